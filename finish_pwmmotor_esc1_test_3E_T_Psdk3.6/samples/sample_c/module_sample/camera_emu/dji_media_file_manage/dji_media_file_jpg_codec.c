@@ -0,0 +1,1546 @@
+/**
+ ********************************************************************
+ * @file    dji_media_file_jpg_codec.c
+ * @brief   Minimal JPEG codec for thumbnails and screennails: Exif thumbnail lookup, baseline Huffman decoder
+ *          with DCT domain downscaling by 1/2, 1/4 and 1/8, integer box resize and baseline 4:2:0 encoder with
+ *          the example tables of ITU T.81 Annex K. Progressive and arithmetic coded files are not supported.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "dji_media_file_jpg_codec.h"
+#include <string.h>
+#include <dji_logger.h>
+#include "dji_platform.h"
+
+/* Private constants ---------------------------------------------------------*/
+#define JPG_MARKER_PREFIX                   0xFF
+#define JPG_MARKER_SOF0                     0xC0
+#define JPG_MARKER_SOF1                     0xC1
+#define JPG_MARKER_SOF15                    0xCF
+#define JPG_MARKER_DHT                      0xC4
+#define JPG_MARKER_JPG                      0xC8
+#define JPG_MARKER_DAC                      0xCC
+#define JPG_MARKER_RST0                     0xD0
+#define JPG_MARKER_RST7                     0xD7
+#define JPG_MARKER_SOI                      0xD8
+#define JPG_MARKER_EOI                      0xD9
+#define JPG_MARKER_SOS                      0xDA
+#define JPG_MARKER_DQT                      0xDB
+#define JPG_MARKER_DRI                      0xDD
+#define JPG_MARKER_APP0                     0xE0
+#define JPG_MARKER_APP1                     0xE1
+
+#define JPG_BLOCK_SIZE                      8
+#define JPG_BLOCK_COEF_NUM                  64
+#define JPG_COMPONENT_NUM_MAX               3
+#define JPG_TABLE_NUM_MAX                   4
+#define JPG_SAMPLING_FACTOR_MAX             4
+#define JPG_MCU_BLOCK_NUM_MAX               10
+#define JPG_HUFFMAN_CODE_LENGTH_MAX         16
+#define JPG_HUFFMAN_FAST_BITS               9
+#define JPG_SAMPLE_PRECISION                8
+#define JPG_SAMPLE_CENTER                   128
+
+//fixed point JFIF YCbCr to RGB and RGB to YCbCr coefficients, scaled by 1 << 16
+#define JPG_COLOR_FIX_SHIFT                 16
+#define JPG_COLOR_FIX_HALF                  (1 << (JPG_COLOR_FIX_SHIFT - 1))
+#define JPG_COLOR_CR_TO_R                   91881
+#define JPG_COLOR_CB_TO_G                   22554
+#define JPG_COLOR_CR_TO_G                   46802
+#define JPG_COLOR_CB_TO_B                   116130
+
+#define JPG_EXIF_HEADER                     "Exif\0\0"
+#define JPG_EXIF_HEADER_LEN                 6
+#define JPG_EXIF_TIFF_MAGIC                 42
+#define JPG_EXIF_IFD_ENTRY_SIZE             12
+#define JPG_EXIF_TYPE_SHORT                 3
+#define JPG_EXIF_TAG_THUMBNAIL_OFFSET       0x0201
+#define JPG_EXIF_TAG_THUMBNAIL_LENGTH       0x0202
+
+#define JPG_ENCODE_QUALITY_MAX              100
+#define JPG_ENCODE_HEADER_SIZE_MAX          1024
+#define JPG_ENCODE_HUFFMAN_DC_SYMBOL_NUM    12
+#define JPG_ENCODE_HUFFMAN_AC_SYMBOL_NUM    162
+
+/* Private types -------------------------------------------------------------*/
+typedef struct {
+    uint8_t fastLength[1 << JPG_HUFFMAN_FAST_BITS];
+    uint8_t fastSymbol[1 << JPG_HUFFMAN_FAST_BITS];
+    //AC coefficient whose code and magnitude bits both fit in the lookup bits: value << 8 | run << 4 | bit count
+    int16_t fastAc[1 << JPG_HUFFMAN_FAST_BITS];
+    int32_t maxCode[JPG_HUFFMAN_CODE_LENGTH_MAX + 1];
+    int32_t valueOffset[JPG_HUFFMAN_CODE_LENGTH_MAX + 1];
+    uint8_t values[256];
+    bool isDefined;
+} T_JpgHuffmanTable;
+
+typedef struct {
+    uint8_t id;
+    uint8_t h;
+    uint8_t v;
+    uint8_t quantTableId;
+    uint8_t dcTableId;
+    uint8_t acTableId;
+    int32_t dcPredictor;
+    uint32_t planeWidth;
+    uint32_t planeHeight;
+    uint8_t *plane;
+} T_JpgComponent;
+
+typedef struct {
+    const uint8_t *data;
+    uint32_t size;
+    uint32_t position;
+    uint64_t bitBuffer;
+    int32_t bitCount;
+    bool isMarkerReached;
+} T_JpgBitReader;
+
+typedef struct {
+    uint16_t width;
+    uint16_t height;
+    uint8_t componentNum;
+    T_JpgComponent component[JPG_COMPONENT_NUM_MAX];
+    uint8_t hMax;
+    uint8_t vMax;
+    uint32_t mcuCountX;
+    uint32_t mcuCountY;
+    uint16_t quantTable[JPG_TABLE_NUM_MAX][JPG_BLOCK_COEF_NUM];
+    bool isQuantTableDefined[JPG_TABLE_NUM_MAX];
+    T_JpgHuffmanTable dcTable[JPG_TABLE_NUM_MAX];
+    T_JpgHuffmanTable acTable[JPG_TABLE_NUM_MAX];
+    uint16_t restartInterval;
+    bool isFrameParsed;
+    bool isScanDecoded;
+    //output size of a block, 8 >> scale shift
+    uint8_t blockSize;
+    float idctTable[JPG_BLOCK_SIZE][JPG_BLOCK_SIZE];
+    T_JpgBitReader reader;
+} T_JpgDecoder;
+
+typedef struct {
+    uint8_t *data;
+    uint32_t size;
+    uint32_t capacity;
+    bool isOutOfMemory;
+    uint32_t bitBuffer;
+    int32_t bitCount;
+    uint8_t quantTable[2][JPG_BLOCK_COEF_NUM];
+    float fdctTable[JPG_BLOCK_SIZE][JPG_BLOCK_SIZE];
+    uint16_t dcCode[2][JPG_ENCODE_HUFFMAN_DC_SYMBOL_NUM];
+    uint8_t dcCodeLength[2][JPG_ENCODE_HUFFMAN_DC_SYMBOL_NUM];
+    uint16_t acCode[2][256];
+    uint8_t acCodeLength[2][256];
+} T_JpgEncoder;
+
+/* Private values -------------------------------------------------------------*/
+//natural order index of the k-th coefficient in zig-zag order
+static const uint8_t s_jpgNaturalOrder[JPG_BLOCK_COEF_NUM] = {
+    0, 1, 8, 16, 9, 2, 3, 10, 17, 24, 32, 25, 18, 11, 4, 5,
+    12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13, 6, 7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63,
+};
+
+//cos(k * pi / 16) for k = 0 to 31, every DCT basis of 8, 4, 2 and 1 points is an entry of it
+static const float s_jpgCos16[32] = {
+    1.0f, 0.98078528f, 0.92387953f, 0.83146961f, 0.70710678f, 0.55557023f, 0.38268343f, 0.19509032f,
+    0.0f, -0.19509032f, -0.38268343f, -0.55557023f, -0.70710678f, -0.83146961f, -0.92387953f, -0.98078528f,
+    -1.0f, -0.98078528f, -0.92387953f, -0.83146961f, -0.70710678f, -0.55557023f, -0.38268343f, -0.19509032f,
+    0.0f, 0.19509032f, 0.38268343f, 0.55557023f, 0.70710678f, 0.83146961f, 0.92387953f, 0.98078528f,
+};
+
+static const uint8_t s_jpgLuminanceQuantTable[JPG_BLOCK_COEF_NUM] = {
+    16, 11, 10, 16, 24, 40, 51, 61,
+    12, 12, 14, 19, 26, 58, 60, 55,
+    14, 13, 16, 24, 40, 57, 69, 56,
+    14, 17, 22, 29, 51, 87, 80, 62,
+    18, 22, 37, 56, 68, 109, 103, 77,
+    24, 35, 55, 64, 81, 104, 113, 92,
+    49, 64, 78, 87, 103, 121, 120, 101,
+    72, 92, 95, 98, 112, 100, 103, 99,
+};
+
+static const uint8_t s_jpgChrominanceQuantTable[JPG_BLOCK_COEF_NUM] = {
+    17, 18, 24, 47, 99, 99, 99, 99,
+    18, 21, 26, 66, 99, 99, 99, 99,
+    24, 26, 56, 99, 99, 99, 99, 99,
+    47, 66, 99, 99, 99, 99, 99, 99,
+    99, 99, 99, 99, 99, 99, 99, 99,
+    99, 99, 99, 99, 99, 99, 99, 99,
+    99, 99, 99, 99, 99, 99, 99, 99,
+    99, 99, 99, 99, 99, 99, 99, 99,
+};
+
+static const uint8_t s_jpgDcLuminanceBits[JPG_HUFFMAN_CODE_LENGTH_MAX] = {
+    0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0
+};
+static const uint8_t s_jpgDcChrominanceBits[JPG_HUFFMAN_CODE_LENGTH_MAX] = {
+    0, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0
+};
+static const uint8_t s_jpgDcValues[JPG_ENCODE_HUFFMAN_DC_SYMBOL_NUM] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11
+};
+
+static const uint8_t s_jpgAcLuminanceBits[JPG_HUFFMAN_CODE_LENGTH_MAX] = {
+    0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 0x7D
+};
+static const uint8_t s_jpgAcLuminanceValues[JPG_ENCODE_HUFFMAN_AC_SYMBOL_NUM] = {
+    0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07,
+    0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xA1, 0x08, 0x23, 0x42, 0xB1, 0xC1, 0x15, 0x52, 0xD1, 0xF0,
+    0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0A, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2A, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49,
+    0x4A, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89,
+    0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7,
+    0xA8, 0xA9, 0xAA, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4, 0xC5,
+    0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA, 0xE1, 0xE2,
+    0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8,
+    0xF9, 0xFA,
+};
+
+static const uint8_t s_jpgAcChrominanceBits[JPG_HUFFMAN_CODE_LENGTH_MAX] = {
+    0, 2, 1, 2, 4, 4, 3, 4, 7, 5, 4, 4, 0, 1, 2, 0x77
+};
+static const uint8_t s_jpgAcChrominanceValues[JPG_ENCODE_HUFFMAN_AC_SYMBOL_NUM] = {
+    0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71,
+    0x13, 0x22, 0x32, 0x81, 0x08, 0x14, 0x42, 0x91, 0xA1, 0xB1, 0xC1, 0x09, 0x23, 0x33, 0x52, 0xF0,
+    0x15, 0x62, 0x72, 0xD1, 0x0A, 0x16, 0x24, 0x34, 0xE1, 0x25, 0xF1, 0x17, 0x18, 0x19, 0x1A, 0x26,
+    0x27, 0x28, 0x29, 0x2A, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48,
+    0x49, 0x4A, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68,
+    0x69, 0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,
+    0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5,
+    0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3,
+    0xC4, 0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA,
+    0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8,
+    0xF9, 0xFA,
+};
+
+/* Private functions declaration ---------------------------------------------*/
+static uint16_t DjiMediaFile_JpgReadU16(const uint8_t *data, bool isBigEndian);
+static uint32_t DjiMediaFile_JpgReadU32(const uint8_t *data, bool isBigEndian);
+static T_DjiReturnCode DjiMediaFile_JpgGetSegment(const uint8_t *data, uint32_t size, uint32_t *position,
+                                                  uint8_t *marker, uint32_t *segmentLen);
+static T_DjiReturnCode DjiMediaFile_JpgParseExifThumbnail(const uint8_t *data, uint32_t tiffPosition,
+                                                          uint32_t tiffSize, uint32_t *thumbnailOffset,
+                                                          uint32_t *thumbnailSize);
+static T_DjiReturnCode DjiMediaFile_JpgParseQuantTable(T_JpgDecoder *decoder, const uint8_t *segment, uint32_t len);
+static T_DjiReturnCode DjiMediaFile_JpgParseHuffmanTable(T_JpgDecoder *decoder, const uint8_t *segment,
+                                                         uint32_t len);
+static T_DjiReturnCode DjiMediaFile_JpgBuildHuffmanTable(T_JpgHuffmanTable *table, const uint8_t *bits,
+                                                         const uint8_t *values, uint32_t valueNum);
+static T_DjiReturnCode DjiMediaFile_JpgParseFrame(T_JpgDecoder *decoder, const uint8_t *segment, uint32_t len,
+                                                  uint16_t minWidth);
+static T_DjiReturnCode DjiMediaFile_JpgDecodeScan(T_JpgDecoder *decoder, const uint8_t *data, uint32_t size,
+                                                  uint32_t segmentPosition, uint32_t segmentLen,
+                                                  uint32_t *nextPosition);
+static T_DjiReturnCode DjiMediaFile_JpgRestart(T_JpgDecoder *decoder, T_JpgComponent **scanComponent,
+                                               uint8_t scanComponentNum);
+static void DjiMediaFile_JpgFillBits(T_JpgBitReader *reader);
+static int32_t DjiMediaFile_JpgDecodeHuffman(T_JpgBitReader *reader, const T_JpgHuffmanTable *table);
+static int32_t DjiMediaFile_JpgReceiveExtend(T_JpgBitReader *reader, uint8_t bitNum);
+static T_DjiReturnCode DjiMediaFile_JpgDecodeBlock(T_JpgDecoder *decoder, T_JpgComponent *component,
+                                                   uint32_t blockX, uint32_t blockY);
+static T_DjiReturnCode DjiMediaFile_JpgOutputImage(const T_JpgDecoder *decoder, T_DjiMediaFileImage *image);
+static void DjiMediaFile_JpgFreeDecoder(T_JpgDecoder *decoder);
+static uint8_t DjiMediaFile_JpgClamp(int32_t value);
+
+static void DjiMediaFile_JpgPutByte(T_JpgEncoder *encoder, uint8_t byte);
+static void DjiMediaFile_JpgPutU16(T_JpgEncoder *encoder, uint16_t value);
+static void DjiMediaFile_JpgPutBits(T_JpgEncoder *encoder, uint32_t bits, uint8_t bitNum);
+static void DjiMediaFile_JpgPutHeaders(T_JpgEncoder *encoder, const T_DjiMediaFileImage *image);
+static void DjiMediaFile_JpgPutHuffmanTable(T_JpgEncoder *encoder, uint8_t tableClassAndId, const uint8_t *bits,
+                                            const uint8_t *values, uint32_t valueNum);
+static void DjiMediaFile_JpgBuildHuffmanCode(const uint8_t *bits, const uint8_t *values, uint16_t *code,
+                                             uint8_t *codeLength);
+static void DjiMediaFile_JpgEncodeBlock(T_JpgEncoder *encoder, const float *block, uint8_t tableId,
+                                        int32_t *dcPredictor);
+static uint8_t DjiMediaFile_JpgGetBitNum(int32_t value);
+
+/* Exported functions definition ---------------------------------------------*/
+/**
+ * @brief Get picture size from the frame header of a JPEG file, without decoding it.
+ * @param data: JPEG file data.
+ * @param size: size of data.
+ * @param width: picture width.
+ * @param height: picture height.
+ * @return Execution result.
+ */
+T_DjiReturnCode DjiMediaFile_JpgGetImageSize(const uint8_t *data, uint32_t size, uint16_t *width, uint16_t *height)
+{
+    uint32_t position = 2;
+    uint32_t segmentLen;
+    uint8_t marker;
+
+    if (size < 2 || data[0] != JPG_MARKER_PREFIX || data[1] != JPG_MARKER_SOI) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    while (DjiMediaFile_JpgGetSegment(data, size, &position, &marker, &segmentLen) ==
+           DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        if (marker >= JPG_MARKER_SOF0 && marker <= JPG_MARKER_SOF15 && marker != JPG_MARKER_DHT &&
+            marker != JPG_MARKER_JPG && marker != JPG_MARKER_DAC) {
+            if (segmentLen < 6) {
+                return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+            }
+            *height = DjiMediaFile_JpgReadU16(&data[position + 1], true);
+            *width = DjiMediaFile_JpgReadU16(&data[position + 3], true);
+            return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+        }
+        if (marker == JPG_MARKER_SOS) {
+            break;
+        }
+        position += segmentLen;
+    }
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
+}
+
+/**
+ * @brief Find the JPEG thumbnail of the Exif APP1 segment, which cameras write to IFD1.
+ * @note Only the segments before the first scan are read, so data may be just the head of the file.
+ * @param data: JPEG file data.
+ * @param size: size of data.
+ * @param thumbnailOffset: offset of the thumbnail JPEG in data.
+ * @param thumbnailSize: size of the thumbnail JPEG.
+ * @return Execution result, DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND if there is no thumbnail.
+ */
+T_DjiReturnCode DjiMediaFile_JpgGetExifThumbnail(const uint8_t *data, uint32_t size, uint32_t *thumbnailOffset,
+                                                 uint32_t *thumbnailSize)
+{
+    uint32_t position = 2;
+    uint32_t segmentLen;
+    uint8_t marker;
+
+    if (size < 2 || data[0] != JPG_MARKER_PREFIX || data[1] != JPG_MARKER_SOI) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    while (DjiMediaFile_JpgGetSegment(data, size, &position, &marker, &segmentLen) ==
+           DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        if (marker == JPG_MARKER_SOS) {
+            break;
+        }
+        if (marker == JPG_MARKER_APP1 && segmentLen > JPG_EXIF_HEADER_LEN &&
+            memcmp(&data[position], JPG_EXIF_HEADER, JPG_EXIF_HEADER_LEN) == 0) {
+            return DjiMediaFile_JpgParseExifThumbnail(data, position + JPG_EXIF_HEADER_LEN,
+                                                      segmentLen - JPG_EXIF_HEADER_LEN, thumbnailOffset,
+                                                      thumbnailSize);
+        }
+        position += segmentLen;
+    }
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
+}
+
+/**
+ * @brief Decode a baseline JPEG file, downscaled in DCT domain to the smallest of 1/8, 1/4, 1/2 and 1 which keeps
+ * the width not less than minWidth.
+ * @note An N point IDCT of the low frequency N x N coefficients gives the block downscaled to N x N, which costs
+ * much less than the full IDCT, while Huffman decoding of the coefficients is the same. Chroma is upsampled by
+ * replication. Pixels are allocated by osal Malloc, free them by DjiMediaFile_ImageFree.
+ * @param data: JPEG file data.
+ * @param size: size of data.
+ * @param minWidth: least width of the decoded picture, 0 to decode at full size.
+ * @param image: decoded picture, gray or RGB.
+ * @return Execution result, DJI_ERROR_SYSTEM_MODULE_CODE_NONSUPPORT for progressive or arithmetic coded files.
+ */
+T_DjiReturnCode DjiMediaFile_JpgDecode(const uint8_t *data, uint32_t size, uint16_t minWidth,
+                                       T_DjiMediaFileImage *image)
+{
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+    T_DjiReturnCode returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    T_JpgDecoder *decoder;
+    uint32_t position = 2;
+    uint32_t segmentLen;
+    uint8_t marker;
+
+    memset(image, 0, sizeof(T_DjiMediaFileImage));
+    if (size < 2 || data[0] != JPG_MARKER_PREFIX || data[1] != JPG_MARKER_SOI) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    decoder = osalHandler->Malloc(sizeof(T_JpgDecoder));
+    if (decoder == NULL) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_MEMORY_ALLOC_FAILED;
+    }
+    memset(decoder, 0, sizeof(T_JpgDecoder));
+
+    while (DjiMediaFile_JpgGetSegment(data, size, &position, &marker, &segmentLen) ==
+           DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        if (marker == JPG_MARKER_SOF0 || marker == JPG_MARKER_SOF1) {
+            returnCode = DjiMediaFile_JpgParseFrame(decoder, &data[position], segmentLen, minWidth);
+        } else if (marker > JPG_MARKER_SOF1 && marker <= JPG_MARKER_SOF15 && marker != JPG_MARKER_DHT &&
+                   marker != JPG_MARKER_JPG && marker != JPG_MARKER_DAC) {
+            returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_NONSUPPORT;
+        } else if (marker == JPG_MARKER_DQT) {
+            returnCode = DjiMediaFile_JpgParseQuantTable(decoder, &data[position], segmentLen);
+        } else if (marker == JPG_MARKER_DHT) {
+            returnCode = DjiMediaFile_JpgParseHuffmanTable(decoder, &data[position], segmentLen);
+        } else if (marker == JPG_MARKER_DRI && segmentLen >= 2) {
+            decoder->restartInterval = DjiMediaFile_JpgReadU16(&data[position], true);
+            returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+        } else if (marker == JPG_MARKER_SOS) {
+            returnCode = DjiMediaFile_JpgDecodeScan(decoder, data, size, position, segmentLen, &position);
+            if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+                goto out;
+            }
+            continue;
+        } else if (marker == JPG_MARKER_EOI) {
+            break;
+        } else {
+            returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+        }
+
+        if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+            goto out;
+        }
+        position += segmentLen;
+    }
+
+    if (!decoder->isScanDecoded) {
+        returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+        goto out;
+    }
+
+    returnCode = DjiMediaFile_JpgOutputImage(decoder, image);
+
+out:
+    DjiMediaFile_JpgFreeDecoder(decoder);
+
+    return returnCode;
+}
+
+/**
+ * @brief Encode a picture to a baseline JPEG file with the example quantization tables of ITU T.81 Annex K scaled
+ * by quality the same way libjpeg does, and the example Huffman tables, so no statistics pass is needed.
+ * @note Color pictures are stored as YCbCr 4:2:0. Data is allocated by osal Malloc, free it by osal Free.
+ * @param image: picture to encode.
+ * @param quality: quality from 1 to 100.
+ * @param data: encoded JPEG file.
+ * @param size: size of data.
+ * @return Execution result.
+ */
+T_DjiReturnCode DjiMediaFile_JpgEncode(const T_DjiMediaFileImage *image, uint8_t quality, uint8_t **data,
+                                       uint32_t *size)
+{
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+    T_JpgEncoder *encoder;
+    float block[JPG_MCU_BLOCK_NUM_MAX][JPG_BLOCK_COEF_NUM];
+    int32_t dcPredictor[JPG_COMPONENT_NUM_MAX] = {0};
+    uint32_t mcuSize, mcuX, mcuY, x, y, k;
+    uint32_t pixelX, pixelY;
+    const uint8_t *pixel;
+    int32_t scale, value;
+    float r, g, b;
+
+    if (image->pixels == NULL || image->width == 0 || image->height == 0 ||
+        (image->componentNum != DJI_MEDIA_FILE_IMAGE_COMPONENT_NUM_GRAY &&
+         image->componentNum != DJI_MEDIA_FILE_IMAGE_COMPONENT_NUM_RGB)) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    encoder = osalHandler->Malloc(sizeof(T_JpgEncoder));
+    if (encoder == NULL) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_MEMORY_ALLOC_FAILED;
+    }
+    memset(encoder, 0, sizeof(T_JpgEncoder));
+
+    //a tenth of raw size is far more than any preview needs at usual quality, buffer grows when it is not
+    encoder->capacity = (uint32_t) image->width * image->height * image->componentNum / 10 + JPG_ENCODE_HEADER_SIZE_MAX;
+    encoder->data = osalHandler->Malloc(encoder->capacity);
+    if (encoder->data == NULL) {
+        osalHandler->Free(encoder);
+        return DJI_ERROR_SYSTEM_MODULE_CODE_MEMORY_ALLOC_FAILED;
+    }
+
+    if (quality == 0) {
+        quality = 1;
+    } else if (quality > JPG_ENCODE_QUALITY_MAX) {
+        quality = JPG_ENCODE_QUALITY_MAX;
+    }
+    scale = quality < 50 ? 5000 / quality : 200 - quality * 2;
+    for (k = 0; k < JPG_BLOCK_COEF_NUM; k++) {
+        value = (s_jpgLuminanceQuantTable[k] * scale + 50) / 100;
+        encoder->quantTable[0][k] = (uint8_t) (value < 1 ? 1 : (value > 255 ? 255 : value));
+        value = (s_jpgChrominanceQuantTable[k] * scale + 50) / 100;
+        encoder->quantTable[1][k] = (uint8_t) (value < 1 ? 1 : (value > 255 ? 255 : value));
+    }
+
+    for (k = 0; k < JPG_BLOCK_SIZE; k++) {
+        for (x = 0; x < JPG_BLOCK_SIZE; x++) {
+            encoder->fdctTable[k][x] = s_jpgCos16[((2 * x + 1) * k) % 32] / 2 *
+                                       (k == 0 ? s_jpgCos16[4] : 1.0f);
+        }
+    }
+
+    DjiMediaFile_JpgBuildHuffmanCode(s_jpgDcLuminanceBits, s_jpgDcValues, encoder->dcCode[0],
+                                     encoder->dcCodeLength[0]);
+    DjiMediaFile_JpgBuildHuffmanCode(s_jpgDcChrominanceBits, s_jpgDcValues, encoder->dcCode[1],
+                                     encoder->dcCodeLength[1]);
+    DjiMediaFile_JpgBuildHuffmanCode(s_jpgAcLuminanceBits, s_jpgAcLuminanceValues, encoder->acCode[0],
+                                     encoder->acCodeLength[0]);
+    DjiMediaFile_JpgBuildHuffmanCode(s_jpgAcChrominanceBits, s_jpgAcChrominanceValues, encoder->acCode[1],
+                                     encoder->acCodeLength[1]);
+
+    DjiMediaFile_JpgPutHeaders(encoder, image);
+
+    mcuSize = image->componentNum == DJI_MEDIA_FILE_IMAGE_COMPONENT_NUM_RGB ? JPG_BLOCK_SIZE * 2 : JPG_BLOCK_SIZE;
+    for (mcuY = 0; mcuY < image->height; mcuY += mcuSize) {
+        for (mcuX = 0; mcuX < image->width; mcuX += mcuSize) {
+            if (image->componentNum == DJI_MEDIA_FILE_IMAGE_COMPONENT_NUM_GRAY) {
+                for (y = 0; y < JPG_BLOCK_SIZE; y++) {
+                    pixelY = mcuY + y < image->height ? mcuY + y : image->height - 1u;
+                    for (x = 0; x < JPG_BLOCK_SIZE; x++) {
+                        pixelX = mcuX + x < image->width ? mcuX + x : image->width - 1u;
+                        block[0][y * JPG_BLOCK_SIZE + x] =
+                            (float) image->pixels[pixelY * image->width + pixelX] - JPG_SAMPLE_CENTER;
+                    }
+                }
+                DjiMediaFile_JpgEncodeBlock(encoder, block[0], 0, &dcPredictor[0]);
+                continue;
+            }
+
+            //four luminance blocks of the 16 x 16 MCU, then chroma blocks of its 2 x 2 averages
+            memset(block[4], 0, sizeof(block[4]) * 2);
+            for (y = 0; y < JPG_BLOCK_SIZE * 2; y++) {
+                pixelY = mcuY + y < image->height ? mcuY + y : image->height - 1u;
+                for (x = 0; x < JPG_BLOCK_SIZE * 2; x++) {
+                    pixelX = mcuX + x < image->width ? mcuX + x : image->width - 1u;
+                    pixel = &image->pixels[(pixelY * image->width + pixelX) * DJI_MEDIA_FILE_IMAGE_COMPONENT_NUM_RGB];
+                    r = pixel[0];
+                    g = pixel[1];
+                    b = pixel[2];
+                    k = (y / JPG_BLOCK_SIZE) * 2 + x / JPG_BLOCK_SIZE;
+                    block[k][(y % JPG_BLOCK_SIZE) * JPG_BLOCK_SIZE + x % JPG_BLOCK_SIZE] =
+                        0.299f * r + 0.587f * g + 0.114f * b - JPG_SAMPLE_CENTER;
+                    k = (y / 2) * JPG_BLOCK_SIZE + x / 2;
+                    block[4][k] += (-0.168736f * r - 0.331264f * g + 0.5f * b) / 4;
+                    block[5][k] += (0.5f * r - 0.418688f * g - 0.081312f * b) / 4;
+                }
+            }
+            for (k = 0; k < 4; k++) {
+                DjiMediaFile_JpgEncodeBlock(encoder, block[k], 0, &dcPredictor[0]);
+            }
+            DjiMediaFile_JpgEncodeBlock(encoder, block[4], 1, &dcPredictor[1]);
+            DjiMediaFile_JpgEncodeBlock(encoder, block[5], 1, &dcPredictor[2]);
+        }
+    }
+
+    //pad the last byte with 1 bits, then end of image
+    DjiMediaFile_JpgPutBits(encoder, 0x7F, 7);
+    encoder->bitCount = 0;
+    DjiMediaFile_JpgPutByte(encoder, JPG_MARKER_PREFIX);
+    DjiMediaFile_JpgPutByte(encoder, JPG_MARKER_EOI);
+
+    if (encoder->isOutOfMemory) {
+        osalHandler->Free(encoder->data);
+        osalHandler->Free(encoder);
+        return DJI_ERROR_SYSTEM_MODULE_CODE_MEMORY_ALLOC_FAILED;
+    }
+
+    *data = encoder->data;
+    *size = encoder->size;
+    osalHandler->Free(encoder);
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+/**
+ * @brief Resize a picture by integer box filter: a target pixel is the average of the source pixels it covers, or
+ * the nearest source pixel when enlarging.
+ * @note Pixels are allocated by osal Malloc, free them by DjiMediaFile_ImageFree.
+ * @param srcImage: source picture.
+ * @param width: target width.
+ * @param height: target height.
+ * @param dstImage: resized picture.
+ * @return Execution result.
+ */
+T_DjiReturnCode DjiMediaFile_ImageResize(const T_DjiMediaFileImage *srcImage, uint16_t width, uint16_t height,
+                                         T_DjiMediaFileImage *dstImage)
+{
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+    uint32_t *columnStart;
+    uint32_t x, y, c, sx, sy, sx0, sx1, sy0, sy1, count;
+    uint32_t sum[JPG_COMPONENT_NUM_MAX];
+    uint8_t componentNum = srcImage->componentNum;
+    const uint8_t *srcRow;
+    uint8_t *dstPixel;
+
+    memset(dstImage, 0, sizeof(T_DjiMediaFileImage));
+    if (srcImage->pixels == NULL || srcImage->width == 0 || srcImage->height == 0 || width == 0 || height == 0 ||
+        componentNum == 0 || componentNum > JPG_COMPONENT_NUM_MAX) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    dstImage->pixels = osalHandler->Malloc((uint32_t) width * height * componentNum);
+    columnStart = osalHandler->Malloc((width + 1u) * sizeof(uint32_t));
+    if (dstImage->pixels == NULL || columnStart == NULL) {
+        osalHandler->Free(dstImage->pixels);
+        osalHandler->Free(columnStart);
+        dstImage->pixels = NULL;
+        return DJI_ERROR_SYSTEM_MODULE_CODE_MEMORY_ALLOC_FAILED;
+    }
+    dstImage->width = width;
+    dstImage->height = height;
+    dstImage->componentNum = componentNum;
+
+    for (x = 0; x <= width; x++) {
+        columnStart[x] = x * srcImage->width / width;
+    }
+
+    dstPixel = dstImage->pixels;
+    for (y = 0; y < height; y++) {
+        sy0 = y * srcImage->height / height;
+        sy1 = (y + 1) * srcImage->height / height;
+        if (sy1 <= sy0) {
+            sy1 = sy0 + 1;
+        }
+        for (x = 0; x < width; x++) {
+            sx0 = columnStart[x];
+            sx1 = columnStart[x + 1] > sx0 ? columnStart[x + 1] : sx0 + 1;
+            memset(sum, 0, sizeof(sum));
+            for (sy = sy0; sy < sy1; sy++) {
+                srcRow = &srcImage->pixels[(sy * srcImage->width + sx0) * componentNum];
+                for (sx = sx0; sx < sx1; sx++) {
+                    for (c = 0; c < componentNum; c++) {
+                        sum[c] += *srcRow++;
+                    }
+                }
+            }
+            count = (sy1 - sy0) * (sx1 - sx0);
+            for (c = 0; c < componentNum; c++) {
+                *dstPixel++ = (uint8_t) ((sum[c] + count / 2) / count);
+            }
+        }
+    }
+
+    osalHandler->Free(columnStart);
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+void DjiMediaFile_ImageFree(T_DjiMediaFileImage *image)
+{
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+
+    if (image->pixels != NULL) {
+        osalHandler->Free(image->pixels);
+    }
+    memset(image, 0, sizeof(T_DjiMediaFileImage));
+}
+
+/* Private functions definition-----------------------------------------------*/
+static uint16_t DjiMediaFile_JpgReadU16(const uint8_t *data, bool isBigEndian)
+{
+    return isBigEndian ? (uint16_t) ((data[0] << 8) | data[1]) : (uint16_t) ((data[1] << 8) | data[0]);
+}
+
+static uint32_t DjiMediaFile_JpgReadU32(const uint8_t *data, bool isBigEndian)
+{
+    if (isBigEndian) {
+        return ((uint32_t) data[0] << 24) | ((uint32_t) data[1] << 16) | ((uint32_t) data[2] << 8) | data[3];
+    }
+
+    return ((uint32_t) data[3] << 24) | ((uint32_t) data[2] << 16) | ((uint32_t) data[1] << 8) | data[0];
+}
+
+/**
+ * @brief Get the next marker from position, skipping fill bytes.
+ * @note On return position is the start of the segment payload, segmentLen is the payload length, which is 0 for
+ * markers without a segment. Entropy coded data after SOS is not part of the segment.
+ */
+static T_DjiReturnCode DjiMediaFile_JpgGetSegment(const uint8_t *data, uint32_t size, uint32_t *position,
+                                                  uint8_t *marker, uint32_t *segmentLen)
+{
+    uint32_t pos = *position;
+    uint16_t len;
+
+    //skip rest of entropy coded data, in which 0xFF 0x00 is a stuffed data byte
+    do {
+        while (pos < size && data[pos] != JPG_MARKER_PREFIX) {
+            pos++;
+        }
+        while (pos < size && data[pos] == JPG_MARKER_PREFIX) {
+            pos++;
+        }
+        if (pos >= size) {
+            return DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
+        }
+    } while (data[pos] == 0x00);
+
+    *marker = data[pos++];
+    if (*marker == JPG_MARKER_EOI || (*marker >= JPG_MARKER_RST0 && *marker <= JPG_MARKER_RST7)) {
+        *segmentLen = 0;
+        *position = pos;
+        return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+    }
+
+    if (pos + 2 > size) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
+    }
+    len = DjiMediaFile_JpgReadU16(&data[pos], true);
+    if (len < 2 || pos + len > size) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
+    }
+
+    *segmentLen = len - 2u;
+    *position = pos + 2;
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+static T_DjiReturnCode DjiMediaFile_JpgParseExifThumbnail(const uint8_t *data, uint32_t tiffPosition,
+                                                          uint32_t tiffSize, uint32_t *thumbnailOffset,
+                                                          uint32_t *thumbnailSize)
+{
+    const uint8_t *tiff = &data[tiffPosition];
+    uint32_t ifdOffset, entryOffset, value, offset = 0, length = 0;
+    uint16_t entryNum, tag, i;
+    bool isBigEndian;
+
+    if (tiffSize < 8) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
+    }
+    if (tiff[0] == 'M' && tiff[1] == 'M') {
+        isBigEndian = true;
+    } else if (tiff[0] == 'I' && tiff[1] == 'I') {
+        isBigEndian = false;
+    } else {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
+    }
+    if (DjiMediaFile_JpgReadU16(&tiff[2], isBigEndian) != JPG_EXIF_TIFF_MAGIC) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
+    }
+
+    //IFD1, which describes the thumbnail, follows IFD0 of the main picture
+    ifdOffset = DjiMediaFile_JpgReadU32(&tiff[4], isBigEndian);
+    if (ifdOffset > tiffSize - 2) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
+    }
+    entryNum = DjiMediaFile_JpgReadU16(&tiff[ifdOffset], isBigEndian);
+    entryOffset = ifdOffset + 2 + (uint32_t) entryNum * JPG_EXIF_IFD_ENTRY_SIZE;
+    if (entryOffset > tiffSize - 4) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
+    }
+    ifdOffset = DjiMediaFile_JpgReadU32(&tiff[entryOffset], isBigEndian);
+    if (ifdOffset == 0 || ifdOffset > tiffSize - 2) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
+    }
+
+    entryNum = DjiMediaFile_JpgReadU16(&tiff[ifdOffset], isBigEndian);
+    for (i = 0; i < entryNum; i++) {
+        entryOffset = ifdOffset + 2 + (uint32_t) i * JPG_EXIF_IFD_ENTRY_SIZE;
+        if (entryOffset > tiffSize - JPG_EXIF_IFD_ENTRY_SIZE) {
+            break;
+        }
+        tag = DjiMediaFile_JpgReadU16(&tiff[entryOffset], isBigEndian);
+        if (DjiMediaFile_JpgReadU16(&tiff[entryOffset + 2], isBigEndian) == JPG_EXIF_TYPE_SHORT) {
+            value = DjiMediaFile_JpgReadU16(&tiff[entryOffset + 8], isBigEndian);
+        } else {
+            value = DjiMediaFile_JpgReadU32(&tiff[entryOffset + 8], isBigEndian);
+        }
+        if (tag == JPG_EXIF_TAG_THUMBNAIL_OFFSET) {
+            offset = value;
+        } else if (tag == JPG_EXIF_TAG_THUMBNAIL_LENGTH) {
+            length = value;
+        }
+    }
+
+    if (length < 4 || offset >= tiffSize || length > tiffSize - offset ||
+        tiff[offset] != JPG_MARKER_PREFIX || tiff[offset + 1] != JPG_MARKER_SOI) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
+    }
+
+    *thumbnailOffset = tiffPosition + offset;
+    *thumbnailSize = length;
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+static T_DjiReturnCode DjiMediaFile_JpgParseQuantTable(T_JpgDecoder *decoder, const uint8_t *segment, uint32_t len)
+{
+    uint32_t position = 0;
+    uint8_t precision, tableId;
+    uint32_t k;
+
+    while (position < len) {
+        precision = segment[position] >> 4;
+        tableId = segment[position] & 0x0F;
+        position++;
+        if (tableId >= JPG_TABLE_NUM_MAX || precision > 1 ||
+            position + JPG_BLOCK_COEF_NUM * (precision + 1u) > len) {
+            return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+        }
+        for (k = 0; k < JPG_BLOCK_COEF_NUM; k++) {
+            decoder->quantTable[tableId][s_jpgNaturalOrder[k]] =
+                precision ? DjiMediaFile_JpgReadU16(&segment[position + k * 2], true) : segment[position + k];
+        }
+        decoder->isQuantTableDefined[tableId] = true;
+        position += JPG_BLOCK_COEF_NUM * (precision + 1u);
+    }
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+static T_DjiReturnCode DjiMediaFile_JpgParseHuffmanTable(T_JpgDecoder *decoder, const uint8_t *segment,
+                                                         uint32_t len)
+{
+    uint32_t position = 0;
+    uint32_t valueNum, i;
+    uint8_t tableClass, tableId;
+    T_JpgHuffmanTable *table;
+
+    while (position < len) {
+        if (position + 1 + JPG_HUFFMAN_CODE_LENGTH_MAX > len) {
+            return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+        }
+        tableClass = segment[position] >> 4;
+        tableId = segment[position] & 0x0F;
+        if (tableClass > 1 || tableId >= JPG_TABLE_NUM_MAX) {
+            return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+        }
+
+        valueNum = 0;
+        for (i = 0; i < JPG_HUFFMAN_CODE_LENGTH_MAX; i++) {
+            valueNum += segment[position + 1 + i];
+        }
+        if (valueNum > 256 || position + 1 + JPG_HUFFMAN_CODE_LENGTH_MAX + valueNum > len) {
+            return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+        }
+
+        table = tableClass == 0 ? &decoder->dcTable[tableId] : &decoder->acTable[tableId];
+        if (DjiMediaFile_JpgBuildHuffmanTable(table, &segment[position + 1],
+                                              &segment[position + 1 + JPG_HUFFMAN_CODE_LENGTH_MAX], valueNum) !=
+            DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+            return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+        }
+        position += 1 + JPG_HUFFMAN_CODE_LENGTH_MAX + valueNum;
+    }
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+/**
+ * @brief Build canonical Huffman decode table of ITU T.81 Annex C, with a lookup table for codes not longer than
+ * JPG_HUFFMAN_FAST_BITS, which are nearly all codes in a usual picture.
+ */
+static T_DjiReturnCode DjiMediaFile_JpgBuildHuffmanTable(T_JpgHuffmanTable *table, const uint8_t *bits,
+                                                         const uint8_t *values, uint32_t valueNum)
+{
+    uint32_t code = 0;
+    uint32_t valueIndex = 0;
+    uint32_t length, i, fill, fastIndex, run, bitNum;
+    int32_t value;
+
+    memset(table, 0, sizeof(T_JpgHuffmanTable));
+    memcpy(table->values, values, valueNum);
+
+    for (length = 1; length <= JPG_HUFFMAN_CODE_LENGTH_MAX; length++) {
+        table->valueOffset[length] = (int32_t) valueIndex - (int32_t) code;
+        if (code + bits[length - 1] > (1u << length)) {
+            return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+        }
+        for (i = 0; i < bits[length - 1]; i++) {
+            if (length <= JPG_HUFFMAN_FAST_BITS) {
+                fastIndex = code << (JPG_HUFFMAN_FAST_BITS - length);
+                for (fill = 0; fill < (1u << (JPG_HUFFMAN_FAST_BITS - length)); fill++) {
+                    table->fastLength[fastIndex + fill] = (uint8_t) length;
+                    table->fastSymbol[fastIndex + fill] = values[valueIndex];
+                }
+            }
+            code++;
+            valueIndex++;
+        }
+        table->maxCode[length] = bits[length - 1] ? (int32_t) code - 1 : -1;
+        code <<= 1;
+    }
+
+    for (fastIndex = 0; fastIndex < (1u << JPG_HUFFMAN_FAST_BITS); fastIndex++) {
+        length = table->fastLength[fastIndex];
+        run = table->fastSymbol[fastIndex] >> 4;
+        bitNum = table->fastSymbol[fastIndex] & 0x0F;
+        if (length == 0 || bitNum == 0 || length + bitNum > JPG_HUFFMAN_FAST_BITS) {
+            continue;
+        }
+        value = (int32_t) ((fastIndex << length) & ((1u << JPG_HUFFMAN_FAST_BITS) - 1)) >>
+                (JPG_HUFFMAN_FAST_BITS - bitNum);
+        if (value < (1 << (bitNum - 1))) {
+            value -= (1 << bitNum) - 1;
+        }
+        table->fastAc[fastIndex] = (int16_t) (value * 256 + (int32_t) (run << 4) + (int32_t) (length + bitNum));
+    }
+    table->isDefined = true;
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+static T_DjiReturnCode DjiMediaFile_JpgParseFrame(T_JpgDecoder *decoder, const uint8_t *segment, uint32_t len,
+                                                  uint16_t minWidth)
+{
+    T_JpgComponent *component;
+    uint32_t i, x, u, scaleStep;
+
+    if (decoder->isFrameParsed || len < 6 || segment[0] != JPG_SAMPLE_PRECISION) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NONSUPPORT;
+    }
+
+    decoder->height = DjiMediaFile_JpgReadU16(&segment[1], true);
+    decoder->width = DjiMediaFile_JpgReadU16(&segment[3], true);
+    decoder->componentNum = segment[5];
+    if (decoder->width == 0 || decoder->height == 0 || len < 6 + decoder->componentNum * 3u ||
+        (decoder->componentNum != DJI_MEDIA_FILE_IMAGE_COMPONENT_NUM_GRAY &&
+         decoder->componentNum != DJI_MEDIA_FILE_IMAGE_COMPONENT_NUM_RGB)) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NONSUPPORT;
+    }
+
+    decoder->hMax = 1;
+    decoder->vMax = 1;
+    for (i = 0; i < decoder->componentNum; i++) {
+        component = &decoder->component[i];
+        component->id = segment[6 + i * 3];
+        component->h = segment[7 + i * 3] >> 4;
+        component->v = segment[7 + i * 3] & 0x0F;
+        component->quantTableId = segment[8 + i * 3];
+        if (component->h == 0 || component->h > JPG_SAMPLING_FACTOR_MAX || component->v == 0 ||
+            component->v > JPG_SAMPLING_FACTOR_MAX || component->quantTableId >= JPG_TABLE_NUM_MAX) {
+            return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+        }
+        decoder->hMax = component->h > decoder->hMax ? component->h : decoder->hMax;
+        decoder->vMax = component->v > decoder->vMax ? component->v : decoder->vMax;
+    }
+
+    decoder->blockSize = 1;
+    while (decoder->blockSize < JPG_BLOCK_SIZE &&
+           (minWidth == 0 ||
+            ((uint32_t) decoder->width * decoder->blockSize + JPG_BLOCK_SIZE - 1) / JPG_BLOCK_SIZE < minWidth)) {
+        decoder->blockSize *= 2;
+    }
+
+    //basis of N point IDCT is cos((2x + 1) * u * pi / (2N)), which is cos(k * pi / 16) with k = (2x + 1) * u * 8 / N
+    scaleStep = JPG_BLOCK_SIZE / decoder->blockSize;
+    for (x = 0; x < decoder->blockSize; x++) {
+        for (u = 0; u < decoder->blockSize; u++) {
+            decoder->idctTable[x][u] = s_jpgCos16[((2 * x + 1) * u * scaleStep) % 32] / 2 *
+                                       (u == 0 ? s_jpgCos16[4] : 1.0f);
+        }
+    }
+
+    decoder->mcuCountX = (decoder->width + JPG_BLOCK_SIZE * decoder->hMax - 1u) / (JPG_BLOCK_SIZE * decoder->hMax);
+    decoder->mcuCountY = (decoder->height + JPG_BLOCK_SIZE * decoder->vMax - 1u) / (JPG_BLOCK_SIZE * decoder->vMax);
+    decoder->isFrameParsed = true;
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+static T_DjiReturnCode DjiMediaFile_JpgDecodeScan(T_JpgDecoder *decoder, const uint8_t *data, uint32_t size,
+                                                  uint32_t segmentPosition, uint32_t segmentLen,
+                                                  uint32_t *nextPosition)
+{
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+    const uint8_t *segment = &data[segmentPosition];
+    T_JpgComponent *scanComponent[JPG_COMPONENT_NUM_MAX];
+    T_JpgComponent *component;
+    uint8_t scanComponentNum;
+    uint32_t i, j, mcuX, mcuY, mcuCountX, mcuCountY, mcuIndex = 0, h, v;
+    T_DjiReturnCode returnCode;
+
+    if (!decoder->isFrameParsed || segmentLen < 1) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    scanComponentNum = segment[0];
+    if (scanComponentNum == 0 || scanComponentNum > decoder->componentNum || segmentLen < 4 + scanComponentNum * 2u) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+    for (i = 0; i < scanComponentNum; i++) {
+        scanComponent[i] = NULL;
+        for (j = 0; j < decoder->componentNum; j++) {
+            if (decoder->component[j].id == segment[1 + i * 2]) {
+                scanComponent[i] = &decoder->component[j];
+            }
+        }
+        if (scanComponent[i] == NULL) {
+            return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+        }
+        component = scanComponent[i];
+        component->dcTableId = segment[2 + i * 2] >> 4;
+        component->acTableId = segment[2 + i * 2] & 0x0F;
+        if (component->dcTableId >= JPG_TABLE_NUM_MAX || component->acTableId >= JPG_TABLE_NUM_MAX ||
+            !decoder->dcTable[component->dcTableId].isDefined || !decoder->acTable[component->acTableId].isDefined ||
+            !decoder->isQuantTableDefined[component->quantTableId]) {
+            return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+        }
+        component->dcPredictor = 0;
+    }
+
+    for (i = 0; i < decoder->componentNum; i++) {
+        component = &decoder->component[i];
+        if (component->plane != NULL) {
+            continue;
+        }
+        component->planeWidth = decoder->mcuCountX * component->h * decoder->blockSize;
+        component->planeHeight = decoder->mcuCountY * component->v * decoder->blockSize;
+        component->plane = osalHandler->Malloc(component->planeWidth * component->planeHeight);
+        if (component->plane == NULL) {
+            return DJI_ERROR_SYSTEM_MODULE_CODE_MEMORY_ALLOC_FAILED;
+        }
+        memset(component->plane, JPG_SAMPLE_CENTER, component->planeWidth * component->planeHeight);
+    }
+
+    decoder->reader.data = data;
+    decoder->reader.size = size;
+    decoder->reader.position = segmentPosition + segmentLen;
+    decoder->reader.bitBuffer = 0;
+    decoder->reader.bitCount = 0;
+    decoder->reader.isMarkerReached = false;
+
+    if (scanComponentNum == 1) {
+        //a non interleaved scan codes the blocks of a component one by one, its MCU is a single block
+        component = scanComponent[0];
+        mcuCountX = ((decoder->width * component->h + decoder->hMax - 1u) / decoder->hMax + JPG_BLOCK_SIZE - 1) /
+                    JPG_BLOCK_SIZE;
+        mcuCountY = ((decoder->height * component->v + decoder->vMax - 1u) / decoder->vMax + JPG_BLOCK_SIZE - 1) /
+                    JPG_BLOCK_SIZE;
+        for (mcuY = 0; mcuY < mcuCountY; mcuY++) {
+            for (mcuX = 0; mcuX < mcuCountX; mcuX++, mcuIndex++) {
+                if (decoder->restartInterval != 0 && mcuIndex != 0 && mcuIndex % decoder->restartInterval == 0) {
+                    returnCode = DjiMediaFile_JpgRestart(decoder, scanComponent, scanComponentNum);
+                    if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+                        return returnCode;
+                    }
+                }
+                returnCode = DjiMediaFile_JpgDecodeBlock(decoder, component, mcuX, mcuY);
+                if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+                    return returnCode;
+                }
+            }
+        }
+    } else {
+        for (mcuY = 0; mcuY < decoder->mcuCountY; mcuY++) {
+            for (mcuX = 0; mcuX < decoder->mcuCountX; mcuX++, mcuIndex++) {
+                if (decoder->restartInterval != 0 && mcuIndex != 0 && mcuIndex % decoder->restartInterval == 0) {
+                    returnCode = DjiMediaFile_JpgRestart(decoder, scanComponent, scanComponentNum);
+                    if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+                        return returnCode;
+                    }
+                }
+                for (i = 0; i < scanComponentNum; i++) {
+                    component = scanComponent[i];
+                    for (v = 0; v < component->v; v++) {
+                        for (h = 0; h < component->h; h++) {
+                            returnCode = DjiMediaFile_JpgDecodeBlock(decoder, component, mcuX * component->h + h,
+                                                                     mcuY * component->v + v);
+                            if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+                                return returnCode;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    decoder->isScanDecoded = true;
+    *nextPosition = decoder->reader.position;
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+static T_DjiReturnCode DjiMediaFile_JpgRestart(T_JpgDecoder *decoder, T_JpgComponent **scanComponent,
+                                               uint8_t scanComponentNum)
+{
+    T_JpgBitReader *reader = &decoder->reader;
+    uint32_t i;
+
+    //remaining bits of the interval are padding, the restart marker follows them
+    while (reader->position + 1 < reader->size &&
+           !(reader->data[reader->position] == JPG_MARKER_PREFIX &&
+             reader->data[reader->position + 1] >= JPG_MARKER_RST0 &&
+             reader->data[reader->position + 1] <= JPG_MARKER_RST7)) {
+        reader->position++;
+    }
+    if (reader->position + 1 >= reader->size) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    reader->position += 2;
+    reader->bitBuffer = 0;
+    reader->bitCount = 0;
+    reader->isMarkerReached = false;
+    for (i = 0; i < scanComponentNum; i++) {
+        scanComponent[i]->dcPredictor = 0;
+    }
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+static void DjiMediaFile_JpgFillBits(T_JpgBitReader *reader)
+{
+    uint32_t byte;
+
+    while (reader->bitCount <= 56) {
+        byte = 0;
+        //stuffed 0xFF 0x00 is a 0xFF data byte, any other marker ends the data and zero bits are fed after it
+        if (!reader->isMarkerReached && reader->position < reader->size) {
+            byte = reader->data[reader->position];
+            if (byte == JPG_MARKER_PREFIX) {
+                if (reader->position + 1 < reader->size && reader->data[reader->position + 1] == 0x00) {
+                    reader->position += 2;
+                } else {
+                    reader->isMarkerReached = true;
+                    byte = 0;
+                }
+            } else {
+                reader->position++;
+            }
+        }
+        reader->bitBuffer |= (uint64_t) byte << (56 - reader->bitCount);
+        reader->bitCount += 8;
+    }
+}
+
+static int32_t DjiMediaFile_JpgDecodeHuffman(T_JpgBitReader *reader, const T_JpgHuffmanTable *table)
+{
+    uint32_t index, code, length;
+
+    if (reader->bitCount < JPG_HUFFMAN_CODE_LENGTH_MAX) {
+        DjiMediaFile_JpgFillBits(reader);
+    }
+
+    index = (uint32_t) (reader->bitBuffer >> (64 - JPG_HUFFMAN_FAST_BITS));
+    length = table->fastLength[index];
+    if (length != 0) {
+        reader->bitBuffer <<= length;
+        reader->bitCount -= (int32_t) length;
+        return table->fastSymbol[index];
+    }
+
+    for (length = JPG_HUFFMAN_FAST_BITS + 1; length <= JPG_HUFFMAN_CODE_LENGTH_MAX; length++) {
+        code = (uint32_t) (reader->bitBuffer >> (64 - length));
+        if ((int32_t) code <= table->maxCode[length]) {
+            reader->bitBuffer <<= length;
+            reader->bitCount -= (int32_t) length;
+            return table->values[(table->valueOffset[length] + (int32_t) code) & 0xFF];
+        }
+    }
+
+    return -1;
+}
+
+static int32_t DjiMediaFile_JpgReceiveExtend(T_JpgBitReader *reader, uint8_t bitNum)
+{
+    uint32_t value;
+
+    if (bitNum == 0) {
+        return 0;
+    }
+
+    if (reader->bitCount < JPG_HUFFMAN_CODE_LENGTH_MAX) {
+        DjiMediaFile_JpgFillBits(reader);
+    }
+    value = (uint32_t) (reader->bitBuffer >> (64 - bitNum));
+    reader->bitBuffer <<= bitNum;
+    reader->bitCount -= bitNum;
+
+    if (value < (1u << (bitNum - 1))) {
+        return (int32_t) value - (int32_t) ((1u << bitNum) - 1);
+    }
+
+    return (int32_t) value;
+}
+
+static T_DjiReturnCode DjiMediaFile_JpgDecodeBlock(T_JpgDecoder *decoder, T_JpgComponent *component,
+                                                   uint32_t blockX, uint32_t blockY)
+{
+    const uint16_t *quantTable = decoder->quantTable[component->quantTableId];
+    const T_JpgHuffmanTable *acTable = &decoder->acTable[component->acTableId];
+    T_JpgBitReader *reader = &decoder->reader;
+    uint8_t blockSize = decoder->blockSize;
+    int32_t coef[JPG_BLOCK_COEF_NUM];
+    float temp[JPG_BLOCK_SIZE][JPG_BLOCK_SIZE];
+    int32_t symbol, k, natural, fastAc;
+    uint8_t *out;
+    uint32_t x, y, u;
+    float sum;
+
+    symbol = DjiMediaFile_JpgDecodeHuffman(reader, &decoder->dcTable[component->dcTableId]);
+    if (symbol < 0 || symbol > JPG_HUFFMAN_CODE_LENGTH_MAX) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+    component->dcPredictor += DjiMediaFile_JpgReceiveExtend(reader, (uint8_t) symbol);
+
+    memset(coef, 0, sizeof(coef));
+    coef[0] = component->dcPredictor * quantTable[0];
+
+    //every coefficient has to be decoded to find the next block, only the low frequency ones are kept
+    for (k = 1; k < JPG_BLOCK_COEF_NUM; k++) {
+        if (reader->bitCount < JPG_HUFFMAN_CODE_LENGTH_MAX) {
+            DjiMediaFile_JpgFillBits(reader);
+        }
+        fastAc = acTable->fastAc[reader->bitBuffer >> (64 - JPG_HUFFMAN_FAST_BITS)];
+        if (fastAc != 0) {
+            reader->bitBuffer <<= fastAc & 0x0F;
+            reader->bitCount -= fastAc & 0x0F;
+            k += (fastAc >> 4) & 0x0F;
+            if (k >= JPG_BLOCK_COEF_NUM) {
+                return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+            }
+            natural = s_jpgNaturalOrder[k];
+            if ((natural & 7) < blockSize && (natural >> 3) < blockSize) {
+                coef[natural] = (fastAc >> 8) * quantTable[natural];
+            }
+            continue;
+        }
+
+        symbol = DjiMediaFile_JpgDecodeHuffman(reader, acTable);
+        if (symbol < 0) {
+            return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+        }
+        if ((symbol & 0x0F) == 0) {
+            if (symbol != 0xF0) {
+                break;
+            }
+            k += 15;
+            continue;
+        }
+        k += symbol >> 4;
+        if (k >= JPG_BLOCK_COEF_NUM) {
+            return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+        }
+        natural = s_jpgNaturalOrder[k];
+        if ((natural & 7) < blockSize && (natural >> 3) < blockSize) {
+            coef[natural] = DjiMediaFile_JpgReceiveExtend(reader, (uint8_t) (symbol & 0x0F)) * quantTable[natural];
+        } else {
+            DjiMediaFile_JpgReceiveExtend(reader, (uint8_t) (symbol & 0x0F));
+        }
+    }
+
+    out = &component->plane[blockY * blockSize * component->planeWidth + blockX * blockSize];
+    if (blockSize == 1) {
+        *out = DjiMediaFile_JpgClamp((coef[0] + (coef[0] >= 0 ? 4 : -4)) / JPG_BLOCK_SIZE + JPG_SAMPLE_CENTER);
+        return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+    }
+
+    for (y = 0; y < blockSize; y++) {
+        for (x = 0; x < blockSize; x++) {
+            sum = 0;
+            for (u = 0; u < blockSize; u++) {
+                sum += (float) coef[y * JPG_BLOCK_SIZE + u] * decoder->idctTable[x][u];
+            }
+            temp[y][x] = sum;
+        }
+    }
+    for (y = 0; y < blockSize; y++) {
+        for (x = 0; x < blockSize; x++) {
+            sum = JPG_SAMPLE_CENTER + 0.5f;
+            for (u = 0; u < blockSize; u++) {
+                sum += decoder->idctTable[y][u] * temp[u][x];
+            }
+            out[y * component->planeWidth + x] = DjiMediaFile_JpgClamp((int32_t) sum);
+        }
+    }
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+static T_DjiReturnCode DjiMediaFile_JpgOutputImage(const T_JpgDecoder *decoder, T_DjiMediaFileImage *image)
+{
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+    const T_JpgComponent *component = decoder->component;
+    const uint8_t *lumaRow, *cbRow, *crRow;
+    uint32_t x, y;
+    int32_t luma, cb, cr;
+    uint8_t *pixel;
+
+    image->width = (uint16_t) (((uint32_t) decoder->width * decoder->blockSize + JPG_BLOCK_SIZE - 1) /
+                               JPG_BLOCK_SIZE);
+    image->height = (uint16_t) (((uint32_t) decoder->height * decoder->blockSize + JPG_BLOCK_SIZE - 1) /
+                                JPG_BLOCK_SIZE);
+    image->componentNum = decoder->componentNum;
+    image->pixels = osalHandler->Malloc((uint32_t) image->width * image->height * image->componentNum);
+    if (image->pixels == NULL) {
+        memset(image, 0, sizeof(T_DjiMediaFileImage));
+        return DJI_ERROR_SYSTEM_MODULE_CODE_MEMORY_ALLOC_FAILED;
+    }
+
+    pixel = image->pixels;
+    for (y = 0; y < image->height; y++) {
+        lumaRow = &component[0].plane[y * component[0].v / decoder->vMax * component[0].planeWidth];
+        if (decoder->componentNum == DJI_MEDIA_FILE_IMAGE_COMPONENT_NUM_GRAY) {
+            for (x = 0; x < image->width; x++) {
+                *pixel++ = lumaRow[x * component[0].h / decoder->hMax];
+            }
+            continue;
+        }
+
+        cbRow = &component[1].plane[y * component[1].v / decoder->vMax * component[1].planeWidth];
+        crRow = &component[2].plane[y * component[2].v / decoder->vMax * component[2].planeWidth];
+        for (x = 0; x < image->width; x++) {
+            luma = (int32_t) lumaRow[x * component[0].h / decoder->hMax] << JPG_COLOR_FIX_SHIFT;
+            cb = (int32_t) cbRow[x * component[1].h / decoder->hMax] - JPG_SAMPLE_CENTER;
+            cr = (int32_t) crRow[x * component[2].h / decoder->hMax] - JPG_SAMPLE_CENTER;
+            *pixel++ = DjiMediaFile_JpgClamp((luma + JPG_COLOR_CR_TO_R * cr + JPG_COLOR_FIX_HALF) >>
+                                                                                                  JPG_COLOR_FIX_SHIFT);
+            *pixel++ = DjiMediaFile_JpgClamp((luma - JPG_COLOR_CB_TO_G * cb - JPG_COLOR_CR_TO_G * cr +
+                                              JPG_COLOR_FIX_HALF) >> JPG_COLOR_FIX_SHIFT);
+            *pixel++ = DjiMediaFile_JpgClamp((luma + JPG_COLOR_CB_TO_B * cb + JPG_COLOR_FIX_HALF) >>
+                                                                                                  JPG_COLOR_FIX_SHIFT);
+        }
+    }
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+static void DjiMediaFile_JpgFreeDecoder(T_JpgDecoder *decoder)
+{
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+    uint32_t i;
+
+    for (i = 0; i < JPG_COMPONENT_NUM_MAX; i++) {
+        if (decoder->component[i].plane != NULL) {
+            osalHandler->Free(decoder->component[i].plane);
+        }
+    }
+    osalHandler->Free(decoder);
+}
+
+static uint8_t DjiMediaFile_JpgClamp(int32_t value)
+{
+    return (uint8_t) (value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+static void DjiMediaFile_JpgPutByte(T_JpgEncoder *encoder, uint8_t byte)
+{
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+    uint8_t *data;
+
+    if (encoder->isOutOfMemory) {
+        return;
+    }
+
+    if (encoder->size == encoder->capacity) {
+        data = osalHandler->Malloc(encoder->capacity * 2);
+        if (data == NULL) {
+            encoder->isOutOfMemory = true;
+            return;
+        }
+        memcpy(data, encoder->data, encoder->size);
+        osalHandler->Free(encoder->data);
+        encoder->data = data;
+        encoder->capacity *= 2;
+    }
+
+    encoder->data[encoder->size++] = byte;
+}
+
+static void DjiMediaFile_JpgPutU16(T_JpgEncoder *encoder, uint16_t value)
+{
+    DjiMediaFile_JpgPutByte(encoder, (uint8_t) (value >> 8));
+    DjiMediaFile_JpgPutByte(encoder, (uint8_t) value);
+}
+
+static void DjiMediaFile_JpgPutBits(T_JpgEncoder *encoder, uint32_t bits, uint8_t bitNum)
+{
+    uint8_t byte;
+
+    encoder->bitBuffer = (encoder->bitBuffer << bitNum) | (bits & ((1u << bitNum) - 1));
+    encoder->bitCount += bitNum;
+    while (encoder->bitCount >= 8) {
+        byte = (uint8_t) (encoder->bitBuffer >> (encoder->bitCount - 8));
+        DjiMediaFile_JpgPutByte(encoder, byte);
+        if (byte == JPG_MARKER_PREFIX) {
+            DjiMediaFile_JpgPutByte(encoder, 0x00);
+        }
+        encoder->bitCount -= 8;
+    }
+}
+
+static void DjiMediaFile_JpgPutHeaders(T_JpgEncoder *encoder, const T_DjiMediaFileImage *image)
+{
+    static const uint8_t jfifHeader[] = {'J', 'F', 'I', 'F', 0, 1, 1, 0, 0, 1, 0, 1, 0, 0};
+    uint8_t tableNum = image->componentNum == DJI_MEDIA_FILE_IMAGE_COMPONENT_NUM_RGB ? 2 : 1;
+    uint32_t i, k;
+
+    DjiMediaFile_JpgPutByte(encoder, JPG_MARKER_PREFIX);
+    DjiMediaFile_JpgPutByte(encoder, JPG_MARKER_SOI);
+
+    DjiMediaFile_JpgPutByte(encoder, JPG_MARKER_PREFIX);
+    DjiMediaFile_JpgPutByte(encoder, JPG_MARKER_APP0);
+    DjiMediaFile_JpgPutU16(encoder, 2 + sizeof(jfifHeader));
+    for (i = 0; i < sizeof(jfifHeader); i++) {
+        DjiMediaFile_JpgPutByte(encoder, jfifHeader[i]);
+    }
+
+    DjiMediaFile_JpgPutByte(encoder, JPG_MARKER_PREFIX);
+    DjiMediaFile_JpgPutByte(encoder, JPG_MARKER_DQT);
+    DjiMediaFile_JpgPutU16(encoder, 2 + tableNum * (1 + JPG_BLOCK_COEF_NUM));
+    for (i = 0; i < tableNum; i++) {
+        DjiMediaFile_JpgPutByte(encoder, (uint8_t) i);
+        for (k = 0; k < JPG_BLOCK_COEF_NUM; k++) {
+            DjiMediaFile_JpgPutByte(encoder, encoder->quantTable[i][s_jpgNaturalOrder[k]]);
+        }
+    }
+
+    DjiMediaFile_JpgPutByte(encoder, JPG_MARKER_PREFIX);
+    DjiMediaFile_JpgPutByte(encoder, JPG_MARKER_SOF0);
+    DjiMediaFile_JpgPutU16(encoder, 8 + image->componentNum * 3);
+    DjiMediaFile_JpgPutByte(encoder, JPG_SAMPLE_PRECISION);
+    DjiMediaFile_JpgPutU16(encoder, image->height);
+    DjiMediaFile_JpgPutU16(encoder, image->width);
+    DjiMediaFile_JpgPutByte(encoder, image->componentNum);
+    for (i = 0; i < image->componentNum; i++) {
+        DjiMediaFile_JpgPutByte(encoder, (uint8_t) (i + 1));
+        DjiMediaFile_JpgPutByte(encoder, i == 0 && tableNum == 2 ? 0x22 : 0x11);
+        DjiMediaFile_JpgPutByte(encoder, i == 0 ? 0 : 1);
+    }
+
+    DjiMediaFile_JpgPutHuffmanTable(encoder, 0x00, s_jpgDcLuminanceBits, s_jpgDcValues,
+                                    JPG_ENCODE_HUFFMAN_DC_SYMBOL_NUM);
+    DjiMediaFile_JpgPutHuffmanTable(encoder, 0x10, s_jpgAcLuminanceBits, s_jpgAcLuminanceValues,
+                                    JPG_ENCODE_HUFFMAN_AC_SYMBOL_NUM);
+    if (tableNum == 2) {
+        DjiMediaFile_JpgPutHuffmanTable(encoder, 0x01, s_jpgDcChrominanceBits, s_jpgDcValues,
+                                        JPG_ENCODE_HUFFMAN_DC_SYMBOL_NUM);
+        DjiMediaFile_JpgPutHuffmanTable(encoder, 0x11, s_jpgAcChrominanceBits, s_jpgAcChrominanceValues,
+                                        JPG_ENCODE_HUFFMAN_AC_SYMBOL_NUM);
+    }
+
+    DjiMediaFile_JpgPutByte(encoder, JPG_MARKER_PREFIX);
+    DjiMediaFile_JpgPutByte(encoder, JPG_MARKER_SOS);
+    DjiMediaFile_JpgPutU16(encoder, 6 + image->componentNum * 2);
+    DjiMediaFile_JpgPutByte(encoder, image->componentNum);
+    for (i = 0; i < image->componentNum; i++) {
+        DjiMediaFile_JpgPutByte(encoder, (uint8_t) (i + 1));
+        DjiMediaFile_JpgPutByte(encoder, i == 0 ? 0x00 : 0x11);
+    }
+    DjiMediaFile_JpgPutByte(encoder, 0);
+    DjiMediaFile_JpgPutByte(encoder, JPG_BLOCK_COEF_NUM - 1);
+    DjiMediaFile_JpgPutByte(encoder, 0);
+}
+
+static void DjiMediaFile_JpgPutHuffmanTable(T_JpgEncoder *encoder, uint8_t tableClassAndId, const uint8_t *bits,
+                                            const uint8_t *values, uint32_t valueNum)
+{
+    uint32_t i;
+
+    DjiMediaFile_JpgPutByte(encoder, JPG_MARKER_PREFIX);
+    DjiMediaFile_JpgPutByte(encoder, JPG_MARKER_DHT);
+    DjiMediaFile_JpgPutU16(encoder, (uint16_t) (3 + JPG_HUFFMAN_CODE_LENGTH_MAX + valueNum));
+    DjiMediaFile_JpgPutByte(encoder, tableClassAndId);
+    for (i = 0; i < JPG_HUFFMAN_CODE_LENGTH_MAX; i++) {
+        DjiMediaFile_JpgPutByte(encoder, bits[i]);
+    }
+    for (i = 0; i < valueNum; i++) {
+        DjiMediaFile_JpgPutByte(encoder, values[i]);
+    }
+}
+
+static void DjiMediaFile_JpgBuildHuffmanCode(const uint8_t *bits, const uint8_t *values, uint16_t *code,
+                                             uint8_t *codeLength)
+{
+    uint32_t length, i, valueIndex = 0;
+    uint16_t nextCode = 0;
+
+    for (length = 1; length <= JPG_HUFFMAN_CODE_LENGTH_MAX; length++) {
+        for (i = 0; i < bits[length - 1]; i++) {
+            code[values[valueIndex]] = nextCode++;
+            codeLength[values[valueIndex]] = (uint8_t) length;
+            valueIndex++;
+        }
+        nextCode <<= 1;
+    }
+}
+
+static void DjiMediaFile_JpgEncodeBlock(T_JpgEncoder *encoder, const float *block, uint8_t tableId,
+                                        int32_t *dcPredictor)
+{
+    const uint8_t *quantTable = encoder->quantTable[tableId];
+    float temp[JPG_BLOCK_SIZE][JPG_BLOCK_SIZE];
+    int32_t coef[JPG_BLOCK_COEF_NUM];
+    uint32_t x, y, u, k, run = 0;
+    uint8_t bitNum;
+    int32_t value;
+    float sum;
+
+    for (u = 0; u < JPG_BLOCK_SIZE; u++) {
+        for (x = 0; x < JPG_BLOCK_SIZE; x++) {
+            sum = 0;
+            for (y = 0; y < JPG_BLOCK_SIZE; y++) {
+                sum += encoder->fdctTable[u][y] * block[y * JPG_BLOCK_SIZE + x];
+            }
+            temp[u][x] = sum;
+        }
+    }
+    for (y = 0; y < JPG_BLOCK_SIZE; y++) {
+        for (u = 0; u < JPG_BLOCK_SIZE; u++) {
+            sum = 0;
+            for (x = 0; x < JPG_BLOCK_SIZE; x++) {
+                sum += encoder->fdctTable[u][x] * temp[y][x];
+            }
+            sum /= quantTable[y * JPG_BLOCK_SIZE + u];
+            coef[y * JPG_BLOCK_SIZE + u] = (int32_t) (sum >= 0 ? sum + 0.5f : sum - 0.5f);
+        }
+    }
+
+    value = coef[0] - *dcPredictor;
+    *dcPredictor = coef[0];
+    bitNum = DjiMediaFile_JpgGetBitNum(value);
+    DjiMediaFile_JpgPutBits(encoder, encoder->dcCode[tableId][bitNum], encoder->dcCodeLength[tableId][bitNum]);
+    if (bitNum != 0) {
+        DjiMediaFile_JpgPutBits(encoder, (uint32_t) (value < 0 ? value - 1 : value), bitNum);
+    }
+
+    for (k = 1; k < JPG_BLOCK_COEF_NUM; k++) {
+        value = coef[s_jpgNaturalOrder[k]];
+        if (value == 0) {
+            run++;
+            continue;
+        }
+        while (run > 15) {
+            DjiMediaFile_JpgPutBits(encoder, encoder->acCode[tableId][0xF0], encoder->acCodeLength[tableId][0xF0]);
+            run -= 16;
+        }
+        bitNum = DjiMediaFile_JpgGetBitNum(value);
+        DjiMediaFile_JpgPutBits(encoder, encoder->acCode[tableId][(run << 4) | bitNum],
+                                encoder->acCodeLength[tableId][(run << 4) | bitNum]);
+        DjiMediaFile_JpgPutBits(encoder, (uint32_t) (value < 0 ? value - 1 : value), bitNum);
+        run = 0;
+    }
+    if (run > 0) {
+        DjiMediaFile_JpgPutBits(encoder, encoder->acCode[tableId][0x00], encoder->acCodeLength[tableId][0x00]);
+    }
+}
+
+static uint8_t DjiMediaFile_JpgGetBitNum(int32_t value)
+{
+    uint32_t magnitude = (uint32_t) (value < 0 ? -value : value);
+    uint8_t bitNum = 0;
+
+    while (magnitude != 0) {
+        bitNum++;
+        magnitude >>= 1;
+    }
+
+    return bitNum;
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
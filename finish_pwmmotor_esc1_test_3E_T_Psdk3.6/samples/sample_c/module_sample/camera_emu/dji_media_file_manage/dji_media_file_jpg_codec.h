@@ -0,0 +1,69 @@
+/**
+ ********************************************************************
+ * @file    dji_media_file_jpg_codec.h
+ * @brief   This is the header file for "dji_media_file_jpg_codec.c", defining the structure and
+ * (exported) function prototypes.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef PSDK_MEDIA_FILE_JPG_CODEC_H
+#define PSDK_MEDIA_FILE_JPG_CODEC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <dji_typedef.h>
+
+/* Exported constants --------------------------------------------------------*/
+#define DJI_MEDIA_FILE_IMAGE_COMPONENT_NUM_GRAY     1
+#define DJI_MEDIA_FILE_IMAGE_COMPONENT_NUM_RGB      3
+
+/* Exported types ------------------------------------------------------------*/
+// pixels are row major without padding, a pixel is one gray byte or R, G and B bytes
+typedef struct {
+    uint16_t width;
+    uint16_t height;
+    uint8_t componentNum;
+    uint8_t *pixels;
+} T_DjiMediaFileImage;
+
+/* Exported functions --------------------------------------------------------*/
+T_DjiReturnCode DjiMediaFile_JpgGetImageSize(const uint8_t *data, uint32_t size, uint16_t *width, uint16_t *height);
+T_DjiReturnCode DjiMediaFile_JpgGetExifThumbnail(const uint8_t *data, uint32_t size, uint32_t *thumbnailOffset,
+                                                 uint32_t *thumbnailSize);
+T_DjiReturnCode DjiMediaFile_JpgDecode(const uint8_t *data, uint32_t size, uint16_t minWidth,
+                                       T_DjiMediaFileImage *image);
+T_DjiReturnCode DjiMediaFile_JpgEncode(const T_DjiMediaFileImage *image, uint8_t quality, uint8_t **data,
+                                       uint32_t *size);
+
+T_DjiReturnCode DjiMediaFile_ImageResize(const T_DjiMediaFileImage *srcImage, uint16_t width, uint16_t height,
+                                         T_DjiMediaFileImage *dstImage);
+void DjiMediaFile_ImageFree(T_DjiMediaFileImage *image);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PSDK_MEDIA_FILE_JPG_CODEC_H
+
+/************************ (C) COPYRIGHT DJI Innovations *******END OF FILE******/
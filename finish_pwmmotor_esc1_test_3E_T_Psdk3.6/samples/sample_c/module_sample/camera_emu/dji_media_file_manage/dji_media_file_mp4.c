@@ -26,35 +26,23 @@
 /* Includes ------------------------------------------------------------------*/
 #include "dji_media_file_mp4.h"
 #include "dji_media_file_core.h"
+#include "dji_media_file_preview.h"
 #include <string.h>
 #include <unistd.h>
 #include <stdio.h>
 #include <dji_logger.h>
 #include <stdlib.h>
 #include "dji_platform.h"
-#include "utils/util_time.h"
 #include "utils/util_file.h"
 
 /* Private constants ---------------------------------------------------------*/
 
 #define MP4_FILE_SUFFIX                 ".mp4"
-#define MP4_TEMP_FILE_TEMPLATE_STR      "MP4_TEMP_XXXXXX.jpg"
-#define MP4_TEMP_FILE_PATH_MAX_LEN      50
 #define FFMPEG_CMD_BUF_SIZE             (256 + 256)
 
-#define MP4_THM_SCALE_CFG_STR           "scale=100:-1"
-#define MP4_SCR_SCALE_CFG_STR           "scale=600:-1"
-
 /* Private types -------------------------------------------------------------*/
-typedef struct {
-    FILE *tempFile;
-    char tempfilePath[MP4_TEMP_FILE_PATH_MAX_LEN];
-} T_DjiMP4TempPicPriv;
 
 /* Private functions declaration ---------------------------------------------*/
-static T_DjiReturnCode DjiMediaFile_CreateTempPicPriv_MP4(const char *srcFilePath, const char *scaleCfgStr,
-                                                          T_DjiMP4TempPicPriv **pTempPicPrivHandle);
-static T_DjiReturnCode DjiMediaFile_DestroyTempPicPriv_MP4(T_DjiMP4TempPicPriv *tempPicPrivHandle);
 
 /* Private values ------------------------------------------------------------*/
 
@@ -127,136 +115,58 @@ T_DjiReturnCode DjiMediaFile_GetFileSizeOrigin_MP4(struct _DjiMediaFile *mediaFi
 
 T_DjiReturnCode DjiMediaFile_CreateThumbNail_MP4(struct _DjiMediaFile *mediaFileHandle)
 {
-
-    return DjiMediaFile_CreateTempPicPriv_MP4(mediaFileHandle->filePath, MP4_THM_SCALE_CFG_STR,
-                                              (T_DjiMP4TempPicPriv **) &mediaFileHandle->mediaFileThm.privThm);
+    return DjiMediaFile_PreviewCreate(mediaFileHandle->filePath, DJI_MEDIA_FILE_PREVIEW_SOURCE_MP4,
+                                      DJI_MEDIA_FILE_PREVIEW_TYPE_THUMBNAIL,
+                                      (T_DjiMediaFilePreview **) &mediaFileHandle->mediaFileThm.privThm);
 }
 
 T_DjiReturnCode DjiMediaFile_GetFileSizeThumbNail_MP4(struct _DjiMediaFile *mediaFileHandle, uint32_t *fileSize)
 {
-    T_DjiMP4TempPicPriv *jpgFileThmPriv = (T_DjiMP4TempPicPriv *) mediaFileHandle->mediaFileThm.privThm;
+    T_DjiMediaFilePreview *thumbNail = (T_DjiMediaFilePreview *) mediaFileHandle->mediaFileThm.privThm;
+
+    *fileSize = thumbNail->size;
 
-    return UtilFile_GetFileSize(jpgFileThmPriv->tempFile, fileSize);
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
 }
 
 T_DjiReturnCode
 DjiMediaFile_GetDataThumbNail_MP4(struct _DjiMediaFile *mediaFileHandle, uint32_t offset, uint16_t len,
                                   uint8_t *data, uint16_t *realLen)
 {
-    T_DjiMP4TempPicPriv *jpgFileThmPriv = (T_DjiMP4TempPicPriv *) mediaFileHandle->mediaFileThm.privThm;
-
-    return UtilFile_GetFileData(jpgFileThmPriv->tempFile, offset, len, data, realLen);
+    return DjiMediaFile_PreviewGetData(mediaFileHandle->mediaFileThm.privThm, offset, len, data, realLen);
 }
 
-T_DjiReturnCode DjiMediaFile_DestroyThumbNail_MP4(struct _DjiMediaFile *MediaFileHandle)
+T_DjiReturnCode DjiMediaFile_DestroyThumbNail_MP4(struct _DjiMediaFile *mediaFileHandle)
 {
-    return DjiMediaFile_DestroyTempPicPriv_MP4(MediaFileHandle->mediaFileThm.privThm);
+    return DjiMediaFile_PreviewDestroy(mediaFileHandle->mediaFileThm.privThm);
 }
 
 T_DjiReturnCode DjiMediaFile_CreateScreenNail_MP4(struct _DjiMediaFile *mediaFileHandle)
 {
-    return DjiMediaFile_CreateTempPicPriv_MP4(mediaFileHandle->filePath, MP4_SCR_SCALE_CFG_STR,
-                                              (T_DjiMP4TempPicPriv **) &mediaFileHandle->mediaFileScr.privScr);
+    return DjiMediaFile_PreviewCreate(mediaFileHandle->filePath, DJI_MEDIA_FILE_PREVIEW_SOURCE_MP4,
+                                      DJI_MEDIA_FILE_PREVIEW_TYPE_SCREENNAIL,
+                                      (T_DjiMediaFilePreview **) &mediaFileHandle->mediaFileScr.privScr);
 }
 
 T_DjiReturnCode DjiMediaFile_GetFileSizeScreenNail_MP4(struct _DjiMediaFile *mediaFileHandle, uint32_t *fileSize)
 {
-    T_DjiMP4TempPicPriv *jpgFileScrPriv = (T_DjiMP4TempPicPriv *) mediaFileHandle->mediaFileScr.privScr;
+    T_DjiMediaFilePreview *screenNail = (T_DjiMediaFilePreview *) mediaFileHandle->mediaFileScr.privScr;
+
+    *fileSize = screenNail->size;
 
-    return UtilFile_GetFileSize(jpgFileScrPriv->tempFile, fileSize);
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
 }
 
 T_DjiReturnCode
 DjiMediaFile_GetDataScreenNail_MP4(struct _DjiMediaFile *mediaFileHandle, uint32_t offset, uint16_t len,
                                    uint8_t *data, uint16_t *realLen)
 {
-    T_DjiMP4TempPicPriv *jpgFileScrPriv = (T_DjiMP4TempPicPriv *) mediaFileHandle->mediaFileScr.privScr;
-
-    return UtilFile_GetFileData(jpgFileScrPriv->tempFile, offset, len, data, realLen);
+    return DjiMediaFile_PreviewGetData(mediaFileHandle->mediaFileScr.privScr, offset, len, data, realLen);
 }
 
 T_DjiReturnCode DjiMediaFile_DestroyScreenNail_MP4(struct _DjiMediaFile *mediaFileHandle)
 {
-    return DjiMediaFile_DestroyTempPicPriv_MP4(mediaFileHandle->mediaFileScr.privScr);
-}
-
-/* Private functions definition-----------------------------------------------*/
-static T_DjiReturnCode DjiMediaFile_CreateTempPicPriv_MP4(const char *srcFilePath, const char *scaleCfgStr,
-                                                          T_DjiMP4TempPicPriv **pTempPicPrivHandle)
-{
-    char ffmpeg_cmd[FFMPEG_CMD_BUF_SIZE];
-    int cmdRet;
-    T_DjiRunTimeStamps tiStart, tiEnd;
-    T_DjiMP4TempPicPriv *mp4TempPicFile;
-    T_DjiReturnCode psdkStat;
-    int tempFd;
-    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
-
-    tiStart = DjiUtilTime_GetRunTimeStamps();
-
-    *pTempPicPrivHandle = osalHandler->Malloc(sizeof(T_DjiMP4TempPicPriv));
-    if (*pTempPicPrivHandle == NULL) {
-        return DJI_ERROR_SYSTEM_MODULE_CODE_MEMORY_ALLOC_FAILED;
-    }
-
-    mp4TempPicFile = *pTempPicPrivHandle;
-
-    //get temp file name
-    strcpy(mp4TempPicFile->tempfilePath, MP4_TEMP_FILE_TEMPLATE_STR);
-    tempFd = mkstemps(mp4TempPicFile->tempfilePath, strlen(MP4_FILE_SUFFIX));
-    if (tempFd < 0) {
-        USER_LOG_ERROR("JPG Create Temp File Error, tempFd = %d\n", tempFd);
-        psdkStat = DJI_ERROR_SYSTEM_MODULE_CODE_SYSTEM_ERROR;
-        goto err_create_temp;
-    }
-    close(tempFd);
-    unlink(mp4TempPicFile->tempfilePath);
-
-    //ffmpeg cmd send
-    snprintf(ffmpeg_cmd, FFMPEG_CMD_BUF_SIZE, "ffmpeg -i \"%s\" -vf %s -ss 00:00:00 -vframes 1 %s 1>/dev/null 2>&1",
-             srcFilePath, scaleCfgStr, mp4TempPicFile->tempfilePath);
-
-    cmdRet = system(ffmpeg_cmd);
-
-    tiEnd = DjiUtilTime_GetRunTimeStamps();
-
-    USER_LOG_DEBUG("JPG Create TempFile, RealTime = %ld us\n", tiEnd.realUsec - tiStart.realUsec);
-
-    if (cmdRet != 0) {
-        USER_LOG_ERROR("JPG ffmpeg cmd call error, ret = %d\n", cmdRet);
-        psdkStat = DJI_ERROR_SYSTEM_MODULE_CODE_SYSTEM_ERROR;
-        goto err_system_cmd;
-    }
-
-    //open temp file
-    mp4TempPicFile->tempFile = fopen(mp4TempPicFile->tempfilePath, "rb+");
-    if (mp4TempPicFile->tempFile == NULL) {
-        psdkStat = DJI_ERROR_SYSTEM_MODULE_CODE_SYSTEM_ERROR;
-        goto err_file_open;
-    }
-
-    //unlink temp file
-    unlink(mp4TempPicFile->tempfilePath);
-
-    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
-
-err_file_open:
-    unlink(mp4TempPicFile->tempfilePath);
-err_system_cmd:
-err_create_temp:
-    osalHandler->Free(*pTempPicPrivHandle);
-
-    return psdkStat;
-}
-
-static T_DjiReturnCode DjiMediaFile_DestroyTempPicPriv_MP4(T_DjiMP4TempPicPriv *tempPicPrivHandle)
-{
-    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
-
-    fclose(tempPicPrivHandle->tempFile);
-    osalHandler->Free(tempPicPrivHandle);
-
-    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+    return DjiMediaFile_PreviewDestroy(mediaFileHandle->mediaFileScr.privScr);
 }
 
 /****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
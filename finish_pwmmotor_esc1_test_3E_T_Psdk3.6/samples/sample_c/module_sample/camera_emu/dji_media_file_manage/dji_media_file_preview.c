@@ -0,0 +1,863 @@
+/**
+ ********************************************************************
+ * @file    dji_media_file_preview.c
+ * @brief   Thumbnails and screennails of media files, made in process by the JPEG codec of
+ *          dji_media_file_jpg_codec.c and kept in a size bounded LRU memory cache and an optional disk cache, so
+ *          browsing the file list again costs no decoding at all.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "dji_media_file_preview.h"
+#include "dji_media_file_core.h"
+#include "dji_media_file_jpg_codec.h"
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <dji_logger.h>
+#include "dji_platform.h"
+
+/* Private constants ---------------------------------------------------------*/
+#define PREVIEW_HASH_BUCKET_NUM             256
+//Exif APP1 segment is at most 64KB and comes right after SOI or JFIF APP0
+#define PREVIEW_JPG_HEAD_READ_SIZE          (128 * 1024)
+#define PREVIEW_JPG_QUALITY                 85
+
+#define PREVIEW_FFMPEG_CMD_BUF_SIZE         (PSDK_MEDIA_FILE_PATH_LEN_MAX + 256)
+#define PREVIEW_FFMPEG_READ_SIZE            (64 * 1024)
+#define PREVIEW_FFMPEG_OUTPUT_SIZE_MAX      (16 * 1024 * 1024)
+
+#define PREVIEW_DISK_CACHE_MAGIC            0x57565250 // "PRVW", also rejects a cache of other byte order
+#define PREVIEW_DISK_CACHE_VERSION          1
+#define PREVIEW_DISK_CACHE_SIZE_MAX         (4 * 1024 * 1024)
+#define PREVIEW_FNV_OFFSET                  14695981039346656037ULL
+#define PREVIEW_FNV_PRIME                   1099511628211ULL
+
+/* Private types -------------------------------------------------------------*/
+// a preview is valid only while the media file it is made from keeps its size and modify time
+typedef struct {
+    uint64_t sourceFileSize;
+    int64_t sourceModifyTimeNs;
+} T_PreviewKey;
+
+typedef struct _PreviewCacheItem {
+    struct _PreviewCacheItem *hashNext;
+    struct _PreviewCacheItem *lruPrev;
+    struct _PreviewCacheItem *lruNext;
+    uint64_t pathHash;
+    E_DjiMediaFilePreviewType type;
+    T_PreviewKey key;
+    uint32_t allocSize;
+    uint32_t size;
+    uint8_t *data;
+    char *filePath;
+} T_PreviewCacheItem;
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t type;
+    uint64_t sourceFileSize;
+    int64_t sourceModifyTimeNs;
+    uint32_t pathLen;
+    uint32_t dataSize;
+    uint64_t checksum;
+} T_PreviewDiskCacheHeader;
+
+typedef struct {
+    uint16_t width;
+    const char *suffix;
+} T_PreviewTypeInfo;
+
+/* Private values -------------------------------------------------------------*/
+static const T_PreviewTypeInfo s_previewTypeInfo[DJI_MEDIA_FILE_PREVIEW_TYPE_NUM] = {
+    {DJI_MEDIA_FILE_PREVIEW_THUMBNAIL_WIDTH,  "thm"},
+    {DJI_MEDIA_FILE_PREVIEW_SCREENNAIL_WIDTH, "scr"},
+};
+
+static bool s_isPreviewInited = false;
+static T_DjiMutexHandle s_previewMutex = NULL;
+static uint32_t s_previewMemoryCacheSizeMax = 0;
+static char s_previewDiskCacheDirPath[PSDK_MEDIA_DIR_PATH_LEN_MAX] = {0};
+static T_PreviewCacheItem *s_previewHashTable[PREVIEW_HASH_BUCKET_NUM] = {0};
+static T_PreviewCacheItem *s_previewLruHead = NULL;
+static T_PreviewCacheItem *s_previewLruTail = NULL;
+static T_DjiMediaFilePreviewStatistics s_previewStatistics = {0};
+
+/* Private functions declaration ---------------------------------------------*/
+static T_DjiReturnCode DjiMediaFile_PreviewGetKey(const char *filePath, T_PreviewKey *key);
+static uint64_t DjiMediaFile_PreviewGetHash(const uint8_t *data, uint32_t len);
+static T_DjiReturnCode DjiMediaFile_PreviewNew(uint8_t *data, uint32_t size, bool isCopy,
+                                               T_DjiMediaFilePreview **preview);
+
+static T_DjiMediaFilePreview *DjiMediaFile_PreviewLookUpMemoryCache(const char *filePath, uint64_t pathHash,
+                                                                    E_DjiMediaFilePreviewType type,
+                                                                    const T_PreviewKey *key);
+static void DjiMediaFile_PreviewInsertMemoryCache(const char *filePath, uint64_t pathHash,
+                                                  E_DjiMediaFilePreviewType type, const T_PreviewKey *key,
+                                                  const T_DjiMediaFilePreview *preview);
+static void DjiMediaFile_PreviewRemoveMemoryCacheItem(T_PreviewCacheItem *item);
+
+static void DjiMediaFile_PreviewGetDiskCachePath(uint64_t pathHash, E_DjiMediaFilePreviewType type,
+                                                 char *cachePath, uint32_t cachePathSize);
+static T_DjiReturnCode DjiMediaFile_PreviewLoadDiskCache(const char *filePath, uint64_t pathHash,
+                                                         E_DjiMediaFilePreviewType type, const T_PreviewKey *key,
+                                                         T_DjiMediaFilePreview **preview);
+static T_DjiReturnCode DjiMediaFile_PreviewSaveDiskCache(const char *filePath, uint64_t pathHash,
+                                                         E_DjiMediaFilePreviewType type, const T_PreviewKey *key,
+                                                         const T_DjiMediaFilePreview *preview);
+
+static T_DjiReturnCode DjiMediaFile_PreviewGenerate(const char *filePath, E_DjiMediaFilePreviewSource source,
+                                                    E_DjiMediaFilePreviewType type,
+                                                    T_DjiMediaFilePreview *generated[DJI_MEDIA_FILE_PREVIEW_TYPE_NUM]);
+static T_DjiReturnCode DjiMediaFile_PreviewDecodeJpgFile(const char *filePath, uint16_t width,
+                                                         T_DjiMediaFileImage *image);
+static T_DjiReturnCode DjiMediaFile_PreviewDecodeByFfmpeg(const char *filePath, T_DjiMediaFileImage *image);
+static T_DjiReturnCode DjiMediaFile_PreviewEncode(const T_DjiMediaFileImage *image, E_DjiMediaFilePreviewType type,
+                                                  T_DjiMediaFilePreview **preview);
+
+/* Exported functions definition ---------------------------------------------*/
+/**
+ * @brief Set up the preview caches, previews are made without any cache before this is called.
+ * @param config: cache configuration.
+ * @return Execution result.
+ */
+T_DjiReturnCode DjiMediaFile_PreviewInit(const T_DjiMediaFilePreviewConfig *config)
+{
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+
+    if (s_isPreviewInited) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_DUPLICATE;
+    }
+
+    if (config->diskCacheDirPath != NULL) {
+        if (strlen(config->diskCacheDirPath) >= sizeof(s_previewDiskCacheDirPath)) {
+            return DJI_ERROR_SYSTEM_MODULE_CODE_OUT_OF_RANGE;
+        }
+        if (mkdir(config->diskCacheDirPath, 0755) != 0 && errno != EEXIST) {
+            USER_LOG_WARN("create preview cache directory %s fail, disk cache is disabled.",
+                          config->diskCacheDirPath);
+        } else {
+            strcpy(s_previewDiskCacheDirPath, config->diskCacheDirPath);
+        }
+    }
+
+    if (osalHandler->MutexCreate(&s_previewMutex) != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        USER_LOG_ERROR("mutex create error");
+        s_previewDiskCacheDirPath[0] = '\0';
+        return DJI_ERROR_SYSTEM_MODULE_CODE_UNKNOWN;
+    }
+
+    s_previewMemoryCacheSizeMax = config->memoryCacheSizeMax;
+    memset(&s_previewStatistics, 0, sizeof(s_previewStatistics));
+    s_isPreviewInited = true;
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+T_DjiReturnCode DjiMediaFile_PreviewDeInit(void)
+{
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+
+    if (!s_isPreviewInited) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+    }
+
+    while (s_previewLruHead != NULL) {
+        DjiMediaFile_PreviewRemoveMemoryCacheItem(s_previewLruHead);
+    }
+    osalHandler->MutexDestroy(s_previewMutex);
+    s_previewMutex = NULL;
+    s_previewDiskCacheDirPath[0] = '\0';
+    s_isPreviewInited = false;
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+/**
+ * @brief Get the thumbnail or screennail of a media file from memory cache, disk cache, or make it.
+ * @note A JPEG file uses its Exif thumbnail when it is wide enough, otherwise its main picture is decoded
+ * downscaled in DCT domain. Progressive JPEG files and videos need ffmpeg, which gives the first key frame of the
+ * video once, all previews of the file are made from it and cached, so ffmpeg runs once for a file at most.
+ * @param filePath: path of the media file.
+ * @param source: type of the media file.
+ * @param type: thumbnail or screennail.
+ * @param preview: JPEG file of the preview, destroy it by DjiMediaFile_PreviewDestroy.
+ * @return Execution result.
+ */
+T_DjiReturnCode DjiMediaFile_PreviewCreate(const char *filePath, E_DjiMediaFilePreviewSource source,
+                                           E_DjiMediaFilePreviewType type, T_DjiMediaFilePreview **preview)
+{
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+    T_DjiMediaFilePreview *generated[DJI_MEDIA_FILE_PREVIEW_TYPE_NUM] = {0};
+    T_DjiReturnCode returnCode;
+    T_PreviewKey key;
+    uint64_t pathHash;
+    uint32_t i;
+
+    *preview = NULL;
+    if (type >= DJI_MEDIA_FILE_PREVIEW_TYPE_NUM) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    returnCode = DjiMediaFile_PreviewGetKey(filePath, &key);
+    if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        USER_LOG_ERROR("media file %s not found.", filePath);
+        return returnCode;
+    }
+    pathHash = DjiMediaFile_PreviewGetHash((const uint8_t *) filePath, strlen(filePath));
+
+    if (s_isPreviewInited) {
+        osalHandler->MutexLock(s_previewMutex);
+        *preview = DjiMediaFile_PreviewLookUpMemoryCache(filePath, pathHash, type, &key);
+        if (*preview != NULL) {
+            s_previewStatistics.memoryHitCount++;
+        }
+        osalHandler->MutexUnlock(s_previewMutex);
+        if (*preview != NULL) {
+            return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+        }
+
+        if (s_previewDiskCacheDirPath[0] != '\0' &&
+            DjiMediaFile_PreviewLoadDiskCache(filePath, pathHash, type, &key, preview) ==
+            DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+            osalHandler->MutexLock(s_previewMutex);
+            DjiMediaFile_PreviewInsertMemoryCache(filePath, pathHash, type, &key, *preview);
+            s_previewStatistics.diskHitCount++;
+            osalHandler->MutexUnlock(s_previewMutex);
+            return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+        }
+    }
+
+    returnCode = DjiMediaFile_PreviewGenerate(filePath, source, type, generated);
+    if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        USER_LOG_ERROR("make preview of %s error: 0x%08llX.", filePath, returnCode);
+        return returnCode;
+    }
+
+    for (i = 0; i < DJI_MEDIA_FILE_PREVIEW_TYPE_NUM; i++) {
+        if (generated[i] == NULL) {
+            continue;
+        }
+        if (s_isPreviewInited) {
+            osalHandler->MutexLock(s_previewMutex);
+            DjiMediaFile_PreviewInsertMemoryCache(filePath, pathHash, (E_DjiMediaFilePreviewType) i, &key,
+                                                  generated[i]);
+            s_previewStatistics.generateCount++;
+            osalHandler->MutexUnlock(s_previewMutex);
+            if (s_previewDiskCacheDirPath[0] != '\0') {
+                DjiMediaFile_PreviewSaveDiskCache(filePath, pathHash, (E_DjiMediaFilePreviewType) i, &key,
+                                                  generated[i]);
+            }
+        }
+        if (i == type) {
+            *preview = generated[i];
+        } else {
+            DjiMediaFile_PreviewDestroy(generated[i]);
+        }
+    }
+
+    return *preview != NULL ? DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS : DJI_ERROR_SYSTEM_MODULE_CODE_SYSTEM_ERROR;
+}
+
+T_DjiReturnCode DjiMediaFile_PreviewGetData(const T_DjiMediaFilePreview *preview, uint32_t offset, uint16_t len,
+                                            uint8_t *data, uint16_t *realLen)
+{
+    if (preview == NULL) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    //same as reading past the end of a file by UtilFile_GetFileData
+    if (offset >= preview->size) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_SYSTEM_ERROR;
+    }
+
+    *realLen = (uint16_t) (preview->size - offset < len ? preview->size - offset : len);
+    memcpy(data, &preview->data[offset], *realLen);
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+T_DjiReturnCode DjiMediaFile_PreviewDestroy(T_DjiMediaFilePreview *preview)
+{
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+
+    if (preview == NULL) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    osalHandler->Free(preview->data);
+    osalHandler->Free(preview);
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+/**
+ * @brief Drop cached previews of a media file, call it when the file is deleted.
+ * @param filePath: path of the media file.
+ * @return Execution result.
+ */
+T_DjiReturnCode DjiMediaFile_PreviewRemove(const char *filePath)
+{
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+    char cachePath[PSDK_MEDIA_FILE_PATH_LEN_MAX];
+    T_PreviewCacheItem *item;
+    T_PreviewCacheItem *next;
+    uint64_t pathHash;
+    uint32_t i;
+
+    if (!s_isPreviewInited) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+    }
+
+    pathHash = DjiMediaFile_PreviewGetHash((const uint8_t *) filePath, strlen(filePath));
+
+    osalHandler->MutexLock(s_previewMutex);
+    for (item = s_previewHashTable[pathHash % PREVIEW_HASH_BUCKET_NUM]; item != NULL; item = next) {
+        next = item->hashNext;
+        if (item->pathHash == pathHash && strcmp(item->filePath, filePath) == 0) {
+            DjiMediaFile_PreviewRemoveMemoryCacheItem(item);
+        }
+    }
+    osalHandler->MutexUnlock(s_previewMutex);
+
+    if (s_previewDiskCacheDirPath[0] != '\0') {
+        for (i = 0; i < DJI_MEDIA_FILE_PREVIEW_TYPE_NUM; i++) {
+            DjiMediaFile_PreviewGetDiskCachePath(pathHash, (E_DjiMediaFilePreviewType) i, cachePath,
+                                                 sizeof(cachePath));
+            remove(cachePath);
+        }
+    }
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+T_DjiReturnCode DjiMediaFile_PreviewGetStatistics(T_DjiMediaFilePreviewStatistics *statistics)
+{
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+
+    if (!s_isPreviewInited) {
+        memset(statistics, 0, sizeof(T_DjiMediaFilePreviewStatistics));
+        return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+    }
+
+    osalHandler->MutexLock(s_previewMutex);
+    *statistics = s_previewStatistics;
+    osalHandler->MutexUnlock(s_previewMutex);
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+/* Private functions definition-----------------------------------------------*/
+static T_DjiReturnCode DjiMediaFile_PreviewGetKey(const char *filePath, T_PreviewKey *key)
+{
+    struct stat fileStat;
+
+    if (stat(filePath, &fileStat) != 0) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
+    }
+    key->sourceFileSize = (uint64_t) fileStat.st_size;
+    key->sourceModifyTimeNs = (int64_t) fileStat.st_mtim.tv_sec * 1000000000 + fileStat.st_mtim.tv_nsec;
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+static uint64_t DjiMediaFile_PreviewGetHash(const uint8_t *data, uint32_t len)
+{
+    uint64_t hash = PREVIEW_FNV_OFFSET;
+    uint32_t i;
+
+    for (i = 0; i < len; i++) {
+        hash = (hash ^ data[i]) * PREVIEW_FNV_PRIME;
+    }
+
+    return hash;
+}
+
+static T_DjiReturnCode DjiMediaFile_PreviewNew(uint8_t *data, uint32_t size, bool isCopy,
+                                               T_DjiMediaFilePreview **preview)
+{
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+
+    *preview = osalHandler->Malloc(sizeof(T_DjiMediaFilePreview));
+    if (*preview == NULL) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_MEMORY_ALLOC_FAILED;
+    }
+
+    if (isCopy) {
+        (*preview)->data = osalHandler->Malloc(size);
+        if ((*preview)->data == NULL) {
+            osalHandler->Free(*preview);
+            *preview = NULL;
+            return DJI_ERROR_SYSTEM_MODULE_CODE_MEMORY_ALLOC_FAILED;
+        }
+        memcpy((*preview)->data, data, size);
+    } else {
+        (*preview)->data = data;
+    }
+    (*preview)->size = size;
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+static T_DjiMediaFilePreview *DjiMediaFile_PreviewLookUpMemoryCache(const char *filePath, uint64_t pathHash,
+                                                                    E_DjiMediaFilePreviewType type,
+                                                                    const T_PreviewKey *key)
+{
+    T_DjiMediaFilePreview *preview = NULL;
+    T_PreviewCacheItem *item;
+
+    for (item = s_previewHashTable[pathHash % PREVIEW_HASH_BUCKET_NUM]; item != NULL; item = item->hashNext) {
+        if (item->pathHash == pathHash && item->type == type && strcmp(item->filePath, filePath) == 0) {
+            break;
+        }
+    }
+    if (item == NULL) {
+        return NULL;
+    }
+
+    if (item->key.sourceFileSize != key->sourceFileSize ||
+        item->key.sourceModifyTimeNs != key->sourceModifyTimeNs) {
+        DjiMediaFile_PreviewRemoveMemoryCacheItem(item);
+        return NULL;
+    }
+
+    //move to the head of the LRU list
+    if (item != s_previewLruHead) {
+        item->lruPrev->lruNext = item->lruNext;
+        if (item->lruNext != NULL) {
+            item->lruNext->lruPrev = item->lruPrev;
+        } else {
+            s_previewLruTail = item->lruPrev;
+        }
+        item->lruPrev = NULL;
+        item->lruNext = s_previewLruHead;
+        s_previewLruHead->lruPrev = item;
+        s_previewLruHead = item;
+    }
+
+    DjiMediaFile_PreviewNew(item->data, item->size, true, &preview);
+
+    return preview;
+}
+
+static void DjiMediaFile_PreviewInsertMemoryCache(const char *filePath, uint64_t pathHash,
+                                                  E_DjiMediaFilePreviewType type, const T_PreviewKey *key,
+                                                  const T_DjiMediaFilePreview *preview)
+{
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+    T_PreviewCacheItem *item;
+    uint32_t pathLen = strlen(filePath);
+    uint32_t allocSize = sizeof(T_PreviewCacheItem) + pathLen + 1 + preview->size;
+    uint32_t bucket = pathHash % PREVIEW_HASH_BUCKET_NUM;
+
+    if (allocSize > s_previewMemoryCacheSizeMax) {
+        return;
+    }
+
+    for (item = s_previewHashTable[bucket]; item != NULL; item = item->hashNext) {
+        if (item->pathHash == pathHash && item->type == type && strcmp(item->filePath, filePath) == 0) {
+            DjiMediaFile_PreviewRemoveMemoryCacheItem(item);
+            break;
+        }
+    }
+
+    while (s_previewLruTail != NULL &&
+           s_previewStatistics.memoryCacheSize + allocSize > s_previewMemoryCacheSizeMax) {
+        DjiMediaFile_PreviewRemoveMemoryCacheItem(s_previewLruTail);
+    }
+
+    //item, path and data share one allocation
+    item = osalHandler->Malloc(allocSize);
+    if (item == NULL) {
+        return;
+    }
+    item->filePath = (char *) (item + 1);
+    item->data = (uint8_t *) item->filePath + pathLen + 1;
+    memcpy(item->filePath, filePath, pathLen + 1);
+    memcpy(item->data, preview->data, preview->size);
+    item->size = preview->size;
+    item->allocSize = allocSize;
+    item->pathHash = pathHash;
+    item->type = type;
+    item->key = *key;
+
+    item->hashNext = s_previewHashTable[bucket];
+    s_previewHashTable[bucket] = item;
+    item->lruPrev = NULL;
+    item->lruNext = s_previewLruHead;
+    if (s_previewLruHead != NULL) {
+        s_previewLruHead->lruPrev = item;
+    } else {
+        s_previewLruTail = item;
+    }
+    s_previewLruHead = item;
+
+    s_previewStatistics.memoryCacheSize += allocSize;
+    s_previewStatistics.memoryCacheItemCount++;
+}
+
+static void DjiMediaFile_PreviewRemoveMemoryCacheItem(T_PreviewCacheItem *item)
+{
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+    T_PreviewCacheItem **link = &s_previewHashTable[item->pathHash % PREVIEW_HASH_BUCKET_NUM];
+
+    while (*link != item) {
+        link = &(*link)->hashNext;
+    }
+    *link = item->hashNext;
+
+    if (item->lruPrev != NULL) {
+        item->lruPrev->lruNext = item->lruNext;
+    } else {
+        s_previewLruHead = item->lruNext;
+    }
+    if (item->lruNext != NULL) {
+        item->lruNext->lruPrev = item->lruPrev;
+    } else {
+        s_previewLruTail = item->lruPrev;
+    }
+
+    s_previewStatistics.memoryCacheSize -= item->allocSize;
+    s_previewStatistics.memoryCacheItemCount--;
+    osalHandler->Free(item);
+}
+
+static void DjiMediaFile_PreviewGetDiskCachePath(uint64_t pathHash, E_DjiMediaFilePreviewType type,
+                                                 char *cachePath, uint32_t cachePathSize)
+{
+    snprintf(cachePath, cachePathSize, "%s/%016llx.%s", s_previewDiskCacheDirPath, (unsigned long long) pathHash,
+             s_previewTypeInfo[type].suffix);
+}
+
+static T_DjiReturnCode DjiMediaFile_PreviewLoadDiskCache(const char *filePath, uint64_t pathHash,
+                                                         E_DjiMediaFilePreviewType type, const T_PreviewKey *key,
+                                                         T_DjiMediaFilePreview **preview)
+{
+    T_DjiReturnCode returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+    char cachePath[PSDK_MEDIA_FILE_PATH_LEN_MAX];
+    const T_PreviewDiskCacheHeader *header;
+    uint32_t pathLen = strlen(filePath);
+    uint8_t *cacheData = NULL;
+    uint8_t *data;
+    struct stat fileStat;
+    uint32_t cacheSize;
+    int fd;
+
+    DjiMediaFile_PreviewGetDiskCachePath(pathHash, type, cachePath, sizeof(cachePath));
+    fd = open(cachePath, O_RDONLY);
+    if (fd < 0) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
+    }
+
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= (off_t) (sizeof(T_PreviewDiskCacheHeader) + pathLen) ||
+        fileStat.st_size > PREVIEW_DISK_CACHE_SIZE_MAX) {
+        goto out;
+    }
+    cacheSize = (uint32_t) fileStat.st_size;
+
+    cacheData = osalHandler->Malloc(cacheSize);
+    if (cacheData == NULL) {
+        returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_MEMORY_ALLOC_FAILED;
+        goto out;
+    }
+    if (read(fd, cacheData, cacheSize) != (ssize_t) cacheSize) {
+        goto out;
+    }
+
+    header = (const T_PreviewDiskCacheHeader *) cacheData;
+    data = cacheData + sizeof(T_PreviewDiskCacheHeader) + pathLen;
+    if (header->magic != PREVIEW_DISK_CACHE_MAGIC || header->version != PREVIEW_DISK_CACHE_VERSION ||
+        header->type != type || header->pathLen != pathLen ||
+        header->sourceFileSize != key->sourceFileSize || header->sourceModifyTimeNs != key->sourceModifyTimeNs ||
+        cacheSize != sizeof(T_PreviewDiskCacheHeader) + pathLen + header->dataSize ||
+        memcmp(cacheData + sizeof(T_PreviewDiskCacheHeader), filePath, pathLen) != 0 ||
+        header->checksum != DjiMediaFile_PreviewGetHash(data, header->dataSize)) {
+        goto out;
+    }
+
+    returnCode = DjiMediaFile_PreviewNew(data, header->dataSize, true, preview);
+
+out:
+    if (cacheData != NULL) {
+        osalHandler->Free(cacheData);
+    }
+    close(fd);
+
+    return returnCode;
+}
+
+static T_DjiReturnCode DjiMediaFile_PreviewSaveDiskCache(const char *filePath, uint64_t pathHash,
+                                                         E_DjiMediaFilePreviewType type, const T_PreviewKey *key,
+                                                         const T_DjiMediaFilePreview *preview)
+{
+    char cachePath[PSDK_MEDIA_FILE_PATH_LEN_MAX];
+    char tempPath[PSDK_MEDIA_FILE_PATH_LEN_MAX];
+    T_PreviewDiskCacheHeader header;
+    FILE *fpFile;
+
+    DjiMediaFile_PreviewGetDiskCachePath(pathHash, type, cachePath, sizeof(cachePath));
+    if (snprintf(tempPath, sizeof(tempPath), "%s.tmp", cachePath) >= (int) sizeof(tempPath)) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_OUT_OF_RANGE;
+    }
+
+    memset(&header, 0, sizeof(header));
+    header.magic = PREVIEW_DISK_CACHE_MAGIC;
+    header.version = PREVIEW_DISK_CACHE_VERSION;
+    header.type = (uint16_t) type;
+    header.sourceFileSize = key->sourceFileSize;
+    header.sourceModifyTimeNs = key->sourceModifyTimeNs;
+    header.pathLen = strlen(filePath);
+    header.dataSize = preview->size;
+    header.checksum = DjiMediaFile_PreviewGetHash(preview->data, preview->size);
+
+    fpFile = fopen(tempPath, "wb");
+    if (fpFile == NULL) {
+        USER_LOG_WARN("create preview cache %s fail.", tempPath);
+        return DJI_ERROR_SYSTEM_MODULE_CODE_SYSTEM_ERROR;
+    }
+
+    if (fwrite(&header, 1, sizeof(header), fpFile) != sizeof(header) ||
+        fwrite(filePath, 1, header.pathLen, fpFile) != header.pathLen ||
+        fwrite(preview->data, 1, preview->size, fpFile) != preview->size) {
+        USER_LOG_WARN("write preview cache %s fail.", tempPath);
+        fclose(fpFile);
+        remove(tempPath);
+        return DJI_ERROR_SYSTEM_MODULE_CODE_SYSTEM_ERROR;
+    }
+
+    if (fclose(fpFile) != 0 || rename(tempPath, cachePath) != 0) {
+        USER_LOG_WARN("save preview cache %s fail.", cachePath);
+        remove(tempPath);
+        return DJI_ERROR_SYSTEM_MODULE_CODE_SYSTEM_ERROR;
+    }
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+static T_DjiReturnCode DjiMediaFile_PreviewGenerate(const char *filePath, E_DjiMediaFilePreviewSource source,
+                                                    E_DjiMediaFilePreviewType type,
+                                                    T_DjiMediaFilePreview *generated[DJI_MEDIA_FILE_PREVIEW_TYPE_NUM])
+{
+    T_DjiMediaFileImage image;
+    T_DjiReturnCode returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_NONSUPPORT;
+    uint32_t i;
+
+    if (source == DJI_MEDIA_FILE_PREVIEW_SOURCE_JPG) {
+        returnCode = DjiMediaFile_PreviewDecodeJpgFile(filePath, s_previewTypeInfo[type].width, &image);
+        if (returnCode == DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+            returnCode = DjiMediaFile_PreviewEncode(&image, type, &generated[type]);
+            DjiMediaFile_ImageFree(&image);
+            return returnCode;
+        }
+    }
+
+    //a picture from ffmpeg costs a process, so every preview of the file is made from it at once
+    returnCode = DjiMediaFile_PreviewDecodeByFfmpeg(filePath, &image);
+    if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        return returnCode;
+    }
+
+    for (i = 0; i < DJI_MEDIA_FILE_PREVIEW_TYPE_NUM; i++) {
+        returnCode = DjiMediaFile_PreviewEncode(&image, (E_DjiMediaFilePreviewType) i, &generated[i]);
+        if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+            break;
+        }
+    }
+    DjiMediaFile_ImageFree(&image);
+
+    if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        for (i = 0; i < DJI_MEDIA_FILE_PREVIEW_TYPE_NUM; i++) {
+            if (generated[i] != NULL) {
+                DjiMediaFile_PreviewDestroy(generated[i]);
+                generated[i] = NULL;
+            }
+        }
+    }
+
+    return returnCode;
+}
+
+static T_DjiReturnCode DjiMediaFile_PreviewDecodeJpgFile(const char *filePath, uint16_t width,
+                                                         T_DjiMediaFileImage *image)
+{
+    T_DjiReturnCode returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_SYSTEM_ERROR;
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+    uint32_t thumbnailOffset, thumbnailSize, readSize;
+    uint16_t thumbnailWidth, thumbnailHeight;
+    struct stat fileStat;
+    uint8_t *data = NULL;
+    int fd;
+
+    fd = open(filePath, O_RDONLY);
+    if (fd < 0) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
+    }
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0 || (uint64_t) fileStat.st_size > UINT32_MAX) {
+        goto out;
+    }
+
+    //Exif thumbnail is in the head of the file, the main picture is read only when the thumbnail is too small
+    readSize = fileStat.st_size < PREVIEW_JPG_HEAD_READ_SIZE ? (uint32_t) fileStat.st_size :
+               PREVIEW_JPG_HEAD_READ_SIZE;
+    data = osalHandler->Malloc(readSize);
+    if (data == NULL) {
+        returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_MEMORY_ALLOC_FAILED;
+        goto out;
+    }
+    if (pread(fd, data, readSize, 0) != (ssize_t) readSize) {
+        goto out;
+    }
+
+    if (DjiMediaFile_JpgGetExifThumbnail(data, readSize, &thumbnailOffset, &thumbnailSize) ==
+        DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS &&
+        DjiMediaFile_JpgGetImageSize(&data[thumbnailOffset], thumbnailSize, &thumbnailWidth, &thumbnailHeight) ==
+        DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS && thumbnailWidth >= width) {
+        returnCode = DjiMediaFile_JpgDecode(&data[thumbnailOffset], thumbnailSize, width, image);
+        if (returnCode == DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+            goto out;
+        }
+    }
+
+    if (readSize < (uint32_t) fileStat.st_size) {
+        osalHandler->Free(data);
+        readSize = (uint32_t) fileStat.st_size;
+        data = osalHandler->Malloc(readSize);
+        if (data == NULL) {
+            returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_MEMORY_ALLOC_FAILED;
+            goto out;
+        }
+        if (pread(fd, data, readSize, 0) != (ssize_t) readSize) {
+            returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_SYSTEM_ERROR;
+            goto out;
+        }
+    }
+
+    returnCode = DjiMediaFile_JpgDecode(data, readSize, width, image);
+
+out:
+    if (data != NULL) {
+        osalHandler->Free(data);
+    }
+    close(fd);
+
+    return returnCode;
+}
+
+static T_DjiReturnCode DjiMediaFile_PreviewDecodeByFfmpeg(const char *filePath, T_DjiMediaFileImage *image)
+{
+    T_DjiReturnCode returnCode;
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+    char ffmpegCmdStr[PREVIEW_FFMPEG_CMD_BUF_SIZE];
+    uint32_t capacity = PREVIEW_FFMPEG_READ_SIZE;
+    uint32_t size = 0;
+    uint8_t *data;
+    uint8_t *newData;
+    size_t readLen;
+    FILE *fp;
+
+    //first key frame, scaled to screennail width, as a JPEG file on stdout, so no temp file is needed
+    snprintf(ffmpegCmdStr, sizeof(ffmpegCmdStr),
+             "ffmpeg -v quiet -skip_frame nokey -i \"%s\" -frames:v 1 -vf scale=%d:-1 -f image2pipe -vcodec mjpeg "
+             "-q:v 2 - 2>/dev/null", filePath, DJI_MEDIA_FILE_PREVIEW_SCREENNAIL_WIDTH);
+
+    data = osalHandler->Malloc(capacity);
+    if (data == NULL) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_MEMORY_ALLOC_FAILED;
+    }
+
+    fp = popen(ffmpegCmdStr, "r");
+    if (fp == NULL) {
+        osalHandler->Free(data);
+        return DJI_ERROR_SYSTEM_MODULE_CODE_SYSTEM_ERROR;
+    }
+
+    while ((readLen = fread(&data[size], 1, capacity - size, fp)) > 0) {
+        size += readLen;
+        if (size < capacity) {
+            continue;
+        }
+        if (capacity >= PREVIEW_FFMPEG_OUTPUT_SIZE_MAX) {
+            break;
+        }
+        newData = osalHandler->Malloc(capacity * 2);
+        if (newData == NULL) {
+            break;
+        }
+        memcpy(newData, data, size);
+        osalHandler->Free(data);
+        data = newData;
+        capacity *= 2;
+    }
+    pclose(fp);
+
+    if (size == 0) {
+        USER_LOG_ERROR("ffmpeg gives no picture of %s.", filePath);
+        osalHandler->Free(data);
+        return DJI_ERROR_SYSTEM_MODULE_CODE_SYSTEM_ERROR;
+    }
+
+    returnCode = DjiMediaFile_JpgDecode(data, size, 0, image);
+    osalHandler->Free(data);
+
+    return returnCode;
+}
+
+static T_DjiReturnCode DjiMediaFile_PreviewEncode(const T_DjiMediaFileImage *image, E_DjiMediaFilePreviewType type,
+                                                  T_DjiMediaFilePreview **preview)
+{
+    T_DjiReturnCode returnCode;
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+    T_DjiMediaFileImage resizedImage;
+    uint16_t width = s_previewTypeInfo[type].width;
+    uint16_t height;
+    uint8_t *data;
+    uint32_t size;
+
+    //keep aspect ratio, like "scale=width:-1" of ffmpeg
+    height = (uint16_t) (((uint32_t) image->height * width + image->width / 2) / image->width);
+    if (height == 0) {
+        height = 1;
+    }
+
+    returnCode = DjiMediaFile_ImageResize(image, width, height, &resizedImage);
+    if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        return returnCode;
+    }
+
+    returnCode = DjiMediaFile_JpgEncode(&resizedImage, PREVIEW_JPG_QUALITY, &data, &size);
+    DjiMediaFile_ImageFree(&resizedImage);
+    if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        return returnCode;
+    }
+
+    returnCode = DjiMediaFile_PreviewNew(data, size, false, preview);
+    if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        osalHandler->Free(data);
+    }
+
+    return returnCode;
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
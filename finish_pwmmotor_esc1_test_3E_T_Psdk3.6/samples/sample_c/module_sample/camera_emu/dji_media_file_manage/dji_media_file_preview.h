@@ -0,0 +1,93 @@
+/**
+ ********************************************************************
+ * @file    dji_media_file_preview.h
+ * @brief   This is the header file for "dji_media_file_preview.c", defining the structure and
+ * (exported) function prototypes.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef PSDK_MEDIA_FILE_PREVIEW_H
+#define PSDK_MEDIA_FILE_PREVIEW_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <dji_typedef.h>
+
+/* Exported constants --------------------------------------------------------*/
+#define DJI_MEDIA_FILE_PREVIEW_THUMBNAIL_WIDTH      100
+#define DJI_MEDIA_FILE_PREVIEW_SCREENNAIL_WIDTH     600
+
+/* Exported types ------------------------------------------------------------*/
+typedef enum {
+    DJI_MEDIA_FILE_PREVIEW_TYPE_THUMBNAIL = 0,
+    DJI_MEDIA_FILE_PREVIEW_TYPE_SCREENNAIL,
+    DJI_MEDIA_FILE_PREVIEW_TYPE_NUM,
+} E_DjiMediaFilePreviewType;
+
+typedef enum {
+    DJI_MEDIA_FILE_PREVIEW_SOURCE_JPG = 0,
+    DJI_MEDIA_FILE_PREVIEW_SOURCE_MP4,
+} E_DjiMediaFilePreviewSource;
+
+typedef struct {
+    // bytes of previews kept in memory, 0 disables the memory cache
+    uint32_t memoryCacheSizeMax;
+    // directory for previews kept across restarts, NULL disables the disk cache
+    const char *diskCacheDirPath;
+} T_DjiMediaFilePreviewConfig;
+
+// a JPEG file of the preview, owned by the caller until DjiMediaFile_PreviewDestroy
+typedef struct {
+    uint8_t *data;
+    uint32_t size;
+} T_DjiMediaFilePreview;
+
+typedef struct {
+    uint32_t memoryHitCount;
+    uint32_t diskHitCount;
+    uint32_t generateCount;
+    uint32_t memoryCacheSize;
+    uint32_t memoryCacheItemCount;
+} T_DjiMediaFilePreviewStatistics;
+
+/* Exported functions --------------------------------------------------------*/
+T_DjiReturnCode DjiMediaFile_PreviewInit(const T_DjiMediaFilePreviewConfig *config);
+T_DjiReturnCode DjiMediaFile_PreviewDeInit(void);
+
+T_DjiReturnCode DjiMediaFile_PreviewCreate(const char *filePath, E_DjiMediaFilePreviewSource source,
+                                           E_DjiMediaFilePreviewType type, T_DjiMediaFilePreview **preview);
+T_DjiReturnCode DjiMediaFile_PreviewGetData(const T_DjiMediaFilePreview *preview, uint32_t offset, uint16_t len,
+                                            uint8_t *data, uint16_t *realLen);
+T_DjiReturnCode DjiMediaFile_PreviewDestroy(T_DjiMediaFilePreview *preview);
+
+T_DjiReturnCode DjiMediaFile_PreviewRemove(const char *filePath);
+T_DjiReturnCode DjiMediaFile_PreviewGetStatistics(T_DjiMediaFilePreviewStatistics *statistics);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PSDK_MEDIA_FILE_PREVIEW_H
+
+/************************ (C) COPYRIGHT DJI Innovations *******END OF FILE******/
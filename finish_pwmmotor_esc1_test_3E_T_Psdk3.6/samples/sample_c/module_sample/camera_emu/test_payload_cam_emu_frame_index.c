@@ -0,0 +1,570 @@
+/**
+ ********************************************************************
+ * @file    test_payload_cam_emu_frame_index.c
+ * @brief   Frame index of H.264 Annex-B video files, which splits the stream into access units the same way
+ *          as "ffprobe -show_packets" does, by streaming through the file with a small fixed buffer, the binary
+ *          cache file of the index kept next to the media file, and seek by time in the index.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "dji_logger.h"
+#include "dji_platform.h"
+#include "utils/util_misc.h"
+#include "test_payload_cam_emu_frame_index.h"
+
+/* Private constants ---------------------------------------------------------*/
+#define FRAME_INDEX_READ_BUFFER_SIZE        (32 * 1024)
+//4 byte start code, a longer run of zero bytes is trailing zero of the previous access unit
+#define FRAME_INDEX_START_CODE_ZERO_MAX     3
+
+#define FRAME_INDEX_NAL_TYPE_MASK           0x1F
+#define FRAME_INDEX_NAL_TYPE_SLICE          1
+#define FRAME_INDEX_NAL_TYPE_SLICE_IDR      5
+#define FRAME_INDEX_NAL_TYPE_SEI            6
+#define FRAME_INDEX_NAL_TYPE_SPS            7
+#define FRAME_INDEX_NAL_TYPE_PPS            8
+#define FRAME_INDEX_NAL_TYPE_AUD            9
+#define FRAME_INDEX_NAL_TYPE_PREFIX_MIN     14
+#define FRAME_INDEX_NAL_TYPE_PREFIX_MAX     18
+//first bit of slice header is ue(v) first_mb_in_slice, it is 1 only when first_mb_in_slice is 0
+#define FRAME_INDEX_FIRST_MB_ZERO_MASK      0x80
+
+#define FRAME_INDEX_CACHE_MAGIC             0x58444946 // "FIDX", also rejects a cache of other byte order
+#define FRAME_INDEX_CACHE_VERSION           1
+#define FRAME_INDEX_CACHE_FLAG_KEY_FRAME    0x01
+#define FRAME_INDEX_CACHE_FNV_OFFSET        2166136261U
+#define FRAME_INDEX_CACHE_FNV_PRIME         16777619U
+
+/* Private types -------------------------------------------------------------*/
+typedef enum {
+    FRAME_INDEX_SCAN_STATE_PAYLOAD = 0,
+    FRAME_INDEX_SCAN_STATE_NAL_HEADER,
+    FRAME_INDEX_SCAN_STATE_SLICE_HEADER,
+    FRAME_INDEX_SCAN_STATE_IDR_SLICE_HEADER,
+} E_FrameIndexScanState;
+
+typedef struct {
+    E_FrameIndexScanState state;
+    uint32_t zeroCount;
+    uint32_t nalPosition;
+    bool isAccessUnitOpen;
+    bool isAccessUnitHasSlice;
+    uint32_t accessUnitPosition;
+    bool isAccessUnitHasIdr;
+    float frameRate;
+    float durationS;
+    T_TestPayloadCameraVideoFrameInfo *frameInfo;
+    uint32_t frameInfoBufferCount;
+    uint32_t frameCount;
+    bool isFrameBufferFull;
+} T_FrameIndexScanner;
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t recordSize;
+    uint64_t sourceFileSize;
+    int64_t sourceModifyTimeNs;
+    float frameRate;
+    uint32_t frameCount;
+    uint32_t checksum;
+} T_FrameIndexCacheHeader;
+
+typedef struct {
+    uint32_t positionInFile;
+    uint32_t size;
+    uint32_t ptsMs;
+    uint32_t flags;
+} T_FrameIndexCacheRecord;
+
+/* Private functions declaration ---------------------------------------------*/
+static void DjiTest_FrameIndexStartAccessUnit(T_FrameIndexScanner *scanner, uint32_t position);
+static void DjiTest_FrameIndexScanByte(T_FrameIndexScanner *scanner, uint8_t byte, uint32_t position);
+static uint32_t DjiTest_FrameIndexGetChecksum(const uint8_t *data, uint32_t len);
+
+/* Exported functions definition ---------------------------------------------*/
+/**
+ * @brief Build frame index of a raw H.264 Annex-B file, like the one "ffmpeg -codec copy -f h264" writes.
+ * @note Access unit boundaries follow H.264 7.4.1.2.3: an access unit delimiter, SEI, SPS, PPS or prefix NAL
+ * unit after a slice, or a slice with first_mb_in_slice 0 after a slice, starts a new access unit. Every frame
+ * lasts 1 / frameRate and timestamps count up from 0 by it, as the raw stream has no timestamps. A frame with an IDR
+ * slice is a key frame.
+ * @param path: path of the H.264 file.
+ * @param frameRate: frame rate of the video.
+ * @param frameInfo: frame info array to fill.
+ * @param frameInfoBufferCount: element count of frameInfo.
+ * @param frameCount: count of frames found.
+ * @return Execution result.
+ */
+T_DjiReturnCode DjiTest_FrameIndexScanH264File(const char *path, float frameRate,
+                                               T_TestPayloadCameraVideoFrameInfo *frameInfo,
+                                               uint32_t frameInfoBufferCount, uint32_t *frameCount)
+{
+    T_DjiReturnCode returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+    T_FrameIndexScanner scanner = {0};
+    FILE *fpFile = NULL;
+    uint8_t *readBuffer = NULL;
+    uint32_t position = 0;
+    size_t readLen;
+    size_t i;
+
+    if (frameRate <= 0 || frameInfo == NULL || frameCount == NULL) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    readBuffer = osalHandler->Malloc(FRAME_INDEX_READ_BUFFER_SIZE);
+    if (readBuffer == NULL) {
+        USER_LOG_ERROR("malloc memory for frame index read buffer fail.");
+        return DJI_ERROR_SYSTEM_MODULE_CODE_MEMORY_ALLOC_FAILED;
+    }
+
+    fpFile = fopen(path, "rb");
+    if (fpFile == NULL) {
+        USER_LOG_ERROR("open video file %s fail.", path);
+        returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
+        goto out;
+    }
+
+    scanner.frameRate = frameRate;
+    scanner.durationS = 1.0f / frameRate;
+    scanner.frameInfo = frameInfo;
+    scanner.frameInfoBufferCount = frameInfoBufferCount;
+
+    while ((readLen = fread(readBuffer, 1, FRAME_INDEX_READ_BUFFER_SIZE, fpFile)) > 0) {
+        for (i = 0; i < readLen; i++) {
+            DjiTest_FrameIndexScanByte(&scanner, readBuffer[i], position++);
+        }
+
+        if (scanner.isFrameBufferFull) {
+            USER_LOG_ERROR("frame buffer is full.");
+            returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_OUT_OF_RANGE;
+            goto out;
+        }
+    }
+
+    if (ferror(fpFile)) {
+        USER_LOG_ERROR("read video file %s error.", path);
+        returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_SYSTEM_ERROR;
+        goto out;
+    }
+
+    // last access unit ends at file tail, trailing NAL units without slice belong to the frame before
+    if (scanner.isAccessUnitHasSlice) {
+        DjiTest_FrameIndexStartAccessUnit(&scanner, position);
+    } else if (scanner.frameCount > 0) {
+        frameInfo[scanner.frameCount - 1].size = position - frameInfo[scanner.frameCount - 1].positionInFile;
+    }
+
+    if (scanner.isFrameBufferFull) {
+        USER_LOG_ERROR("frame buffer is full.");
+        returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_OUT_OF_RANGE;
+    }
+
+out:
+    *frameCount = scanner.frameCount;
+    if (fpFile != NULL) {
+        fclose(fpFile);
+    }
+    osalHandler->Free(readBuffer);
+
+    return returnCode;
+}
+
+/**
+ * @brief Get path of the frame index cache of a media file, a hidden file in the same directory.
+ * @param sourcePath: path of the media file.
+ * @param cachePath: buffer of the cache file path.
+ * @param cachePathSize: size of cachePath.
+ * @return Execution result.
+ */
+T_DjiReturnCode DjiTest_FrameIndexGetCachePath(const char *sourcePath, char *cachePath, uint32_t cachePathSize)
+{
+    const char *fileName = strrchr(sourcePath, '/');
+    int len;
+
+    fileName = fileName != NULL ? fileName + 1 : sourcePath;
+    len = snprintf(cachePath, cachePathSize, "%.*s.%s%s", (int) (fileName - sourcePath), sourcePath, fileName,
+                   FRAME_INDEX_CACHE_FILE_SUFFIX);
+    if (len < 0 || (uint32_t) len >= cachePathSize) {
+        USER_LOG_ERROR("frame index cache path of %s is too long.", sourcePath);
+        return DJI_ERROR_SYSTEM_MODULE_CODE_OUT_OF_RANGE;
+    }
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+/**
+ * @brief Get key of the frame index cache of a media file.
+ * @param sourcePath: path of the media file.
+ * @param key: key to fill.
+ * @return Execution result.
+ */
+T_DjiReturnCode DjiTest_FrameIndexGetCacheKey(const char *sourcePath, T_TestPayloadCameraFrameIndexKey *key)
+{
+    struct stat fileStat;
+
+    memset(key, 0, sizeof(T_TestPayloadCameraFrameIndexKey));
+    if (stat(sourcePath, &fileStat) != 0) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
+    }
+    key->sourceFileSize = (uint64_t) fileStat.st_size;
+    key->sourceModifyTimeNs = (int64_t) fileStat.st_mtim.tv_sec * 1000000000 + fileStat.st_mtim.tv_nsec;
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+/**
+ * @brief Load frame index from its cache file with a single read.
+ * @note Fails with DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND when there is no cache, or it does not match key or is
+ * damaged, the index has to be built again then.
+ * @param cachePath: path of the cache file.
+ * @param key: key of the media file.
+ * @param frameRate: frame rate of the video.
+ * @param frameInfo: frame info array to fill.
+ * @param frameInfoBufferCount: element count of frameInfo.
+ * @param frameCount: count of frames loaded.
+ * @return Execution result.
+ */
+T_DjiReturnCode DjiTest_FrameIndexLoadCache(const char *cachePath, const T_TestPayloadCameraFrameIndexKey *key,
+                                            float *frameRate, T_TestPayloadCameraVideoFrameInfo *frameInfo,
+                                            uint32_t frameInfoBufferCount, uint32_t *frameCount)
+{
+    T_DjiReturnCode returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+    const T_FrameIndexCacheHeader *header;
+    const T_FrameIndexCacheRecord *record;
+    struct stat fileStat;
+    uint8_t *cacheData = NULL;
+    uint32_t cacheSize;
+    int fd;
+    uint32_t i;
+
+    fd = open(cachePath, O_RDONLY);
+    if (fd < 0) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
+    }
+
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size < (off_t) sizeof(T_FrameIndexCacheHeader) ||
+        fileStat.st_size > (off_t) (sizeof(T_FrameIndexCacheHeader) +
+                                    (uint64_t) frameInfoBufferCount * sizeof(T_FrameIndexCacheRecord))) {
+        goto out;
+    }
+    cacheSize = (uint32_t) fileStat.st_size;
+
+    cacheData = osalHandler->Malloc(cacheSize);
+    if (cacheData == NULL) {
+        USER_LOG_ERROR("malloc memory for frame index cache fail.");
+        returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_MEMORY_ALLOC_FAILED;
+        goto out;
+    }
+
+    if (read(fd, cacheData, cacheSize) != (ssize_t) cacheSize) {
+        goto out;
+    }
+
+    header = (const T_FrameIndexCacheHeader *) cacheData;
+    record = (const T_FrameIndexCacheRecord *) (cacheData + sizeof(T_FrameIndexCacheHeader));
+    if (header->magic != FRAME_INDEX_CACHE_MAGIC || header->version != FRAME_INDEX_CACHE_VERSION ||
+        header->recordSize != sizeof(T_FrameIndexCacheRecord) ||
+        header->sourceFileSize != key->sourceFileSize || header->sourceModifyTimeNs != key->sourceModifyTimeNs ||
+        header->frameRate <= 0 ||
+        cacheSize != sizeof(T_FrameIndexCacheHeader) + header->frameCount * sizeof(T_FrameIndexCacheRecord) ||
+        header->checksum != DjiTest_FrameIndexGetChecksum((const uint8_t *) record,
+                                                           cacheSize - sizeof(T_FrameIndexCacheHeader))) {
+        goto out;
+    }
+
+    for (i = 0; i < header->frameCount; i++) {
+        frameInfo[i].durationS = 1.0f / header->frameRate;
+        frameInfo[i].positionInFile = record[i].positionInFile;
+        frameInfo[i].size = record[i].size;
+        frameInfo[i].ptsMs = record[i].ptsMs;
+        frameInfo[i].isKeyFrame = (record[i].flags & FRAME_INDEX_CACHE_FLAG_KEY_FRAME) != 0;
+    }
+    *frameRate = header->frameRate;
+    *frameCount = header->frameCount;
+    returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+
+out:
+    if (cacheData != NULL) {
+        osalHandler->Free(cacheData);
+    }
+    close(fd);
+
+    return returnCode;
+}
+
+/**
+ * @brief Save frame index to its cache file.
+ * @note The cache is written to a temporary file and renamed, so a reader never sees a partly written cache.
+ * Writers of the same cache file must be serialized by the caller.
+ * @param cachePath: path of the cache file.
+ * @param key: key of the media file.
+ * @param frameRate: frame rate of the video.
+ * @param frameInfo: frame info array to save.
+ * @param frameCount: count of frames in frameInfo.
+ * @return Execution result.
+ */
+T_DjiReturnCode DjiTest_FrameIndexSaveCache(const char *cachePath, const T_TestPayloadCameraFrameIndexKey *key,
+                                            float frameRate, const T_TestPayloadCameraVideoFrameInfo *frameInfo,
+                                            uint32_t frameCount)
+{
+    T_DjiReturnCode returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+    T_FrameIndexCacheHeader *header;
+    T_FrameIndexCacheRecord *record;
+    char tempPath[DJI_FILE_PATH_SIZE_MAX];
+    uint8_t *cacheData = NULL;
+    uint32_t cacheSize;
+    FILE *fpFile = NULL;
+    uint32_t i;
+
+    if (snprintf(tempPath, sizeof(tempPath), "%s.tmp", cachePath) >= (int) sizeof(tempPath)) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_OUT_OF_RANGE;
+    }
+
+    cacheSize = sizeof(T_FrameIndexCacheHeader) + frameCount * sizeof(T_FrameIndexCacheRecord);
+    cacheData = osalHandler->Malloc(cacheSize);
+    if (cacheData == NULL) {
+        USER_LOG_ERROR("malloc memory for frame index cache fail.");
+        return DJI_ERROR_SYSTEM_MODULE_CODE_MEMORY_ALLOC_FAILED;
+    }
+
+    header = (T_FrameIndexCacheHeader *) cacheData;
+    record = (T_FrameIndexCacheRecord *) (cacheData + sizeof(T_FrameIndexCacheHeader));
+    for (i = 0; i < frameCount; i++) {
+        record[i].positionInFile = frameInfo[i].positionInFile;
+        record[i].size = frameInfo[i].size;
+        record[i].ptsMs = frameInfo[i].ptsMs;
+        record[i].flags = frameInfo[i].isKeyFrame ? FRAME_INDEX_CACHE_FLAG_KEY_FRAME : 0;
+    }
+    memset(header, 0, sizeof(T_FrameIndexCacheHeader));
+    header->magic = FRAME_INDEX_CACHE_MAGIC;
+    header->version = FRAME_INDEX_CACHE_VERSION;
+    header->recordSize = sizeof(T_FrameIndexCacheRecord);
+    header->sourceFileSize = key->sourceFileSize;
+    header->sourceModifyTimeNs = key->sourceModifyTimeNs;
+    header->frameRate = frameRate;
+    header->frameCount = frameCount;
+    header->checksum = DjiTest_FrameIndexGetChecksum((const uint8_t *) record,
+                                                     frameCount * sizeof(T_FrameIndexCacheRecord));
+
+    fpFile = fopen(tempPath, "wb");
+    if (fpFile == NULL) {
+        USER_LOG_WARN("create frame index cache %s fail.", tempPath);
+        returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_SYSTEM_ERROR;
+        goto out;
+    }
+
+    if (fwrite(cacheData, 1, cacheSize, fpFile) != cacheSize) {
+        USER_LOG_WARN("write frame index cache %s fail.", tempPath);
+        returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_SYSTEM_ERROR;
+        fclose(fpFile);
+        remove(tempPath);
+        goto out;
+    }
+
+    if (fclose(fpFile) != 0 || rename(tempPath, cachePath) != 0) {
+        USER_LOG_WARN("save frame index cache %s fail.", cachePath);
+        returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_SYSTEM_ERROR;
+        remove(tempPath);
+    }
+
+out:
+    osalHandler->Free(cacheData);
+
+    return returnCode;
+}
+
+/**
+ * @brief Build key frame index of a frame index, the frame numbers of all key frames in ascending order.
+ * @param frameInfo: frame index.
+ * @param frameCount: count of frames in frameInfo.
+ * @param keyFrameIndex: key frame index array to fill.
+ * @param keyFrameIndexBufferCount: element count of keyFrameIndex.
+ * @param keyFrameCount: count of key frames found.
+ * @return Execution result.
+ */
+T_DjiReturnCode DjiTest_FrameIndexBuildKeyFrameIndex(const T_TestPayloadCameraVideoFrameInfo *frameInfo,
+                                                     uint32_t frameCount, uint32_t *keyFrameIndex,
+                                                     uint32_t keyFrameIndexBufferCount, uint32_t *keyFrameCount)
+{
+    uint32_t i;
+
+    *keyFrameCount = 0;
+    for (i = 0; i < frameCount; i++) {
+        if (!frameInfo[i].isKeyFrame) {
+            continue;
+        }
+
+        if (*keyFrameCount >= keyFrameIndexBufferCount) {
+            USER_LOG_ERROR("key frame index buffer is full.");
+            return DJI_ERROR_SYSTEM_MODULE_CODE_OUT_OF_RANGE;
+        }
+        keyFrameIndex[(*keyFrameCount)++] = i;
+    }
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+/**
+ * @brief Find the frame shown at a time by binary search of the frame timestamps, and the last key frame not
+ * after it by binary search of the key frame index.
+ * @note When no key frame is before the frame, decoding starts from the first frame.
+ * @param frameInfo: frame index.
+ * @param frameCount: count of frames in frameInfo.
+ * @param keyFrameIndex: key frame index of frameInfo.
+ * @param keyFrameCount: count of key frames in keyFrameIndex.
+ * @param timeMs: time to seek to.
+ * @param position: position to start decoding from.
+ * @return Execution result, DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND when time is after the end of the video.
+ */
+T_DjiReturnCode DjiTest_FrameIndexSeek(const T_TestPayloadCameraVideoFrameInfo *frameInfo, uint32_t frameCount,
+                                       const uint32_t *keyFrameIndex, uint32_t keyFrameCount, uint32_t timeMs,
+                                       T_TestPayloadCameraFrameSeekPosition *position)
+{
+    uint32_t low;
+    uint32_t high;
+    uint32_t middle;
+    uint32_t frameNumber;
+
+    if (frameCount == 0 ||
+        timeMs > frameInfo[frameCount - 1].ptsMs + (uint32_t) (frameInfo[frameCount - 1].durationS * 1000 + 0.5f)) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
+    }
+
+    // last frame with timestamp not after timeMs
+    low = 0;
+    high = frameCount;
+    while (high - low > 1) {
+        middle = low + (high - low) / 2;
+        if (frameInfo[middle].ptsMs <= timeMs) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+    frameNumber = low;
+
+    // last key frame not after frameNumber
+    low = 0;
+    high = keyFrameCount;
+    while (low < high) {
+        middle = low + (high - low) / 2;
+        if (keyFrameIndex[middle] <= frameNumber) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    position->keyFrameNumber = low > 0 ? keyFrameIndex[low - 1] : 0;
+    position->decodeForwardCount = frameNumber - position->keyFrameNumber;
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+/* Private functions definition-----------------------------------------------*/
+// close the open access unit with a slice at position, and open the next one there
+static void DjiTest_FrameIndexStartAccessUnit(T_FrameIndexScanner *scanner, uint32_t position)
+{
+    T_TestPayloadCameraVideoFrameInfo *frame;
+
+    if (scanner->isAccessUnitHasSlice) {
+        if (scanner->frameCount >= scanner->frameInfoBufferCount) {
+            scanner->isFrameBufferFull = true;
+        } else {
+            frame = &scanner->frameInfo[scanner->frameCount++];
+            frame->durationS = scanner->durationS;
+            frame->positionInFile = scanner->accessUnitPosition;
+            frame->size = position - scanner->accessUnitPosition;
+            frame->ptsMs = (uint32_t) ((double) (scanner->frameCount - 1) * 1000.0 / scanner->frameRate + 0.5);
+            frame->isKeyFrame = scanner->isAccessUnitHasIdr;
+        }
+    }
+
+    scanner->isAccessUnitOpen = true;
+    scanner->isAccessUnitHasSlice = false;
+    scanner->isAccessUnitHasIdr = false;
+    scanner->accessUnitPosition = position;
+}
+
+static void DjiTest_FrameIndexScanByte(T_FrameIndexScanner *scanner, uint8_t byte, uint32_t position)
+{
+    uint8_t nalType;
+
+    if (scanner->state == FRAME_INDEX_SCAN_STATE_NAL_HEADER) {
+        nalType = byte & FRAME_INDEX_NAL_TYPE_MASK;
+        scanner->state = FRAME_INDEX_SCAN_STATE_PAYLOAD;
+
+        if (nalType == FRAME_INDEX_NAL_TYPE_SLICE || nalType == FRAME_INDEX_NAL_TYPE_SLICE_IDR) {
+            scanner->state = nalType == FRAME_INDEX_NAL_TYPE_SLICE_IDR ? FRAME_INDEX_SCAN_STATE_IDR_SLICE_HEADER :
+                             FRAME_INDEX_SCAN_STATE_SLICE_HEADER;
+        } else if (nalType == FRAME_INDEX_NAL_TYPE_AUD || nalType == FRAME_INDEX_NAL_TYPE_SEI ||
+                   nalType == FRAME_INDEX_NAL_TYPE_SPS || nalType == FRAME_INDEX_NAL_TYPE_PPS ||
+                   (nalType >= FRAME_INDEX_NAL_TYPE_PREFIX_MIN && nalType <= FRAME_INDEX_NAL_TYPE_PREFIX_MAX)) {
+            if (scanner->isAccessUnitHasSlice || !scanner->isAccessUnitOpen) {
+                DjiTest_FrameIndexStartAccessUnit(scanner, scanner->nalPosition);
+            }
+        }
+    } else if (scanner->state == FRAME_INDEX_SCAN_STATE_SLICE_HEADER ||
+               scanner->state == FRAME_INDEX_SCAN_STATE_IDR_SLICE_HEADER) {
+        if ((scanner->isAccessUnitHasSlice && (byte & FRAME_INDEX_FIRST_MB_ZERO_MASK) != 0) ||
+            !scanner->isAccessUnitOpen) {
+            DjiTest_FrameIndexStartAccessUnit(scanner, scanner->nalPosition);
+        }
+        scanner->isAccessUnitHasSlice = true;
+        scanner->isAccessUnitHasIdr |= scanner->state == FRAME_INDEX_SCAN_STATE_IDR_SLICE_HEADER;
+        scanner->state = FRAME_INDEX_SCAN_STATE_PAYLOAD;
+    }
+
+    // start code search, emulation prevention keeps 00 00 01 out of NAL unit payload
+    if (byte == 0) {
+        scanner->zeroCount++;
+    } else {
+        if (byte == 1 && scanner->zeroCount >= 2) {
+            scanner->nalPosition = position - USER_UTIL_MIN(scanner->zeroCount, FRAME_INDEX_START_CODE_ZERO_MAX);
+            scanner->state = FRAME_INDEX_SCAN_STATE_NAL_HEADER;
+        }
+        scanner->zeroCount = 0;
+    }
+}
+
+// FNV-1a, damaged cache is detected and built again
+static uint32_t DjiTest_FrameIndexGetChecksum(const uint8_t *data, uint32_t len)
+{
+    uint32_t checksum = FRAME_INDEX_CACHE_FNV_OFFSET;
+    uint32_t i;
+
+    for (i = 0; i < len; i++) {
+        checksum = (checksum ^ data[i]) * FRAME_INDEX_CACHE_FNV_PRIME;
+    }
+
+    return checksum;
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
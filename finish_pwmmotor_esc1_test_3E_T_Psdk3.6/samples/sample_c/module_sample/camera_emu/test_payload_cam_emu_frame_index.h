@@ -0,0 +1,85 @@
+/**
+ ********************************************************************
+ * @file    test_payload_cam_emu_frame_index.h
+ * @brief   This is the header file for "test_payload_cam_emu_frame_index.c", defining the structure and
+ * (exported) function prototypes.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef TEST_PAYLOAD_CAM_EMU_FRAME_INDEX_H
+#define TEST_PAYLOAD_CAM_EMU_FRAME_INDEX_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "dji_typedef.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Exported constants --------------------------------------------------------*/
+#define FRAME_INDEX_CACHE_FILE_SUFFIX       ".fidx"
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct {
+    float durationS;
+    uint32_t positionInFile;
+    uint32_t size;
+    uint32_t ptsMs;
+    bool isKeyFrame;
+} T_TestPayloadCameraVideoFrameInfo;
+
+// a cached index is valid only while the media file it is built from keeps its size and modify time
+typedef struct {
+    uint64_t sourceFileSize;
+    int64_t sourceModifyTimeNs;
+} T_TestPayloadCameraFrameIndexKey;
+
+// decoding has to start at a key frame, frame at the seek time is decodeForwardCount frames after it
+typedef struct {
+    uint32_t keyFrameNumber;
+    uint32_t decodeForwardCount;
+} T_TestPayloadCameraFrameSeekPosition;
+
+/* Exported functions --------------------------------------------------------*/
+T_DjiReturnCode DjiTest_FrameIndexScanH264File(const char *path, float frameRate,
+                                               T_TestPayloadCameraVideoFrameInfo *frameInfo,
+                                               uint32_t frameInfoBufferCount, uint32_t *frameCount);
+T_DjiReturnCode DjiTest_FrameIndexGetCachePath(const char *sourcePath, char *cachePath, uint32_t cachePathSize);
+T_DjiReturnCode DjiTest_FrameIndexGetCacheKey(const char *sourcePath, T_TestPayloadCameraFrameIndexKey *key);
+T_DjiReturnCode DjiTest_FrameIndexLoadCache(const char *cachePath, const T_TestPayloadCameraFrameIndexKey *key,
+                                            float *frameRate, T_TestPayloadCameraVideoFrameInfo *frameInfo,
+                                            uint32_t frameInfoBufferCount, uint32_t *frameCount);
+T_DjiReturnCode DjiTest_FrameIndexSaveCache(const char *cachePath, const T_TestPayloadCameraFrameIndexKey *key,
+                                            float frameRate, const T_TestPayloadCameraVideoFrameInfo *frameInfo,
+                                            uint32_t frameCount);
+T_DjiReturnCode DjiTest_FrameIndexBuildKeyFrameIndex(const T_TestPayloadCameraVideoFrameInfo *frameInfo,
+                                                     uint32_t frameCount, uint32_t *keyFrameIndex,
+                                                     uint32_t keyFrameIndexBufferCount, uint32_t *keyFrameCount);
+T_DjiReturnCode DjiTest_FrameIndexSeek(const T_TestPayloadCameraVideoFrameInfo *frameInfo, uint32_t frameCount,
+                                       const uint32_t *keyFrameIndex, uint32_t keyFrameCount, uint32_t timeMs,
+                                       T_TestPayloadCameraFrameSeekPosition *position);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TEST_PAYLOAD_CAM_EMU_FRAME_INDEX_H
+/************************ (C) COPYRIGHT DJI Innovations *******END OF FILE******/
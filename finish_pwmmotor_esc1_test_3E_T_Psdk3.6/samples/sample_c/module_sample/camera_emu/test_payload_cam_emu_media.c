@@ -25,6 +25,7 @@
 /* Includes ------------------------------------------------------------------*/
 #include <fcntl.h>
 #include <stdlib.h>
+#include <dirent.h>
 #include "dji_logger.h"
 #include "utils/util_misc.h"
 #include "utils/util_time.h"
@@ -32,7 +33,12 @@
 #include "utils/util_buffer.h"
 #include "test_payload_cam_emu_media.h"
 #include "test_payload_cam_emu_base.h"
+#include "test_payload_cam_emu_frame_index.h"
+#include "test_payload_cam_emu_video_source.h"
+#include "test_payload_cam_emu_media_catalog.h"
 #include "camera_emu/dji_media_file_manage/dji_media_file_core.h"
+#include "camera_emu/dji_media_file_manage/dji_media_file_mp4.h"
+#include "camera_emu/dji_media_file_manage/dji_media_file_preview.h"
 #include "dji_high_speed_data_channel.h"
 #include "dji_aircraft_info.h"
 
@@ -40,8 +46,10 @@
 #define FFMPEG_CMD_BUF_SIZE                 (256 + 256)
 #define SEND_VIDEO_TASK_FREQ                 120
 #define VIDEO_FRAME_MAX_COUNT                18000 // max video duration 10 minutes
-#define VIDEO_FRAME_AUD_LEN                  6
 #define DATA_SEND_FROM_VIDEO_STREAM_MAX_LEN  60000
+#define FRAME_INDEX_TRANSCODED_FILE_NAME     ".frame_index"
+#define PREVIEW_CACHE_DIR_NAME               ".preview_cache"
+#define PREVIEW_MEMORY_CACHE_SIZE_MAX        (8 * 1024 * 1024)
 
 /* Private types -------------------------------------------------------------*/
 typedef enum {
@@ -65,12 +73,6 @@ typedef struct {
     char path[DJI_FILE_PATH_SIZE_MAX];
 } T_TestPayloadCameraPlaybackCommand;
 
-typedef struct {
-    float durationS;
-    uint32_t positionInFile;
-    uint32_t size;
-} T_TestPayloadCameraVideoFrameInfo;
-
 /* Private functions declaration ---------------------------------------------*/
 static T_DjiReturnCode DjiPlayback_StopPlay(T_DjiPlaybackInfo *playbackInfo);
 static T_DjiReturnCode DjiPlayback_PausePlay(T_DjiPlaybackInfo *playbackInfo);
@@ -85,13 +87,15 @@ static T_DjiReturnCode DjiPlayback_StartPlayProcess(const char *filePath, uint32
 static T_DjiReturnCode DjiPlayback_StopPlayProcess(void);
 static T_DjiReturnCode
 DjiPlayback_VideoFileTranscode(const char *inPath, const char *outFormat, char *outPath, uint16_t outPathBufferSize);
-static T_DjiReturnCode
-DjiPlayback_GetFrameInfoOfVideoFile(const char *path, T_TestPayloadCameraVideoFrameInfo *frameInfo,
-                                    uint32_t frameInfoBufferCount, uint32_t *frameCount);
+static T_DjiReturnCode DjiPlayback_RunTranscodeCommand(const char *inPath, const char *outFormat, const char *outPath);
 static T_DjiReturnCode DjiPlayback_GetFrameRateOfVideoFile(const char *path, float *frameRate);
 static T_DjiReturnCode
-DjiPlayback_GetFrameNumberByTime(T_TestPayloadCameraVideoFrameInfo *frameInfo, uint32_t frameCount,
-                                 uint32_t *frameNumber, uint32_t timeMs);
+DjiPlayback_GetFrameInfoOfVideoFile(const char *filePath, const char *transcodedFilePath, float *frameRate,
+                                    T_TestPayloadCameraVideoFrameInfo *frameInfo, uint32_t frameInfoBufferCount,
+                                    uint32_t *frameCount);
+static T_DjiReturnCode DjiPlayback_BuildFrameIndexCache(const char *filePath, const char *transcodedFilePath,
+                                                        T_TestPayloadCameraVideoFrameInfo *frameInfo,
+                                                        uint32_t frameInfoBufferCount);
 static T_DjiReturnCode GetMediaFileDir(char *dirPath);
 static T_DjiReturnCode GetMediaFileOriginData(const char *filePath, uint32_t offset, uint32_t length,
                                               uint8_t *data);
@@ -120,21 +124,19 @@ static T_DjiReturnCode StartDownloadNotification(void);
 static T_DjiReturnCode StopDownloadNotification(void);
 
 _Noreturn static void *UserCameraMedia_SendVideoTask(void *arg);
+static void *UserCameraMedia_BuildFrameIndexTask(void *arg);
 
 /* Private variables -------------------------------------------------------------*/
 static T_DjiCameraMediaDownloadPlaybackHandler s_psdkCameraMedia = {0};
 static T_DjiPlaybackInfo s_playbackInfo = {0};
 static T_DjiTaskHandle s_userSendVideoThread;
+static T_DjiTaskHandle s_userBuildFrameIndexThread;
+static T_DjiMutexHandle s_frameIndexCacheMutex = {0};
 static T_UtilBuffer s_mediaPlayCommandBufferHandler = {0};
 static T_DjiMutexHandle s_mediaPlayCommandBufferMutex = {0};
 static uint8_t s_mediaPlayCommandBuffer[sizeof(T_TestPayloadCameraPlaybackCommand) * 32] = {0};
-static const char *s_frameKeyChar = "[PACKET]";
-static const char *s_frameDurationTimeKeyChar = "duration_time";
-static const char *s_framePositionKeyChar = "pos";
-static const char *s_frameSizeKeyChar = "size";
 static T_DjiMediaFileHandle s_mediaFileThumbNailHandle;
 static T_DjiMediaFileHandle s_mediaFileScreenNailHandle;
-static const uint8_t s_frameAudInfo[VIDEO_FRAME_AUD_LEN] = {0x00, 0x00, 0x00, 0x01, 0x09, 0x10};
 static char s_mediaFileDirPath[DJI_FILE_PATH_SIZE_MAX] = {0};
 static bool s_isMediaFileDirPathConfigured = false;
 
@@ -146,6 +148,10 @@ T_DjiReturnCode DjiTest_CameraEmuMediaStartService(void)
     const T_DjiDataChannelBandwidthProportionOfHighspeedChannel bandwidthProportionOfHighspeedChannel =
         {10, 60, 30};
     T_DjiAircraftInfoBaseInfo aircraftInfoBaseInfo = {0};
+    T_DjiMediaFilePreviewConfig previewConfig = {0};
+    char curFileDirPath[DJI_FILE_PATH_SIZE_MAX];
+    char mediaDirPath[DJI_FILE_PATH_SIZE_MAX] = {0};
+    char previewCacheDirPath[DJI_FILE_PATH_SIZE_MAX] = {0};
 
     if (DjiAircraftInfo_GetBaseInfo(&aircraftInfoBaseInfo) != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
         USER_LOG_ERROR("get aircraft information error.");
@@ -186,6 +192,37 @@ T_DjiReturnCode DjiTest_CameraEmuMediaStartService(void)
 
     UtilBuffer_Init(&s_mediaPlayCommandBufferHandler, s_mediaPlayCommandBuffer, sizeof(s_mediaPlayCommandBuffer));
 
+    if (osalHandler->MutexCreate(&s_frameIndexCacheMutex) != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        USER_LOG_ERROR("mutex create error");
+        return DJI_ERROR_SYSTEM_MODULE_CODE_UNKNOWN;
+    }
+
+    if (s_isMediaFileDirPathConfigured == true) {
+        snprintf(mediaDirPath, DJI_FILE_PATH_SIZE_MAX, "%s", s_mediaFileDirPath);
+    } else if (DjiUserUtil_GetCurrentFileDirPath(__FILE__, DJI_FILE_PATH_SIZE_MAX, curFileDirPath) ==
+               DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        snprintf(mediaDirPath, DJI_FILE_PATH_SIZE_MAX, "%smedia_file/", curFileDirPath);
+    }
+
+    // previews are kept across restarts in a hidden directory of the media files, like the frame index caches
+    if (mediaDirPath[0] != '\0') {
+        snprintf(previewCacheDirPath, DJI_FILE_PATH_SIZE_MAX, "%s%s", mediaDirPath, PREVIEW_CACHE_DIR_NAME);
+    }
+    previewConfig.memoryCacheSizeMax = PREVIEW_MEMORY_CACHE_SIZE_MAX;
+    previewConfig.diskCacheDirPath = previewCacheDirPath[0] != '\0' ? previewCacheDirPath : NULL;
+    returnCode = DjiMediaFile_PreviewInit(&previewConfig);
+    if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        USER_LOG_WARN("media file preview cache init error, previews are made without cache.");
+    }
+
+    // file information is served from the catalog, attributes are not read from files on every request
+    if (mediaDirPath[0] != '\0') {
+        returnCode = DjiTest_MediaCatalogInit(mediaDirPath);
+        if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+            USER_LOG_WARN("media catalog init error, file information is read from files.");
+        }
+    }
+
     if (aircraftInfoBaseInfo.aircraftType == DJI_AIRCRAFT_TYPE_M300_RTK ||
         aircraftInfoBaseInfo.aircraftType == DJI_AIRCRAFT_TYPE_M350_RTK) {
         returnCode = DjiPayloadCamera_RegMediaDownloadPlaybackHandler(&s_psdkCameraMedia);
@@ -208,6 +245,14 @@ T_DjiReturnCode DjiTest_CameraEmuMediaStartService(void)
             USER_LOG_ERROR("user send video task create error.");
             return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
         }
+
+        // frame index of every video is built once in background, so playback starts without scanning the video
+        returnCode = osalHandler->TaskCreate("user_camera_frame_index_task", UserCameraMedia_BuildFrameIndexTask,
+                                             2048, NULL, &s_userBuildFrameIndexThread);
+        if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+            USER_LOG_ERROR("user build frame index task create error.");
+            return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+        }
     }
 
     return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
@@ -226,6 +271,14 @@ T_DjiReturnCode DjiTest_CameraMediaGetFileInfo(const char *filePath, T_DjiCamera
 {
     T_DjiReturnCode returnCode;
     T_DjiMediaFileHandle mediaFileHandle;
+    T_TestPayloadCameraMediaCatalogFileInfo catalogFileInfo;
+
+    if (DjiTest_MediaCatalogGetFileInfo(filePath, &catalogFileInfo) == DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        fileInfo->type = catalogFileInfo.type;
+        fileInfo->mediaFileAttr = catalogFileInfo.mediaFileAttr;
+        fileInfo->fileSize = catalogFileInfo.fileSize;
+        return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+    }
 
     returnCode = DjiMediaFile_CreateHandle(filePath, &mediaFileHandle);
     if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
@@ -523,8 +576,6 @@ static T_DjiReturnCode DjiPlayback_VideoFileTranscode(const char *inPath, const
 {
     T_DjiReturnCode returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
     T_DjiReturnCode djiStatus = DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
-    FILE *fpCommand = NULL;
-    char ffmpegCmdStr[FFMPEG_CMD_BUF_SIZE];
     char *directory = NULL;
     T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
 
@@ -542,17 +593,7 @@ static T_DjiReturnCode DjiPlayback_VideoFileTranscode(const char *inPath, const
     }
 
     snprintf(outPath, outPathBufferSize, "%sout.%s", directory, outFormat);
-    snprintf(ffmpegCmdStr, FFMPEG_CMD_BUF_SIZE,
-             "echo \"y\" | ffmpeg -i \"%s\" -codec copy -f \"%s\" \"%s\" 1>/dev/null 2>&1", inPath,
-             outFormat, outPath);
-    fpCommand = popen(ffmpegCmdStr, "r");
-    if (fpCommand == NULL) {
-        USER_LOG_ERROR("execute transcode command fail.");
-        returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_UNKNOWN;
-        goto out;
-    }
-
-    pclose(fpCommand);
+    returnCode = DjiPlayback_RunTranscodeCommand(inPath, outFormat, outPath);
 
 out:
     osalHandler->Free(directory);
@@ -560,145 +601,23 @@ out:
     return returnCode;
 }
 
-static T_DjiReturnCode
-DjiPlayback_GetFrameInfoOfVideoFile(const char *path, T_TestPayloadCameraVideoFrameInfo *frameInfo,
-                                    uint32_t frameInfoBufferCount, uint32_t *frameCount)
+static T_DjiReturnCode DjiPlayback_RunTranscodeCommand(const char *inPath, const char *outFormat, const char *outPath)
 {
-    long ret;
-    T_DjiReturnCode returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
     FILE *fpCommand = NULL;
     char ffmpegCmdStr[FFMPEG_CMD_BUF_SIZE];
-    char *frameInfoString = NULL;
-    char *frameLocation = NULL;
-    char frameParameterFormat[50] = {0};
-    char *frameDurationTimeLocation = NULL;
-    float frameDurationTimeS = 0;
-    uint32_t frameNumber = 0;
-    char *framePositionLocation = NULL;
-    uint32_t framePosition = 0;
-    char *frameSizeLocation = NULL;
-    uint32_t frameSize = 0;
-    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
-
-    frameInfoString = osalHandler->Malloc(VIDEO_FRAME_MAX_COUNT * 1024);
-    if (frameInfoString == NULL) {
-        USER_LOG_ERROR("malloc memory for frame info fail.");
-        return DJI_ERROR_SYSTEM_MODULE_CODE_MEMORY_ALLOC_FAILED;
-    }
-    memset(frameInfoString, 0, VIDEO_FRAME_MAX_COUNT * 1024);
 
-    snprintf(ffmpegCmdStr, FFMPEG_CMD_BUF_SIZE, "ffprobe -show_packets \"%s\" 2>/dev/null", path);
+    snprintf(ffmpegCmdStr, FFMPEG_CMD_BUF_SIZE,
+             "echo \"y\" | ffmpeg -i \"%s\" -codec copy -f \"%s\" \"%s\" 1>/dev/null 2>&1", inPath,
+             outFormat, outPath);
     fpCommand = popen(ffmpegCmdStr, "r");
     if (fpCommand == NULL) {
-        USER_LOG_ERROR("execute show frames commands fail.");
-        returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_UNKNOWN;
-        goto out2;
-    }
-
-    ret = (long) fread(frameInfoString, 1, VIDEO_FRAME_MAX_COUNT * 1024, fpCommand);
-    if (ret < 0) {
-        USER_LOG_ERROR("read show frames commands result error.");
-        goto out1;
-    }
-    frameInfoString[ret] = '\0';
-
-    frameLocation = frameInfoString;
-    *frameCount = 0;
-    while (1) {
-        // find frame
-        frameLocation = strstr(frameLocation, s_frameKeyChar);
-        if (frameLocation == NULL) {
-            USER_LOG_DEBUG("reach file tail.");
-            break;
-        }
-
-        // find frame duration
-        frameDurationTimeLocation = strstr(frameLocation, s_frameDurationTimeKeyChar);
-        if (frameDurationTimeLocation == NULL) {
-            USER_LOG_ERROR("can not find pkt_duration_time.");
-            returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
-            goto out1;
-        }
-
-        ret = snprintf(frameParameterFormat, sizeof(frameParameterFormat), "%s=%%f", s_frameDurationTimeKeyChar);
-        if (ret < 0) {
-            USER_LOG_ERROR("snprintf frameParameterFormat fail.");
-            returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_UNKNOWN;
-            goto out1;
-        }
-
-        ret = sscanf(frameDurationTimeLocation, frameParameterFormat, &frameDurationTimeS);
-        if (ret <= 0) {
-            USER_LOG_ERROR("can not find pkt_duration_time.");
-            returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
-            goto out1;
-        }
-        frameInfo[frameNumber].durationS = frameDurationTimeS;
-
-        // find frame position
-        framePositionLocation = strstr(frameLocation, s_framePositionKeyChar);
-        if (framePositionLocation == NULL) {
-            USER_LOG_ERROR("can not found pkt_pos.");
-            returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
-            goto out1;
-        }
-
-        ret = snprintf(frameParameterFormat, sizeof(frameParameterFormat), "%s=%%d", s_framePositionKeyChar);
-        if (ret < 0) {
-            USER_LOG_ERROR("snprintf frameParameterFormat fail.");
-            returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_UNKNOWN;
-            goto out1;
-        }
-
-        ret = sscanf(framePositionLocation, frameParameterFormat, &framePosition);
-        if (ret <= 0) {
-            USER_LOG_ERROR("can not found pkt_pos.");
-            returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
-            goto out1;
-        }
-        frameInfo[frameNumber].positionInFile = framePosition;
-
-        // find frame size
-        frameSizeLocation = strstr(frameLocation, s_frameSizeKeyChar);
-        if (frameSizeLocation == NULL) {
-            USER_LOG_ERROR("can not found pkt_size.");
-            returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
-            goto out1;
-        }
-
-        ret = snprintf(frameParameterFormat, sizeof(frameParameterFormat), "%s=%%d", s_frameSizeKeyChar);
-        if (ret < 0) {
-            USER_LOG_ERROR("snprintf frameParameterFormat fail.");
-            returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_UNKNOWN;
-            goto out1;
-        }
-
-        ret = sscanf(frameSizeLocation, frameParameterFormat, &frameSize);
-        if (ret <= 0) {
-            USER_LOG_ERROR("can not find pkt_size.");
-            returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
-            goto out1;
-        }
-        frameInfo[frameNumber].size = frameSize;
-
-        frameLocation += strlen(s_frameKeyChar);
-        frameNumber++;
-        (*frameCount)++;
-
-        if (frameNumber >= frameInfoBufferCount) {
-            USER_LOG_ERROR("frame buffer is full.");
-            returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_OUT_OF_RANGE;
-            goto out1;
-        }
+        USER_LOG_ERROR("execute transcode command fail.");
+        return DJI_ERROR_SYSTEM_MODULE_CODE_UNKNOWN;
     }
 
-out1:
     pclose(fpCommand);
 
-out2:
-    osalHandler->Free(frameInfoString);
-
-    return returnCode;
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
 }
 
 static T_DjiReturnCode DjiPlayback_GetFrameRateOfVideoFile(const char *path, float *frameRate)
@@ -731,23 +650,95 @@ out:
     return returnCode;
 }
 
-static T_DjiReturnCode DjiPlayback_GetFrameNumberByTime(T_TestPayloadCameraVideoFrameInfo *frameInfo,
-                                                        uint32_t frameCount, uint32_t *frameNumber, uint32_t timeMs)
+/**
+ * @brief Get frame rate and frame index of a video, from the frame index cache of the video when it is valid,
+ * otherwise by scanning the transcoded file, and the cache is saved for next time.
+ */
+static T_DjiReturnCode
+DjiPlayback_GetFrameInfoOfVideoFile(const char *filePath, const char *transcodedFilePath, float *frameRate,
+                                    T_TestPayloadCameraVideoFrameInfo *frameInfo, uint32_t frameInfoBufferCount,
+                                    uint32_t *frameCount)
 {
-    uint32_t i = 0;
-    double camulativeTimeS = 0;
-    double timeS = (double) timeMs / 1000.0;
+    T_DjiReturnCode returnCode;
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+    T_TestPayloadCameraFrameIndexKey cacheKey;
+    char cachePath[DJI_FILE_PATH_SIZE_MAX];
+    bool isCacheUsable;
+
+    isCacheUsable = DjiTest_FrameIndexGetCachePath(filePath, cachePath, sizeof(cachePath)) ==
+                    DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS &&
+                    DjiTest_FrameIndexGetCacheKey(filePath, &cacheKey) == DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+    if (isCacheUsable &&
+        DjiTest_FrameIndexLoadCache(cachePath, &cacheKey, frameRate, frameInfo, frameInfoBufferCount,
+                                    frameCount) == DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+    }
+
+    returnCode = DjiPlayback_GetFrameRateOfVideoFile(transcodedFilePath, frameRate);
+    if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        USER_LOG_ERROR("get frame rate of video error: 0x%08llX.", returnCode);
+        return returnCode;
+    }
 
-    for (i = 0; i < frameCount; ++i) {
-        camulativeTimeS += frameInfo[i].durationS;
+    returnCode = DjiTest_FrameIndexScanH264File(transcodedFilePath, *frameRate, frameInfo, frameInfoBufferCount,
+                                                frameCount);
+    if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        USER_LOG_ERROR("get frame info of video error: 0x%08llX.", returnCode);
+        return returnCode;
+    }
 
-        if (camulativeTimeS >= timeS) {
-            *frameNumber = i;
+    if (isCacheUsable) {
+        if (osalHandler->MutexLock(s_frameIndexCacheMutex) != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+            USER_LOG_ERROR("mutex lock error");
             return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
         }
+
+        DjiTest_FrameIndexSaveCache(cachePath, &cacheKey, *frameRate, frameInfo, *frameCount);
+
+        if (osalHandler->MutexUnlock(s_frameIndexCacheMutex) != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+            USER_LOG_ERROR("mutex unlock error");
+        }
+    }
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+// build frame index cache of a video if it has no valid one, transcodedFilePath is scratch file of transcoding
+static T_DjiReturnCode DjiPlayback_BuildFrameIndexCache(const char *filePath, const char *transcodedFilePath,
+                                                        T_TestPayloadCameraVideoFrameInfo *frameInfo,
+                                                        uint32_t frameInfoBufferCount)
+{
+    T_DjiReturnCode returnCode;
+    T_TestPayloadCameraFrameIndexKey cacheKey;
+    char cachePath[DJI_FILE_PATH_SIZE_MAX];
+    float frameRate = 1.0f;
+    uint32_t frameCount = 0;
+
+    returnCode = DjiTest_FrameIndexGetCachePath(filePath, cachePath, sizeof(cachePath));
+    if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        return returnCode;
+    }
+
+    returnCode = DjiTest_FrameIndexGetCacheKey(filePath, &cacheKey);
+    if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        return returnCode;
+    }
+
+    if (DjiTest_FrameIndexLoadCache(cachePath, &cacheKey, &frameRate, frameInfo, frameInfoBufferCount,
+                                    &frameCount) == DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+    }
+
+    returnCode = DjiPlayback_RunTranscodeCommand(filePath, "h264", transcodedFilePath);
+    if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        return returnCode;
     }
 
-    return DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
+    returnCode = DjiPlayback_GetFrameInfoOfVideoFile(filePath, transcodedFilePath, &frameRate, frameInfo,
+                                                     frameInfoBufferCount, &frameCount);
+    remove(transcodedFilePath);
+
+    return returnCode;
 }
 
 static T_DjiReturnCode GetMediaFileDir(char *dirPath)
@@ -994,6 +985,7 @@ static T_DjiReturnCode DestroyMediaFileScreenNail(const char *filePath)
 static T_DjiReturnCode DeleteMediaFile(char *filePath)
 {
     T_DjiReturnCode returnCode;
+    char cachePath[DJI_FILE_PATH_SIZE_MAX];
 
     USER_LOG_INFO("delete media file:%s", filePath);
     returnCode = DjiFile_Delete(filePath);
@@ -1002,6 +994,13 @@ static T_DjiReturnCode DeleteMediaFile(char *filePath)
         return returnCode;
     }
 
+    if (DjiTest_FrameIndexGetCachePath(filePath, cachePath, sizeof(cachePath)) ==
+        DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        remove(cachePath);
+    }
+    DjiMediaFile_PreviewRemove(filePath);
+    DjiTest_MediaCatalogRemoveFile(filePath);
+
     return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
 }
 
@@ -1151,14 +1150,10 @@ static T_DjiReturnCode StopDownloadNotification(void)
 
 static void *UserCameraMedia_SendVideoTask(void *arg)
 {
-    int ret;
     T_DjiReturnCode returnCode;
     static uint32_t sendVideoStep = 0;
-    FILE *fpFile = NULL;
-    unsigned long dataLength = 0;
-    uint16_t lengthOfDataToBeSent = 0;
-    int lengthOfDataHaveBeenSent = 0;
-    char *dataBuffer = NULL;
+    T_TestPayloadCameraVideoSource videoSource = {.fd = -1};
+    bool isVideoSourceOpened = false;
     T_TestPayloadCameraPlaybackCommand playbackCommand = {0};
     uint16_t bufferReadSize = 0;
     char *videoFilePath = NULL;
@@ -1167,13 +1162,15 @@ static void *UserCameraMedia_SendVideoTask(void *arg)
     T_TestPayloadCameraVideoFrameInfo *frameInfo = NULL;
     uint32_t frameNumber = 0;
     uint32_t frameCount = 0;
+    uint32_t *keyFrameIndex = NULL;
+    uint32_t keyFrameCount = 0;
+    T_TestPayloadCameraFrameSeekPosition seekPosition = {0};
     uint32_t startTimeMs = 0;
     bool sendVideoFlag = true;
     bool sendOneTimeFlag = false;
     T_DjiDataChannelState videoStreamState = {0};
     E_DjiCameraMode mode = DJI_CAMERA_MODE_SHOOT_PHOTO;
     T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
-    uint32_t frameBufSize = 0;
     E_DjiCameraVideoStreamType videoStreamType;
     char curFileDirPath[DJI_FILE_PATH_SIZE_MAX];
     char tempPath[DJI_FILE_PATH_SIZE_MAX];
@@ -1210,6 +1207,12 @@ static void *UserCameraMedia_SendVideoTask(void *arg)
     }
     memset(frameInfo, 0, VIDEO_FRAME_MAX_COUNT * sizeof(T_TestPayloadCameraVideoFrameInfo));
 
+    keyFrameIndex = osalHandler->Malloc(VIDEO_FRAME_MAX_COUNT * sizeof(uint32_t));
+    if (keyFrameIndex == NULL) {
+        USER_LOG_ERROR("malloc memory for key frame index fail.");
+        exit(1);
+    }
+
     returnCode = DjiPlayback_StopPlayProcess();
     if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
         USER_LOG_ERROR("stop playback and start liveview error: 0x%08llX.", returnCode);
@@ -1266,37 +1269,43 @@ static void *UserCameraMedia_SendVideoTask(void *arg)
             continue;
         }
 
-        returnCode = DjiPlayback_GetFrameRateOfVideoFile(transcodedFilePath, &frameRate);
+        returnCode = DjiPlayback_GetFrameInfoOfVideoFile(videoFilePath, transcodedFilePath, &frameRate, frameInfo,
+                                                         VIDEO_FRAME_MAX_COUNT, &frameCount);
         if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
-            USER_LOG_ERROR("get frame rate of video error: 0x%08llX.", returnCode);
+            USER_LOG_ERROR("get frame info of video error: 0x%08llX.", returnCode);
             continue;
         }
 
-        returnCode = DjiPlayback_GetFrameInfoOfVideoFile(transcodedFilePath, frameInfo, VIDEO_FRAME_MAX_COUNT,
-                                                         &frameCount);
+        returnCode = DjiTest_FrameIndexBuildKeyFrameIndex(frameInfo, frameCount, keyFrameIndex, VIDEO_FRAME_MAX_COUNT,
+                                                          &keyFrameCount);
         if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
-            USER_LOG_ERROR("get frame info of video error: 0x%08llX.", returnCode);
+            USER_LOG_ERROR("build key frame index error: 0x%08llX.", returnCode);
             continue;
         }
 
-        returnCode = DjiPlayback_GetFrameNumberByTime(frameInfo, frameCount, &frameNumber,
-                                                      startTimeMs);
+        // decoder needs the frames from the last key frame on, so sending starts there
+        returnCode = DjiTest_FrameIndexSeek(frameInfo, frameCount, keyFrameIndex, keyFrameCount, startTimeMs,
+                                            &seekPosition);
         if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
             USER_LOG_ERROR("get start frame number error: 0x%08llX.", returnCode);
             continue;
         }
+        frameNumber = seekPosition.keyFrameNumber;
 
-        if (fpFile != NULL)
-            fclose(fpFile);
+        if (isVideoSourceOpened == true) {
+            DjiTest_VideoSourceClose(&videoSource);
+            isVideoSourceOpened = false;
+        }
 
-        fpFile = fopen(transcodedFilePath, "rb+");
-        if (fpFile == NULL) {
+        returnCode = DjiTest_VideoSourceOpen(&videoSource, transcodedFilePath, frameInfo, frameCount);
+        if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
             USER_LOG_ERROR("open video file fail.");
             continue;
         }
+        isVideoSourceOpened = true;
 
 send:
-        if (fpFile == NULL) {
+        if (isVideoSourceOpened != true) {
             USER_LOG_ERROR("open video file fail.");
             continue;
         }
@@ -1318,51 +1327,19 @@ send:
             continue;
         }
 
-        if (!USER_UTIL_IS_WORK_TURN(sendVideoStep++, frameRate, SEND_VIDEO_TASK_FREQ))
+        // frames before the seek time are only for decoding, they are sent at task frequency to catch up
+        if (seekPosition.decodeForwardCount > 0) {
+            seekPosition.decodeForwardCount--;
+        } else if (!USER_UTIL_IS_WORK_TURN(sendVideoStep++, frameRate, SEND_VIDEO_TASK_FREQ)) {
             continue;
-
-        frameBufSize = frameInfo[frameNumber].size;
-        if (videoStreamType == DJI_CAMERA_VIDEO_STREAM_TYPE_H264_DJI_FORMAT) {
-            frameBufSize = frameBufSize + VIDEO_FRAME_AUD_LEN;
-        }
-
-        dataBuffer = calloc(frameBufSize, 1);
-        if (dataBuffer == NULL) {
-            USER_LOG_ERROR("malloc fail.");
-            goto free;
         }
 
-        ret = fseek(fpFile, frameInfo[frameNumber].positionInFile, SEEK_SET);
-        if (ret != 0) {
-            USER_LOG_ERROR("fseek fail.");
-            goto free;
-        }
-
-        dataLength = fread(dataBuffer, 1, frameInfo[frameNumber].size, fpFile);
-        if (dataLength != frameInfo[frameNumber].size) {
-            USER_LOG_ERROR("read data from video file error.");
-        } else {
-            USER_LOG_DEBUG("read data from video file success, len = %d B\r\n", dataLength);
-        }
-
-        if (videoStreamType == DJI_CAMERA_VIDEO_STREAM_TYPE_H264_DJI_FORMAT) {
-            memcpy(&dataBuffer[frameInfo[frameNumber].size], s_frameAudInfo, VIDEO_FRAME_AUD_LEN);
-            dataLength = dataLength + VIDEO_FRAME_AUD_LEN;
-        }
+        // frames are sent from the mapped file, no buffer is allocated or copied per frame
+        DjiTest_VideoSourceSendFrame(&videoSource, &frameInfo[frameNumber],
+                                     videoStreamType == DJI_CAMERA_VIDEO_STREAM_TYPE_H264_DJI_FORMAT,
+                                     DATA_SEND_FROM_VIDEO_STREAM_MAX_LEN, DjiPayloadCamera_SendVideoStream);
 
-        lengthOfDataHaveBeenSent = 0;
-        while (dataLength - lengthOfDataHaveBeenSent) {
-            lengthOfDataToBeSent = USER_UTIL_MIN(DATA_SEND_FROM_VIDEO_STREAM_MAX_LEN,
-                                                 dataLength - lengthOfDataHaveBeenSent);
-            returnCode = DjiPayloadCamera_SendVideoStream((const uint8_t *) dataBuffer + lengthOfDataHaveBeenSent,
-                                                          lengthOfDataToBeSent);
-            if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
-                USER_LOG_ERROR("send video stream error: 0x%08llX.", returnCode);
-            }
-            lengthOfDataHaveBeenSent += lengthOfDataToBeSent;
-        }
-
-        if ((frameNumber++) >= frameCount) {
+        if ((++frameNumber) >= frameCount) {
             USER_LOG_DEBUG("reach file tail.");
             frameNumber = 0;
 
@@ -1380,9 +1357,6 @@ send:
         } else {
             USER_LOG_ERROR("get video stream state error.");
         }
-
-free:
-        free(dataBuffer);
     }
 }
 
@@ -1390,6 +1364,71 @@ free:
 #pragma GCC diagnostic pop
 #endif
 
+static void *UserCameraMedia_BuildFrameIndexTask(void *arg)
+{
+    T_DjiReturnCode returnCode;
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+    T_TestPayloadCameraVideoFrameInfo *frameInfo = NULL;
+    char curFileDirPath[DJI_FILE_PATH_SIZE_MAX];
+    char dirPath[DJI_FILE_PATH_SIZE_MAX];
+    char filePath[DJI_FILE_PATH_SIZE_MAX];
+    char transcodedFilePath[DJI_FILE_PATH_SIZE_MAX];
+    struct dirent *entry;
+    DIR *dir = NULL;
+    uint32_t builtCount = 0;
+
+    USER_UTIL_UNUSED(arg);
+
+    if (s_isMediaFileDirPathConfigured == true) {
+        snprintf(dirPath, DJI_FILE_PATH_SIZE_MAX, "%s", s_mediaFileDirPath);
+    } else {
+        returnCode = DjiUserUtil_GetCurrentFileDirPath(__FILE__, DJI_FILE_PATH_SIZE_MAX, curFileDirPath);
+        if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+            USER_LOG_ERROR("Get file current path error, stat = 0x%08llX", returnCode);
+            return NULL;
+        }
+        snprintf(dirPath, DJI_FILE_PATH_SIZE_MAX, "%smedia_file/", curFileDirPath);
+    }
+    snprintf(transcodedFilePath, DJI_FILE_PATH_SIZE_MAX, "%s%s.h264", dirPath, FRAME_INDEX_TRANSCODED_FILE_NAME);
+
+    frameInfo = osalHandler->Malloc(VIDEO_FRAME_MAX_COUNT * sizeof(T_TestPayloadCameraVideoFrameInfo));
+    if (frameInfo == NULL) {
+        USER_LOG_ERROR("malloc memory for frame info fail.");
+        return NULL;
+    }
+
+    dir = opendir(dirPath);
+    if (dir == NULL) {
+        USER_LOG_WARN("open media file directory %s fail.", dirPath);
+        goto out;
+    }
+
+    // hidden files are frame index caches and scratch files
+    while ((entry = readdir(dir)) != NULL) {
+        if (entry->d_name[0] == '.' || strlen(entry->d_name) <= strlen(".mp4") ||
+            !DjiMediaFile_IsSupported_MP4(entry->d_name)) {
+            continue;
+        }
+
+        snprintf(filePath, DJI_FILE_PATH_SIZE_MAX, "%s%s", dirPath, entry->d_name);
+        returnCode = DjiPlayback_BuildFrameIndexCache(filePath, transcodedFilePath, frameInfo, VIDEO_FRAME_MAX_COUNT);
+        if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+            USER_LOG_WARN("build frame index of %s error: 0x%08llX.", filePath, returnCode);
+            continue;
+        }
+        builtCount++;
+    }
+    USER_LOG_INFO("frame index of %d videos is ready.", builtCount);
+
+out:
+    if (dir != NULL) {
+        closedir(dir);
+    }
+    osalHandler->Free(frameInfo);
+
+    return NULL;
+}
+
 //#endif
 
 /****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
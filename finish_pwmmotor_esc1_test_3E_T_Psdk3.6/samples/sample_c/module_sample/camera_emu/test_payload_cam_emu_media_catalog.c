@@ -0,0 +1,882 @@
+/**
+ ********************************************************************
+ * @file    test_payload_cam_emu_media_catalog.c
+ * @brief   In memory catalog of the media directory, which keeps type, size, duration, resolution and create time
+ *          of every media file, so file information requests and file list pages are served without touching the
+ *          files. Attributes are read from file headers once, when the file is added. The catalog follows the
+ *          directory by inotify on Linux, and by DjiTest_MediaCatalogAddFile and DjiTest_MediaCatalogRemoveFile
+ *          called by the writer of media files on RTOS.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#ifdef SYSTEM_ARCH_LINUX
+#include <sys/inotify.h>
+#endif
+#include "dji_logger.h"
+#include "dji_platform.h"
+#include "test_payload_cam_emu_media_catalog.h"
+
+/* Private constants ---------------------------------------------------------*/
+#define MEDIA_CATALOG_DIR_PATH_SIZE_MAX     256
+#define MEDIA_CATALOG_FILE_PATH_SIZE_MAX    (MEDIA_CATALOG_DIR_PATH_SIZE_MAX + MEDIA_CATALOG_FILE_NAME_SIZE_MAX)
+#define MEDIA_CATALOG_HASH_BUCKET_NUM       1024
+#define MEDIA_CATALOG_CAPACITY_MIN          64
+#define MEDIA_CATALOG_FNV_OFFSET            2166136261U
+#define MEDIA_CATALOG_FNV_PRIME             16777619U
+#define MEDIA_CATALOG_JPG_FILE_SUFFIX       ".jpg"
+#define MEDIA_CATALOG_MP4_FILE_SUFFIX       ".mp4"
+
+#define MEDIA_CATALOG_JPG_MARKER_PREFIX     0xFF
+#define MEDIA_CATALOG_JPG_MARKER_SOI        0xD8
+#define MEDIA_CATALOG_JPG_MARKER_SOF0       0xC0
+#define MEDIA_CATALOG_JPG_MARKER_SOF15      0xCF
+#define MEDIA_CATALOG_JPG_MARKER_DHT        0xC4
+#define MEDIA_CATALOG_JPG_MARKER_JPG        0xC8
+#define MEDIA_CATALOG_JPG_MARKER_DAC        0xCC
+#define MEDIA_CATALOG_JPG_MARKER_RST0       0xD0
+#define MEDIA_CATALOG_JPG_MARKER_EOI        0xD9
+#define MEDIA_CATALOG_JPG_MARKER_SOS        0xDA
+#define MEDIA_CATALOG_JPG_MARKER_TEM        0x01
+//Exif, XMP and MPF segments come before SOF, a file with more segments than this is not a camera photo
+#define MEDIA_CATALOG_JPG_SEGMENT_NUM_MAX   64
+
+#define MEDIA_CATALOG_MP4_BOX_TYPE(a, b, c, d) \
+    (((uint32_t) (a) << 24) | ((uint32_t) (b) << 16) | ((uint32_t) (c) << 8) | (uint32_t) (d))
+#define MEDIA_CATALOG_MP4_BOX_MOOV          MEDIA_CATALOG_MP4_BOX_TYPE('m', 'o', 'o', 'v')
+#define MEDIA_CATALOG_MP4_BOX_MVHD          MEDIA_CATALOG_MP4_BOX_TYPE('m', 'v', 'h', 'd')
+#define MEDIA_CATALOG_MP4_BOX_TRAK          MEDIA_CATALOG_MP4_BOX_TYPE('t', 'r', 'a', 'k')
+#define MEDIA_CATALOG_MP4_BOX_TKHD          MEDIA_CATALOG_MP4_BOX_TYPE('t', 'k', 'h', 'd')
+#define MEDIA_CATALOG_MP4_BOX_MDIA          MEDIA_CATALOG_MP4_BOX_TYPE('m', 'd', 'i', 'a')
+#define MEDIA_CATALOG_MP4_BOX_MDHD          MEDIA_CATALOG_MP4_BOX_TYPE('m', 'd', 'h', 'd')
+#define MEDIA_CATALOG_MP4_BOX_HDLR          MEDIA_CATALOG_MP4_BOX_TYPE('h', 'd', 'l', 'r')
+#define MEDIA_CATALOG_MP4_BOX_MINF          MEDIA_CATALOG_MP4_BOX_TYPE('m', 'i', 'n', 'f')
+#define MEDIA_CATALOG_MP4_BOX_STBL          MEDIA_CATALOG_MP4_BOX_TYPE('s', 't', 'b', 'l')
+#define MEDIA_CATALOG_MP4_BOX_STTS          MEDIA_CATALOG_MP4_BOX_TYPE('s', 't', 't', 's')
+#define MEDIA_CATALOG_MP4_HANDLER_VIDE      MEDIA_CATALOG_MP4_BOX_TYPE('v', 'i', 'd', 'e')
+#define MEDIA_CATALOG_MP4_BOX_HEADER_SIZE   8
+//sample tables of a 10 minutes video take less than 1MB
+#define MEDIA_CATALOG_MP4_MOOV_SIZE_MAX     (16 * 1024 * 1024)
+
+#ifdef SYSTEM_ARCH_LINUX
+#define MEDIA_CATALOG_INOTIFY_BUFFER_SIZE   4096
+#endif
+
+/* Private types -------------------------------------------------------------*/
+typedef struct _MediaCatalogItem {
+    struct _MediaCatalogItem *hashNext;
+    uint32_t nameHash;
+    T_TestPayloadCameraMediaCatalogFileInfo fileInfo;
+} T_MediaCatalogItem;
+
+typedef struct {
+    uint16_t width;
+    uint16_t height;
+    E_DjiCameraVideoResolution resolution;
+} T_MediaCatalogResolutionItem;
+
+/* Private values -------------------------------------------------------------*/
+static const T_MediaCatalogResolutionItem s_mediaCatalogResolution[] = {
+    {640,  480,  DJI_CAMERA_VIDEO_RESOLUTION_640x480},
+    {1280, 720,  DJI_CAMERA_VIDEO_RESOLUTION_1280x720},
+    {1920, 1080, DJI_CAMERA_VIDEO_RESOLUTION_1920x1080},
+    {2048, 1080, DJI_CAMERA_VIDEO_RESOLUTION_2048x1080},
+    {3840, 2160, DJI_CAMERA_VIDEO_RESOLUTION_3840x2160},
+};
+
+static bool s_isMediaCatalogInited = false;
+static T_DjiMutexHandle s_mediaCatalogMutex = NULL;
+static char s_mediaCatalogDirPath[MEDIA_CATALOG_DIR_PATH_SIZE_MAX] = {0};
+static T_MediaCatalogItem *s_mediaCatalogHashTable[MEDIA_CATALOG_HASH_BUCKET_NUM] = {0};
+// items sorted by create time and then file name, file list pages are slices of it
+static T_MediaCatalogItem **s_mediaCatalogSortedItems = NULL;
+static uint32_t s_mediaCatalogItemCount = 0;
+static uint32_t s_mediaCatalogItemCapacity = 0;
+#ifdef SYSTEM_ARCH_LINUX
+static int s_mediaCatalogInotifyFd = -1;
+#endif
+
+/* Private functions declaration ---------------------------------------------*/
+static const char *DjiTest_MediaCatalogGetFileName(const char *filePath);
+static uint32_t DjiTest_MediaCatalogGetNameHash(const char *fileName);
+static T_DjiReturnCode DjiTest_MediaCatalogScanDir(void);
+static T_DjiReturnCode DjiTest_MediaCatalogReadFileInfo(const char *filePath, const char *fileName,
+                                                        T_TestPayloadCameraMediaCatalogFileInfo *fileInfo);
+static void DjiTest_MediaCatalogReadJpgInfo(int fd, T_TestPayloadCameraMediaCatalogFileInfo *fileInfo);
+static void DjiTest_MediaCatalogReadMp4Info(int fd, uint64_t fileSize,
+                                            T_TestPayloadCameraMediaCatalogFileInfo *fileInfo);
+static void DjiTest_MediaCatalogParseMp4Moov(const uint8_t *moov, uint32_t moovSize,
+                                             T_TestPayloadCameraMediaCatalogFileInfo *fileInfo);
+static bool DjiTest_MediaCatalogFindMp4Box(const uint8_t *data, uint32_t size, uint32_t *position, uint32_t type,
+                                           const uint8_t **box, uint32_t *boxSize);
+static uint32_t DjiTest_MediaCatalogReadU32(const uint8_t *data);
+static uint64_t DjiTest_MediaCatalogReadU64(const uint8_t *data);
+
+static T_MediaCatalogItem *DjiTest_MediaCatalogFindItem(const char *fileName, uint32_t nameHash);
+static T_DjiReturnCode DjiTest_MediaCatalogInsertItem(const T_TestPayloadCameraMediaCatalogFileInfo *fileInfo,
+                                                      bool isKeepSorted);
+static void DjiTest_MediaCatalogRemoveItem(T_MediaCatalogItem *item);
+static void DjiTest_MediaCatalogClear(void);
+static uint32_t DjiTest_MediaCatalogFindSortedPosition(const T_TestPayloadCameraMediaCatalogFileInfo *fileInfo);
+static int DjiTest_MediaCatalogCompare(const T_TestPayloadCameraMediaCatalogFileInfo *a,
+                                       const T_TestPayloadCameraMediaCatalogFileInfo *b);
+static int DjiTest_MediaCatalogCompareItem(const void *a, const void *b);
+static void DjiTest_MediaCatalogProcessEvents(void);
+
+/* Exported functions definition ---------------------------------------------*/
+/**
+ * @brief Build the catalog of a media directory and start following its changes.
+ * @param dirPath: media directory, with or without the trailing '/'.
+ * @return Execution result.
+ */
+T_DjiReturnCode DjiTest_MediaCatalogInit(const char *dirPath)
+{
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+    T_DjiReturnCode returnCode;
+    uint32_t dirPathLen = strlen(dirPath);
+
+    if (s_isMediaCatalogInited) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_DUPLICATE;
+    }
+
+    while (dirPathLen > 1 && dirPath[dirPathLen - 1] == '/') {
+        dirPathLen--;
+    }
+    if (dirPathLen == 0 || dirPathLen >= sizeof(s_mediaCatalogDirPath)) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+    memcpy(s_mediaCatalogDirPath, dirPath, dirPathLen);
+    s_mediaCatalogDirPath[dirPathLen] = '\0';
+
+    if (osalHandler->MutexCreate(&s_mediaCatalogMutex) != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        USER_LOG_ERROR("mutex create error");
+        return DJI_ERROR_SYSTEM_MODULE_CODE_UNKNOWN;
+    }
+
+#ifdef SYSTEM_ARCH_LINUX
+    //watch before scan, so a file written during the scan is not missed
+    s_mediaCatalogInotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (s_mediaCatalogInotifyFd < 0 ||
+        inotify_add_watch(s_mediaCatalogInotifyFd, s_mediaCatalogDirPath,
+                          IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE) < 0) {
+        USER_LOG_WARN("watch media directory %s fail, errno = %d.", s_mediaCatalogDirPath, errno);
+        if (s_mediaCatalogInotifyFd >= 0) {
+            close(s_mediaCatalogInotifyFd);
+            s_mediaCatalogInotifyFd = -1;
+        }
+    }
+#endif
+
+    s_isMediaCatalogInited = true;
+
+    returnCode = DjiTest_MediaCatalogScanDir();
+    if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        USER_LOG_WARN("scan media directory %s error: 0x%08llX.", s_mediaCatalogDirPath, returnCode);
+    }
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+T_DjiReturnCode DjiTest_MediaCatalogDeInit(void)
+{
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+
+    if (!s_isMediaCatalogInited) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+    }
+
+#ifdef SYSTEM_ARCH_LINUX
+    if (s_mediaCatalogInotifyFd >= 0) {
+        close(s_mediaCatalogInotifyFd);
+        s_mediaCatalogInotifyFd = -1;
+    }
+#endif
+
+    DjiTest_MediaCatalogClear();
+    if (s_mediaCatalogSortedItems != NULL) {
+        osalHandler->Free(s_mediaCatalogSortedItems);
+        s_mediaCatalogSortedItems = NULL;
+    }
+    s_mediaCatalogItemCapacity = 0;
+    osalHandler->MutexDestroy(s_mediaCatalogMutex);
+    s_mediaCatalogMutex = NULL;
+    s_isMediaCatalogInited = false;
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+/**
+ * @brief Add a new or rewritten media file of the directory, call it when the file is closed after writing.
+ * @note On Linux inotify does the same, calling it as well is harmless.
+ * @param filePath: path of the media file.
+ * @return Execution result, DJI_ERROR_SYSTEM_MODULE_CODE_NONSUPPORT when the file is not a media file.
+ */
+T_DjiReturnCode DjiTest_MediaCatalogAddFile(const char *filePath)
+{
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+    T_TestPayloadCameraMediaCatalogFileInfo fileInfo;
+    T_DjiReturnCode returnCode;
+    const char *fileName;
+
+    if (!s_isMediaCatalogInited) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_SYSTEM_ERROR;
+    }
+
+    fileName = DjiTest_MediaCatalogGetFileName(filePath);
+    if (fileName == NULL) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    //file is read without lock, queries are not blocked by disk
+    returnCode = DjiTest_MediaCatalogReadFileInfo(filePath, fileName, &fileInfo);
+    if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        return returnCode;
+    }
+
+    osalHandler->MutexLock(s_mediaCatalogMutex);
+    returnCode = DjiTest_MediaCatalogInsertItem(&fileInfo, true);
+    osalHandler->MutexUnlock(s_mediaCatalogMutex);
+
+    return returnCode;
+}
+
+T_DjiReturnCode DjiTest_MediaCatalogRemoveFile(const char *filePath)
+{
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+    T_MediaCatalogItem *item;
+    const char *fileName;
+
+    if (!s_isMediaCatalogInited) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_SYSTEM_ERROR;
+    }
+
+    fileName = DjiTest_MediaCatalogGetFileName(filePath);
+    if (fileName == NULL) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    osalHandler->MutexLock(s_mediaCatalogMutex);
+    item = DjiTest_MediaCatalogFindItem(fileName, DjiTest_MediaCatalogGetNameHash(fileName));
+    if (item != NULL) {
+        DjiTest_MediaCatalogRemoveItem(item);
+    }
+    osalHandler->MutexUnlock(s_mediaCatalogMutex);
+
+    return item != NULL ? DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS : DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
+}
+
+T_DjiReturnCode DjiTest_MediaCatalogGetFileInfo(const char *filePath,
+                                                T_TestPayloadCameraMediaCatalogFileInfo *fileInfo)
+{
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+    T_MediaCatalogItem *item;
+    const char *fileName;
+
+    if (!s_isMediaCatalogInited) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_SYSTEM_ERROR;
+    }
+
+    fileName = DjiTest_MediaCatalogGetFileName(filePath);
+    if (fileName == NULL) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    DjiTest_MediaCatalogProcessEvents();
+
+    osalHandler->MutexLock(s_mediaCatalogMutex);
+    item = DjiTest_MediaCatalogFindItem(fileName, DjiTest_MediaCatalogGetNameHash(fileName));
+    if (item != NULL) {
+        *fileInfo = item->fileInfo;
+    }
+    osalHandler->MutexUnlock(s_mediaCatalogMutex);
+
+    return item != NULL ? DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS : DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
+}
+
+/**
+ * @brief Get a page of the file list, sorted by create time.
+ * @param offset: index of the first file of the page.
+ * @param count: size of the page.
+ * @param isNewestFirst: true to sort from the newest file, false from the oldest.
+ * @param fileInfo: buffer of count files.
+ * @param fileCount: number of files in the page, less than count on the last page.
+ * @param totalFileCount: number of files in the catalog.
+ * @return Execution result.
+ */
+T_DjiReturnCode DjiTest_MediaCatalogQuery(uint32_t offset, uint32_t count, bool isNewestFirst,
+                                          T_TestPayloadCameraMediaCatalogFileInfo *fileInfo, uint32_t *fileCount,
+                                          uint32_t *totalFileCount)
+{
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+    uint32_t i;
+
+    *fileCount = 0;
+    *totalFileCount = 0;
+    if (!s_isMediaCatalogInited) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_SYSTEM_ERROR;
+    }
+
+    DjiTest_MediaCatalogProcessEvents();
+
+    osalHandler->MutexLock(s_mediaCatalogMutex);
+    *totalFileCount = s_mediaCatalogItemCount;
+    for (i = 0; i < count && offset < s_mediaCatalogItemCount - i; i++) {
+        if (isNewestFirst) {
+            fileInfo[i] = s_mediaCatalogSortedItems[s_mediaCatalogItemCount - 1 - offset - i]->fileInfo;
+        } else {
+            fileInfo[i] = s_mediaCatalogSortedItems[offset + i]->fileInfo;
+        }
+    }
+    *fileCount = i;
+    osalHandler->MutexUnlock(s_mediaCatalogMutex);
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+/* Private functions definition-----------------------------------------------*/
+// name of a file right in the media directory, NULL for other paths
+static const char *DjiTest_MediaCatalogGetFileName(const char *filePath)
+{
+    uint32_t dirPathLen = strlen(s_mediaCatalogDirPath);
+    const char *fileName;
+
+    if (strncmp(filePath, s_mediaCatalogDirPath, dirPathLen) != 0 || filePath[dirPathLen] != '/') {
+        return NULL;
+    }
+
+    fileName = &filePath[dirPathLen + 1];
+    while (*fileName == '/') {
+        fileName++;
+    }
+    if (*fileName == '\0' || strchr(fileName, '/') != NULL) {
+        return NULL;
+    }
+
+    return fileName;
+}
+
+static uint32_t DjiTest_MediaCatalogGetNameHash(const char *fileName)
+{
+    uint32_t hash = MEDIA_CATALOG_FNV_OFFSET;
+
+    while (*fileName != '\0') {
+        hash = (hash ^ (uint8_t) *fileName++) * MEDIA_CATALOG_FNV_PRIME;
+    }
+
+    return hash;
+}
+
+static T_DjiReturnCode DjiTest_MediaCatalogScanDir(void)
+{
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+    T_TestPayloadCameraMediaCatalogFileInfo fileInfo;
+    char filePath[MEDIA_CATALOG_FILE_PATH_SIZE_MAX];
+    struct dirent *entry;
+    DIR *dir;
+
+    dir = opendir(s_mediaCatalogDirPath);
+    if (dir == NULL) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
+    }
+
+    osalHandler->MutexLock(s_mediaCatalogMutex);
+    DjiTest_MediaCatalogClear();
+    while ((entry = readdir(dir)) != NULL) {
+        //names too long for the catalog are skipped by ReadFileInfo, only the path must not be cut here
+        if (snprintf(filePath, sizeof(filePath), "%s/%s", s_mediaCatalogDirPath, entry->d_name) >=
+            (int) sizeof(filePath)) {
+            continue;
+        }
+        if (DjiTest_MediaCatalogReadFileInfo(filePath, entry->d_name, &fileInfo) ==
+            DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+            DjiTest_MediaCatalogInsertItem(&fileInfo, false);
+        }
+    }
+    //sorting once is much cheaper than keeping the list sorted on every insert of a large directory
+    qsort(s_mediaCatalogSortedItems, s_mediaCatalogItemCount, sizeof(T_MediaCatalogItem *),
+          DjiTest_MediaCatalogCompareItem);
+    osalHandler->MutexUnlock(s_mediaCatalogMutex);
+
+    closedir(dir);
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+static T_DjiReturnCode DjiTest_MediaCatalogReadFileInfo(const char *filePath, const char *fileName,
+                                                        T_TestPayloadCameraMediaCatalogFileInfo *fileInfo)
+{
+    uint32_t fileNameLen = strlen(fileName);
+    struct stat fileStat;
+    int fd;
+
+    //hidden files are caches of the media files
+    if (fileName[0] == '.' || fileNameLen >= MEDIA_CATALOG_FILE_NAME_SIZE_MAX || fileNameLen < 4) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NONSUPPORT;
+    }
+
+    memset(fileInfo, 0, sizeof(T_TestPayloadCameraMediaCatalogFileInfo));
+    if (strcmp(&fileName[fileNameLen - 4], MEDIA_CATALOG_JPG_FILE_SUFFIX) == 0) {
+        fileInfo->type = DJI_CAMERA_FILE_TYPE_JPEG;
+    } else if (strcmp(&fileName[fileNameLen - 4], MEDIA_CATALOG_MP4_FILE_SUFFIX) == 0) {
+        fileInfo->type = DJI_CAMERA_FILE_TYPE_MP4;
+    } else {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NONSUPPORT;
+    }
+    memcpy(fileInfo->fileName, fileName, fileNameLen + 1);
+
+    fd = open(filePath, O_RDONLY);
+    if (fd < 0) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
+    }
+    if (fstat(fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode)) {
+        close(fd);
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
+    }
+
+    fileInfo->fileSize = fileStat.st_size > UINT32_MAX ? UINT32_MAX : (uint32_t) fileStat.st_size;
+    fileInfo->createTimeMs = (int64_t) fileStat.st_mtim.tv_sec * 1000 + fileStat.st_mtim.tv_nsec / 1000000;
+    fileInfo->mediaFileAttr.attrVideoFrameRate = DJI_CAMERA_VIDEO_FRAME_RATE_UNKNOWN;
+    fileInfo->mediaFileAttr.attrVideoResolution = DJI_CAMERA_VIDEO_RESOLUTION_UNKNOWN;
+
+    if (fileInfo->type == DJI_CAMERA_FILE_TYPE_JPEG) {
+        DjiTest_MediaCatalogReadJpgInfo(fd, fileInfo);
+    } else {
+        DjiTest_MediaCatalogReadMp4Info(fd, (uint64_t) fileStat.st_size, fileInfo);
+    }
+    close(fd);
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+// walk the segment headers to SOF, which costs a few small reads instead of reading the Exif segments
+static void DjiTest_MediaCatalogReadJpgInfo(int fd, T_TestPayloadCameraMediaCatalogFileInfo *fileInfo)
+{
+    uint8_t header[9];
+    off_t position = 2;
+    uint8_t marker;
+    uint32_t i;
+
+    if (pread(fd, header, 2, 0) != 2 || header[0] != MEDIA_CATALOG_JPG_MARKER_PREFIX ||
+        header[1] != MEDIA_CATALOG_JPG_MARKER_SOI) {
+        return;
+    }
+
+    for (i = 0; i < MEDIA_CATALOG_JPG_SEGMENT_NUM_MAX; i++) {
+        if (pread(fd, header, 4, position) != 4 || header[0] != MEDIA_CATALOG_JPG_MARKER_PREFIX) {
+            return;
+        }
+
+        marker = header[1];
+        if (marker == MEDIA_CATALOG_JPG_MARKER_PREFIX) {
+            //fill byte
+            position++;
+            continue;
+        }
+        if (marker == MEDIA_CATALOG_JPG_MARKER_SOS || marker == MEDIA_CATALOG_JPG_MARKER_EOI) {
+            return;
+        }
+        if (marker == MEDIA_CATALOG_JPG_MARKER_TEM ||
+            (marker >= MEDIA_CATALOG_JPG_MARKER_RST0 && marker < MEDIA_CATALOG_JPG_MARKER_SOI)) {
+            position += 2;
+            continue;
+        }
+
+        if (marker >= MEDIA_CATALOG_JPG_MARKER_SOF0 && marker <= MEDIA_CATALOG_JPG_MARKER_SOF15 &&
+            marker != MEDIA_CATALOG_JPG_MARKER_DHT && marker != MEDIA_CATALOG_JPG_MARKER_JPG &&
+            marker != MEDIA_CATALOG_JPG_MARKER_DAC) {
+            if (pread(fd, header, sizeof(header), position) == sizeof(header)) {
+                fileInfo->height = (uint16_t) ((header[5] << 8) | header[6]);
+                fileInfo->width = (uint16_t) ((header[7] << 8) | header[8]);
+            }
+            return;
+        }
+
+        position += 2 + ((header[2] << 8) | header[3]);
+    }
+}
+
+static void DjiTest_MediaCatalogReadMp4Info(int fd, uint64_t fileSize,
+                                            T_TestPayloadCameraMediaCatalogFileInfo *fileInfo)
+{
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+    uint8_t header[16];
+    uint64_t position = 0;
+    uint64_t boxSize;
+    uint32_t headerSize;
+    uint8_t *moov;
+
+    //moov is a top level box, before or after mdat
+    while (position + MEDIA_CATALOG_MP4_BOX_HEADER_SIZE <= fileSize) {
+        if (pread(fd, header, sizeof(header), (off_t) position) < MEDIA_CATALOG_MP4_BOX_HEADER_SIZE) {
+            return;
+        }
+
+        boxSize = DjiTest_MediaCatalogReadU32(header);
+        headerSize = MEDIA_CATALOG_MP4_BOX_HEADER_SIZE;
+        if (boxSize == 1) {
+            boxSize = DjiTest_MediaCatalogReadU64(&header[8]);
+            headerSize = sizeof(header);
+        } else if (boxSize == 0) {
+            boxSize = fileSize - position;
+        }
+        if (boxSize < headerSize || boxSize > fileSize - position) {
+            return;
+        }
+
+        if (DjiTest_MediaCatalogReadU32(&header[4]) == MEDIA_CATALOG_MP4_BOX_MOOV) {
+            if (boxSize - headerSize > MEDIA_CATALOG_MP4_MOOV_SIZE_MAX) {
+                USER_LOG_WARN("moov of %s is too large.", fileInfo->fileName);
+                return;
+            }
+            moov = osalHandler->Malloc((uint32_t) (boxSize - headerSize));
+            if (moov == NULL) {
+                return;
+            }
+            if (pread(fd, moov, boxSize - headerSize, (off_t) (position + headerSize)) ==
+                (ssize_t) (boxSize - headerSize)) {
+                DjiTest_MediaCatalogParseMp4Moov(moov, (uint32_t) (boxSize - headerSize), fileInfo);
+            }
+            osalHandler->Free(moov);
+            return;
+        }
+
+        position += boxSize;
+    }
+}
+
+static void DjiTest_MediaCatalogParseMp4Moov(const uint8_t *moov, uint32_t moovSize,
+                                             T_TestPayloadCameraMediaCatalogFileInfo *fileInfo)
+{
+    const uint8_t *box, *trak, *mdia, *minf, *stbl, *tkhd = NULL, *mdhd = NULL, *stts = NULL;
+    uint32_t boxSize, trakSize, mdiaSize, minfSize, stblSize, tkhdSize = 0, mdhdSize = 0, sttsSize = 0;
+    uint32_t position = 0, trakPosition = 0, childPosition;
+    uint64_t duration, sampleNum = 0;
+    uint32_t timescale, entryNum, fps, i;
+
+    //mvhd, version 1 has 64 bit times
+    if (DjiTest_MediaCatalogFindMp4Box(moov, moovSize, &position, MEDIA_CATALOG_MP4_BOX_MVHD, &box, &boxSize)) {
+        if (box[0] == 1 && boxSize >= 32) {
+            timescale = DjiTest_MediaCatalogReadU32(&box[20]);
+            duration = DjiTest_MediaCatalogReadU64(&box[24]);
+        } else if (boxSize >= 20) {
+            timescale = DjiTest_MediaCatalogReadU32(&box[12]);
+            duration = DjiTest_MediaCatalogReadU32(&box[16]);
+        } else {
+            timescale = 0;
+            duration = 0;
+        }
+        if (timescale != 0) {
+            fileInfo->durationMs = (uint32_t) (duration * 1000 / timescale);
+            fileInfo->mediaFileAttr.attrVideoDuration = (uint16_t) ((fileInfo->durationMs + 500) / 1000);
+        }
+    }
+
+    //first video track
+    while (DjiTest_MediaCatalogFindMp4Box(moov, moovSize, &trakPosition, MEDIA_CATALOG_MP4_BOX_TRAK, &trak,
+                                          &trakSize)) {
+        childPosition = 0;
+        if (!DjiTest_MediaCatalogFindMp4Box(trak, trakSize, &childPosition, MEDIA_CATALOG_MP4_BOX_MDIA, &mdia,
+                                            &mdiaSize)) {
+            continue;
+        }
+        childPosition = 0;
+        if (!DjiTest_MediaCatalogFindMp4Box(mdia, mdiaSize, &childPosition, MEDIA_CATALOG_MP4_BOX_HDLR, &box,
+                                            &boxSize) || boxSize < 12 ||
+            DjiTest_MediaCatalogReadU32(&box[8]) != MEDIA_CATALOG_MP4_HANDLER_VIDE) {
+            continue;
+        }
+
+        childPosition = 0;
+        DjiTest_MediaCatalogFindMp4Box(trak, trakSize, &childPosition, MEDIA_CATALOG_MP4_BOX_TKHD, &tkhd, &tkhdSize);
+        childPosition = 0;
+        DjiTest_MediaCatalogFindMp4Box(mdia, mdiaSize, &childPosition, MEDIA_CATALOG_MP4_BOX_MDHD, &mdhd, &mdhdSize);
+        childPosition = 0;
+        if (DjiTest_MediaCatalogFindMp4Box(mdia, mdiaSize, &childPosition, MEDIA_CATALOG_MP4_BOX_MINF, &minf,
+                                           &minfSize)) {
+            childPosition = 0;
+            if (DjiTest_MediaCatalogFindMp4Box(minf, minfSize, &childPosition, MEDIA_CATALOG_MP4_BOX_STBL, &stbl,
+                                               &stblSize)) {
+                childPosition = 0;
+                DjiTest_MediaCatalogFindMp4Box(stbl, stblSize, &childPosition, MEDIA_CATALOG_MP4_BOX_STTS, &stts,
+                                               &sttsSize);
+            }
+        }
+        break;
+    }
+
+    //width and height are 16.16 fixed point at the end of tkhd
+    if (tkhd != NULL && tkhdSize >= (tkhd[0] == 1 ? 96 : 84)) {
+        box = tkhd[0] == 1 ? &tkhd[88] : &tkhd[76];
+        fileInfo->width = (uint16_t) (DjiTest_MediaCatalogReadU32(box) >> 16);
+        fileInfo->height = (uint16_t) (DjiTest_MediaCatalogReadU32(&box[4]) >> 16);
+        for (i = 0; i < sizeof(s_mediaCatalogResolution) / sizeof(s_mediaCatalogResolution[0]); i++) {
+            if (s_mediaCatalogResolution[i].width == fileInfo->width &&
+                s_mediaCatalogResolution[i].height == fileInfo->height) {
+                fileInfo->mediaFileAttr.attrVideoResolution = s_mediaCatalogResolution[i].resolution;
+                break;
+            }
+        }
+    }
+
+    //frame rate is sample count over media duration, 29.97 fps is 30 fps
+    if (mdhd == NULL || stts == NULL || sttsSize < 8) {
+        return;
+    }
+    if (mdhd[0] == 1 && mdhdSize >= 32) {
+        timescale = DjiTest_MediaCatalogReadU32(&mdhd[20]);
+        duration = DjiTest_MediaCatalogReadU64(&mdhd[24]);
+    } else if (mdhdSize >= 20) {
+        timescale = DjiTest_MediaCatalogReadU32(&mdhd[12]);
+        duration = DjiTest_MediaCatalogReadU32(&mdhd[16]);
+    } else {
+        return;
+    }
+    entryNum = DjiTest_MediaCatalogReadU32(&stts[4]);
+    for (i = 0; i < entryNum && i < (sttsSize - 8) / 8; i++) {
+        sampleNum += DjiTest_MediaCatalogReadU32(&stts[8 + i * 8]);
+    }
+    if (duration == 0 || timescale == 0) {
+        return;
+    }
+
+    fps = (uint32_t) ((sampleNum * timescale + duration / 2) / duration);
+    if (fps == 24) {
+        fileInfo->mediaFileAttr.attrVideoFrameRate = DJI_CAMERA_VIDEO_FRAME_RATE_24_FPS;
+    } else if (fps == 25) {
+        fileInfo->mediaFileAttr.attrVideoFrameRate = DJI_CAMERA_VIDEO_FRAME_RATE_25_FPS;
+    } else if (fps == 30) {
+        fileInfo->mediaFileAttr.attrVideoFrameRate = DJI_CAMERA_VIDEO_FRAME_RATE_30_FPS;
+    }
+}
+
+// next box of type from *position in a box payload, box points to its payload
+static bool DjiTest_MediaCatalogFindMp4Box(const uint8_t *data, uint32_t size, uint32_t *position, uint32_t type,
+                                           const uint8_t **box, uint32_t *boxSize)
+{
+    uint32_t thisBoxSize;
+
+    while (size >= MEDIA_CATALOG_MP4_BOX_HEADER_SIZE && *position <= size - MEDIA_CATALOG_MP4_BOX_HEADER_SIZE) {
+        thisBoxSize = DjiTest_MediaCatalogReadU32(&data[*position]);
+        if (thisBoxSize < MEDIA_CATALOG_MP4_BOX_HEADER_SIZE || thisBoxSize > size - *position) {
+            return false;
+        }
+
+        *position += thisBoxSize;
+        if (DjiTest_MediaCatalogReadU32(&data[*position - thisBoxSize + 4]) == type) {
+            *box = &data[*position - thisBoxSize + MEDIA_CATALOG_MP4_BOX_HEADER_SIZE];
+            *boxSize = thisBoxSize - MEDIA_CATALOG_MP4_BOX_HEADER_SIZE;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static uint32_t DjiTest_MediaCatalogReadU32(const uint8_t *data)
+{
+    return ((uint32_t) data[0] << 24) | ((uint32_t) data[1] << 16) | ((uint32_t) data[2] << 8) | data[3];
+}
+
+static uint64_t DjiTest_MediaCatalogReadU64(const uint8_t *data)
+{
+    return ((uint64_t) DjiTest_MediaCatalogReadU32(data) << 32) | DjiTest_MediaCatalogReadU32(&data[4]);
+}
+
+static T_MediaCatalogItem *DjiTest_MediaCatalogFindItem(const char *fileName, uint32_t nameHash)
+{
+    T_MediaCatalogItem *item;
+
+    for (item = s_mediaCatalogHashTable[nameHash % MEDIA_CATALOG_HASH_BUCKET_NUM]; item != NULL;
+         item = item->hashNext) {
+        if (item->nameHash == nameHash && strcmp(item->fileInfo.fileName, fileName) == 0) {
+            return item;
+        }
+    }
+
+    return NULL;
+}
+
+static T_DjiReturnCode DjiTest_MediaCatalogInsertItem(const T_TestPayloadCameraMediaCatalogFileInfo *fileInfo,
+                                                      bool isKeepSorted)
+{
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+    uint32_t nameHash = DjiTest_MediaCatalogGetNameHash(fileInfo->fileName);
+    T_MediaCatalogItem **sortedItems;
+    T_MediaCatalogItem *item;
+    uint32_t capacity;
+    uint32_t position;
+
+    //a rewritten file may move in the sorted list
+    item = DjiTest_MediaCatalogFindItem(fileInfo->fileName, nameHash);
+    if (item != NULL) {
+        DjiTest_MediaCatalogRemoveItem(item);
+    }
+
+    if (s_mediaCatalogItemCount == s_mediaCatalogItemCapacity) {
+        capacity = s_mediaCatalogItemCapacity == 0 ? MEDIA_CATALOG_CAPACITY_MIN : s_mediaCatalogItemCapacity * 2;
+        sortedItems = osalHandler->Malloc(capacity * sizeof(T_MediaCatalogItem *));
+        if (sortedItems == NULL) {
+            return DJI_ERROR_SYSTEM_MODULE_CODE_MEMORY_ALLOC_FAILED;
+        }
+        if (s_mediaCatalogSortedItems != NULL) {
+            memcpy(sortedItems, s_mediaCatalogSortedItems, s_mediaCatalogItemCount * sizeof(T_MediaCatalogItem *));
+            osalHandler->Free(s_mediaCatalogSortedItems);
+        }
+        s_mediaCatalogSortedItems = sortedItems;
+        s_mediaCatalogItemCapacity = capacity;
+    }
+
+    item = osalHandler->Malloc(sizeof(T_MediaCatalogItem));
+    if (item == NULL) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_MEMORY_ALLOC_FAILED;
+    }
+    item->fileInfo = *fileInfo;
+    item->nameHash = nameHash;
+    item->hashNext = s_mediaCatalogHashTable[nameHash % MEDIA_CATALOG_HASH_BUCKET_NUM];
+    s_mediaCatalogHashTable[nameHash % MEDIA_CATALOG_HASH_BUCKET_NUM] = item;
+
+    //a new file is usually the newest one, which is the cheapest to insert
+    position = isKeepSorted ? DjiTest_MediaCatalogFindSortedPosition(fileInfo) : s_mediaCatalogItemCount;
+    memmove(&s_mediaCatalogSortedItems[position + 1], &s_mediaCatalogSortedItems[position],
+            (s_mediaCatalogItemCount - position) * sizeof(T_MediaCatalogItem *));
+    s_mediaCatalogSortedItems[position] = item;
+    s_mediaCatalogItemCount++;
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+static void DjiTest_MediaCatalogRemoveItem(T_MediaCatalogItem *item)
+{
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+    T_MediaCatalogItem **link = &s_mediaCatalogHashTable[item->nameHash % MEDIA_CATALOG_HASH_BUCKET_NUM];
+    uint32_t position;
+
+    while (*link != item) {
+        link = &(*link)->hashNext;
+    }
+    *link = item->hashNext;
+
+    position = DjiTest_MediaCatalogFindSortedPosition(&item->fileInfo);
+    memmove(&s_mediaCatalogSortedItems[position], &s_mediaCatalogSortedItems[position + 1],
+            (s_mediaCatalogItemCount - position - 1) * sizeof(T_MediaCatalogItem *));
+    s_mediaCatalogItemCount--;
+
+    osalHandler->Free(item);
+}
+
+static void DjiTest_MediaCatalogClear(void)
+{
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+    uint32_t i;
+
+    for (i = 0; i < s_mediaCatalogItemCount; i++) {
+        osalHandler->Free(s_mediaCatalogSortedItems[i]);
+    }
+    s_mediaCatalogItemCount = 0;
+    memset(s_mediaCatalogHashTable, 0, sizeof(s_mediaCatalogHashTable));
+}
+
+// first position whose item is not less than fileInfo
+static uint32_t DjiTest_MediaCatalogFindSortedPosition(const T_TestPayloadCameraMediaCatalogFileInfo *fileInfo)
+{
+    uint32_t low = 0;
+    uint32_t high = s_mediaCatalogItemCount;
+    uint32_t middle;
+
+    while (low < high) {
+        middle = low + (high - low) / 2;
+        if (DjiTest_MediaCatalogCompare(&s_mediaCatalogSortedItems[middle]->fileInfo, fileInfo) < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+static int DjiTest_MediaCatalogCompare(const T_TestPayloadCameraMediaCatalogFileInfo *a,
+                                       const T_TestPayloadCameraMediaCatalogFileInfo *b)
+{
+    if (a->createTimeMs != b->createTimeMs) {
+        return a->createTimeMs < b->createTimeMs ? -1 : 1;
+    }
+
+    return strcmp(a->fileName, b->fileName);
+}
+
+static int DjiTest_MediaCatalogCompareItem(const void *a, const void *b)
+{
+    return DjiTest_MediaCatalogCompare(&(*(T_MediaCatalogItem *const *) a)->fileInfo,
+                                       &(*(T_MediaCatalogItem *const *) b)->fileInfo);
+}
+
+// inotify fd is not blocking, pending events are applied before a query, so no task is needed to follow the directory
+static void DjiTest_MediaCatalogProcessEvents(void)
+{
+#ifdef SYSTEM_ARCH_LINUX
+    uint8_t buffer[MEDIA_CATALOG_INOTIFY_BUFFER_SIZE] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+    char filePath[MEDIA_CATALOG_FILE_PATH_SIZE_MAX];
+    const struct inotify_event *event;
+    bool isRescanNeeded = false;
+    ssize_t readLen;
+    ssize_t i;
+
+    if (s_mediaCatalogInotifyFd < 0) {
+        return;
+    }
+
+    while ((readLen = read(s_mediaCatalogInotifyFd, buffer, sizeof(buffer))) > 0) {
+        for (i = 0; i < readLen; i += sizeof(struct inotify_event) + event->len) {
+            event = (const struct inotify_event *) &buffer[i];
+            if (event->mask & IN_Q_OVERFLOW) {
+                isRescanNeeded = true;
+                continue;
+            }
+            if (event->len == 0) {
+                continue;
+            }
+
+            snprintf(filePath, sizeof(filePath), "%s/%s", s_mediaCatalogDirPath, event->name);
+            if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+                DjiTest_MediaCatalogAddFile(filePath);
+            } else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                DjiTest_MediaCatalogRemoveFile(filePath);
+            }
+        }
+    }
+
+    //events are lost, catalog is rebuilt from the directory
+    if (isRescanNeeded) {
+        USER_LOG_WARN("media directory events overflow, scan %s again.", s_mediaCatalogDirPath);
+        DjiTest_MediaCatalogScanDir();
+    }
+#endif
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
@@ -0,0 +1,71 @@
+/**
+ ********************************************************************
+ * @file    test_payload_cam_emu_media_catalog.h
+ * @brief   This is the header file for "test_payload_cam_emu_media_catalog.c", defining the structure and
+ * (exported) function prototypes.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef TEST_PAYLOAD_CAM_EMU_MEDIA_CATALOG_H
+#define TEST_PAYLOAD_CAM_EMU_MEDIA_CATALOG_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "dji_typedef.h"
+#include "dji_payload_camera.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Exported constants --------------------------------------------------------*/
+#define MEDIA_CATALOG_FILE_NAME_SIZE_MAX    64
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct {
+    char fileName[MEDIA_CATALOG_FILE_NAME_SIZE_MAX];
+    E_DjiCameraMediaFileType type;
+    uint32_t fileSize;
+    T_DjiCameraMediaFileAttr mediaFileAttr;
+    // pixels of the photo or the video, 0 when the file does not tell
+    uint16_t width;
+    uint16_t height;
+    uint32_t durationMs;
+    // modify time of the file, which a camera writes once
+    int64_t createTimeMs;
+} T_TestPayloadCameraMediaCatalogFileInfo;
+
+/* Exported functions --------------------------------------------------------*/
+T_DjiReturnCode DjiTest_MediaCatalogInit(const char *dirPath);
+T_DjiReturnCode DjiTest_MediaCatalogDeInit(void);
+T_DjiReturnCode DjiTest_MediaCatalogAddFile(const char *filePath);
+T_DjiReturnCode DjiTest_MediaCatalogRemoveFile(const char *filePath);
+T_DjiReturnCode DjiTest_MediaCatalogGetFileInfo(const char *filePath,
+                                                T_TestPayloadCameraMediaCatalogFileInfo *fileInfo);
+T_DjiReturnCode DjiTest_MediaCatalogQuery(uint32_t offset, uint32_t count, bool isNewestFirst,
+                                          T_TestPayloadCameraMediaCatalogFileInfo *fileInfo, uint32_t *fileCount,
+                                          uint32_t *totalFileCount);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TEST_PAYLOAD_CAM_EMU_MEDIA_CATALOG_H
+/************************ (C) COPYRIGHT DJI Innovations *******END OF FILE******/
@@ -0,0 +1,232 @@
+/**
+ ********************************************************************
+ * @file    test_payload_cam_emu_video_source.c
+ * @brief   Video frame source of the camera emulator send task. Frames are sent straight from a memory map of
+ *          the video file, with the access unit delimiter sent from a constant after the frame, so that sending
+ *          a frame needs no heap allocation and no copy.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "dji_logger.h"
+#include "dji_platform.h"
+#include "utils/util_misc.h"
+#include "test_payload_cam_emu_video_source.h"
+
+/* Private constants ---------------------------------------------------------*/
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private functions declaration ---------------------------------------------*/
+static T_DjiReturnCode DjiTest_VideoSourceSendData(const uint8_t *data, uint32_t len, uint16_t sendLenMax,
+                                                   DjiTest_VideoSourceSendFunc sendFunc);
+
+/* Private variables -------------------------------------------------------------*/
+static const uint8_t s_videoSourceAud[VIDEO_SOURCE_AUD_LEN] = {0x00, 0x00, 0x00, 0x01, 0x09, 0x10};
+
+/* Exported functions definition ---------------------------------------------*/
+/**
+ * @brief Open video file as frame source, map it into memory.
+ * @note When the file can not be mapped, a read buffer of the largest frame in frameInfo is allocated here once,
+ * and every frame is read into it with a single pread.
+ * @param source: source to open.
+ * @param path: path of the video file.
+ * @param frameInfo: frame table of the file.
+ * @param frameCount: frame count of frameInfo.
+ * @return Execution result.
+ */
+T_DjiReturnCode DjiTest_VideoSourceOpen(T_TestPayloadCameraVideoSource *source, const char *path,
+                                        const T_TestPayloadCameraVideoFrameInfo *frameInfo, uint32_t frameCount)
+{
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+    struct stat fileStat;
+    void *mapData;
+    uint32_t i;
+
+    memset(source, 0, sizeof(T_TestPayloadCameraVideoSource));
+    source->fd = open(path, O_RDONLY);
+    if (source->fd < 0) {
+        USER_LOG_ERROR("open video file %s fail.", path);
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
+    }
+
+    if (fstat(source->fd, &fileStat) != 0 || fileStat.st_size <= 0 || fileStat.st_size > UINT32_MAX) {
+        USER_LOG_ERROR("get size of video file %s fail.", path);
+        DjiTest_VideoSourceClose(source);
+        return DJI_ERROR_SYSTEM_MODULE_CODE_SYSTEM_ERROR;
+    }
+    source->fileSize = (uint32_t) fileStat.st_size;
+
+    for (i = 0; i < frameCount; i++) {
+        if (frameInfo[i].positionInFile > source->fileSize ||
+            frameInfo[i].size > source->fileSize - frameInfo[i].positionInFile) {
+            USER_LOG_ERROR("frame %d is out of video file.", i);
+            DjiTest_VideoSourceClose(source);
+            return DJI_ERROR_SYSTEM_MODULE_CODE_OUT_OF_RANGE;
+        }
+    }
+
+    mapData = mmap(NULL, source->fileSize, PROT_READ, MAP_PRIVATE, source->fd, 0);
+    if (mapData != MAP_FAILED) {
+        // frames are read in file order
+        madvise(mapData, source->fileSize, MADV_SEQUENTIAL);
+        source->mapData = mapData;
+        return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+    }
+
+    USER_LOG_WARN("map video file fail, read frames into buffer.");
+    for (i = 0; i < frameCount; i++) {
+        source->readBufferSize = USER_UTIL_MAX(source->readBufferSize, frameInfo[i].size);
+    }
+    source->readBuffer = osalHandler->Malloc(USER_UTIL_MAX(source->readBufferSize, 1));
+    if (source->readBuffer == NULL) {
+        USER_LOG_ERROR("malloc memory for video read buffer fail.");
+        DjiTest_VideoSourceClose(source);
+        return DJI_ERROR_SYSTEM_MODULE_CODE_MEMORY_ALLOC_FAILED;
+    }
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+/**
+ * @brief Send a frame in pieces of at most sendLenMax bytes, and the access unit delimiter after it if needed.
+ * @note The delimiter goes in the last send together with the end of the frame, which is copied into a tail buffer
+ * of sendLenMax bytes allocated on first use, so a frame takes as many sends as with the delimiter appended to it.
+ * @param source: opened source.
+ * @param frame: frame to send, from the frame table source is opened with.
+ * @param isAppendAud: whether to send access unit delimiter after the frame, for DJI H264 format.
+ * @param sendLenMax: max length of a send.
+ * @param sendFunc: send function, DjiPayloadCamera_SendVideoStream.
+ * @return Execution result.
+ */
+T_DjiReturnCode DjiTest_VideoSourceSendFrame(T_TestPayloadCameraVideoSource *source,
+                                             const T_TestPayloadCameraVideoFrameInfo *frame, bool isAppendAud,
+                                             uint16_t sendLenMax, DjiTest_VideoSourceSendFunc sendFunc)
+{
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+    T_DjiReturnCode returnCode;
+    const uint8_t *frameData;
+    ssize_t readLen;
+    uint16_t tailBufferSize;
+    uint32_t lastSendLen;
+    uint32_t tailLen;
+
+    if (sendLenMax == 0) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    if (source->mapData != NULL) {
+        frameData = source->mapData + frame->positionInFile;
+    } else if (frame->size <= source->readBufferSize) {
+        readLen = pread(source->fd, source->readBuffer, frame->size, frame->positionInFile);
+        if (readLen != (ssize_t) frame->size) {
+            USER_LOG_ERROR("read data from video file error.");
+            return DJI_ERROR_SYSTEM_MODULE_CODE_SYSTEM_ERROR;
+        }
+        frameData = source->readBuffer;
+    } else {
+        USER_LOG_ERROR("frame size %d is larger than read buffer.", frame->size);
+        return DJI_ERROR_SYSTEM_MODULE_CODE_OUT_OF_RANGE;
+    }
+
+    if (!isAppendAud) {
+        return DjiTest_VideoSourceSendData(frameData, frame->size, sendLenMax, sendFunc);
+    }
+
+    tailBufferSize = USER_UTIL_MAX(sendLenMax, VIDEO_SOURCE_AUD_LEN);
+    if (source->tailBufferSize < tailBufferSize) {
+        if (source->tailBuffer != NULL) {
+            osalHandler->Free(source->tailBuffer);
+        }
+        source->tailBufferSize = 0;
+        source->tailBuffer = osalHandler->Malloc(tailBufferSize);
+        if (source->tailBuffer == NULL) {
+            USER_LOG_ERROR("malloc memory for video tail buffer fail.");
+            return DJI_ERROR_SYSTEM_MODULE_CODE_MEMORY_ALLOC_FAILED;
+        }
+        source->tailBufferSize = tailBufferSize;
+    }
+
+    // frame bytes that would share the last send with the delimiter are sent with it from tail buffer
+    lastSendLen = (frame->size + VIDEO_SOURCE_AUD_LEN) % sendLenMax;
+    if (lastSendLen == 0) {
+        lastSendLen = sendLenMax;
+    }
+    tailLen = lastSendLen > VIDEO_SOURCE_AUD_LEN ? lastSendLen - VIDEO_SOURCE_AUD_LEN : 0;
+
+    returnCode = DjiTest_VideoSourceSendData(frameData, frame->size - tailLen, sendLenMax, sendFunc);
+    if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        return returnCode;
+    }
+
+    memcpy(source->tailBuffer, frameData + frame->size - tailLen, tailLen);
+    memcpy(source->tailBuffer + tailLen, s_videoSourceAud, VIDEO_SOURCE_AUD_LEN);
+
+    return DjiTest_VideoSourceSendData(source->tailBuffer, tailLen + VIDEO_SOURCE_AUD_LEN, sendLenMax, sendFunc);
+}
+
+void DjiTest_VideoSourceClose(T_TestPayloadCameraVideoSource *source)
+{
+    T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
+
+    if (source->mapData != NULL) {
+        munmap((void *) source->mapData, source->fileSize);
+    }
+    if (source->readBuffer != NULL) {
+        osalHandler->Free(source->readBuffer);
+    }
+    if (source->tailBuffer != NULL) {
+        osalHandler->Free(source->tailBuffer);
+    }
+    if (source->fd >= 0) {
+        close(source->fd);
+    }
+
+    memset(source, 0, sizeof(T_TestPayloadCameraVideoSource));
+    source->fd = -1;
+}
+
+/* Private functions definition-----------------------------------------------*/
+static T_DjiReturnCode DjiTest_VideoSourceSendData(const uint8_t *data, uint32_t len, uint16_t sendLenMax,
+                                                   DjiTest_VideoSourceSendFunc sendFunc)
+{
+    T_DjiReturnCode returnCode;
+    uint32_t lengthOfDataHaveBeenSent = 0;
+    uint16_t lengthOfDataToBeSent;
+
+    while (len - lengthOfDataHaveBeenSent) {
+        lengthOfDataToBeSent = USER_UTIL_MIN(sendLenMax, len - lengthOfDataHaveBeenSent);
+        returnCode = sendFunc(data + lengthOfDataHaveBeenSent, lengthOfDataToBeSent);
+        if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+            USER_LOG_ERROR("send video stream error: 0x%08llX.", returnCode);
+            return returnCode;
+        }
+        lengthOfDataHaveBeenSent += lengthOfDataToBeSent;
+    }
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
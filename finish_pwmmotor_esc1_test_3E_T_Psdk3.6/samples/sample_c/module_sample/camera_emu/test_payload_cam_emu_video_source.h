@@ -0,0 +1,67 @@
+/**
+ ********************************************************************
+ * @file    test_payload_cam_emu_video_source.h
+ * @brief   This is the header file for "test_payload_cam_emu_video_source.c", defining the structure and
+ * (exported) function prototypes.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef TEST_PAYLOAD_CAM_EMU_VIDEO_SOURCE_H
+#define TEST_PAYLOAD_CAM_EMU_VIDEO_SOURCE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "dji_typedef.h"
+#include "test_payload_cam_emu_frame_index.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Exported constants --------------------------------------------------------*/
+#define VIDEO_SOURCE_AUD_LEN                 6
+
+/* Exported types ------------------------------------------------------------*/
+typedef T_DjiReturnCode (*DjiTest_VideoSourceSendFunc)(const uint8_t *data, uint16_t len);
+
+typedef struct {
+    int fd;
+    const uint8_t *mapData;
+    uint32_t fileSize;
+    uint8_t *readBuffer;
+    uint32_t readBufferSize;
+    uint8_t *tailBuffer;
+    uint16_t tailBufferSize;
+} T_TestPayloadCameraVideoSource;
+
+/* Exported functions --------------------------------------------------------*/
+T_DjiReturnCode DjiTest_VideoSourceOpen(T_TestPayloadCameraVideoSource *source, const char *path,
+                                        const T_TestPayloadCameraVideoFrameInfo *frameInfo, uint32_t frameCount);
+T_DjiReturnCode DjiTest_VideoSourceSendFrame(T_TestPayloadCameraVideoSource *source,
+                                             const T_TestPayloadCameraVideoFrameInfo *frame, bool isAppendAud,
+                                             uint16_t sendLenMax, DjiTest_VideoSourceSendFunc sendFunc);
+void DjiTest_VideoSourceClose(T_TestPayloadCameraVideoSource *source);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TEST_PAYLOAD_CAM_EMU_VIDEO_SOURCE_H
+/************************ (C) COPYRIGHT DJI Innovations *******END OF FILE******/
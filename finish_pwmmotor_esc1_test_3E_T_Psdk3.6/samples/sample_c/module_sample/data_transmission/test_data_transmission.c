@@ -36,6 +36,7 @@
 /* Private constants ---------------------------------------------------------*/
 #define DATA_TRANSMISSION_TASK_FREQ         (1)
 #define DATA_TRANSMISSION_TASK_STACK_SIZE   (2048)
+#define DATA_TRANSMISSION_SEND_DATA_MAX_LEN (128)
 
 /* Private types -------------------------------------------------------------*/
 
@@ -49,6 +50,7 @@ static T_DjiReturnCode ReceiveDataFromPayload(const uint8_t *data, uint16_t len)
 /* Private variables ---------------------------------------------------------*/
 static T_DjiTaskHandle s_userDataTransmissionThread;
 static T_DjiAircraftInfoBaseInfo s_aircraftInfoBaseInfo;
+static DjiTestDataTransmissionGetSendDataCallback s_getSendDataCallback = NULL;
 
 /* Exported functions definition ---------------------------------------------*/
 T_DjiReturnCode DjiTest_DataTransmissionStartService(void)
@@ -134,6 +136,19 @@ T_DjiReturnCode DjiTest_DataTransmissionStartService(void)
     return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
 }
 
+/**
+ * @brief Register callback providing data sent to mobile and other channels, instead of fixed test data.
+ * @note Callback runs in data transmission task once per send turn.
+ * @param callback: callback function, NULL to send test data.
+ * @return Execution result.
+ */
+T_DjiReturnCode DjiTest_DataTransmissionRegGetSendDataCallback(DjiTestDataTransmissionGetSendDataCallback callback)
+{
+    s_getSendDataCallback = callback;
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
 T_DjiReturnCode DjiTest_DataTransmissionStopService(void)
 {
     T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
@@ -163,7 +178,11 @@ T_DjiReturnCode DjiTest_DataTransmissionStopService(void)
 static void *UserDataTransmission_Task(void *arg)
 {
     T_DjiReturnCode djiStat;
-    const uint8_t dataToBeSent[] = "DJI Data Transmission Test Data.";
+    const uint8_t testData[] = "DJI Data Transmission Test Data.";
+    uint8_t userData[DATA_TRANSMISSION_SEND_DATA_MAX_LEN];
+    const uint8_t *dataToBeSent;
+    uint16_t dataLen;
+    DjiTestDataTransmissionGetSendDataCallback getSendDataCallback;
     T_DjiDataChannelState state = {0};
     T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
     E_DjiChannelAddress channelAddress;
@@ -173,8 +192,17 @@ static void *UserDataTransmission_Task(void *arg)
     while (1) {
         osalHandler->TaskSleepMs(1000 / DATA_TRANSMISSION_TASK_FREQ);
 
+        getSendDataCallback = s_getSendDataCallback;
+        if (getSendDataCallback != NULL) {
+            dataToBeSent = userData;
+            dataLen = getSendDataCallback(userData, sizeof(userData));
+        } else {
+            dataToBeSent = testData;
+            dataLen = sizeof(testData);
+        }
+
         channelAddress = DJI_CHANNEL_ADDRESS_MASTER_RC_APP;
-        djiStat = DjiLowSpeedDataChannel_SendData(channelAddress, dataToBeSent, sizeof(dataToBeSent));
+        djiStat = DjiLowSpeedDataChannel_SendData(channelAddress, dataToBeSent, dataLen);
         if (djiStat != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS)
             USER_LOG_ERROR("send data to mobile error.");
 
@@ -191,7 +219,7 @@ static void *UserDataTransmission_Task(void *arg)
         if (s_aircraftInfoBaseInfo.aircraftType == DJI_AIRCRAFT_TYPE_M30 ||
             s_aircraftInfoBaseInfo.aircraftType == DJI_AIRCRAFT_TYPE_M30T) {
             channelAddress = DJI_CHANNEL_ADDRESS_CLOUD_API;
-            djiStat = DjiLowSpeedDataChannel_SendData(channelAddress, dataToBeSent, sizeof(dataToBeSent));
+            djiStat = DjiLowSpeedDataChannel_SendData(channelAddress, dataToBeSent, dataLen);
             if (djiStat != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS)
                 USER_LOG_ERROR("send data to cloud error.");
 
@@ -210,7 +238,7 @@ static void *UserDataTransmission_Task(void *arg)
             s_aircraftInfoBaseInfo.mountPosition == DJI_MOUNT_POSITION_PAYLOAD_PORT_NO2 ||
             s_aircraftInfoBaseInfo.mountPosition == DJI_MOUNT_POSITION_PAYLOAD_PORT_NO3) {
             channelAddress = DJI_CHANNEL_ADDRESS_EXTENSION_PORT;
-            djiStat = DjiLowSpeedDataChannel_SendData(channelAddress, dataToBeSent, sizeof(dataToBeSent));
+            djiStat = DjiLowSpeedDataChannel_SendData(channelAddress, dataToBeSent, dataLen);
             if (djiStat != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS)
                 USER_LOG_ERROR("send data to extension port error.");
 
@@ -226,7 +254,7 @@ static void *UserDataTransmission_Task(void *arg)
 
             if (DjiPlatform_GetSocketHandler() != NULL) {
 #ifdef SYSTEM_ARCH_LINUX
-                djiStat = DjiHighSpeedDataChannel_SendDataStreamData(dataToBeSent, sizeof(dataToBeSent));
+                djiStat = DjiHighSpeedDataChannel_SendDataStreamData(dataToBeSent, dataLen);
                 if (djiStat != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS)
                     USER_LOG_ERROR("send data to data stream error.");
 
@@ -242,7 +270,7 @@ static void *UserDataTransmission_Task(void *arg)
             }
         } else if (s_aircraftInfoBaseInfo.mountPosition == DJI_MOUNT_POSITION_EXTENSION_PORT) {
             channelAddress = DJI_CHANNEL_ADDRESS_PAYLOAD_PORT_NO1;
-            djiStat = DjiLowSpeedDataChannel_SendData(channelAddress, dataToBeSent, sizeof(dataToBeSent));
+            djiStat = DjiLowSpeedDataChannel_SendData(channelAddress, dataToBeSent, dataLen);
             if (djiStat != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS)
                 USER_LOG_ERROR("send data to extension port error.");
 
@@ -38,10 +38,12 @@ extern "C" {
 
 
 /* Exported types ------------------------------------------------------------*/
+typedef uint16_t (*DjiTestDataTransmissionGetSendDataCallback)(uint8_t *buffer, uint16_t bufferLen);
 
 /* Exported functions --------------------------------------------------------*/
 T_DjiReturnCode DjiTest_DataTransmissionStartService(void);
 T_DjiReturnCode DjiTest_DataTransmissionStopService(void);
+T_DjiReturnCode DjiTest_DataTransmissionRegGetSendDataCallback(DjiTestDataTransmissionGetSendDataCallback callback);
 
 #ifdef __cplusplus
 }
@@ -125,3 +125,75 @@ uint16_t UtilBuffer_GetUnusedSize(T_UtilBuffer *pthis)
 {
     return (uint16_t) (pthis->bufferSize - pthis->writeIndex + pthis->readIndex);
 }
+
+/**
+ * @brief Expose data stored in buffer without copying it out, data is released by UtilBuffer_Consume().
+ * @param pthis Pointer to buffer structure.
+ * @param spans Two spans filled with stored data in order, second span is empty if data does not wrap.
+ * @return Total length of data exposed by spans.
+ */
+uint16_t UtilBuffer_PeekSpans(T_UtilBuffer *pthis, T_UtilBufferSpan spans[2])
+{
+    uint16_t dataLen;
+    uint16_t readOffset;
+
+    dataLen = (uint16_t) (pthis->writeIndex - pthis->readIndex);
+    readOffset = pthis->readIndex & (pthis->bufferSize - 1);
+
+    spans[0].dataPtr = pthis->bufferPtr + readOffset;
+    spans[0].dataLen = USER_UTIL_MIN(dataLen, (uint16_t) (pthis->bufferSize - readOffset));
+    spans[1].dataPtr = pthis->bufferPtr;
+    spans[1].dataLen = dataLen - spans[0].dataLen;
+
+    return dataLen;
+}
+
+/**
+ * @brief Release data of buffer that have been handled in place.
+ * @param pthis Pointer to buffer structure.
+ * @param dataLen Length of data to be released.
+ * @return Length of data released actually.
+ */
+uint16_t UtilBuffer_Consume(T_UtilBuffer *pthis, uint16_t dataLen)
+{
+    dataLen = USER_UTIL_MIN(dataLen, (uint16_t) (pthis->writeIndex - pthis->readIndex));
+    pthis->readIndex += dataLen;
+
+    return dataLen;
+}
+
+/**
+ * @brief Expose unused space of buffer to be filled in place, data is published by UtilBuffer_Commit().
+ * @param pthis Pointer to buffer structure.
+ * @param spans Two spans filled with unused space in order, second span is empty if space does not wrap.
+ * @return Total length of space exposed by spans.
+ */
+uint16_t UtilBuffer_ReserveSpans(T_UtilBuffer *pthis, T_UtilBufferSpan spans[2])
+{
+    uint16_t spaceLen;
+    uint16_t writeOffset;
+
+    spaceLen = UtilBuffer_GetUnusedSize(pthis);
+    writeOffset = pthis->writeIndex & (pthis->bufferSize - 1);
+
+    spans[0].dataPtr = pthis->bufferPtr + writeOffset;
+    spans[0].dataLen = USER_UTIL_MIN(spaceLen, (uint16_t) (pthis->bufferSize - writeOffset));
+    spans[1].dataPtr = pthis->bufferPtr;
+    spans[1].dataLen = spaceLen - spans[0].dataLen;
+
+    return spaceLen;
+}
+
+/**
+ * @brief Publish data that have been written in place to reserved space of buffer.
+ * @param pthis Pointer to buffer structure.
+ * @param dataLen Length of data to be published.
+ * @return Length of data published actually.
+ */
+uint16_t UtilBuffer_Commit(T_UtilBuffer *pthis, uint16_t dataLen)
+{
+    dataLen = USER_UTIL_MIN(dataLen, UtilBuffer_GetUnusedSize(pthis));
+    pthis->writeIndex += dataLen;
+
+    return dataLen;
+}
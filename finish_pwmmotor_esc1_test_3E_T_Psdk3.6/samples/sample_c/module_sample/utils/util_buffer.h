@@ -42,6 +42,12 @@ typedef struct {
     uint16_t writeIndex;
 } T_UtilBuffer;
 
+//contiguous region of buffer memory, data may wrap so up to two spans describe it
+typedef struct {
+    uint8_t *dataPtr;
+    uint16_t dataLen;
+} T_UtilBufferSpan;
+
 /* Exported variables --------------------------------------------------------*/
 /* Exported functions --------------------------------------------------------*/
 
@@ -49,6 +55,10 @@ void UtilBuffer_Init(T_UtilBuffer *pthis, uint8_t *pBuf, uint16_t bufSize);
 uint16_t UtilBuffer_Put(T_UtilBuffer *pthis, const uint8_t *pData, uint16_t dataLen);
 uint16_t UtilBuffer_Get(T_UtilBuffer *pthis, uint8_t *pData, uint16_t dataLen);
 uint16_t UtilBuffer_GetUnusedSize(T_UtilBuffer *pthis);
+uint16_t UtilBuffer_PeekSpans(T_UtilBuffer *pthis, T_UtilBufferSpan spans[2]);
+uint16_t UtilBuffer_Consume(T_UtilBuffer *pthis, uint16_t dataLen);
+uint16_t UtilBuffer_ReserveSpans(T_UtilBuffer *pthis, T_UtilBufferSpan spans[2]);
+uint16_t UtilBuffer_Commit(T_UtilBuffer *pthis, uint16_t dataLen);
 
 /* Private constants ---------------------------------------------------------*/
 /* Private macros ------------------------------------------------------------*/
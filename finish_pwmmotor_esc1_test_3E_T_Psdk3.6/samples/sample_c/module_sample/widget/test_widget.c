@@ -28,6 +28,7 @@
 #include "../utils/util_misc.h"
 #include <dji_platform.h>
 #include <stdio.h>
+#include <string.h>
 #include "dji_sdk_config.h"
 #include "file_binary_array_list_en.h"
 
@@ -48,6 +49,8 @@ static T_DjiReturnCode DjiTestWidget_GetWidgetValue(E_DjiWidgetType widgetType,
 static T_DjiTaskHandle s_widgetTestThread;
 static bool s_isWidgetFileDirPathConfigured = false;
 static char s_widgetFileDirPath[DJI_FILE_PATH_SIZE_MAX] = {0};
+static DjiTestWidgetValueChangedCallback s_widgetValueChangedCallback = NULL;
+static const char *volatile s_floatingWindowStatus = NULL;
 
 static const T_DjiWidgetHandlerListItem s_widgetHandlerList[] = {
     {0, DJI_WIDGET_TYPE_BUTTON,        DjiTestWidget_SetWidgetValue, DjiTestWidget_GetWidgetValue, NULL},
@@ -193,6 +196,70 @@ int32_t DjiUser_GetValue(E_DjiWidgetType widgetType, uint32_t index){
     return value;
 }
 
+/**
+ * @brief Register callback invoked after value of any widget is set by app, so that users of widget value can wait
+ * for change instead of polling.
+ * @note Callback runs in the task of payload sdk that handles widget commands, it must not block.
+ * @param callback: callback function, NULL to unregister.
+ * @return Execution result.
+ */
+T_DjiReturnCode DjiTest_WidgetRegValueChangedCallback(DjiTestWidgetValueChangedCallback callback)
+{
+    s_widgetValueChangedCallback = callback;
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+/**
+ * @brief Set value of widget from payload side, e.g. to show state of payload, app reads it on next query. Value
+ * changed callback is not invoked.
+ * @param widgetType: type of widget.
+ * @param index: index of widget.
+ * @param value: value of widget.
+ * @return Execution result.
+ */
+T_DjiReturnCode DjiTest_WidgetSyncValue(E_DjiWidgetType widgetType, uint32_t index, int32_t value)
+{
+    USER_UTIL_UNUSED(widgetType);
+
+    if (index >= s_widgetHandlerListCount) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    s_widgetValueList[index] = value;
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+/**
+ * @brief Set value of widget as if it were set by app, value changed callback is invoked. Used to script widget
+ * operations when no app is connected, e.g. by test bench of simulator.
+ * @param widgetType: type of widget.
+ * @param index: index of widget.
+ * @param value: value of widget.
+ * @return Execution result.
+ */
+T_DjiReturnCode DjiTest_WidgetInjectValue(E_DjiWidgetType widgetType, uint32_t index, int32_t value)
+{
+    if (index >= s_widgetHandlerListCount) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    return DjiTestWidget_SetWidgetValue(widgetType, index, value, NULL);
+}
+
+/**
+ * @brief Set status line appended to message of floating window, shown on next refresh.
+ * @param status: status string, must stay valid until replaced, e.g. string constant. NULL to remove.
+ * @return Execution result.
+ */
+T_DjiReturnCode DjiTest_WidgetSetFloatingWindowStatus(const char *status)
+{
+    s_floatingWindowStatus = status;
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
 #ifndef __CC_ARM
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wmissing-noreturn"
@@ -205,6 +272,8 @@ static void *DjiTest_WidgetTask(void *arg)
 {
     char message[DJI_WIDGET_FLOATING_WINDOW_MSG_MAX_LEN];
     uint32_t sysTimeMs = 0;
+    uint32_t messageLen;
+    const char *status;
     T_DjiReturnCode djiStat;
     T_DjiOsalHandler *osalHandler = DjiPlatform_GetOsalHandler();
 
@@ -226,6 +295,11 @@ static void *DjiTest_WidgetTask(void *arg)
                  __DATE__, __TIME__);
 #endif
 
+        status = s_floatingWindowStatus;
+        messageLen = strlen(message);
+        if (status != NULL && messageLen < DJI_WIDGET_FLOATING_WINDOW_MSG_MAX_LEN) {
+            snprintf(message + messageLen, DJI_WIDGET_FLOATING_WINDOW_MSG_MAX_LEN - messageLen, "\r\n%s", status);
+        }
 
         djiStat = DjiWidgetFloatingWindow_ShowMessage(message);
         if (djiStat != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
@@ -249,6 +323,10 @@ static T_DjiReturnCode DjiTestWidget_SetWidgetValue(E_DjiWidgetType widgetType,
                   s_widgetTypeNameArray[widgetType], index, value);
     s_widgetValueList[index] = value;
 
+    if (s_widgetValueChangedCallback != NULL) {
+        s_widgetValueChangedCallback(widgetType, index, value);
+    }
+
     return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
 }
 
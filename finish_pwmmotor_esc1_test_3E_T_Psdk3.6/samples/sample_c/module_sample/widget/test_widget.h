@@ -39,12 +39,17 @@ extern "C" {
 /* Exported constants --------------------------------------------------------*/
 
 /* Exported types ------------------------------------------------------------*/
+typedef void (*DjiTestWidgetValueChangedCallback)(E_DjiWidgetType widgetType, uint32_t index, int32_t value);
 
 /* Exported functions --------------------------------------------------------*/
 T_DjiReturnCode DjiTest_WidgetStartService(void);
 T_DjiReturnCode DjiTest_WidgetSetConfigFilePath(const char *path);
 __attribute__((weak)) void DjiTest_WidgetLogAppend(const char *fmt, ...);
 int32_t DjiUser_GetValue(E_DjiWidgetType widgetType, uint32_t index);
+T_DjiReturnCode DjiTest_WidgetRegValueChangedCallback(DjiTestWidgetValueChangedCallback callback);
+T_DjiReturnCode DjiTest_WidgetSyncValue(E_DjiWidgetType widgetType, uint32_t index, int32_t value);
+T_DjiReturnCode DjiTest_WidgetInjectValue(E_DjiWidgetType widgetType, uint32_t index, int32_t value);
+T_DjiReturnCode DjiTest_WidgetSetFloatingWindowStatus(const char *status);
 #ifdef __cplusplus
 }
 #endif
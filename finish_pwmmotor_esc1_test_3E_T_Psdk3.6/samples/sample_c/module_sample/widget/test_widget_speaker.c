@@ -32,7 +32,8 @@
 #include "utils/util_misc.h"
 #include "utils/util_md5.h"
 #include <dji_aircraft_info.h>
-#include "bsp_debug_usart.h"
+#include "tts_output.h"
+#include "textcodec.h"
 
 
 
@@ -105,7 +106,7 @@ static T_DjiReturnCode DjiTest_CheckFileMd5Sum(const char *path, uint8_t *buf, u
 #endif
 
 /* Exported functions definition ---------------------------------------------*/
-void SYN_FrameInfo(uint8_t *HZdata);
+void SYN_FrameInfo(const uint8_t *HZdata, uint16_t len);
 
 T_DjiReturnCode DjiTest_WidgetSpeakerStartService(void)
 {
@@ -611,31 +612,20 @@ static T_DjiReturnCode SetVolume(uint8_t volume)
     return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
 }
 
-void SYN_FrameInfo(uint8_t *HZdata)
+/**
+ * @brief Queue announcement of text on speech module, returns without waiting for module to speak it.
+ * @param HZdata: text in GBK encoding.
+ * @param len: length of text, unit: byte.
+ * @return None.
+ */
+void SYN_FrameInfo(const uint8_t *HZdata, uint16_t len)
 {
-/****************��Ҫ���͵��ı�**********************************/ 
-		 unsigned  char Frame_Info[50]; //������ı�����?         
-		 unsigned  int  HZ_Length;  
-		 //uint8_t word;
-	     uint8_t i=0; 
-		 HZ_Length =strlen(HZdata); 			//��Ҫ�����ı��ĳ���
- 		 
-/*****************֡�̶�������Ϣ**************************************/           
-		 Frame_Info[0] = 0xFD ; 			//����֡ͷFD
-		 Frame_Info[1] = 0x00 ; 			//�������������ȵĸ��ֽ�
-		 Frame_Info[2] = HZ_Length+2; 		//�������������ȵĵ��ֽ�
-		 Frame_Info[3] = 0x01 ; 			//���������֣��ϳɲ�������		 		 
-		 Frame_Info[4] = 0x01;       //�ı������ʽ��GBK 
- 
-/*******************����֡��Ϣ***************************************/		  
-         memcpy(&Frame_Info[5], HZdata, HZ_Length);
-		 Usart_SendString((uint8_t *)Frame_Info,5+HZ_Length);
-		 vTaskDelay(500);
-		 //for(i=0;i<HZ_Length;i++){
-			//word = Frame_Info[i];
-			//Usart_SendString(word);
-		 //}
-		 //Usart_SendString(&Frame_Info); //����֡����
+    T_DjiReturnCode returnCode;
+
+    returnCode = TtsOutput_Speak(HZdata, len, TTS_OUTPUT_PRIORITY_NORMAL);
+    if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        USER_LOG_WARN("queue announcement error: 0x%08llX.", returnCode);
+    }
 }
 
 static T_DjiReturnCode ReceiveTtsData(E_DjiWidgetTransmitDataEvent event,
@@ -692,7 +682,7 @@ static T_DjiReturnCode ReceiveTtsData(E_DjiWidgetTransmitDataEvent event,
 
 
 uint8_t gbk[64];
-uint8_t gbkSize;
+uint32_t gbkSize;
 static T_DjiReturnCode ReceiveAudioData(E_DjiWidgetTransmitDataEvent event,
                                         uint32_t offset, uint8_t *buf, uint16_t size)
 {
@@ -718,10 +708,10 @@ static T_DjiReturnCode ReceiveAudioData(E_DjiWidgetTransmitDataEvent event,
         USER_LOG_INFO("Create voice file: %s, decoder bitrate: %d.", transDataContent.transDataStartContent.fileName,
                       transDataContent.transDataStartContent.fileDecodeBitrate);
 		
-        UTF8ToGBK((const uint8_t *)transDataContent.transDataStartContent.fileName,strlen(transDataContent.transDataStartContent.fileName),gbk,&gbkSize);
-        uint8_t h[20];
-        memcpy(h, gbk, gbkSize);
-		SYN_FrameInfo(h);
+        UTF8ToGBK((const uint8_t *)transDataContent.transDataStartContent.fileName,
+                  strnlen((const char *) transDataContent.transDataStartContent.fileName,
+                          sizeof(transDataContent.transDataStartContent.fileName)), gbk, &gbkSize);
+        SYN_FrameInfo(gbk, (uint16_t) gbkSize);
 
 
     } else if (event == DJI_WIDGET_TRANSMIT_DATA_EVENT_TRANSMIT) {
@@ -28,15 +28,31 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "semphr.h"
+#include "time_base.h"
+#include "osal_mem_pool.h"
 #include "stdlib.h"
+#include "string.h"
 
 /* Private constants ---------------------------------------------------------*/
 #define SEM_MUTEX_WAIT_FOREVER      0xFFFFFFFF
 #define TASK_PRIORITY_NORMAL        0
 
 /* Private types -------------------------------------------------------------*/
+typedef struct {
+    T_DjiTaskHandle task;
+    uint32_t stackSize;
+} T_OsalTaskRecord;
+
+/* Private values -------------------------------------------------------------*/
+static const T_OsalTaskPolicy *s_taskPolicyList = NULL;
+static uint16_t s_taskPolicyNum = 0;
+static uint8_t s_taskDefaultPriority = TASK_PRIORITY_NORMAL;
+static T_OsalTaskRecord s_taskRecordList[OSAL_TASK_RECORD_MAX_NUM];
 
 /* Private functions declaration ---------------------------------------------*/
+static const T_OsalTaskPolicy *Osal_FindTaskPolicy(const char *name);
+static void Osal_AddTaskRecord(T_DjiTaskHandle task, uint32_t stackSize);
+static void Osal_RemoveTaskRecord(T_DjiTaskHandle task);
 
 /* Exported functions definition ---------------------------------------------*/
 
@@ -45,7 +61,9 @@ T_DjiReturnCode Osal_TaskCreate(const char *name, void *(*taskFunc)(void *), uin
                                 void *arg, T_DjiTaskHandle *task)
 {
     uint32_t stackDepth;
-    char nameDealed[16] = {0};
+    char nameDealed[OSAL_TASK_NAME_MAX_LEN] = {0};
+    const T_OsalTaskPolicy *policy;
+    uint8_t priority = s_taskDefaultPriority;
 
     //attention :  freertos use stack depth param, stack size = (stack depth) * sizeof(StackType_t)
     if (stackSize % sizeof(StackType_t) == 0) {
@@ -56,10 +74,29 @@ T_DjiReturnCode Osal_TaskCreate(const char *name, void *(*taskFunc)(void *), uin
 
     if (name != NULL)
         strncpy(nameDealed, name, sizeof(nameDealed) - 1);
-    if (xTaskCreate((TaskFunction_t) taskFunc, nameDealed, stackDepth, arg, TASK_PRIORITY_NORMAL, (TaskHandle_t *)task) != pdPASS) {
+
+    policy = Osal_FindTaskPolicy(nameDealed);
+    if (policy != NULL) {
+        priority = policy->priority;
+    }
+
+    //task with higher priority must not start running before its record and affinity are set up
+    vTaskSuspendAll();
+    if (xTaskCreate((TaskFunction_t) taskFunc, nameDealed, stackDepth, arg, priority, (TaskHandle_t *)task) != pdPASS) {
         *task = NULL;
+        xTaskResumeAll();
+        return DJI_ERROR_SYSTEM_MODULE_CODE_MEMORY_ALLOC_FAILED;
     }
 
+#if (configNUM_CORES > 1) && (configUSE_CORE_AFFINITY == 1)
+    if (policy != NULL && policy->coreAffinityMask != 0) {
+        vTaskCoreAffinitySet((TaskHandle_t) *task, (UBaseType_t) policy->coreAffinityMask);
+    }
+#endif
+
+    Osal_AddTaskRecord(*task, stackDepth * sizeof(StackType_t));
+    xTaskResumeAll();
+
     return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
 }
 
@@ -69,11 +106,75 @@ T_DjiReturnCode Osal_TaskDestroy(T_DjiTaskHandle task)
         return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
     }
 
+    //record must be gone before handle becomes invalid, task may be destroying itself
+    Osal_RemoveTaskRecord(task);
     vTaskDelete(task);
 
     return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
 }
 
+/**
+ * @brief Set priority policy of tasks created by Osal_TaskCreate.
+ * @note Policy list is referenced rather than copied, it must stay valid and should be set before any task is
+ * created, tasks that have been created keep their priority.
+ * @param policyList: list of policies keyed by task name, NULL to use default priority for all tasks.
+ * @param policyNum: number of policies in list.
+ * @param defaultPriority: priority of tasks not found in list.
+ * @return Execution result.
+ */
+T_DjiReturnCode Osal_SetTaskPolicy(const T_OsalTaskPolicy *policyList, uint16_t policyNum, uint8_t defaultPriority)
+{
+    uint16_t i;
+
+    if ((policyList == NULL && policyNum != 0) || defaultPriority >= configMAX_PRIORITIES) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    for (i = 0; i < policyNum; i++) {
+        if (policyList[i].name == NULL || policyList[i].priority >= configMAX_PRIORITIES) {
+            return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+        }
+    }
+
+    s_taskPolicyList = policyList;
+    s_taskPolicyNum = policyNum;
+    s_taskDefaultPriority = defaultPriority;
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+/**
+ * @brief Get state of a task created by Osal_TaskCreate.
+ * @param index: index of task record, range from 0 to OSAL_TASK_RECORD_MAX_NUM - 1.
+ * @param state: pointer to state of task.
+ * @return Execution result, DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND if no task is recorded at index.
+ */
+T_DjiReturnCode Osal_GetTaskState(uint16_t index, T_OsalTaskState *state)
+{
+    TaskHandle_t task;
+
+    if (state == NULL || index >= OSAL_TASK_RECORD_MAX_NUM) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    //no task can be destroyed while scheduler is suspended, so handle stays valid
+    vTaskSuspendAll();
+    task = s_taskRecordList[index].task;
+    if (task == NULL) {
+        xTaskResumeAll();
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
+    }
+
+    memset(state->name, 0, sizeof(state->name));
+    strncpy(state->name, pcTaskGetName(task), sizeof(state->name) - 1);
+    state->priority = (uint8_t) uxTaskPriorityGet(task);
+    state->stackSize = s_taskRecordList[index].stackSize;
+    state->minFreeStackSize = (uint32_t) uxTaskGetStackHighWaterMark(task) * sizeof(StackType_t);
+    xTaskResumeAll();
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
 T_DjiReturnCode Osal_TaskSleepMs(uint32_t timeMs)
 {
     TickType_t ticks;
@@ -230,7 +331,7 @@ T_DjiReturnCode Osal_GetTimeUs(uint64_t *us)
         return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
     }
 
-    *us = xTaskGetTickCount() * 1000;
+    *us = TimeBase_GetUs();
 
     return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
 }
@@ -244,12 +345,63 @@ T_DjiReturnCode Osal_GetRandomNum(uint16_t *randomNum)
 
 void *Osal_Malloc(uint32_t size)
 {
+#if OSAL_MEM_POOL_ENABLE
+    return OsalMemPool_Malloc(size);
+#else
     return pvPortMalloc(size);
+#endif
 }
 
 void Osal_Free(void *ptr)
 {
+#if OSAL_MEM_POOL_ENABLE
+    OsalMemPool_Free(ptr);
+#else
     vPortFree(ptr);
+#endif
+}
+
+static const T_OsalTaskPolicy *Osal_FindTaskPolicy(const char *name)
+{
+    uint16_t i;
+
+    //name of task is truncated by kernel, so only the part kept is compared
+    for (i = 0; i < s_taskPolicyNum; i++) {
+        if (strncmp(name, s_taskPolicyList[i].name, OSAL_TASK_NAME_MAX_LEN - 1) == 0) {
+            return &s_taskPolicyList[i];
+        }
+    }
+
+    return NULL;
+}
+
+static void Osal_AddTaskRecord(T_DjiTaskHandle task, uint32_t stackSize)
+{
+    uint16_t i;
+
+    vTaskSuspendAll();
+    for (i = 0; i < OSAL_TASK_RECORD_MAX_NUM; i++) {
+        if (s_taskRecordList[i].task == NULL) {
+            s_taskRecordList[i].task = task;
+            s_taskRecordList[i].stackSize = stackSize;
+            break;
+        }
+    }
+    xTaskResumeAll();
+}
+
+static void Osal_RemoveTaskRecord(T_DjiTaskHandle task)
+{
+    uint16_t i;
+
+    vTaskSuspendAll();
+    for (i = 0; i < OSAL_TASK_RECORD_MAX_NUM; i++) {
+        if (s_taskRecordList[i].task == task) {
+            s_taskRecordList[i].task = NULL;
+            break;
+        }
+    }
+    xTaskResumeAll();
 }
 
 /****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
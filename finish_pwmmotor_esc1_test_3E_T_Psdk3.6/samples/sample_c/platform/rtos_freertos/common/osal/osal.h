@@ -37,13 +37,29 @@ extern "C" {
 #endif
 
 /* Exported constants --------------------------------------------------------*/
+#define OSAL_TASK_NAME_MAX_LEN      16
+#define OSAL_TASK_RECORD_MAX_NUM    32
 
 /* Exported types ------------------------------------------------------------*/
+typedef struct {
+    const char *name; /*!< Task name, compared with at most OSAL_TASK_NAME_MAX_LEN - 1 characters. */
+    uint8_t priority; /*!< Priority of task, larger value means higher priority. */
+    uint32_t coreAffinityMask; /*!< Cores the task may run on, 0 means any core. Only used by SMP kernel. */
+} T_OsalTaskPolicy;
+
+typedef struct {
+    char name[OSAL_TASK_NAME_MAX_LEN];
+    uint8_t priority;
+    uint32_t stackSize; /*!< Stack size requested on creation, unit: byte. */
+    uint32_t minFreeStackSize; /*!< Stack high water mark, minimum free stack ever seen, unit: byte. */
+} T_OsalTaskState;
 
 /* Exported functions --------------------------------------------------------*/
 T_DjiReturnCode Osal_TaskCreate(const char *name, void *(*taskFunc)(void *), uint32_t stackSize,
                                 void *arg, T_DjiTaskHandle *task);
 T_DjiReturnCode Osal_TaskDestroy(T_DjiTaskHandle task);
+T_DjiReturnCode Osal_SetTaskPolicy(const T_OsalTaskPolicy *policyList, uint16_t policyNum, uint8_t defaultPriority);
+T_DjiReturnCode Osal_GetTaskState(uint16_t index, T_OsalTaskState *state);
 T_DjiReturnCode Osal_TaskSleepMs(uint32_t timeMs);
 T_DjiReturnCode Osal_MutexCreate(T_DjiMutexHandle *mutex);
 T_DjiReturnCode Osal_MutexDestroy(T_DjiMutexHandle mutex);
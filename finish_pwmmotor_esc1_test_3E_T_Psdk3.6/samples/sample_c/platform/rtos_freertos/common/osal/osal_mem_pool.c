@@ -0,0 +1,229 @@
+/**
+ ********************************************************************
+ * @file    osal_mem_pool.c
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   Size class pool allocator behind Osal_Malloc, small blocks are taken from
+ * fixed size free lists in O(1) so that short-lived allocations do not fragment FreeRTOS heap.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "osal_mem_pool.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "string.h"
+
+/* Private constants ---------------------------------------------------------*/
+
+/* Private types -------------------------------------------------------------*/
+typedef struct T_OsalMemPoolBlock {
+    struct T_OsalMemPoolBlock *next;
+} T_OsalMemPoolBlock;
+
+typedef struct {
+    uint32_t blockSize;
+    uint32_t blockNum;
+} T_OsalMemPoolClassConfig;
+
+typedef struct {
+    uint8_t *startAddr;
+    uint8_t *endAddr;
+    T_OsalMemPoolBlock *freeList;
+    T_OsalMemPoolClassState state;
+} T_OsalMemPoolClass;
+
+/* Private values -------------------------------------------------------------*/
+//block size must be a multiple of portBYTE_ALIGNMENT and ascending, pool is taken from FreeRTOS heap on init
+static const T_OsalMemPoolClassConfig s_memPoolClassConfig[OSAL_MEM_POOL_CLASS_NUM] = {
+    {16,   48},
+    {32,   48},
+    {64,   32},
+    {128,  24},
+    {256,  12},
+    {1024, 4},
+};
+static T_OsalMemPoolClass s_memPoolClass[OSAL_MEM_POOL_CLASS_NUM];
+static uint8_t *s_memPoolStartAddr = NULL;
+static uint8_t *s_memPoolEndAddr = NULL;
+static uint32_t s_countOfHeapAlloc = 0;
+
+/* Private functions declaration ---------------------------------------------*/
+
+/* Exported functions definition ---------------------------------------------*/
+/**
+ * @brief Take memory of all classes from FreeRTOS heap at once and build free list of every class.
+ * @note Allocations before init or after init failed are served by FreeRTOS heap.
+ * @return Execution result.
+ */
+T_DjiReturnCode OsalMemPool_Init(void)
+{
+    uint32_t poolSize = 0;
+    uint8_t *addr;
+    uint32_t i;
+    uint32_t j;
+
+    if (s_memPoolStartAddr != NULL) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+    }
+
+    for (i = 0; i < OSAL_MEM_POOL_CLASS_NUM; i++) {
+        poolSize += s_memPoolClassConfig[i].blockSize * s_memPoolClassConfig[i].blockNum;
+    }
+
+    addr = pvPortMalloc(poolSize);
+    if (addr == NULL) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_MEMORY_ALLOC_FAILED;
+    }
+
+    memset(s_memPoolClass, 0, sizeof(s_memPoolClass));
+    for (i = 0; i < OSAL_MEM_POOL_CLASS_NUM; i++) {
+        s_memPoolClass[i].startAddr = addr;
+        s_memPoolClass[i].state.blockSize = s_memPoolClassConfig[i].blockSize;
+        s_memPoolClass[i].state.blockNum = s_memPoolClassConfig[i].blockNum;
+        //link blocks backwards so that free list hands out lowest address first
+        for (j = s_memPoolClassConfig[i].blockNum; j > 0; j--) {
+            T_OsalMemPoolBlock *block = (T_OsalMemPoolBlock *) (addr + (j - 1) * s_memPoolClassConfig[i].blockSize);
+
+            block->next = s_memPoolClass[i].freeList;
+            s_memPoolClass[i].freeList = block;
+        }
+        addr += s_memPoolClassConfig[i].blockSize * s_memPoolClassConfig[i].blockNum;
+        s_memPoolClass[i].endAddr = addr;
+    }
+
+    taskENTER_CRITICAL();
+    s_memPoolEndAddr = addr;
+    s_memPoolStartAddr = s_memPoolClass[0].startAddr;
+    taskEXIT_CRITICAL();
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+/**
+ * @brief Allocate memory from smallest class that fits, or from FreeRTOS heap if size is larger than any class or
+ * the class is exhausted.
+ * @param size: size of memory, unit: byte.
+ * @return Pointer to memory, NULL if failed.
+ */
+void *OsalMemPool_Malloc(uint32_t size)
+{
+    T_OsalMemPoolClass *memPoolClass = NULL;
+    T_OsalMemPoolBlock *block = NULL;
+    uint32_t i;
+
+    if (s_memPoolStartAddr != NULL && size != 0) {
+        for (i = 0; i < OSAL_MEM_POOL_CLASS_NUM; i++) {
+            if (size <= s_memPoolClass[i].state.blockSize) {
+                memPoolClass = &s_memPoolClass[i];
+                break;
+            }
+        }
+    }
+
+    if (memPoolClass != NULL) {
+        taskENTER_CRITICAL();
+        block = memPoolClass->freeList;
+        if (block != NULL) {
+            memPoolClass->freeList = block->next;
+            memPoolClass->state.usedBlockNum++;
+            memPoolClass->state.countOfAlloc++;
+            if (memPoolClass->state.usedBlockNum > memPoolClass->state.maxUsedBlockNum) {
+                memPoolClass->state.maxUsedBlockNum = memPoolClass->state.usedBlockNum;
+            }
+        } else {
+            memPoolClass->state.countOfExhausted++;
+        }
+        taskEXIT_CRITICAL();
+
+        if (block != NULL) {
+            return block;
+        }
+    }
+
+    taskENTER_CRITICAL();
+    s_countOfHeapAlloc++;
+    taskEXIT_CRITICAL();
+
+    return pvPortMalloc(size);
+}
+
+/**
+ * @brief Free memory allocated by OsalMemPool_Malloc, memory outside of pool is returned to FreeRTOS heap.
+ * @param ptr: pointer to memory, NULL is ignored.
+ * @return None.
+ */
+void OsalMemPool_Free(void *ptr)
+{
+    T_OsalMemPoolBlock *block = (T_OsalMemPoolBlock *) ptr;
+    uint32_t i;
+
+    if (ptr == NULL) {
+        return;
+    }
+
+    if (s_memPoolStartAddr == NULL || (uint8_t *) ptr < s_memPoolStartAddr || (uint8_t *) ptr >= s_memPoolEndAddr) {
+        vPortFree(ptr);
+        return;
+    }
+
+    for (i = 0; i < OSAL_MEM_POOL_CLASS_NUM; i++) {
+        if ((uint8_t *) ptr < s_memPoolClass[i].endAddr) {
+            taskENTER_CRITICAL();
+            block->next = s_memPoolClass[i].freeList;
+            s_memPoolClass[i].freeList = block;
+            s_memPoolClass[i].state.usedBlockNum--;
+            taskEXIT_CRITICAL();
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Get state of a size class.
+ * @param classIndex: index of class, range from 0 to OSAL_MEM_POOL_CLASS_NUM - 1, ascending by block size.
+ * @param state: pointer to state of class.
+ * @return Execution result.
+ */
+T_DjiReturnCode OsalMemPool_GetClassState(uint8_t classIndex, T_OsalMemPoolClassState *state)
+{
+    if (classIndex >= OSAL_MEM_POOL_CLASS_NUM || state == NULL) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    taskENTER_CRITICAL();
+    memcpy(state, &s_memPoolClass[classIndex].state, sizeof(T_OsalMemPoolClassState));
+    taskEXIT_CRITICAL();
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+/**
+ * @brief Get count of allocations served by FreeRTOS heap, including large and zero size ones.
+ * @return Count of allocations.
+ */
+uint32_t OsalMemPool_GetCountOfHeapAlloc(void)
+{
+    return s_countOfHeapAlloc;
+}
+
+/* Private functions definition-----------------------------------------------*/
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
@@ -0,0 +1,69 @@
+/**
+ ********************************************************************
+ * @file    osal_mem_pool.h
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   This is the header file for "osal_mem_pool.c", defining the structure and
+ * (exported) function prototypes.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef OSAL_MEM_POOL_H
+#define OSAL_MEM_POOL_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "dji_typedef.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Exported constants --------------------------------------------------------*/
+//set to 0 to let Osal_Malloc use FreeRTOS heap directly
+#ifndef OSAL_MEM_POOL_ENABLE
+#define OSAL_MEM_POOL_ENABLE        1
+#endif
+
+#define OSAL_MEM_POOL_CLASS_NUM     6
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct {
+    uint32_t blockSize; /*!< Size of block of class, unit: byte. */
+    uint32_t blockNum; /*!< Number of blocks of class. */
+    uint32_t usedBlockNum; /*!< Number of blocks in use. */
+    uint32_t maxUsedBlockNum; /*!< Max number of blocks that have been in use at the same time. */
+    uint32_t countOfAlloc; /*!< Count of allocations served by class. */
+    uint32_t countOfExhausted; /*!< Count of allocations sent to heap because class was exhausted. */
+} T_OsalMemPoolClassState;
+
+/* Exported functions --------------------------------------------------------*/
+T_DjiReturnCode OsalMemPool_Init(void);
+void *OsalMemPool_Malloc(uint32_t size);
+void OsalMemPool_Free(void *ptr);
+T_DjiReturnCode OsalMemPool_GetClassState(uint8_t classIndex, T_OsalMemPoolClassState *state);
+uint32_t OsalMemPool_GetCountOfHeapAlloc(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OSAL_MEM_POOL_H
+/************************ (C) COPYRIGHT DJI Innovations *******END OF FILE******/
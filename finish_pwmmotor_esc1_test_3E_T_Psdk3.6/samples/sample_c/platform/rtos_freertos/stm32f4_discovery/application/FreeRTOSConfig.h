@@ -31,6 +31,11 @@
 #ifndef FREERTOS_CONFIG_H
 #define FREERTOS_CONFIG_H
 
+#ifdef SYSTEM_ARCH_RTOS_SIM
+/* Host simulator build runs on FreeRTOS POSIX port, see project/posix_sim. */
+#include "FreeRTOSConfig_posix.h"
+#else
+
 /*-----------------------------------------------------------
  * Application specific definitions.
  *
@@ -90,6 +95,7 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelayUntil              0
 #define INCLUDE_vTaskDelay                   1
 #define INCLUDE_xTaskGetSchedulerState       1
+#define INCLUDE_uxTaskGetStackHighWaterMark  1
 
 /* Cortex-M specific definitions. */
 #ifdef __NVIC_PRIO_BITS
@@ -136,4 +142,6 @@ standard names. */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
 /* USER CODE END Defines */
 
+#endif /* SYSTEM_ARCH_RTOS_SIM */
+
 #endif /* FREERTOS_CONFIG_H */
@@ -24,6 +24,7 @@
  */
 /* Includes ------------------------------------------------------------------*/
 #include <widget/test_widget_speaker.h>
+#include <stdio.h>
 #include <hms/test_hms.h>
 #include "FreeRTOS.h"
 #include "FreeRTOSConfig.h"
@@ -39,6 +40,7 @@
 #include "application.h"
 #include "hal_uart.h"
 #include "osal.h"
+#include "osal_mem_pool.h"
 #include "dji_sdk_app_info.h"
 #include "dji_sdk_config.h"
 #include "dji_core.h"
@@ -60,27 +62,174 @@
 #include "power_management/test_power_management.h"
 
 #include "ledpwm.h"
+#include "motor_pwm.h"
+#include "esc_output.h"
+#include "esc_arming.h"
+#include "motor_capture.h"
+#include "widget_bus.h"
+#include "tts_output.h"
 #include "bsp_debug_usart.h"
 
 extern TIM_HandleTypeDef g_timx_pwm_chy_handle;     /* ��ʱ��x��� */
 extern TIM_HandleTypeDef g_timx_motor_chy_handle;
 
-void SYN_FrameInfo(uint8_t *HZdata);
-
 /* Private constants ---------------------------------------------------------*/
 #define RUN_INDICATE_TASK_FREQ_1HZ        1
 #define RUN_INDICATE_TASK_FREQ_0D1HZ      0.1f
 
 #define DJI_USE_WIDGET_INTERACTION        0
 
+#define TIME_BASE_TEST_STEP_NUM           100
+#define TIME_BASE_TEST_MAX_SAMPLE_NUM     100000
+
+//task priority of tasks created through osal, larger value means higher priority
+#define DJI_USE_TASK_POLICY               1
+#define DJI_TASK_PRIORITY_NORMAL          1
+#define DJI_TASK_PRIORITY_ABOVE_NORMAL    2
+#define DJI_TASK_PRIORITY_HIGH            3
+#define DJI_TASK_STACK_LOW_WATER_RATIO    8
+
+//background load used to check latency of reading communication uart, load is busy for BUSY_MS in every PERIOD_MS
+#define DJI_USE_CPU_LOAD_TEST             0
+#define CPU_LOAD_TASK_STACK_SIZE          512
+#define CPU_LOAD_TASK_PERIOD_MS           100
+#define CPU_LOAD_TASK_BUSY_MS             80
+
+//throttle of motor follows scale widget, task waits for change of widget and re-reads value at least once per period
+#define MOTOR_THROTTLE_WIDGET_INDEX       5
+#define MOTOR_THROTTLE_REFRESH_MS         20
+#define MOTOR_THROTTLE_IDLE_COMPARE       (MOTOR_PWM_PERIOD_COUNT - 60)
+#define MOTOR_THROTTLE_WIDGET_VALUE_MAX   100
+#define LED_PWM_WIDGET_INDEX              3
+#define LED_PWM_REFRESH_MS                100
+
+//motors are driven by multi-channel ESC output instead of PWM on TIM14, throttle widget drives all of them
+#define DJI_USE_ESC_OUTPUT                0
+#define ESC_OUTPUT_MOTOR_NUM              4
+#define ESC_OUTPUT_MOTOR_MODE             ESC_OUTPUT_MODE_DSHOT600
+#define ESC_OUTPUT_PWM_FREQ_HZ            400
+#define ESC_OUTPUT_UPDATE_PERIOD_MS       1
+
+//max update rate of ESC output and CPU load at a set of update rates, measured once with motors stopped
+#define DJI_USE_ESC_OUTPUT_BENCHMARK      0
+#define ESC_OUTPUT_BENCHMARK_DURATION_MS  1000
+
+//switch widget arms and disarms motors, button widget starts throttle range calibration of PWM ESCs. Switch follows
+//arming state and state is shown in floating window, outputs are stopped when no data comes from aircraft
+#define ESC_ARMING_SWITCH_WIDGET_INDEX         7
+#define ESC_CALIBRATION_BUTTON_WIDGET_INDEX    4
+#define ESC_ARMING_MAX_THROTTLE_HOLD_MS        5000
+#define ESC_ARMING_CALIBRATION_MIN_HOLD_MS     5000
+#define ESC_ARMING_MIN_THROTTLE_HOLD_MS        3000
+#define ESC_ARMING_LINK_LOST_TIMEOUT_MS        1000
+
+//produced pulse and motor speed are measured by input capture, refer to motor_capture.h for pins. Values are logged by
+//monitor task and sent to mobile through data transmission channel in place of its test payload. Capture takes TIM4,
+//PB6, PB8 and DMA1 stream 0 and 7, enable it only on boards that leave them free
+#define DJI_USE_MOTOR_CAPTURE                  0
+#define MOTOR_CAPTURE_FILTER_SHIFT             3
+#define MOTOR_CAPTURE_TACH_EDGE_PER_REV        7
+#define MOTOR_CAPTURE_SIGNAL_TIMEOUT_MS        50
+
 /* Private types -------------------------------------------------------------*/
+typedef struct {
+    uint32_t resolutionUs;
+    uint32_t maxStepUs;
+    uint32_t countOfBackStep;
+} T_DjiUserTimeBaseState;
+
+typedef struct {
+    uint64_t sumOfLatencyUs;
+    uint32_t countOfLatency;
+    uint32_t maxLatencyUs;
+} T_DjiUserThrottleLatency;
+
+typedef enum {
+    DJI_USER_ESC_ARMING_REQUEST_NONE = 0,
+    DJI_USER_ESC_ARMING_REQUEST_ARM,
+    DJI_USER_ESC_ARMING_REQUEST_DISARM,
+    DJI_USER_ESC_ARMING_REQUEST_CALIBRATION,
+} E_DjiUserEscArmingRequest;
 
 /* Private values -------------------------------------------------------------*/
 static bool s_isApplicationStart = false;
+#if DJI_USE_TASK_POLICY
+static const T_OsalTaskPolicy s_taskPolicyList[] = {
+    //protocol of payload sdk is received and dispatched to callbacks in root task, keep it ahead of other work
+    {.name = "root_task", .priority = DJI_TASK_PRIORITY_HIGH},
+    {.name = "user_widget_task", .priority = DJI_TASK_PRIORITY_ABOVE_NORMAL},
+};
+#endif
+#if DJI_USE_CPU_LOAD_TEST
+static T_DjiTaskHandle s_cpuLoadTask;
+#endif
+static T_WidgetBusHandle s_motorWidgetBusHandle = NULL;
+//latency from widget change to motor target set, and to output of target, see DjiUser_MonitorTask
+static T_DjiUserThrottleLatency s_throttleTargetLatency = {0};
+#if DJI_USE_ESC_OUTPUT
+static T_DjiUserThrottleLatency s_throttleOutputLatency = {0};
+#endif
+static const T_EscArmingConfig s_escArmingConfig = {
+    .maxThrottleHoldMs = ESC_ARMING_MAX_THROTTLE_HOLD_MS,
+    .calibrationMinThrottleHoldMs = ESC_ARMING_CALIBRATION_MIN_HOLD_MS,
+    .armMinThrottleHoldMs = ESC_ARMING_MIN_THROTTLE_HOLD_MS,
+    .linkLostTimeoutMs = ESC_ARMING_LINK_LOST_TIMEOUT_MS,
+};
+static T_EscArming s_escArming;
+static E_EscArmingState s_escArmingReportedState = ESC_ARMING_STATE_IDLE;
+static volatile E_DjiUserEscArmingRequest s_escArmingRequest = DJI_USER_ESC_ARMING_REQUEST_NONE;
+#if DJI_USE_MOTOR_CAPTURE
+static const T_MotorTelemetryConfig s_motorCaptureConfig = {
+    .filterShift = MOTOR_CAPTURE_FILTER_SHIFT,
+    .tachEdgePerRev = MOTOR_CAPTURE_TACH_EDGE_PER_REV,
+    .signalTimeoutMs = MOTOR_CAPTURE_SIGNAL_TIMEOUT_MS,
+};
+#endif
+//compare value is active low, so throttle up means ramping down, keep steps within 1% of full range per period
+static const T_ThrottleRampConfig s_motorThrottleRampConfig = {
+    .profile = THROTTLE_RAMP_PROFILE_S_CURVE,
+    .maxStepPerUpdate = 20,
+    .rampUpdateNum = 10,
+    .exponentialShift = 2,
+};
+#if DJI_USE_ESC_OUTPUT
+//ESC output is updated every millisecond, full throttle range is ramped in no less than 200 ms
+static const T_EscOutputConfig s_escOutputConfig = {
+    .mode = ESC_OUTPUT_MOTOR_MODE,
+    .channelNum = ESC_OUTPUT_MOTOR_NUM,
+    .pwmFreqHz = ESC_OUTPUT_PWM_FREQ_HZ,
+    .rampConfig = {
+        .profile = THROTTLE_RAMP_PROFILE_S_CURVE,
+        .maxStepPerUpdate = 10,
+        .rampUpdateNum = 100,
+        .exponentialShift = 4,
+    },
+};
+#endif
 
 /* Private functions declaration ---------------------------------------------*/
 static T_DjiReturnCode DjiUser_PrintConsole(const uint8_t *data, uint16_t dataLen);
 static T_DjiReturnCode DjiUser_FillInUserInfo(T_DjiUserInfo *userInfo);
+static void DjiUser_TestTimeBase(T_DjiUserTimeBaseState *state);
+static void DjiUser_ReportTaskState(void);
+static void DjiUser_ReportMemoryState(void);
+static void DjiUser_SubscribeMotorWidget(void);
+static bool DjiUser_ReceiveMotorWidget(uint32_t timeoutMs, int32_t *throttleValue, uint64_t *throttleChangeTimeUs);
+static void DjiUser_UpdateThrottleLatency(T_DjiUserThrottleLatency *latency, uint64_t changeTimeUs);
+static void DjiUser_InitEscArming(void);
+static uint16_t DjiUser_ProcessEscArming(uint16_t throttle, uint16_t throttleMax);
+#if DJI_USE_MOTOR_CAPTURE
+static uint16_t DjiUser_GetMotorTelemetryData(uint8_t *buffer, uint16_t bufferLen);
+#endif
+#if DJI_USE_ESC_OUTPUT
+static void DjiUser_RunEscOutput(void);
+#if DJI_USE_ESC_OUTPUT_BENCHMARK
+static void DjiUser_BenchmarkEscOutput(void);
+#endif
+#endif
+#if DJI_USE_CPU_LOAD_TEST
+static void *DjiUser_CpuLoadTask(void *arg);
+#endif
 
 
 /* Exported functions definition ---------------------------------------------*/
@@ -129,6 +278,9 @@ void DjiUser_StartTask(void const *argument)
 
     UART_Init(DJI_CONSOLE_UART_NUM, DJI_CONSOLE_UART_BAUD);
 	DEBUG_USART_Config();
+    if (TtsOutput_Init() != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        printf("tts output init error");
+    }
     //ESC_Init();
     Led_Init(LED3);
     Led_Init(LED4);
@@ -143,6 +295,21 @@ void DjiUser_StartTask(void const *argument)
     Osal_TaskSleepMs(2000);
 #endif
 
+#if OSAL_MEM_POOL_ENABLE
+    returnCode = OsalMemPool_Init();
+    if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        printf("init memory pool error, use heap only");
+    }
+#endif
+
+#if DJI_USE_TASK_POLICY
+    returnCode = Osal_SetTaskPolicy(s_taskPolicyList, UTIL_ARRAY_SIZE(s_taskPolicyList), DJI_TASK_PRIORITY_NORMAL);
+    if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        printf("set task policy error");
+        goto out;
+    }
+#endif
+
     returnCode = DjiPlatform_RegOsalHandler(&osalHandler);
     if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
         printf("register osal handler error");
@@ -233,6 +400,9 @@ void DjiUser_StartTask(void const *argument)
     if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
         USER_LOG_ERROR("widget sample init error");
     }
+#if DJI_USE_MOTOR_CAPTURE
+    DjiTest_DataTransmissionRegGetSendDataCallback(DjiUser_GetMotorTelemetryData);
+#endif
 #endif
 
 #ifdef CONFIG_MODULE_SAMPLE_FC_SUBSCRIPTION_ON
@@ -353,6 +523,13 @@ void DjiUser_StartTask(void const *argument)
 
     s_isApplicationStart = true;
 
+#if DJI_USE_CPU_LOAD_TEST
+    if (Osal_TaskCreate("cpu_load_task", DjiUser_CpuLoadTask, CPU_LOAD_TASK_STACK_SIZE, NULL, &s_cpuLoadTask) !=
+        DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS || s_cpuLoadTask == NULL) {
+        USER_LOG_ERROR("create cpu load task error");
+    }
+#endif
+
     while (1) {
         Osal_TaskSleepMs(500);
         Led_Trigger(LED3);
@@ -374,6 +551,21 @@ void DjiUser_MonitorTask(void const *argument)
     static uint32_t runIndicateTaskStep = 0;
     T_UartBufferState readBufferState = {0};
     T_UartBufferState writeBufferState = {0};
+    T_DjiUserTimeBaseState timeBaseState = {0};
+    T_DjiUserThrottleLatency throttleLatency;
+    T_WidgetBusSubscriberState widgetBusState;
+    uint16_t widgetBusIndex;
+    T_TtsOutputState ttsOutputState;
+#if DJI_USE_ESC_OUTPUT
+    T_EscOutputUpdateState escOutputUpdateState;
+#else
+    T_MotorPwmUpdateCost motorPwmUpdateCost;
+    T_MotorPwmOutputLatency motorPwmOutputLatency;
+#endif
+#if DJI_USE_MOTOR_CAPTURE
+    T_MotorTelemetryValue motorTelemetryValue;
+#endif
+    uint32_t lastWriteTransferredData[UART_NUM_3 + 1] = {0};
 #if (configUSE_TRACE_FACILITY == 1)
     int32_t i = 0;
     int32_t j = 0;
@@ -390,29 +582,114 @@ void DjiUser_MonitorTask(void const *argument)
         if (s_isApplicationStart == false) {
             continue;
         }
+        // report time base state
+        DjiUser_TestTimeBase(&timeBaseState);
+        USER_LOG_DEBUG("Time base state: resolution %d us, maxStep %d us, countOfBackStep %d.",
+                       timeBaseState.resolutionUs, timeBaseState.maxStepUs, timeBaseState.countOfBackStep);
+
+        // report latency from widget change to motor target, and to output reaching target after ramp
+        taskENTER_CRITICAL();
+        throttleLatency = s_throttleTargetLatency;
+        taskEXIT_CRITICAL();
+        USER_LOG_DEBUG("Motor throttle target latency: average %d us, max %d us, count %d.",
+                       throttleLatency.countOfLatency != 0 ?
+                       (uint32_t) (throttleLatency.sumOfLatencyUs / throttleLatency.countOfLatency) : 0,
+                       throttleLatency.maxLatencyUs, throttleLatency.countOfLatency);
+
+        // report delivery of widget changes to each subscriber
+        for (widgetBusIndex = 0;
+             WidgetBus_GetSubscriberState(widgetBusIndex, &widgetBusState) == DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+             widgetBusIndex++) {
+            USER_LOG_DEBUG("Widget bus %s: event %d, dropped %d, latency average %d us, max %d us.",
+                           widgetBusState.name, widgetBusState.countOfEvent, widgetBusState.countOfDropped,
+                           widgetBusState.averageLatencyUs, widgetBusState.maxLatencyUs);
+        }
+
+        // report announcement queue of speech module
+        TtsOutput_GetState(&ttsOutputState);
+        USER_LOG_DEBUG("Tts output: busy %d, queue %d, maxQueue %d, wait average %d ms, max %d ms.",
+                       ttsOutputState.isModuleBusy, ttsOutputState.queueDepth, ttsOutputState.maxQueueDepth,
+                       ttsOutputState.averageWaitMs, ttsOutputState.maxWaitMs);
+        USER_LOG_DEBUG("Tts output: announcement %d, preempted %d, dropped %d, error %d, throughput %d byte/s.",
+                       ttsOutputState.countOfAnnouncement, ttsOutputState.countOfPreempted,
+                       ttsOutputState.countOfDropped, ttsOutputState.countOfError,
+                       ttsOutputState.transmitBytesPerSecond);
+#if DJI_USE_ESC_OUTPUT
+        taskENTER_CRITICAL();
+        throttleLatency = s_throttleOutputLatency;
+        taskEXIT_CRITICAL();
+        USER_LOG_DEBUG("Motor throttle output latency: average %d us, max %d us, count %d.",
+                       throttleLatency.countOfLatency != 0 ?
+                       (uint32_t) (throttleLatency.sumOfLatencyUs / throttleLatency.countOfLatency) : 0,
+                       throttleLatency.maxLatencyUs, throttleLatency.countOfLatency);
+        EscOutput_GetUpdateState(&escOutputUpdateState);
+        USER_LOG_DEBUG("Esc output update: count %d, busy skip %d, average cost %d ns, max cost %d ns.",
+                       escOutputUpdateState.countOfUpdate, escOutputUpdateState.countOfBusySkip,
+                       escOutputUpdateState.averageCostNs, escOutputUpdateState.maxCostNs);
+#else
+        MotorPwm_GetOutputLatency(&motorPwmOutputLatency);
+        USER_LOG_DEBUG("Motor throttle output latency: average %d us, max %d us, count %d.",
+                       motorPwmOutputLatency.averageLatencyUs, motorPwmOutputLatency.maxLatencyUs,
+                       motorPwmOutputLatency.countOfLatency);
+        MotorPwm_GetUpdateCost(&motorPwmUpdateCost);
+        USER_LOG_DEBUG("Motor pwm ramp update: compare %d, average cost %d ns, max cost %d ns, count %d.",
+                       MotorPwm_GetCompare(MOTOR_PWM_CHANNEL_THROTTLE), motorPwmUpdateCost.averageCostNs,
+                       motorPwmUpdateCost.maxCostNs, motorPwmUpdateCost.countOfUpdate);
+#endif
+#if DJI_USE_MOTOR_CAPTURE
+        MotorCapture_GetTelemetry(&motorTelemetryValue);
+        USER_LOG_DEBUG("Motor capture: pulse %d us, period %d us, rpm %d, countOfPulse %d, countOfTachEdge %d.",
+                       motorTelemetryValue.pulseWidthUs, motorTelemetryValue.pulsePeriodUs, motorTelemetryValue.rpm,
+                       motorTelemetryValue.countOfPulse, motorTelemetryValue.countOfTachEdge);
+#endif
+
         // report UART buffer state
 #ifdef USING_UART_PORT_1
         UART_GetBufferState(UART_NUM_1, &readBufferState, &writeBufferState);
-        USER_LOG_DEBUG("Uart1 read buffer state: countOfLostData %d, maxUsedCapacityOfBuffer %d.",
-                       readBufferState.countOfLostData, readBufferState.maxUsedCapacityOfBuffer);
+        USER_LOG_DEBUG("Uart1 read buffer state: countOfLostData %d, maxUsedCapacityOfBuffer %d, interruptsPerKiloByte %d.",
+                       readBufferState.countOfLostData, readBufferState.maxUsedCapacityOfBuffer,
+                       readBufferState.interruptsPerKiloByte);
+        USER_LOG_DEBUG("Uart1 read latency: average %d us, max %d us.",
+                       readBufferState.averageLatencyUs, readBufferState.maxLatencyUs);
         USER_LOG_DEBUG("Uart1 write buffer state: countOfLostData %d, maxUsedCapacityOfBuffer %d.",
                        writeBufferState.countOfLostData, writeBufferState.maxUsedCapacityOfBuffer);
+        USER_LOG_DEBUG("Uart1 write throughput: %d byte/s, interruptsPerKiloByte %d.",
+                       (uint32_t) ((writeBufferState.countOfTransferredData - lastWriteTransferredData[UART_NUM_1]) *
+                                   RUN_INDICATE_TASK_FREQ_0D1HZ),
+                       writeBufferState.interruptsPerKiloByte);
+        lastWriteTransferredData[UART_NUM_1] = writeBufferState.countOfTransferredData;
 #endif
 
 #ifdef USING_UART_PORT_2
         UART_GetBufferState(UART_NUM_2, &readBufferState, &writeBufferState);
-        USER_LOG_DEBUG("Uart2 read buffer state: countOfLostData %d, maxUsedCapacityOfBuffer %d.",
-                       readBufferState.countOfLostData, readBufferState.maxUsedCapacityOfBuffer);
+        USER_LOG_DEBUG("Uart2 read buffer state: countOfLostData %d, maxUsedCapacityOfBuffer %d, interruptsPerKiloByte %d.",
+                       readBufferState.countOfLostData, readBufferState.maxUsedCapacityOfBuffer,
+                       readBufferState.interruptsPerKiloByte);
+        USER_LOG_DEBUG("Uart2 read latency: average %d us, max %d us.",
+                       readBufferState.averageLatencyUs, readBufferState.maxLatencyUs);
         USER_LOG_DEBUG("Uart2 write buffer state: countOfLostData %d, maxUsedCapacityOfBuffer %d.",
                        writeBufferState.countOfLostData, writeBufferState.maxUsedCapacityOfBuffer);
+        USER_LOG_DEBUG("Uart2 write throughput: %d byte/s, interruptsPerKiloByte %d.",
+                       (uint32_t) ((writeBufferState.countOfTransferredData - lastWriteTransferredData[UART_NUM_2]) *
+                                   RUN_INDICATE_TASK_FREQ_0D1HZ),
+                       writeBufferState.interruptsPerKiloByte);
+        lastWriteTransferredData[UART_NUM_2] = writeBufferState.countOfTransferredData;
 #endif
 
 #ifdef USING_UART_PORT_3
         UART_GetBufferState(UART_NUM_3, &readBufferState, &writeBufferState);
-        USER_LOG_DEBUG("Uart3 read buffer state: countOfLostData %d, maxUsedCapacityOfBuffer %d.",
-                       readBufferState.countOfLostData, readBufferState.maxUsedCapacityOfBuffer);
+        USER_LOG_DEBUG("Uart3 read buffer state: countOfLostData %d, maxUsedCapacityOfBuffer %d, interruptsPerKiloByte %d.",
+                       readBufferState.countOfLostData, readBufferState.maxUsedCapacityOfBuffer,
+                       readBufferState.interruptsPerKiloByte);
+        USER_LOG_DEBUG("Uart3 read latency: average %d us, max %d us.",
+                       readBufferState.averageLatencyUs, readBufferState.maxLatencyUs);
         USER_LOG_DEBUG("Uart3 write buffer state: countOfLostData %d, maxUsedCapacityOfBuffer %d.",
                        writeBufferState.countOfLostData, writeBufferState.maxUsedCapacityOfBuffer);
+        USER_LOG_DEBUG("Uart3 write throughput: %d byte/s, interruptsPerKiloByte %d.",
+                       (uint32_t) ((writeBufferState.countOfTransferredData - lastWriteTransferredData[UART_NUM_3]) *
+                                   RUN_INDICATE_TASK_FREQ_0D1HZ),
+                       writeBufferState.interruptsPerKiloByte);
+        lastWriteTransferredData[UART_NUM_3] = writeBufferState.countOfTransferredData;
 #endif
 
         // report system performance information.
@@ -447,6 +724,8 @@ void DjiUser_MonitorTask(void const *argument)
             lastTaskStatusArray = currentTaskStatusArray;
             lastTaskStatusArraySize = currentTaskStatusArraySize;
 #endif
+            DjiUser_ReportTaskState();
+            DjiUser_ReportMemoryState();
         }
         USER_LOG_INFO("Used heap size: %d/%d.\r\n", configTOTAL_HEAP_SIZE - xPortGetFreeHeapSize(),
                       configTOTAL_HEAP_SIZE);
@@ -461,8 +740,25 @@ void DjiUser_MotorPwmTask(void const *argument){
     //gtim_timx_pwm_chy_init(500-1,840-1);
 //     //led_init();                                 /* ��ʼ��LED */
 
-    gtim_timx_pwm_chy_init(2000 - 1, 840 - 1);    /* 84 000 000 / 84 = 1 000 000 1Mhz�ļ���Ƶ�ʣ�2Khz��PWM */
-    uint32_t value;
+    DjiUser_InitEscArming();
+    DjiUser_SubscribeMotorWidget();
+
+#if DJI_USE_MOTOR_CAPTURE
+    if (MotorCapture_Init(&s_motorCaptureConfig) != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        USER_LOG_ERROR("motor capture init error");
+    }
+#endif
+
+#if DJI_USE_ESC_OUTPUT
+    DjiUser_RunEscOutput();
+#endif
+
+    MotorPwm_Init(&s_motorThrottleRampConfig, MOTOR_THROTTLE_IDLE_COMPARE);    /* 84 000 000 / 840 = 100 000, 100Khz count, 2000 counts per period, 50Hz PWM */
+    int32_t value = 0;
+    uint16_t throttle;
+    uint64_t changeTimeUs = 0;
+    bool isThrottleChanged = false;
+
     while (1)
     {
 		
@@ -478,14 +774,23 @@ void DjiUser_MotorPwmTask(void const *argument){
 
 //         // ���ݲ����ͷ����������
 //         currentBrightness += direction * step;
-            value = 2000 - 60 - DjiUser_GetValue( 3 , 5);
+            //calibration endpoints of ESC are the same idle and full throttle pulses that widget range maps to
+            throttle = DjiUser_ProcessEscArming((uint16_t) value, MOTOR_THROTTLE_WIDGET_VALUE_MAX);
             //gtim_timx_pwm_chy_init(2000 - 1, 840 - 1);
     //gtim_timx_motor_chy_init(2000 - 1, 840 - 1); 
             
             // for(value = 100 ; value<500 ; value+=10){
-            __HAL_TIM_SET_COMPARE(&g_timx_pwm_chy_handle, GTIM_TIMX_PWM_CHY, value);
-            vTaskDelay(2000);
-            printf("%d",value);
+            //failsafe stops motor at once, ramp only smooths commanded changes
+            if (s_escArmingReportedState == ESC_ARMING_STATE_FAULT) {
+                MotorPwm_JumpTarget(MOTOR_PWM_CHANNEL_THROTTLE, MOTOR_THROTTLE_IDLE_COMPARE);
+            } else {
+                MotorPwm_SetTarget(MOTOR_PWM_CHANNEL_THROTTLE, MOTOR_THROTTLE_IDLE_COMPARE - throttle);
+            }
+            if (isThrottleChanged) {
+                DjiUser_UpdateThrottleLatency(&s_throttleTargetLatency, changeTimeUs);
+                //latency to output is accounted by update interrupt once compare register reaches target
+                MotorPwm_StampTarget(MOTOR_PWM_CHANNEL_THROTTLE, changeTimeUs);
+            }
 
             // }
             ///__HAL_TIM_SET_COMPARE(&g_timx_pwm_chy_handle, GTIM_TIMX_PWM_CHY, 2000-);
@@ -493,6 +798,10 @@ void DjiUser_MotorPwmTask(void const *argument){
             
             Led_Trigger(LED4);
 
+            //wake up on widget change, output starts ramping toward new target from next PWM period, arming state
+            //machine also runs once per period
+            isThrottleChanged = DjiUser_ReceiveMotorWidget(MOTOR_THROTTLE_REFRESH_MS, &value, &changeTimeUs);
+
 //         vTaskDelay(100); // �����Ʊ仯�ٶȿ���
         
 //         */
@@ -538,12 +847,28 @@ void DjiUser_MotorPwmTask(void const *argument){
 void DjiUser_LedPwmTask(void const *argument){
     gtim_timx_motor_chy_init(200 - 1, 8400 - 1);    /* 84 000 000 / 84 = 1 000 000 1Mhz�ļ���Ƶ�ʣ�2Khz��PWM */
     uint32_t value;
+    T_WidgetBusHandle widgetBusHandle = NULL;
+    T_WidgetBusSnapshot widgetBusSnapshot;
+    T_WidgetBusEvent widgetBusEvent;
+
+    if (WidgetBus_Subscribe("led_pwm", WIDGET_BUS_INDEX_MASK(LED_PWM_WIDGET_INDEX), &widgetBusHandle) !=
+        DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        USER_LOG_ERROR("led pwm subscribe widget error");
+    }
+    WidgetBus_GetSnapshot(&widgetBusSnapshot);
+    widgetBusEvent.value = widgetBusSnapshot.value[LED_PWM_WIDGET_INDEX];
+
     while (1){
-        value = 200 - DjiUser_GetValue( 3 , 3)*2;
+        value = 200 - widgetBusEvent.value*2;
 //         //USER_LOG_INFO("value:%d",value);
         __HAL_TIM_SET_COMPARE(&g_timx_motor_chy_handle, GTIM_TIMX_MOTORPWM_CHY, value );
         Led_On(LED4);
-        vTaskDelay(100);
+        //wake up on widget change, otherwise refresh output at the old polling rate
+        if (widgetBusHandle != NULL) {
+            WidgetBus_Receive(widgetBusHandle, &widgetBusEvent, LED_PWM_REFRESH_MS);
+        } else {
+            vTaskDelay(LED_PWM_REFRESH_MS);
+        }
 
     }
 
@@ -636,6 +961,429 @@ static T_DjiReturnCode DjiUser_PrintConsole(const uint8_t *data, uint16_t dataLe
     return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
 }
 
+/**
+ * @brief Sample Osal_GetTimeUs back to back and check its resolution and monotonicity.
+ * @note Resolution is the smallest non-zero step between two samples, max step includes time of being preempted,
+ * so it is an upper bound of jitter. Resolution is 0 if time does not move within TIME_BASE_TEST_MAX_SAMPLE_NUM
+ * samples.
+ * @param state: pointer to result of test.
+ */
+static void DjiUser_TestTimeBase(T_DjiUserTimeBaseState *state)
+{
+    uint64_t lastTimeUs = 0;
+    uint64_t timeUs = 0;
+    uint32_t stepUs;
+    uint32_t countOfStep = 0;
+    uint32_t i;
+
+    state->resolutionUs = UINT32_MAX;
+    state->maxStepUs = 0;
+    state->countOfBackStep = 0;
+
+    Osal_GetTimeUs(&lastTimeUs);
+    for (i = 0; i < TIME_BASE_TEST_MAX_SAMPLE_NUM && countOfStep < TIME_BASE_TEST_STEP_NUM; i++) {
+        Osal_GetTimeUs(&timeUs);
+        if (timeUs < lastTimeUs) {
+            state->countOfBackStep++;
+        } else if (timeUs > lastTimeUs) {
+            stepUs = (uint32_t) (timeUs - lastTimeUs);
+            state->resolutionUs = USER_UTIL_MIN(stepUs, state->resolutionUs);
+            state->maxStepUs = USER_UTIL_MAX(stepUs, state->maxStepUs);
+            countOfStep++;
+        }
+        lastTimeUs = timeUs;
+    }
+
+    if (countOfStep == 0) {
+        state->resolutionUs = 0;
+    }
+}
+
+/**
+ * @brief Report priority and stack high water mark of tasks created through osal, warn of tasks short of stack.
+ */
+static void DjiUser_ReportTaskState(void)
+{
+    T_OsalTaskState taskState;
+    uint16_t i;
+
+    USER_LOG_DEBUG("osal task state:");
+    USER_LOG_DEBUG("task name\tpriority\tstack size (byte)\tstack left (byte)");
+    for (i = 0; i < OSAL_TASK_RECORD_MAX_NUM; i++) {
+        if (Osal_GetTaskState(i, &taskState) != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+            continue;
+        }
+
+        USER_LOG_DEBUG("%-16s\t%u\t%u\t%u", taskState.name, taskState.priority, taskState.stackSize,
+                       taskState.minFreeStackSize);
+        if (taskState.minFreeStackSize < taskState.stackSize / DJI_TASK_STACK_LOW_WATER_RATIO) {
+            USER_LOG_WARN("task %s is short of stack, %u of %u bytes left.", taskState.name,
+                          taskState.minFreeStackSize, taskState.stackSize);
+        }
+    }
+}
+
+/**
+ * @brief Publish widget changes to widget bus and subscribe motor task to throttle, arming and calibration widgets.
+ */
+static void DjiUser_SubscribeMotorWidget(void)
+{
+    T_DjiReturnCode returnCode;
+
+    DjiTest_WidgetRegValueChangedCallback(WidgetBus_Publish);
+
+    returnCode = WidgetBus_Subscribe("motor", WIDGET_BUS_INDEX_MASK(MOTOR_THROTTLE_WIDGET_INDEX) |
+                                              WIDGET_BUS_INDEX_MASK(ESC_ARMING_SWITCH_WIDGET_INDEX) |
+                                              WIDGET_BUS_INDEX_MASK(ESC_CALIBRATION_BUTTON_WIDGET_INDEX),
+                                     &s_motorWidgetBusHandle);
+    if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        USER_LOG_ERROR("motor subscribe widget error: 0x%08llX", returnCode);
+    }
+}
+
+/**
+ * @brief Wait for widget changes of motor task, arming and calibration changes are turned into requests.
+ * @param timeoutMs: max time to wait for first change, changes already queued after it are taken without wait.
+ * @param throttleValue: throttle widget value clamped to widget range, kept if throttle not changed.
+ * @param throttleChangeTimeUs: time of oldest throttle change taken, kept if throttle not changed.
+ * @return True if throttle changed.
+ */
+static bool DjiUser_ReceiveMotorWidget(uint32_t timeoutMs, int32_t *throttleValue, uint64_t *throttleChangeTimeUs)
+{
+    T_WidgetBusEvent event;
+    bool isThrottleChanged = false;
+
+    if (s_motorWidgetBusHandle == NULL) {
+        vTaskDelay(pdMS_TO_TICKS(timeoutMs));
+        return false;
+    }
+
+    while (WidgetBus_Receive(s_motorWidgetBusHandle, &event, timeoutMs) == DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        timeoutMs = 0;
+
+        if (event.widgetType == DJI_WIDGET_TYPE_SWITCH && event.index == ESC_ARMING_SWITCH_WIDGET_INDEX) {
+            s_escArmingRequest = event.value != 0 ? DJI_USER_ESC_ARMING_REQUEST_ARM :
+                                 DJI_USER_ESC_ARMING_REQUEST_DISARM;
+        } else if (event.widgetType == DJI_WIDGET_TYPE_BUTTON && event.index == ESC_CALIBRATION_BUTTON_WIDGET_INDEX) {
+            //button is set to 1 when pressed and 0 when released, calibration starts on press, a release that is
+            //coalesced with its press still means a press
+            if (event.value != 0 || event.countOfCoalesced != 0) {
+                s_escArmingRequest = DJI_USER_ESC_ARMING_REQUEST_CALIBRATION;
+            }
+        } else if (event.widgetType == DJI_WIDGET_TYPE_SCALE && event.index == MOTOR_THROTTLE_WIDGET_INDEX) {
+            *throttleValue = USER_UTIL_MIN(USER_UTIL_MAX(event.value, 0), MOTOR_THROTTLE_WIDGET_VALUE_MAX);
+            if (!isThrottleChanged) {
+                *throttleChangeTimeUs = event.timeUs;
+                isThrottleChanged = true;
+            }
+        }
+    }
+
+    return isThrottleChanged;
+}
+
+/**
+ * @brief Account time from oldest widget change taken to now, called by motor task after target is set or output.
+ * @param latency: latency to be updated.
+ * @param changeTimeUs: time of change, from widget bus event.
+ */
+static void DjiUser_UpdateThrottleLatency(T_DjiUserThrottleLatency *latency, uint64_t changeTimeUs)
+{
+    uint64_t timeUs = 0;
+    uint32_t latencyUs;
+
+    //widget bus stamps changes with time base, which is what Osal_GetTimeUs reads
+    Osal_GetTimeUs(&timeUs);
+    if (timeUs < changeTimeUs) {
+        return;
+    }
+
+    latencyUs = (uint32_t) (timeUs - changeTimeUs);
+    taskENTER_CRITICAL();
+    latency->sumOfLatencyUs += latencyUs;
+    latency->countOfLatency++;
+    latency->maxLatencyUs = USER_UTIL_MAX(latencyUs, latency->maxLatencyUs);
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Start ESC arming state machine in idle, called by motor task before output starts.
+ */
+static void DjiUser_InitEscArming(void)
+{
+    uint32_t timeMs = 0;
+
+    Osal_GetTimeMs(&timeMs);
+    EscArming_Init(&s_escArming, &s_escArmingConfig, timeMs);
+    s_escArmingReportedState = ESC_ARMING_STATE_IDLE;
+    DjiTest_WidgetSetFloatingWindowStatus(EscArming_GetStateName(ESC_ARMING_STATE_IDLE));
+}
+
+/**
+ * @brief Apply arming request from widgets and run ESC arming state machine, called by motor task every turn.
+ * @param throttle: throttle command.
+ * @param throttleMax: full throttle.
+ * @return Throttle to be output.
+ */
+static uint16_t DjiUser_ProcessEscArming(uint16_t throttle, uint16_t throttleMax)
+{
+    E_DjiUserEscArmingRequest request;
+    E_EscArmingState state;
+    uint32_t timeMs = 0;
+
+    if (HalUart_GetLastReceiveTimeMs(&timeMs) == DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        EscArming_FeedLink(&s_escArming, timeMs);
+    }
+    Osal_GetTimeMs(&timeMs);
+
+    taskENTER_CRITICAL();
+    request = s_escArmingRequest;
+    s_escArmingRequest = DJI_USER_ESC_ARMING_REQUEST_NONE;
+    taskEXIT_CRITICAL();
+
+    switch (request) {
+        case DJI_USER_ESC_ARMING_REQUEST_ARM:
+            if (!EscArming_RequestArm(&s_escArming, throttle, timeMs)) {
+                USER_LOG_WARN("Esc arming is rejected in state %s, throttle %d, throttle must be zero and link alive.",
+                              EscArming_GetStateName(s_escArming.state), throttle);
+            }
+            break;
+        case DJI_USER_ESC_ARMING_REQUEST_DISARM:
+            EscArming_RequestDisarm(&s_escArming, timeMs);
+            if (s_escArming.state == ESC_ARMING_STATE_FAULT) {
+                USER_LOG_WARN("Esc fault is not cleared, link must be alive.");
+            }
+            break;
+        case DJI_USER_ESC_ARMING_REQUEST_CALIBRATION:
+#if DJI_USE_ESC_OUTPUT
+            if (ESC_OUTPUT_MOTOR_MODE != ESC_OUTPUT_MODE_PWM) {
+                USER_LOG_WARN("Esc calibration is not needed by dshot.");
+                break;
+            }
+#endif
+            if (!EscArming_RequestCalibration(&s_escArming, timeMs)) {
+                USER_LOG_WARN("Esc calibration is rejected in state %s, motors must be disarmed and link alive.",
+                              EscArming_GetStateName(s_escArming.state));
+            }
+            break;
+        default:
+            break;
+    }
+
+    state = EscArming_Process(&s_escArming, timeMs);
+    if (state != s_escArmingReportedState) {
+        USER_LOG_INFO("Esc arming state: %s -> %s.", EscArming_GetStateName(s_escArmingReportedState),
+                      EscArming_GetStateName(state));
+        s_escArmingReportedState = state;
+        DjiTest_WidgetSetFloatingWindowStatus(EscArming_GetStateName(state));
+    }
+
+    //switch keeps showing on in fault, so that turning it off requests the disarm that clears the fault
+    DjiTest_WidgetSyncValue(DJI_WIDGET_TYPE_SWITCH, ESC_ARMING_SWITCH_WIDGET_INDEX,
+                            EscArming_IsSwitchOn(&s_escArming));
+
+    return EscArming_GetOutputThrottle(&s_escArming, throttle, throttleMax);
+}
+
+#if DJI_USE_MOTOR_CAPTURE
+/**
+ * @brief Format latest motor telemetry as text, called by data transmission task before sending.
+ * @param buffer: buffer of data to be sent.
+ * @param bufferLen: length of buffer.
+ * @return Length of data, including terminating null character.
+ */
+static uint16_t DjiUser_GetMotorTelemetryData(uint8_t *buffer, uint16_t bufferLen)
+{
+    T_MotorTelemetryValue value;
+    int len;
+
+    MotorCapture_GetTelemetry(&value);
+    len = snprintf((char *) buffer, bufferLen, "pulse %u us, period %u us, rpm %u, esc %s",
+                   value.pulseWidthUs, value.pulsePeriodUs, (unsigned int) value.rpm,
+                   EscArming_GetStateName(s_escArmingReportedState));
+    if (len < 0) {
+        return 0;
+    }
+
+    return (uint16_t) USER_UTIL_MIN((uint32_t) len + 1, bufferLen);
+}
+#endif
+
+/**
+ * @brief Report usage of memory pool classes and fragmentation of FreeRTOS heap.
+ */
+static void DjiUser_ReportMemoryState(void)
+{
+    HeapStats_t heapStats = {0};
+#if OSAL_MEM_POOL_ENABLE
+    T_OsalMemPoolClassState classState;
+    uint8_t i;
+
+    USER_LOG_DEBUG("memory pool state:");
+    USER_LOG_DEBUG("block size (byte)\tused/total\tmax used\talloc\texhausted");
+    for (i = 0; i < OSAL_MEM_POOL_CLASS_NUM; i++) {
+        if (OsalMemPool_GetClassState(i, &classState) != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+            continue;
+        }
+        USER_LOG_DEBUG("%u\t%u/%u\t%u\t%u\t%u", classState.blockSize, classState.usedBlockNum, classState.blockNum,
+                       classState.maxUsedBlockNum, classState.countOfAlloc, classState.countOfExhausted);
+    }
+    USER_LOG_DEBUG("memory pool countOfHeapAlloc %u.", OsalMemPool_GetCountOfHeapAlloc());
+#endif
+
+    vPortGetHeapStats(&heapStats);
+    USER_LOG_DEBUG("Heap state: freeBlocks %u, largestFreeBlock %u, minEverFree %u.",
+                   (unsigned int) heapStats.xNumberOfFreeBlocks,
+                   (unsigned int) heapStats.xSizeOfLargestFreeBlockInBytes,
+                   (unsigned int) heapStats.xMinimumEverFreeBytesRemaining);
+}
+
+#if DJI_USE_ESC_OUTPUT
+#ifndef __CC_ARM
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-noreturn"
+#pragma GCC diagnostic ignored "-Wreturn-type"
+#endif
+
+/**
+ * @brief Drive ESC output from throttle widget, frames are sent every ESC_OUTPUT_UPDATE_PERIOD_MS since ESCs stop
+ * motors when frames stop coming. Never returns.
+ */
+static void DjiUser_RunEscOutput(void)
+{
+    T_DjiReturnCode returnCode;
+    int32_t value = 0;
+    uint16_t throttle;
+    uint64_t changeTimeUs = 0;
+    uint64_t outputChangeTimeUs = 0;
+    bool isThrottleChanged;
+    uint8_t i;
+
+    returnCode = EscOutput_Init(&s_escOutputConfig);
+    if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        USER_LOG_ERROR("esc output init error: 0x%08llX", returnCode);
+        while (1) {
+            vTaskDelay(pdMS_TO_TICKS(MOTOR_THROTTLE_REFRESH_MS));
+        }
+    }
+
+#if DJI_USE_ESC_OUTPUT_BENCHMARK
+    DjiUser_BenchmarkEscOutput();
+#endif
+
+    while (1) {
+        //widget change wakes task early, throttle is output in the same turn
+        isThrottleChanged = DjiUser_ReceiveMotorWidget(ESC_OUTPUT_UPDATE_PERIOD_MS, &value, &changeTimeUs);
+
+        //arming runs every turn so that failsafe does not wait for a widget change
+        throttle = (uint16_t) (value * ESC_OUTPUT_THROTTLE_MAX / MOTOR_THROTTLE_WIDGET_VALUE_MAX);
+        throttle = DjiUser_ProcessEscArming(throttle, ESC_OUTPUT_THROTTLE_MAX);
+        for (i = 0; i < ESC_OUTPUT_MOTOR_NUM; i++) {
+            //failsafe stops motors at once, ramp only smooths commanded changes
+            if (s_escArmingReportedState == ESC_ARMING_STATE_FAULT) {
+                EscOutput_JumpThrottle(i, 0);
+            } else {
+                EscOutput_SetThrottle(i, throttle);
+            }
+        }
+        if (isThrottleChanged) {
+            DjiUser_UpdateThrottleLatency(&s_throttleTargetLatency, changeTimeUs);
+            if (outputChangeTimeUs == 0) {
+                outputChangeTimeUs = changeTimeUs;
+            }
+        }
+
+        //oldest change is output once a frame carrying target throttle of every channel has been started
+        if (EscOutput_Update() == DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS && outputChangeTimeUs != 0 &&
+            EscOutput_IsSettled()) {
+            DjiUser_UpdateThrottleLatency(&s_throttleOutputLatency, outputChangeTimeUs);
+            outputChangeTimeUs = 0;
+        }
+    }
+}
+
+#ifndef __CC_ARM
+#pragma GCC diagnostic pop
+#endif
+
+#if DJI_USE_ESC_OUTPUT_BENCHMARK
+/**
+ * @brief Run ESC output at a set of update rates by busy waiting, and report achieved rate and CPU load of updates.
+ * Rate 0 updates as fast as possible, so achieved rate of it is the max rate of ESC output.
+ */
+static void DjiUser_BenchmarkEscOutput(void)
+{
+    static const uint32_t s_benchmarkUpdateFreqHz[] = {500, 1000, 2000, 4000, 8000, 16000, 0};
+    T_EscOutputUpdateState startState;
+    T_EscOutputUpdateState endState;
+    uint64_t startTimeUs;
+    uint64_t nowTimeUs;
+    uint64_t nextUpdateTimeUs;
+    uint32_t periodUs;
+    uint32_t i;
+
+    USER_LOG_INFO("esc output benchmark:");
+    USER_LOG_INFO("target rate (Hz)\tachieved rate (Hz)\tbusy skip\taverage cost (ns)\tcpu load (0.01%%)");
+    for (i = 0; i < UTIL_ARRAY_SIZE(s_benchmarkUpdateFreqHz); i++) {
+        periodUs = s_benchmarkUpdateFreqHz[i] != 0 ? 1000000 / s_benchmarkUpdateFreqHz[i] : 0;
+
+        EscOutput_GetUpdateState(&startState);
+        Osal_GetTimeUs(&startTimeUs);
+        nextUpdateTimeUs = startTimeUs;
+        do {
+            Osal_GetTimeUs(&nowTimeUs);
+            if (nowTimeUs >= nextUpdateTimeUs) {
+                EscOutput_Update();
+                nextUpdateTimeUs += periodUs;
+            }
+        } while (nowTimeUs - startTimeUs < ESC_OUTPUT_BENCHMARK_DURATION_MS * 1000);
+        EscOutput_GetUpdateState(&endState);
+
+        endState.countOfUpdate -= startState.countOfUpdate;
+        endState.sumOfCostNs -= startState.sumOfCostNs;
+        USER_LOG_INFO("%d\t%d\t%d\t%d\t%d", s_benchmarkUpdateFreqHz[i],
+                      endState.countOfUpdate * 1000 / ESC_OUTPUT_BENCHMARK_DURATION_MS,
+                      endState.countOfBusySkip - startState.countOfBusySkip,
+                      endState.countOfUpdate != 0 ? (uint32_t) (endState.sumOfCostNs / endState.countOfUpdate) : 0,
+                      (uint32_t) (endState.sumOfCostNs / ((uint64_t) ESC_OUTPUT_BENCHMARK_DURATION_MS * 100)));
+    }
+}
+#endif
+#endif
+
+#if DJI_USE_CPU_LOAD_TEST
+#ifndef __CC_ARM
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-noreturn"
+#pragma GCC diagnostic ignored "-Wreturn-type"
+#endif
+
+/**
+ * @brief Keep cpu busy for CPU_LOAD_TASK_BUSY_MS in every CPU_LOAD_TASK_PERIOD_MS, only used to check how much
+ * latency of reading communication uart depends on priority of root task.
+ */
+static void *DjiUser_CpuLoadTask(void *arg)
+{
+    uint32_t startTimeMs;
+    uint32_t currentTimeMs;
+
+    USER_UTIL_UNUSED(arg);
+
+    while (1) {
+        Osal_GetTimeMs(&startTimeMs);
+        do {
+            Osal_GetTimeMs(&currentTimeMs);
+        } while (currentTimeMs - startTimeMs < CPU_LOAD_TASK_BUSY_MS);
+
+        Osal_TaskSleepMs(CPU_LOAD_TASK_PERIOD_MS - CPU_LOAD_TASK_BUSY_MS);
+    }
+}
+
+#ifndef __CC_ARM
+#pragma GCC diagnostic pop
+#endif
+#endif
+
 #ifdef __cplusplus
 }
 #endif
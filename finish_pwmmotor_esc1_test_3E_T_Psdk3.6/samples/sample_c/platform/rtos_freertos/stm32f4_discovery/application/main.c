@@ -28,16 +28,19 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "ledpwm.h"
+#include "time_base.h"
 
 /* Private constants ---------------------------------------------------------*/
+//tasks of payload sdk run at priority 1 to 3, refer to task policy in application.c
 #define USER_START_TASK_STACK_SIZE          2048
-#define USER_START_TASK_PRIORITY            0
+#define USER_START_TASK_PRIORITY            2
 #define USER_RUN_INDICATE_TASK_STACK_SIZE   256
 #define USER_RUN_INDICATE_TASK_PRIORITY     0
 
 /* My Task -------------------------------------------------------------------*/
+//motor output must not wait for logging and sdk background work
 #define USER_MOTORPWM_TASK_STACK_SIZE         256
-#define USER_MOTORPWM_TASK_PRIORITY           0
+#define USER_MOTORPWM_TASK_PRIORITY           2
 
 #define USER_LEDPWM_TASK_STACK_SIZE         256
 #define USER_LEDPWM_TASK_PRIORITY           0
@@ -73,6 +76,9 @@ int main(void)
 
     /* Configure the system clock to 168 MHz */
     SystemClock_Config();
+
+    /* Start microsecond time base, used by Osal_GetTimeUs */
+    TimeBase_Init();
    
     /* Create start task */
     xTaskCreate((TaskFunction_t) DjiUser_StartTask, "start_task", USER_START_TASK_STACK_SIZE,
@@ -16,8 +16,10 @@
   */ 
   
 #include "bsp_debug_usart.h"
+#include "tts_output.h"
 
 UART_HandleTypeDef UartHandle;
+static DMA_HandleTypeDef s_debugUsartTxDmaHandle;
 //extern uint8_t ucTemp;  
 
  /**
@@ -27,7 +29,7 @@ UART_HandleTypeDef UartHandle;
   */  
 void DEBUG_USART_Config(void)
 { 
-  HAL_UART4_MspInit(UartHandle);
+  HAL_UART4_MspInit(&UartHandle);
 	
 	
   UartHandle.Instance          = DEBUG_USART;
@@ -43,6 +45,27 @@ void DEBUG_USART_Config(void)
     
  /*ʹܴڽն */
   __HAL_UART_ENABLE_IT(&UartHandle,UART_IT_RXNE);  
+
+  /* transmit DMA is started per frame by Usart_SendStringDma, only its complete interrupt is used */
+  DEBUG_USART_TX_DMA_CLK_ENABLE();
+  s_debugUsartTxDmaHandle.Instance = DEBUG_USART_TX_DMA_STREAM;
+  s_debugUsartTxDmaHandle.Init.Channel = DEBUG_USART_TX_DMA_CHANNEL;
+  s_debugUsartTxDmaHandle.Init.Direction = DMA_MEMORY_TO_PERIPH;
+  s_debugUsartTxDmaHandle.Init.PeriphInc = DMA_PINC_DISABLE;
+  s_debugUsartTxDmaHandle.Init.MemInc = DMA_MINC_ENABLE;
+  s_debugUsartTxDmaHandle.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+  s_debugUsartTxDmaHandle.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+  s_debugUsartTxDmaHandle.Init.Mode = DMA_NORMAL;
+  s_debugUsartTxDmaHandle.Init.Priority = DMA_PRIORITY_LOW;
+  s_debugUsartTxDmaHandle.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+  HAL_DMA_Init(&s_debugUsartTxDmaHandle);
+  __HAL_LINKDMA(&UartHandle, hdmatx, s_debugUsartTxDmaHandle);
+
+  s_debugUsartTxDmaHandle.Instance->PAR = (uint32_t) &UartHandle.Instance->DR;
+  __HAL_DMA_ENABLE_IT(&s_debugUsartTxDmaHandle, DMA_IT_TC);
+  HAL_NVIC_SetPriority(DEBUG_USART_TX_DMA_IRQn, DEBUG_USART_IRQ_PRIO_PRE, DEBUG_USART_IRQ_PRIO_SUB);
+  HAL_NVIC_EnableIRQ(DEBUG_USART_TX_DMA_IRQn);
+  SET_BIT(UartHandle.Instance->CR3, USART_CR3_DMAT);
 	
 	
 }
@@ -79,7 +102,7 @@ void HAL_UART4_MspInit(UART_HandleTypeDef *huart)
   GPIO_InitStruct.Alternate = DEBUG_USART_RX_AF;
   HAL_GPIO_Init(DEBUG_USART_RX_GPIO_PORT, &GPIO_InitStruct); 
  
-  HAL_NVIC_SetPriority(DEBUG_USART_IRQ ,0,1);	//ռȼ0ȼ1
+  HAL_NVIC_SetPriority(DEBUG_USART_IRQ ,DEBUG_USART_IRQ_PRIO_PRE,DEBUG_USART_IRQ_PRIO_SUB);	//preempt priority 5, sub priority 1, see DEBUG_USART_IRQ_PRIO_PRE/_SUB
   HAL_NVIC_EnableIRQ(DEBUG_USART_IRQ );		    //ʹUSART1жͨ  
 }
 
@@ -95,6 +118,53 @@ void Usart_SendString(uint8_t *str,uint8_t size)
   } while(k < size);
   
 }
+/**
+  * @brief  Start DMA transmission of a frame and return at once, end of transmission is reported to
+  *         TtsOutput_TransmitCompleteFromIsr. A transmission still running is cut off.
+  * @note   Stream leaves enable state once the byte in flight is written, wait for it is bounded by
+  *         DEBUG_USART_TX_DMA_DISABLE_WAIT_NUM. If stream is still enabled then, frame is not sent and no
+  *         completion is reported, transmit timeout of tts_output.c recovers the link.
+  * @param  str: frame, must stay valid until transmission completes.
+  * @param  size: length of frame, unit: byte.
+  * @retval None
+  */
+void Usart_SendStringDma(const uint8_t *str, uint16_t size)
+{
+  uint32_t waitNum = 0;
+
+  __HAL_DMA_DISABLE(&s_debugUsartTxDmaHandle);
+  while ((s_debugUsartTxDmaHandle.Instance->CR & DMA_SxCR_EN) != 0) {
+    if (++waitNum >= DEBUG_USART_TX_DMA_DISABLE_WAIT_NUM) {
+      return;
+    }
+  }
+
+  __HAL_DMA_CLEAR_FLAG(&s_debugUsartTxDmaHandle, __HAL_DMA_GET_TC_FLAG_INDEX(&s_debugUsartTxDmaHandle) |
+                                                 __HAL_DMA_GET_HT_FLAG_INDEX(&s_debugUsartTxDmaHandle) |
+                                                 __HAL_DMA_GET_TE_FLAG_INDEX(&s_debugUsartTxDmaHandle) |
+                                                 __HAL_DMA_GET_DME_FLAG_INDEX(&s_debugUsartTxDmaHandle) |
+                                                 __HAL_DMA_GET_FE_FLAG_INDEX(&s_debugUsartTxDmaHandle));
+  s_debugUsartTxDmaHandle.Instance->M0AR = (uint32_t) str;
+  s_debugUsartTxDmaHandle.Instance->NDTR = size;
+  __HAL_DMA_ENABLE(&s_debugUsartTxDmaHandle);
+}
+
+/**
+  * @brief  Interrupt of transmit DMA stream.
+  * @note   Complete flag is raised when last byte is written to data register, about one byte time before it
+  *         leaves the line, which is negligible against response time of speech module.
+  * @retval None
+  */
+void DEBUG_USART_TX_DMA_IRQHandler(void)
+{
+  if (__HAL_DMA_GET_FLAG(&s_debugUsartTxDmaHandle, __HAL_DMA_GET_TC_FLAG_INDEX(&s_debugUsartTxDmaHandle)) == RESET) {
+    return;
+  }
+  __HAL_DMA_CLEAR_FLAG(&s_debugUsartTxDmaHandle, __HAL_DMA_GET_TC_FLAG_INDEX(&s_debugUsartTxDmaHandle));
+
+  TtsOutput_TransmitCompleteFromIsr();
+}
+
 ///ضc⺯printfDEBUG_USARTضʹprintf
 int fputc1(int ch, FILE *f)
 {
@@ -27,10 +27,24 @@
 
 #define DEBUG_USART_IRQHandler                  UART4_IRQHandler
 #define DEBUG_USART_IRQ                 		    UART4_IRQn
+
+//status bytes of speech module are reported to tts_output.c from interrupts, so priority must be a FreeRTOS one
+#define DEBUG_USART_IRQ_PRIO_PRE                5
+#define DEBUG_USART_IRQ_PRIO_SUB                1
+
+#define DEBUG_USART_TX_DMA_CLK_ENABLE()         __HAL_RCC_DMA1_CLK_ENABLE()
+#define DEBUG_USART_TX_DMA_STREAM               DMA1_Stream4
+#define DEBUG_USART_TX_DMA_CHANNEL              DMA_CHANNEL_4
+#define DEBUG_USART_TX_DMA_IRQn                 DMA1_Stream4_IRQn
+#define DEBUG_USART_TX_DMA_IRQHandler           DMA1_Stream4_IRQHandler
+//disabling a stream ends after the single transfer in flight, a few bus cycles, bound is far beyond that
+#define DEBUG_USART_TX_DMA_DISABLE_WAIT_NUM     1000
 /************************************************************/
 
 void Usart_SendString(uint8_t *str,uint8_t size);
+void Usart_SendStringDma(const uint8_t *str, uint16_t size);
 void DEBUG_USART_Config(void);
+void HAL_UART4_MspInit(UART_HandleTypeDef *huart);
 //int fputc(int ch, FILE *f);
 extern UART_HandleTypeDef UartHandle;
 #endif /* __USART1_H */
@@ -0,0 +1,384 @@
+/**
+ ******************************************************************************
+ * @file    dji_mp_ringbuffer.c
+ * @version V1.0.0
+ * @date    2026/10/16
+ * @brief   The file defines lock free multi-producer ring buffer related functions, including initialize,
+ *           put data to buffer, get data from buffer, get unused count of bytes of buffer, and peek and consume
+ *           data in place.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "dji_mp_ringbuffer.h"
+#include <string.h>
+#include <stdbool.h>
+
+#if defined(__CC_ARM) || defined(__arm__)
+#include "cmsis_compiler.h"
+#endif
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+#define MP_RINGBUF_MIN(a, b) (((a)<(b))?(a):(b))
+
+/* Private variables ---------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief Cut buffer size to power of 2, in order to increase the convenience of get and put operating of buffer.
+ * @param bufSize Original buffer size.
+ * @return Buffer size after handling.
+ */
+static uint32_t MpRingBuf_CutBufSizeToPowOfTwo(uint32_t bufSize)
+{
+    uint32_t i = 0;
+
+    while (i < 31 && ((uint32_t) 1 << (i + 1)) <= bufSize) {
+        i++;
+    }
+    return (uint32_t) 1 << i;
+}
+
+#if defined(__CC_ARM) || defined(__arm__)
+
+/**
+ * @brief Reserve space by moving reserve index forward with LDREX/STREX.
+ * @param pthis Pointer to ring buffer structure.
+ * @param dataLen Length of space wanted.
+ * @param reserveIndex Start index of reserved space.
+ * @return Length of space reserved actually.
+ */
+static uint32_t MpRingBuf_Reserve(T_MpRingBuffer *pthis, uint32_t dataLen, uint32_t *reserveIndex)
+{
+    uint32_t reserveLen;
+    uint32_t releaseIndex;
+
+    do {
+        *reserveIndex = __LDREXW(&pthis->reserveIndex);
+        //release index must be sampled once, consumer may move it at any time
+        releaseIndex = pthis->releaseIndex;
+        reserveLen = MP_RINGBUF_MIN(dataLen, pthis->bufferSize - (*reserveIndex - releaseIndex));
+        if (reserveLen == 0) {
+            __CLREX();
+            return 0;
+        }
+    } while (__STREXW(*reserveIndex + reserveLen, &pthis->reserveIndex) != 0);
+
+    //consumer must be done with the space before it is overwritten
+    __DMB();
+
+    return reserveLen;
+}
+
+/**
+ * @brief Add length of data written in a slot to its commit count.
+ * @param commitCount Pointer to commit count of slot.
+ * @param dataLen Length of data written in slot.
+ * @return None.
+ */
+static void MpRingBuf_AddCommitCount(volatile uint32_t *commitCount, uint32_t dataLen)
+{
+    uint32_t count;
+
+    //data copy must be visible before commit count
+    __DMB();
+    do {
+        count = __LDREXW(commitCount);
+    } while (__STREXW(count + dataLen, commitCount) != 0);
+}
+
+/**
+ * @brief Read an index or count published by the other side, later reads must not pass it.
+ * @param value Pointer to value.
+ * @return Value read.
+ */
+static uint32_t MpRingBuf_LoadAcquire(volatile uint32_t *value)
+{
+    uint32_t result = *value;
+
+    __DMB();
+
+    return result;
+}
+
+/**
+ * @brief Publish an index to the other side, earlier accesses must be complete before it.
+ * @param value Pointer to value.
+ * @param newValue Value to be stored.
+ * @return None.
+ */
+static void MpRingBuf_StoreRelease(volatile uint32_t *value, uint32_t newValue)
+{
+    __DMB();
+    *value = newValue;
+}
+
+#else
+
+static uint32_t MpRingBuf_Reserve(T_MpRingBuffer *pthis, uint32_t dataLen, uint32_t *reserveIndex)
+{
+    uint32_t reserveLen;
+    uint32_t releaseIndex;
+
+    *reserveIndex = __atomic_load_n(&pthis->reserveIndex, __ATOMIC_RELAXED);
+    do {
+        releaseIndex = __atomic_load_n(&pthis->releaseIndex, __ATOMIC_ACQUIRE);
+        reserveLen = MP_RINGBUF_MIN(dataLen, pthis->bufferSize - (*reserveIndex - releaseIndex));
+        if (reserveLen == 0) {
+            return 0;
+        }
+    } while (!__atomic_compare_exchange_n(&pthis->reserveIndex, reserveIndex, *reserveIndex + reserveLen, true,
+                                          __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+
+    return reserveLen;
+}
+
+static void MpRingBuf_AddCommitCount(volatile uint32_t *commitCount, uint32_t dataLen)
+{
+    __atomic_fetch_add(commitCount, dataLen, __ATOMIC_RELEASE);
+}
+
+static uint32_t MpRingBuf_LoadAcquire(volatile uint32_t *value)
+{
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+}
+
+static void MpRingBuf_StoreRelease(volatile uint32_t *value, uint32_t newValue)
+{
+    __atomic_store_n(value, newValue, __ATOMIC_RELEASE);
+}
+
+#endif
+
+/**
+ * @brief Get commit count of the slot an index falls in.
+ * @param pthis Pointer to ring buffer structure.
+ * @param index Index of ring buffer.
+ * @return Pointer to commit count of slot.
+ */
+static volatile uint32_t *MpRingBuf_GetSlotCommitCount(T_MpRingBuffer *pthis, uint32_t index)
+{
+    return &pthis->slotCommitCount[(index & (pthis->bufferSize - 1)) / pthis->slotSize];
+}
+
+/**
+ * @brief Publish data written to reserved space by adding its length to commit count of every slot it covers.
+ * @param pthis Pointer to ring buffer structure.
+ * @param reserveIndex Start index of reserved space.
+ * @param dataLen Length of data written.
+ * @return None.
+ */
+static void MpRingBuf_Publish(T_MpRingBuffer *pthis, uint32_t reserveIndex, uint32_t dataLen)
+{
+    uint32_t slotLen;
+
+    while (dataLen > 0) {
+        slotLen = MP_RINGBUF_MIN(dataLen, pthis->slotSize - (reserveIndex & (pthis->slotSize - 1)));
+        MpRingBuf_AddCommitCount(MpRingBuf_GetSlotCommitCount(pthis, reserveIndex), slotLen);
+        reserveIndex += slotLen;
+        dataLen -= slotLen;
+    }
+}
+
+/**
+ * @brief Get length of data consumer may read, from read index up to the first slot with data not committed yet.
+ * @param pthis Pointer to ring buffer structure.
+ * @return Length of data visible to consumer.
+ */
+static uint32_t MpRingBuf_GetVisibleLen(T_MpRingBuffer *pthis)
+{
+    uint32_t readIndex = pthis->readIndex;
+    uint32_t visibleIndex = readIndex;
+    uint32_t slotStart;
+    uint32_t reserveIndex;
+    uint32_t reservedLen;
+    uint32_t commitCount;
+    uint32_t i;
+
+    //reserved data never spans more than every slot plus the part of the slot read index is in
+    for (i = 0; i <= pthis->slotNum; i++) {
+        slotStart = visibleIndex & ~(pthis->slotSize - 1);
+        //commit count must be read before reserve index, every committed byte was reserved before it was counted
+        commitCount = MpRingBuf_LoadAcquire(MpRingBuf_GetSlotCommitCount(pthis, slotStart));
+        reserveIndex = MpRingBuf_LoadAcquire(&pthis->reserveIndex);
+        reservedLen = MP_RINGBUF_MIN(reserveIndex - slotStart, pthis->slotSize);
+        if (commitCount != reservedLen) {
+            break;
+        }
+        visibleIndex = slotStart + reservedLen;
+        if (reservedLen < pthis->slotSize) {
+            break;
+        }
+    }
+
+    return visibleIndex - readIndex;
+}
+
+/**
+ * @brief Release space read by consumer, slots passed completely are cleared before producers may reuse them.
+ * @param pthis Pointer to ring buffer structure.
+ * @param dataLen Length of data read.
+ * @return None.
+ */
+static void MpRingBuf_Release(T_MpRingBuffer *pthis, uint32_t dataLen)
+{
+    uint32_t readIndex = pthis->readIndex + dataLen;
+    uint32_t slotStart = pthis->readIndex & ~(pthis->slotSize - 1);
+
+    while (readIndex - slotStart >= pthis->slotSize) {
+        *MpRingBuf_GetSlotCommitCount(pthis, slotStart) = 0;
+        slotStart += pthis->slotSize;
+    }
+
+    pthis->readIndex = readIndex;
+    MpRingBuf_StoreRelease(&pthis->releaseIndex, slotStart);
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief Ring buffer initialization.
+ * @param pthis Pointer to ring buffer structure.
+ * @param pBuf Pointer to data buffer.
+ * @param bufSize Size of data buffer.
+ * @return None.
+ */
+void MpRingBuf_Init(T_MpRingBuffer *pthis, uint8_t *pBuf, uint32_t bufSize)
+{
+    uint32_t i;
+
+    pthis->readIndex = 0;
+    pthis->releaseIndex = 0;
+    pthis->reserveIndex = 0;
+    pthis->bufferPtr = pBuf;
+    pthis->bufferSize = MpRingBuf_CutBufSizeToPowOfTwo(bufSize);
+    pthis->slotSize = pthis->bufferSize > MP_RINGBUF_SLOT_NUM_MAX ? pthis->bufferSize / MP_RINGBUF_SLOT_NUM_MAX : 1;
+    pthis->slotNum = pthis->bufferSize / pthis->slotSize;
+
+    for (i = 0; i < MP_RINGBUF_SLOT_NUM_MAX; i++) {
+        pthis->slotCommitCount[i] = 0;
+    }
+}
+
+/**
+ * @brief Put a block of data into ring buffer, may be called by several producers concurrently.
+ * @param pthis Pointer to ring buffer structure.
+ * @param pData Pointer to data to be stored.
+ * @param dataLen Length of data to be stored.
+ * @return Length of data to be stored.
+ */
+uint32_t MpRingBuf_Put(T_MpRingBuffer *pthis, const uint8_t *pData, uint32_t dataLen)
+{
+    uint32_t reserveIndex;
+    uint32_t writeUpLen;
+
+    dataLen = MpRingBuf_Reserve(pthis, dataLen, &reserveIndex);
+    if (dataLen == 0) {
+        return 0;
+    }
+
+    //fill up data
+    writeUpLen = MP_RINGBUF_MIN(dataLen, pthis->bufferSize - (reserveIndex & (pthis->bufferSize - 1)));
+    memcpy(pthis->bufferPtr + (reserveIndex & (pthis->bufferSize - 1)), pData, writeUpLen);
+
+    //fill begin data
+    memcpy(pthis->bufferPtr, pData + writeUpLen, dataLen - writeUpLen);
+
+    MpRingBuf_Publish(pthis, reserveIndex, dataLen);
+
+    return dataLen;
+}
+
+/**
+ * @brief Get a block of data from ring buffer, must be called by one consumer only.
+ * @param pthis Pointer to ring buffer structure.
+ * @param pData Pointer to data to be read.
+ * @param dataLen Length of data to be read.
+ * @return Length of data to be read.
+ */
+uint32_t MpRingBuf_Get(T_MpRingBuffer *pthis, uint8_t *pData, uint32_t dataLen)
+{
+    uint32_t readIndex = pthis->readIndex;
+    uint32_t readUpLen;
+
+    dataLen = MP_RINGBUF_MIN(dataLen, MpRingBuf_GetVisibleLen(pthis));
+
+    //get up data
+    readUpLen = MP_RINGBUF_MIN(dataLen, pthis->bufferSize - (readIndex & (pthis->bufferSize - 1)));
+    memcpy(pData, pthis->bufferPtr + (readIndex & (pthis->bufferSize - 1)), readUpLen);
+
+    //get begin data
+    memcpy(pData + readUpLen, pthis->bufferPtr, dataLen - readUpLen);
+
+    MpRingBuf_Release(pthis, dataLen);
+
+    return dataLen;
+}
+
+/**
+ * @brief Get unused size of ring buffer.
+ * @param pthis Pointer to ring buffer structure.
+ * @return Unused size of ring buffer.
+ */
+uint32_t MpRingBuf_GetUnusedSize(T_MpRingBuffer *pthis)
+{
+    return pthis->bufferSize - (pthis->reserveIndex - pthis->releaseIndex);
+}
+
+/**
+ * @brief Expose data committed to ring buffer without copying it out, must be called by one consumer only,
+ *        data is released by MpRingBuf_Consume().
+ * @param pthis Pointer to ring buffer structure.
+ * @param spans Two spans filled with committed data in order, second span is empty if data does not wrap.
+ * @return Total length of data exposed by spans.
+ */
+uint32_t MpRingBuf_PeekSpans(T_MpRingBuffer *pthis, T_MpRingBufSpan spans[2])
+{
+    uint32_t dataLen;
+    uint32_t readOffset;
+
+    dataLen = MpRingBuf_GetVisibleLen(pthis);
+    readOffset = pthis->readIndex & (pthis->bufferSize - 1);
+
+    spans[0].dataPtr = pthis->bufferPtr + readOffset;
+    spans[0].dataLen = MP_RINGBUF_MIN(dataLen, pthis->bufferSize - readOffset);
+    spans[1].dataPtr = pthis->bufferPtr;
+    spans[1].dataLen = dataLen - spans[0].dataLen;
+
+    return dataLen;
+}
+
+/**
+ * @brief Release data of ring buffer that have been handled in place, must be called by one consumer only.
+ * @param pthis Pointer to ring buffer structure.
+ * @param dataLen Length of data to be released.
+ * @return Length of data released actually.
+ */
+uint32_t MpRingBuf_Consume(T_MpRingBuffer *pthis, uint32_t dataLen)
+{
+    dataLen = MP_RINGBUF_MIN(dataLen, MpRingBuf_GetVisibleLen(pthis));
+    MpRingBuf_Release(pthis, dataLen);
+
+    return dataLen;
+}
@@ -0,0 +1,83 @@
+/**
+ ******************************************************************************
+ * @file    dji_mp_ringbuffer.h
+ * @version V1.0.0
+ * @date    2026/10/16
+ * @brief   This is the header file for "dji_mp_ringbuffer.c".
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef _DJI_MP_RING_BUFFER_H_
+#define _DJI_MP_RING_BUFFER_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+//commits are tracked per slot, buffer is split into at most this many slots of equal power of 2 size
+#define MP_RINGBUF_SLOT_NUM_MAX     32
+
+/* Exported macros -----------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+
+//Note: lock free for multi-producer / one consumer, need mutex to protect for multi-consumer.
+//Producers reserve space with an atomic compare-and-swap on reserveIndex, copy their data and then add its
+//length to the commit count of every slot it covers. Consumer reads on from readIndex through every slot whose
+//commit count has caught up with the space reserved in it, so data of a producer preempted in the middle of
+//copying is never exposed and only holds back the slots after its own, not the whole buffer.
+//Producers may reuse space once consumer passed the end of its slot, so up to a slot less than the whole buffer
+//may be free for them.
+
+typedef struct _mpRingBuffer {
+    uint8_t *bufferPtr;
+    uint32_t bufferSize;
+    uint32_t slotSize;
+    uint32_t slotNum;
+
+    volatile uint32_t readIndex;
+    volatile uint32_t releaseIndex;
+    volatile uint32_t reserveIndex;
+    volatile uint32_t slotCommitCount[MP_RINGBUF_SLOT_NUM_MAX];
+} T_MpRingBuffer;
+
+//contiguous region of ring buffer memory, data may wrap so up to two spans describe it
+typedef struct {
+    uint8_t *dataPtr;
+    uint32_t dataLen;
+} T_MpRingBufSpan;
+
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+void MpRingBuf_Init(T_MpRingBuffer *pthis, uint8_t *pBuf, uint32_t bufSize);
+uint32_t MpRingBuf_Put(T_MpRingBuffer *pthis, const uint8_t *pData, uint32_t dataLen);
+uint32_t MpRingBuf_Get(T_MpRingBuffer *pthis, uint8_t *pData, uint32_t dataLen);
+uint32_t MpRingBuf_GetUnusedSize(T_MpRingBuffer *pthis);
+uint32_t MpRingBuf_PeekSpans(T_MpRingBuffer *pthis, T_MpRingBufSpan spans[2]);
+uint32_t MpRingBuf_Consume(T_MpRingBuffer *pthis, uint32_t dataLen);
+
+/* Private constants ---------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+/* Private types -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+
+#endif
@@ -128,3 +128,75 @@ uint16_t RingBuf_GetUnusedSize(T_RingBuffer *pthis)
 {
     return (uint16_t) (pthis->bufferSize - pthis->writeIndex + pthis->readIndex);
 }
+
+/**
+ * @brief Expose data stored in ring buffer without copying it out, data is released by RingBuf_Consume().
+ * @param pthis Pointer to ring buffer structure.
+ * @param spans Two spans filled with stored data in order, second span is empty if data does not wrap.
+ * @return Total length of data exposed by spans.
+ */
+uint16_t RingBuf_PeekSpans(T_RingBuffer *pthis, T_RingBufSpan spans[2])
+{
+    uint16_t dataLen;
+    uint16_t readOffset;
+
+    dataLen = (uint16_t) (pthis->writeIndex - pthis->readIndex);
+    readOffset = pthis->readIndex & (pthis->bufferSize - 1);
+
+    spans[0].dataPtr = pthis->bufferPtr + readOffset;
+    spans[0].dataLen = RINGBUF_MIN(dataLen, (uint16_t) (pthis->bufferSize - readOffset));
+    spans[1].dataPtr = pthis->bufferPtr;
+    spans[1].dataLen = dataLen - spans[0].dataLen;
+
+    return dataLen;
+}
+
+/**
+ * @brief Release data of ring buffer that have been handled in place.
+ * @param pthis Pointer to ring buffer structure.
+ * @param dataLen Length of data to be released.
+ * @return Length of data released actually.
+ */
+uint16_t RingBuf_Consume(T_RingBuffer *pthis, uint16_t dataLen)
+{
+    dataLen = RINGBUF_MIN(dataLen, (uint16_t) (pthis->writeIndex - pthis->readIndex));
+    pthis->readIndex += dataLen;
+
+    return dataLen;
+}
+
+/**
+ * @brief Expose unused space of ring buffer to be filled in place, data is published by RingBuf_Commit().
+ * @param pthis Pointer to ring buffer structure.
+ * @param spans Two spans filled with unused space in order, second span is empty if space does not wrap.
+ * @return Total length of space exposed by spans.
+ */
+uint16_t RingBuf_ReserveSpans(T_RingBuffer *pthis, T_RingBufSpan spans[2])
+{
+    uint16_t spaceLen;
+    uint16_t writeOffset;
+
+    spaceLen = RingBuf_GetUnusedSize(pthis);
+    writeOffset = pthis->writeIndex & (pthis->bufferSize - 1);
+
+    spans[0].dataPtr = pthis->bufferPtr + writeOffset;
+    spans[0].dataLen = RINGBUF_MIN(spaceLen, (uint16_t) (pthis->bufferSize - writeOffset));
+    spans[1].dataPtr = pthis->bufferPtr;
+    spans[1].dataLen = spaceLen - spans[0].dataLen;
+
+    return spaceLen;
+}
+
+/**
+ * @brief Publish data that have been written in place to reserved space of ring buffer.
+ * @param pthis Pointer to ring buffer structure.
+ * @param dataLen Length of data to be published.
+ * @return Length of data published actually.
+ */
+uint16_t RingBuf_Commit(T_RingBuffer *pthis, uint16_t dataLen)
+{
+    dataLen = RINGBUF_MIN(dataLen, RingBuf_GetUnusedSize(pthis));
+    pthis->writeIndex += dataLen;
+
+    return dataLen;
+}
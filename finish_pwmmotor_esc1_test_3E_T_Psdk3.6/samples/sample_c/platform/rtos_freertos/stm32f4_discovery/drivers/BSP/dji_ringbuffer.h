@@ -46,6 +46,12 @@ typedef struct _ringBuffer {
     uint16_t writeIndex;
 } T_RingBuffer;
 
+//contiguous region of ring buffer memory, data may wrap so up to two spans describe it
+typedef struct {
+    uint8_t *dataPtr;
+    uint16_t dataLen;
+} T_RingBufSpan;
+
 /* Exported variables --------------------------------------------------------*/
 /* Exported functions --------------------------------------------------------*/
 
@@ -53,6 +59,10 @@ void RingBuf_Init(T_RingBuffer *pthis, uint8_t *pBuf, uint16_t bufSize);
 uint16_t RingBuf_Put(T_RingBuffer *pthis, const uint8_t *pData, uint16_t dataLen);
 uint16_t RingBuf_Get(T_RingBuffer *pthis, uint8_t *pData, uint16_t dataLen);
 uint16_t RingBuf_GetUnusedSize(T_RingBuffer *pthis);
+uint16_t RingBuf_PeekSpans(T_RingBuffer *pthis, T_RingBufSpan spans[2]);
+uint16_t RingBuf_Consume(T_RingBuffer *pthis, uint16_t dataLen);
+uint16_t RingBuf_ReserveSpans(T_RingBuffer *pthis, T_RingBufSpan spans[2]);
+uint16_t RingBuf_Commit(T_RingBuffer *pthis, uint16_t dataLen);
 
 /* Private constants ---------------------------------------------------------*/
 /* Private macros ------------------------------------------------------------*/
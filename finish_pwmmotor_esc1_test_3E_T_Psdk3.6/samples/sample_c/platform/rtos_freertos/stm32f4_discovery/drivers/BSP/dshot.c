@@ -0,0 +1,140 @@
+/**
+ ********************************************************************
+ * @file    dshot.c
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   DShot digital ESC protocol, frame encoding and compare value buffer for timer
+ * burst DMA. Hardware independent, timer and DMA are driven by esc_output.c.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "dshot.h"
+
+/* Private constants ---------------------------------------------------------*/
+//minimal timer counts of a bit that keep bit 0 and bit 1 apart by more than one count
+#define DSHOT_BIT_PERIOD_COUNT_MIN      16
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private values -------------------------------------------------------------*/
+static const uint32_t s_dshotBitRate[] = {
+    [DSHOT_SPEED_150] = 150000,
+    [DSHOT_SPEED_300] = 300000,
+    [DSHOT_SPEED_600] = 600000,
+};
+
+/* Private functions declaration ---------------------------------------------*/
+
+/* Exported functions definition ---------------------------------------------*/
+/**
+ * @brief Encode a DShot frame, 11 bits value, 1 bit telemetry request and 4 bits checksum, MSB first.
+ * @param value: throttle or command value, refer to DSHOT_VALUE_MAX.
+ * @param telemetryRequest: ask ESC to send telemetry back.
+ * @return Frame.
+ */
+uint16_t Dshot_EncodeFrame(uint16_t value, bool telemetryRequest)
+{
+    uint16_t packet;
+    uint16_t checksum;
+
+    packet = (uint16_t) (((value & DSHOT_VALUE_MAX) << 1) | (telemetryRequest ? 1 : 0));
+    checksum = (packet ^ (packet >> 4) ^ (packet >> 8)) & 0x0F;
+
+    return (uint16_t) ((packet << 4) | checksum);
+}
+
+/**
+ * @brief Map throttle to DShot throttle value, throttle 0 stops motor.
+ * @param throttle: throttle, 0 to throttleMax.
+ * @param throttleMax: full throttle.
+ * @return DShot value, 0 or 48 to 2047.
+ */
+uint16_t Dshot_ThrottleToValue(uint16_t throttle, uint16_t throttleMax)
+{
+    if (throttle == 0 || throttleMax == 0) {
+        return 0;
+    }
+    if (throttle >= throttleMax) {
+        return DSHOT_VALUE_MAX;
+    }
+
+    return (uint16_t) (DSHOT_THROTTLE_VALUE_MIN +
+                       (uint32_t) (throttle - 1) * (DSHOT_VALUE_MAX - DSHOT_THROTTLE_VALUE_MIN) / (throttleMax - 1));
+}
+
+/**
+ * @brief Get timer counts of a DShot bit, timer counts at timerClockHz without prescaler.
+ * @param speed: DShot speed.
+ * @param timerClockHz: counter clock of timer.
+ * @param timing: pointer to timing.
+ * @return True if timer can generate the speed, false if bit period does not fit 16 bits counter or is too short.
+ */
+bool Dshot_GetTiming(E_DshotSpeed speed, uint32_t timerClockHz, T_DshotTiming *timing)
+{
+    uint32_t bitPeriodCount;
+
+    if ((uint32_t) speed >= sizeof(s_dshotBitRate) / sizeof(s_dshotBitRate[0])) {
+        return false;
+    }
+
+    bitPeriodCount = (timerClockHz + s_dshotBitRate[speed] / 2) / s_dshotBitRate[speed];
+    if (bitPeriodCount < DSHOT_BIT_PERIOD_COUNT_MIN || bitPeriodCount > 0xFFFF) {
+        return false;
+    }
+
+    timing->bitPeriodCount = (uint16_t) bitPeriodCount;
+    timing->bit0HighCount = (uint16_t) ((bitPeriodCount * 3 + 4) / 8);
+    timing->bit1HighCount = (uint16_t) ((bitPeriodCount * 3 + 2) / 4);
+
+    return true;
+}
+
+/**
+ * @brief Fill compare values of frames into buffer, in order of timer burst DMA, that is compare values of all
+ * channels for first bit, then all channels for second bit and so on. Reset slots at end hold line low.
+ * @param buffer: buffer of DSHOT_FRAME_SLOT_NUM * channelNum words.
+ * @param frames: frame of every channel.
+ * @param channelNum: count of channels, same as burst length of DMA.
+ * @param timing: pointer to timing.
+ * @return None.
+ */
+void Dshot_FillBurstBuffer(uint32_t *buffer, const uint16_t *frames, uint8_t channelNum,
+                           const T_DshotTiming *timing)
+{
+    uint32_t bit0HighCount = timing->bit0HighCount;
+    uint32_t bit1HighCount = timing->bit1HighCount;
+    uint16_t mask;
+    uint8_t i;
+
+    for (mask = 1U << (DSHOT_FRAME_BIT_NUM - 1); mask != 0; mask >>= 1) {
+        for (i = 0; i < channelNum; i++) {
+            *buffer++ = (frames[i] & mask) != 0 ? bit1HighCount : bit0HighCount;
+        }
+    }
+
+    for (i = 0; i < DSHOT_FRAME_RESET_SLOT_NUM * channelNum; i++) {
+        *buffer++ = 0;
+    }
+}
+
+/* Private functions definition-----------------------------------------------*/
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
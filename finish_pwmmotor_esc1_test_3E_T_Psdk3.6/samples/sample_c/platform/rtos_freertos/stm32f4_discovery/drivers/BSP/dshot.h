@@ -0,0 +1,93 @@
+/**
+ ********************************************************************
+ * @file    dshot.h
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   This is the header file for "dshot.c", defining the structure and
+ * (exported) function prototypes.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef DSHOT_H
+#define DSHOT_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Exported constants --------------------------------------------------------*/
+#define DSHOT_FRAME_BIT_NUM             16
+//line is held low for some bit periods after a frame, so that ESC can tell consecutive frames apart
+#define DSHOT_FRAME_RESET_SLOT_NUM      2
+#define DSHOT_FRAME_SLOT_NUM            (DSHOT_FRAME_BIT_NUM + DSHOT_FRAME_RESET_SLOT_NUM)
+
+//value 0 stops motor, 1 to 47 are commands, 48 to 2047 are throttle
+#define DSHOT_VALUE_MAX                 2047
+#define DSHOT_THROTTLE_VALUE_MIN        48
+#define DSHOT_COMMAND_MAX               47
+
+/* Exported types ------------------------------------------------------------*/
+typedef enum {
+    DSHOT_SPEED_150 = 0,
+    DSHOT_SPEED_300,
+    DSHOT_SPEED_600,
+} E_DshotSpeed;
+
+typedef enum {
+    DSHOT_COMMAND_MOTOR_STOP = 0,
+    DSHOT_COMMAND_BEEP1 = 1,
+    DSHOT_COMMAND_BEEP2 = 2,
+    DSHOT_COMMAND_BEEP3 = 3,
+    DSHOT_COMMAND_BEEP4 = 4,
+    DSHOT_COMMAND_BEEP5 = 5,
+    DSHOT_COMMAND_ESC_INFO = 6,
+    DSHOT_COMMAND_SPIN_DIRECTION_1 = 7,
+    DSHOT_COMMAND_SPIN_DIRECTION_2 = 8,
+    DSHOT_COMMAND_3D_MODE_OFF = 9,
+    DSHOT_COMMAND_3D_MODE_ON = 10,
+    DSHOT_COMMAND_SAVE_SETTINGS = 12,
+    DSHOT_COMMAND_SPIN_DIRECTION_NORMAL = 20,
+    DSHOT_COMMAND_SPIN_DIRECTION_REVERSED = 21,
+} E_DshotCommand;
+
+typedef struct {
+    uint16_t bitPeriodCount; /*!< Timer counts of a bit, auto-reload value is one less. */
+    uint16_t bit0HighCount; /*!< Compare value of bit 0, high for 3/8 of bit period. */
+    uint16_t bit1HighCount; /*!< Compare value of bit 1, high for 3/4 of bit period. */
+} T_DshotTiming;
+
+/* Exported functions --------------------------------------------------------*/
+uint16_t Dshot_EncodeFrame(uint16_t value, bool telemetryRequest);
+uint16_t Dshot_ThrottleToValue(uint16_t throttle, uint16_t throttleMax);
+bool Dshot_GetTiming(E_DshotSpeed speed, uint32_t timerClockHz, T_DshotTiming *timing);
+void Dshot_FillBurstBuffer(uint32_t *buffer, const uint16_t *frames, uint8_t channelNum,
+                           const T_DshotTiming *timing);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DSHOT_H
+/************************ (C) COPYRIGHT DJI Innovations *******END OF FILE******/
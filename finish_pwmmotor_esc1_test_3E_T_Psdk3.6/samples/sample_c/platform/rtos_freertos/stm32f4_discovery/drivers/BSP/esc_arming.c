@@ -0,0 +1,235 @@
+/**
+ ********************************************************************
+ * @file    esc_arming.c
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   Arming and throttle range calibration of ESCs, driven by a millisecond clock
+ * given by caller instead of blocking delays, so it runs in the motor output loop and on host alike.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "esc_arming.h"
+
+/* Private constants ---------------------------------------------------------*/
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private values -------------------------------------------------------------*/
+static const char *s_escArmingStateName[] = {
+    [ESC_ARMING_STATE_IDLE] = "idle",
+    [ESC_ARMING_STATE_MAX_THROTTLE] = "max throttle",
+    [ESC_ARMING_STATE_MIN_THROTTLE] = "min throttle",
+    [ESC_ARMING_STATE_ARMED] = "armed",
+    [ESC_ARMING_STATE_FAULT] = "fault",
+};
+
+/* Private functions declaration ---------------------------------------------*/
+static bool EscArming_IsLinkAlive(const T_EscArming *arming, uint32_t nowMs);
+static void EscArming_EnterState(T_EscArming *arming, E_EscArmingState state, uint32_t nowMs);
+
+/* Exported functions definition ---------------------------------------------*/
+/**
+ * @brief Initialize arming state machine in idle state, link is regarded lost until first fed.
+ * @param arming: pointer to arming state machine.
+ * @param config: pointer to timing configuration.
+ * @param nowMs: current time, unit: ms.
+ * @return None.
+ */
+void EscArming_Init(T_EscArming *arming, const T_EscArmingConfig *config, uint32_t nowMs)
+{
+    arming->config = *config;
+    arming->lastLinkTimeMs = 0;
+    arming->isLinkSeen = false;
+    arming->isCalibrating = false;
+    EscArming_EnterState(arming, ESC_ARMING_STATE_IDLE, nowMs);
+}
+
+/**
+ * @brief Record that link was alive at given time, e.g. time data was last received from aircraft.
+ * @param arming: pointer to arming state machine.
+ * @param linkTimeMs: time link was last seen alive, unit: ms.
+ * @return None.
+ */
+void EscArming_FeedLink(T_EscArming *arming, uint32_t linkTimeMs)
+{
+    arming->lastLinkTimeMs = linkTimeMs;
+    arming->isLinkSeen = true;
+}
+
+/**
+ * @brief Request arming, accepted in idle state only, with link alive and throttle command at zero.
+ * @param arming: pointer to arming state machine.
+ * @param throttle: current throttle command.
+ * @param nowMs: current time, unit: ms.
+ * @return True if accepted.
+ */
+bool EscArming_RequestArm(T_EscArming *arming, uint16_t throttle, uint32_t nowMs)
+{
+    if (arming->state != ESC_ARMING_STATE_IDLE || throttle != 0 || !EscArming_IsLinkAlive(arming, nowMs)) {
+        return false;
+    }
+
+    arming->isCalibrating = false;
+    EscArming_EnterState(arming, ESC_ARMING_STATE_MIN_THROTTLE, nowMs);
+
+    return true;
+}
+
+/**
+ * @brief Request throttle range calibration, accepted in idle state only and with link alive. Calibration goes back
+ * to idle when done, ESC must be powered and propellers removed.
+ * @param arming: pointer to arming state machine.
+ * @param nowMs: current time, unit: ms.
+ * @return True if accepted.
+ */
+bool EscArming_RequestCalibration(T_EscArming *arming, uint32_t nowMs)
+{
+    if (arming->state != ESC_ARMING_STATE_IDLE || !EscArming_IsLinkAlive(arming, nowMs)) {
+        return false;
+    }
+
+    arming->isCalibrating = true;
+    EscArming_EnterState(arming, ESC_ARMING_STATE_MAX_THROTTLE, nowMs);
+
+    return true;
+}
+
+/**
+ * @brief Request disarm, stops output from any state. Fault is only cleared when link is alive again.
+ * @param arming: pointer to arming state machine.
+ * @param nowMs: current time, unit: ms.
+ * @return None.
+ */
+void EscArming_RequestDisarm(T_EscArming *arming, uint32_t nowMs)
+{
+    if (arming->state == ESC_ARMING_STATE_FAULT && !EscArming_IsLinkAlive(arming, nowMs)) {
+        return;
+    }
+
+    arming->isCalibrating = false;
+    EscArming_EnterState(arming, ESC_ARMING_STATE_IDLE, nowMs);
+}
+
+/**
+ * @brief Run timed transitions and link check, call periodically, e.g. once per output update.
+ * @param arming: pointer to arming state machine.
+ * @param nowMs: current time, unit: ms.
+ * @return State after processing.
+ */
+E_EscArmingState EscArming_Process(T_EscArming *arming, uint32_t nowMs)
+{
+    uint32_t stateTimeMs = nowMs - arming->stateEnterTimeMs;
+
+    if (arming->state != ESC_ARMING_STATE_IDLE && arming->state != ESC_ARMING_STATE_FAULT &&
+        !EscArming_IsLinkAlive(arming, nowMs)) {
+        arming->isCalibrating = false;
+        EscArming_EnterState(arming, ESC_ARMING_STATE_FAULT, nowMs);
+        return arming->state;
+    }
+
+    switch (arming->state) {
+        case ESC_ARMING_STATE_MAX_THROTTLE:
+            if (stateTimeMs >= arming->config.maxThrottleHoldMs) {
+                EscArming_EnterState(arming, ESC_ARMING_STATE_MIN_THROTTLE, nowMs);
+            }
+            break;
+        case ESC_ARMING_STATE_MIN_THROTTLE:
+            if (arming->isCalibrating && stateTimeMs >= arming->config.calibrationMinThrottleHoldMs) {
+                arming->isCalibrating = false;
+                EscArming_EnterState(arming, ESC_ARMING_STATE_IDLE, nowMs);
+            } else if (!arming->isCalibrating && stateTimeMs >= arming->config.armMinThrottleHoldMs) {
+                EscArming_EnterState(arming, ESC_ARMING_STATE_ARMED, nowMs);
+            }
+            break;
+        default:
+            break;
+    }
+
+    return arming->state;
+}
+
+/**
+ * @brief Get throttle to be output in current state.
+ * @param arming: pointer to arming state machine.
+ * @param throttle: throttle command.
+ * @param throttleMax: full throttle.
+ * @return Throttle to be output, 0 means stopped.
+ */
+uint16_t EscArming_GetOutputThrottle(const T_EscArming *arming, uint16_t throttle, uint16_t throttleMax)
+{
+    switch (arming->state) {
+        case ESC_ARMING_STATE_MAX_THROTTLE:
+            return throttleMax;
+        case ESC_ARMING_STATE_ARMED:
+            return throttle < throttleMax ? throttle : throttleMax;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Get position an arm switch should show in current state. Switch shows on while arming, armed and in fault, so
+ * that a rejected request turns it back off and a fault is cleared by the off edge, which requests disarm.
+ * @param arming: pointer to arming state machine.
+ * @return True if switch should show on.
+ */
+bool EscArming_IsSwitchOn(const T_EscArming *arming)
+{
+    switch (arming->state) {
+        case ESC_ARMING_STATE_MIN_THROTTLE:
+            return !arming->isCalibrating;
+        case ESC_ARMING_STATE_ARMED:
+        case ESC_ARMING_STATE_FAULT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Get name of state, used for logging and widget display.
+ * @param state: arming state.
+ * @return Name of state.
+ */
+const char *EscArming_GetStateName(E_EscArmingState state)
+{
+    if ((uint32_t) state >= sizeof(s_escArmingStateName) / sizeof(s_escArmingStateName[0])) {
+        return "unknown";
+    }
+
+    return s_escArmingStateName[state];
+}
+
+/* Private functions definition-----------------------------------------------*/
+static bool EscArming_IsLinkAlive(const T_EscArming *arming, uint32_t nowMs)
+{
+    //link time may be a little newer than time of caller, it is alive in that case
+    return arming->isLinkSeen &&
+           (int32_t) (nowMs - arming->lastLinkTimeMs) < (int32_t) arming->config.linkLostTimeoutMs;
+}
+
+static void EscArming_EnterState(T_EscArming *arming, E_EscArmingState state, uint32_t nowMs)
+{
+    arming->state = state;
+    arming->stateEnterTimeMs = nowMs;
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
@@ -0,0 +1,83 @@
+/**
+ ********************************************************************
+ * @file    esc_arming.h
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   This is the header file for "esc_arming.c", defining the structure and
+ * (exported) function prototypes.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ESC_ARMING_H
+#define ESC_ARMING_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Exported constants --------------------------------------------------------*/
+
+/* Exported types ------------------------------------------------------------*/
+typedef enum {
+    ESC_ARMING_STATE_IDLE = 0, /*!< Output stopped, waiting for arm or calibration request. */
+    ESC_ARMING_STATE_MAX_THROTTLE, /*!< Calibration, output full throttle so that ESC learns top of range. */
+    ESC_ARMING_STATE_MIN_THROTTLE, /*!< Output stopped so that ESC arms, or learns bottom of range in calibration. */
+    ESC_ARMING_STATE_ARMED, /*!< Output follows throttle command. */
+    ESC_ARMING_STATE_FAULT, /*!< Failsafe, output stopped until disarm is requested with link alive. */
+} E_EscArmingState;
+
+typedef struct {
+    uint32_t maxThrottleHoldMs; /*!< Time full throttle is held in calibration. */
+    uint32_t calibrationMinThrottleHoldMs; /*!< Time zero throttle is held after full throttle in calibration. */
+    uint32_t armMinThrottleHoldMs; /*!< Time zero throttle is held before armed. */
+    uint32_t linkLostTimeoutMs; /*!< Time without link after which output goes to failsafe. */
+} T_EscArmingConfig;
+
+typedef struct {
+    T_EscArmingConfig config;
+    E_EscArmingState state;
+    uint32_t stateEnterTimeMs;
+    uint32_t lastLinkTimeMs;
+    bool isLinkSeen;
+    bool isCalibrating;
+} T_EscArming;
+
+/* Exported functions --------------------------------------------------------*/
+void EscArming_Init(T_EscArming *arming, const T_EscArmingConfig *config, uint32_t nowMs);
+void EscArming_FeedLink(T_EscArming *arming, uint32_t linkTimeMs);
+bool EscArming_RequestArm(T_EscArming *arming, uint16_t throttle, uint32_t nowMs);
+bool EscArming_RequestCalibration(T_EscArming *arming, uint32_t nowMs);
+void EscArming_RequestDisarm(T_EscArming *arming, uint32_t nowMs);
+E_EscArmingState EscArming_Process(T_EscArming *arming, uint32_t nowMs);
+uint16_t EscArming_GetOutputThrottle(const T_EscArming *arming, uint16_t throttle, uint16_t throttleMax);
+bool EscArming_IsSwitchOn(const T_EscArming *arming);
+const char *EscArming_GetStateName(E_EscArmingState state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ESC_ARMING_H
+/************************ (C) COPYRIGHT DJI Innovations *******END OF FILE******/
@@ -0,0 +1,544 @@
+/**
+ ********************************************************************
+ * @file    esc_output.c
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   Multi-channel ESC output, DShot frames are sent by timer burst DMA which writes
+ * compare registers of all channels of a timer on every update event. Analog PWM is kept as fallback.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "esc_output.h"
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Private constants ---------------------------------------------------------*/
+#define ESC_OUTPUT_GROUP0_TIM               TIM8
+#define ESC_OUTPUT_GROUP0_GPIO_PORT         GPIOC
+#define ESC_OUTPUT_GROUP0_GPIO_AF           GPIO_AF3_TIM8
+//DMA request of timer update event, refer to DMA request mapping of reference manual
+#define ESC_OUTPUT_GROUP0_DMA_STREAM        DMA2_Stream1
+#define ESC_OUTPUT_GROUP0_DMA_CHANNEL       DMA_CHANNEL_7
+#define ESC_OUTPUT_GROUP0_DMA_IRQn          DMA2_Stream1_IRQn
+#define ESC_OUTPUT_GROUP0_DMA_IRQHandler    DMA2_Stream1_IRQHandler
+#define ESC_OUTPUT_GROUP0_CLK_ENABLE()      do { __HAL_RCC_TIM8_CLK_ENABLE(); __HAL_RCC_GPIOC_CLK_ENABLE(); \
+                                                 __HAL_RCC_DMA2_CLK_ENABLE(); } while (0)
+
+#define ESC_OUTPUT_GROUP1_TIM               TIM3
+#define ESC_OUTPUT_GROUP1_GPIO_PORT         GPIOB
+#define ESC_OUTPUT_GROUP1_GPIO_AF           GPIO_AF2_TIM3
+#define ESC_OUTPUT_GROUP1_DMA_STREAM        DMA1_Stream2
+#define ESC_OUTPUT_GROUP1_DMA_CHANNEL       DMA_CHANNEL_5
+#define ESC_OUTPUT_GROUP1_DMA_IRQn          DMA1_Stream2_IRQn
+#define ESC_OUTPUT_GROUP1_DMA_IRQHandler    DMA1_Stream2_IRQHandler
+#define ESC_OUTPUT_GROUP1_CLK_ENABLE()      do { __HAL_RCC_TIM3_CLK_ENABLE(); __HAL_RCC_GPIOB_CLK_ENABLE(); \
+                                                 __HAL_RCC_DMA1_CLK_ENABLE(); } while (0)
+
+//DMA interrupt only releases the timer, so it may run at the highest priority FreeRTOS allows
+#define ESC_OUTPUT_DMA_IRQ_PRIO_PRE         configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+#define ESC_OUTPUT_DMA_IRQ_PRIO_SUB         0
+
+#define ESC_OUTPUT_PWM_COUNTER_FREQ_HZ      1000000
+#define ESC_OUTPUT_PWM_FREQ_MIN_HZ          50
+#define ESC_OUTPUT_PWM_FREQ_MAX_HZ          490
+
+#define ESC_OUTPUT_BURST_BUFFER_LEN         (DSHOT_FRAME_SLOT_NUM * ESC_OUTPUT_GROUP_CHANNEL_NUM)
+
+/* Private types -------------------------------------------------------------*/
+typedef struct {
+    TIM_TypeDef *tim;
+    GPIO_TypeDef *gpioPort;
+    uint16_t gpioPin[ESC_OUTPUT_GROUP_CHANNEL_NUM];
+    uint8_t gpioAf;
+    DMA_Stream_TypeDef *dmaStream;
+    uint32_t dmaChannel;
+    IRQn_Type dmaIrqNum;
+} T_EscOutputGroupConfig;
+
+typedef struct {
+    TIM_HandleTypeDef timHandle;
+    DMA_HandleTypeDef dmaHandle;
+    uint8_t channelNum;
+    T_DshotTiming dshotTiming;
+    volatile bool isDmaBusy; /*!< Set when frame is started, cleared by DMA transfer complete interrupt. */
+} T_EscOutputGroup;
+
+typedef struct {
+    T_ThrottleRamp ramp;
+    uint8_t command;
+    uint8_t commandRepeatNum; /*!< Count of frames still to carry command instead of throttle. */
+} T_EscOutputChannel;
+
+/* Private values -------------------------------------------------------------*/
+static const T_EscOutputGroupConfig s_escOutputGroupConfig[ESC_OUTPUT_GROUP_NUM] = {
+    {
+        .tim = ESC_OUTPUT_GROUP0_TIM,
+        .gpioPort = ESC_OUTPUT_GROUP0_GPIO_PORT,
+        .gpioPin = {GPIO_PIN_6, GPIO_PIN_7, GPIO_PIN_8, GPIO_PIN_9},
+        .gpioAf = ESC_OUTPUT_GROUP0_GPIO_AF,
+        .dmaStream = ESC_OUTPUT_GROUP0_DMA_STREAM,
+        .dmaChannel = ESC_OUTPUT_GROUP0_DMA_CHANNEL,
+        .dmaIrqNum = ESC_OUTPUT_GROUP0_DMA_IRQn,
+    },
+    {
+        .tim = ESC_OUTPUT_GROUP1_TIM,
+        .gpioPort = ESC_OUTPUT_GROUP1_GPIO_PORT,
+        .gpioPin = {GPIO_PIN_4, GPIO_PIN_5, GPIO_PIN_0, GPIO_PIN_1},
+        .gpioAf = ESC_OUTPUT_GROUP1_GPIO_AF,
+        .dmaStream = ESC_OUTPUT_GROUP1_DMA_STREAM,
+        .dmaChannel = ESC_OUTPUT_GROUP1_DMA_CHANNEL,
+        .dmaIrqNum = ESC_OUTPUT_GROUP1_DMA_IRQn,
+    },
+};
+static const uint32_t s_escOutputTimChannel[ESC_OUTPUT_GROUP_CHANNEL_NUM] = {
+    TIM_CHANNEL_1, TIM_CHANNEL_2, TIM_CHANNEL_3, TIM_CHANNEL_4,
+};
+
+static bool s_isEscOutputInit = false;
+static E_EscOutputMode s_escOutputMode;
+static uint8_t s_escOutputChannelNum;
+static T_EscOutputGroup s_escOutputGroup[ESC_OUTPUT_GROUP_NUM];
+static T_EscOutputChannel s_escOutputChannel[ESC_OUTPUT_CHANNEL_MAX_NUM];
+//DMA controller can not access CCMRAM, so burst buffers are kept in main SRAM
+static uint32_t s_escOutputBurstBuffer[ESC_OUTPUT_GROUP_NUM][ESC_OUTPUT_BURST_BUFFER_LEN];
+static T_EscOutputUpdateState s_escOutputUpdateState = {0};
+
+/* Private functions declaration ---------------------------------------------*/
+static uint32_t EscOutput_GetTimerClockFreq(const TIM_TypeDef *tim);
+static void EscOutput_GroupInit(uint8_t groupIndex, const T_EscOutputConfig *config);
+static void EscOutput_GroupDmaInit(uint8_t groupIndex);
+static void EscOutput_GroupDmaKick(T_EscOutputGroup *group, const uint32_t *burstBuffer);
+static void EscOutput_GroupDmaComplete(T_EscOutputGroup *group);
+static void EscOutput_RecordUpdateCost(uint32_t costCycles);
+
+/* Exported functions definition ---------------------------------------------*/
+/**
+ * @brief Start ESC output, channels are stopped until throttle is set, can only be called once.
+ * @param config: pointer to output configuration.
+ * @return Execution result.
+ */
+T_DjiReturnCode EscOutput_Init(const T_EscOutputConfig *config)
+{
+    uint8_t groupNum;
+    uint8_t i;
+
+    if (s_isEscOutputInit) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NONSUPPORT_IN_CURRENT_STATE;
+    }
+
+    if (config->channelNum == 0 || config->channelNum > ESC_OUTPUT_CHANNEL_MAX_NUM ||
+        config->mode > ESC_OUTPUT_MODE_DSHOT600) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    if (config->mode == ESC_OUTPUT_MODE_PWM &&
+        (config->pwmFreqHz < ESC_OUTPUT_PWM_FREQ_MIN_HZ || config->pwmFreqHz > ESC_OUTPUT_PWM_FREQ_MAX_HZ)) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    groupNum = (config->channelNum + ESC_OUTPUT_GROUP_CHANNEL_NUM - 1) / ESC_OUTPUT_GROUP_CHANNEL_NUM;
+    for (i = 0; i < groupNum; i++) {
+        if (config->mode != ESC_OUTPUT_MODE_PWM &&
+            !Dshot_GetTiming((E_DshotSpeed) (config->mode - ESC_OUTPUT_MODE_DSHOT150),
+                             EscOutput_GetTimerClockFreq(s_escOutputGroupConfig[i].tim),
+                             &s_escOutputGroup[i].dshotTiming)) {
+            return DJI_ERROR_SYSTEM_MODULE_CODE_NONSUPPORT;
+        }
+    }
+
+    s_escOutputMode = config->mode;
+    s_escOutputChannelNum = config->channelNum;
+    for (i = 0; i < config->channelNum; i++) {
+        ThrottleRamp_Init(&s_escOutputChannel[i].ramp, &config->rampConfig, 0);
+        s_escOutputChannel[i].commandRepeatNum = 0;
+    }
+
+    //cycle counter is used to measure cost of update
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    for (i = 0; i < groupNum; i++) {
+        EscOutput_GroupInit(i, config);
+        if (config->mode != ESC_OUTPUT_MODE_PWM) {
+            EscOutput_GroupDmaInit(i);
+        }
+    }
+
+    s_isEscOutputInit = true;
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+/**
+ * @brief Set target throttle of a channel, output ramps toward it on following updates.
+ * @param channel: ESC channel.
+ * @param throttle: target throttle, 0 to ESC_OUTPUT_THROTTLE_MAX, 0 stops motor.
+ * @return Execution result.
+ */
+T_DjiReturnCode EscOutput_SetThrottle(uint8_t channel, uint16_t throttle)
+{
+    if (!s_isEscOutputInit) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NONSUPPORT_IN_CURRENT_STATE;
+    }
+
+    if (channel >= s_escOutputChannelNum || throttle > ESC_OUTPUT_THROTTLE_MAX) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    ThrottleRamp_SetTarget(&s_escOutputChannel[channel].ramp, throttle);
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+/**
+ * @brief Set throttle of a channel without ramp, it is output by next update, used to stop motor in failsafe.
+ * @note Ramp is stepped by EscOutput_Update, call it from the task that runs update.
+ * @param channel: ESC channel.
+ * @param throttle: throttle, 0 to ESC_OUTPUT_THROTTLE_MAX, 0 stops motor.
+ * @return Execution result.
+ */
+T_DjiReturnCode EscOutput_JumpThrottle(uint8_t channel, uint16_t throttle)
+{
+    if (!s_isEscOutputInit) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NONSUPPORT_IN_CURRENT_STATE;
+    }
+
+    if (channel >= s_escOutputChannelNum || throttle > ESC_OUTPUT_THROTTLE_MAX) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    ThrottleRamp_Jump(&s_escOutputChannel[channel].ramp, throttle);
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+/**
+ * @brief Send DShot command to a channel in place of throttle, ESC only accepts commands while motor is stopped.
+ * @note Settings commands, e.g. spin direction and save settings, must be repeated at least 6 times.
+ * @param channel: ESC channel.
+ * @param command: DShot command.
+ * @param repeatNum: count of consecutive frames carrying command.
+ * @return Execution result.
+ */
+T_DjiReturnCode EscOutput_SendCommand(uint8_t channel, E_DshotCommand command, uint8_t repeatNum)
+{
+    if (!s_isEscOutputInit || s_escOutputMode == ESC_OUTPUT_MODE_PWM) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NONSUPPORT_IN_CURRENT_STATE;
+    }
+
+    if (channel >= s_escOutputChannelNum || command > DSHOT_COMMAND_MAX || repeatNum == 0) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    taskENTER_CRITICAL();
+    s_escOutputChannel[channel].command = (uint8_t) command;
+    s_escOutputChannel[channel].commandRepeatNum = repeatNum;
+    taskEXIT_CRITICAL();
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+/**
+ * @brief Step throttle ramps and output one frame on every channel, must be called from a single task.
+ * @note DShot ESCs stop motor when frames stop coming, call it periodically, e.g. every millisecond. In PWM mode,
+ * compare registers are preloaded and the last value written in a PWM period is output.
+ * @return Execution result, busy if DMA is still sending previous frame, ramps are not stepped in this case.
+ */
+T_DjiReturnCode EscOutput_Update(void)
+{
+    uint32_t startCycles = DWT->CYCCNT;
+    uint16_t frames[ESC_OUTPUT_CHANNEL_MAX_NUM] = {0};
+    T_EscOutputGroup *group;
+    T_EscOutputChannel *escChannel;
+    uint16_t throttle;
+    uint8_t groupNum;
+    uint8_t i;
+
+    if (!s_isEscOutputInit) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NONSUPPORT_IN_CURRENT_STATE;
+    }
+
+    groupNum = (s_escOutputChannelNum + ESC_OUTPUT_GROUP_CHANNEL_NUM - 1) / ESC_OUTPUT_GROUP_CHANNEL_NUM;
+    for (i = 0; i < groupNum; i++) {
+        if (s_escOutputGroup[i].isDmaBusy) {
+            s_escOutputUpdateState.countOfBusySkip++;
+            return DJI_ERROR_SYSTEM_MODULE_CODE_BUSY;
+        }
+    }
+
+    for (i = 0; i < s_escOutputChannelNum; i++) {
+        escChannel = &s_escOutputChannel[i];
+        group = &s_escOutputGroup[i / ESC_OUTPUT_GROUP_CHANNEL_NUM];
+        throttle = ThrottleRamp_Update(&escChannel->ramp);
+
+        if (s_escOutputMode == ESC_OUTPUT_MODE_PWM) {
+            __HAL_TIM_SET_COMPARE(&group->timHandle, s_escOutputTimChannel[i % ESC_OUTPUT_GROUP_CHANNEL_NUM],
+                                  ESC_OUTPUT_PWM_PULSE_MIN_US + (uint32_t) throttle *
+                                  (ESC_OUTPUT_PWM_PULSE_MAX_US - ESC_OUTPUT_PWM_PULSE_MIN_US) /
+                                  ESC_OUTPUT_THROTTLE_MAX);
+            continue;
+        }
+
+        taskENTER_CRITICAL();
+        if (escChannel->commandRepeatNum != 0) {
+            escChannel->commandRepeatNum--;
+            //commands are sent with telemetry request set, same as flight controllers do
+            frames[i] = Dshot_EncodeFrame(escChannel->command, true);
+        } else {
+            frames[i] = Dshot_EncodeFrame(Dshot_ThrottleToValue(throttle, ESC_OUTPUT_THROTTLE_MAX), false);
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    if (s_escOutputMode != ESC_OUTPUT_MODE_PWM) {
+        //burst always writes all 4 compare registers of a timer, compare values of unused channels are not output
+        for (i = 0; i < groupNum; i++) {
+            Dshot_FillBurstBuffer(s_escOutputBurstBuffer[i], &frames[i * ESC_OUTPUT_GROUP_CHANNEL_NUM],
+                                  ESC_OUTPUT_GROUP_CHANNEL_NUM, &s_escOutputGroup[i].dshotTiming);
+            EscOutput_GroupDmaKick(&s_escOutputGroup[i], s_escOutputBurstBuffer[i]);
+        }
+    }
+
+    EscOutput_RecordUpdateCost(DWT->CYCCNT - startCycles);
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+/**
+ * @brief Check whether last update output target throttle on every channel.
+ * @return True if every ramp has reached its target.
+ */
+bool EscOutput_IsSettled(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < s_escOutputChannelNum; i++) {
+        if (!ThrottleRamp_IsSettled(&s_escOutputChannel[i].ramp)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Get count and CPU cost of updates.
+ * @param state: pointer to update state.
+ * @return None.
+ */
+void EscOutput_GetUpdateState(T_EscOutputUpdateState *state)
+{
+    taskENTER_CRITICAL();
+    *state = s_escOutputUpdateState;
+    taskEXIT_CRITICAL();
+
+    state->averageCostNs = state->countOfUpdate != 0 ? (uint32_t) (state->sumOfCostNs / state->countOfUpdate) : 0;
+}
+
+/**
+ * @brief DMA interrupt of TIM8 burst, channel 0 to 3.
+ * @return None.
+ */
+void ESC_OUTPUT_GROUP0_DMA_IRQHandler(void)
+{
+    EscOutput_GroupDmaComplete(&s_escOutputGroup[0]);
+}
+
+/**
+ * @brief DMA interrupt of TIM3 burst, channel 4 to 7.
+ * @return None.
+ */
+void ESC_OUTPUT_GROUP1_DMA_IRQHandler(void)
+{
+    EscOutput_GroupDmaComplete(&s_escOutputGroup[1]);
+}
+
+/* Private functions definition-----------------------------------------------*/
+static uint32_t EscOutput_GetTimerClockFreq(const TIM_TypeDef *tim)
+{
+    //timers run at twice of PCLK when APB prescaler is not 1
+    if (tim == TIM8) {
+        if ((RCC->CFGR & RCC_CFGR_PPRE2) == RCC_CFGR_PPRE2_DIV1) {
+            return HAL_RCC_GetPCLK2Freq();
+        }
+        return HAL_RCC_GetPCLK2Freq() * 2;
+    }
+
+    if ((RCC->CFGR & RCC_CFGR_PPRE1) == RCC_CFGR_PPRE1_DIV1) {
+        return HAL_RCC_GetPCLK1Freq();
+    }
+    return HAL_RCC_GetPCLK1Freq() * 2;
+}
+
+/**
+ * @brief Configure pins and timer of a group, channels output stop pulses, or stay low in DShot modes.
+ * @param groupIndex: index of group.
+ * @param config: pointer to output configuration.
+ * @return None.
+ */
+static void EscOutput_GroupInit(uint8_t groupIndex, const T_EscOutputConfig *config)
+{
+    const T_EscOutputGroupConfig *groupConfig = &s_escOutputGroupConfig[groupIndex];
+    T_EscOutputGroup *group = &s_escOutputGroup[groupIndex];
+    GPIO_InitTypeDef gpioInitStruct = {0};
+    TIM_OC_InitTypeDef timOcInitStruct = {0};
+    uint8_t i;
+
+    if (groupIndex == 0) {
+        ESC_OUTPUT_GROUP0_CLK_ENABLE();
+    } else {
+        ESC_OUTPUT_GROUP1_CLK_ENABLE();
+    }
+
+    group->channelNum = config->channelNum - groupIndex * ESC_OUTPUT_GROUP_CHANNEL_NUM;
+    if (group->channelNum > ESC_OUTPUT_GROUP_CHANNEL_NUM) {
+        group->channelNum = ESC_OUTPUT_GROUP_CHANNEL_NUM;
+    }
+    group->isDmaBusy = false;
+
+    //pull down keeps ESC input low while pins are not driven yet
+    gpioInitStruct.Mode = GPIO_MODE_AF_PP;
+    gpioInitStruct.Pull = GPIO_PULLDOWN;
+    gpioInitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+    gpioInitStruct.Alternate = groupConfig->gpioAf;
+    for (i = 0; i < group->channelNum; i++) {
+        gpioInitStruct.Pin |= groupConfig->gpioPin[i];
+    }
+    HAL_GPIO_Init(groupConfig->gpioPort, &gpioInitStruct);
+
+    group->timHandle.Instance = groupConfig->tim;
+    group->timHandle.Init.CounterMode = TIM_COUNTERMODE_UP;
+    group->timHandle.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    group->timHandle.Init.RepetitionCounter = 0;
+    group->timHandle.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+    if (config->mode == ESC_OUTPUT_MODE_PWM) {
+        group->timHandle.Init.Prescaler =
+            EscOutput_GetTimerClockFreq(groupConfig->tim) / ESC_OUTPUT_PWM_COUNTER_FREQ_HZ - 1;
+        group->timHandle.Init.Period = ESC_OUTPUT_PWM_COUNTER_FREQ_HZ / config->pwmFreqHz - 1;
+        timOcInitStruct.Pulse = ESC_OUTPUT_PWM_PULSE_MIN_US;
+    } else {
+        group->timHandle.Init.Prescaler = 0;
+        group->timHandle.Init.Period = group->dshotTiming.bitPeriodCount - 1;
+        timOcInitStruct.Pulse = 0;
+    }
+    HAL_TIM_PWM_Init(&group->timHandle);
+
+    timOcInitStruct.OCMode = TIM_OCMODE_PWM1;
+    timOcInitStruct.OCPolarity = TIM_OCPOLARITY_HIGH;
+    timOcInitStruct.OCNPolarity = TIM_OCNPOLARITY_HIGH;
+    timOcInitStruct.OCFastMode = TIM_OCFAST_DISABLE;
+    timOcInitStruct.OCIdleState = TIM_OCIDLESTATE_RESET;
+    timOcInitStruct.OCNIdleState = TIM_OCNIDLESTATE_RESET;
+    for (i = 0; i < group->channelNum; i++) {
+        HAL_TIM_PWM_ConfigChannel(&group->timHandle, &timOcInitStruct, s_escOutputTimChannel[i]);
+        HAL_TIM_PWM_Start(&group->timHandle, s_escOutputTimChannel[i]);
+    }
+}
+
+/**
+ * @brief Prepare DMA stream writing compare registers of a group through timer DMA burst register.
+ * @param groupIndex: index of group.
+ * @return None.
+ */
+static void EscOutput_GroupDmaInit(uint8_t groupIndex)
+{
+    const T_EscOutputGroupConfig *groupConfig = &s_escOutputGroupConfig[groupIndex];
+    T_EscOutputGroup *group = &s_escOutputGroup[groupIndex];
+
+    group->dmaHandle.Instance = groupConfig->dmaStream;
+    group->dmaHandle.Init.Channel = groupConfig->dmaChannel;
+    group->dmaHandle.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    group->dmaHandle.Init.PeriphInc = DMA_PINC_DISABLE;
+    group->dmaHandle.Init.MemInc = DMA_MINC_ENABLE;
+    group->dmaHandle.Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
+    group->dmaHandle.Init.MemDataAlignment = DMA_MDATAALIGN_WORD;
+    group->dmaHandle.Init.Mode = DMA_NORMAL;
+    group->dmaHandle.Init.Priority = DMA_PRIORITY_VERY_HIGH;
+    group->dmaHandle.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    HAL_DMA_Init(&group->dmaHandle);
+    __HAL_LINKDMA(&group->timHandle, hdma[TIM_DMA_ID_UPDATE], group->dmaHandle);
+
+    //stream is reprogrammed for every frame, so registers are driven directly instead of HAL state
+    groupConfig->dmaStream->PAR = (uint32_t) &groupConfig->tim->DMAR;
+    __HAL_DMA_ENABLE_IT(&group->dmaHandle, DMA_IT_TC);
+
+    //every update event writes CCR1 to CCR4 once
+    groupConfig->tim->DCR = TIM_DMABASE_CCR1 | TIM_DMABURSTLENGTH_4TRANSFERS;
+
+    HAL_NVIC_SetPriority(groupConfig->dmaIrqNum, ESC_OUTPUT_DMA_IRQ_PRIO_PRE, ESC_OUTPUT_DMA_IRQ_PRIO_SUB);
+    HAL_NVIC_EnableIRQ(groupConfig->dmaIrqNum);
+}
+
+/**
+ * @brief Start sending a frame, compare values of first bit are loaded on next update event and output from the
+ * one after, so a frame never starts in the middle of a bit.
+ * @param group: pointer to group.
+ * @param burstBuffer: compare values of frame, refer to Dshot_FillBurstBuffer.
+ * @return None.
+ */
+static void EscOutput_GroupDmaKick(T_EscOutputGroup *group, const uint32_t *burstBuffer)
+{
+    group->isDmaBusy = true;
+
+    __HAL_DMA_CLEAR_FLAG(&group->dmaHandle, __HAL_DMA_GET_TC_FLAG_INDEX(&group->dmaHandle) |
+                                            __HAL_DMA_GET_HT_FLAG_INDEX(&group->dmaHandle) |
+                                            __HAL_DMA_GET_TE_FLAG_INDEX(&group->dmaHandle) |
+                                            __HAL_DMA_GET_DME_FLAG_INDEX(&group->dmaHandle) |
+                                            __HAL_DMA_GET_FE_FLAG_INDEX(&group->dmaHandle));
+    group->dmaHandle.Instance->M0AR = (uint32_t) burstBuffer;
+    group->dmaHandle.Instance->NDTR = ESC_OUTPUT_BURST_BUFFER_LEN;
+    __HAL_DMA_ENABLE(&group->dmaHandle);
+
+    __HAL_TIM_ENABLE_DMA(&group->timHandle, TIM_DMA_UPDATE);
+}
+
+/**
+ * @brief Stop DMA request of timer once the whole frame has been written, called from DMA interrupt.
+ * @note Reset slots at end of frame are still being output, they keep line low until next frame.
+ * @param group: pointer to group.
+ * @return None.
+ */
+static void EscOutput_GroupDmaComplete(T_EscOutputGroup *group)
+{
+    if (__HAL_DMA_GET_FLAG(&group->dmaHandle, __HAL_DMA_GET_TC_FLAG_INDEX(&group->dmaHandle)) == RESET) {
+        return;
+    }
+    __HAL_DMA_CLEAR_FLAG(&group->dmaHandle, __HAL_DMA_GET_TC_FLAG_INDEX(&group->dmaHandle));
+
+    __HAL_TIM_DISABLE_DMA(&group->timHandle, TIM_DMA_UPDATE);
+    group->isDmaBusy = false;
+}
+
+static void EscOutput_RecordUpdateCost(uint32_t costCycles)
+{
+    uint32_t costNs = (uint32_t) ((uint64_t) costCycles * 1000 / (SystemCoreClock / 1000000));
+
+    taskENTER_CRITICAL();
+    s_escOutputUpdateState.countOfUpdate++;
+    s_escOutputUpdateState.sumOfCostNs += costNs;
+    if (costNs > s_escOutputUpdateState.maxCostNs) {
+        s_escOutputUpdateState.maxCostNs = costNs;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
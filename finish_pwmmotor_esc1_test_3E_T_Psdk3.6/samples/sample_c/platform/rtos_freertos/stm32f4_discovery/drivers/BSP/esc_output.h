@@ -0,0 +1,91 @@
+/**
+ ********************************************************************
+ * @file    esc_output.h
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   This is the header file for "esc_output.c", defining the structure and
+ * (exported) function prototypes.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ESC_OUTPUT_H
+#define ESC_OUTPUT_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "dji_typedef.h"
+#include "dshot.h"
+#include "throttle_ramp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Exported constants --------------------------------------------------------*/
+//channel 0 to 3 are TIM8 CH1 to CH4 on PC6 to PC9, channel 4 to 7 are TIM3 CH1 to CH4 on PB4, PB5, PB0, PB1
+#define ESC_OUTPUT_GROUP_CHANNEL_NUM    4
+#define ESC_OUTPUT_GROUP_NUM            2
+#define ESC_OUTPUT_CHANNEL_MAX_NUM      (ESC_OUTPUT_GROUP_CHANNEL_NUM * ESC_OUTPUT_GROUP_NUM)
+
+//throttle 0 stops motor in every mode
+#define ESC_OUTPUT_THROTTLE_MAX         2000
+
+//pulse width of PWM mode, unit: us
+#define ESC_OUTPUT_PWM_PULSE_MIN_US     1000
+#define ESC_OUTPUT_PWM_PULSE_MAX_US     2000
+
+/* Exported types ------------------------------------------------------------*/
+typedef enum {
+    ESC_OUTPUT_MODE_PWM = 0, /*!< Analog PWM, kept for ESCs without DShot, needs throttle range calibration. */
+    ESC_OUTPUT_MODE_DSHOT150,
+    ESC_OUTPUT_MODE_DSHOT300,
+    ESC_OUTPUT_MODE_DSHOT600,
+} E_EscOutputMode;
+
+typedef struct {
+    E_EscOutputMode mode;
+    uint8_t channelNum; /*!< Count of used channels, 1 to ESC_OUTPUT_CHANNEL_MAX_NUM. */
+    uint16_t pwmFreqHz; /*!< Frame rate of PWM mode, 50 to 490, not used by DShot modes. */
+    T_ThrottleRampConfig rampConfig; /*!< Ramp of throttle, steps once per EscOutput_Update. */
+} T_EscOutputConfig;
+
+typedef struct {
+    uint32_t countOfUpdate; /*!< Count of frames started. */
+    uint32_t countOfBusySkip; /*!< Count of updates skipped since DMA was still sending previous frame. */
+    uint32_t averageCostNs; /*!< Average CPU time of an update, unit: ns. */
+    uint32_t maxCostNs; /*!< Max CPU time of an update, unit: ns. */
+    uint64_t sumOfCostNs; /*!< Total CPU time of all updates, unit: ns. */
+} T_EscOutputUpdateState;
+
+/* Exported functions --------------------------------------------------------*/
+T_DjiReturnCode EscOutput_Init(const T_EscOutputConfig *config);
+T_DjiReturnCode EscOutput_SetThrottle(uint8_t channel, uint16_t throttle);
+T_DjiReturnCode EscOutput_JumpThrottle(uint8_t channel, uint16_t throttle);
+T_DjiReturnCode EscOutput_SendCommand(uint8_t channel, E_DshotCommand command, uint8_t repeatNum);
+T_DjiReturnCode EscOutput_Update(void);
+bool EscOutput_IsSettled(void);
+void EscOutput_GetUpdateState(T_EscOutputUpdateState *state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ESC_OUTPUT_H
+/************************ (C) COPYRIGHT DJI Innovations *******END OF FILE******/
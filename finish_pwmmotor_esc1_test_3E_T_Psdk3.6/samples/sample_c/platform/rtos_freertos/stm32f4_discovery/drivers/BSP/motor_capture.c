@@ -0,0 +1,237 @@
+/**
+ ********************************************************************
+ * @file    motor_capture.c
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   Input capture of produced pulse and motor tachometer on TIM4. Edges are captured into circular
+ * buffers by DMA, and filtered once per millisecond from compare interrupt of the same timer.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "motor_capture.h"
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Private constants ---------------------------------------------------------*/
+#define MOTOR_CAPTURE_TIM                   TIM4
+#define MOTOR_CAPTURE_TIM_IRQn              TIM4_IRQn
+#define MOTOR_CAPTURE_TIM_IRQHandler        TIM4_IRQHandler
+#define MOTOR_CAPTURE_GPIO_PORT             GPIOB
+#define MOTOR_CAPTURE_PULSE_GPIO_PIN        GPIO_PIN_6
+#define MOTOR_CAPTURE_TACH_GPIO_PIN         GPIO_PIN_8
+#define MOTOR_CAPTURE_GPIO_AF               GPIO_AF2_TIM4
+//DMA requests of CH1 and CH3 capture, refer to DMA request mapping of reference manual
+#define MOTOR_CAPTURE_PULSE_DMA_STREAM      DMA1_Stream0
+#define MOTOR_CAPTURE_TACH_DMA_STREAM       DMA1_Stream7
+#define MOTOR_CAPTURE_DMA_CHANNEL           DMA_CHANNEL_2
+#define MOTOR_CAPTURE_CLK_ENABLE()          do { __HAL_RCC_TIM4_CLK_ENABLE(); __HAL_RCC_GPIOB_CLK_ENABLE(); \
+                                                 __HAL_RCC_DMA1_CLK_ENABLE(); } while (0)
+
+//update of filtered values is not urgent, it must not delay interrupts of ESC output
+#define MOTOR_CAPTURE_IRQ_PRIO_PRE          10
+#define MOTOR_CAPTURE_IRQ_PRIO_SUB          0
+
+//filter of input, sampled at timer clock divided by 4 and 8 samples, rejects glitches shorter than about 0.4 us
+#define MOTOR_CAPTURE_INPUT_FILTER          0x9
+
+#define MOTOR_CAPTURE_UPDATE_PERIOD_COUNT   (MOTOR_TELEMETRY_CAPTURE_FREQ_HZ / MOTOR_TELEMETRY_UPDATE_FREQ_HZ)
+#define MOTOR_CAPTURE_PULSE_BUFFER_LEN      (MOTOR_CAPTURE_PULSE_RECORD_NUM * MOTOR_TELEMETRY_PULSE_RECORD_LEN)
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private values -------------------------------------------------------------*/
+static bool s_isMotorCaptureInit = false;
+static TIM_HandleTypeDef s_motorCaptureTimHandle;
+static DMA_HandleTypeDef s_motorCapturePulseDmaHandle;
+static DMA_HandleTypeDef s_motorCaptureTachDmaHandle;
+//DMA controller can not access CCMRAM, so capture buffers are kept in main SRAM
+static uint16_t s_motorCapturePulseBuffer[MOTOR_CAPTURE_PULSE_BUFFER_LEN];
+static uint16_t s_motorCaptureTachBuffer[MOTOR_CAPTURE_TACH_EDGE_NUM];
+static T_MotorTelemetry s_motorTelemetry;
+
+/* Private functions declaration ---------------------------------------------*/
+static uint32_t MotorCapture_GetTimerClockFreq(void);
+static void MotorCapture_TimInit(void);
+static void MotorCapture_DmaInit(DMA_HandleTypeDef *dmaHandle, DMA_Stream_TypeDef *stream, const volatile void *src,
+                                 uint16_t *buffer, uint16_t bufferLen);
+
+/* Exported functions definition ---------------------------------------------*/
+/**
+ * @brief Start capture, values are published from first update, 1 ms later. Can only be called once.
+ * @param config: pointer to filter configuration.
+ * @return Execution result.
+ */
+T_DjiReturnCode MotorCapture_Init(const T_MotorTelemetryConfig *config)
+{
+    if (s_isMotorCaptureInit) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NONSUPPORT_IN_CURRENT_STATE;
+    }
+
+    MotorTelemetry_Init(&s_motorTelemetry, config);
+
+    MOTOR_CAPTURE_CLK_ENABLE();
+    MotorCapture_TimInit();
+
+    //every capture of CH1 reads CCR1 and CCR2 through DMA burst register, which is a record of rising edge and
+    //the falling edge before it
+    MOTOR_CAPTURE_TIM->DCR = TIM_DMABASE_CCR1 | TIM_DMABURSTLENGTH_2TRANSFERS;
+    MotorCapture_DmaInit(&s_motorCapturePulseDmaHandle, MOTOR_CAPTURE_PULSE_DMA_STREAM, &MOTOR_CAPTURE_TIM->DMAR,
+                         s_motorCapturePulseBuffer, MOTOR_CAPTURE_PULSE_BUFFER_LEN);
+    MotorCapture_DmaInit(&s_motorCaptureTachDmaHandle, MOTOR_CAPTURE_TACH_DMA_STREAM, &MOTOR_CAPTURE_TIM->CCR3,
+                         s_motorCaptureTachBuffer, MOTOR_CAPTURE_TACH_EDGE_NUM);
+
+    __HAL_TIM_SET_COMPARE(&s_motorCaptureTimHandle, TIM_CHANNEL_4, MOTOR_CAPTURE_UPDATE_PERIOD_COUNT);
+    HAL_NVIC_SetPriority(MOTOR_CAPTURE_TIM_IRQn, MOTOR_CAPTURE_IRQ_PRIO_PRE, MOTOR_CAPTURE_IRQ_PRIO_SUB);
+    HAL_NVIC_EnableIRQ(MOTOR_CAPTURE_TIM_IRQn);
+
+    MOTOR_CAPTURE_TIM->CCER |= TIM_CCER_CC1E | TIM_CCER_CC2E | TIM_CCER_CC3E;
+    __HAL_TIM_ENABLE_DMA(&s_motorCaptureTimHandle, TIM_DMA_CC1 | TIM_DMA_CC3);
+    __HAL_TIM_ENABLE_IT(&s_motorCaptureTimHandle, TIM_IT_CC4);
+    __HAL_TIM_ENABLE(&s_motorCaptureTimHandle);
+
+    s_isMotorCaptureInit = true;
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+/**
+ * @brief Get latest filtered values.
+ * @param value: pointer to values, all 0 if capture is not started.
+ * @return None.
+ */
+void MotorCapture_GetTelemetry(T_MotorTelemetryValue *value)
+{
+    taskENTER_CRITICAL();
+    *value = s_motorTelemetry.value;
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Compare interrupt of CH4, fires every millisecond and consumes captures written by DMA since last one.
+ * @return None.
+ */
+void MOTOR_CAPTURE_TIM_IRQHandler(void)
+{
+    T_MotorTelemetryCapture pulseCapture = {s_motorCapturePulseBuffer, MOTOR_CAPTURE_PULSE_BUFFER_LEN, 0};
+    T_MotorTelemetryCapture tachCapture = {s_motorCaptureTachBuffer, MOTOR_CAPTURE_TACH_EDGE_NUM, 0};
+
+    if ((MOTOR_CAPTURE_TIM->SR & TIM_SR_CC4IF) == 0) {
+        return;
+    }
+    MOTOR_CAPTURE_TIM->SR = ~TIM_SR_CC4IF;
+    //compare value wraps with counter, so interval stays the same across overflow
+    MOTOR_CAPTURE_TIM->CCR4 = (uint16_t) (MOTOR_CAPTURE_TIM->CCR4 + MOTOR_CAPTURE_UPDATE_PERIOD_COUNT);
+
+    pulseCapture.writeIndex = MOTOR_CAPTURE_PULSE_BUFFER_LEN - MOTOR_CAPTURE_PULSE_DMA_STREAM->NDTR;
+    tachCapture.writeIndex = MOTOR_CAPTURE_TACH_EDGE_NUM - MOTOR_CAPTURE_TACH_DMA_STREAM->NDTR;
+    MotorTelemetry_Update(&s_motorTelemetry, &pulseCapture, &tachCapture);
+}
+
+/* Private functions definition-----------------------------------------------*/
+static uint32_t MotorCapture_GetTimerClockFreq(void)
+{
+    //timers on APB1 run at twice of PCLK1 when APB1 prescaler is not 1
+    if ((RCC->CFGR & RCC_CFGR_PPRE1) == RCC_CFGR_PPRE1_DIV1) {
+        return HAL_RCC_GetPCLK1Freq();
+    }
+
+    return HAL_RCC_GetPCLK1Freq() * 2;
+}
+
+/**
+ * @brief Configure pins and free running timer, CH1 captures rising and CH2 falling edges of pulse input, CH3
+ * captures rising edges of tachometer, CH4 only generates update interrupt.
+ * @return None.
+ */
+static void MotorCapture_TimInit(void)
+{
+    GPIO_InitTypeDef gpioInitStruct = {0};
+    TIM_IC_InitTypeDef timIcInitStruct = {0};
+    TIM_OC_InitTypeDef timOcInitStruct = {0};
+
+    gpioInitStruct.Pin = MOTOR_CAPTURE_PULSE_GPIO_PIN;
+    gpioInitStruct.Mode = GPIO_MODE_AF_PP;
+    gpioInitStruct.Pull = GPIO_PULLDOWN;
+    gpioInitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+    gpioInitStruct.Alternate = MOTOR_CAPTURE_GPIO_AF;
+    HAL_GPIO_Init(MOTOR_CAPTURE_GPIO_PORT, &gpioInitStruct);
+
+    //tachometer outputs and ESC telemetry lines are usually open drain
+    gpioInitStruct.Pin = MOTOR_CAPTURE_TACH_GPIO_PIN;
+    gpioInitStruct.Pull = GPIO_PULLUP;
+    HAL_GPIO_Init(MOTOR_CAPTURE_GPIO_PORT, &gpioInitStruct);
+
+    s_motorCaptureTimHandle.Instance = MOTOR_CAPTURE_TIM;
+    s_motorCaptureTimHandle.Init.Prescaler = MotorCapture_GetTimerClockFreq() / MOTOR_TELEMETRY_CAPTURE_FREQ_HZ - 1;
+    s_motorCaptureTimHandle.Init.CounterMode = TIM_COUNTERMODE_UP;
+    s_motorCaptureTimHandle.Init.Period = 0xFFFF;
+    s_motorCaptureTimHandle.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    s_motorCaptureTimHandle.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+    HAL_TIM_IC_Init(&s_motorCaptureTimHandle);
+
+    timIcInitStruct.ICPrescaler = TIM_ICPSC_DIV1;
+    timIcInitStruct.ICFilter = MOTOR_CAPTURE_INPUT_FILTER;
+    timIcInitStruct.ICPolarity = TIM_ICPOLARITY_RISING;
+    timIcInitStruct.ICSelection = TIM_ICSELECTION_DIRECTTI;
+    HAL_TIM_IC_ConfigChannel(&s_motorCaptureTimHandle, &timIcInitStruct, TIM_CHANNEL_1);
+    HAL_TIM_IC_ConfigChannel(&s_motorCaptureTimHandle, &timIcInitStruct, TIM_CHANNEL_3);
+
+    //CH2 takes the same pin as CH1
+    timIcInitStruct.ICPolarity = TIM_ICPOLARITY_FALLING;
+    timIcInitStruct.ICSelection = TIM_ICSELECTION_INDIRECTTI;
+    HAL_TIM_IC_ConfigChannel(&s_motorCaptureTimHandle, &timIcInitStruct, TIM_CHANNEL_2);
+
+    timOcInitStruct.OCMode = TIM_OCMODE_TIMING;
+    timOcInitStruct.Pulse = 0;
+    timOcInitStruct.OCPolarity = TIM_OCPOLARITY_HIGH;
+    timOcInitStruct.OCFastMode = TIM_OCFAST_DISABLE;
+    HAL_TIM_OC_ConfigChannel(&s_motorCaptureTimHandle, &timOcInitStruct, TIM_CHANNEL_4);
+}
+
+/**
+ * @brief Start circular DMA stream copying captures of a channel into buffer, no interrupt is used.
+ * @param dmaHandle: pointer to DMA handle.
+ * @param stream: DMA stream.
+ * @param src: register to read.
+ * @param buffer: capture buffer.
+ * @param bufferLen: length of buffer, unit: half word.
+ * @return None.
+ */
+static void MotorCapture_DmaInit(DMA_HandleTypeDef *dmaHandle, DMA_Stream_TypeDef *stream, const volatile void *src,
+                                 uint16_t *buffer, uint16_t bufferLen)
+{
+    dmaHandle->Instance = stream;
+    dmaHandle->Init.Channel = MOTOR_CAPTURE_DMA_CHANNEL;
+    dmaHandle->Init.Direction = DMA_PERIPH_TO_MEMORY;
+    dmaHandle->Init.PeriphInc = DMA_PINC_DISABLE;
+    dmaHandle->Init.MemInc = DMA_MINC_ENABLE;
+    dmaHandle->Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+    dmaHandle->Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+    dmaHandle->Init.Mode = DMA_CIRCULAR;
+    dmaHandle->Init.Priority = DMA_PRIORITY_HIGH;
+    dmaHandle->Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    HAL_DMA_Init(dmaHandle);
+
+    HAL_DMA_Start(dmaHandle, (uint32_t) src, (uint32_t) buffer, bufferLen);
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
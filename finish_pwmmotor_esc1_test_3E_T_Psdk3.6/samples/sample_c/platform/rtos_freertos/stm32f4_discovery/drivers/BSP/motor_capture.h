@@ -0,0 +1,57 @@
+/**
+ ********************************************************************
+ * @file    motor_capture.h
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   This is the header file for "motor_capture.c", defining the structure and
+ * (exported) function prototypes.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef MOTOR_CAPTURE_H
+#define MOTOR_CAPTURE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "dji_typedef.h"
+#include "motor_telemetry.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Exported constants --------------------------------------------------------*/
+//pulse input is TIM4 CH1 on PB6, wire it to the output to be verified, e.g. motor PWM on PA7. Tachometer or ESC
+//telemetry line is TIM4 CH3 on PB8
+#define MOTOR_CAPTURE_PULSE_RECORD_NUM      8
+#define MOTOR_CAPTURE_TACH_EDGE_NUM         64
+
+/* Exported types ------------------------------------------------------------*/
+
+/* Exported functions --------------------------------------------------------*/
+T_DjiReturnCode MotorCapture_Init(const T_MotorTelemetryConfig *config);
+void MotorCapture_GetTelemetry(T_MotorTelemetryValue *value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MOTOR_CAPTURE_H
+/************************ (C) COPYRIGHT DJI Innovations *******END OF FILE******/
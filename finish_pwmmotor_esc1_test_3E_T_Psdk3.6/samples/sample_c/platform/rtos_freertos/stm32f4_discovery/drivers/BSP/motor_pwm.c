@@ -0,0 +1,275 @@
+/**
+ ********************************************************************
+ * @file    motor_pwm.c
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   ESC PWM output, compare value of every channel is ramped toward its target in
+ * timer update interrupt, once per PWM period.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "motor_pwm.h"
+#include "ledpwm.h"
+#include "time_base.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Private constants ---------------------------------------------------------*/
+#define MOTOR_PWM_TIM_IRQn              TIM8_TRG_COM_TIM14_IRQn
+#define MOTOR_PWM_TIM_IRQHandler        TIM8_TRG_COM_TIM14_IRQHandler
+
+/* Private types -------------------------------------------------------------*/
+typedef struct {
+    TIM_HandleTypeDef *timHandle;
+    uint32_t timChannel;
+} T_MotorPwmChannelConfig;
+
+typedef struct {
+    uint64_t changeTimeUs; /*!< Time of oldest change not output yet, 0 if none. */
+    bool isTargetPreloaded; /*!< Target is in preload register, it is output from next update event. */
+} T_MotorPwmStamp;
+
+/* Private values -------------------------------------------------------------*/
+extern TIM_HandleTypeDef g_timx_pwm_chy_handle;
+
+static const T_MotorPwmChannelConfig s_motorPwmChannelConfig[MOTOR_PWM_CHANNEL_NUM] = {
+    {&g_timx_pwm_chy_handle, GTIM_TIMX_PWM_CHY},
+};
+static T_ThrottleRamp s_motorPwmRamp[MOTOR_PWM_CHANNEL_NUM];
+static volatile uint32_t s_countOfUpdate = 0;
+static volatile uint64_t s_sumOfUpdateCycles = 0;
+static volatile uint32_t s_maxUpdateCycles = 0;
+static T_MotorPwmStamp s_motorPwmStamp[MOTOR_PWM_CHANNEL_NUM];
+static volatile uint32_t s_countOfLatency = 0;
+static volatile uint64_t s_sumOfLatencyUs = 0;
+static volatile uint32_t s_maxLatencyUs = 0;
+
+/* Private functions declaration ---------------------------------------------*/
+static void MotorPwm_UpdateStamp(uint32_t channel, uint16_t compare);
+
+/* Exported functions definition ---------------------------------------------*/
+/**
+ * @brief Start ESC PWM and ramp update interrupt, all channels share the ramp configuration.
+ * @param rampConfig: pointer to ramp configuration.
+ * @param initCompare: compare value output until first target is set.
+ * @return None.
+ */
+void MotorPwm_Init(const T_ThrottleRampConfig *rampConfig, uint16_t initCompare)
+{
+    uint32_t i;
+
+    gtim_timx_pwm_chy_init(MOTOR_PWM_PERIOD_COUNT - 1, MOTOR_PWM_PRESCALER - 1);
+
+    for (i = 0; i < MOTOR_PWM_CHANNEL_NUM; i++) {
+        ThrottleRamp_Init(&s_motorPwmRamp[i], rampConfig, initCompare);
+        __HAL_TIM_SET_COMPARE(s_motorPwmChannelConfig[i].timHandle, s_motorPwmChannelConfig[i].timChannel,
+                              initCompare);
+    }
+
+    //cycle counter is used to measure cost of update
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    //update interrupt calls FreeRTOS API free code only, but keep it below kernel critical sections anyway
+    HAL_NVIC_SetPriority(MOTOR_PWM_TIM_IRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(MOTOR_PWM_TIM_IRQn);
+    __HAL_TIM_CLEAR_FLAG(&g_timx_pwm_chy_handle, TIM_FLAG_UPDATE);
+    __HAL_TIM_ENABLE_IT(&g_timx_pwm_chy_handle, TIM_IT_UPDATE);
+}
+
+/**
+ * @brief Set target compare value of a channel, output ramps toward it from next PWM period.
+ * @param channel: ESC channel.
+ * @param compare: target compare value.
+ * @return None.
+ */
+void MotorPwm_SetTarget(E_MotorPwmChannel channel, uint16_t compare)
+{
+    if (channel >= MOTOR_PWM_CHANNEL_NUM) {
+        return;
+    }
+
+    ThrottleRamp_SetTarget(&s_motorPwmRamp[channel], compare);
+}
+
+/**
+ * @brief Set compare value of a channel without ramp, it is output from next PWM period, used to stop in failsafe.
+ * @param channel: ESC channel.
+ * @param compare: compare value.
+ * @return None.
+ */
+void MotorPwm_JumpTarget(E_MotorPwmChannel channel, uint16_t compare)
+{
+    if (channel >= MOTOR_PWM_CHANNEL_NUM) {
+        return;
+    }
+
+    //update interrupt is below kernel critical sections, so it never sees a ramp half moved
+    taskENTER_CRITICAL();
+    ThrottleRamp_Jump(&s_motorPwmRamp[channel], compare);
+    __HAL_TIM_SET_COMPARE(s_motorPwmChannelConfig[channel].timHandle, s_motorPwmChannelConfig[channel].timChannel,
+                          compare);
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Stamp target of a channel with time of the change it comes from, latency is accounted when compare register
+ * starts outputting target. Oldest stamp is kept if target changes again before being output.
+ * @param channel: ESC channel.
+ * @param changeTimeUs: time of change, from time base.
+ * @return None.
+ */
+void MotorPwm_StampTarget(E_MotorPwmChannel channel, uint64_t changeTimeUs)
+{
+    if (channel >= MOTOR_PWM_CHANNEL_NUM || changeTimeUs == 0) {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    if (s_motorPwmStamp[channel].changeTimeUs == 0) {
+        s_motorPwmStamp[channel].changeTimeUs = changeTimeUs;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Get compare value being output by a channel.
+ * @param channel: ESC channel.
+ * @return Compare value.
+ */
+uint16_t MotorPwm_GetCompare(E_MotorPwmChannel channel)
+{
+    if (channel >= MOTOR_PWM_CHANNEL_NUM) {
+        return 0;
+    }
+
+    return s_motorPwmRamp[channel].current;
+}
+
+/**
+ * @brief Get cost of ramp update in timer interrupt.
+ * @param cost: pointer to cost.
+ * @return None.
+ */
+void MotorPwm_GetUpdateCost(T_MotorPwmUpdateCost *cost)
+{
+    uint32_t countOfUpdate;
+    uint64_t sumOfUpdateCycles;
+    uint32_t maxUpdateCycles;
+    uint32_t cyclesPerUs = SystemCoreClock / 1000000;
+
+    taskENTER_CRITICAL();
+    countOfUpdate = s_countOfUpdate;
+    sumOfUpdateCycles = s_sumOfUpdateCycles;
+    maxUpdateCycles = s_maxUpdateCycles;
+    taskEXIT_CRITICAL();
+
+    cost->countOfUpdate = countOfUpdate;
+    cost->averageCostNs = countOfUpdate != 0 ?
+                          (uint32_t) (sumOfUpdateCycles * 1000 / cyclesPerUs / countOfUpdate) : 0;
+    cost->maxCostNs = maxUpdateCycles * 1000 / cyclesPerUs;
+}
+
+/**
+ * @brief Get latency from stamped changes to compare register outputting target.
+ * @param latency: pointer to latency.
+ * @return None.
+ */
+void MotorPwm_GetOutputLatency(T_MotorPwmOutputLatency *latency)
+{
+    uint32_t countOfLatency;
+    uint64_t sumOfLatencyUs;
+
+    taskENTER_CRITICAL();
+    countOfLatency = s_countOfLatency;
+    sumOfLatencyUs = s_sumOfLatencyUs;
+    latency->maxLatencyUs = s_maxLatencyUs;
+    taskEXIT_CRITICAL();
+
+    latency->countOfLatency = countOfLatency;
+    latency->averageLatencyUs = countOfLatency != 0 ? (uint32_t) (sumOfLatencyUs / countOfLatency) : 0;
+}
+
+/**
+ * @brief Timer update interrupt of ESC PWM, compare registers are preloaded so values written here are output from
+ * next period.
+ * @return None.
+ */
+void MOTOR_PWM_TIM_IRQHandler(void)
+{
+    uint32_t startCycles = DWT->CYCCNT;
+    uint32_t costCycles;
+    uint16_t compare;
+    uint32_t i;
+
+    if (__HAL_TIM_GET_FLAG(&g_timx_pwm_chy_handle, TIM_FLAG_UPDATE) == RESET) {
+        return;
+    }
+    __HAL_TIM_CLEAR_FLAG(&g_timx_pwm_chy_handle, TIM_FLAG_UPDATE);
+
+    for (i = 0; i < MOTOR_PWM_CHANNEL_NUM; i++) {
+        compare = ThrottleRamp_Update(&s_motorPwmRamp[i]);
+        __HAL_TIM_SET_COMPARE(s_motorPwmChannelConfig[i].timHandle, s_motorPwmChannelConfig[i].timChannel, compare);
+        MotorPwm_UpdateStamp(i, compare);
+    }
+
+    costCycles = DWT->CYCCNT - startCycles;
+    s_countOfUpdate++;
+    s_sumOfUpdateCycles += costCycles;
+    if (costCycles > s_maxUpdateCycles) {
+        s_maxUpdateCycles = costCycles;
+    }
+}
+
+/* Private functions definition-----------------------------------------------*/
+/**
+ * @brief Account latency of stamped target, called in update interrupt after compare value of a channel is written.
+ * @param channel: ESC channel.
+ * @param compare: compare value written to preload register.
+ * @return None.
+ */
+static void MotorPwm_UpdateStamp(uint32_t channel, uint16_t compare)
+{
+    T_MotorPwmStamp *stamp = &s_motorPwmStamp[channel];
+    uint64_t timeUs;
+    uint32_t latencyUs;
+
+    //update event raising this interrupt has just moved value preloaded by last interrupt to compare register
+    if (stamp->isTargetPreloaded) {
+        stamp->isTargetPreloaded = false;
+        timeUs = TimeBase_GetUs();
+        if (timeUs >= stamp->changeTimeUs) {
+            latencyUs = (uint32_t) (timeUs - stamp->changeTimeUs);
+            s_countOfLatency++;
+            s_sumOfLatencyUs += latencyUs;
+            if (latencyUs > s_maxLatencyUs) {
+                s_maxLatencyUs = latencyUs;
+            }
+        }
+        stamp->changeTimeUs = 0;
+    }
+
+    if (stamp->changeTimeUs != 0 && compare == s_motorPwmRamp[channel].target) {
+        stamp->isTargetPreloaded = true;
+    }
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
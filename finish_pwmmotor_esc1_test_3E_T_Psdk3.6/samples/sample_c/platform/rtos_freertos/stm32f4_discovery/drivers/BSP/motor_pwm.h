@@ -0,0 +1,77 @@
+/**
+ ********************************************************************
+ * @file    motor_pwm.h
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   This is the header file for "motor_pwm.c", defining the structure and
+ * (exported) function prototypes.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef MOTOR_PWM_H
+#define MOTOR_PWM_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "throttle_ramp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Exported constants --------------------------------------------------------*/
+//ESC PWM is 50 Hz, compare value is counted in 10 us
+#define MOTOR_PWM_PERIOD_COUNT          2000
+#define MOTOR_PWM_PRESCALER             840
+#define MOTOR_PWM_UPDATE_FREQ_HZ        50
+
+/* Exported types ------------------------------------------------------------*/
+typedef enum {
+    MOTOR_PWM_CHANNEL_THROTTLE = 0,
+    MOTOR_PWM_CHANNEL_NUM,
+} E_MotorPwmChannel;
+
+typedef struct {
+    uint32_t countOfUpdate; /*!< Count of ramp updates run in timer interrupt. */
+    uint32_t averageCostNs; /*!< Average time an update of all channels takes, unit: ns. */
+    uint32_t maxCostNs; /*!< Max time an update of all channels takes, unit: ns. */
+} T_MotorPwmUpdateCost;
+
+typedef struct {
+    uint32_t countOfLatency; /*!< Count of stamped targets that have been output. */
+    uint32_t averageLatencyUs; /*!< Average time from stamp to compare register outputting target, unit: us. */
+    uint32_t maxLatencyUs; /*!< Max time from stamp to compare register outputting target, unit: us. */
+} T_MotorPwmOutputLatency;
+
+/* Exported functions --------------------------------------------------------*/
+void MotorPwm_Init(const T_ThrottleRampConfig *rampConfig, uint16_t initCompare);
+void MotorPwm_SetTarget(E_MotorPwmChannel channel, uint16_t compare);
+void MotorPwm_JumpTarget(E_MotorPwmChannel channel, uint16_t compare);
+void MotorPwm_StampTarget(E_MotorPwmChannel channel, uint64_t changeTimeUs);
+uint16_t MotorPwm_GetCompare(E_MotorPwmChannel channel);
+void MotorPwm_GetUpdateCost(T_MotorPwmUpdateCost *cost);
+void MotorPwm_GetOutputLatency(T_MotorPwmOutputLatency *latency);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MOTOR_PWM_H
+/************************ (C) COPYRIGHT DJI Innovations *******END OF FILE******/
@@ -0,0 +1,214 @@
+/**
+ ********************************************************************
+ * @file    motor_telemetry.c
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   Filtering of captured pulse and tachometer edges into pulse width and motor speed. Captures are
+ * read from circular buffers written by DMA once per update, so there is no work per edge.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "motor_telemetry.h"
+
+/* Private constants ---------------------------------------------------------*/
+#define MOTOR_TELEMETRY_US_PER_MINUTE       60000000ULL
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private values -------------------------------------------------------------*/
+
+/* Private functions declaration ---------------------------------------------*/
+static void MotorTelemetry_UpdatePulse(T_MotorTelemetry *telemetry, const T_MotorTelemetryCapture *capture);
+static void MotorTelemetry_UpdateTach(T_MotorTelemetry *telemetry, const T_MotorTelemetryCapture *capture);
+static bool MotorTelemetry_CheckTimeout(T_MotorTelemetry *telemetry, T_MotorTelemetryEdgeState *edgeState);
+static uint32_t MotorTelemetry_Filter(const T_MotorTelemetry *telemetry, uint32_t filtered, uint32_t scaledSample);
+
+/* Exported functions definition ---------------------------------------------*/
+/**
+ * @brief Initialize telemetry, read index of captures starts from 0, same as DMA.
+ * @param telemetry: pointer to telemetry.
+ * @param config: pointer to configuration, filter shift and timeout are limited to the max supported.
+ * @return None.
+ */
+void MotorTelemetry_Init(T_MotorTelemetry *telemetry, const T_MotorTelemetryConfig *config)
+{
+    T_MotorTelemetry zero = {0};
+
+    *telemetry = zero;
+    telemetry->config = *config;
+    if (telemetry->config.filterShift > MOTOR_TELEMETRY_FILTER_SHIFT_MAX) {
+        telemetry->config.filterShift = MOTOR_TELEMETRY_FILTER_SHIFT_MAX;
+    }
+    if (telemetry->config.signalTimeoutMs > MOTOR_TELEMETRY_SIGNAL_TIMEOUT_MAX_MS) {
+        telemetry->config.signalTimeoutMs = MOTOR_TELEMETRY_SIGNAL_TIMEOUT_MAX_MS;
+    }
+    if (telemetry->config.tachEdgePerRev == 0) {
+        telemetry->config.tachEdgePerRev = 1;
+    }
+}
+
+/**
+ * @brief Consume captures written since last update and refresh values, called at MOTOR_TELEMETRY_UPDATE_FREQ_HZ.
+ * @note Captures are lost if DMA writes more than length of buffer between two updates.
+ * @param telemetry: pointer to telemetry.
+ * @param pulseCapture: captures of pulse in records of MOTOR_TELEMETRY_PULSE_RECORD_LEN, NULL if not used.
+ * @param tachCapture: captures of tachometer edges, NULL if not used.
+ * @return None.
+ */
+void MotorTelemetry_Update(T_MotorTelemetry *telemetry, const T_MotorTelemetryCapture *pulseCapture,
+                           const T_MotorTelemetryCapture *tachCapture)
+{
+    if (pulseCapture != NULL) {
+        MotorTelemetry_UpdatePulse(telemetry, pulseCapture);
+    }
+
+    if (tachCapture != NULL) {
+        MotorTelemetry_UpdateTach(telemetry, tachCapture);
+    }
+}
+
+/* Private functions definition-----------------------------------------------*/
+static void MotorTelemetry_UpdatePulse(T_MotorTelemetry *telemetry, const T_MotorTelemetryCapture *capture)
+{
+    T_MotorTelemetryEdgeState *edgeState = &telemetry->pulse;
+    //record being written by DMA is skipped until both captures of it are in buffer
+    uint16_t writeIndex = capture->writeIndex - capture->writeIndex % MOTOR_TELEMETRY_PULSE_RECORD_LEN;
+    uint8_t shift = telemetry->config.filterShift;
+    uint16_t riseTime;
+    uint16_t fallTime;
+    uint16_t period;
+    uint16_t width;
+
+    if (edgeState->readIndex == writeIndex) {
+        if (MotorTelemetry_CheckTimeout(telemetry, edgeState)) {
+            telemetry->pulseWidthFiltered = 0;
+            telemetry->pulsePeriodFiltered = 0;
+            telemetry->value.pulseWidthUs = 0;
+            telemetry->value.pulsePeriodUs = 0;
+        }
+        return;
+    }
+
+    while (edgeState->readIndex != writeIndex) {
+        riseTime = capture->buffer[edgeState->readIndex];
+        fallTime = capture->buffer[edgeState->readIndex + 1];
+        edgeState->readIndex = (edgeState->readIndex + MOTOR_TELEMETRY_PULSE_RECORD_LEN) % capture->bufferLen;
+
+        if (edgeState->isLastTimeValid) {
+            period = (uint16_t) (riseTime - edgeState->lastTime);
+            width = (uint16_t) (fallTime - edgeState->lastTime);
+            //falling edge older than previous rising edge means the line did not fall during the period
+            if (width < period) {
+                telemetry->pulseWidthFiltered = MotorTelemetry_Filter(telemetry, telemetry->pulseWidthFiltered,
+                                                                      (uint32_t) width << shift);
+                telemetry->pulsePeriodFiltered = MotorTelemetry_Filter(telemetry, telemetry->pulsePeriodFiltered,
+                                                                       (uint32_t) period << shift);
+                telemetry->value.countOfPulse++;
+            }
+        }
+
+        edgeState->lastTime = riseTime;
+        edgeState->isLastTimeValid = true;
+    }
+    edgeState->idleMs = 0;
+
+    telemetry->value.pulseWidthUs = (uint16_t) (telemetry->pulseWidthFiltered >> shift);
+    telemetry->value.pulsePeriodUs = (uint16_t) (telemetry->pulsePeriodFiltered >> shift);
+}
+
+static void MotorTelemetry_UpdateTach(T_MotorTelemetry *telemetry, const T_MotorTelemetryCapture *capture)
+{
+    T_MotorTelemetryEdgeState *edgeState = &telemetry->tach;
+    uint16_t firstTime = capture->buffer[edgeState->readIndex];
+    uint16_t newestTime = firstTime;
+    uint8_t shift = telemetry->config.filterShift;
+    uint16_t edgeNum = 0;
+    uint16_t intervalNum;
+    uint16_t span;
+
+    if (edgeState->readIndex == capture->writeIndex) {
+        if (MotorTelemetry_CheckTimeout(telemetry, edgeState)) {
+            telemetry->tachPeriodFiltered = 0;
+            telemetry->value.rpm = 0;
+        }
+        return;
+    }
+
+    //only the newest edge is needed, average period over all new edges is span divided by count of intervals
+    while (edgeState->readIndex != capture->writeIndex) {
+        newestTime = capture->buffer[edgeState->readIndex];
+        edgeState->readIndex = (edgeState->readIndex + 1) % capture->bufferLen;
+        edgeNum++;
+    }
+    telemetry->value.countOfTachEdge += edgeNum;
+
+    if (edgeState->isLastTimeValid) {
+        span = (uint16_t) (newestTime - edgeState->lastTime);
+        intervalNum = edgeNum;
+    } else {
+        span = (uint16_t) (newestTime - firstTime);
+        intervalNum = edgeNum - 1;
+    }
+    edgeState->lastTime = newestTime;
+    edgeState->isLastTimeValid = true;
+    edgeState->idleMs = 0;
+
+    if (intervalNum == 0 || span == 0) {
+        return;
+    }
+
+    //scaled period keeps fraction of average, which matters when many edges come in one update
+    telemetry->tachPeriodFiltered = MotorTelemetry_Filter(telemetry, telemetry->tachPeriodFiltered,
+                                                          ((uint32_t) span << shift) / intervalNum);
+    telemetry->value.rpm = (uint32_t) ((MOTOR_TELEMETRY_US_PER_MINUTE << shift) /
+                                       ((uint64_t) telemetry->tachPeriodFiltered *
+                                        telemetry->config.tachEdgePerRev));
+}
+
+static bool MotorTelemetry_CheckTimeout(T_MotorTelemetry *telemetry, T_MotorTelemetryEdgeState *edgeState)
+{
+    if (!edgeState->isLastTimeValid) {
+        return false;
+    }
+
+    //counter wraps at 65.5 ms, previous edge must be dropped before interval to it can no longer be measured
+    edgeState->idleMs += 1000 / MOTOR_TELEMETRY_UPDATE_FREQ_HZ;
+    if (edgeState->idleMs < telemetry->config.signalTimeoutMs) {
+        return false;
+    }
+
+    edgeState->isLastTimeValid = false;
+
+    return true;
+}
+
+static uint32_t MotorTelemetry_Filter(const T_MotorTelemetry *telemetry, uint32_t filtered, uint32_t scaledSample)
+{
+    //first sample is taken as it is, so value does not ramp up from 0
+    if (filtered == 0) {
+        return scaledSample;
+    }
+
+    return (uint32_t) ((int32_t) filtered +
+                       (((int32_t) scaledSample - (int32_t) filtered) >> telemetry->config.filterShift));
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
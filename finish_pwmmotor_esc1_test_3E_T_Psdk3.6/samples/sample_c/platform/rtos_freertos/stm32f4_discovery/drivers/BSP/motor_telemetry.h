@@ -0,0 +1,99 @@
+/**
+ ********************************************************************
+ * @file    motor_telemetry.h
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   This is the header file for "motor_telemetry.c", defining the structure and
+ * (exported) function prototypes.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef MOTOR_TELEMETRY_H
+#define MOTOR_TELEMETRY_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Exported constants --------------------------------------------------------*/
+//captures are 16 bit counts of 1 us, so intervals must be shorter than 65.5 ms to be measured
+#define MOTOR_TELEMETRY_CAPTURE_FREQ_HZ     1000000
+#define MOTOR_TELEMETRY_UPDATE_FREQ_HZ      1000
+#define MOTOR_TELEMETRY_SIGNAL_TIMEOUT_MAX_MS   60
+#define MOTOR_TELEMETRY_FILTER_SHIFT_MAX    6
+
+//a pulse record is capture of rising edge, followed by capture of latest falling edge taken at the same time
+#define MOTOR_TELEMETRY_PULSE_RECORD_LEN    2
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct {
+    uint8_t filterShift; /*!< Weight of new sample is 1 / 2^filterShift, 0 disables filter. */
+    uint8_t tachEdgePerRev; /*!< Count of tachometer edges per revolution, e.g. pole pairs for ESC telemetry line. */
+    uint16_t signalTimeoutMs; /*!< Time without edge after which signal is regarded lost. */
+} T_MotorTelemetryConfig;
+
+typedef struct {
+    uint16_t pulseWidthUs; /*!< Filtered width of produced pulse, 0 if no pulse. */
+    uint16_t pulsePeriodUs; /*!< Filtered period of produced pulse, 0 if no pulse. */
+    uint32_t rpm; /*!< Filtered speed of motor, 0 if stopped or too slow to be measured. */
+    uint32_t countOfPulse; /*!< Count of measured pulses. */
+    uint32_t countOfTachEdge; /*!< Count of tachometer edges. */
+} T_MotorTelemetryValue;
+
+typedef struct {
+    const uint16_t *buffer; /*!< Circular buffer of captures written by DMA. */
+    uint16_t bufferLen; /*!< Length of buffer, unit: half word. */
+    uint16_t writeIndex; /*!< Index DMA writes next, unit: half word. */
+} T_MotorTelemetryCapture;
+
+typedef struct {
+    uint16_t readIndex;
+    uint16_t lastTime;
+    uint16_t idleMs;
+    bool isLastTimeValid;
+} T_MotorTelemetryEdgeState;
+
+typedef struct {
+    T_MotorTelemetryConfig config;
+    T_MotorTelemetryEdgeState pulse;
+    T_MotorTelemetryEdgeState tach;
+    uint32_t pulseWidthFiltered; /*!< Filtered values are scaled by 2^filterShift, 0 means no sample yet. */
+    uint32_t pulsePeriodFiltered;
+    uint32_t tachPeriodFiltered;
+    T_MotorTelemetryValue value;
+} T_MotorTelemetry;
+
+/* Exported functions --------------------------------------------------------*/
+void MotorTelemetry_Init(T_MotorTelemetry *telemetry, const T_MotorTelemetryConfig *config);
+void MotorTelemetry_Update(T_MotorTelemetry *telemetry, const T_MotorTelemetryCapture *pulseCapture,
+                           const T_MotorTelemetryCapture *tachCapture);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MOTOR_TELEMETRY_H
+/************************ (C) COPYRIGHT DJI Innovations *******END OF FILE******/
@@ -28,6 +28,8 @@
 #include "stm32f4xx_hal.h"
 #include "pps.h"
 #include "osal.h"
+#include "FreeRTOS.h"
+#include "task.h"
 #include "stdio.h"
 #include "dji_logger.h"
 
@@ -42,7 +44,7 @@
 /* Private types -------------------------------------------------------------*/
 
 /* Private values -------------------------------------------------------------*/
-static uint64_t s_ppsNewestTriggerLocalTimeMs = 0;
+static uint64_t s_ppsNewestTriggerLocalTimeUs = 0;
 
 /* Private functions declaration ---------------------------------------------*/
 
@@ -50,30 +52,37 @@ static uint64_t s_ppsNewestTriggerLocalTimeMs = 0;
 void DjiTest_PpsIrqHandler(void)
 {
     T_DjiReturnCode psdkStat;
-    uint32_t timeMs = 0;
+    uint64_t timeUs = 0;
 
     /* EXTI line interrupt detected */
     if (__HAL_GPIO_EXTI_GET_IT(PPS_PIN) != RESET) {
         __HAL_GPIO_EXTI_CLEAR_IT(PPS_PIN);
-        psdkStat = Osal_GetTimeMs(&timeMs);
+        psdkStat = Osal_GetTimeUs(&timeUs);
         if (psdkStat == DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS)
-            s_ppsNewestTriggerLocalTimeMs = timeMs;
+            s_ppsNewestTriggerLocalTimeUs = timeUs;
     }
 }
 
 T_DjiReturnCode DjiTest_GetNewestPpsTriggerLocalTimeUs(uint64_t *localTimeUs)
 {
+    uint64_t ppsNewestTriggerLocalTimeUs;
+
     if (localTimeUs == NULL) {
         USER_LOG_ERROR("input pointer is null.");
         return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
     }
 
-    if (s_ppsNewestTriggerLocalTimeMs == 0) {
+    //64-bit access is not atomic, keep pps interrupt out while reading
+    taskENTER_CRITICAL();
+    ppsNewestTriggerLocalTimeUs = s_ppsNewestTriggerLocalTimeUs;
+    taskEXIT_CRITICAL();
+
+    if (ppsNewestTriggerLocalTimeUs == 0) {
         USER_LOG_WARN("pps have not been triggered.");
         return DJI_ERROR_SYSTEM_MODULE_CODE_BUSY;
     }
 
-    *localTimeUs = (uint64_t) (s_ppsNewestTriggerLocalTimeMs * 1000);
+    *localTimeUs = ppsNewestTriggerLocalTimeUs;
 
     return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
 }
@@ -22,6 +22,7 @@
 #include "stm32f4xx_hal.h"
 #include "stm32f4xx_it.h"
 #include "bsp_debug_usart.h"
+#include "tts_output.h"
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
@@ -203,7 +204,8 @@ void  DEBUG_USART_IRQHandler(void)
 	if(__HAL_UART_GET_FLAG( &UartHandle, UART_FLAG_RXNE ) != RESET)
 	{		
     ch=( uint16_t)READ_REG(UartHandle.Instance->DR);
-    WRITE_REG(UartHandle.Instance->DR,ch); 
+    //speech module only sends status bytes
+    TtsOutput_ReceiveStatusFromIsr(ch);
  
 	}
 }
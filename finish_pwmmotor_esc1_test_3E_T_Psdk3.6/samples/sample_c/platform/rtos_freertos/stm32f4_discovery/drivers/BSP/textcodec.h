@@ -15,6 +15,8 @@
  * 是否启用UTF8、GBK、UNICODE编码之间的转换
  *
  * 注意：unicode编码表非常大，如果用在单片机中，建议优化ff_convert函数，将编码表放到SD卡或者FLASH中
+ * UNICODE转GBK使用textcodec_table.c中的两级页表，GBK转UNICODE按首字节和尾字节直接索引，
+ * 两张表都由project/tools/textcodec_table_gen.py生成，分别约53KB和48KB
  */
 
 /**
@@ -54,7 +56,7 @@ void UTF8ToGBK(const uint8_t* from, uint32_t fromSize, uint8_t* to, uint32_t* to
 
 
 /**
- * @brief GBK码转UTF8码
+ * @brief GBK码转UTF8码，非法序列和GBK中没有的字符转为U+FFFD
  * @param from GBK码
  * @param fromSize GBK码的大小
  * @param to UTF8码
@@ -64,17 +66,17 @@ void GBKToUTF8(const uint8_t* from, uint32_t fromSize, uint8_t* to, uint32_t* to
 
 
 /**
- * @brief UTF8码转GBK码
+ * @brief UTF8码转GBK码，支持2/3/4字节UTF8，非法序列和GBK中没有的字符转为'?'
  * @param from UTF8码
  * @param fromSize UTF8码的大小
- * @param to GBK码
+ * @param to GBK码，GBK码不会比UTF8码长，大小不小于fromSize即可
  * @param toSize GBK码大小
  */
 void UTF8ToGBK(const uint8_t* from, uint32_t fromSize, uint8_t* to, uint32_t* toSize);
 
 
 /**
- * @brief GBK码转双字节UNICODE码
+ * @brief GBK码转双字节UNICODE码，非法序列和GBK中没有的字符转为U+FFFD
  * @param from GBK码
  * @param fromSize GBK码大小
  * @param to UNICODE码
@@ -84,7 +86,7 @@ void GBKToUnicode(const uint8_t* from, uint32_t fromSize, uint8_t* to, uint32_t*
 
 
 /**
- * @brief 双字节UNICODE码转GBK码
+ * @brief 双字节UNICODE码转GBK码，GBK中没有的字符转为'?'
  * @param from 双字节UNICODE码
  * @param fromSize UNICODE码大小
  * @param to GBK码
@@ -94,7 +96,7 @@ void UnicodeToGBK(const uint8_t* from, uint32_t fromSize, uint8_t* to, uint32_t*
 
 
 /**
- * @brief 三字节UTF8码转双字节UNICODE码
+ * @brief UTF8码转双字节UNICODE码，非法序列和超出U+FFFF的字符转为U+FFFD
  * @param from UTF8码
  * @param fromSize UTF8码大小
  * @param to GBK码
@@ -103,7 +105,7 @@ void UnicodeToGBK(const uint8_t* from, uint32_t fromSize, uint8_t* to, uint32_t*
 void UTF8ToUnicode(const uint8_t* from, uint32_t fromSize, uint8_t* to, uint32_t* toSize);
 
 /**
- * @brief 双字节UNICODE码转三字节UTF8码
+ * @brief 双字节UNICODE码转三字节UTF8码，单独的代理区码点转为U+FFFD
  * @param from
  * @param fromSize
  * @param to
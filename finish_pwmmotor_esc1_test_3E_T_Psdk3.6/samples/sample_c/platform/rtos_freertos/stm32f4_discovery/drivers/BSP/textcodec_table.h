@@ -0,0 +1,62 @@
+/**
+ ********************************************************************
+ * @file    textcodec_table.h
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   Unicode to GBK page table, generated by project/tools/textcodec_table_gen.py, do not edit.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef TEXTCODEC_TABLE_H
+#define TEXTCODEC_TABLE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Exported constants --------------------------------------------------------*/
+#define TEXTCODEC_TABLE_PAGE_SIZE                   256
+#define TEXTCODEC_TABLE_UNICODE_TO_GBK_PAGE_NUM     103
+#define TEXTCODEC_TABLE_UNICODE_TO_GBK_CODE_NUM     21791
+#define TEXTCODEC_TABLE_GBK_LEAD_MIN                0x81
+#define TEXTCODEC_TABLE_GBK_LEAD_MAX                0xFE
+#define TEXTCODEC_TABLE_GBK_TRAIL_MIN               0x40
+#define TEXTCODEC_TABLE_GBK_TRAIL_MAX               0xFE
+
+/* Exported types ------------------------------------------------------------*/
+
+/* Exported functions --------------------------------------------------------*/
+//page of code point c is page[index[c >> 8]], entry c & 0xFF of it is GBK code in big endian order, 0 if unmapped
+extern const uint8_t g_textCodecUnicodeToGbkIndex[TEXTCODEC_TABLE_PAGE_SIZE];
+extern const uint16_t g_textCodecUnicodeToGbkPage[TEXTCODEC_TABLE_UNICODE_TO_GBK_PAGE_NUM][TEXTCODEC_TABLE_PAGE_SIZE];
+//code point of GBK code lead, trail is entry [lead - LEAD_MIN][trail - TRAIL_MIN], 0 if unmapped
+extern const uint16_t g_textCodecGbkToUnicode[TEXTCODEC_TABLE_GBK_LEAD_MAX - TEXTCODEC_TABLE_GBK_LEAD_MIN + 1]
+                                             [TEXTCODEC_TABLE_GBK_TRAIL_MAX - TEXTCODEC_TABLE_GBK_TRAIL_MIN + 1];
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TEXTCODEC_TABLE_H
+/************************ (C) COPYRIGHT DJI Innovations *******END OF FILE******/
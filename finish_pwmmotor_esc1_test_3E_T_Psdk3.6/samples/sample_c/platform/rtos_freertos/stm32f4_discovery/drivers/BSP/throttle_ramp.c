@@ -0,0 +1,230 @@
+/**
+ ********************************************************************
+ * @file    throttle_ramp.c
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   Ramp engine that moves a PWM compare value toward its target once per PWM
+ * period, integer only so that it can run in timer interrupt.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "throttle_ramp.h"
+#include <string.h>
+
+/* Private constants ---------------------------------------------------------*/
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private values -------------------------------------------------------------*/
+
+/* Private functions declaration ---------------------------------------------*/
+static void ThrottleRamp_StartSegment(T_ThrottleRamp *ramp, uint16_t target);
+static uint32_t ThrottleRamp_GetProgress(E_ThrottleRampProfile profile, uint32_t distance, uint32_t stepIndex,
+                                         uint32_t stepNum);
+static uint16_t ThrottleRamp_LimitStep(const T_ThrottleRamp *ramp, int32_t next);
+
+/* Exported functions definition ---------------------------------------------*/
+/**
+ * @brief Initialize state of a ramp channel.
+ * @param ramp: pointer to ramp channel.
+ * @param config: pointer to configuration, copied into channel.
+ * @param initValue: compare value output before first target is set.
+ * @return None.
+ */
+void ThrottleRamp_Init(T_ThrottleRamp *ramp, const T_ThrottleRampConfig *config, uint16_t initValue)
+{
+    memset(ramp, 0, sizeof(T_ThrottleRamp));
+    ramp->config = *config;
+    if (ramp->config.rampUpdateNum == 0) {
+        ramp->config.rampUpdateNum = 1;
+    }
+    ramp->target = initValue;
+    ramp->current = initValue;
+    ramp->segmentTarget = initValue;
+    ramp->segmentStart = initValue;
+}
+
+/**
+ * @brief Set target compare value, ramp toward it starts from current value on next update.
+ * @param ramp: pointer to ramp channel.
+ * @param target: target compare value.
+ * @return None.
+ */
+void ThrottleRamp_SetTarget(T_ThrottleRamp *ramp, uint16_t target)
+{
+    //single half word store, update in interrupt sees either old or new target
+    ramp->target = target;
+}
+
+/**
+ * @brief Move output to a value at once, skipping ramp and slew limit, e.g. to stop motor in failsafe.
+ * @note Update must not run meanwhile, call it with update interrupt masked or from the task that runs update.
+ * @param ramp: pointer to ramp channel.
+ * @param value: compare value, output by next update and held.
+ * @return None.
+ */
+void ThrottleRamp_Jump(T_ThrottleRamp *ramp, uint16_t value)
+{
+    ramp->target = value;
+    ramp->current = value;
+    ramp->segmentTarget = value;
+    ramp->segmentStart = value;
+    ramp->stepIndex = 0;
+    ramp->stepNum = 0;
+}
+
+/**
+ * @brief Advance ramp by one update, called once per PWM period from timer update interrupt.
+ * @param ramp: pointer to ramp channel.
+ * @return Compare value to output for next period.
+ */
+uint16_t ThrottleRamp_Update(T_ThrottleRamp *ramp)
+{
+    uint16_t target = ramp->target;
+    int32_t distance;
+    uint32_t progress;
+    int32_t next;
+
+    if (target != ramp->segmentTarget) {
+        ThrottleRamp_StartSegment(ramp, target);
+    }
+
+    if (ramp->current == ramp->segmentTarget) {
+        return ramp->current;
+    }
+
+    distance = (int32_t) ramp->segmentTarget - (int32_t) ramp->current;
+    switch (ramp->config.profile) {
+        case THROTTLE_RAMP_PROFILE_LINEAR:
+        case THROTTLE_RAMP_PROFILE_S_CURVE:
+            ramp->stepIndex++;
+            if (ramp->stepIndex >= ramp->stepNum) {
+                next = ramp->segmentTarget;
+            } else if (ramp->segmentTarget > ramp->segmentStart) {
+                //progress is rounded toward start in both directions, so rising and falling ramps are symmetric
+                progress = ThrottleRamp_GetProgress(ramp->config.profile, ramp->segmentTarget - ramp->segmentStart,
+                                                    ramp->stepIndex, ramp->stepNum);
+                next = (int32_t) ramp->segmentStart + (int32_t) progress;
+            } else {
+                progress = ThrottleRamp_GetProgress(ramp->config.profile, ramp->segmentStart - ramp->segmentTarget,
+                                                    ramp->stepIndex, ramp->stepNum);
+                next = (int32_t) ramp->segmentStart - (int32_t) progress;
+            }
+            break;
+        case THROTTLE_RAMP_PROFILE_EXPONENTIAL:
+            //arithmetic shift rounds toward minus infinity, so move at least one count in either direction
+            if (distance > 0) {
+                next = ramp->current + ((distance >> ramp->config.exponentialShift) > 0 ?
+                                        (distance >> ramp->config.exponentialShift) : 1);
+            } else {
+                next = ramp->current - (((-distance) >> ramp->config.exponentialShift) > 0 ?
+                                        ((-distance) >> ramp->config.exponentialShift) : 1);
+            }
+            break;
+        case THROTTLE_RAMP_PROFILE_NONE:
+        default:
+            next = ramp->segmentTarget;
+            break;
+    }
+
+    ramp->current = ThrottleRamp_LimitStep(ramp, next);
+
+    return ramp->current;
+}
+
+/**
+ * @brief Check whether output has reached target.
+ * @param ramp: pointer to ramp channel.
+ * @return True if output equals target.
+ */
+bool ThrottleRamp_IsSettled(const T_ThrottleRamp *ramp)
+{
+    return ramp->current == ramp->target;
+}
+
+/* Private functions definition-----------------------------------------------*/
+static void ThrottleRamp_StartSegment(T_ThrottleRamp *ramp, uint16_t target)
+{
+    uint32_t distance;
+    uint32_t minStepNum = 0;
+
+    distance = target > ramp->current ? target - ramp->current : ramp->current - target;
+
+    //stretch ramp so that its steepest step stays within slew limit, S-curve is 1.5 times as steep as linear
+    if (ramp->config.maxStepPerUpdate != 0) {
+        if (ramp->config.profile == THROTTLE_RAMP_PROFILE_S_CURVE) {
+            minStepNum = (3 * distance + 2 * ramp->config.maxStepPerUpdate - 1) / (2 * ramp->config.maxStepPerUpdate);
+        } else {
+            minStepNum = (distance + ramp->config.maxStepPerUpdate - 1) / ramp->config.maxStepPerUpdate;
+        }
+    }
+
+    ramp->segmentStart = ramp->current;
+    ramp->segmentTarget = target;
+    ramp->stepIndex = 0;
+    ramp->stepNum = minStepNum > ramp->config.rampUpdateNum ?
+                    (uint16_t) (minStepNum > UINT16_MAX ? UINT16_MAX : minStepNum) : ramp->config.rampUpdateNum;
+}
+
+static uint32_t ThrottleRamp_GetProgress(E_ThrottleRampProfile profile, uint32_t distance, uint32_t stepIndex,
+                                         uint32_t stepNum)
+{
+    uint64_t xQ16;
+    uint64_t x2Q32;
+    uint64_t x3Q48;
+    uint64_t shapeQ16;
+
+    //distance and step index are at most 16 bits, so divisions stay in 32 bits, which update interrupt affords
+    if (profile != THROTTLE_RAMP_PROFILE_S_CURVE) {
+        return distance * stepIndex / stepNum;
+    }
+
+    //smoothstep 3x^2 - 2x^3, x is below 1 here so products fit in 64 bits, rounding once keeps it non-decreasing
+    xQ16 = (stepIndex << 16) / stepNum;
+    x2Q32 = xQ16 * xQ16;
+    x3Q48 = x2Q32 * xQ16;
+    shapeQ16 = (((3 * x2Q32) << 16) - 2 * x3Q48) >> 32;
+
+    return (uint32_t) ((distance * shapeQ16) >> 16);
+}
+
+static uint16_t ThrottleRamp_LimitStep(const T_ThrottleRamp *ramp, int32_t next)
+{
+    int32_t maxStep = ramp->config.maxStepPerUpdate;
+
+    if (maxStep != 0) {
+        if (next > (int32_t) ramp->current + maxStep) {
+            next = (int32_t) ramp->current + maxStep;
+        } else if (next < (int32_t) ramp->current - maxStep) {
+            next = (int32_t) ramp->current - maxStep;
+        }
+    }
+
+    if (next < 0) {
+        next = 0;
+    } else if (next > UINT16_MAX) {
+        next = UINT16_MAX;
+    }
+
+    return (uint16_t) next;
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
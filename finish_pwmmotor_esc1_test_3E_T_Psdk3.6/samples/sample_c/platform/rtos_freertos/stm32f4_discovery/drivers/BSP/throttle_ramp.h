@@ -0,0 +1,79 @@
+/**
+ ********************************************************************
+ * @file    throttle_ramp.h
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   This is the header file for "throttle_ramp.c", defining the structure and
+ * (exported) function prototypes.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef THROTTLE_RAMP_H
+#define THROTTLE_RAMP_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Exported constants --------------------------------------------------------*/
+
+/* Exported types ------------------------------------------------------------*/
+typedef enum {
+    THROTTLE_RAMP_PROFILE_NONE = 0, /*!< Jump to target, only limited by slew rate. */
+    THROTTLE_RAMP_PROFILE_LINEAR, /*!< Constant rate from current value to target. */
+    THROTTLE_RAMP_PROFILE_S_CURVE, /*!< Smoothstep, rate starts and ends at zero. */
+    THROTTLE_RAMP_PROFILE_EXPONENTIAL, /*!< Cover a fixed fraction of remaining distance every update. */
+} E_ThrottleRampProfile;
+
+typedef struct {
+    E_ThrottleRampProfile profile;
+    uint16_t maxStepPerUpdate; /*!< Slew limit, max change of compare value per update, 0 means no limit. */
+    uint16_t rampUpdateNum; /*!< Updates a linear or S-curve ramp takes at least, stretched if slew limit needs. */
+    uint8_t exponentialShift; /*!< Exponential profile covers 1/2^shift of remaining distance every update. */
+} T_ThrottleRampConfig;
+
+typedef struct {
+    T_ThrottleRampConfig config;
+    volatile uint16_t target; /*!< Written by task, taken by next update. */
+    uint16_t current; /*!< Compare value output by last update. */
+    uint16_t segmentTarget;
+    uint16_t segmentStart;
+    uint16_t stepIndex;
+    uint16_t stepNum;
+} T_ThrottleRamp;
+
+/* Exported functions --------------------------------------------------------*/
+void ThrottleRamp_Init(T_ThrottleRamp *ramp, const T_ThrottleRampConfig *config, uint16_t initValue);
+void ThrottleRamp_SetTarget(T_ThrottleRamp *ramp, uint16_t target);
+void ThrottleRamp_Jump(T_ThrottleRamp *ramp, uint16_t value);
+uint16_t ThrottleRamp_Update(T_ThrottleRamp *ramp);
+bool ThrottleRamp_IsSettled(const T_ThrottleRamp *ramp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // THROTTLE_RAMP_H
+/************************ (C) COPYRIGHT DJI Innovations *******END OF FILE******/
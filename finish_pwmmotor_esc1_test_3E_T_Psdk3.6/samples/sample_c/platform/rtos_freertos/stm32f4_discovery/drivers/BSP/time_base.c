@@ -0,0 +1,130 @@
+/**
+ ********************************************************************
+ * @file    time_base.c
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   Monotonic 64-bit microsecond time base. TIM2 is a free-running 32-bit counter at 1MHz,
+ *          its update interrupt extends the counter to 64 bits.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "time_base.h"
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+
+/* Private constants ---------------------------------------------------------*/
+#define TIME_BASE_TIM                   TIM2
+#define TIME_BASE_TIM_IRQn              TIM2_IRQn
+#define TIME_BASE_TIM_IRQHandler        TIM2_IRQHandler
+#define TIME_BASE_TIM_CLK_ENABLE()      __HAL_RCC_TIM2_CLK_ENABLE()
+#define TIME_BASE_COUNTER_FREQ_HZ       1000000
+
+//same as syscall interrupt priority, so update interrupt is masked while time is being read by task
+#define TIME_BASE_IRQ_PRIO_PRE          configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+#define TIME_BASE_IRQ_PRIO_SUB          0
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private values -------------------------------------------------------------*/
+static TIM_HandleTypeDef s_timeBaseHandle;
+static volatile uint32_t s_timeBaseHigh = 0;
+
+/* Private functions declaration ---------------------------------------------*/
+static uint32_t TimeBase_GetTimerClockFreq(void);
+
+/* Exported functions definition ---------------------------------------------*/
+/**
+ * @brief Time base initialization, must be called after system clock has been configured.
+ * @return None.
+ */
+void TimeBase_Init(void)
+{
+    TIME_BASE_TIM_CLK_ENABLE();
+
+    s_timeBaseHandle.Instance = TIME_BASE_TIM;
+    s_timeBaseHandle.Init.Prescaler = TimeBase_GetTimerClockFreq() / TIME_BASE_COUNTER_FREQ_HZ - 1;
+    s_timeBaseHandle.Init.CounterMode = TIM_COUNTERMODE_UP;
+    s_timeBaseHandle.Init.Period = 0xFFFFFFFF;
+    s_timeBaseHandle.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    s_timeBaseHandle.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+    HAL_TIM_Base_Init(&s_timeBaseHandle);
+
+    //update event generated by init loads prescaler, it is not an overflow
+    __HAL_TIM_CLEAR_FLAG(&s_timeBaseHandle, TIM_FLAG_UPDATE);
+    s_timeBaseHigh = 0;
+
+    HAL_NVIC_SetPriority(TIME_BASE_TIM_IRQn, TIME_BASE_IRQ_PRIO_PRE, TIME_BASE_IRQ_PRIO_SUB);
+    HAL_NVIC_EnableIRQ(TIME_BASE_TIM_IRQn);
+    __HAL_TIM_ENABLE_IT(&s_timeBaseHandle, TIM_IT_UPDATE);
+    __HAL_TIM_ENABLE(&s_timeBaseHandle);
+}
+
+/**
+ * @brief Get time since time base initialization, can be called from task and any interrupt.
+ * @note Overflow that has happened but not been handled by update interrupt yet, e.g. called in critical section
+ * or from interrupt with higher priority, is taken into account by checking update flag.
+ * @return Time, unit: us.
+ */
+uint64_t TimeBase_GetUs(void)
+{
+    UBaseType_t intStatus;
+    uint32_t high;
+    uint32_t counter;
+
+    intStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    high = s_timeBaseHigh;
+    counter = TIME_BASE_TIM->CNT;
+    //counter must be read before flag, a small counter with flag set means overflow is pending
+    if ((TIME_BASE_TIM->SR & TIM_SR_UIF) != 0 && counter < 0x80000000U) {
+        high++;
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(intStatus);
+
+    return ((uint64_t) high << 32) | counter;
+}
+
+/**
+ * @brief Update interrupt of time base timer, extends counter to 64 bits.
+ * @return None.
+ */
+void TIME_BASE_TIM_IRQHandler(void)
+{
+    if ((TIME_BASE_TIM->SR & TIM_SR_UIF) != 0) {
+        //interrupt with higher priority must not see flag cleared before high word is increased
+        __disable_irq();
+        s_timeBaseHigh++;
+        TIME_BASE_TIM->SR = ~TIM_SR_UIF;
+        __enable_irq();
+    }
+}
+
+/* Private functions definition-----------------------------------------------*/
+static uint32_t TimeBase_GetTimerClockFreq(void)
+{
+    //timers on APB1 run at twice of PCLK1 when APB1 prescaler is not 1
+    if ((RCC->CFGR & RCC_CFGR_PPRE1) == RCC_HCLK_DIV1) {
+        return HAL_RCC_GetPCLK1Freq();
+    }
+
+    return HAL_RCC_GetPCLK1Freq() * 2;
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
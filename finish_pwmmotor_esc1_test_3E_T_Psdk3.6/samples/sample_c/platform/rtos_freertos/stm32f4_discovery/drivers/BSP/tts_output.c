@@ -0,0 +1,463 @@
+/**
+ ********************************************************************
+ * @file    tts_output.c
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   Announcement queue of SYN speech synthesis module. Frames are sent by DMA and next one
+ *          is started when status byte of module reports idle, instead of after a fixed delay.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "tts_output.h"
+#include "bsp_debug_usart.h"
+#include "time_base.h"
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "task.h"
+
+/* Private constants ---------------------------------------------------------*/
+#define TTS_OUTPUT_TASK_STACK_SIZE          256
+#define TTS_OUTPUT_TASK_PRIORITY            1
+#define TTS_OUTPUT_STATUS_QUEUE_LEN         8
+
+#define TTS_OUTPUT_EVENT_REQUEST            (1UL << 0)
+#define TTS_OUTPUT_EVENT_TRANSMIT_COMPLETE  (1UL << 1)
+#define TTS_OUTPUT_EVENT_STATUS             (1UL << 2)
+
+//longest frame takes 140 ms at 9600 baud, module answers a frame in a few ms and speaks about 4 characters of 2 bytes
+//per second, timeouts only recover from lost status bytes
+#define TTS_OUTPUT_TRANSMIT_TIMEOUT_MS      500
+#define TTS_OUTPUT_RECEIVED_TIMEOUT_MS      500
+#define TTS_OUTPUT_SPEAK_TIMEOUT_BASE_MS    2000
+#define TTS_OUTPUT_SPEAK_TIMEOUT_BYTE_MS    250
+
+/* Private types -------------------------------------------------------------*/
+typedef enum {
+    TTS_OUTPUT_LINK_STATE_IDLE = 0,
+    TTS_OUTPUT_LINK_STATE_TRANSMITTING,
+    TTS_OUTPUT_LINK_STATE_WAIT_RECEIVED,
+    TTS_OUTPUT_LINK_STATE_SPEAKING,
+} E_TtsOutputLinkState;
+
+typedef struct {
+    bool isUsed;
+    uint8_t priority;
+    uint16_t textLen;
+    uint32_t sequence;
+    uint64_t enqueueTimeUs;
+    uint8_t text[TTS_OUTPUT_TEXT_MAX_LEN];
+} T_TtsOutputRequest;
+
+typedef struct {
+    E_TtsOutputLinkState linkState;
+    bool isStopFrame; /*!< Frame on link is stop command, not an announcement. */
+    uint8_t priority; /*!< Priority of announcement on link. */
+    uint16_t textLen;
+    TickType_t deadline;
+    uint64_t transmitStartUs;
+} T_TtsOutputLink;
+
+/* Private values -------------------------------------------------------------*/
+static TaskHandle_t s_ttsOutputTask = NULL;
+static QueueHandle_t s_ttsOutputStatusQueue = NULL;
+static T_TtsOutputRequest s_ttsOutputRequest[TTS_OUTPUT_QUEUE_LEN];
+static uint32_t s_ttsOutputSequence = 0;
+static T_TtsOutputLink s_ttsOutputLink = {0};
+//DMA reads frame after transmission is started, so frames must not live on stack
+static uint8_t s_ttsOutputFrame[TTS_OUTPUT_FRAME_MAX_LEN];
+static const uint8_t s_ttsOutputStopFrame[] = {TTS_OUTPUT_FRAME_HEAD, 0x00, 0x01, TTS_OUTPUT_COMMAND_STOP};
+static T_TtsOutputState s_ttsOutputState = {0};
+static uint64_t s_ttsOutputSumOfWaitMs = 0;
+static uint64_t s_ttsOutputSumOfTransmitUs = 0;
+static uint32_t s_ttsOutputCountOfWait = 0;
+
+/* Private functions declaration ---------------------------------------------*/
+static void TtsOutput_Task(void *arg);
+static int8_t TtsOutput_FindNextRequest(void);
+static void TtsOutput_StartNext(void);
+static void TtsOutput_StartStop(void);
+static void TtsOutput_OnTransmitComplete(void);
+static void TtsOutput_OnStatus(uint8_t status);
+static void TtsOutput_OnTimeout(void);
+static void TtsOutput_SetLinkState(E_TtsOutputLinkState linkState, uint32_t timeoutMs);
+
+/* Exported functions definition ---------------------------------------------*/
+/**
+ * @brief Create task of announcement queue, debug UART must have been configured.
+ * @return Execution result.
+ */
+T_DjiReturnCode TtsOutput_Init(void)
+{
+    if (s_ttsOutputTask != NULL) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NONSUPPORT_IN_CURRENT_STATE;
+    }
+
+    s_ttsOutputStatusQueue = xQueueCreate(TTS_OUTPUT_STATUS_QUEUE_LEN, sizeof(uint8_t));
+    if (s_ttsOutputStatusQueue == NULL) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_MEMORY_ALLOC_FAILED;
+    }
+
+    if (xTaskCreate(TtsOutput_Task, "tts_output", TTS_OUTPUT_TASK_STACK_SIZE, NULL, TTS_OUTPUT_TASK_PRIORITY,
+                    &s_ttsOutputTask) != pdPASS) {
+        vQueueDelete(s_ttsOutputStatusQueue);
+        s_ttsOutputStatusQueue = NULL;
+        s_ttsOutputTask = NULL;
+        return DJI_ERROR_SYSTEM_MODULE_CODE_MEMORY_ALLOC_FAILED;
+    }
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+/**
+ * @brief Queue an announcement and return without waiting for transmission.
+ * @note When queue is full, the newest announcement of lowest priority is dropped to make room, if its priority is
+ *       lower than the one queued.
+ * @param gbkText: text in GBK encoding, copied into queue.
+ * @param len: length of text, unit: byte.
+ * @param priority: priority of announcement.
+ * @return Execution result, DJI_ERROR_SYSTEM_MODULE_CODE_BUSY if queue is full of announcements not of lower priority.
+ */
+T_DjiReturnCode TtsOutput_Speak(const uint8_t *gbkText, uint16_t len, E_TtsOutputPriority priority)
+{
+    T_TtsOutputRequest *request = NULL;
+    T_TtsOutputRequest *victim = NULL;
+    uint64_t timeUs;
+    uint8_t i;
+
+    if (gbkText == NULL || len == 0 || len > TTS_OUTPUT_TEXT_MAX_LEN || priority >= TTS_OUTPUT_PRIORITY_NUM) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    if (s_ttsOutputTask == NULL) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NONSUPPORT_IN_CURRENT_STATE;
+    }
+
+    timeUs = TimeBase_GetUs();
+
+    taskENTER_CRITICAL();
+    for (i = 0; i < TTS_OUTPUT_QUEUE_LEN; i++) {
+        if (!s_ttsOutputRequest[i].isUsed) {
+            request = &s_ttsOutputRequest[i];
+            break;
+        }
+        if (victim == NULL || s_ttsOutputRequest[i].priority < victim->priority ||
+            (s_ttsOutputRequest[i].priority == victim->priority &&
+             (int32_t) (s_ttsOutputRequest[i].sequence - victim->sequence) > 0)) {
+            victim = &s_ttsOutputRequest[i];
+        }
+    }
+
+    if (request == NULL) {
+        s_ttsOutputState.countOfDropped++;
+        if (victim->priority >= priority) {
+            taskEXIT_CRITICAL();
+            return DJI_ERROR_SYSTEM_MODULE_CODE_BUSY;
+        }
+        request = victim;
+        s_ttsOutputState.queueDepth--;
+    }
+
+    request->isUsed = true;
+    request->priority = (uint8_t) priority;
+    request->textLen = len;
+    request->sequence = s_ttsOutputSequence++;
+    request->enqueueTimeUs = timeUs;
+    memcpy(request->text, gbkText, len);
+    s_ttsOutputState.queueDepth++;
+    if (s_ttsOutputState.queueDepth > s_ttsOutputState.maxQueueDepth) {
+        s_ttsOutputState.maxQueueDepth = s_ttsOutputState.queueDepth;
+    }
+    taskEXIT_CRITICAL();
+
+    xTaskNotify(s_ttsOutputTask, TTS_OUTPUT_EVENT_REQUEST, eSetBits);
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+/**
+ * @brief Get queue and link state, for report.
+ * @param state: queue and link state.
+ * @return None.
+ */
+void TtsOutput_GetState(T_TtsOutputState *state)
+{
+    taskENTER_CRITICAL();
+    *state = s_ttsOutputState;
+    state->averageWaitMs = s_ttsOutputCountOfWait != 0 ?
+                           (uint32_t) (s_ttsOutputSumOfWaitMs / s_ttsOutputCountOfWait) : 0;
+    state->transmitBytesPerSecond = s_ttsOutputSumOfTransmitUs != 0 ?
+                                    (uint32_t) ((uint64_t) s_ttsOutputState.countOfTransmittedByte * 1000000 /
+                                                s_ttsOutputSumOfTransmitUs) : 0;
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Report end of DMA transmission of a frame, called from interrupt of transmit DMA stream.
+ * @return None.
+ */
+void TtsOutput_TransmitCompleteFromIsr(void)
+{
+    BaseType_t isHigherPriorityTaskWoken = pdFALSE;
+
+    if (s_ttsOutputTask == NULL) {
+        return;
+    }
+
+    xTaskNotifyFromISR(s_ttsOutputTask, TTS_OUTPUT_EVENT_TRANSMIT_COMPLETE, eSetBits, &isHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(isHigherPriorityTaskWoken);
+}
+
+/**
+ * @brief Report a status byte received from module, called from receive interrupt of UART.
+ * @param status: status byte, TTS_OUTPUT_STATUS_*.
+ * @return None.
+ */
+void TtsOutput_ReceiveStatusFromIsr(uint8_t status)
+{
+    BaseType_t isHigherPriorityTaskWoken = pdFALSE;
+
+    if (s_ttsOutputTask == NULL) {
+        return;
+    }
+
+    //a full queue drops the byte, lost idle status is recovered by speak timeout
+    xQueueSendFromISR(s_ttsOutputStatusQueue, &status, &isHigherPriorityTaskWoken);
+    xTaskNotifyFromISR(s_ttsOutputTask, TTS_OUTPUT_EVENT_STATUS, eSetBits, &isHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(isHigherPriorityTaskWoken);
+}
+
+/* Private functions definition-----------------------------------------------*/
+#ifndef __CC_ARM
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-noreturn"
+#pragma GCC diagnostic ignored "-Wreturn-type"
+#endif
+
+static void TtsOutput_Task(void *arg)
+{
+    uint32_t event;
+    uint8_t status;
+    int8_t next;
+    TickType_t timeout;
+    TickType_t now;
+
+    (void) arg;
+
+    while (1) {
+        if (s_ttsOutputLink.linkState == TTS_OUTPUT_LINK_STATE_IDLE) {
+            timeout = portMAX_DELAY;
+        } else {
+            now = xTaskGetTickCount();
+            timeout = (int32_t) (s_ttsOutputLink.deadline - now) > 0 ? s_ttsOutputLink.deadline - now : 0;
+        }
+        event = 0;
+        xTaskNotifyWait(0, UINT32_MAX, &event, timeout);
+
+        //transmit complete always comes before status answering the frame
+        if ((event & TTS_OUTPUT_EVENT_TRANSMIT_COMPLETE) != 0) {
+            TtsOutput_OnTransmitComplete();
+        }
+        while (xQueueReceive(s_ttsOutputStatusQueue, &status, 0) == pdTRUE) {
+            TtsOutput_OnStatus(status);
+        }
+        if (s_ttsOutputLink.linkState != TTS_OUTPUT_LINK_STATE_IDLE &&
+            (int32_t) (xTaskGetTickCount() - s_ttsOutputLink.deadline) >= 0) {
+            TtsOutput_OnTimeout();
+        }
+
+        if (s_ttsOutputLink.linkState == TTS_OUTPUT_LINK_STATE_IDLE) {
+            TtsOutput_StartNext();
+        } else if (!s_ttsOutputLink.isStopFrame &&
+                   (s_ttsOutputLink.linkState == TTS_OUTPUT_LINK_STATE_WAIT_RECEIVED ||
+                    s_ttsOutputLink.linkState == TTS_OUTPUT_LINK_STATE_SPEAKING)) {
+            next = TtsOutput_FindNextRequest();
+            if (next >= 0 && s_ttsOutputRequest[next].priority > s_ttsOutputLink.priority) {
+                TtsOutput_StartStop();
+            }
+        }
+    }
+}
+
+#ifndef __CC_ARM
+#pragma GCC diagnostic pop
+#endif
+
+static int8_t TtsOutput_FindNextRequest(void)
+{
+    int8_t next = -1;
+    uint8_t i;
+
+    taskENTER_CRITICAL();
+    for (i = 0; i < TTS_OUTPUT_QUEUE_LEN; i++) {
+        if (!s_ttsOutputRequest[i].isUsed) {
+            continue;
+        }
+        if (next < 0 || s_ttsOutputRequest[i].priority > s_ttsOutputRequest[next].priority ||
+            (s_ttsOutputRequest[i].priority == s_ttsOutputRequest[next].priority &&
+             (int32_t) (s_ttsOutputRequest[i].sequence - s_ttsOutputRequest[next].sequence) < 0)) {
+            next = (int8_t) i;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return next;
+}
+
+static void TtsOutput_StartNext(void)
+{
+    T_TtsOutputRequest *request;
+    uint64_t timeUs;
+    uint32_t waitMs;
+    int8_t next;
+
+    next = TtsOutput_FindNextRequest();
+    if (next < 0) {
+        return;
+    }
+
+    request = &s_ttsOutputRequest[next];
+    timeUs = TimeBase_GetUs();
+
+    //only this task releases requests, so the slot found stays valid until released here
+    s_ttsOutputFrame[0] = TTS_OUTPUT_FRAME_HEAD;
+    s_ttsOutputFrame[1] = (uint8_t) ((request->textLen + 2) >> 8);
+    s_ttsOutputFrame[2] = (uint8_t) (request->textLen + 2);
+    s_ttsOutputFrame[3] = TTS_OUTPUT_COMMAND_SYNTHESIS;
+    s_ttsOutputFrame[4] = TTS_OUTPUT_ENCODING_GBK;
+    taskENTER_CRITICAL();
+    memcpy(&s_ttsOutputFrame[5], request->text, request->textLen);
+    s_ttsOutputLink.priority = request->priority;
+    s_ttsOutputLink.textLen = request->textLen;
+    waitMs = timeUs > request->enqueueTimeUs ? (uint32_t) ((timeUs - request->enqueueTimeUs) / 1000) : 0;
+    request->isUsed = false;
+    s_ttsOutputState.queueDepth--;
+    s_ttsOutputCountOfWait++;
+    s_ttsOutputSumOfWaitMs += waitMs;
+    if (waitMs > s_ttsOutputState.maxWaitMs) {
+        s_ttsOutputState.maxWaitMs = waitMs;
+    }
+    taskEXIT_CRITICAL();
+
+    s_ttsOutputLink.isStopFrame = false;
+    s_ttsOutputLink.transmitStartUs = timeUs;
+    TtsOutput_SetLinkState(TTS_OUTPUT_LINK_STATE_TRANSMITTING, TTS_OUTPUT_TRANSMIT_TIMEOUT_MS);
+    Usart_SendStringDma(s_ttsOutputFrame, (uint16_t) (TTS_OUTPUT_FRAME_HEADER_LEN + 2 + s_ttsOutputLink.textLen));
+}
+
+static void TtsOutput_StartStop(void)
+{
+    taskENTER_CRITICAL();
+    s_ttsOutputState.countOfPreempted++;
+    taskEXIT_CRITICAL();
+
+    s_ttsOutputLink.isStopFrame = true;
+    s_ttsOutputLink.transmitStartUs = TimeBase_GetUs();
+    TtsOutput_SetLinkState(TTS_OUTPUT_LINK_STATE_TRANSMITTING, TTS_OUTPUT_TRANSMIT_TIMEOUT_MS);
+    Usart_SendStringDma(s_ttsOutputStopFrame, sizeof(s_ttsOutputStopFrame));
+}
+
+static void TtsOutput_OnTransmitComplete(void)
+{
+    uint64_t timeUs = TimeBase_GetUs();
+    uint16_t frameLen;
+
+    if (s_ttsOutputLink.linkState != TTS_OUTPUT_LINK_STATE_TRANSMITTING) {
+        return;
+    }
+
+    frameLen = s_ttsOutputLink.isStopFrame ? sizeof(s_ttsOutputStopFrame) :
+               (uint16_t) (TTS_OUTPUT_FRAME_HEADER_LEN + 2 + s_ttsOutputLink.textLen);
+    taskENTER_CRITICAL();
+    s_ttsOutputState.countOfTransmittedByte += frameLen;
+    s_ttsOutputSumOfTransmitUs += timeUs - s_ttsOutputLink.transmitStartUs;
+    taskEXIT_CRITICAL();
+
+    TtsOutput_SetLinkState(TTS_OUTPUT_LINK_STATE_WAIT_RECEIVED, TTS_OUTPUT_RECEIVED_TIMEOUT_MS);
+}
+
+static void TtsOutput_OnStatus(uint8_t status)
+{
+    switch (status) {
+        case TTS_OUTPUT_STATUS_RECEIVED:
+            if (s_ttsOutputLink.linkState != TTS_OUTPUT_LINK_STATE_WAIT_RECEIVED) {
+                break;
+            }
+            if (s_ttsOutputLink.isStopFrame) {
+                TtsOutput_SetLinkState(TTS_OUTPUT_LINK_STATE_IDLE, 0);
+                break;
+            }
+            taskENTER_CRITICAL();
+            s_ttsOutputState.countOfAnnouncement++;
+            s_ttsOutputState.isModuleBusy = true;
+            taskEXIT_CRITICAL();
+            TtsOutput_SetLinkState(TTS_OUTPUT_LINK_STATE_SPEAKING, TTS_OUTPUT_SPEAK_TIMEOUT_BASE_MS +
+                                                                   (uint32_t) s_ttsOutputLink.textLen *
+                                                                   TTS_OUTPUT_SPEAK_TIMEOUT_BYTE_MS);
+            break;
+        case TTS_OUTPUT_STATUS_ERROR:
+            if (s_ttsOutputLink.linkState != TTS_OUTPUT_LINK_STATE_WAIT_RECEIVED) {
+                break;
+            }
+            taskENTER_CRITICAL();
+            s_ttsOutputState.countOfError++;
+            taskEXIT_CRITICAL();
+            TtsOutput_SetLinkState(TTS_OUTPUT_LINK_STATE_IDLE, 0);
+            break;
+        case TTS_OUTPUT_STATUS_IDLE:
+        case TTS_OUTPUT_STATUS_INIT_DONE:
+            //module reset in the middle of a frame never answers it
+            taskENTER_CRITICAL();
+            s_ttsOutputState.isModuleBusy = false;
+            taskEXIT_CRITICAL();
+            if (s_ttsOutputLink.linkState == TTS_OUTPUT_LINK_STATE_SPEAKING ||
+                (status == TTS_OUTPUT_STATUS_INIT_DONE &&
+                 s_ttsOutputLink.linkState == TTS_OUTPUT_LINK_STATE_WAIT_RECEIVED)) {
+                TtsOutput_SetLinkState(TTS_OUTPUT_LINK_STATE_IDLE, 0);
+            }
+            break;
+        case TTS_OUTPUT_STATUS_BUSY:
+            taskENTER_CRITICAL();
+            s_ttsOutputState.isModuleBusy = true;
+            taskEXIT_CRITICAL();
+            break;
+        default:
+            break;
+    }
+}
+
+static void TtsOutput_OnTimeout(void)
+{
+    taskENTER_CRITICAL();
+    s_ttsOutputState.countOfError++;
+    s_ttsOutputState.isModuleBusy = false;
+    taskEXIT_CRITICAL();
+
+    TtsOutput_SetLinkState(TTS_OUTPUT_LINK_STATE_IDLE, 0);
+}
+
+static void TtsOutput_SetLinkState(E_TtsOutputLinkState linkState, uint32_t timeoutMs)
+{
+    s_ttsOutputLink.linkState = linkState;
+    s_ttsOutputLink.deadline = xTaskGetTickCount() + pdMS_TO_TICKS(timeoutMs);
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
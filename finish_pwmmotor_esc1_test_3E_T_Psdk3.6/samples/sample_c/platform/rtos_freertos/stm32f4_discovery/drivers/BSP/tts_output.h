@@ -0,0 +1,93 @@
+/**
+ ********************************************************************
+ * @file    tts_output.h
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   Announcement queue of SYN speech synthesis module on debug UART.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef TTS_OUTPUT_H
+#define TTS_OUTPUT_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "dji_typedef.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Exported constants --------------------------------------------------------*/
+//frame is FD, length high, length low, command, then parameters; length counts command and parameters
+#define TTS_OUTPUT_FRAME_HEAD               0xFD
+#define TTS_OUTPUT_FRAME_HEADER_LEN         3
+#define TTS_OUTPUT_COMMAND_SYNTHESIS        0x01
+#define TTS_OUTPUT_COMMAND_STOP             0x02
+#define TTS_OUTPUT_COMMAND_QUERY            0x21
+#define TTS_OUTPUT_ENCODING_GBK             0x01
+
+//status byte sent back by module
+#define TTS_OUTPUT_STATUS_INIT_DONE         0x4A
+#define TTS_OUTPUT_STATUS_RECEIVED          0x41
+#define TTS_OUTPUT_STATUS_ERROR             0x45
+#define TTS_OUTPUT_STATUS_BUSY              0x4E
+#define TTS_OUTPUT_STATUS_IDLE              0x4F
+
+#define TTS_OUTPUT_TEXT_MAX_LEN             128
+#define TTS_OUTPUT_FRAME_MAX_LEN            (TTS_OUTPUT_FRAME_HEADER_LEN + 2 + TTS_OUTPUT_TEXT_MAX_LEN)
+#define TTS_OUTPUT_QUEUE_LEN                8
+
+/* Exported types ------------------------------------------------------------*/
+//announcement being spoken is stopped as soon as one of higher priority is queued, equal priorities are spoken in order
+typedef enum {
+    TTS_OUTPUT_PRIORITY_LOW = 0,
+    TTS_OUTPUT_PRIORITY_NORMAL,
+    TTS_OUTPUT_PRIORITY_HIGH,
+    TTS_OUTPUT_PRIORITY_NUM,
+} E_TtsOutputPriority;
+
+typedef struct {
+    bool isModuleBusy; /*!< Module is speaking, according to its latest status byte. */
+    uint8_t queueDepth; /*!< Announcements waiting, not counting the one being spoken. */
+    uint8_t maxQueueDepth;
+    uint32_t countOfAnnouncement; /*!< Announcements accepted by module. */
+    uint32_t countOfPreempted; /*!< Announcements stopped by one of higher priority. */
+    uint32_t countOfDropped; /*!< Announcements rejected or evicted because queue was full. */
+    uint32_t countOfError; /*!< Frames refused by module or answered by no status in time. */
+    uint32_t averageWaitMs; /*!< Average time from enqueue to start of transmission. */
+    uint32_t maxWaitMs;
+    uint32_t countOfTransmittedByte;
+    uint32_t transmitBytesPerSecond; /*!< Rate of DMA transmission, should be close to UART line rate. */
+} T_TtsOutputState;
+
+/* Exported functions --------------------------------------------------------*/
+T_DjiReturnCode TtsOutput_Init(void);
+T_DjiReturnCode TtsOutput_Speak(const uint8_t *gbkText, uint16_t len, E_TtsOutputPriority priority);
+void TtsOutput_GetState(T_TtsOutputState *state);
+void TtsOutput_TransmitCompleteFromIsr(void);
+void TtsOutput_ReceiveStatusFromIsr(uint8_t status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TTS_OUTPUT_H
+/************************ (C) COPYRIGHT DJI Innovations *******END OF FILE******/
@@ -28,11 +28,22 @@
 #include "uart.h"
 #include "stm32f4xx_hal.h"
 #include "dji_ringbuffer.h"
+#include "dji_mp_ringbuffer.h"
+#include "uart_rx_dma.h"
 #include "FreeRTOS.h"
 #include "task.h"
 #include "osal.h"
 
 /* Private typedef -----------------------------------------------------------*/
+typedef struct {
+    DMA_HandleTypeDef dmaHandle;
+    uint16_t lastPosition; /*!< Ring buffer offset the DMA had reached on last update. */
+} T_UartRxDma;
+
+typedef struct {
+    DMA_HandleTypeDef dmaHandle;
+    uint32_t transferLen; /*!< Length of write buffer span in flight, 0 when DMA is idle. */
+} T_UartTxDma;
 
 /* Private define ------------------------------------------------------------*/
 //uart uart buffer size define
@@ -43,6 +54,51 @@
 #define UART3_READ_BUF_SIZE      8192
 #define UART3_WRITE_BUF_SIZE     2048
 
+//uart receive dma stream define, refer to DMA request mapping of reference manual
+#define UART1_RX_DMA_STREAM      DMA2_Stream2
+#define UART1_RX_DMA_CHANNEL     DMA_CHANNEL_4
+#define UART1_RX_DMA_IRQn        DMA2_Stream2_IRQn
+#define UART1_RX_DMA_IRQHandler  DMA2_Stream2_IRQHandler
+#define UART2_RX_DMA_STREAM      DMA1_Stream5
+#define UART2_RX_DMA_CHANNEL     DMA_CHANNEL_4
+#define UART2_RX_DMA_IRQn        DMA1_Stream5_IRQn
+#define UART2_RX_DMA_IRQHandler  DMA1_Stream5_IRQHandler
+#define UART3_RX_DMA_STREAM      DMA1_Stream1
+#define UART3_RX_DMA_CHANNEL     DMA_CHANNEL_4
+#define UART3_RX_DMA_IRQn        DMA1_Stream1_IRQn
+#define UART3_RX_DMA_IRQHandler  DMA1_Stream1_IRQHandler
+
+//uart transmit dma stream define
+#define UART1_TX_DMA_STREAM      DMA2_Stream7
+#define UART1_TX_DMA_CHANNEL     DMA_CHANNEL_4
+#define UART1_TX_DMA_IRQn        DMA2_Stream7_IRQn
+#define UART1_TX_DMA_IRQHandler  DMA2_Stream7_IRQHandler
+#define UART2_TX_DMA_STREAM      DMA1_Stream6
+#define UART2_TX_DMA_CHANNEL     DMA_CHANNEL_4
+#define UART2_TX_DMA_IRQn        DMA1_Stream6_IRQn
+#define UART2_TX_DMA_IRQHandler  DMA1_Stream6_IRQHandler
+#define UART3_TX_DMA_STREAM      DMA1_Stream3
+#define UART3_TX_DMA_CHANNEL     DMA_CHANNEL_4
+#define UART3_TX_DMA_IRQn        DMA1_Stream3_IRQn
+#define UART3_TX_DMA_IRQHandler  DMA1_Stream3_IRQHandler
+
+//NDTR of DMA stream is 16 bits
+#define UART_TX_DMA_TRANSFER_LEN_MAX    0xFFFF
+
+//same preemption priority as the USART interrupts, so that IDLE and DMA events never nest
+#define UART_DMA_IRQ_PRIO_PRE    5
+#define UART_DMA_IRQ_PRIO_SUB    0
+
+#if (UART1_RX_MODE == UART_RX_MODE_DMA) || (UART2_RX_MODE == UART_RX_MODE_DMA) || \
+    (UART3_RX_MODE == UART_RX_MODE_DMA)
+#define UART_RX_DMA_USED
+#endif
+
+#if (UART1_TX_MODE == UART_TX_MODE_DMA) || (UART2_TX_MODE == UART_TX_MODE_DMA) || \
+    (UART3_TX_MODE == UART_TX_MODE_DMA)
+#define UART_TX_DMA_USED
+#endif
+
 /* Private macro -------------------------------------------------------------*/
 
 /* Private variables ---------------------------------------------------------*/
@@ -51,14 +107,27 @@
 static T_RingBuffer s_uart1ReadRingBuffer;
 //USART1 read buffer state
 static T_UartBufferState s_uart1ReadBufferState;
-//UART1 write ring buffer structure
-static T_RingBuffer s_uart1WriteRingBuffer;
+//UART1 write ring buffer structure, written by several tasks without lock
+static T_MpRingBuffer s_uart1WriteRingBuffer;
 //USART1 write buffer state
 static T_UartBufferState s_uart1WriteBufferState;
 //UART1 read buffer
+#if (UART1_RX_MODE == UART_RX_MODE_DMA)
+//DMA controller can not access CCMRAM, so DMA target buffer is kept in main SRAM
+static uint8_t s_uart1ReadBuf[UART1_READ_BUF_SIZE];
+//UART1 receive DMA
+static T_UartRxDma s_uart1RxDma;
+#else
 CCMRAM static uint8_t s_uart1ReadBuf[UART1_READ_BUF_SIZE];
+#endif
 //UART1 write buffer
+#if (UART1_TX_MODE == UART_TX_MODE_DMA)
+static uint8_t s_uart1WriteBuf[UART1_WRITE_BUF_SIZE];
+//UART1 transmit DMA
+static T_UartTxDma s_uart1TxDma;
+#else
 CCMRAM static uint8_t s_uart1WriteBuf[UART1_WRITE_BUF_SIZE];
+#endif
 
 //UART1 mutex
 static T_DjiMutexHandle s_uart1Mutex;
@@ -69,10 +138,20 @@ static UART_HandleTypeDef s_uart1Handle;
 #ifdef USING_UART_PORT_2
 static T_RingBuffer s_uart2ReadRingBuffer;
 static T_UartBufferState s_uart2ReadBufferState;
-static T_RingBuffer s_uart2WriteRingBuffer;
+static T_MpRingBuffer s_uart2WriteRingBuffer;
 static T_UartBufferState s_uart2WriteBufferState;
+#if (UART2_RX_MODE == UART_RX_MODE_DMA)
+static uint8_t s_uart2ReadBuf[UART2_READ_BUF_SIZE];
+static T_UartRxDma s_uart2RxDma;
+#else
 CCMRAM static uint8_t s_uart2ReadBuf[UART2_READ_BUF_SIZE];
+#endif
+#if (UART2_TX_MODE == UART_TX_MODE_DMA)
+static uint8_t s_uart2WriteBuf[UART2_WRITE_BUF_SIZE];
+static T_UartTxDma s_uart2TxDma;
+#else
 CCMRAM static uint8_t s_uart2WriteBuf[UART2_WRITE_BUF_SIZE];
+#endif
 
 static T_DjiMutexHandle s_uart2Mutex;
 static UART_HandleTypeDef s_uart2Handle;
@@ -81,10 +160,20 @@ static UART_HandleTypeDef s_uart2Handle;
 #ifdef USING_UART_PORT_3
 static T_RingBuffer s_uart3ReadRingBuffer;
 static T_UartBufferState s_uart3ReadBufferState;
-static T_RingBuffer s_uart3WriteRingBuffer;
+static T_MpRingBuffer s_uart3WriteRingBuffer;
 static T_UartBufferState s_uart3WriteBufferState;
+#if (UART3_RX_MODE == UART_RX_MODE_DMA)
+static uint8_t s_uart3ReadBuf[UART3_READ_BUF_SIZE];
+static T_UartRxDma s_uart3RxDma;
+#else
 CCMRAM static uint8_t s_uart3ReadBuf[UART3_READ_BUF_SIZE];
+#endif
+#if (UART3_TX_MODE == UART_TX_MODE_DMA)
+static uint8_t s_uart3WriteBuf[UART3_WRITE_BUF_SIZE];
+static T_UartTxDma s_uart3TxDma;
+#else
 CCMRAM static uint8_t s_uart3WriteBuf[UART3_WRITE_BUF_SIZE];
+#endif
 
 static T_DjiMutexHandle s_uart3Mutex;
 static UART_HandleTypeDef s_uart3Handle;
@@ -92,7 +181,256 @@ static UART_HandleTypeDef s_uart3Handle;
 
 /* Exported variables --------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
+#ifdef UART_RX_DMA_USED
+static void UART_RxDmaInit(T_UartRxDma *rxDma, UART_HandleTypeDef *uartHandle, DMA_Stream_TypeDef *stream,
+                           uint32_t channel, IRQn_Type irqNum, T_RingBuffer *readRingBuffer);
+static void UART_RxDmaUpdate(T_UartRxDma *rxDma, T_RingBuffer *readRingBuffer, T_UartBufferState *readBufferState);
+#endif
+#ifdef UART_TX_DMA_USED
+static void UART_TxDmaInit(T_UartTxDma *txDma, UART_HandleTypeDef *uartHandle, DMA_Stream_TypeDef *stream,
+                           uint32_t channel, IRQn_Type irqNum);
+static void UART_TxDmaKick(T_UartTxDma *txDma, T_MpRingBuffer *writeRingBuffer);
+static void UART_TxDmaComplete(T_UartTxDma *txDma, T_MpRingBuffer *writeRingBuffer,
+                               T_UartBufferState *writeBufferState);
+#endif
+static void UART_UpdateWriteState(T_MpRingBuffer *writeRingBuffer, T_UartBufferState *writeBufferState,
+                                  uint16_t writeSize, uint16_t writeRealLen);
+static void UART_UpdateInterruptRate(T_UartBufferState *bufferState);
+static void UART_MarkReadPending(T_UartBufferState *readBufferState);
+static void UART_UpdateReadLatency(T_RingBuffer *readRingBuffer, T_UartBufferState *readBufferState);
+
 /* Private functions ---------------------------------------------------------*/
+#ifdef UART_RX_DMA_USED
+
+/**
+ * @brief Start circular DMA reception straight into the memory of read ring buffer.
+ * @note DMA half-transfer, transfer-complete and UART IDLE-line interrupts all report progress through
+ *       UART_RxDmaUpdate(), so one interrupt is taken per burst instead of one per byte.
+ * @param rxDma Pointer to receive DMA structure.
+ * @param uartHandle Pointer to UART handle, UART must have been initialized.
+ * @param stream DMA stream mapped to UART receive request.
+ * @param channel DMA channel mapped to UART receive request.
+ * @param irqNum Interrupt number of DMA stream.
+ * @param readRingBuffer Pointer to read ring buffer, the whole data buffer is used as DMA target.
+ * @return None.
+ */
+static void UART_RxDmaInit(T_UartRxDma *rxDma, UART_HandleTypeDef *uartHandle, DMA_Stream_TypeDef *stream,
+                           uint32_t channel, IRQn_Type irqNum, T_RingBuffer *readRingBuffer)
+{
+    rxDma->dmaHandle.Instance = stream;
+    rxDma->dmaHandle.Init.Channel = channel;
+    rxDma->dmaHandle.Init.Direction = DMA_PERIPH_TO_MEMORY;
+    rxDma->dmaHandle.Init.PeriphInc = DMA_PINC_DISABLE;
+    rxDma->dmaHandle.Init.MemInc = DMA_MINC_ENABLE;
+    rxDma->dmaHandle.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    rxDma->dmaHandle.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    rxDma->dmaHandle.Init.Mode = DMA_CIRCULAR;
+    rxDma->dmaHandle.Init.Priority = DMA_PRIORITY_HIGH;
+    rxDma->dmaHandle.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    HAL_DMA_Init(&rxDma->dmaHandle);
+    __HAL_LINKDMA(uartHandle, hdmarx, rxDma->dmaHandle);
+
+    HAL_NVIC_SetPriority(irqNum, UART_DMA_IRQ_PRIO_PRE, UART_DMA_IRQ_PRIO_SUB);
+    HAL_NVIC_EnableIRQ(irqNum);
+
+    rxDma->lastPosition = 0;
+    HAL_DMA_Start(&rxDma->dmaHandle, (uint32_t) &uartHandle->Instance->DR, (uint32_t) readRingBuffer->bufferPtr,
+                  readRingBuffer->bufferSize);
+    __HAL_DMA_ENABLE_IT(&rxDma->dmaHandle, DMA_IT_HT | DMA_IT_TC);
+
+    __HAL_UART_CLEAR_IDLEFLAG(uartHandle);
+    SET_BIT(uartHandle->Instance->CR3, USART_CR3_DMAR);
+    __HAL_UART_ENABLE_IT(uartHandle, UART_IT_IDLE);
+}
+
+/**
+ * @brief Publish data written by receive DMA since last update to read ring buffer, called from interrupt context.
+ * @param rxDma Pointer to receive DMA structure.
+ * @param readRingBuffer Pointer to read ring buffer.
+ * @param readBufferState Pointer to read buffer state.
+ * @return None.
+ */
+static void UART_RxDmaUpdate(T_UartRxDma *rxDma, T_RingBuffer *readRingBuffer, T_UartBufferState *readBufferState)
+{
+    if (UartRxDma_Update(&rxDma->lastPosition, readRingBuffer, (uint16_t) __HAL_DMA_GET_COUNTER(&rxDma->dmaHandle),
+                         readBufferState) != 0) {
+        UART_MarkReadPending(readBufferState);
+    }
+}
+
+#endif
+
+#ifdef UART_TX_DMA_USED
+
+/**
+ * @brief Prepare a DMA stream to send spans of write ring buffer, transfers are started by UART_TxDmaKick().
+ * @param txDma Pointer to transmit DMA structure.
+ * @param uartHandle Pointer to UART handle, UART must have been initialized.
+ * @param stream DMA stream mapped to UART transmit request.
+ * @param channel DMA channel mapped to UART transmit request.
+ * @param irqNum Interrupt number of DMA stream.
+ * @return None.
+ */
+static void UART_TxDmaInit(T_UartTxDma *txDma, UART_HandleTypeDef *uartHandle, DMA_Stream_TypeDef *stream,
+                           uint32_t channel, IRQn_Type irqNum)
+{
+    txDma->dmaHandle.Instance = stream;
+    txDma->dmaHandle.Init.Channel = channel;
+    txDma->dmaHandle.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    txDma->dmaHandle.Init.PeriphInc = DMA_PINC_DISABLE;
+    txDma->dmaHandle.Init.MemInc = DMA_MINC_ENABLE;
+    txDma->dmaHandle.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    txDma->dmaHandle.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    txDma->dmaHandle.Init.Mode = DMA_NORMAL;
+    txDma->dmaHandle.Init.Priority = DMA_PRIORITY_MEDIUM;
+    txDma->dmaHandle.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    HAL_DMA_Init(&txDma->dmaHandle);
+    __HAL_LINKDMA(uartHandle, hdmatx, txDma->dmaHandle);
+
+    //stream is reprogrammed per span from interrupt context, so registers are driven directly instead of HAL state
+    stream->PAR = (uint32_t) &uartHandle->Instance->DR;
+    __HAL_DMA_ENABLE_IT(&txDma->dmaHandle, DMA_IT_TC);
+    txDma->transferLen = 0;
+
+    HAL_NVIC_SetPriority(irqNum, UART_DMA_IRQ_PRIO_PRE, UART_DMA_IRQ_PRIO_SUB);
+    HAL_NVIC_EnableIRQ(irqNum);
+
+    SET_BIT(uartHandle->Instance->CR3, USART_CR3_DMAT);
+}
+
+/**
+ * @brief Start a DMA transfer of the next contiguous span of write ring buffer if DMA is idle.
+ * @note Called from DMA interrupt, or from task with DMA interrupt masked. A span wrapping around the end of
+ *       buffer is sent as two chained transfers, the second one being started on completion of the first.
+ * @param txDma Pointer to transmit DMA structure.
+ * @param writeRingBuffer Pointer to write ring buffer.
+ * @return None.
+ */
+static void UART_TxDmaKick(T_UartTxDma *txDma, T_MpRingBuffer *writeRingBuffer)
+{
+    T_MpRingBufSpan spans[2];
+
+    if (txDma->transferLen != 0) {
+        return;
+    }
+
+    if (MpRingBuf_PeekSpans(writeRingBuffer, spans) == 0) {
+        return;
+    }
+    txDma->transferLen = spans[0].dataLen < UART_TX_DMA_TRANSFER_LEN_MAX ? spans[0].dataLen
+                                                                         : UART_TX_DMA_TRANSFER_LEN_MAX;
+
+    __HAL_DMA_CLEAR_FLAG(&txDma->dmaHandle, __HAL_DMA_GET_TC_FLAG_INDEX(&txDma->dmaHandle) |
+                                            __HAL_DMA_GET_HT_FLAG_INDEX(&txDma->dmaHandle) |
+                                            __HAL_DMA_GET_TE_FLAG_INDEX(&txDma->dmaHandle) |
+                                            __HAL_DMA_GET_DME_FLAG_INDEX(&txDma->dmaHandle) |
+                                            __HAL_DMA_GET_FE_FLAG_INDEX(&txDma->dmaHandle));
+    txDma->dmaHandle.Instance->M0AR = (uint32_t) spans[0].dataPtr;
+    txDma->dmaHandle.Instance->NDTR = txDma->transferLen;
+    __HAL_DMA_ENABLE(&txDma->dmaHandle);
+}
+
+/**
+ * @brief Release the span sent by transmit DMA and chain the next one, called from DMA interrupt.
+ * @param txDma Pointer to transmit DMA structure.
+ * @param writeRingBuffer Pointer to write ring buffer.
+ * @param writeBufferState Pointer to write buffer state.
+ * @return None.
+ */
+static void UART_TxDmaComplete(T_UartTxDma *txDma, T_MpRingBuffer *writeRingBuffer,
+                               T_UartBufferState *writeBufferState)
+{
+    if (__HAL_DMA_GET_FLAG(&txDma->dmaHandle, __HAL_DMA_GET_TC_FLAG_INDEX(&txDma->dmaHandle)) == RESET) {
+        return;
+    }
+    __HAL_DMA_CLEAR_FLAG(&txDma->dmaHandle, __HAL_DMA_GET_TC_FLAG_INDEX(&txDma->dmaHandle));
+
+    MpRingBuf_Consume(writeRingBuffer, txDma->transferLen);
+    writeBufferState->countOfTransferredData += txDma->transferLen;
+    writeBufferState->countOfInterrupt++;
+    txDma->transferLen = 0;
+
+    UART_TxDmaKick(txDma, writeRingBuffer);
+}
+
+#endif
+
+/**
+ * @brief Refresh interrupts per kilobyte statistics of buffer state.
+ * @param bufferState Pointer to buffer state.
+ * @return None.
+ */
+static void UART_UpdateInterruptRate(T_UartBufferState *bufferState)
+{
+    if (bufferState->countOfTransferredData == 0) {
+        bufferState->interruptsPerKiloByte = 0;
+        return;
+    }
+
+    bufferState->interruptsPerKiloByte =
+        (uint32_t) ((uint64_t) bufferState->countOfInterrupt * 1024 / bufferState->countOfTransferredData);
+}
+
+/**
+ * @brief Account data written by UART_Write() in write buffer state, called with interrupts masked.
+ * @param writeRingBuffer Pointer to write ring buffer.
+ * @param writeBufferState Pointer to write buffer state.
+ * @param writeSize Size of data to be written.
+ * @param writeRealLen Size of data put into write ring buffer actually.
+ * @return None.
+ */
+static void UART_UpdateWriteState(T_MpRingBuffer *writeRingBuffer, T_UartBufferState *writeBufferState,
+                                  uint16_t writeSize, uint16_t writeRealLen)
+{
+    uint16_t usedCapacityOfBuffer;
+
+    usedCapacityOfBuffer = (uint16_t) (writeRingBuffer->bufferSize - MpRingBuf_GetUnusedSize(writeRingBuffer));
+    writeBufferState->maxUsedCapacityOfBuffer =
+        usedCapacityOfBuffer > writeBufferState->maxUsedCapacityOfBuffer ? usedCapacityOfBuffer
+                                                                         : writeBufferState->maxUsedCapacityOfBuffer;
+    writeBufferState->countOfLostData += writeSize - writeRealLen;
+}
+
+/**
+ * @brief Record the time read buffer turned from empty to non-empty, called from interrupt context.
+ * @param readBufferState Pointer to read buffer state.
+ * @return None.
+ */
+static void UART_MarkReadPending(T_UartBufferState *readBufferState)
+{
+    if (readBufferState->pendingTimeUs == 0) {
+        Osal_GetTimeUs(&readBufferState->pendingTimeUs);
+    }
+}
+
+/**
+ * @brief Account the time oldest data waited in read buffer, called by reader after data was read.
+ * @note Data left in buffer is measured from now on, so latency is the delay a reader adds, not the time data
+ *       waits behind older data.
+ * @param readRingBuffer Pointer to read ring buffer.
+ * @param readBufferState Pointer to read buffer state.
+ * @return None.
+ */
+static void UART_UpdateReadLatency(T_RingBuffer *readRingBuffer, T_UartBufferState *readBufferState)
+{
+    uint64_t timeUs;
+    uint32_t latencyUs;
+
+    Osal_GetTimeUs(&timeUs);
+
+    //receive interrupt must not mark new data between empty check and clearing of pending time
+    taskENTER_CRITICAL();
+    if (readBufferState->pendingTimeUs != 0 && timeUs >= readBufferState->pendingTimeUs) {
+        latencyUs = (uint32_t) (timeUs - readBufferState->pendingTimeUs);
+        readBufferState->sumOfLatencyUs += latencyUs;
+        readBufferState->countOfLatency++;
+        readBufferState->maxLatencyUs =
+            latencyUs > readBufferState->maxLatencyUs ? latencyUs : readBufferState->maxLatencyUs;
+        readBufferState->pendingTimeUs = readRingBuffer->writeIndex == readRingBuffer->readIndex ? 0 : timeUs;
+    }
+    taskEXIT_CRITICAL();
+}
+
 /* Exported functions --------------------------------------------------------*/
 
 /**
@@ -108,7 +446,7 @@ void UART_Init(E_UartNum uartNum, uint32_t baudRate)
 #ifdef USING_UART_PORT_1
         case UART_NUM_1: {
             RingBuf_Init(&s_uart1ReadRingBuffer, s_uart1ReadBuf, UART1_READ_BUF_SIZE);
-            RingBuf_Init(&s_uart1WriteRingBuffer, s_uart1WriteBuf, UART1_WRITE_BUF_SIZE);
+            MpRingBuf_Init(&s_uart1WriteRingBuffer, s_uart1WriteBuf, UART1_WRITE_BUF_SIZE);
 
             s_uart1Handle.Instance = USART1;
             s_uart1Handle.Init.BaudRate = baudRate;
@@ -119,7 +457,18 @@ void UART_Init(E_UartNum uartNum, uint32_t baudRate)
             s_uart1Handle.Init.Mode = UART_MODE_TX_RX;
             s_uart1Handle.Init.OverSampling = UART_OVERSAMPLING_16;
             HAL_UART_Init(&s_uart1Handle);
+#if (UART1_RX_MODE == UART_RX_MODE_DMA)
+            __HAL_RCC_DMA2_CLK_ENABLE();
+            UART_RxDmaInit(&s_uart1RxDma, &s_uart1Handle, UART1_RX_DMA_STREAM, UART1_RX_DMA_CHANNEL,
+                           UART1_RX_DMA_IRQn, &s_uart1ReadRingBuffer);
+#else
             __HAL_UART_ENABLE_IT(&s_uart1Handle, UART_IT_RXNE);
+#endif
+#if (UART1_TX_MODE == UART_TX_MODE_DMA)
+            __HAL_RCC_DMA2_CLK_ENABLE();
+            UART_TxDmaInit(&s_uart1TxDma, &s_uart1Handle, UART1_TX_DMA_STREAM, UART1_TX_DMA_CHANNEL,
+                           UART1_TX_DMA_IRQn);
+#endif
 
             Osal_MutexCreate(&s_uart1Mutex);
         }
@@ -129,7 +478,7 @@ void UART_Init(E_UartNum uartNum, uint32_t baudRate)
 #ifdef USING_UART_PORT_2
         case UART_NUM_2: {
             RingBuf_Init(&s_uart2ReadRingBuffer, s_uart2ReadBuf, UART2_READ_BUF_SIZE);
-            RingBuf_Init(&s_uart2WriteRingBuffer, s_uart2WriteBuf, UART2_WRITE_BUF_SIZE);
+            MpRingBuf_Init(&s_uart2WriteRingBuffer, s_uart2WriteBuf, UART2_WRITE_BUF_SIZE);
 
             s_uart2Handle.Instance = USART2;
             s_uart2Handle.Init.BaudRate = baudRate;
@@ -140,7 +489,18 @@ void UART_Init(E_UartNum uartNum, uint32_t baudRate)
             s_uart2Handle.Init.Mode = UART_MODE_TX_RX;
             s_uart2Handle.Init.OverSampling = UART_OVERSAMPLING_16;
             HAL_UART_Init(&s_uart2Handle);
+#if (UART2_RX_MODE == UART_RX_MODE_DMA)
+            __HAL_RCC_DMA1_CLK_ENABLE();
+            UART_RxDmaInit(&s_uart2RxDma, &s_uart2Handle, UART2_RX_DMA_STREAM, UART2_RX_DMA_CHANNEL,
+                           UART2_RX_DMA_IRQn, &s_uart2ReadRingBuffer);
+#else
             __HAL_UART_ENABLE_IT(&s_uart2Handle, UART_IT_RXNE);
+#endif
+#if (UART2_TX_MODE == UART_TX_MODE_DMA)
+            __HAL_RCC_DMA1_CLK_ENABLE();
+            UART_TxDmaInit(&s_uart2TxDma, &s_uart2Handle, UART2_TX_DMA_STREAM, UART2_TX_DMA_CHANNEL,
+                           UART2_TX_DMA_IRQn);
+#endif
 
             Osal_MutexCreate(&s_uart2Mutex);
         }
@@ -150,7 +510,7 @@ void UART_Init(E_UartNum uartNum, uint32_t baudRate)
 #ifdef USING_UART_PORT_3
         case UART_NUM_3: {
             RingBuf_Init(&s_uart3ReadRingBuffer, s_uart3ReadBuf, UART3_READ_BUF_SIZE);
-            RingBuf_Init(&s_uart3WriteRingBuffer, s_uart3WriteBuf, UART3_WRITE_BUF_SIZE);
+            MpRingBuf_Init(&s_uart3WriteRingBuffer, s_uart3WriteBuf, UART3_WRITE_BUF_SIZE);
 
             s_uart3Handle.Instance = USART3;
             s_uart3Handle.Init.BaudRate = baudRate;
@@ -161,7 +521,18 @@ void UART_Init(E_UartNum uartNum, uint32_t baudRate)
             s_uart3Handle.Init.Mode = UART_MODE_TX_RX;
             s_uart3Handle.Init.OverSampling = UART_OVERSAMPLING_16;
             HAL_UART_Init(&s_uart3Handle);
+#if (UART3_RX_MODE == UART_RX_MODE_DMA)
+            __HAL_RCC_DMA1_CLK_ENABLE();
+            UART_RxDmaInit(&s_uart3RxDma, &s_uart3Handle, UART3_RX_DMA_STREAM, UART3_RX_DMA_CHANNEL,
+                           UART3_RX_DMA_IRQn, &s_uart3ReadRingBuffer);
+#else
             __HAL_UART_ENABLE_IT(&s_uart3Handle, UART_IT_RXNE);
+#endif
+#if (UART3_TX_MODE == UART_TX_MODE_DMA)
+            __HAL_RCC_DMA1_CLK_ENABLE();
+            UART_TxDmaInit(&s_uart3TxDma, &s_uart3Handle, UART3_TX_DMA_STREAM, UART3_TX_DMA_CHANNEL,
+                           UART3_TX_DMA_IRQn);
+#endif
 
             Osal_MutexCreate(&s_uart3Mutex);
         }
@@ -189,7 +560,13 @@ int UART_Read(E_UartNum uartNum, uint8_t *buf, uint16_t readSize)
 #ifdef USING_UART_PORT_1
         case UART_NUM_1: {
             Osal_MutexLock(s_uart1Mutex);
+#if (UART1_RX_MODE == UART_RX_MODE_DMA)
+            UartRxDma_Resync(&s_uart1ReadRingBuffer);
+#endif
             readRealSize = RingBuf_Get(&s_uart1ReadRingBuffer, buf, readSize);
+            if (readRealSize != 0) {
+                UART_UpdateReadLatency(&s_uart1ReadRingBuffer, &s_uart1ReadBufferState);
+            }
             Osal_MutexUnlock(s_uart1Mutex);
         }
             break;
@@ -198,7 +575,13 @@ int UART_Read(E_UartNum uartNum, uint8_t *buf, uint16_t readSize)
 #ifdef USING_UART_PORT_2
         case UART_NUM_2: {
             Osal_MutexLock(s_uart2Mutex);
+#if (UART2_RX_MODE == UART_RX_MODE_DMA)
+            UartRxDma_Resync(&s_uart2ReadRingBuffer);
+#endif
             readRealSize = RingBuf_Get(&s_uart2ReadRingBuffer, buf, readSize);
+            if (readRealSize != 0) {
+                UART_UpdateReadLatency(&s_uart2ReadRingBuffer, &s_uart2ReadBufferState);
+            }
             Osal_MutexUnlock(s_uart2Mutex);
         }
             break;
@@ -207,7 +590,13 @@ int UART_Read(E_UartNum uartNum, uint8_t *buf, uint16_t readSize)
 #ifdef USING_UART_PORT_3
         case UART_NUM_3: {
             Osal_MutexLock(s_uart3Mutex);
+#if (UART3_RX_MODE == UART_RX_MODE_DMA)
+            UartRxDma_Resync(&s_uart3ReadRingBuffer);
+#endif
             readRealSize = RingBuf_Get(&s_uart3ReadRingBuffer, buf, readSize);
+            if (readRealSize != 0) {
+                UART_UpdateReadLatency(&s_uart3ReadRingBuffer, &s_uart3ReadBufferState);
+            }
             Osal_MutexUnlock(s_uart3Mutex);
         }
             break;
@@ -221,7 +610,7 @@ int UART_Read(E_UartNum uartNum, uint8_t *buf, uint16_t readSize)
 }
 
 /**
- * @brief Write UART data.
+ * @brief Write UART data, may be called by several tasks concurrently.
  * @param uartNum UART number.
  * @param buf Pointer to buffer used to store data.
  * @param writeSize Size of data to be write.
@@ -230,51 +619,56 @@ int UART_Read(E_UartNum uartNum, uint8_t *buf, uint16_t readSize)
 int UART_Write(E_UartNum uartNum, const uint8_t *buf, uint16_t writeSize)
 {
     int writeRealLen;
-    uint16_t usedCapacityOfBuffer = 0;
 
     switch (uartNum) {
 
 #ifdef USING_UART_PORT_1
         case UART_NUM_1: {
-            Osal_MutexLock(s_uart1Mutex);
-            writeRealLen = RingBuf_Put(&s_uart1WriteRingBuffer, buf, writeSize);
+            writeRealLen = (int) MpRingBuf_Put(&s_uart1WriteRingBuffer, buf, writeSize);
+            //only DMA start and statistics are serialized, copy of data runs concurrently in every task
+            taskENTER_CRITICAL();
+#if (UART1_TX_MODE == UART_TX_MODE_DMA)
+            UART_TxDmaKick(&s_uart1TxDma, &s_uart1WriteRingBuffer);
+#else
             __HAL_UART_ENABLE_IT(&s_uart1Handle, UART_IT_TXE);
-            usedCapacityOfBuffer = UART1_WRITE_BUF_SIZE - RingBuf_GetUnusedSize(&s_uart1WriteRingBuffer);
-            s_uart1WriteBufferState.maxUsedCapacityOfBuffer =
-                usedCapacityOfBuffer > s_uart1WriteBufferState.maxUsedCapacityOfBuffer ? usedCapacityOfBuffer
-                                                                                       : s_uart1WriteBufferState.maxUsedCapacityOfBuffer;
-            s_uart1WriteBufferState.countOfLostData += writeSize - writeRealLen;
-            Osal_MutexUnlock(s_uart1Mutex);
+#endif
+            UART_UpdateWriteState(&s_uart1WriteRingBuffer, &s_uart1WriteBufferState, writeSize,
+                                  (uint16_t) writeRealLen);
+            taskEXIT_CRITICAL();
         }
             break;
 #endif
 
 #ifdef USING_UART_PORT_2
         case UART_NUM_2: {
-            Osal_MutexLock(s_uart2Mutex);
-            writeRealLen = RingBuf_Put(&s_uart2WriteRingBuffer, buf, writeSize);
+            writeRealLen = (int) MpRingBuf_Put(&s_uart2WriteRingBuffer, buf, writeSize);
+            //only DMA start and statistics are serialized, copy of data runs concurrently in every task
+            taskENTER_CRITICAL();
+#if (UART2_TX_MODE == UART_TX_MODE_DMA)
+            UART_TxDmaKick(&s_uart2TxDma, &s_uart2WriteRingBuffer);
+#else
             __HAL_UART_ENABLE_IT(&s_uart2Handle, UART_IT_TXE);
-            usedCapacityOfBuffer = UART2_WRITE_BUF_SIZE - RingBuf_GetUnusedSize(&s_uart2WriteRingBuffer);
-            s_uart2WriteBufferState.maxUsedCapacityOfBuffer =
-                usedCapacityOfBuffer > s_uart2WriteBufferState.maxUsedCapacityOfBuffer ? usedCapacityOfBuffer
-                                                                                       : s_uart2WriteBufferState.maxUsedCapacityOfBuffer;
-            s_uart2WriteBufferState.countOfLostData += writeSize - writeRealLen;
-            Osal_MutexUnlock(s_uart2Mutex);
+#endif
+            UART_UpdateWriteState(&s_uart2WriteRingBuffer, &s_uart2WriteBufferState, writeSize,
+                                  (uint16_t) writeRealLen);
+            taskEXIT_CRITICAL();
         }
             break;
 #endif
 
 #ifdef USING_UART_PORT_3
         case UART_NUM_3: {
-            Osal_MutexLock(s_uart3Mutex);
-            writeRealLen = RingBuf_Put(&s_uart3WriteRingBuffer, buf, writeSize);
+            writeRealLen = (int) MpRingBuf_Put(&s_uart3WriteRingBuffer, buf, writeSize);
+            //only DMA start and statistics are serialized, copy of data runs concurrently in every task
+            taskENTER_CRITICAL();
+#if (UART3_TX_MODE == UART_TX_MODE_DMA)
+            UART_TxDmaKick(&s_uart3TxDma, &s_uart3WriteRingBuffer);
+#else
             __HAL_UART_ENABLE_IT(&s_uart3Handle, UART_IT_TXE);
-            usedCapacityOfBuffer = UART3_WRITE_BUF_SIZE - RingBuf_GetUnusedSize(&s_uart3WriteRingBuffer);
-            s_uart3WriteBufferState.maxUsedCapacityOfBuffer =
-                usedCapacityOfBuffer > s_uart3WriteBufferState.maxUsedCapacityOfBuffer ? usedCapacityOfBuffer
-                                                                                       : s_uart3WriteBufferState.maxUsedCapacityOfBuffer;
-            s_uart3WriteBufferState.countOfLostData += writeSize - writeRealLen;
-            Osal_MutexUnlock(s_uart3Mutex);
+#endif
+            UART_UpdateWriteState(&s_uart3WriteRingBuffer, &s_uart3WriteBufferState, writeSize,
+                                  (uint16_t) writeRealLen);
+            taskEXIT_CRITICAL();
         }
             break;
 #endif
@@ -291,18 +685,30 @@ void UART_GetBufferState(E_UartNum uartNum, T_UartBufferState *readBufferState,
     switch (uartNum) {
 #ifdef USING_UART_PORT_1
         case UART_NUM_1:
+            UART_UpdateInterruptRate(&s_uart1ReadBufferState);
+            s_uart1ReadBufferState.averageLatencyUs = s_uart1ReadBufferState.countOfLatency != 0 ?
+                (uint32_t) (s_uart1ReadBufferState.sumOfLatencyUs / s_uart1ReadBufferState.countOfLatency) : 0;
+            UART_UpdateInterruptRate(&s_uart1WriteBufferState);
             memcpy(readBufferState, &s_uart1ReadBufferState, sizeof(T_UartBufferState));
             memcpy(writeBufferState, &s_uart1WriteBufferState, sizeof(T_UartBufferState));
             break;
 #endif
 #ifdef USING_UART_PORT_2
         case UART_NUM_2:
+            UART_UpdateInterruptRate(&s_uart2ReadBufferState);
+            s_uart2ReadBufferState.averageLatencyUs = s_uart2ReadBufferState.countOfLatency != 0 ?
+                (uint32_t) (s_uart2ReadBufferState.sumOfLatencyUs / s_uart2ReadBufferState.countOfLatency) : 0;
+            UART_UpdateInterruptRate(&s_uart2WriteBufferState);
             memcpy(readBufferState, &s_uart2ReadBufferState, sizeof(T_UartBufferState));
             memcpy(writeBufferState, &s_uart2WriteBufferState, sizeof(T_UartBufferState));
             break;
 #endif
 #ifdef USING_UART_PORT_3
         case UART_NUM_3:
+            UART_UpdateInterruptRate(&s_uart3ReadBufferState);
+            s_uart3ReadBufferState.averageLatencyUs = s_uart3ReadBufferState.countOfLatency != 0 ?
+                (uint32_t) (s_uart3ReadBufferState.sumOfLatencyUs / s_uart3ReadBufferState.countOfLatency) : 0;
+            UART_UpdateInterruptRate(&s_uart3WriteBufferState);
             memcpy(readBufferState, &s_uart3ReadBufferState, sizeof(T_UartBufferState));
             memcpy(writeBufferState, &s_uart3WriteBufferState, sizeof(T_UartBufferState));
             break;
@@ -332,19 +738,68 @@ void USART1_IRQHandler(void)
             usedCapacityOfBuffer > s_uart1ReadBufferState.maxUsedCapacityOfBuffer ? usedCapacityOfBuffer
                                                                                   : s_uart1ReadBufferState.maxUsedCapacityOfBuffer;
         s_uart1ReadBufferState.countOfLostData += 1 - realCountPutBuffer;
+        if (realCountPutBuffer != 0) {
+            UART_MarkReadPending(&s_uart1ReadBufferState);
+        }
+        s_uart1ReadBufferState.countOfInterrupt++;
+        s_uart1ReadBufferState.countOfTransferredData++;
     }
 
+#if (UART1_RX_MODE == UART_RX_MODE_DMA)
+    if (__HAL_UART_GET_IT_SOURCE(&s_uart1Handle, UART_IT_IDLE) != RESET &&
+        __HAL_UART_GET_FLAG(&s_uart1Handle, UART_FLAG_IDLE) != RESET) {
+        __HAL_UART_CLEAR_IDLEFLAG(&s_uart1Handle);
+        UART_RxDmaUpdate(&s_uart1RxDma, &s_uart1ReadRingBuffer, &s_uart1ReadBufferState);
+    }
+#endif
+
     if (__HAL_UART_GET_IT_SOURCE(&s_uart1Handle, UART_IT_TXE) != RESET &&
         __HAL_UART_GET_FLAG(&s_uart1Handle, UART_FLAG_TXE) != RESET) {
-        if (RingBuf_Get(&s_uart1WriteRingBuffer, &data, 1)) {
+        if (MpRingBuf_Get(&s_uart1WriteRingBuffer, &data, 1)) {
             /* Transmit Data */
             s_uart1Handle.Instance->DR = ((uint16_t) data & (uint16_t) 0x01FF);
+            s_uart1WriteBufferState.countOfInterrupt++;
+            s_uart1WriteBufferState.countOfTransferredData++;
         } else {
             __HAL_UART_DISABLE_IT(&s_uart1Handle, UART_IT_TXE);
         }
     }
 }
 
+#if (UART1_RX_MODE == UART_RX_MODE_DMA)
+
+/**
+ * @brief UART1 receive DMA interrupt request handler function.
+ */
+void UART1_RX_DMA_IRQHandler(void)
+{
+    DMA_HandleTypeDef *dmaHandle = &s_uart1RxDma.dmaHandle;
+
+    if (__HAL_DMA_GET_FLAG(dmaHandle, __HAL_DMA_GET_HT_FLAG_INDEX(dmaHandle)) != RESET) {
+        __HAL_DMA_CLEAR_FLAG(dmaHandle, __HAL_DMA_GET_HT_FLAG_INDEX(dmaHandle));
+        UART_RxDmaUpdate(&s_uart1RxDma, &s_uart1ReadRingBuffer, &s_uart1ReadBufferState);
+    }
+
+    if (__HAL_DMA_GET_FLAG(dmaHandle, __HAL_DMA_GET_TC_FLAG_INDEX(dmaHandle)) != RESET) {
+        __HAL_DMA_CLEAR_FLAG(dmaHandle, __HAL_DMA_GET_TC_FLAG_INDEX(dmaHandle));
+        UART_RxDmaUpdate(&s_uart1RxDma, &s_uart1ReadRingBuffer, &s_uart1ReadBufferState);
+    }
+}
+
+#endif
+
+#if (UART1_TX_MODE == UART_TX_MODE_DMA)
+
+/**
+ * @brief UART1 transmit DMA interrupt request handler function.
+ */
+void UART1_TX_DMA_IRQHandler(void)
+{
+    UART_TxDmaComplete(&s_uart1TxDma, &s_uart1WriteRingBuffer, &s_uart1WriteBufferState);
+}
+
+#endif
+
 #endif
 
 /**
@@ -367,19 +822,68 @@ void USART2_IRQHandler(void)
             usedCapacityOfBuffer > s_uart2ReadBufferState.maxUsedCapacityOfBuffer ? usedCapacityOfBuffer
                                                                                   : s_uart2ReadBufferState.maxUsedCapacityOfBuffer;
         s_uart2ReadBufferState.countOfLostData += 1 - realCountPutBuffer;
+        if (realCountPutBuffer != 0) {
+            UART_MarkReadPending(&s_uart2ReadBufferState);
+        }
+        s_uart2ReadBufferState.countOfInterrupt++;
+        s_uart2ReadBufferState.countOfTransferredData++;
     }
 
+#if (UART2_RX_MODE == UART_RX_MODE_DMA)
+    if (__HAL_UART_GET_IT_SOURCE(&s_uart2Handle, UART_IT_IDLE) != RESET &&
+        __HAL_UART_GET_FLAG(&s_uart2Handle, UART_FLAG_IDLE) != RESET) {
+        __HAL_UART_CLEAR_IDLEFLAG(&s_uart2Handle);
+        UART_RxDmaUpdate(&s_uart2RxDma, &s_uart2ReadRingBuffer, &s_uart2ReadBufferState);
+    }
+#endif
+
     if (__HAL_UART_GET_IT_SOURCE(&s_uart2Handle, UART_IT_TXE) != RESET &&
         __HAL_UART_GET_FLAG(&s_uart2Handle, UART_FLAG_TXE) != RESET) {
-        if (RingBuf_Get(&s_uart2WriteRingBuffer, &data, 1)) {
+        if (MpRingBuf_Get(&s_uart2WriteRingBuffer, &data, 1)) {
             /* Transmit Data */
             s_uart2Handle.Instance->DR = ((uint16_t) data & (uint16_t) 0x01FF);
+            s_uart2WriteBufferState.countOfInterrupt++;
+            s_uart2WriteBufferState.countOfTransferredData++;
         } else {
             __HAL_UART_DISABLE_IT(&s_uart2Handle, UART_IT_TXE);
         }
     }
 }
 
+#if (UART2_RX_MODE == UART_RX_MODE_DMA)
+
+/**
+ * @brief UART2 receive DMA interrupt request handler function.
+ */
+void UART2_RX_DMA_IRQHandler(void)
+{
+    DMA_HandleTypeDef *dmaHandle = &s_uart2RxDma.dmaHandle;
+
+    if (__HAL_DMA_GET_FLAG(dmaHandle, __HAL_DMA_GET_HT_FLAG_INDEX(dmaHandle)) != RESET) {
+        __HAL_DMA_CLEAR_FLAG(dmaHandle, __HAL_DMA_GET_HT_FLAG_INDEX(dmaHandle));
+        UART_RxDmaUpdate(&s_uart2RxDma, &s_uart2ReadRingBuffer, &s_uart2ReadBufferState);
+    }
+
+    if (__HAL_DMA_GET_FLAG(dmaHandle, __HAL_DMA_GET_TC_FLAG_INDEX(dmaHandle)) != RESET) {
+        __HAL_DMA_CLEAR_FLAG(dmaHandle, __HAL_DMA_GET_TC_FLAG_INDEX(dmaHandle));
+        UART_RxDmaUpdate(&s_uart2RxDma, &s_uart2ReadRingBuffer, &s_uart2ReadBufferState);
+    }
+}
+
+#endif
+
+#if (UART2_TX_MODE == UART_TX_MODE_DMA)
+
+/**
+ * @brief UART2 transmit DMA interrupt request handler function.
+ */
+void UART2_TX_DMA_IRQHandler(void)
+{
+    UART_TxDmaComplete(&s_uart2TxDma, &s_uart2WriteRingBuffer, &s_uart2WriteBufferState);
+}
+
+#endif
+
 #endif
 
 /**
@@ -402,19 +906,68 @@ void USART3_IRQHandler(void)
             usedCapacityOfBuffer > s_uart3ReadBufferState.maxUsedCapacityOfBuffer ? usedCapacityOfBuffer
                                                                                   : s_uart3ReadBufferState.maxUsedCapacityOfBuffer;
         s_uart3ReadBufferState.countOfLostData += 1 - realCountPutBuffer;
+        if (realCountPutBuffer != 0) {
+            UART_MarkReadPending(&s_uart3ReadBufferState);
+        }
+        s_uart3ReadBufferState.countOfInterrupt++;
+        s_uart3ReadBufferState.countOfTransferredData++;
     }
 
+#if (UART3_RX_MODE == UART_RX_MODE_DMA)
+    if (__HAL_UART_GET_IT_SOURCE(&s_uart3Handle, UART_IT_IDLE) != RESET &&
+        __HAL_UART_GET_FLAG(&s_uart3Handle, UART_FLAG_IDLE) != RESET) {
+        __HAL_UART_CLEAR_IDLEFLAG(&s_uart3Handle);
+        UART_RxDmaUpdate(&s_uart3RxDma, &s_uart3ReadRingBuffer, &s_uart3ReadBufferState);
+    }
+#endif
+
     if (__HAL_UART_GET_IT_SOURCE(&s_uart3Handle, UART_IT_TXE) != RESET &&
         __HAL_UART_GET_FLAG(&s_uart3Handle, UART_FLAG_TXE) != RESET) {
-        if (RingBuf_Get(&s_uart3WriteRingBuffer, &data, 1)) {
+        if (MpRingBuf_Get(&s_uart3WriteRingBuffer, &data, 1)) {
             /* Transmit Data */
             s_uart3Handle.Instance->DR = ((uint16_t) data & (uint16_t) 0x01FF);
+            s_uart3WriteBufferState.countOfInterrupt++;
+            s_uart3WriteBufferState.countOfTransferredData++;
         } else {
             __HAL_UART_DISABLE_IT(&s_uart3Handle, UART_IT_TXE);
         }
     }
 }
 
+#if (UART3_RX_MODE == UART_RX_MODE_DMA)
+
+/**
+ * @brief UART3 receive DMA interrupt request handler function.
+ */
+void UART3_RX_DMA_IRQHandler(void)
+{
+    DMA_HandleTypeDef *dmaHandle = &s_uart3RxDma.dmaHandle;
+
+    if (__HAL_DMA_GET_FLAG(dmaHandle, __HAL_DMA_GET_HT_FLAG_INDEX(dmaHandle)) != RESET) {
+        __HAL_DMA_CLEAR_FLAG(dmaHandle, __HAL_DMA_GET_HT_FLAG_INDEX(dmaHandle));
+        UART_RxDmaUpdate(&s_uart3RxDma, &s_uart3ReadRingBuffer, &s_uart3ReadBufferState);
+    }
+
+    if (__HAL_DMA_GET_FLAG(dmaHandle, __HAL_DMA_GET_TC_FLAG_INDEX(dmaHandle)) != RESET) {
+        __HAL_DMA_CLEAR_FLAG(dmaHandle, __HAL_DMA_GET_TC_FLAG_INDEX(dmaHandle));
+        UART_RxDmaUpdate(&s_uart3RxDma, &s_uart3ReadRingBuffer, &s_uart3ReadBufferState);
+    }
+}
+
+#endif
+
+#if (UART3_TX_MODE == UART_TX_MODE_DMA)
+
+/**
+ * @brief UART3 transmit DMA interrupt request handler function.
+ */
+void UART3_TX_DMA_IRQHandler(void)
+{
+    UART_TxDmaComplete(&s_uart3TxDma, &s_uart3WriteRingBuffer, &s_uart3WriteBufferState);
+}
+
+#endif
+
 #endif
 
 #ifdef __CC_ARM
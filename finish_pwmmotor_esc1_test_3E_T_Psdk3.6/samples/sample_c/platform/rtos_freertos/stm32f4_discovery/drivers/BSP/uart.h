@@ -36,6 +36,22 @@
 #define USING_UART_PORT_2
 #define USING_UART_PORT_3
 
+//UART receive mode, interrupt per byte or circular DMA with IDLE-line detection
+#define UART_RX_MODE_IT         0
+#define UART_RX_MODE_DMA        1
+
+#define UART1_RX_MODE           UART_RX_MODE_IT
+#define UART2_RX_MODE           UART_RX_MODE_IT
+#define UART3_RX_MODE           UART_RX_MODE_DMA
+
+//UART transmit mode, TXE interrupt per byte or one DMA transfer per contiguous span of write buffer
+#define UART_TX_MODE_IT         0
+#define UART_TX_MODE_DMA        1
+
+#define UART1_TX_MODE           UART_TX_MODE_IT
+#define UART2_TX_MODE           UART_TX_MODE_IT
+#define UART3_TX_MODE           UART_TX_MODE_DMA
+
 #define UART_ERROR      (-1)
 
 /* Exported macros -----------------------------------------------------------*/
@@ -52,6 +68,14 @@ typedef enum {
 typedef struct {
     uint32_t countOfLostData; /*!< Count of data lost, unit: byte. */
     uint16_t maxUsedCapacityOfBuffer; /*!< Max capacity of buffer that have been used, unit: byte. */
+    uint32_t countOfInterrupt; /*!< Count of interrupts taken to move data through buffer. */
+    uint32_t countOfTransferredData; /*!< Count of data moved through buffer, unit: byte. */
+    uint32_t interruptsPerKiloByte; /*!< Interrupts taken per 1024 bytes of data, updated on query. */
+    uint64_t pendingTimeUs; /*!< Time oldest unread data became readable, 0 if none. Read buffer only, unit: us. */
+    uint64_t sumOfLatencyUs; /*!< Sum of time data waited in buffer until it was read, unit: us. */
+    uint32_t countOfLatency; /*!< Count of reads summed up in sumOfLatencyUs. */
+    uint32_t maxLatencyUs; /*!< Max time data waited in buffer until it was read, unit: us. */
+    uint32_t averageLatencyUs; /*!< Average time data waited in buffer until it was read, updated on query, unit: us. */
 } T_UartBufferState;
 
 /* Exported variables --------------------------------------------------------*/
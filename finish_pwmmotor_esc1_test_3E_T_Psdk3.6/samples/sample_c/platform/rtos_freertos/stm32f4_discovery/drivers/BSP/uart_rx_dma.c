@@ -0,0 +1,111 @@
+/**
+ ********************************************************************
+ * @file    uart_rx_dma.c
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   Index bookkeeping of UART circular DMA reception, the DMA writes straight into memory of read
+ *          ring buffer and only the write index is moved here. Kept free of HAL so that it runs on host.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "uart_rx_dma.h"
+
+/* Private constants ---------------------------------------------------------*/
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private values -------------------------------------------------------------*/
+
+/* Private functions declaration ---------------------------------------------*/
+
+/* Exported functions definition ---------------------------------------------*/
+/**
+ * @brief Publish data written by receive DMA since last update to read ring buffer, called from interrupt context.
+ * @note When DMA overruns the reader, write index is kept less than two buffers ahead of read index, so the
+ *       16 bits index distance never wraps however long the reader stalls.
+ * @param lastPosition: ring buffer offset the DMA had reached on last update, updated to current offset.
+ * @param readRingBuffer: pointer to read ring buffer, its whole memory is the DMA target.
+ * @param dmaRemainCount: NDTR of DMA stream, count of transfers left until the DMA wraps to buffer start.
+ * @param readBufferState: pointer to read buffer state.
+ * @return Count of bytes received since last update.
+ */
+uint16_t UartRxDma_Update(uint16_t *lastPosition, T_RingBuffer *readRingBuffer, uint16_t dmaRemainCount,
+                          T_UartBufferState *readBufferState)
+{
+    uint16_t position;
+    uint16_t receivedLen;
+    uint16_t readIndex;
+    uint16_t usedCapacityOfBuffer;
+    uint16_t unusedCapacityOfBuffer;
+
+    position = (uint16_t) (readRingBuffer->bufferSize - dmaRemainCount) & (readRingBuffer->bufferSize - 1);
+    receivedLen = (uint16_t) (position - *lastPosition) & (readRingBuffer->bufferSize - 1);
+    *lastPosition = position;
+
+    readBufferState->countOfInterrupt++;
+    if (receivedLen == 0) {
+        return 0;
+    }
+
+    //DMA has already overwritten unread data when reader falls behind, count it and let reader resync
+    readIndex = readRingBuffer->readIndex;
+    usedCapacityOfBuffer = (uint16_t) (readRingBuffer->writeIndex - readIndex);
+    unusedCapacityOfBuffer = usedCapacityOfBuffer < readRingBuffer->bufferSize ?
+                             readRingBuffer->bufferSize - usedCapacityOfBuffer : 0;
+    if (receivedLen > unusedCapacityOfBuffer) {
+        readBufferState->countOfLostData += receivedLen - unusedCapacityOfBuffer;
+    }
+
+    //data is already in place, only the write index has to be moved, keeping its offset equal to DMA position
+    usedCapacityOfBuffer += receivedLen;
+    if (usedCapacityOfBuffer >= 2 * readRingBuffer->bufferSize) {
+        usedCapacityOfBuffer = readRingBuffer->bufferSize + (usedCapacityOfBuffer & (readRingBuffer->bufferSize - 1));
+    }
+    readRingBuffer->writeIndex = (uint16_t) (readIndex + usedCapacityOfBuffer);
+    readBufferState->countOfTransferredData += receivedLen;
+
+    if (usedCapacityOfBuffer > readRingBuffer->bufferSize) {
+        usedCapacityOfBuffer = readRingBuffer->bufferSize;
+    }
+    readBufferState->maxUsedCapacityOfBuffer =
+        usedCapacityOfBuffer > readBufferState->maxUsedCapacityOfBuffer ? usedCapacityOfBuffer
+                                                                        : readBufferState->maxUsedCapacityOfBuffer;
+
+    return receivedLen;
+}
+
+/**
+ * @brief Drop the oldest data of a DMA fed read ring buffer after DMA overran the reader, called by reader only.
+ * @param readRingBuffer: pointer to read ring buffer.
+ * @return None.
+ */
+void UartRxDma_Resync(T_RingBuffer *readRingBuffer)
+{
+    uint16_t writeIndex = readRingBuffer->writeIndex;
+
+    if ((uint16_t) (writeIndex - readRingBuffer->readIndex) > readRingBuffer->bufferSize) {
+        readRingBuffer->readIndex = (uint16_t) (writeIndex - readRingBuffer->bufferSize);
+    }
+}
+
+/* Private functions definition-----------------------------------------------*/
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
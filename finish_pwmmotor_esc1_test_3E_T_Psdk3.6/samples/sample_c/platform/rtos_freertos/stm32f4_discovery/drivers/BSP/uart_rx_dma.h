@@ -0,0 +1,55 @@
+/**
+ ********************************************************************
+ * @file    uart_rx_dma.h
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   This is the header file for "uart_rx_dma.c", defining the structure and
+ * (exported) function prototypes.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef UART_RX_DMA_H
+#define UART_RX_DMA_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "dji_ringbuffer.h"
+#include "uart.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Exported constants --------------------------------------------------------*/
+
+/* Exported types ------------------------------------------------------------*/
+
+/* Exported functions --------------------------------------------------------*/
+uint16_t UartRxDma_Update(uint16_t *lastPosition, T_RingBuffer *readRingBuffer, uint16_t dmaRemainCount,
+                          T_UartBufferState *readBufferState);
+void UartRxDma_Resync(T_RingBuffer *readRingBuffer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UART_RX_DMA_H
+/************************ (C) COPYRIGHT DJI Innovations *******END OF FILE******/
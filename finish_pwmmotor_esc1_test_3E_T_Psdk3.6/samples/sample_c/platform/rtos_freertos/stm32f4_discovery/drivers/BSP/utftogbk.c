@@ -3,66 +3,240 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <errno.h>
 #include "iconv.h"
+#ifdef _MSC_VER
 #pragma comment(lib,"libiconv.lib")
+#endif
 
-//iInLenĳȲ\0ӦstrlenֵǴsOut
-int Utf8ToGb2312(char *sOut, int iMaxOutLen, const char *sIn, int iInLen)
+//Linuxÿ̻߳ԼiconvRTOSûֲ߳̾洢Ȼÿδ򿪹ر
+#if defined(__linux__)
+#include <pthread.h>
+#define UTFTOGBK_USE_THREAD_CACHE
+#endif
+
+typedef struct
+{
+    iconv_t cd[UTFTOGBK_DIRECTION_NUM];
+} T_UtfToGbkCache;
+
+//ÿĿԴ
+static const char *const s_utfToGbkCode[UTFTOGBK_DIRECTION_NUM][2] =
+{
+    {"gb2312", "utf-8"},
+    {"utf-8", "gb2312"},
+};
+
+#ifdef UTFTOGBK_USE_THREAD_CACHE
+static pthread_key_t s_utfToGbkCacheKey;
+static pthread_once_t s_utfToGbkCacheOnce = PTHREAD_ONCE_INIT;
+static int s_utfToGbkCacheKeyValid = 0;
+
+//߳˳ʱرո̻߳ľ
+static void UtfToGbk_FreeCache(void *arg)
+{
+    T_UtfToGbkCache *cache = (T_UtfToGbkCache *)arg;
+    int i;
+
+    for (i = 0; i < UTFTOGBK_DIRECTION_NUM; i++)
+    {
+        if (cache->cd[i] != (iconv_t) - 1)
+        {
+            iconv_close(cache->cd[i]);
+        }
+    }
+    free(cache);
+}
+
+static void UtfToGbk_CreateCacheKey(void)
+{
+    s_utfToGbkCacheKeyValid = pthread_key_create(&s_utfToGbkCacheKey, UtfToGbk_FreeCache) == 0;
+}
+
+static T_UtfToGbkCache *UtfToGbk_GetCache(void)
+{
+    T_UtfToGbkCache *cache;
+    int i;
+
+    pthread_once(&s_utfToGbkCacheOnce, UtfToGbk_CreateCacheKey);
+    if (!s_utfToGbkCacheKeyValid)
+    {
+        return NULL;
+    }
+
+    cache = (T_UtfToGbkCache *)pthread_getspecific(s_utfToGbkCacheKey);
+    if (cache != NULL)
+    {
+        return cache;
+    }
+
+    cache = (T_UtfToGbkCache *)malloc(sizeof(T_UtfToGbkCache));
+    if (cache == NULL)
+    {
+        return NULL;
+    }
+    for (i = 0; i < UTFTOGBK_DIRECTION_NUM; i++)
+    {
+        cache->cd[i] = (iconv_t) - 1;
+    }
+    if (pthread_setspecific(s_utfToGbkCacheKey, cache) != 0)
+    {
+        free(cache);
+        return NULL;
+    }
+
+    return cache;
+}
+#endif
+
+//ȡñ̻߳ľûлʱһʱ*pIsCachedΪ0ʾҪر
+static iconv_t UtfToGbk_AcquireCd(E_UtfToGbkDirection direction, int *pIsCached)
+{
+#ifdef UTFTOGBK_USE_THREAD_CACHE
+    T_UtfToGbkCache *cache = UtfToGbk_GetCache();
+
+    if (cache != NULL)
+    {
+        if (cache->cd[direction] == (iconv_t) - 1)
+        {
+            cache->cd[direction] = iconv_open(s_utfToGbkCode[direction][0], s_utfToGbkCode[direction][1]);
+        }
+        else
+        {
+            //λת״̬һεóʱַܲ
+            iconv(cache->cd[direction], NULL, NULL, NULL, NULL);
+        }
+        *pIsCached = 1;
+        return cache->cd[direction];
+    }
+#endif
+
+    *pIsCached = 0;
+    return iconv_open(s_utfToGbkCode[direction][0], s_utfToGbkCode[direction][1]);
+}
+
+static void UtfToGbk_ReleaseCd(iconv_t cd, int isCached)
+{
+    if (!isCached)
+    {
+        iconv_close(cd);
+    }
+}
+
+static int UtfToGbk_Convert(E_UtfToGbkDirection direction, char *sOut, int iMaxOutLen, const char *sIn, int iInLen)
 {
     char *pIn = (char *)sIn;
     char *pOut = sOut;
     size_t ret;
-    size_t iLeftLen=iMaxOutLen;
+    size_t iLeftLen = iMaxOutLen;
+    size_t iSrcLen = iInLen;
+    int isCached;
     iconv_t cd;
 
-    cd = iconv_open("gb2312", "utf-8");
-
+    cd = UtfToGbk_AcquireCd(direction, &isCached);
     if (cd == (iconv_t) - 1)
     {
         return -1;
     }
-	
-    size_t iSrcLen=iInLen;
-    ret = iconv(cd, &pIn,&iSrcLen, &pOut,&iLeftLen);
-	
+
+    ret = iconv(cd, &pIn, &iSrcLen, &pOut, &iLeftLen);
+    UtfToGbk_ReleaseCd(cd, isCached);
+
     if (ret == (size_t) - 1)
     {
-        iconv_close(cd);
         return -1;
     }
 
-    iconv_close(cd);
-
     return (iMaxOutLen - iLeftLen);
 }
 
+//iInLenĳȲ\0ӦstrlenֵǴsOut
+int Utf8ToGb2312(char *sOut, int iMaxOutLen, const char *sIn, int iInLen)
+{
+    return UtfToGbk_Convert(UTFTOGBK_UTF8_TO_GB2312, sOut, iMaxOutLen, sIn, iInLen);
+}
+
 //iInLenĳȲ\0ӦstrlenֵǴsOut
 int Gb2312ToUtf8(char *sOut, int iMaxOutLen, const char *sIn, int iInLen)
 {
-    char *pIn = (char *)sIn;
-    char *pOut = sOut;
-    size_t ret;
-    size_t iLeftLen=iMaxOutLen;
+    return UtfToGbk_Convert(UTFTOGBK_GB2312_TO_UTF8, sOut, iMaxOutLen, sIn, iInLen);
+}
+
+//򿪷ֶתɹ0
+int UtfToGbkStream_Begin(T_UtfToGbkStream *stream, E_UtfToGbkDirection direction)
+{
     iconv_t cd;
 
+    if (stream == NULL || direction >= UTFTOGBK_DIRECTION_NUM)
+    {
+        return -1;
+    }
 
-    cd = iconv_open("utf-8", "gb2312");
-	
+    cd = iconv_open(s_utfToGbkCode[direction][0], s_utfToGbkCode[direction][1]);
     if (cd == (iconv_t) - 1)
     {
         return -1;
     }
-    size_t iSrcLen=iInLen;
-	
-    ret = iconv(cd, &pIn,&iSrcLen, &pOut,&iLeftLen);
-    if (ret == (size_t) - 1)
+
+    stream->cd = (void *)cd;
+    stream->pendingLen = 0;
+
+    return 0;
+}
+
+//תһ룬βضϵַһתֵǱдsOutĳȣ
+//ǷsOutʱ-1ʱܼʹãֻEnd
+int UtfToGbkStream_Write(T_UtfToGbkStream *stream, char *sOut, int iMaxOutLen, const char *sIn, int iInLen)
+{
+    iconv_t cd = (iconv_t)stream->cd;
+    char *pIn = (char *)sIn;
+    char *pOut = sOut;
+    char *pPending;
+    size_t iLeftLen = iMaxOutLen;
+    size_t iSrcLen = iInLen;
+    size_t iPendingLen;
+
+    //һβַ
+    while (stream->pendingLen != 0 && iSrcLen != 0)
     {
-        iconv_close(cd);
-        return -1;
+        stream->pending[stream->pendingLen++] = *pIn++;
+        iSrcLen--;
+
+        pPending = stream->pending;
+        iPendingLen = stream->pendingLen;
+        if (iconv(cd, &pPending, &iPendingLen, &pOut, &iLeftLen) != (size_t) - 1)
+        {
+            stream->pendingLen = 0;
+            break;
+        }
+        if (errno != EINVAL || stream->pendingLen == UTFTOGBK_STREAM_PENDING_MAX)
+        {
+            return -1;
+        }
     }
 
-    iconv_close(cd);
+    if (iSrcLen != 0 && iconv(cd, &pIn, &iSrcLen, &pOut, &iLeftLen) == (size_t) - 1)
+    {
+        if (errno != EINVAL || iSrcLen > UTFTOGBK_STREAM_PENDING_MAX)
+        {
+            return -1;
+        }
+        memcpy(stream->pending, pIn, iSrcLen);
+        stream->pendingLen = (int)iSrcLen;
+    }
 
     return (iMaxOutLen - iLeftLen);
 }
 
+//رշֶתַмʱ-1
+int UtfToGbkStream_End(T_UtfToGbkStream *stream)
+{
+    int ret = stream->pendingLen == 0 ? 0 : -1;
+
+    iconv_close((iconv_t)stream->cd);
+    stream->cd = NULL;
+    stream->pendingLen = 0;
+
+    return ret;
+}
+
@@ -1,7 +1,29 @@
 #ifndef _UTFTOGBK_H_
 #define _UTFTOGBK_H_
 
+//UTF-8GB2312ֶ֮תֶֽα߽ϱضϵַȻ
+#define UTFTOGBK_STREAM_PENDING_MAX     8
+
+typedef enum
+{
+    UTFTOGBK_UTF8_TO_GB2312 = 0,
+    UTFTOGBK_GB2312_TO_UTF8,
+    UTFTOGBK_DIRECTION_NUM,
+} E_UtfToGbkDirection;
+
+//ݵķֶתռһiconvBeginEnd֮ԶWrite
+typedef struct
+{
+    void *cd;
+    char pending[UTFTOGBK_STREAM_PENDING_MAX];
+    int pendingLen;
+} T_UtfToGbkStream;
+
 int Utf8ToGb2312(char *sOut, int iMaxOutLen, const char *sIn, int iInLen);
 int Gb2312ToUtf8(char *sOut, int iMaxOutLen, const char *sIn, int iInLen);
 
+int UtfToGbkStream_Begin(T_UtfToGbkStream *stream, E_UtfToGbkDirection direction);
+int UtfToGbkStream_Write(T_UtfToGbkStream *stream, char *sOut, int iMaxOutLen, const char *sIn, int iInLen);
+int UtfToGbkStream_End(T_UtfToGbkStream *stream);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,254 @@
+/**
+ ********************************************************************
+ * @file    widget_bus.c
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   Publish and subscribe of widget value changes. Changes are coalesced per widget until the
+ *          subscriber takes them, and subscriber is woken through a FreeRTOS queue.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "widget_bus.h"
+#include "time_base.h"
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "task.h"
+
+/* Private constants ---------------------------------------------------------*/
+
+/* Private types -------------------------------------------------------------*/
+typedef struct {
+    E_DjiWidgetType widgetType;
+    int32_t value;
+    uint64_t timeUs;
+    uint32_t countOfCoalesced;
+} T_WidgetBusSlot;
+
+typedef struct {
+    char name[WIDGET_BUS_SUBSCRIBER_NAME_MAX_LEN];
+    uint32_t indexMask;
+    //an index is queued once when its slot turns pending, so queue never holds more than WIDGET_BUS_INDEX_NUM items
+    QueueHandle_t queue;
+    uint32_t pendingMask;
+    T_WidgetBusSlot slot[WIDGET_BUS_INDEX_NUM];
+    uint32_t countOfEvent;
+    uint32_t countOfDropped;
+    uint64_t sumOfLatencyUs;
+    uint32_t maxLatencyUs;
+} T_WidgetBusSubscriber;
+
+/* Private values -------------------------------------------------------------*/
+static T_WidgetBusSubscriber s_widgetBusSubscriber[WIDGET_BUS_SUBSCRIBER_MAX_NUM];
+static uint16_t s_widgetBusSubscriberNum = 0;
+static T_WidgetBusSnapshot s_widgetBusSnapshot = {0};
+
+/* Private functions declaration ---------------------------------------------*/
+
+/* Exported functions definition ---------------------------------------------*/
+/**
+ * @brief Subscribe to changes of a set of widgets.
+ * @param name: name used in state report, truncated to WIDGET_BUS_SUBSCRIBER_NAME_MAX_LEN - 1 characters.
+ * @param indexMask: widgets of interest, bit n set by WIDGET_BUS_INDEX_MASK(n) for widget of index n.
+ * @param handle: handle used to receive events.
+ * @return Execution result.
+ */
+T_DjiReturnCode WidgetBus_Subscribe(const char *name, uint32_t indexMask, T_WidgetBusHandle *handle)
+{
+    T_WidgetBusSubscriber *subscriber;
+    QueueHandle_t queue;
+
+    if (name == NULL || indexMask == 0 || handle == NULL) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    queue = xQueueCreate(WIDGET_BUS_INDEX_NUM, sizeof(uint8_t));
+    if (queue == NULL) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_MEMORY_ALLOC_FAILED;
+    }
+
+    taskENTER_CRITICAL();
+    if (s_widgetBusSubscriberNum >= WIDGET_BUS_SUBSCRIBER_MAX_NUM) {
+        taskEXIT_CRITICAL();
+        vQueueDelete(queue);
+        return DJI_ERROR_SYSTEM_MODULE_CODE_OUT_OF_RANGE;
+    }
+    subscriber = &s_widgetBusSubscriber[s_widgetBusSubscriberNum];
+    memset(subscriber, 0, sizeof(T_WidgetBusSubscriber));
+    strncpy(subscriber->name, name, WIDGET_BUS_SUBSCRIBER_NAME_MAX_LEN - 1);
+    subscriber->indexMask = indexMask;
+    subscriber->queue = queue;
+    //publisher only walks subscribers below count, so count is raised after subscriber is filled in
+    s_widgetBusSubscriberNum++;
+    taskEXIT_CRITICAL();
+
+    *handle = subscriber;
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+/**
+ * @brief Publish value change of a widget to snapshot and subscribers. Has the signature of value changed callback
+ * of widget sample, so that it can be registered directly.
+ * @note Must not be called from interrupt.
+ * @param widgetType: type of widget.
+ * @param index: index of widget, changes of index out of WIDGET_BUS_INDEX_NUM are ignored.
+ * @param value: new value of widget.
+ * @return None.
+ */
+void WidgetBus_Publish(E_DjiWidgetType widgetType, uint32_t index, int32_t value)
+{
+    T_WidgetBusSubscriber *subscriber;
+    T_WidgetBusSlot *slot;
+    uint64_t timeUs;
+    uint16_t subscriberNum;
+    uint16_t i;
+    uint8_t queueItem = (uint8_t) index;
+    bool isQueueNeeded;
+
+    if (index >= WIDGET_BUS_INDEX_NUM) {
+        return;
+    }
+
+    timeUs = TimeBase_GetUs();
+
+    taskENTER_CRITICAL();
+    s_widgetBusSnapshot.value[index] = value;
+    s_widgetBusSnapshot.sequence++;
+    subscriberNum = s_widgetBusSubscriberNum;
+    taskEXIT_CRITICAL();
+
+    for (i = 0; i < subscriberNum; i++) {
+        subscriber = &s_widgetBusSubscriber[i];
+        if ((subscriber->indexMask & WIDGET_BUS_INDEX_MASK(index)) == 0) {
+            continue;
+        }
+
+        slot = &subscriber->slot[index];
+        taskENTER_CRITICAL();
+        isQueueNeeded = (subscriber->pendingMask & WIDGET_BUS_INDEX_MASK(index)) == 0;
+        if (isQueueNeeded) {
+            subscriber->pendingMask |= WIDGET_BUS_INDEX_MASK(index);
+            slot->timeUs = timeUs;
+            slot->countOfCoalesced = 0;
+        } else {
+            //keep time of oldest change so that latency covers the whole wait
+            slot->countOfCoalesced++;
+            subscriber->countOfDropped++;
+        }
+        slot->widgetType = widgetType;
+        slot->value = value;
+        taskEXIT_CRITICAL();
+
+        if (isQueueNeeded) {
+            xQueueSend(subscriber->queue, &queueItem, 0);
+        }
+    }
+}
+
+/**
+ * @brief Wait for next change of the widgets a subscriber is interested in.
+ * @param handle: handle of subscriber.
+ * @param event: latest value of changed widget.
+ * @param timeoutMs: max time to wait, 0 to return immediately.
+ * @return Execution result, DJI_ERROR_SYSTEM_MODULE_CODE_TIMEOUT if no change before timeout.
+ */
+T_DjiReturnCode WidgetBus_Receive(T_WidgetBusHandle handle, T_WidgetBusEvent *event, uint32_t timeoutMs)
+{
+    T_WidgetBusSubscriber *subscriber = (T_WidgetBusSubscriber *) handle;
+    T_WidgetBusSlot *slot;
+    uint8_t queueItem;
+    uint64_t timeUs;
+    uint32_t latencyUs;
+
+    if (subscriber == NULL || event == NULL) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    if (xQueueReceive(subscriber->queue, &queueItem, pdMS_TO_TICKS(timeoutMs)) != pdTRUE) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_TIMEOUT;
+    }
+
+    timeUs = TimeBase_GetUs();
+    slot = &subscriber->slot[queueItem];
+
+    taskENTER_CRITICAL();
+    event->widgetType = slot->widgetType;
+    event->index = queueItem;
+    event->value = slot->value;
+    event->timeUs = slot->timeUs;
+    event->countOfCoalesced = slot->countOfCoalesced;
+    subscriber->pendingMask &= ~WIDGET_BUS_INDEX_MASK(queueItem);
+
+    latencyUs = timeUs > slot->timeUs ? (uint32_t) (timeUs - slot->timeUs) : 0;
+    subscriber->countOfEvent++;
+    subscriber->sumOfLatencyUs += latencyUs;
+    if (latencyUs > subscriber->maxLatencyUs) {
+        subscriber->maxLatencyUs = latencyUs;
+    }
+    taskEXIT_CRITICAL();
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+/**
+ * @brief Copy values of all widgets at once, no change is published in the middle of copy.
+ * @param snapshot: values of widgets and count of changes so far.
+ * @return None.
+ */
+void WidgetBus_GetSnapshot(T_WidgetBusSnapshot *snapshot)
+{
+    taskENTER_CRITICAL();
+    memcpy(snapshot, &s_widgetBusSnapshot, sizeof(T_WidgetBusSnapshot));
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Get delivery state of a subscriber, for report.
+ * @param index: index of subscriber in order of subscription.
+ * @param state: delivery state.
+ * @return Execution result, DJI_ERROR_SYSTEM_MODULE_CODE_OUT_OF_RANGE if index is not less than count of subscribers.
+ */
+T_DjiReturnCode WidgetBus_GetSubscriberState(uint16_t index, T_WidgetBusSubscriberState *state)
+{
+    T_WidgetBusSubscriber *subscriber;
+
+    if (index >= s_widgetBusSubscriberNum) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_OUT_OF_RANGE;
+    }
+
+    subscriber = &s_widgetBusSubscriber[index];
+    taskENTER_CRITICAL();
+    memcpy(state->name, subscriber->name, sizeof(state->name));
+    state->indexMask = subscriber->indexMask;
+    state->countOfEvent = subscriber->countOfEvent;
+    state->countOfDropped = subscriber->countOfDropped;
+    state->averageLatencyUs = subscriber->countOfEvent != 0 ?
+                              (uint32_t) (subscriber->sumOfLatencyUs / subscriber->countOfEvent) : 0;
+    state->maxLatencyUs = subscriber->maxLatencyUs;
+    taskEXIT_CRITICAL();
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+/* Private functions definition-----------------------------------------------*/
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
@@ -0,0 +1,84 @@
+/**
+ ********************************************************************
+ * @file    widget_bus.h
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   This is the header file for "widget_bus.c", defining the structure and
+ *          (exported) function prototypes.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef WIDGET_BUS_H
+#define WIDGET_BUS_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "dji_typedef.h"
+#include "dji_widget.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Exported constants --------------------------------------------------------*/
+//widget indexes a subscriber is interested in are given as bit mask
+#define WIDGET_BUS_INDEX_NUM                32
+#define WIDGET_BUS_INDEX_MASK(index)        (1UL << (index))
+#define WIDGET_BUS_SUBSCRIBER_MAX_NUM       4
+#define WIDGET_BUS_SUBSCRIBER_NAME_MAX_LEN  16
+
+/* Exported types ------------------------------------------------------------*/
+typedef void *T_WidgetBusHandle;
+
+typedef struct {
+    E_DjiWidgetType widgetType;
+    uint32_t index;
+    int32_t value; /*!< Latest value, changes not yet received are coalesced into one event. */
+    uint64_t timeUs; /*!< Time of oldest change coalesced into this event. */
+    uint32_t countOfCoalesced; /*!< Changes replaced by a later one before received. */
+} T_WidgetBusEvent;
+
+typedef struct {
+    int32_t value[WIDGET_BUS_INDEX_NUM];
+    uint32_t sequence; /*!< Count of changes published, snapshots of same sequence are identical. */
+} T_WidgetBusSnapshot;
+
+typedef struct {
+    char name[WIDGET_BUS_SUBSCRIBER_NAME_MAX_LEN];
+    uint32_t indexMask;
+    uint32_t countOfEvent; /*!< Events received by subscriber. */
+    uint32_t countOfDropped; /*!< Changes coalesced away before subscriber received them. */
+    uint32_t averageLatencyUs; /*!< Average time from change to receive. */
+    uint32_t maxLatencyUs;
+} T_WidgetBusSubscriberState;
+
+/* Exported functions --------------------------------------------------------*/
+T_DjiReturnCode WidgetBus_Subscribe(const char *name, uint32_t indexMask, T_WidgetBusHandle *handle);
+void WidgetBus_Publish(E_DjiWidgetType widgetType, uint32_t index, int32_t value);
+T_DjiReturnCode WidgetBus_Receive(T_WidgetBusHandle handle, T_WidgetBusEvent *event, uint32_t timeoutMs);
+void WidgetBus_GetSnapshot(T_WidgetBusSnapshot *snapshot);
+T_DjiReturnCode WidgetBus_GetSubscriberState(uint16_t index, T_WidgetBusSubscriberState *state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WIDGET_BUS_H
+/************************ (C) COPYRIGHT DJI Innovations *******END OF FILE******/
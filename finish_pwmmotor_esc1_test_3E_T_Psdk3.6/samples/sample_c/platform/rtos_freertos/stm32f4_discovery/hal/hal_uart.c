@@ -28,6 +28,8 @@
 #include "hal_uart.h"
 #include "uart.h"
 #include "dji_platform.h"
+#include "FreeRTOS.h"
+#include "task.h"
 
 #if USE_USB_HOST_UART
 
@@ -48,6 +50,10 @@ typedef struct {
     T_UserUartNum uartNum;
 } T_UartHandleStruct;
 
+/* Private values -------------------------------------------------------------*/
+static volatile uint32_t s_lastReceiveTimeMs = 0;
+static volatile bool s_isDataReceived = false;
+
 /* Private functions declaration ---------------------------------------------*/
 
 /* Exported functions definition ---------------------------------------------*/
@@ -85,7 +91,13 @@ T_DjiReturnCode HalUart_WriteData(T_DjiUartHandle uartHandle, const uint8_t *buf
     int32_t ret;
 
     if (uartHandleStruct->uartNum == USER_UART_NUM0) {
-        UART_Write(COMMUNICATION_UART_NUM, buf, len);
+        //data is queued to write buffer and sent by interrupt or DMA, no need to wait for transmission here
+        ret = UART_Write(COMMUNICATION_UART_NUM, buf, len);
+        if (ret < 0) {
+            *realLen = 0;
+            return DJI_ERROR_SYSTEM_MODULE_CODE_UNKNOWN;
+        }
+        *realLen = ret;
     } else if (uartHandleStruct->uartNum == USER_UART_NUM1) {
         USBH_CDC_WriteData(buf, len, realLen);
     }
@@ -100,6 +112,10 @@ T_DjiReturnCode HalUart_ReadData(T_DjiUartHandle uartHandle, uint8_t *buf, uint3
 
     if (uartHandleStruct->uartNum == USER_UART_NUM0) {
         *realLen = UART_Read(COMMUNICATION_UART_NUM, buf, len);
+        if (*realLen > 0) {
+            s_lastReceiveTimeMs = xTaskGetTickCount();
+            s_isDataReceived = true;
+        }
     } else if (uartHandleStruct->uartNum == USER_UART_NUM1) {
         USBH_CDC_ReadData(buf, len, realLen);
     }
@@ -120,6 +136,22 @@ T_DjiReturnCode HalUart_GetStatus(E_DjiHalUartNum uartNum, T_DjiUartStatus *stat
     return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
 }
 
+/**
+ * @brief Get time data was last received from aircraft on communication uart, used to tell whether link is alive.
+ * @param timeMs: pointer to time, same clock as Osal_GetTimeMs, unit: ms.
+ * @return Execution result, not found if no data is received yet.
+ */
+T_DjiReturnCode HalUart_GetLastReceiveTimeMs(uint32_t *timeMs)
+{
+    if (!s_isDataReceived) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
+    }
+
+    *timeMs = s_lastReceiveTimeMs;
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
 /* Private functions definition-----------------------------------------------*/
 
 /****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
@@ -48,6 +48,7 @@ T_DjiReturnCode HalUart_DeInit(T_DjiUartHandle uartHandle);
 T_DjiReturnCode HalUart_WriteData(T_DjiUartHandle uartHandle, const uint8_t *buf, uint32_t len, uint32_t *realLen);
 T_DjiReturnCode HalUart_ReadData(T_DjiUartHandle uartHandle, uint8_t *buf, uint32_t len, uint32_t *realLen);
 T_DjiReturnCode HalUart_GetStatus(E_DjiHalUartNum uartNum, T_DjiUartStatus *status);
+T_DjiReturnCode HalUart_GetLastReceiveTimeMs(uint32_t *timeMs);
 
 #ifdef __cplusplus
 }
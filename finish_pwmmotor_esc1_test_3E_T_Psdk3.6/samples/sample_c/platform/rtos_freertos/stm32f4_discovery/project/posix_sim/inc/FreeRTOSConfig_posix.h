@@ -0,0 +1,82 @@
+/**
+ ********************************************************************
+ * @file    FreeRTOSConfig_posix.h
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   FreeRTOS configuration for host simulator build with the FreeRTOS POSIX port,
+ *          kept in line with application/FreeRTOSConfig.h except for port specific items.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef FREERTOS_CONFIG_POSIX_H
+#define FREERTOS_CONFIG_POSIX_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <assert.h>
+#include <limits.h>
+
+/* Exported constants --------------------------------------------------------*/
+#define configUSE_PREEMPTION                     1
+#define configSUPPORT_STATIC_ALLOCATION          0
+#define configSUPPORT_DYNAMIC_ALLOCATION         1
+#define configUSE_IDLE_HOOK                      0
+#define configUSE_TICK_HOOK                      0
+#define configCPU_CLOCK_HZ                       ((unsigned long) 168000000)
+#define configTICK_RATE_HZ                       ((TickType_t)1000)
+#define configMAX_PRIORITIES                     ( 7 )
+//pthread stack is allocated by port, stack depth is only used for high water mark
+#define configMINIMAL_STACK_SIZE                 ((uint16_t)PTHREAD_STACK_MIN)
+//task stacks are allocated from heap and StackType_t is 8 bytes on host, heap is much larger than target
+#define configTOTAL_HEAP_SIZE                    ((size_t)(16 * 1024 * 1024))
+#define configMAX_TASK_NAME_LEN                  ( 16 )
+#define configUSE_16_BIT_TICKS                   0
+#define configUSE_MUTEXES                        1
+#define configQUEUE_REGISTRY_SIZE                8
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION  0
+#define configMESSAGE_BUFFER_LENGTH_TYPE         size_t
+
+/* Co-routine definitions. */
+#define configUSE_CO_ROUTINES                    0
+#define configMAX_CO_ROUTINE_PRIORITIES          ( 2 )
+
+/* Set the following definitions to 1 to include the API function, or zero
+to exclude the API function. */
+#define INCLUDE_vTaskPrioritySet                 1
+#define INCLUDE_uxTaskPriorityGet                1
+#define INCLUDE_vTaskDelete                      1
+#define INCLUDE_vTaskCleanUpResources            0
+#define INCLUDE_vTaskSuspend                     1
+#define INCLUDE_vTaskDelayUntil                  0
+#define INCLUDE_vTaskDelay                       1
+#define INCLUDE_xTaskGetSchedulerState           1
+#define INCLUDE_uxTaskGetStackHighWaterMark      1
+
+/* Kernel interrupt priorities are not used by POSIX port, keep them defined for shared code. */
+#define configLIBRARY_LOWEST_INTERRUPT_PRIORITY      15
+#define configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY 5
+#define configKERNEL_INTERRUPT_PRIORITY             255
+#define configMAX_SYSCALL_INTERRUPT_PRIORITY        191
+
+//abort instead of spinning, so sanitizers and debugger show where the assertion failed
+#define configASSERT(x)                          assert(x)
+
+#endif // FREERTOS_CONFIG_POSIX_H
+/************************ (C) COPYRIGHT DJI Innovations *******END OF FILE******/
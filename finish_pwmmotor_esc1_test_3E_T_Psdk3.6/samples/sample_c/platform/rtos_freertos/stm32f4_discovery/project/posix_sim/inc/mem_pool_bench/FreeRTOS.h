@@ -0,0 +1,89 @@
+/**
+ ********************************************************************
+ * @file    FreeRTOS.h
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   Minimal FreeRTOS header for host memory pool bench, just enough of the kernel for
+ *          heap_4.c and osal_mem_pool.c of target to run single threaded on host.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef FREERTOS_MEM_POOL_BENCH_H
+#define FREERTOS_MEM_POOL_BENCH_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+#include <assert.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Exported constants --------------------------------------------------------*/
+//same heap as application/FreeRTOSConfig.h and alignment as portmacro.h of ARM_CM4F
+#define configTOTAL_HEAP_SIZE                    ((size_t)75000)
+#define configSUPPORT_DYNAMIC_ALLOCATION         1
+#define configAPPLICATION_ALLOCATED_HEAP         0
+#define configUSE_MALLOC_FAILED_HOOK             0
+#define configASSERT(x)                          assert(x)
+
+#define portBYTE_ALIGNMENT                       8
+#define portBYTE_ALIGNMENT_MASK                  (0x0007)
+#define portMAX_DELAY                            ((size_t) -1)
+#define PRIVILEGED_FUNCTION
+
+//bench is single threaded, there is nothing to lock against
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+
+#define mtCOVERAGE_TEST_MARKER()
+#define traceMALLOC(pvAddress, uiSize)
+#define traceFREE(pvAddress, uiSize)
+
+/* Exported types ------------------------------------------------------------*/
+typedef long BaseType_t;
+
+typedef struct {
+    size_t xAvailableHeapSpaceInBytes;
+    size_t xSizeOfLargestFreeBlockInBytes;
+    size_t xSizeOfSmallestFreeBlockInBytes;
+    size_t xNumberOfFreeBlocks;
+    size_t xMinimumEverFreeBytesRemaining;
+    size_t xNumberOfSuccessfulAllocations;
+    size_t xNumberOfSuccessfulFrees;
+} HeapStats_t;
+
+/* Exported functions --------------------------------------------------------*/
+void *pvPortMalloc(size_t xSize);
+void vPortFree(void *pv);
+void vPortInitialiseBlocks(void);
+size_t xPortGetFreeHeapSize(void);
+size_t xPortGetMinimumEverFreeHeapSize(void);
+void vPortGetHeapStats(HeapStats_t *pxHeapStats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FREERTOS_MEM_POOL_BENCH_H
+/************************ (C) COPYRIGHT DJI Innovations *******END OF FILE******/
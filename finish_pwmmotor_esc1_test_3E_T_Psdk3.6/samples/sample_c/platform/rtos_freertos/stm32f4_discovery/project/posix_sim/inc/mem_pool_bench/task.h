@@ -0,0 +1,55 @@
+/**
+ ********************************************************************
+ * @file    task.h
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   Minimal task header for host memory pool bench, the bench is single threaded,
+ *          so suspending the scheduler does nothing.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef TASK_MEM_POOL_BENCH_H
+#define TASK_MEM_POOL_BENCH_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Exported functions --------------------------------------------------------*/
+static inline void vTaskSuspendAll(void)
+{
+}
+
+static inline BaseType_t xTaskResumeAll(void)
+{
+    return 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TASK_MEM_POOL_BENCH_H
+/************************ (C) COPYRIGHT DJI Innovations *******END OF FILE******/
@@ -0,0 +1,71 @@
+/**
+ ********************************************************************
+ * @file    motor_capture_signal_sim.h
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   This is the header file for "motor_capture_signal_sim.c", defining the structure and
+ *          (exported) function prototypes.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef MOTOR_CAPTURE_SIGNAL_SIM_H
+#define MOTOR_CAPTURE_SIGNAL_SIM_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Exported constants --------------------------------------------------------*/
+
+/* Exported types ------------------------------------------------------------*/
+//pulse and tachometer edges captured by a 16 bit timer counting in us, written into circular buffers the way DMA
+//of motor_capture.c does, time is advanced by caller instead of following host clock
+typedef struct {
+    uint16_t *pulseBuffer;
+    uint16_t pulseBufferLen;
+    uint16_t pulseWriteIndex;
+    uint16_t *tachBuffer;
+    uint16_t tachBufferLen;
+    uint16_t tachWriteIndex;
+    uint32_t timeUs;
+    uint32_t nextRiseUs;
+    uint32_t lastFallUs;
+    uint32_t nextTachUs;
+    bool isPulseRunning;
+    bool isTachRunning;
+} T_MotorCaptureSignalSim;
+
+/* Exported functions --------------------------------------------------------*/
+void MotorCaptureSignalSim_Init(T_MotorCaptureSignalSim *signal, uint16_t *pulseBuffer, uint16_t pulseBufferLen,
+                                uint16_t *tachBuffer, uint16_t tachBufferLen);
+void MotorCaptureSignalSim_Advance(T_MotorCaptureSignalSim *signal, uint32_t durationUs, uint32_t pulseWidthUs,
+                                   uint32_t pulsePeriodUs, uint32_t tachPeriodUs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MOTOR_CAPTURE_SIGNAL_SIM_H
+/************************ (C) COPYRIGHT DJI Innovations *******END OF FILE******/
@@ -0,0 +1,111 @@
+/**
+ ********************************************************************
+ * @file    motor_plant_model_sim.h
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   This is the header file for "motor_plant_model_sim.c", defining the structure and
+ *          (exported) function prototypes.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef MOTOR_PLANT_MODEL_SIM_H
+#define MOTOR_PLANT_MODEL_SIM_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "stm32f4xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Exported constants --------------------------------------------------------*/
+//samples of a step are taken once per millisecond, with room for late samples
+#define MOTOR_PLANT_MODEL_STEP_SAMPLE_MAX_NUM   2000
+#define MOTOR_PLANT_MODEL_RESULT_MAX_NUM        1024
+
+/* Exported types ------------------------------------------------------------*/
+typedef enum {
+    MOTOR_PLANT_MODEL_ESC_INPUT_PULSE = 0, /*!< Throttle is pulse width between min and max pulse. */
+    MOTOR_PLANT_MODEL_ESC_INPUT_DUTY, /*!< Throttle is duty cycle of whole period. */
+} E_MotorPlantModelEscInput;
+
+typedef struct {
+    const char *name;
+    TIM_TypeDef *instance;
+    E_MotorPlantModelEscInput escInput;
+    uint32_t pulseMinUs;
+    uint32_t pulseMaxUs;
+} T_MotorPlantModelChannelConfig;
+
+typedef struct {
+    uint32_t timeUs; /*!< Time since command of current step. */
+    float rpm;
+} T_MotorPlantModelSample;
+
+//ESC reading PWM of a timer and the motor it drives, time is advanced by caller instead of following host clock
+typedef struct {
+    const T_MotorPlantModelChannelConfig *config;
+    //latest compare write, taken by ESC at first period start after the write, like preloaded compare register
+    bool isComparePending;
+    uint32_t pendingCompare;
+    uint64_t pendingWriteTimeUs;
+    uint32_t compare;
+    uint64_t periodStartUs;
+    uint64_t timeUs;
+    uint32_t pulseUs;
+    double throttle;
+    double speed; /*!< Unit: rad/s. */
+    //measurement of current step
+    bool isStepActive;
+    uint64_t stepCommandTimeUs;
+    double stepStartThrottle;
+    bool isOutputChanged;
+    uint32_t latencyUs;
+    uint32_t sampleNum;
+    T_MotorPlantModelSample sample[MOTOR_PLANT_MODEL_STEP_SAMPLE_MAX_NUM];
+} T_MotorPlantModelChannel;
+
+typedef struct {
+    uint32_t latencyUs[MOTOR_PLANT_MODEL_RESULT_MAX_NUM];
+    uint32_t settlingUs[MOTOR_PLANT_MODEL_RESULT_MAX_NUM];
+    uint32_t resultNum;
+    uint32_t countOfNoResponse;
+} T_MotorPlantModelResult;
+
+/* Exported functions --------------------------------------------------------*/
+void MotorPlantModel_Init(T_MotorPlantModelChannel *channel, const T_MotorPlantModelChannelConfig *config,
+                          uint64_t timeUs);
+void MotorPlantModel_WriteCompare(T_MotorPlantModelChannel *channel, uint32_t compare, uint64_t timeUs);
+void MotorPlantModel_Advance(T_MotorPlantModelChannel *channel, uint64_t timeUs);
+double MotorPlantModel_GetRpm(const T_MotorPlantModelChannel *channel);
+void MotorPlantModel_StartStep(T_MotorPlantModelChannel *channel, uint64_t commandTimeUs);
+void MotorPlantModel_Sample(T_MotorPlantModelChannel *channel);
+void MotorPlantModel_EndStep(T_MotorPlantModelChannel *channel, T_MotorPlantModelResult *result);
+void MotorPlantModel_PrintResult(const char *name, T_MotorPlantModelResult *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MOTOR_PLANT_MODEL_SIM_H
+/************************ (C) COPYRIGHT DJI Innovations *******END OF FILE******/
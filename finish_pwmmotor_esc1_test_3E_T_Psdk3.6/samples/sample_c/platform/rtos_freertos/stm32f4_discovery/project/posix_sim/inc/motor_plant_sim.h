@@ -0,0 +1,53 @@
+/**
+ ********************************************************************
+ * @file    motor_plant_sim.h
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   This is the header file for "motor_plant_sim.c", defining the structure and
+ *          (exported) function prototypes.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef MOTOR_PLANT_SIM_H
+#define MOTOR_PLANT_SIM_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Exported constants --------------------------------------------------------*/
+//set to path of csv file to run control latency bench, process exits after bench is done
+#define MOTOR_PLANT_SIM_CSV_ENV_NAME        "PSDK_SIM_PLANT_CSV"
+
+/* Exported types ------------------------------------------------------------*/
+
+/* Exported functions --------------------------------------------------------*/
+void MotorPlantSim_Init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MOTOR_PLANT_SIM_H
+/************************ (C) COPYRIGHT DJI Innovations *******END OF FILE******/
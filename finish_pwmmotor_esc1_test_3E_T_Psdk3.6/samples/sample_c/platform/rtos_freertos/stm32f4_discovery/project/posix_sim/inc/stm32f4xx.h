@@ -0,0 +1,102 @@
+/**
+ ********************************************************************
+ * @file    stm32f4xx.h
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   Minimal device header for host simulator build, only the register blocks the
+ *          application touches directly are modelled, backed by plain memory.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STM32F4XX_SIM_H
+#define STM32F4XX_SIM_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Exported constants --------------------------------------------------------*/
+#define __IO    volatile
+
+/* Exported types ------------------------------------------------------------*/
+typedef enum {
+    RESET = 0,
+    SET = !RESET
+} FlagStatus, ITStatus;
+
+typedef struct {
+    __IO uint32_t CR1;
+    __IO uint32_t CR2;
+    __IO uint32_t SMCR;
+    __IO uint32_t DIER;
+    __IO uint32_t SR;
+    __IO uint32_t EGR;
+    __IO uint32_t CCMR1;
+    __IO uint32_t CCMR2;
+    __IO uint32_t CCER;
+    __IO uint32_t CNT;
+    __IO uint32_t PSC;
+    __IO uint32_t ARR;
+    __IO uint32_t RCR;
+    __IO uint32_t CCR1;
+    __IO uint32_t CCR2;
+    __IO uint32_t CCR3;
+    __IO uint32_t CCR4;
+} TIM_TypeDef;
+
+typedef struct {
+    __IO uint32_t SR;
+    __IO uint32_t DR;
+    __IO uint32_t BRR;
+    __IO uint32_t CR1;
+    __IO uint32_t CR2;
+    __IO uint32_t CR3;
+} USART_TypeDef;
+
+/* Exported variables --------------------------------------------------------*/
+extern TIM_TypeDef g_simTim13;
+extern TIM_TypeDef g_simTim14;
+extern USART_TypeDef g_simUart4;
+
+#define TIM13               (&g_simTim13)
+#define TIM14               (&g_simTim14)
+#define UART4               (&g_simUart4)
+
+/* Exported functions --------------------------------------------------------*/
+#define __disable_irq()     do {} while (0)
+#define __enable_irq()      do {} while (0)
+
+void NVIC_SystemReset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef USE_HAL_DRIVER
+#include "stm32f4xx_hal.h"
+#endif
+
+#endif // STM32F4XX_SIM_H
+/************************ (C) COPYRIGHT DJI Innovations *******END OF FILE******/
@@ -0,0 +1,116 @@
+/**
+ ********************************************************************
+ * @file    stm32f4xx_hal.h
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   Minimal HAL header for host simulator build, keeps the HAL types and macros used
+ *          by application and BSP headers so they compile unchanged on the host.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STM32F4XX_HAL_SIM_H
+#define STM32F4XX_HAL_SIM_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Exported constants --------------------------------------------------------*/
+#define TIM_CHANNEL_1       0x00000000U
+#define TIM_CHANNEL_2       0x00000004U
+#define TIM_CHANNEL_3       0x00000008U
+#define TIM_CHANNEL_4       0x0000000CU
+#define TIM_CHANNEL_ALL     0x0000003CU
+
+/* Exported types ------------------------------------------------------------*/
+typedef enum {
+    HAL_OK = 0x00U,
+    HAL_ERROR = 0x01U,
+    HAL_BUSY = 0x02U,
+    HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+typedef struct {
+    uint32_t Prescaler;
+    uint32_t CounterMode;
+    uint32_t Period;
+    uint32_t ClockDivision;
+    uint32_t RepetitionCounter;
+    uint32_t AutoReloadPreload;
+} TIM_Base_InitTypeDef;
+
+typedef struct {
+    TIM_TypeDef *Instance;
+    TIM_Base_InitTypeDef Init;
+} TIM_HandleTypeDef;
+
+typedef struct {
+    uint32_t BaudRate;
+    uint32_t WordLength;
+    uint32_t StopBits;
+    uint32_t Parity;
+    uint32_t Mode;
+    uint32_t HwFlowCtl;
+    uint32_t OverSampling;
+} UART_InitTypeDef;
+
+typedef struct {
+    USART_TypeDef *Instance;
+    UART_InitTypeDef Init;
+} UART_HandleTypeDef;
+
+typedef void (*TimSimCompareWriteCallback)(TIM_TypeDef *instance, uint32_t channel, uint32_t compare);
+
+/* Exported macros -----------------------------------------------------------*/
+//compare writes go through simulator timer driver, so that plant model sees the time of each write
+#define __HAL_TIM_SET_COMPARE(__HANDLE__, __CHANNEL__, __COMPARE__) \
+  TimSim_SetCompare((__HANDLE__)->Instance, (__CHANNEL__), (__COMPARE__))
+
+#define __HAL_TIM_GET_COMPARE(__HANDLE__, __CHANNEL__) \
+  (((__CHANNEL__) == TIM_CHANNEL_1) ? ((__HANDLE__)->Instance->CCR1) :\
+   ((__CHANNEL__) == TIM_CHANNEL_2) ? ((__HANDLE__)->Instance->CCR2) :\
+   ((__CHANNEL__) == TIM_CHANNEL_3) ? ((__HANDLE__)->Instance->CCR3) :\
+   ((__HANDLE__)->Instance->CCR4))
+
+#define __HAL_TIM_SET_AUTORELOAD(__HANDLE__, __AUTORELOAD__) \
+  do {                                                    \
+    (__HANDLE__)->Instance->ARR = (__AUTORELOAD__);       \
+    (__HANDLE__)->Init.Period = (__AUTORELOAD__);         \
+  } while(0)
+
+#define __HAL_TIM_GET_AUTORELOAD(__HANDLE__)    ((__HANDLE__)->Instance->ARR)
+
+/* Exported functions --------------------------------------------------------*/
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t Delay);
+
+void TimSim_SetCompare(TIM_TypeDef *instance, uint32_t channel, uint32_t compare);
+void TimSim_RegCompareWriteCallback(TimSimCompareWriteCallback callback);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // STM32F4XX_HAL_SIM_H
+/************************ (C) COPYRIGHT DJI Innovations *******END OF FILE******/
@@ -0,0 +1,62 @@
+/**
+ ********************************************************************
+ * @file    FreeRTOS.h
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   Minimal FreeRTOS header for host widget bus check, just enough of the kernel for
+ *          widget_bus.c of target to run single threaded on host.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef FREERTOS_WIDGET_BUS_CHECK_H
+#define FREERTOS_WIDGET_BUS_CHECK_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Exported constants --------------------------------------------------------*/
+#define pdFALSE                                  ((BaseType_t) 0)
+#define pdTRUE                                   ((BaseType_t) 1)
+#define pdPASS                                   (pdTRUE)
+#define errQUEUE_FULL                            ((BaseType_t) 0)
+#define pdMS_TO_TICKS(xTimeInMs)                 ((TickType_t) (xTimeInMs))
+
+//check is single threaded, there is nothing to lock against
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+
+/* Exported types ------------------------------------------------------------*/
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FREERTOS_WIDGET_BUS_CHECK_H
+/************************ (C) COPYRIGHT DJI Innovations *******END OF FILE******/
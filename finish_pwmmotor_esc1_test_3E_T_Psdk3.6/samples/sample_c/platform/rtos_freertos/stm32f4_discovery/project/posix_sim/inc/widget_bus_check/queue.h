@@ -0,0 +1,104 @@
+/**
+ ********************************************************************
+ * @file    queue.h
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   Minimal queue header for host widget bus check, a queue is a ring of fixed size items,
+ *          receive never blocks as nothing can send while the single thread waits.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef QUEUE_WIDGET_BUS_CHECK_H
+#define QUEUE_WIDGET_BUS_CHECK_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <string.h>
+#include "FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct {
+    UBaseType_t length;
+    UBaseType_t itemSize;
+    UBaseType_t head;
+    UBaseType_t count;
+    uint8_t item[];
+} T_QueueWidgetBusCheck;
+
+typedef T_QueueWidgetBusCheck *QueueHandle_t;
+
+/* Exported functions --------------------------------------------------------*/
+static inline QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize)
+{
+    QueueHandle_t queue = calloc(1, sizeof(T_QueueWidgetBusCheck) + uxQueueLength * uxItemSize);
+
+    if (queue != NULL) {
+        queue->length = uxQueueLength;
+        queue->itemSize = uxItemSize;
+    }
+
+    return queue;
+}
+
+static inline void vQueueDelete(QueueHandle_t xQueue)
+{
+    free(xQueue);
+}
+
+static inline BaseType_t xQueueSend(QueueHandle_t xQueue, const void *pvItemToQueue, TickType_t xTicksToWait)
+{
+    (void) xTicksToWait;
+
+    if (xQueue->count >= xQueue->length) {
+        return errQUEUE_FULL;
+    }
+    memcpy(&xQueue->item[(xQueue->head + xQueue->count) % xQueue->length * xQueue->itemSize], pvItemToQueue,
+           xQueue->itemSize);
+    xQueue->count++;
+
+    return pdPASS;
+}
+
+static inline BaseType_t xQueueReceive(QueueHandle_t xQueue, void *pvBuffer, TickType_t xTicksToWait)
+{
+    (void) xTicksToWait;
+
+    if (xQueue->count == 0) {
+        return pdFALSE;
+    }
+    memcpy(pvBuffer, &xQueue->item[xQueue->head * xQueue->itemSize], xQueue->itemSize);
+    xQueue->head = (xQueue->head + 1) % xQueue->length;
+    xQueue->count--;
+
+    return pdTRUE;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // QUEUE_WIDGET_BUS_CHECK_H
+/************************ (C) COPYRIGHT DJI Innovations *******END OF FILE******/
@@ -0,0 +1,287 @@
+/**
+ ********************************************************************
+ * @file    board_sim.c
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   Board support of host simulator build: LED, PPS, high power apply pin, USB host, debug
+ *          UART with a model of the speech module on it, and the few HAL/CMSIS calls left in shared code.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32f4xx_hal.h"
+#include "led.h"
+#include "pps.h"
+#include "apply_high_power.h"
+#include "usb_host.h"
+#include "bsp_debug_usart.h"
+#include "tts_output.h"
+#include "osal.h"
+
+/* Private constants ---------------------------------------------------------*/
+#define PPS_SIM_PERIOD_MS       1000
+
+//speech module model answers a frame after its line time and speaks about 4 characters of 2 bytes per second
+#define TTS_SIM_TASK_STACK_SIZE 256
+#define TTS_SIM_TASK_PRIORITY   (configMAX_PRIORITIES - 1)
+#define TTS_SIM_ANSWER_MS       2
+#define TTS_SIM_SPEAK_BYTE_MS   125
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private values -------------------------------------------------------------*/
+static uint8_t s_ledState[LED_NUM];
+static E_DjiPowerManagementPinState s_highPowerApplyPinState;
+
+USART_TypeDef g_simUart4;
+UART_HandleTypeDef UartHandle;
+
+static TaskHandle_t s_ttsSimTask = NULL;
+static uint8_t s_ttsSimFrame[TTS_OUTPUT_FRAME_MAX_LEN];
+static uint16_t s_ttsSimFrameLen;
+
+/* Private functions declaration ---------------------------------------------*/
+static void TtsSim_Task(void *arg);
+
+/* Exported functions definition ---------------------------------------------*/
+void Led_Init(E_LedNum ledNum)
+{
+    s_ledState[ledNum] = 0;
+}
+
+void Led_On(E_LedNum ledNum)
+{
+    s_ledState[ledNum] = 1;
+}
+
+void Led_Off(E_LedNum ledNum)
+{
+    s_ledState[ledNum] = 0;
+}
+
+void Led_Trigger(E_LedNum ledNum)
+{
+    s_ledState[ledNum] = !s_ledState[ledNum];
+}
+
+T_DjiReturnCode DjiTest_PpsSignalResponseInit(void)
+{
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+/**
+ * @brief Get local time of newest PPS edge. There is no PPS pin on host, so an edge is assumed on every whole
+ * second of local time.
+ * @param localTimeUs Pointer to local time of newest PPS edge, unit: us.
+ * @return Execution result.
+ */
+T_DjiReturnCode DjiTest_GetNewestPpsTriggerLocalTimeUs(uint64_t *localTimeUs)
+{
+    uint32_t timeMs = 0;
+
+    if (localTimeUs == NULL) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    Osal_GetTimeMs(&timeMs);
+    if (timeMs < PPS_SIM_PERIOD_MS) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_BUSY;
+    }
+
+    *localTimeUs = (uint64_t) (timeMs - timeMs % PPS_SIM_PERIOD_MS) * 1000;
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+T_DjiReturnCode DjiTest_HighPowerApplyPinInit(void)
+{
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+T_DjiReturnCode DjiTest_WriteHighPowerApplyPin(E_DjiPowerManagementPinState pinState)
+{
+    s_highPowerApplyPinState = pinState;
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+void MX_USB_HOST_Init(void)
+{
+}
+
+void USBH_CDC_WriteData(const uint8_t *buf, uint32_t len, uint32_t *realLen)
+{
+    (void) buf;
+    (void) len;
+    *realLen = 0;
+}
+
+void USBH_CDC_ReadData(uint8_t *buf, uint32_t len, uint32_t *realLen)
+{
+    (void) buf;
+    (void) len;
+    *realLen = 0;
+}
+
+void DEBUG_USART_Config(void)
+{
+    UartHandle.Instance = DEBUG_USART;
+    UartHandle.Init.BaudRate = DEBUG_USART_BAUDRATE;
+
+    if (s_ttsSimTask == NULL) {
+        xTaskCreate(TtsSim_Task, "tts_sim", TTS_SIM_TASK_STACK_SIZE, NULL, TTS_SIM_TASK_PRIORITY, &s_ttsSimTask);
+    }
+}
+
+/**
+ * @brief Send frame to model of speech module, which reports end of transmission and answers with status bytes
+ * like the module does.
+ * @param str Pointer to frame.
+ * @param size Size of frame.
+ * @return None.
+ */
+void Usart_SendStringDma(const uint8_t *str, uint16_t size)
+{
+    if (s_ttsSimTask == NULL) {
+        return;
+    }
+
+    s_ttsSimFrameLen = size < sizeof(s_ttsSimFrame) ? size : sizeof(s_ttsSimFrame);
+    memcpy(s_ttsSimFrame, str, s_ttsSimFrameLen);
+    Usart_SendString(s_ttsSimFrame, (uint8_t) s_ttsSimFrameLen);
+    xTaskNotifyGive(s_ttsSimTask);
+}
+
+/**
+ * @brief Send frame to speech module on debug UART, dumped as hex on host.
+ * @param str Pointer to frame.
+ * @param size Size of frame.
+ * @return None.
+ */
+void Usart_SendString(uint8_t *str, uint8_t size)
+{
+    uint8_t i;
+
+    printf("uart4 tx:");
+    for (i = 0; i < size; i++) {
+        printf(" %02X", str[i]);
+    }
+    printf("\r\n");
+}
+
+void NVIC_SystemReset(void)
+{
+    exit(0);
+}
+
+uint32_t HAL_GetTick(void)
+{
+    return xTaskGetTickCount() * portTICK_PERIOD_MS;
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+    vTaskDelay(pdMS_TO_TICKS(Delay));
+}
+
+void Error_Handler(void)
+{
+    abort();
+}
+
+/* Private functions definition-----------------------------------------------*/
+#ifndef __CC_ARM
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-noreturn"
+#pragma GCC diagnostic ignored "-Wreturn-type"
+#endif
+
+//interrupt handlers of target are stood in for by this task, FromISR calls are valid from tasks on POSIX port
+static void TtsSim_Task(void *arg)
+{
+    TickType_t speakEnd = 0;
+    TickType_t timeout;
+    TickType_t now;
+    bool isSpeaking = false;
+    uint8_t status;
+
+    (void) arg;
+
+    while (1) {
+        now = xTaskGetTickCount();
+        if (!isSpeaking) {
+            timeout = portMAX_DELAY;
+        } else {
+            timeout = (int32_t) (speakEnd - now) > 0 ? speakEnd - now : 0;
+        }
+
+        if (ulTaskNotifyTake(pdTRUE, timeout) == 0) {
+            isSpeaking = false;
+            TtsOutput_ReceiveStatusFromIsr(TTS_OUTPUT_STATUS_IDLE);
+            continue;
+        }
+
+        //10 bits per byte on line
+        vTaskDelay(pdMS_TO_TICKS((uint32_t) s_ttsSimFrameLen * 10 * 1000 / DEBUG_USART_BAUDRATE + 1));
+        TtsOutput_TransmitCompleteFromIsr();
+        vTaskDelay(pdMS_TO_TICKS(TTS_SIM_ANSWER_MS));
+
+        if (s_ttsSimFrameLen <= TTS_OUTPUT_FRAME_HEADER_LEN || s_ttsSimFrame[0] != TTS_OUTPUT_FRAME_HEAD ||
+            ((s_ttsSimFrame[1] << 8) | s_ttsSimFrame[2]) != s_ttsSimFrameLen - TTS_OUTPUT_FRAME_HEADER_LEN) {
+            TtsOutput_ReceiveStatusFromIsr(TTS_OUTPUT_STATUS_ERROR);
+            continue;
+        }
+
+        switch (s_ttsSimFrame[TTS_OUTPUT_FRAME_HEADER_LEN]) {
+            case TTS_OUTPUT_COMMAND_SYNTHESIS:
+                TtsOutput_ReceiveStatusFromIsr(TTS_OUTPUT_STATUS_RECEIVED);
+                isSpeaking = true;
+                speakEnd = xTaskGetTickCount() +
+                           pdMS_TO_TICKS((uint32_t) (s_ttsSimFrameLen - TTS_OUTPUT_FRAME_HEADER_LEN - 2) *
+                                         TTS_SIM_SPEAK_BYTE_MS);
+                break;
+            case TTS_OUTPUT_COMMAND_STOP:
+                TtsOutput_ReceiveStatusFromIsr(TTS_OUTPUT_STATUS_RECEIVED);
+                if (isSpeaking) {
+                    isSpeaking = false;
+                    TtsOutput_ReceiveStatusFromIsr(TTS_OUTPUT_STATUS_IDLE);
+                }
+                break;
+            case TTS_OUTPUT_COMMAND_QUERY:
+                status = isSpeaking ? TTS_OUTPUT_STATUS_BUSY : TTS_OUTPUT_STATUS_IDLE;
+                TtsOutput_ReceiveStatusFromIsr(status);
+                break;
+            default:
+                TtsOutput_ReceiveStatusFromIsr(TTS_OUTPUT_STATUS_ERROR);
+                break;
+        }
+    }
+}
+
+#ifndef __CC_ARM
+#pragma GCC diagnostic pop
+#endif
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
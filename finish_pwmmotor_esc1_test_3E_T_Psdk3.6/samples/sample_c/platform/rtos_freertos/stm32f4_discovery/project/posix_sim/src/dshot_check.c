@@ -0,0 +1,247 @@
+/**
+ ********************************************************************
+ * @file    dshot_check.c
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   Host check of DShot encoding, frames and checksum, bit timing of the ESC output timers, burst
+ *          buffer layout of timer DMA and mapping of throttle to DShot values.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "dshot.h"
+
+/* Private constants ---------------------------------------------------------*/
+//TIM8 on APB2 and TIM3 on APB1 of ESC output run at 168 MHz and 84 MHz with system clock of 168 MHz
+#define DSHOT_CHECK_TIM8_CLOCK_HZ       168000000
+#define DSHOT_CHECK_TIM3_CLOCK_HZ       84000000
+#define DSHOT_CHECK_CHANNEL_NUM_MAX     8
+#define DSHOT_CHECK_CANARY              0xDEADBEEF
+#define DSHOT_CHECK_THROTTLE_MAX        2000
+
+/* Private types -------------------------------------------------------------*/
+typedef struct {
+    E_DshotSpeed speed;
+    uint32_t timerClockHz;
+    T_DshotTiming expect;
+} T_DshotCheckTiming;
+
+/* Private values -------------------------------------------------------------*/
+//bit 0 is high for 3/8 and bit 1 for 3/4 of bit period, rounded to nearest count
+static const T_DshotCheckTiming s_checkTiming[] = {
+    {DSHOT_SPEED_150, DSHOT_CHECK_TIM8_CLOCK_HZ, {1120, 420, 840}},
+    {DSHOT_SPEED_300, DSHOT_CHECK_TIM8_CLOCK_HZ, {560, 210, 420}},
+    {DSHOT_SPEED_600, DSHOT_CHECK_TIM8_CLOCK_HZ, {280, 105, 210}},
+    {DSHOT_SPEED_150, DSHOT_CHECK_TIM3_CLOCK_HZ, {560, 210, 420}},
+    {DSHOT_SPEED_300, DSHOT_CHECK_TIM3_CLOCK_HZ, {280, 105, 210}},
+    {DSHOT_SPEED_600, DSHOT_CHECK_TIM3_CLOCK_HZ, {140, 53, 105}},
+};
+static int s_isFail = 0;
+
+/* Private functions declaration ---------------------------------------------*/
+static void DshotCheck_EncodeFrame(void);
+static void DshotCheck_GetTiming(void);
+static void DshotCheck_FillBurstBuffer(uint8_t channelNum);
+static void DshotCheck_ThrottleToValue(void);
+static void DshotCheck_Expect(const char *name, bool isPass, uint32_t value, uint32_t expect);
+
+/* Exported functions definition ---------------------------------------------*/
+int main(void)
+{
+    DshotCheck_EncodeFrame();
+    DshotCheck_GetTiming();
+    DshotCheck_FillBurstBuffer(4);
+    DshotCheck_FillBurstBuffer(8);
+    DshotCheck_ThrottleToValue();
+
+    printf("%s\r\n", s_isFail ? "CHECK FAIL" : "CHECK PASS");
+
+    return s_isFail;
+}
+
+/* Private functions definition-----------------------------------------------*/
+static void DshotCheck_EncodeFrame(void)
+{
+    uint32_t badChecksumNum = 0;
+    uint32_t badValueNum = 0;
+    uint16_t frame;
+    uint16_t value;
+    int telemetryRequest;
+
+    printf("encode frame:\r\n");
+    //reference frame of DShot description, value 1046 without telemetry request
+    DshotCheck_Expect("  1046", Dshot_EncodeFrame(1046, false) == 0x82C6, Dshot_EncodeFrame(1046, false), 0x82C6);
+    DshotCheck_Expect("  1046 telemetry", Dshot_EncodeFrame(1046, true) == 0x82D7, Dshot_EncodeFrame(1046, true),
+                      0x82D7);
+    DshotCheck_Expect("  stop", Dshot_EncodeFrame(0, false) == 0x0000, Dshot_EncodeFrame(0, false), 0x0000);
+    DshotCheck_Expect("  full", Dshot_EncodeFrame(DSHOT_VALUE_MAX, false) == 0xFFEE,
+                      Dshot_EncodeFrame(DSHOT_VALUE_MAX, false), 0xFFEE);
+    //value above 11 bits is masked, not carried into telemetry bit
+    DshotCheck_Expect("  masked", Dshot_EncodeFrame(DSHOT_VALUE_MAX + 1, false) == 0x0000,
+                      Dshot_EncodeFrame(DSHOT_VALUE_MAX + 1, false), 0x0000);
+
+    //nibbles of a frame XOR to 0, and value and telemetry bit come back from the top 12 bits
+    for (value = 0; value <= DSHOT_VALUE_MAX; value++) {
+        for (telemetryRequest = 0; telemetryRequest <= 1; telemetryRequest++) {
+            frame = Dshot_EncodeFrame(value, telemetryRequest != 0);
+            if (((frame ^ (frame >> 4) ^ (frame >> 8) ^ (frame >> 12)) & 0x0F) != 0) {
+                badChecksumNum++;
+            }
+            if ((frame >> 5) != value || ((frame >> 4) & 1) != telemetryRequest) {
+                badValueNum++;
+            }
+        }
+    }
+    DshotCheck_Expect("  frames with bad checksum", badChecksumNum == 0, badChecksumNum, 0);
+    DshotCheck_Expect("  frames with bad value", badValueNum == 0, badValueNum, 0);
+}
+
+static void DshotCheck_GetTiming(void)
+{
+    static const char *const speedName[] = {"150", "300", "600"};
+    const T_DshotCheckTiming *item;
+    T_DshotTiming timing;
+    char name[64];
+    bool isSupported;
+    uint32_t i;
+
+    printf("timing:\r\n");
+    for (i = 0; i < sizeof(s_checkTiming) / sizeof(s_checkTiming[0]); i++) {
+        item = &s_checkTiming[i];
+        memset(&timing, 0, sizeof(timing));
+        isSupported = Dshot_GetTiming(item->speed, item->timerClockHz, &timing);
+        snprintf(name, sizeof(name), "  dshot%s %3u MHz period", speedName[item->speed],
+                 item->timerClockHz / 1000000);
+        DshotCheck_Expect(name, isSupported && timing.bitPeriodCount == item->expect.bitPeriodCount,
+                          timing.bitPeriodCount, item->expect.bitPeriodCount);
+        snprintf(name, sizeof(name), "  dshot%s %3u MHz bit 0 high", speedName[item->speed],
+                 item->timerClockHz / 1000000);
+        DshotCheck_Expect(name, timing.bit0HighCount == item->expect.bit0HighCount, timing.bit0HighCount,
+                          item->expect.bit0HighCount);
+        snprintf(name, sizeof(name), "  dshot%s %3u MHz bit 1 high", speedName[item->speed],
+                 item->timerClockHz / 1000000);
+        DshotCheck_Expect(name, timing.bit1HighCount == item->expect.bit1HighCount, timing.bit1HighCount,
+                          item->expect.bit1HighCount);
+    }
+
+    //bit period under 16 counts can't tell bit 0 and bit 1 apart reliably
+    isSupported = Dshot_GetTiming(DSHOT_SPEED_600, 8000000, &timing);
+    DshotCheck_Expect("  dshot600 8 MHz not supported", !isSupported, isSupported, 0);
+    isSupported = Dshot_GetTiming((E_DshotSpeed) (DSHOT_SPEED_600 + 1), DSHOT_CHECK_TIM8_CLOCK_HZ, &timing);
+    DshotCheck_Expect("  unknown speed not supported", !isSupported, isSupported, 0);
+}
+
+/**
+ * @brief Check burst buffer order, bit by bit with all channels of a bit next to each other, then reset slots.
+ * @param channelNum: count of channels.
+ * @return None.
+ */
+static void DshotCheck_FillBurstBuffer(uint8_t channelNum)
+{
+    static const uint16_t frames[DSHOT_CHECK_CHANNEL_NUM_MAX] = {
+        0x82C6, 0x0000, 0xFFFF, 0xA5A5, 0x8001, 0x5A5A, 0x0F0F, 0xFFEE,
+    };
+    uint32_t buffer[DSHOT_FRAME_SLOT_NUM * DSHOT_CHECK_CHANNEL_NUM_MAX + 1];
+    uint32_t len = DSHOT_FRAME_SLOT_NUM * channelNum;
+    T_DshotTiming timing;
+    uint32_t badSlotNum = 0;
+    uint32_t expect;
+    char name[64];
+    uint32_t bit;
+    uint32_t i;
+
+    printf("burst buffer of %u channels:\r\n", channelNum);
+    Dshot_GetTiming(DSHOT_SPEED_600, DSHOT_CHECK_TIM8_CLOCK_HZ, &timing);
+    for (i = 0; i < sizeof(buffer) / sizeof(buffer[0]); i++) {
+        buffer[i] = DSHOT_CHECK_CANARY;
+    }
+
+    Dshot_FillBurstBuffer(buffer, frames, channelNum, &timing);
+
+    for (i = 0; i < len; i++) {
+        bit = i / channelNum;
+        if (bit >= DSHOT_FRAME_BIT_NUM) {
+            expect = 0;
+        } else {
+            expect = (frames[i % channelNum] >> (DSHOT_FRAME_BIT_NUM - 1 - bit)) & 1 ? timing.bit1HighCount :
+                     timing.bit0HighCount;
+        }
+        if (buffer[i] != expect) {
+            badSlotNum++;
+        }
+    }
+    snprintf(name, sizeof(name), "  slots out of %u wrong", len);
+    DshotCheck_Expect(name, badSlotNum == 0, badSlotNum, 0);
+    DshotCheck_Expect("  first slot of channel 0", buffer[0] == timing.bit1HighCount, buffer[0],
+                      timing.bit1HighCount);
+    DshotCheck_Expect("  first slot of channel 1", buffer[1] == timing.bit0HighCount, buffer[1],
+                      timing.bit0HighCount);
+    DshotCheck_Expect("  reset slots", buffer[DSHOT_FRAME_BIT_NUM * channelNum] == 0 && buffer[len - 1] == 0,
+                      buffer[len - 1], 0);
+    DshotCheck_Expect("  written past end", buffer[len] == DSHOT_CHECK_CANARY, buffer[len] != DSHOT_CHECK_CANARY, 0);
+}
+
+static void DshotCheck_ThrottleToValue(void)
+{
+    uint32_t badOrderNum = 0;
+    uint16_t lastValue = 0;
+    uint16_t value;
+    uint16_t throttle;
+
+    printf("throttle to value:\r\n");
+    DshotCheck_Expect("  0 stops motor", Dshot_ThrottleToValue(0, DSHOT_CHECK_THROTTLE_MAX) == 0,
+                      Dshot_ThrottleToValue(0, DSHOT_CHECK_THROTTLE_MAX), 0);
+    DshotCheck_Expect("  1 is lowest throttle", Dshot_ThrottleToValue(1, DSHOT_CHECK_THROTTLE_MAX) ==
+                      DSHOT_THROTTLE_VALUE_MIN, Dshot_ThrottleToValue(1, DSHOT_CHECK_THROTTLE_MAX),
+                      DSHOT_THROTTLE_VALUE_MIN);
+    DshotCheck_Expect("  half", Dshot_ThrottleToValue(1000, DSHOT_CHECK_THROTTLE_MAX) == 1047,
+                      Dshot_ThrottleToValue(1000, DSHOT_CHECK_THROTTLE_MAX), 1047);
+    DshotCheck_Expect("  max is full throttle", Dshot_ThrottleToValue(DSHOT_CHECK_THROTTLE_MAX,
+                      DSHOT_CHECK_THROTTLE_MAX) == DSHOT_VALUE_MAX,
+                      Dshot_ThrottleToValue(DSHOT_CHECK_THROTTLE_MAX, DSHOT_CHECK_THROTTLE_MAX), DSHOT_VALUE_MAX);
+    DshotCheck_Expect("  above max is full throttle", Dshot_ThrottleToValue(UINT16_MAX, DSHOT_CHECK_THROTTLE_MAX) ==
+                      DSHOT_VALUE_MAX, Dshot_ThrottleToValue(UINT16_MAX, DSHOT_CHECK_THROTTLE_MAX), DSHOT_VALUE_MAX);
+    DshotCheck_Expect("  max of 0 stops motor", Dshot_ThrottleToValue(100, 0) == 0, Dshot_ThrottleToValue(100, 0),
+                      0);
+
+    //throttle never maps to a command value and never goes down as throttle goes up
+    for (throttle = 1; throttle <= DSHOT_CHECK_THROTTLE_MAX; throttle++) {
+        value = Dshot_ThrottleToValue(throttle, DSHOT_CHECK_THROTTLE_MAX);
+        if (value < DSHOT_THROTTLE_VALUE_MIN || value > DSHOT_VALUE_MAX || value < lastValue) {
+            badOrderNum++;
+        }
+        lastValue = value;
+    }
+    DshotCheck_Expect("  values out of range or order", badOrderNum == 0, badOrderNum, 0);
+}
+
+static void DshotCheck_Expect(const char *name, bool isPass, uint32_t value, uint32_t expect)
+{
+    printf("%-36s %8u, expect %8u%s\r\n", name, value, expect, isPass ? "" : "  FAIL");
+    if (!isPass) {
+        s_isFail = 1;
+    }
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
@@ -0,0 +1,433 @@
+/**
+ ********************************************************************
+ * @file    esc_arming_check.c
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   Host check of the ESC arming state machine, calibration and arming sequences, hold times, link
+ *          timeout to fault in every output state, failsafe output, recovery and time wrap-around.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "esc_arming.h"
+
+/* Private constants ---------------------------------------------------------*/
+//same timing as application.c, state machine is processed every motor task turn
+#define ESC_ARMING_CHECK_MAX_THROTTLE_HOLD_MS       5000
+#define ESC_ARMING_CHECK_CALIBRATION_MIN_HOLD_MS    5000
+#define ESC_ARMING_CHECK_MIN_THROTTLE_HOLD_MS       3000
+#define ESC_ARMING_CHECK_LINK_LOST_TIMEOUT_MS       1000
+#define ESC_ARMING_CHECK_STEP_MS                    20
+#define ESC_ARMING_CHECK_THROTTLE_MAX               2000
+#define ESC_ARMING_CHECK_THROTTLE                   800
+//far beyond any hold time, a state that lasts this long is reported as stuck
+#define ESC_ARMING_CHECK_WAIT_MS_MAX                60000
+
+/* Private types -------------------------------------------------------------*/
+typedef struct {
+    T_EscArming arming;
+    uint32_t nowMs;
+    bool isLinkAlive;
+    const char *caseName;
+    int isFail;
+} T_EscArmingCheckRun;
+
+typedef struct {
+    const char *name;
+    void (*func)(T_EscArmingCheckRun *run);
+} T_EscArmingCheckCase;
+
+/* Private values -------------------------------------------------------------*/
+static const T_EscArmingConfig s_checkConfig = {
+    .maxThrottleHoldMs = ESC_ARMING_CHECK_MAX_THROTTLE_HOLD_MS,
+    .calibrationMinThrottleHoldMs = ESC_ARMING_CHECK_CALIBRATION_MIN_HOLD_MS,
+    .armMinThrottleHoldMs = ESC_ARMING_CHECK_MIN_THROTTLE_HOLD_MS,
+    .linkLostTimeoutMs = ESC_ARMING_CHECK_LINK_LOST_TIMEOUT_MS,
+};
+
+/* Private functions declaration ---------------------------------------------*/
+static void EscArmingCheck_CalibrateThenArm(T_EscArmingCheckRun *run);
+static void EscArmingCheck_RejectRequest(T_EscArmingCheckRun *run);
+static void EscArmingCheck_TimeoutToFault(T_EscArmingCheckRun *run);
+static void EscArmingCheck_LinkLostFailsafe(T_EscArmingCheckRun *run);
+static void EscArmingCheck_Recover(T_EscArmingCheckRun *run);
+static void EscArmingCheck_RecoverFromSwitch(T_EscArmingCheckRun *run);
+static void EscArmingCheck_Disarm(T_EscArmingCheckRun *run);
+static void EscArmingCheck_TimeWrapAround(T_EscArmingCheckRun *run);
+static void EscArmingCheck_Start(T_EscArmingCheckRun *run, uint32_t startMs);
+static void EscArmingCheck_Advance(T_EscArmingCheckRun *run, uint32_t ms);
+static uint32_t EscArmingCheck_WaitLeave(T_EscArmingCheckRun *run, E_EscArmingState state);
+static void EscArmingCheck_Expect(T_EscArmingCheckRun *run, E_EscArmingState state, uint16_t expectOutput,
+                                  const char *step);
+static void EscArmingCheck_Switch(T_EscArmingCheckRun *run, bool isOn);
+static void EscArmingCheck_ExpectTrue(T_EscArmingCheckRun *run, bool isTrue, const char *step);
+static void EscArmingCheck_ExpectHold(T_EscArmingCheckRun *run, uint32_t holdMs, uint32_t expectMs, const char *step);
+
+/* Exported functions definition ---------------------------------------------*/
+int main(void)
+{
+    static const T_EscArmingCheckCase checkCase[] = {
+        {"calibrate then arm", EscArmingCheck_CalibrateThenArm},
+        {"reject request", EscArmingCheck_RejectRequest},
+        {"link timeout to fault", EscArmingCheck_TimeoutToFault},
+        {"link lost failsafe", EscArmingCheck_LinkLostFailsafe},
+        {"recover from fault", EscArmingCheck_Recover},
+        {"recover from fault by switch", EscArmingCheck_RecoverFromSwitch},
+        {"disarm", EscArmingCheck_Disarm},
+        {"time wrap-around", EscArmingCheck_TimeWrapAround},
+    };
+    T_EscArmingCheckRun run;
+    int isFail = 0;
+    uint32_t i;
+
+    for (i = 0; i < sizeof(checkCase) / sizeof(checkCase[0]); i++) {
+        run.caseName = checkCase[i].name;
+        run.isFail = 0;
+        checkCase[i].func(&run);
+        printf("%-30s %s\r\n", checkCase[i].name, run.isFail ? "FAIL" : "ok");
+        isFail |= run.isFail;
+    }
+
+    if (EscArming_GetStateName((E_EscArmingState) (ESC_ARMING_STATE_FAULT + 1))[0] != 'u') {
+        printf("name of state out of range is not unknown\r\n");
+        isFail = 1;
+    }
+
+    printf("%s\r\n", isFail ? "CHECK FAIL" : "CHECK PASS");
+
+    return isFail;
+}
+
+/* Private functions definition-----------------------------------------------*/
+/**
+ * @brief Calibration runs idle, max throttle, min throttle and back to idle, arming then runs min throttle and armed.
+ */
+static void EscArmingCheck_CalibrateThenArm(T_EscArmingCheckRun *run)
+{
+    EscArmingCheck_Start(run, 1000);
+    EscArmingCheck_Expect(run, ESC_ARMING_STATE_IDLE, 0, "after init");
+
+    EscArmingCheck_ExpectTrue(run, EscArming_RequestCalibration(&run->arming, run->nowMs), "calibration request");
+    EscArmingCheck_Expect(run, ESC_ARMING_STATE_MAX_THROTTLE, ESC_ARMING_CHECK_THROTTLE_MAX, "calibration start");
+    EscArmingCheck_ExpectHold(run, EscArmingCheck_WaitLeave(run, ESC_ARMING_STATE_MAX_THROTTLE),
+                              ESC_ARMING_CHECK_MAX_THROTTLE_HOLD_MS, "max throttle");
+    EscArmingCheck_Expect(run, ESC_ARMING_STATE_MIN_THROTTLE, 0, "calibration bottom");
+    EscArmingCheck_ExpectHold(run, EscArmingCheck_WaitLeave(run, ESC_ARMING_STATE_MIN_THROTTLE),
+                              ESC_ARMING_CHECK_CALIBRATION_MIN_HOLD_MS, "calibration min throttle");
+    EscArmingCheck_Expect(run, ESC_ARMING_STATE_IDLE, 0, "calibration done");
+
+    EscArmingCheck_ExpectTrue(run, EscArming_RequestArm(&run->arming, 0, run->nowMs), "arm request");
+    EscArmingCheck_Expect(run, ESC_ARMING_STATE_MIN_THROTTLE, 0, "arm start");
+    EscArmingCheck_ExpectHold(run, EscArmingCheck_WaitLeave(run, ESC_ARMING_STATE_MIN_THROTTLE),
+                              ESC_ARMING_CHECK_MIN_THROTTLE_HOLD_MS, "arm min throttle");
+    EscArmingCheck_Expect(run, ESC_ARMING_STATE_ARMED, ESC_ARMING_CHECK_THROTTLE, "armed");
+
+    //armed output is limited to full throttle
+    EscArmingCheck_ExpectTrue(run, EscArming_GetOutputThrottle(&run->arming, ESC_ARMING_CHECK_THROTTLE_MAX + 1,
+                                                               ESC_ARMING_CHECK_THROTTLE_MAX) ==
+                                   ESC_ARMING_CHECK_THROTTLE_MAX, "armed output above full throttle");
+
+    //armed stays armed while link is alive
+    EscArmingCheck_Advance(run, 10 * ESC_ARMING_CHECK_LINK_LOST_TIMEOUT_MS);
+    EscArmingCheck_Expect(run, ESC_ARMING_STATE_ARMED, ESC_ARMING_CHECK_THROTTLE, "armed with link");
+}
+
+/**
+ * @brief Requests out of idle, with throttle up or without link are rejected and leave state as it is.
+ */
+static void EscArmingCheck_RejectRequest(T_EscArmingCheckRun *run)
+{
+    //link is regarded lost until first fed
+    run->nowMs = 1000;
+    run->isLinkAlive = false;
+    EscArming_Init(&run->arming, &s_checkConfig, run->nowMs);
+    EscArmingCheck_ExpectTrue(run, !EscArming_RequestArm(&run->arming, 0, run->nowMs), "arm before link");
+    EscArmingCheck_ExpectTrue(run, !EscArming_RequestCalibration(&run->arming, run->nowMs),
+                              "calibration before link");
+    EscArmingCheck_Expect(run, ESC_ARMING_STATE_IDLE, 0, "rejected before link");
+
+    run->isLinkAlive = true;
+    EscArmingCheck_Advance(run, ESC_ARMING_CHECK_STEP_MS);
+    EscArmingCheck_ExpectTrue(run, !EscArming_RequestArm(&run->arming, 1, run->nowMs), "arm with throttle up");
+    EscArmingCheck_Expect(run, ESC_ARMING_STATE_IDLE, 0, "rejected with throttle up");
+
+    EscArmingCheck_ExpectTrue(run, EscArming_RequestCalibration(&run->arming, run->nowMs), "calibration request");
+    EscArmingCheck_ExpectTrue(run, !EscArming_RequestArm(&run->arming, 0, run->nowMs), "arm in calibration");
+    EscArmingCheck_ExpectTrue(run, !EscArming_RequestCalibration(&run->arming, run->nowMs),
+                              "calibration in calibration");
+    EscArmingCheck_Expect(run, ESC_ARMING_STATE_MAX_THROTTLE, ESC_ARMING_CHECK_THROTTLE_MAX,
+                          "rejected in calibration");
+
+    EscArming_RequestDisarm(&run->arming, run->nowMs);
+    EscArmingCheck_ExpectTrue(run, EscArming_RequestArm(&run->arming, 0, run->nowMs), "arm request");
+    EscArmingCheck_WaitLeave(run, ESC_ARMING_STATE_MIN_THROTTLE);
+    EscArmingCheck_ExpectTrue(run, !EscArming_RequestCalibration(&run->arming, run->nowMs), "calibration armed");
+    EscArmingCheck_ExpectTrue(run, !EscArming_RequestArm(&run->arming, 0, run->nowMs), "arm armed");
+    EscArmingCheck_Expect(run, ESC_ARMING_STATE_ARMED, ESC_ARMING_CHECK_THROTTLE, "rejected armed");
+}
+
+/**
+ * @brief Link lost in max throttle and in min throttle goes to fault after timeout, and output stops at once.
+ */
+static void EscArmingCheck_TimeoutToFault(T_EscArmingCheckRun *run)
+{
+    static const E_EscArmingState outputState[] = {ESC_ARMING_STATE_MAX_THROTTLE, ESC_ARMING_STATE_MIN_THROTTLE};
+    uint32_t i;
+
+    for (i = 0; i < sizeof(outputState) / sizeof(outputState[0]); i++) {
+        EscArmingCheck_Start(run, 1000);
+        if (outputState[i] == ESC_ARMING_STATE_MAX_THROTTLE) {
+            EscArming_RequestCalibration(&run->arming, run->nowMs);
+        } else {
+            EscArming_RequestArm(&run->arming, 0, run->nowMs);
+        }
+        EscArmingCheck_Advance(run, ESC_ARMING_CHECK_STEP_MS);
+
+        run->isLinkAlive = false;
+        EscArmingCheck_ExpectHold(run, EscArmingCheck_WaitLeave(run, outputState[i]),
+                                  ESC_ARMING_CHECK_LINK_LOST_TIMEOUT_MS, EscArming_GetStateName(outputState[i]));
+        EscArmingCheck_Expect(run, ESC_ARMING_STATE_FAULT, 0, EscArming_GetStateName(outputState[i]));
+    }
+}
+
+/**
+ * @brief Armed motor keeps throttle while link is within timeout, then fault stops it and holds it stopped.
+ */
+static void EscArmingCheck_LinkLostFailsafe(T_EscArmingCheckRun *run)
+{
+    EscArmingCheck_Start(run, 1000);
+    EscArming_RequestArm(&run->arming, 0, run->nowMs);
+    EscArmingCheck_WaitLeave(run, ESC_ARMING_STATE_MIN_THROTTLE);
+    EscArmingCheck_Expect(run, ESC_ARMING_STATE_ARMED, ESC_ARMING_CHECK_THROTTLE, "armed");
+
+    run->isLinkAlive = false;
+    EscArmingCheck_Advance(run, ESC_ARMING_CHECK_LINK_LOST_TIMEOUT_MS - ESC_ARMING_CHECK_STEP_MS);
+    EscArmingCheck_Expect(run, ESC_ARMING_STATE_ARMED, ESC_ARMING_CHECK_THROTTLE, "within link timeout");
+    EscArmingCheck_Advance(run, ESC_ARMING_CHECK_STEP_MS);
+    EscArmingCheck_Expect(run, ESC_ARMING_STATE_FAULT, 0, "at link timeout");
+
+    EscArmingCheck_ExpectTrue(run, !EscArming_RequestArm(&run->arming, 0, run->nowMs), "arm in fault");
+    EscArmingCheck_ExpectTrue(run, !EscArming_RequestCalibration(&run->arming, run->nowMs), "calibration in fault");
+    EscArmingCheck_Advance(run, ESC_ARMING_CHECK_WAIT_MS_MAX);
+    EscArmingCheck_Expect(run, ESC_ARMING_STATE_FAULT, 0, "fault held");
+}
+
+/**
+ * @brief Fault is only left by disarm with link alive again, then arming works as from start.
+ */
+static void EscArmingCheck_Recover(T_EscArmingCheckRun *run)
+{
+    EscArmingCheck_Start(run, 1000);
+    EscArming_RequestArm(&run->arming, 0, run->nowMs);
+    EscArmingCheck_WaitLeave(run, ESC_ARMING_STATE_MIN_THROTTLE);
+    run->isLinkAlive = false;
+    EscArmingCheck_WaitLeave(run, ESC_ARMING_STATE_ARMED);
+    EscArmingCheck_Expect(run, ESC_ARMING_STATE_FAULT, 0, "failsafe");
+
+    EscArming_RequestDisarm(&run->arming, run->nowMs);
+    EscArmingCheck_Expect(run, ESC_ARMING_STATE_FAULT, 0, "disarm without link");
+
+    //link coming back alone does not restart motor
+    run->isLinkAlive = true;
+    EscArmingCheck_Advance(run, 10 * ESC_ARMING_CHECK_STEP_MS);
+    EscArmingCheck_Expect(run, ESC_ARMING_STATE_FAULT, 0, "link back");
+
+    EscArming_RequestDisarm(&run->arming, run->nowMs);
+    EscArmingCheck_Advance(run, ESC_ARMING_CHECK_STEP_MS);
+    EscArmingCheck_Expect(run, ESC_ARMING_STATE_IDLE, 0, "disarm with link");
+
+    EscArmingCheck_ExpectTrue(run, EscArming_RequestArm(&run->arming, 0, run->nowMs), "arm after recovery");
+    EscArmingCheck_ExpectHold(run, EscArmingCheck_WaitLeave(run, ESC_ARMING_STATE_MIN_THROTTLE),
+                              ESC_ARMING_CHECK_MIN_THROTTLE_HOLD_MS, "arm min throttle after recovery");
+    EscArmingCheck_Expect(run, ESC_ARMING_STATE_ARMED, ESC_ARMING_CHECK_THROTTLE, "armed after recovery");
+}
+
+/**
+ * @brief Arm switch of app shows on in fault, so its off edge clears the fault once link is alive, and its on edge
+ * arms again. Switch position is synced from state after every request, as application.c does.
+ */
+static void EscArmingCheck_RecoverFromSwitch(T_EscArmingCheckRun *run)
+{
+    EscArmingCheck_Start(run, 1000);
+    EscArmingCheck_ExpectTrue(run, !EscArming_IsSwitchOn(&run->arming), "switch off in idle");
+    EscArmingCheck_Switch(run, true);
+    EscArmingCheck_ExpectTrue(run, EscArming_IsSwitchOn(&run->arming), "switch on while arming");
+    EscArmingCheck_WaitLeave(run, ESC_ARMING_STATE_MIN_THROTTLE);
+    run->isLinkAlive = false;
+    EscArmingCheck_WaitLeave(run, ESC_ARMING_STATE_ARMED);
+    EscArmingCheck_Expect(run, ESC_ARMING_STATE_FAULT, 0, "failsafe");
+    EscArmingCheck_ExpectTrue(run, EscArming_IsSwitchOn(&run->arming), "switch on in fault");
+
+    EscArmingCheck_Switch(run, false);
+    EscArmingCheck_Expect(run, ESC_ARMING_STATE_FAULT, 0, "switch off without link");
+    EscArmingCheck_ExpectTrue(run, EscArming_IsSwitchOn(&run->arming), "switch back on without link");
+
+    run->isLinkAlive = true;
+    EscArmingCheck_Advance(run, ESC_ARMING_CHECK_STEP_MS);
+    EscArmingCheck_Switch(run, false);
+    EscArmingCheck_Expect(run, ESC_ARMING_STATE_IDLE, 0, "switch off with link");
+    EscArmingCheck_ExpectTrue(run, !EscArming_IsSwitchOn(&run->arming), "switch off after recovery");
+
+    EscArmingCheck_Switch(run, true);
+    EscArmingCheck_ExpectTrue(run, EscArming_IsSwitchOn(&run->arming), "switch on after recovery");
+    EscArmingCheck_ExpectHold(run, EscArmingCheck_WaitLeave(run, ESC_ARMING_STATE_MIN_THROTTLE),
+                              ESC_ARMING_CHECK_MIN_THROTTLE_HOLD_MS - ESC_ARMING_CHECK_STEP_MS,
+                              "arm min throttle by switch");
+    EscArmingCheck_Expect(run, ESC_ARMING_STATE_ARMED, ESC_ARMING_CHECK_THROTTLE, "armed by switch");
+    EscArmingCheck_ExpectTrue(run, EscArming_IsSwitchOn(&run->arming), "switch on when armed");
+}
+
+/**
+ * @brief Disarm stops output from every state with link alive.
+ */
+static void EscArmingCheck_Disarm(T_EscArmingCheckRun *run)
+{
+    EscArmingCheck_Start(run, 1000);
+    EscArming_RequestArm(&run->arming, 0, run->nowMs);
+    EscArmingCheck_WaitLeave(run, ESC_ARMING_STATE_MIN_THROTTLE);
+    EscArming_RequestDisarm(&run->arming, run->nowMs);
+    EscArmingCheck_Expect(run, ESC_ARMING_STATE_IDLE, 0, "disarm armed");
+
+    EscArming_RequestArm(&run->arming, 0, run->nowMs);
+    EscArmingCheck_Advance(run, ESC_ARMING_CHECK_STEP_MS);
+    EscArming_RequestDisarm(&run->arming, run->nowMs);
+    EscArmingCheck_Expect(run, ESC_ARMING_STATE_IDLE, 0, "disarm while arming");
+
+    EscArming_RequestCalibration(&run->arming, run->nowMs);
+    EscArmingCheck_Advance(run, ESC_ARMING_CHECK_STEP_MS);
+    EscArming_RequestDisarm(&run->arming, run->nowMs);
+    EscArmingCheck_Expect(run, ESC_ARMING_STATE_IDLE, 0, "disarm in calibration");
+
+    //calibration flag is cleared, so next arming holds arm time and ends armed
+    EscArming_RequestArm(&run->arming, 0, run->nowMs);
+    EscArmingCheck_ExpectHold(run, EscArmingCheck_WaitLeave(run, ESC_ARMING_STATE_MIN_THROTTLE),
+                              ESC_ARMING_CHECK_MIN_THROTTLE_HOLD_MS, "arm after calibration disarm");
+    EscArmingCheck_Expect(run, ESC_ARMING_STATE_ARMED, ESC_ARMING_CHECK_THROTTLE, "armed after calibration disarm");
+}
+
+/**
+ * @brief Millisecond time wraps every 49.7 days, hold times and link timeout are counted across it.
+ */
+static void EscArmingCheck_TimeWrapAround(T_EscArmingCheckRun *run)
+{
+    EscArmingCheck_Start(run, UINT32_MAX - ESC_ARMING_CHECK_MIN_THROTTLE_HOLD_MS / 2);
+    EscArming_RequestArm(&run->arming, 0, run->nowMs);
+    EscArmingCheck_ExpectHold(run, EscArmingCheck_WaitLeave(run, ESC_ARMING_STATE_MIN_THROTTLE),
+                              ESC_ARMING_CHECK_MIN_THROTTLE_HOLD_MS, "arm min throttle across wrap");
+    EscArmingCheck_Expect(run, ESC_ARMING_STATE_ARMED, ESC_ARMING_CHECK_THROTTLE, "armed across wrap");
+
+    EscArmingCheck_Start(run, UINT32_MAX - ESC_ARMING_CHECK_MIN_THROTTLE_HOLD_MS - ESC_ARMING_CHECK_STEP_MS -
+                              ESC_ARMING_CHECK_LINK_LOST_TIMEOUT_MS / 2);
+    EscArming_RequestArm(&run->arming, 0, run->nowMs);
+    EscArmingCheck_WaitLeave(run, ESC_ARMING_STATE_MIN_THROTTLE);
+    run->isLinkAlive = false;
+    EscArmingCheck_ExpectHold(run, EscArmingCheck_WaitLeave(run, ESC_ARMING_STATE_ARMED),
+                              ESC_ARMING_CHECK_LINK_LOST_TIMEOUT_MS, "link timeout across wrap");
+    EscArmingCheck_Expect(run, ESC_ARMING_STATE_FAULT, 0, "failsafe across wrap");
+}
+
+static void EscArmingCheck_Start(T_EscArmingCheckRun *run, uint32_t startMs)
+{
+    run->nowMs = startMs;
+    run->isLinkAlive = true;
+    EscArming_Init(&run->arming, &s_checkConfig, run->nowMs);
+    EscArming_FeedLink(&run->arming, run->nowMs);
+}
+
+/**
+ * @brief Advance time by motor task turns, feeding link at every turn while it is alive, as application.c does.
+ */
+static void EscArmingCheck_Advance(T_EscArmingCheckRun *run, uint32_t ms)
+{
+    uint32_t i;
+
+    for (i = 0; i < ms; i += ESC_ARMING_CHECK_STEP_MS) {
+        run->nowMs += ESC_ARMING_CHECK_STEP_MS;
+        if (run->isLinkAlive) {
+            EscArming_FeedLink(&run->arming, run->nowMs);
+        }
+        EscArming_Process(&run->arming, run->nowMs);
+    }
+}
+
+/**
+ * @brief Advance time until state is left.
+ * @return Time the state lasted from now, unit: ms, ESC_ARMING_CHECK_WAIT_MS_MAX if it is never left.
+ */
+static uint32_t EscArmingCheck_WaitLeave(T_EscArmingCheckRun *run, E_EscArmingState state)
+{
+    uint32_t ms;
+
+    for (ms = 0; ms < ESC_ARMING_CHECK_WAIT_MS_MAX && run->arming.state == state; ms += ESC_ARMING_CHECK_STEP_MS) {
+        EscArmingCheck_Advance(run, ESC_ARMING_CHECK_STEP_MS);
+    }
+
+    return ms;
+}
+
+static void EscArmingCheck_Expect(T_EscArmingCheckRun *run, E_EscArmingState state, uint16_t expectOutput,
+                                  const char *step)
+{
+    uint16_t output = EscArming_GetOutputThrottle(&run->arming, ESC_ARMING_CHECK_THROTTLE,
+                                                  ESC_ARMING_CHECK_THROTTLE_MAX);
+
+    if (run->arming.state != state || output != expectOutput) {
+        printf("  %s: %s: state %s, output %u, expect %s, output %u\r\n", run->caseName, step,
+               EscArming_GetStateName(run->arming.state), output, EscArming_GetStateName(state), expectOutput);
+        run->isFail = 1;
+    }
+}
+
+/**
+ * @brief Turn arm switch of app and run one motor task turn, on edge requests arm at zero throttle and off edge
+ * requests disarm, as application.c does.
+ */
+static void EscArmingCheck_Switch(T_EscArmingCheckRun *run, bool isOn)
+{
+    if (isOn) {
+        EscArming_RequestArm(&run->arming, 0, run->nowMs);
+    } else {
+        EscArming_RequestDisarm(&run->arming, run->nowMs);
+    }
+    EscArmingCheck_Advance(run, ESC_ARMING_CHECK_STEP_MS);
+}
+
+static void EscArmingCheck_ExpectTrue(T_EscArmingCheckRun *run, bool isTrue, const char *step)
+{
+    if (!isTrue) {
+        printf("  %s: %s: unexpected result in state %s\r\n", run->caseName, step,
+               EscArming_GetStateName(run->arming.state));
+        run->isFail = 1;
+    }
+}
+
+static void EscArmingCheck_ExpectHold(T_EscArmingCheckRun *run, uint32_t holdMs, uint32_t expectMs, const char *step)
+{
+    if (holdMs != expectMs) {
+        printf("  %s: %s: held %u ms, expect %u ms\r\n", run->caseName, step, holdMs, expectMs);
+        run->isFail = 1;
+    }
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
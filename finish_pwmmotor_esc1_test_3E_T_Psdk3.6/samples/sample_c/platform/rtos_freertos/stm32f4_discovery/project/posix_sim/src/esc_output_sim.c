@@ -0,0 +1,227 @@
+/**
+ ********************************************************************
+ * @file    esc_output_sim.c
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   ESC output of host simulator build, replaces esc_output.c. Frames are encoded
+ *          into the same burst buffers as on target but not sent, so frame content and CPU cost can be checked.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <time.h>
+#include "esc_output.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Private constants ---------------------------------------------------------*/
+//timer clock of TIM8 on target
+#define ESC_OUTPUT_SIM_TIMER_CLOCK_HZ       168000000
+#define ESC_OUTPUT_SIM_GROUP_NUM            ((ESC_OUTPUT_CHANNEL_MAX_NUM + ESC_OUTPUT_GROUP_CHANNEL_NUM - 1) / \
+                                             ESC_OUTPUT_GROUP_CHANNEL_NUM)
+#define ESC_OUTPUT_SIM_BURST_BUFFER_LEN     (DSHOT_FRAME_SLOT_NUM * ESC_OUTPUT_GROUP_CHANNEL_NUM)
+
+/* Private types -------------------------------------------------------------*/
+typedef struct {
+    T_ThrottleRamp ramp;
+    uint8_t command;
+    uint8_t commandRepeatNum;
+    uint16_t pwmPulseUs; /*!< Pulse width output in PWM mode. */
+} T_EscOutputSimChannel;
+
+/* Private values -------------------------------------------------------------*/
+static bool s_isEscOutputInit = false;
+static E_EscOutputMode s_escOutputMode;
+static uint8_t s_escOutputChannelNum;
+static T_DshotTiming s_escOutputDshotTiming;
+static T_EscOutputSimChannel s_escOutputChannel[ESC_OUTPUT_CHANNEL_MAX_NUM];
+static uint32_t s_escOutputBurstBuffer[ESC_OUTPUT_SIM_GROUP_NUM][ESC_OUTPUT_SIM_BURST_BUFFER_LEN];
+static T_EscOutputUpdateState s_escOutputUpdateState = {0};
+
+/* Private functions declaration ---------------------------------------------*/
+static uint64_t EscOutput_GetMonotonicNs(void);
+
+/* Exported functions definition ---------------------------------------------*/
+T_DjiReturnCode EscOutput_Init(const T_EscOutputConfig *config)
+{
+    uint8_t i;
+
+    if (s_isEscOutputInit) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NONSUPPORT_IN_CURRENT_STATE;
+    }
+
+    if (config->channelNum == 0 || config->channelNum > ESC_OUTPUT_CHANNEL_MAX_NUM ||
+        config->mode > ESC_OUTPUT_MODE_DSHOT600) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    if (config->mode != ESC_OUTPUT_MODE_PWM &&
+        !Dshot_GetTiming((E_DshotSpeed) (config->mode - ESC_OUTPUT_MODE_DSHOT150), ESC_OUTPUT_SIM_TIMER_CLOCK_HZ,
+                         &s_escOutputDshotTiming)) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NONSUPPORT;
+    }
+
+    s_escOutputMode = config->mode;
+    s_escOutputChannelNum = config->channelNum;
+    for (i = 0; i < config->channelNum; i++) {
+        ThrottleRamp_Init(&s_escOutputChannel[i].ramp, &config->rampConfig, 0);
+        s_escOutputChannel[i].commandRepeatNum = 0;
+        s_escOutputChannel[i].pwmPulseUs = ESC_OUTPUT_PWM_PULSE_MIN_US;
+    }
+
+    s_isEscOutputInit = true;
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+T_DjiReturnCode EscOutput_SetThrottle(uint8_t channel, uint16_t throttle)
+{
+    if (!s_isEscOutputInit) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NONSUPPORT_IN_CURRENT_STATE;
+    }
+
+    if (channel >= s_escOutputChannelNum || throttle > ESC_OUTPUT_THROTTLE_MAX) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    ThrottleRamp_SetTarget(&s_escOutputChannel[channel].ramp, throttle);
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+T_DjiReturnCode EscOutput_JumpThrottle(uint8_t channel, uint16_t throttle)
+{
+    if (!s_isEscOutputInit) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NONSUPPORT_IN_CURRENT_STATE;
+    }
+
+    if (channel >= s_escOutputChannelNum || throttle > ESC_OUTPUT_THROTTLE_MAX) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    ThrottleRamp_Jump(&s_escOutputChannel[channel].ramp, throttle);
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+T_DjiReturnCode EscOutput_SendCommand(uint8_t channel, E_DshotCommand command, uint8_t repeatNum)
+{
+    if (!s_isEscOutputInit || s_escOutputMode == ESC_OUTPUT_MODE_PWM) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NONSUPPORT_IN_CURRENT_STATE;
+    }
+
+    if (channel >= s_escOutputChannelNum || command > DSHOT_COMMAND_MAX || repeatNum == 0) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    taskENTER_CRITICAL();
+    s_escOutputChannel[channel].command = (uint8_t) command;
+    s_escOutputChannel[channel].commandRepeatNum = repeatNum;
+    taskEXIT_CRITICAL();
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+T_DjiReturnCode EscOutput_Update(void)
+{
+    uint64_t startNs = EscOutput_GetMonotonicNs();
+    uint16_t frames[ESC_OUTPUT_SIM_GROUP_NUM * ESC_OUTPUT_GROUP_CHANNEL_NUM] = {0};
+    T_EscOutputSimChannel *escChannel;
+    uint32_t costNs;
+    uint16_t throttle;
+    uint8_t i;
+
+    if (!s_isEscOutputInit) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NONSUPPORT_IN_CURRENT_STATE;
+    }
+
+    for (i = 0; i < s_escOutputChannelNum; i++) {
+        escChannel = &s_escOutputChannel[i];
+        throttle = ThrottleRamp_Update(&escChannel->ramp);
+
+        if (s_escOutputMode == ESC_OUTPUT_MODE_PWM) {
+            escChannel->pwmPulseUs = (uint16_t) (ESC_OUTPUT_PWM_PULSE_MIN_US + (uint32_t) throttle *
+                                                 (ESC_OUTPUT_PWM_PULSE_MAX_US - ESC_OUTPUT_PWM_PULSE_MIN_US) /
+                                                 ESC_OUTPUT_THROTTLE_MAX);
+            continue;
+        }
+
+        taskENTER_CRITICAL();
+        if (escChannel->commandRepeatNum != 0) {
+            escChannel->commandRepeatNum--;
+            frames[i] = Dshot_EncodeFrame(escChannel->command, true);
+        } else {
+            frames[i] = Dshot_EncodeFrame(Dshot_ThrottleToValue(throttle, ESC_OUTPUT_THROTTLE_MAX), false);
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    if (s_escOutputMode != ESC_OUTPUT_MODE_PWM) {
+        for (i = 0; i * ESC_OUTPUT_GROUP_CHANNEL_NUM < s_escOutputChannelNum; i++) {
+            Dshot_FillBurstBuffer(s_escOutputBurstBuffer[i], &frames[i * ESC_OUTPUT_GROUP_CHANNEL_NUM],
+                                  ESC_OUTPUT_GROUP_CHANNEL_NUM, &s_escOutputDshotTiming);
+        }
+    }
+
+    costNs = (uint32_t) (EscOutput_GetMonotonicNs() - startNs);
+    taskENTER_CRITICAL();
+    s_escOutputUpdateState.countOfUpdate++;
+    s_escOutputUpdateState.sumOfCostNs += costNs;
+    if (costNs > s_escOutputUpdateState.maxCostNs) {
+        s_escOutputUpdateState.maxCostNs = costNs;
+    }
+    taskEXIT_CRITICAL();
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+bool EscOutput_IsSettled(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < s_escOutputChannelNum; i++) {
+        if (!ThrottleRamp_IsSettled(&s_escOutputChannel[i].ramp)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void EscOutput_GetUpdateState(T_EscOutputUpdateState *state)
+{
+    taskENTER_CRITICAL();
+    *state = s_escOutputUpdateState;
+    taskEXIT_CRITICAL();
+
+    state->averageCostNs = state->countOfUpdate != 0 ? (uint32_t) (state->sumOfCostNs / state->countOfUpdate) : 0;
+}
+
+/* Private functions definition-----------------------------------------------*/
+static uint64_t EscOutput_GetMonotonicNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
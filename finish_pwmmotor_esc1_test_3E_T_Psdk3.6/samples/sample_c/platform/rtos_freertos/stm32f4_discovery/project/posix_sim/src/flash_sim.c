@@ -0,0 +1,230 @@
+/**
+ ********************************************************************
+ * @file    flash_sim.c
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   Flash interface and upgrade platform of host simulator build. Internal flash is a memory
+ *          array covering ADDR_FLASH_SECTOR_0 to FLASH_END_ADDRESS, erased state is 0xFF.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include <stdlib.h>
+#include "flash_if.h"
+#include "upgrade_platform_opt_stm32.h"
+#include "dji_logger.h"
+
+/* Private constants ---------------------------------------------------------*/
+#define FLASH_SIM_SIZE                              (FLASH_END_ADDRESS - ADDR_FLASH_SECTOR_0 + 1)
+#define DJI_TEST_UPGRADE_FILE_INFO_STORE_ADDR       (APPLICATION_STORE_ADDRESS_END - 1023)
+#define DJI_TEST_UPGRADE_REBOOT_KEY                 0x11223344
+
+/* Private macros ------------------------------------------------------------*/
+#define FLASH_SIM_PTR(addr)                         (&s_flashSim[(addr) - ADDR_FLASH_SECTOR_0])
+
+/* Private types -------------------------------------------------------------*/
+typedef struct {
+    uint32_t upgradeRebootKey;
+    T_DjiUpgradeEndInfo upgradeEndInfo;
+} T_DjiTestUpgradeRebootParam;
+
+/* Private values -------------------------------------------------------------*/
+static uint8_t s_flashSim[FLASH_SIM_SIZE];
+static T_DjiUpgradeFileInfo s_upgradeFileInfo = {0};
+
+/* Private functions declaration ---------------------------------------------*/
+static bool FLASH_SimIsRangeValid(uint32_t startAddress, uint32_t len);
+
+/* Exported functions definition ---------------------------------------------*/
+void FLASH_If_Init(void)
+{
+    memset(s_flashSim, 0xFF, sizeof(s_flashSim));
+}
+
+uint32_t FLASH_If_Erase(uint32_t StartAddress, uint32_t endAddress)
+{
+    if (endAddress < StartAddress || !FLASH_SimIsRangeValid(StartAddress, endAddress - StartAddress + 1)) {
+        return FLASHIF_ERASE_ERROR;
+    }
+
+    memset(FLASH_SIM_PTR(StartAddress), 0xFF, endAddress - StartAddress + 1);
+
+    return FLASHIF_OK;
+}
+
+uint32_t FLASH_If_Write(uint32_t FlashAddress, const uint8_t *Data, uint32_t DataLength)
+{
+    uint32_t i;
+
+    if (!FLASH_SimIsRangeValid(FlashAddress, DataLength)) {
+        return FLASHIF_WRITING_ERROR;
+    }
+
+    //programming can only clear bits, same as real flash
+    for (i = 0; i < DataLength; i++) {
+        FLASH_SIM_PTR(FlashAddress)[i] &= Data[i];
+        if (FLASH_SIM_PTR(FlashAddress)[i] != Data[i]) {
+            return FLASHIF_WRITINGCTRL_ERROR;
+        }
+    }
+
+    return FLASHIF_OK;
+}
+
+uint16_t FLASH_If_GetWriteProtectionStatus(void)
+{
+    return FLASHIF_PROTECTION_NONE;
+}
+
+HAL_StatusTypeDef FLASH_If_WriteProtectionConfig(uint32_t modifier)
+{
+    (void) modifier;
+
+    return HAL_OK;
+}
+
+T_DjiReturnCode DjiUpgradePlatformStm32_RebootSystem(void)
+{
+    USER_LOG_WARN("sim reboot requested, exit process.");
+    exit(0);
+}
+
+T_DjiReturnCode DjiUpgradePlatformStm32_CleanUpgradeProgramFileStoreArea(void)
+{
+    if (FLASH_If_Erase(APPLICATION_STORE_ADDRESS, APPLICATION_STORE_ADDRESS_END) != FLASHIF_OK) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_SYSTEM_ERROR;
+    }
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+T_DjiReturnCode DjiUpgradePlatformStm32_CreateUpgradeProgramFile(const T_DjiUpgradeFileInfo *fileInfo)
+{
+    s_upgradeFileInfo = *fileInfo;
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+T_DjiReturnCode DjiUpgradePlatformStm32_WriteUpgradeProgramFile(uint32_t offset, const uint8_t *data,
+                                                                uint16_t dataLen)
+{
+    if (FLASH_If_Write(APPLICATION_STORE_ADDRESS + offset, data, dataLen) != FLASHIF_OK) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_SYSTEM_ERROR;
+    }
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+T_DjiReturnCode DjiUpgradePlatformStm32_ReadUpgradeProgramFile(uint32_t offset, uint16_t readDataLen, uint8_t *data,
+                                                               uint16_t *realLen)
+{
+    if (!FLASH_SimIsRangeValid(APPLICATION_STORE_ADDRESS + offset, readDataLen)) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    memcpy(data, FLASH_SIM_PTR(APPLICATION_STORE_ADDRESS + offset), readDataLen);
+    *realLen = readDataLen;
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+T_DjiReturnCode DjiUpgradePlatformStm32_CloseUpgradeProgramFile(void)
+{
+    FLASH_If_Write(DJI_TEST_UPGRADE_FILE_INFO_STORE_ADDR, (uint8_t *) &s_upgradeFileInfo,
+                   sizeof(T_DjiUpgradeFileInfo));
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+T_DjiReturnCode DjiUpgradePlatformStm32_ReplaceOldProgram(void)
+{
+    T_DjiUpgradeFileInfo upgradeFileInfo;
+
+    memcpy(&upgradeFileInfo, FLASH_SIM_PTR(DJI_TEST_UPGRADE_FILE_INFO_STORE_ADDR), sizeof(upgradeFileInfo));
+    if (upgradeFileInfo.fileSize > APPLICATION_ADDRESS_END - APPLICATION_ADDRESS + 1) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    if (FLASH_If_Erase(APPLICATION_ADDRESS, APPLICATION_ADDRESS_END) != FLASHIF_OK) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_SYSTEM_ERROR;
+    }
+
+    if (FLASH_If_Write(APPLICATION_ADDRESS, FLASH_SIM_PTR(APPLICATION_STORE_ADDRESS), upgradeFileInfo.fileSize)
+        != FLASHIF_OK) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_SYSTEM_ERROR;
+    }
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+T_DjiReturnCode DjiUpgradePlatformStm32_SetUpgradeRebootState(const T_DjiUpgradeEndInfo *upgradeEndInfo)
+{
+    T_DjiTestUpgradeRebootParam upgradeRebootParam;
+
+    upgradeRebootParam.upgradeRebootKey = DJI_TEST_UPGRADE_REBOOT_KEY;
+    upgradeRebootParam.upgradeEndInfo = *upgradeEndInfo;
+
+    if (FLASH_If_Erase(APPLICATION_PARAM_STORE_ADDRESS, APPLICATION_PARAM_STORE_ADDRESS_END) != FLASHIF_OK) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_SYSTEM_ERROR;
+    }
+
+    if (FLASH_If_Write(APPLICATION_PARAM_STORE_ADDRESS, (uint8_t *) &upgradeRebootParam,
+                       sizeof(T_DjiTestUpgradeRebootParam)) != FLASHIF_OK) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_SYSTEM_ERROR;
+    }
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+T_DjiReturnCode DjiUpgradePlatformStm32_GetUpgradeRebootState(bool *isUpgradeReboot,
+                                                              T_DjiUpgradeEndInfo *upgradeEndInfo)
+{
+    T_DjiTestUpgradeRebootParam upgradeRebootParam;
+
+    memcpy(&upgradeRebootParam, FLASH_SIM_PTR(APPLICATION_PARAM_STORE_ADDRESS), sizeof(upgradeRebootParam));
+
+    if (upgradeRebootParam.upgradeRebootKey == DJI_TEST_UPGRADE_REBOOT_KEY) {
+        *isUpgradeReboot = true;
+        *upgradeEndInfo = upgradeRebootParam.upgradeEndInfo;
+    } else {
+        *isUpgradeReboot = false;
+    }
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+T_DjiReturnCode DjiUpgradePlatformStm32_CleanUpgradeRebootState(void)
+{
+    if (FLASH_If_Erase(APPLICATION_PARAM_STORE_ADDRESS, APPLICATION_PARAM_STORE_ADDRESS_END) != FLASHIF_OK) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_SYSTEM_ERROR;
+    }
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+/* Private functions definition-----------------------------------------------*/
+static bool FLASH_SimIsRangeValid(uint32_t startAddress, uint32_t len)
+{
+    return startAddress >= ADDR_FLASH_SECTOR_0 && len <= FLASH_SIM_SIZE &&
+           startAddress - ADDR_FLASH_SECTOR_0 <= FLASH_SIM_SIZE - len;
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
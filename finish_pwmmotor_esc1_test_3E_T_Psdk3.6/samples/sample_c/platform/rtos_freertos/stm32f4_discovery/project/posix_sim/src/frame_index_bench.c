@@ -0,0 +1,383 @@
+/**
+ ********************************************************************
+ * @file    frame_index_bench.c
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   Host benchmark of the H.264 frame index of camera_emu against the ffprobe -show_packets path it
+ *          replaced, on generated Annex-B streams. The old parser runs on ffprobe text built from the expected
+ *          frame table, and ffprobe itself runs too when it is in PATH.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <time.h>
+#include "dji_logger.h"
+#include "dji_platform.h"
+#include "camera_emu/test_payload_cam_emu_frame_index.h"
+
+/* Private constants ---------------------------------------------------------*/
+#define FRAME_INDEX_BENCH_FRAME_RATE            30
+#define FRAME_INDEX_BENCH_GOP_SIZE              30
+#define FRAME_INDEX_BENCH_IDR_SIZE              20000
+#define FRAME_INDEX_BENCH_P_SIZE                3000
+//same limits as test_payload_cam_emu_media.c
+#define FRAME_INDEX_BENCH_FRAME_MAX_COUNT       18000
+#define FRAME_INDEX_BENCH_FFPROBE_LINE_SIZE     1024
+#define FRAME_INDEX_BENCH_CMD_BUF_SIZE          512
+#define FRAME_INDEX_BENCH_PATH_SIZE             256
+
+/* Private types -------------------------------------------------------------*/
+typedef struct {
+    const char *name;
+    uint32_t durationS;
+} T_FrameIndexBenchStream;
+
+/* Private values -------------------------------------------------------------*/
+static T_DjiOsalHandler s_osalHandler = {0};
+static uint32_t s_seed = 1;
+
+/* Private functions declaration ---------------------------------------------*/
+static void *FrameIndexBench_Malloc(uint32_t size);
+static void FrameIndexBench_Free(void *ptr);
+static uint32_t FrameIndexBench_Random(void);
+static void FrameIndexBench_WriteNal(FILE *file, uint8_t header, uint8_t firstByte, uint32_t size,
+                                     uint32_t startCodeLen);
+static int FrameIndexBench_MakeStream(const char *path, uint32_t frameNum, T_TestPayloadCameraVideoFrameInfo *expect);
+static char *FrameIndexBench_MakeFfprobeText(const T_TestPayloadCameraVideoFrameInfo *frame, uint32_t frameNum,
+                                             size_t *size);
+static T_DjiReturnCode FrameIndexBench_ParseFfprobe(FILE *fpCommand, T_TestPayloadCameraVideoFrameInfo *frameInfo,
+                                                    uint32_t frameInfoBufferCount, uint32_t *frameCount);
+static int FrameIndexBench_Compare(const T_TestPayloadCameraVideoFrameInfo *a, uint32_t aNum,
+                                   const T_TestPayloadCameraVideoFrameInfo *b, uint32_t bNum);
+static double FrameIndexBench_GetMonotonicMs(void);
+
+/* Exported functions definition ---------------------------------------------*/
+T_DjiOsalHandler *DjiPlatform_GetOsalHandler(void)
+{
+    return &s_osalHandler;
+}
+
+void DjiLogger_UserLogOutput(E_DjiLoggerConsoleLogLevel level, const char *fmt, ...)
+{
+    va_list args;
+
+    if (level > DJI_LOGGER_CONSOLE_LOG_LEVEL_WARN) {
+        return;
+    }
+
+    va_start(args, fmt);
+    vfprintf(stderr, fmt, args);
+    fprintf(stderr, "\r\n");
+    va_end(args);
+}
+
+int main(int argc, char *argv[])
+{
+    static const T_FrameIndexBenchStream stream[] = {
+        {"1 min", 60},
+        //old parser fails when frame count reaches the buffer count of 18000, so stay below 10 min
+        {"9 min 50 s", 590},
+    };
+    const char *dir = argc > 1 ? argv[1] : "/tmp";
+    char path[FRAME_INDEX_BENCH_PATH_SIZE];
+    char cmd[FRAME_INDEX_BENCH_CMD_BUF_SIZE];
+    T_TestPayloadCameraVideoFrameInfo *expect;
+    T_TestPayloadCameraVideoFrameInfo *frame;
+    uint32_t frameNum;
+    uint32_t frameCount;
+    size_t textSize;
+    char *text;
+    FILE *file;
+    double startMs;
+    double scanMs;
+    double parseMs;
+    double ffprobeMs;
+    int isFfprobeFound;
+    int isMismatch = 0;
+    uint32_t i;
+    T_DjiReturnCode returnCode;
+
+    s_osalHandler.Malloc = FrameIndexBench_Malloc;
+    s_osalHandler.Free = FrameIndexBench_Free;
+
+    expect = malloc(FRAME_INDEX_BENCH_FRAME_MAX_COUNT * sizeof(T_TestPayloadCameraVideoFrameInfo));
+    frame = malloc(FRAME_INDEX_BENCH_FRAME_MAX_COUNT * sizeof(T_TestPayloadCameraVideoFrameInfo));
+    if (expect == NULL || frame == NULL) {
+        printf("frame index bench out of memory\r\n");
+        return 1;
+    }
+    isFfprobeFound = system("command -v ffprobe >/dev/null 2>&1") == 0;
+
+    for (i = 0; i < sizeof(stream) / sizeof(stream[0]); i++) {
+        frameNum = stream[i].durationS * FRAME_INDEX_BENCH_FRAME_RATE;
+        snprintf(path, sizeof(path), "%s/frame_index_bench_%u.h264", dir, stream[i].durationS);
+        if (FrameIndexBench_MakeStream(path, frameNum, expect) != 0) {
+            printf("frame index bench write %s error\r\n", path);
+            return 1;
+        }
+
+        startMs = FrameIndexBench_GetMonotonicMs();
+        returnCode = DjiTest_FrameIndexScanH264File(path, FRAME_INDEX_BENCH_FRAME_RATE, frame,
+                                                    FRAME_INDEX_BENCH_FRAME_MAX_COUNT, &frameCount);
+        scanMs = FrameIndexBench_GetMonotonicMs() - startMs;
+        if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS ||
+            FrameIndexBench_Compare(frame, frameCount, expect, frameNum) != 0) {
+            isMismatch = 1;
+        }
+
+        //old parser on the text ffprobe would print, includes its 18 MB buffer but not ffprobe itself
+        text = FrameIndexBench_MakeFfprobeText(expect, frameNum, &textSize);
+        file = text != NULL ? fmemopen(text, textSize, "r") : NULL;
+        if (file == NULL) {
+            printf("frame index bench out of memory\r\n");
+            return 1;
+        }
+        startMs = FrameIndexBench_GetMonotonicMs();
+        returnCode = FrameIndexBench_ParseFfprobe(file, frame, FRAME_INDEX_BENCH_FRAME_MAX_COUNT, &frameCount);
+        parseMs = FrameIndexBench_GetMonotonicMs() - startMs;
+        fclose(file);
+        free(text);
+        if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS ||
+            FrameIndexBench_Compare(frame, frameCount, expect, frameNum) != 0) {
+            isMismatch = 1;
+        }
+
+        printf("%s, %u frames, %.1f MB:\r\n", stream[i].name, frameNum,
+               (double) (expect[frameNum - 1].positionInFile + expect[frameNum - 1].size) / 1e6);
+        printf("  native scan            %9.1f ms, buffer %u KB\r\n", scanMs, 32);
+        printf("  ffprobe text parse     %9.1f ms, buffer %u KB\r\n", parseMs,
+               FRAME_INDEX_BENCH_FRAME_MAX_COUNT * FRAME_INDEX_BENCH_FFPROBE_LINE_SIZE / 1024);
+
+        if (isFfprobeFound) {
+            snprintf(cmd, sizeof(cmd), "ffprobe -show_packets \"%s\" 2>/dev/null", path);
+            startMs = FrameIndexBench_GetMonotonicMs();
+            file = popen(cmd, "r");
+            returnCode = file != NULL ?
+                         FrameIndexBench_ParseFfprobe(file, frame, FRAME_INDEX_BENCH_FRAME_MAX_COUNT, &frameCount) :
+                         DJI_ERROR_SYSTEM_MODULE_CODE_SYSTEM_ERROR;
+            if (file != NULL) {
+                pclose(file);
+            }
+            ffprobeMs = FrameIndexBench_GetMonotonicMs() - startMs;
+            printf("  ffprobe popen + parse  %9.1f ms, %s native scan\r\n", ffprobeMs,
+                   returnCode == DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS &&
+                   FrameIndexBench_Compare(frame, frameCount, expect, frameNum) == 0 ? "same as" : "DIFFERS from");
+        } else {
+            printf("  ffprobe popen + parse  skipped, ffprobe is not in PATH\r\n");
+        }
+
+        remove(path);
+    }
+
+    printf("frame table %s\r\n", isMismatch ? "MISMATCH" : "matches generated stream");
+    free(frame);
+    free(expect);
+
+    return isMismatch;
+}
+
+/* Private functions definition-----------------------------------------------*/
+static void *FrameIndexBench_Malloc(uint32_t size)
+{
+    return malloc(size);
+}
+
+static void FrameIndexBench_Free(void *ptr)
+{
+    free(ptr);
+}
+
+static uint32_t FrameIndexBench_Random(void)
+{
+    s_seed = s_seed * 1103515245 + 12345;
+
+    return s_seed >> 8;
+}
+
+//payload has no zero byte, so it never needs emulation prevention
+static void FrameIndexBench_WriteNal(FILE *file, uint8_t header, uint8_t firstByte, uint32_t size,
+                                     uint32_t startCodeLen)
+{
+    static const uint8_t startCode[] = {0x00, 0x00, 0x00, 0x01};
+    uint32_t i;
+
+    fwrite(startCode + sizeof(startCode) - startCodeLen, 1, startCodeLen, file);
+    fputc(header, file);
+    fputc(firstByte, file);
+    for (i = 2; i < size; i++) {
+        fputc((int) (FrameIndexBench_Random() % 255 + 1), file);
+    }
+}
+
+//like ffmpeg -f h264 output: SPS, PPS and SEI before every IDR, one or two slices a frame, AUD now and then
+static int FrameIndexBench_MakeStream(const char *path, uint32_t frameNum, T_TestPayloadCameraVideoFrameInfo *expect)
+{
+    FILE *file;
+    uint32_t i;
+    uint32_t size;
+    uint32_t random;
+    long position;
+
+    file = fopen(path, "wb");
+    if (file == NULL) {
+        return -1;
+    }
+
+    for (i = 0; i < frameNum; i++) {
+        position = ftell(file);
+        random = FrameIndexBench_Random();
+        size = i % FRAME_INDEX_BENCH_GOP_SIZE == 0 ? FRAME_INDEX_BENCH_IDR_SIZE : FRAME_INDEX_BENCH_P_SIZE;
+        size = size / 2 + random % size;
+
+        if (random % 7 == 0) {
+            FrameIndexBench_WriteNal(file, 0x09, 0x10, 2, 4);
+        }
+        if (i % FRAME_INDEX_BENCH_GOP_SIZE == 0) {
+            FrameIndexBench_WriteNal(file, 0x67, 0x64, 24, 4);
+            FrameIndexBench_WriteNal(file, 0x68, 0xEB, 6, 4);
+            FrameIndexBench_WriteNal(file, 0x06, 0x05, 40, 4);
+        }
+        //first slice has first_mb_in_slice 0, second one a larger first_mb_in_slice
+        if (random % 3 == 0) {
+            FrameIndexBench_WriteNal(file, i % FRAME_INDEX_BENCH_GOP_SIZE == 0 ? 0x65 : 0x41, 0x88, size / 2,
+                                     i % FRAME_INDEX_BENCH_GOP_SIZE == 0 && random % 7 != 0 ? 3 : 4);
+            FrameIndexBench_WriteNal(file, i % FRAME_INDEX_BENCH_GOP_SIZE == 0 ? 0x65 : 0x41, 0x4A, size / 2, 3);
+        } else {
+            FrameIndexBench_WriteNal(file, i % FRAME_INDEX_BENCH_GOP_SIZE == 0 ? 0x65 : 0x41, 0x88, size,
+                                     i % FRAME_INDEX_BENCH_GOP_SIZE == 0 && random % 7 != 0 ? 3 : 4);
+        }
+
+        expect[i].durationS = 1.0f / FRAME_INDEX_BENCH_FRAME_RATE;
+        expect[i].positionInFile = (uint32_t) position;
+        expect[i].size = (uint32_t) (ftell(file) - position);
+    }
+
+    return fclose(file);
+}
+
+static char *FrameIndexBench_MakeFfprobeText(const T_TestPayloadCameraVideoFrameInfo *frame, uint32_t frameNum,
+                                             size_t *size)
+{
+    char *text = malloc((size_t) frameNum * 256);
+    size_t len = 0;
+    uint32_t i;
+
+    if (text == NULL) {
+        return NULL;
+    }
+
+    for (i = 0; i < frameNum; i++) {
+        len += (size_t) sprintf(text + len,
+                                "[PACKET]\ncodec_type=video\nstream_index=0\npts=N/A\npts_time=N/A\ndts=N/A\n"
+                                "dts_time=N/A\nduration=%u\nduration_time=%f\nconvergence_duration=N/A\n"
+                                "convergence_duration_time=N/A\nsize=%u\npos=%u\nflags=%s\n[/PACKET]\n",
+                                1200000 / FRAME_INDEX_BENCH_FRAME_RATE, frame[i].durationS, frame[i].size,
+                                frame[i].positionInFile, i % FRAME_INDEX_BENCH_GOP_SIZE == 0 ? "K_" : "__");
+    }
+    *size = len;
+
+    return text;
+}
+
+//DjiPlayback_GetFrameInfoOfVideoFile of test_payload_cam_emu_media.c before the frame index, reading from a stream
+static T_DjiReturnCode FrameIndexBench_ParseFfprobe(FILE *fpCommand, T_TestPayloadCameraVideoFrameInfo *frameInfo,
+                                                    uint32_t frameInfoBufferCount, uint32_t *frameCount)
+{
+    long ret;
+    T_DjiReturnCode returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+    char *frameInfoString;
+    char *frameLocation;
+    char *location;
+    uint32_t frameNumber = 0;
+
+    frameInfoString = malloc(FRAME_INDEX_BENCH_FRAME_MAX_COUNT * FRAME_INDEX_BENCH_FFPROBE_LINE_SIZE);
+    if (frameInfoString == NULL) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_MEMORY_ALLOC_FAILED;
+    }
+    memset(frameInfoString, 0, FRAME_INDEX_BENCH_FRAME_MAX_COUNT * FRAME_INDEX_BENCH_FFPROBE_LINE_SIZE);
+
+    ret = (long) fread(frameInfoString, 1, FRAME_INDEX_BENCH_FRAME_MAX_COUNT * FRAME_INDEX_BENCH_FFPROBE_LINE_SIZE - 1,
+                       fpCommand);
+    frameInfoString[ret] = '\0';
+
+    frameLocation = frameInfoString;
+    *frameCount = 0;
+    while ((frameLocation = strstr(frameLocation, "[PACKET]")) != NULL) {
+        if ((location = strstr(frameLocation, "duration_time")) == NULL ||
+            sscanf(location, "duration_time=%f", &frameInfo[frameNumber].durationS) <= 0 ||
+            (location = strstr(frameLocation, "pos")) == NULL ||
+            sscanf(location, "pos=%u", &frameInfo[frameNumber].positionInFile) <= 0 ||
+            (location = strstr(frameLocation, "size")) == NULL ||
+            sscanf(location, "size=%u", &frameInfo[frameNumber].size) <= 0) {
+            returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
+            break;
+        }
+
+        frameLocation += strlen("[PACKET]");
+        frameNumber++;
+        (*frameCount)++;
+
+        if (frameNumber >= frameInfoBufferCount) {
+            returnCode = DJI_ERROR_SYSTEM_MODULE_CODE_OUT_OF_RANGE;
+            break;
+        }
+    }
+
+    free(frameInfoString);
+
+    return returnCode;
+}
+
+static int FrameIndexBench_Compare(const T_TestPayloadCameraVideoFrameInfo *a, uint32_t aNum,
+                                   const T_TestPayloadCameraVideoFrameInfo *b, uint32_t bNum)
+{
+    uint32_t i;
+
+    if (aNum != bNum) {
+        printf("  frame count %u, expect %u\r\n", aNum, bNum);
+        return -1;
+    }
+
+    for (i = 0; i < aNum; i++) {
+        if (a[i].positionInFile != b[i].positionInFile || a[i].size != b[i].size ||
+            (a[i].durationS - b[i].durationS) * (a[i].durationS - b[i].durationS) > 1e-10f) {
+            printf("  frame %u at %u size %u, expect at %u size %u\r\n", i, a[i].positionInFile, a[i].size,
+                   b[i].positionInFile, b[i].size);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static double FrameIndexBench_GetMonotonicMs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double) ts.tv_sec * 1e3 + (double) ts.tv_nsec / 1e6;
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
@@ -0,0 +1,350 @@
+/**
+ ********************************************************************
+ * @file    frame_index_cache_bench.c
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   Host benchmark of the frame index cache of camera_emu on a generated media directory: cold start scans
+ *          every video and saves its cache, warm start loads the caches. Also checks that a loaded index equals
+ *          the scanned one, and that a modified video or a damaged cache is not used.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <time.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include "dji_logger.h"
+#include "dji_platform.h"
+#include "camera_emu/test_payload_cam_emu_frame_index.h"
+
+/* Private constants ---------------------------------------------------------*/
+#define FRAME_INDEX_CACHE_BENCH_FILE_NUM            16
+#define FRAME_INDEX_CACHE_BENCH_DURATION_MIN_S      30
+#define FRAME_INDEX_CACHE_BENCH_DURATION_STEP_S     35
+#define FRAME_INDEX_CACHE_BENCH_FRAME_RATE          30
+#define FRAME_INDEX_CACHE_BENCH_GOP_SIZE            30
+#define FRAME_INDEX_CACHE_BENCH_IDR_SIZE            20000
+#define FRAME_INDEX_CACHE_BENCH_P_SIZE              3000
+//a frame is less than 1.5 IDR size and starts in the first IDR size bytes of the payload
+#define FRAME_INDEX_CACHE_BENCH_PAYLOAD_SIZE        (FRAME_INDEX_CACHE_BENCH_IDR_SIZE * 3)
+//same limit as test_payload_cam_emu_media.c
+#define FRAME_INDEX_CACHE_BENCH_FRAME_MAX_COUNT     18000
+#define FRAME_INDEX_CACHE_BENCH_PATH_SIZE           512
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private values -------------------------------------------------------------*/
+static T_DjiOsalHandler s_osalHandler = {0};
+static uint32_t s_seed = 1;
+
+/* Private functions declaration ---------------------------------------------*/
+static void *FrameIndexCacheBench_Malloc(uint32_t size);
+static void FrameIndexCacheBench_Free(void *ptr);
+static uint32_t FrameIndexCacheBench_Random(void);
+static int FrameIndexCacheBench_MakeStream(const char *path, uint32_t frameNum);
+static T_DjiReturnCode FrameIndexCacheBench_GetFrameInfo(const char *path, bool isScanOnMiss,
+                                                         T_TestPayloadCameraVideoFrameInfo *frameInfo,
+                                                         uint32_t *frameCount);
+static int FrameIndexCacheBench_Compare(const T_TestPayloadCameraVideoFrameInfo *a, uint32_t aNum,
+                                        const T_TestPayloadCameraVideoFrameInfo *b, uint32_t bNum);
+static double FrameIndexCacheBench_GetMonotonicMs(void);
+
+/* Exported functions definition ---------------------------------------------*/
+T_DjiOsalHandler *DjiPlatform_GetOsalHandler(void)
+{
+    return &s_osalHandler;
+}
+
+void DjiLogger_UserLogOutput(E_DjiLoggerConsoleLogLevel level, const char *fmt, ...)
+{
+    va_list args;
+
+    if (level > DJI_LOGGER_CONSOLE_LOG_LEVEL_WARN) {
+        return;
+    }
+
+    va_start(args, fmt);
+    vfprintf(stderr, fmt, args);
+    fprintf(stderr, "\r\n");
+    va_end(args);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *dir = argc > 1 ? argv[1] : "/tmp";
+    char path[FRAME_INDEX_CACHE_BENCH_FILE_NUM][FRAME_INDEX_CACHE_BENCH_PATH_SIZE];
+    char cachePath[FRAME_INDEX_CACHE_BENCH_PATH_SIZE];
+    T_TestPayloadCameraVideoFrameInfo *scanned[FRAME_INDEX_CACHE_BENCH_FILE_NUM];
+    uint32_t scannedCount[FRAME_INDEX_CACHE_BENCH_FILE_NUM];
+    T_TestPayloadCameraVideoFrameInfo *frame;
+    uint32_t frameCount;
+    uint32_t totalFrameNum = 0;
+    double totalMb = 0;
+    double cacheKb = 0;
+    double startMs;
+    double fileMs;
+    double coldMs = 0;
+    double coldMaxMs = 0;
+    double warmMs = 0;
+    double warmMaxMs = 0;
+    struct stat fileStat;
+    struct timespec modifyTime[2];
+    FILE *file;
+    int isFail = 0;
+    uint32_t i;
+
+    s_osalHandler.Malloc = FrameIndexCacheBench_Malloc;
+    s_osalHandler.Free = FrameIndexCacheBench_Free;
+
+    frame = malloc(FRAME_INDEX_CACHE_BENCH_FRAME_MAX_COUNT * sizeof(T_TestPayloadCameraVideoFrameInfo));
+    if (frame == NULL) {
+        printf("frame index cache bench out of memory\r\n");
+        return 1;
+    }
+
+    for (i = 0; i < FRAME_INDEX_CACHE_BENCH_FILE_NUM; i++) {
+        snprintf(path[i], sizeof(path[i]), "%s/frame_index_cache_bench_%02u.h264", dir, i);
+        if (FrameIndexCacheBench_MakeStream(path[i], (FRAME_INDEX_CACHE_BENCH_DURATION_MIN_S +
+                                                      i * FRAME_INDEX_CACHE_BENCH_DURATION_STEP_S) *
+                                                     FRAME_INDEX_CACHE_BENCH_FRAME_RATE) != 0) {
+            printf("frame index cache bench write %s error\r\n", path[i]);
+            return 1;
+        }
+        if (DjiTest_FrameIndexGetCachePath(path[i], cachePath, sizeof(cachePath)) ==
+            DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+            remove(cachePath);
+        }
+        scanned[i] = malloc(FRAME_INDEX_CACHE_BENCH_FRAME_MAX_COUNT * sizeof(T_TestPayloadCameraVideoFrameInfo));
+        if (scanned[i] == NULL) {
+            printf("frame index cache bench out of memory\r\n");
+            return 1;
+        }
+    }
+
+    //cold start, no cache yet, the video is in page cache right after writing so this is the best case of a scan
+    for (i = 0; i < FRAME_INDEX_CACHE_BENCH_FILE_NUM; i++) {
+        startMs = FrameIndexCacheBench_GetMonotonicMs();
+        if (FrameIndexCacheBench_GetFrameInfo(path[i], true, scanned[i], &scannedCount[i]) !=
+            DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+            printf("  cold start of %s fail\r\n", path[i]);
+            isFail = 1;
+        }
+        fileMs = FrameIndexCacheBench_GetMonotonicMs() - startMs;
+        coldMs += fileMs;
+        coldMaxMs = fileMs > coldMaxMs ? fileMs : coldMaxMs;
+
+        totalFrameNum += scannedCount[i];
+        if (stat(path[i], &fileStat) == 0) {
+            totalMb += (double) fileStat.st_size / 1e6;
+        }
+        if (DjiTest_FrameIndexGetCachePath(path[i], cachePath, sizeof(cachePath)) ==
+            DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS && stat(cachePath, &fileStat) == 0) {
+            cacheKb += (double) fileStat.st_size / 1e3;
+        }
+    }
+
+    //warm start, every index comes from its cache and must equal the scanned one
+    for (i = 0; i < FRAME_INDEX_CACHE_BENCH_FILE_NUM; i++) {
+        startMs = FrameIndexCacheBench_GetMonotonicMs();
+        if (FrameIndexCacheBench_GetFrameInfo(path[i], false, frame, &frameCount) !=
+            DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS ||
+            FrameIndexCacheBench_Compare(frame, frameCount, scanned[i], scannedCount[i]) != 0) {
+            printf("  warm start of %s fail\r\n", path[i]);
+            isFail = 1;
+        }
+        fileMs = FrameIndexCacheBench_GetMonotonicMs() - startMs;
+        warmMs += fileMs;
+        warmMaxMs = fileMs > warmMaxMs ? fileMs : warmMaxMs;
+    }
+
+    printf("%u videos, %u frames, %.1f MB, cache %.1f KB:\r\n", FRAME_INDEX_CACHE_BENCH_FILE_NUM, totalFrameNum,
+           totalMb, cacheKb);
+    printf("  cold start, scan and save  %9.2f ms, max %8.2f ms a video\r\n", coldMs, coldMaxMs);
+    printf("  warm start, load cache     %9.2f ms, max %8.2f ms a video, %.0fx\r\n", warmMs, warmMaxMs,
+           coldMs / warmMs);
+
+    //a video with new modify time has to be scanned again
+    modifyTime[0].tv_nsec = UTIME_OMIT;
+    modifyTime[1].tv_sec = time(NULL) + 10;
+    modifyTime[1].tv_nsec = 0;
+    if (utimensat(AT_FDCWD, path[0], modifyTime, 0) != 0 ||
+        FrameIndexCacheBench_GetFrameInfo(path[0], false, frame, &frameCount) !=
+        DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND) {
+        printf("  cache of modified video is used\r\n");
+        isFail = 1;
+    }
+
+    //flip a byte of a frame record, checksum must reject the cache
+    if (DjiTest_FrameIndexGetCachePath(path[1], cachePath, sizeof(cachePath)) ==
+        DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS && (file = fopen(cachePath, "rb+")) != NULL) {
+        fseek(file, -5, SEEK_END);
+        fputc(0x5A, file);
+        fclose(file);
+    }
+    if (FrameIndexCacheBench_GetFrameInfo(path[1], false, frame, &frameCount) !=
+        DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND) {
+        printf("  damaged cache is used\r\n");
+        isFail = 1;
+    }
+
+    for (i = 0; i < FRAME_INDEX_CACHE_BENCH_FILE_NUM; i++) {
+        if (DjiTest_FrameIndexGetCachePath(path[i], cachePath, sizeof(cachePath)) ==
+            DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+            remove(cachePath);
+        }
+        remove(path[i]);
+        free(scanned[i]);
+    }
+    free(frame);
+
+    printf("frame index cache %s\r\n", isFail ? "FAIL" : "ok");
+
+    return isFail;
+}
+
+/* Private functions definition-----------------------------------------------*/
+static void *FrameIndexCacheBench_Malloc(uint32_t size)
+{
+    return malloc(size);
+}
+
+static void FrameIndexCacheBench_Free(void *ptr)
+{
+    free(ptr);
+}
+
+static uint32_t FrameIndexCacheBench_Random(void)
+{
+    s_seed = s_seed * 1103515245 + 12345;
+
+    return s_seed >> 8;
+}
+
+//SPS and PPS before every IDR, one slice a frame, payload has no zero byte
+static int FrameIndexCacheBench_MakeStream(const char *path, uint32_t frameNum)
+{
+    static const uint8_t sps[] = {0x00, 0x00, 0x00, 0x01, 0x67, 0x64, 0x00, 0x28, 0xAC};
+    static const uint8_t pps[] = {0x00, 0x00, 0x00, 0x01, 0x68, 0xEB, 0xE3, 0xCB};
+    uint8_t header[] = {0x00, 0x00, 0x00, 0x01, 0x00, 0x88};
+    uint8_t *payload;
+    FILE *file;
+    uint32_t i;
+    uint32_t size;
+
+    payload = malloc(FRAME_INDEX_CACHE_BENCH_PAYLOAD_SIZE);
+    file = fopen(path, "wb");
+    if (payload == NULL || file == NULL) {
+        free(payload);
+        return -1;
+    }
+    for (i = 0; i < FRAME_INDEX_CACHE_BENCH_PAYLOAD_SIZE; i++) {
+        payload[i] = (uint8_t) (FrameIndexCacheBench_Random() % 255 + 1);
+    }
+
+    for (i = 0; i < frameNum; i++) {
+        size = i % FRAME_INDEX_CACHE_BENCH_GOP_SIZE == 0 ? FRAME_INDEX_CACHE_BENCH_IDR_SIZE :
+               FRAME_INDEX_CACHE_BENCH_P_SIZE;
+        size = size / 2 + FrameIndexCacheBench_Random() % size;
+        header[4] = i % FRAME_INDEX_CACHE_BENCH_GOP_SIZE == 0 ? 0x65 : 0x41;
+
+        if (i % FRAME_INDEX_CACHE_BENCH_GOP_SIZE == 0) {
+            fwrite(sps, 1, sizeof(sps), file);
+            fwrite(pps, 1, sizeof(pps), file);
+        }
+        fwrite(header, 1, sizeof(header), file);
+        fwrite(payload + FrameIndexCacheBench_Random() % FRAME_INDEX_CACHE_BENCH_IDR_SIZE, 1, size, file);
+    }
+
+    free(payload);
+
+    return fclose(file);
+}
+
+//DjiPlayback_GetFrameInfoOfVideoFile of test_payload_cam_emu_media.c, the video is its own transcoded file here
+static T_DjiReturnCode FrameIndexCacheBench_GetFrameInfo(const char *path, bool isScanOnMiss,
+                                                         T_TestPayloadCameraVideoFrameInfo *frameInfo,
+                                                         uint32_t *frameCount)
+{
+    T_TestPayloadCameraFrameIndexKey cacheKey;
+    char cachePath[FRAME_INDEX_CACHE_BENCH_PATH_SIZE];
+    float frameRate = FRAME_INDEX_CACHE_BENCH_FRAME_RATE;
+    T_DjiReturnCode returnCode;
+
+    returnCode = DjiTest_FrameIndexGetCachePath(path, cachePath, sizeof(cachePath));
+    if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        return returnCode;
+    }
+
+    returnCode = DjiTest_FrameIndexGetCacheKey(path, &cacheKey);
+    if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        return returnCode;
+    }
+
+    returnCode = DjiTest_FrameIndexLoadCache(cachePath, &cacheKey, &frameRate, frameInfo,
+                                             FRAME_INDEX_CACHE_BENCH_FRAME_MAX_COUNT, frameCount);
+    if (returnCode == DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS || !isScanOnMiss) {
+        return returnCode;
+    }
+
+    returnCode = DjiTest_FrameIndexScanH264File(path, frameRate, frameInfo, FRAME_INDEX_CACHE_BENCH_FRAME_MAX_COUNT,
+                                                frameCount);
+    if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        return returnCode;
+    }
+
+    return DjiTest_FrameIndexSaveCache(cachePath, &cacheKey, frameRate, frameInfo, *frameCount);
+}
+
+static int FrameIndexCacheBench_Compare(const T_TestPayloadCameraVideoFrameInfo *a, uint32_t aNum,
+                                        const T_TestPayloadCameraVideoFrameInfo *b, uint32_t bNum)
+{
+    uint32_t i;
+
+    if (aNum != bNum) {
+        printf("  frame count %u, expect %u\r\n", aNum, bNum);
+        return -1;
+    }
+
+    for (i = 0; i < aNum; i++) {
+        if (a[i].positionInFile != b[i].positionInFile || a[i].size != b[i].size || a[i].ptsMs != b[i].ptsMs ||
+            a[i].isKeyFrame != b[i].isKeyFrame || a[i].durationS != b[i].durationS ||
+            a[i].isKeyFrame != (i % FRAME_INDEX_CACHE_BENCH_GOP_SIZE == 0)) {
+            printf("  frame %u differs\r\n", i);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static double FrameIndexCacheBench_GetMonotonicMs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double) ts.tv_sec * 1e3 + (double) ts.tv_nsec / 1e6;
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
@@ -0,0 +1,292 @@
+/**
+ ********************************************************************
+ * @file    frame_seek_bench.c
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   Host microbenchmark of seek by time in the frame index of camera_emu on synthetic 1 hour frame
+ *          tables, binary search with key frame index against the linear walk it replaced. Seek results are
+ *          checked against a brute force search.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <time.h>
+#include "dji_logger.h"
+#include "dji_platform.h"
+#include "camera_emu/test_payload_cam_emu_frame_index.h"
+
+/* Private constants ---------------------------------------------------------*/
+#define FRAME_SEEK_BENCH_DURATION_S             3600
+#define FRAME_SEEK_BENCH_LINEAR_SEEK_NUM        2000
+#define FRAME_SEEK_BENCH_SEEK_NUM               1000000
+#define FRAME_SEEK_BENCH_CHECK_NUM              20000
+//one in this many frames is an extra key frame of a scene cut
+#define FRAME_SEEK_BENCH_SCENE_CUT_RATE         97
+
+/* Private types -------------------------------------------------------------*/
+typedef struct {
+    const char *name;
+    float frameRate;
+    uint32_t gopSize;
+    bool isSceneCut;
+} T_FrameSeekBenchTable;
+
+/* Private values -------------------------------------------------------------*/
+static T_DjiOsalHandler s_osalHandler = {0};
+static uint32_t s_seed = 1;
+
+/* Private functions declaration ---------------------------------------------*/
+static void *FrameSeekBench_Malloc(uint32_t size);
+static void FrameSeekBench_Free(void *ptr);
+static uint32_t FrameSeekBench_Random(void);
+static void FrameSeekBench_MakeTable(const T_FrameSeekBenchTable *table, T_TestPayloadCameraVideoFrameInfo *frameInfo,
+                                     uint32_t frameCount);
+static T_DjiReturnCode FrameSeekBench_GetFrameNumberByTime(T_TestPayloadCameraVideoFrameInfo *frameInfo,
+                                                           uint32_t frameCount, uint32_t *frameNumber,
+                                                           uint32_t timeMs);
+static int FrameSeekBench_Check(const T_TestPayloadCameraVideoFrameInfo *frameInfo, uint32_t frameCount,
+                                const uint32_t *keyFrameIndex, uint32_t keyFrameCount, uint32_t timeMs);
+static double FrameSeekBench_GetMonotonicNs(void);
+
+/* Exported functions definition ---------------------------------------------*/
+T_DjiOsalHandler *DjiPlatform_GetOsalHandler(void)
+{
+    return &s_osalHandler;
+}
+
+void DjiLogger_UserLogOutput(E_DjiLoggerConsoleLogLevel level, const char *fmt, ...)
+{
+    va_list args;
+
+    if (level > DJI_LOGGER_CONSOLE_LOG_LEVEL_WARN) {
+        return;
+    }
+
+    va_start(args, fmt);
+    vfprintf(stderr, fmt, args);
+    fprintf(stderr, "\r\n");
+    va_end(args);
+}
+
+int main(void)
+{
+    static const T_FrameSeekBenchTable table[] = {
+        {"30 fps, 1 s GOP", 30, 30, false},
+        {"30 fps, 10 s GOP, scene cuts", 30, 300, true},
+        {"60 fps, 2 s GOP", 60, 120, false},
+    };
+    T_TestPayloadCameraVideoFrameInfo *frameInfo;
+    T_TestPayloadCameraFrameSeekPosition position;
+    uint32_t *keyFrameIndex;
+    uint32_t *seekTimeMs;
+    uint32_t frameCount;
+    uint32_t keyFrameCount;
+    uint32_t durationMs;
+    uint32_t frameNumber;
+    uint64_t checksum = 0;
+    uint64_t decodeForwardSum;
+    double startNs;
+    double buildNs;
+    double linearNs;
+    double seekNs;
+    int isFail = 0;
+    uint32_t i;
+    uint32_t j;
+
+    s_osalHandler.Malloc = FrameSeekBench_Malloc;
+    s_osalHandler.Free = FrameSeekBench_Free;
+
+    seekTimeMs = malloc(FRAME_SEEK_BENCH_SEEK_NUM * sizeof(uint32_t));
+    if (seekTimeMs == NULL) {
+        printf("frame seek bench out of memory\r\n");
+        return 1;
+    }
+
+    for (i = 0; i < sizeof(table) / sizeof(table[0]); i++) {
+        frameCount = (uint32_t) (FRAME_SEEK_BENCH_DURATION_S * table[i].frameRate);
+        frameInfo = malloc(frameCount * sizeof(T_TestPayloadCameraVideoFrameInfo));
+        keyFrameIndex = malloc(frameCount * sizeof(uint32_t));
+        if (frameInfo == NULL || keyFrameIndex == NULL) {
+            printf("frame seek bench out of memory\r\n");
+            return 1;
+        }
+        FrameSeekBench_MakeTable(&table[i], frameInfo, frameCount);
+        durationMs = FRAME_SEEK_BENCH_DURATION_S * 1000;
+        for (j = 0; j < FRAME_SEEK_BENCH_SEEK_NUM; j++) {
+            seekTimeMs[j] = FrameSeekBench_Random() % (durationMs + 1);
+        }
+
+        startNs = FrameSeekBench_GetMonotonicNs();
+        if (DjiTest_FrameIndexBuildKeyFrameIndex(frameInfo, frameCount, keyFrameIndex, frameCount,
+                                                 &keyFrameCount) != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+            isFail = 1;
+        }
+        buildNs = FrameSeekBench_GetMonotonicNs() - startNs;
+
+        startNs = FrameSeekBench_GetMonotonicNs();
+        for (j = 0; j < FRAME_SEEK_BENCH_LINEAR_SEEK_NUM; j++) {
+            if (FrameSeekBench_GetFrameNumberByTime(frameInfo, frameCount, &frameNumber, seekTimeMs[j]) ==
+                DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+                checksum += frameNumber;
+            }
+        }
+        linearNs = (FrameSeekBench_GetMonotonicNs() - startNs) / FRAME_SEEK_BENCH_LINEAR_SEEK_NUM;
+
+        decodeForwardSum = 0;
+        startNs = FrameSeekBench_GetMonotonicNs();
+        for (j = 0; j < FRAME_SEEK_BENCH_SEEK_NUM; j++) {
+            if (DjiTest_FrameIndexSeek(frameInfo, frameCount, keyFrameIndex, keyFrameCount, seekTimeMs[j],
+                                       &position) == DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+                decodeForwardSum += position.decodeForwardCount;
+                checksum += position.keyFrameNumber;
+            }
+        }
+        seekNs = (FrameSeekBench_GetMonotonicNs() - startNs) / FRAME_SEEK_BENCH_SEEK_NUM;
+
+        for (j = 0; j < FRAME_SEEK_BENCH_CHECK_NUM; j++) {
+            if (FrameSeekBench_Check(frameInfo, frameCount, keyFrameIndex, keyFrameCount, seekTimeMs[j]) != 0) {
+                isFail = 1;
+                break;
+            }
+        }
+        //edges, both ends of the video and after its end
+        if (FrameSeekBench_Check(frameInfo, frameCount, keyFrameIndex, keyFrameCount, 0) != 0 ||
+            FrameSeekBench_Check(frameInfo, frameCount, keyFrameIndex, keyFrameCount, durationMs) != 0 ||
+            DjiTest_FrameIndexSeek(frameInfo, frameCount, keyFrameIndex, keyFrameCount, durationMs + 1,
+                                   &position) != DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND) {
+            isFail = 1;
+        }
+
+        printf("%s, %u frames, %u key frames:\r\n", table[i].name, frameCount, keyFrameCount);
+        printf("  key frame index build  %10.1f us\r\n", buildNs / 1e3);
+        printf("  linear walk            %10.1f ns a seek\r\n", linearNs);
+        printf("  binary search          %10.1f ns a seek, %.0fx, %.1f frames to decode forward on average\r\n",
+               seekNs, linearNs / seekNs, (double) decodeForwardSum / FRAME_SEEK_BENCH_SEEK_NUM);
+
+        free(keyFrameIndex);
+        free(frameInfo);
+    }
+
+    free(seekTimeMs);
+    printf("seek %s (%llu)\r\n", isFail ? "MISMATCH" : "matches brute force search", (unsigned long long) checksum);
+
+    return isFail;
+}
+
+/* Private functions definition-----------------------------------------------*/
+static void *FrameSeekBench_Malloc(uint32_t size)
+{
+    return malloc(size);
+}
+
+static void FrameSeekBench_Free(void *ptr)
+{
+    free(ptr);
+}
+
+static uint32_t FrameSeekBench_Random(void)
+{
+    s_seed = s_seed * 1103515245 + 12345;
+
+    return s_seed >> 8;
+}
+
+//timestamps as the frame index scan makes them, position and size do not matter for seek
+static void FrameSeekBench_MakeTable(const T_FrameSeekBenchTable *table, T_TestPayloadCameraVideoFrameInfo *frameInfo,
+                                     uint32_t frameCount)
+{
+    uint32_t i;
+
+    for (i = 0; i < frameCount; i++) {
+        frameInfo[i].durationS = 1.0f / table->frameRate;
+        frameInfo[i].positionInFile = i * 4096;
+        frameInfo[i].size = 4096;
+        frameInfo[i].ptsMs = (uint32_t) ((double) i * 1000.0 / table->frameRate + 0.5);
+        frameInfo[i].isKeyFrame = i % table->gopSize == 0 ||
+                                  (table->isSceneCut && FrameSeekBench_Random() % FRAME_SEEK_BENCH_SCENE_CUT_RATE == 0);
+    }
+}
+
+//DjiPlayback_GetFrameNumberByTime of test_payload_cam_emu_media.c before the seek of frame index
+static T_DjiReturnCode FrameSeekBench_GetFrameNumberByTime(T_TestPayloadCameraVideoFrameInfo *frameInfo,
+                                                           uint32_t frameCount, uint32_t *frameNumber,
+                                                           uint32_t timeMs)
+{
+    uint32_t i = 0;
+    double camulativeTimeS = 0;
+    double timeS = (double) timeMs / 1000.0;
+
+    for (i = 0; i < frameCount; ++i) {
+        camulativeTimeS += frameInfo[i].durationS;
+
+        if (camulativeTimeS >= timeS) {
+            *frameNumber = i;
+            return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+        }
+    }
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_NOT_FOUND;
+}
+
+static int FrameSeekBench_Check(const T_TestPayloadCameraVideoFrameInfo *frameInfo, uint32_t frameCount,
+                                const uint32_t *keyFrameIndex, uint32_t keyFrameCount, uint32_t timeMs)
+{
+    T_TestPayloadCameraFrameSeekPosition position;
+    uint32_t frameNumber = 0;
+    uint32_t keyFrameNumber = 0;
+    uint32_t i;
+
+    if (DjiTest_FrameIndexSeek(frameInfo, frameCount, keyFrameIndex, keyFrameCount, timeMs, &position) !=
+        DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        printf("  seek to %u ms fail\r\n", timeMs);
+        return -1;
+    }
+
+    for (i = 0; i < frameCount && frameInfo[i].ptsMs <= timeMs; i++) {
+        frameNumber = i;
+        if (frameInfo[i].isKeyFrame) {
+            keyFrameNumber = i;
+        }
+    }
+
+    if (position.keyFrameNumber != keyFrameNumber ||
+        position.keyFrameNumber + position.decodeForwardCount != frameNumber) {
+        printf("  seek to %u ms gets key frame %u + %u, expect %u + %u\r\n", timeMs, position.keyFrameNumber,
+               position.decodeForwardCount, keyFrameNumber, frameNumber - keyFrameNumber);
+        return -1;
+    }
+
+    return 0;
+}
+
+static double FrameSeekBench_GetMonotonicNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
@@ -0,0 +1,94 @@
+/**
+ ********************************************************************
+ * @file    main_sim.c
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   Entry of host simulator build, creates the same tasks as application/main.c and runs
+ *          them on FreeRTOS POSIX port.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <signal.h>
+#include <stdio.h>
+#include "application.h"
+#include "flash_if.h"
+#include "time_base.h"
+#include "motor_plant_sim.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Private constants ---------------------------------------------------------*/
+//stack depth of POSIX port is counted in 8 bytes words, keep same bytes as target
+#define USER_START_TASK_STACK_SIZE          (2048 * 4 / sizeof(StackType_t))
+#define USER_START_TASK_PRIORITY            0
+#define USER_RUN_INDICATE_TASK_STACK_SIZE   configMINIMAL_STACK_SIZE
+#define USER_RUN_INDICATE_TASK_PRIORITY     0
+
+#define USER_MOTORPWM_TASK_STACK_SIZE       configMINIMAL_STACK_SIZE
+#define USER_MOTORPWM_TASK_PRIORITY         0
+
+#define USER_LEDPWM_TASK_STACK_SIZE         configMINIMAL_STACK_SIZE
+#define USER_LEDPWM_TASK_PRIORITY           0
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private values -------------------------------------------------------------*/
+static TaskHandle_t startTask;
+static TaskHandle_t runIndicateTask;
+static TaskHandle_t motorPwmTask;
+static TaskHandle_t ledPwmTask;
+
+/* Private functions declaration ---------------------------------------------*/
+
+/* Exported functions definition ---------------------------------------------*/
+int main(void)
+{
+    //stand-in of aircraft link may be a pipe, don't let a closed reader kill the process
+    signal(SIGPIPE, SIG_IGN);
+    setvbuf(stdout, NULL, _IONBF, 0);
+
+    FLASH_If_Init();
+    TimeBase_Init();
+    MotorPlantSim_Init();
+
+    /* Create start task */
+    xTaskCreate((TaskFunction_t) DjiUser_StartTask, "start_task", USER_START_TASK_STACK_SIZE,
+                NULL, USER_START_TASK_PRIORITY, &startTask);
+
+    /* Create runIndicate task */
+    xTaskCreate((TaskFunction_t) DjiUser_MonitorTask, "monitor_task", USER_RUN_INDICATE_TASK_STACK_SIZE,
+                NULL, USER_RUN_INDICATE_TASK_PRIORITY, &runIndicateTask);
+
+    /* Create motorPwm Task */
+    xTaskCreate((TaskFunction_t) DjiUser_MotorPwmTask, "motorPwm_task", USER_MOTORPWM_TASK_STACK_SIZE,
+                NULL, USER_MOTORPWM_TASK_PRIORITY, &motorPwmTask);
+
+    /* Create ledPwm Task */
+    xTaskCreate((TaskFunction_t) DjiUser_LedPwmTask, "ledPwm_task", USER_LEDPWM_TASK_STACK_SIZE,
+                NULL, USER_LEDPWM_TASK_PRIORITY, &ledPwmTask);
+
+    /* Start scheduler */
+    vTaskStartScheduler();
+
+    return 0;
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
@@ -0,0 +1,539 @@
+/**
+ ********************************************************************
+ * @file    media_catalog_bench.c
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   Host benchmark of the media catalog of camera_emu on a generated media directory of 10k photos and
+ *          videos: building the catalog, a file list request which gets information of every file, and pages of
+ *          the file list sorted by time. Also checks attributes read from the files, sort order, and that files
+ *          written, renamed and deleted after the build are followed by inotify and by explicit hooks.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <time.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "dji_logger.h"
+#include "dji_platform.h"
+#include "camera_emu/test_payload_cam_emu_media_catalog.h"
+
+/* Private constants ---------------------------------------------------------*/
+#define MEDIA_CATALOG_BENCH_FILE_NUM            10000
+//one video every few photos, like a survey flight
+#define MEDIA_CATALOG_BENCH_VIDEO_INTERVAL      5
+#define MEDIA_CATALOG_BENCH_PAGE_SIZE           50
+#define MEDIA_CATALOG_BENCH_EXIF_SIZE           2048
+#define MEDIA_CATALOG_BENCH_MDAT_SIZE           4096
+#define MEDIA_CATALOG_BENCH_FILE_SIZE_MAX       8192
+#define MEDIA_CATALOG_BENCH_PATH_SIZE           320
+//room for a file name after the directory
+#define MEDIA_CATALOG_BENCH_DIR_PATH_SIZE       256
+#define MEDIA_CATALOG_BENCH_TIME_BASE_S         1700000000
+//a photo written after the catalog is built
+#define MEDIA_CATALOG_BENCH_NEW_FILE_INDEX      (MEDIA_CATALOG_BENCH_FILE_NUM + 1)
+
+/* Private types -------------------------------------------------------------*/
+typedef struct {
+    uint16_t width;
+    uint16_t height;
+    E_DjiCameraVideoResolution resolution;
+} T_MediaCatalogBenchResolution;
+
+typedef struct {
+    uint32_t timescale;
+    uint32_t sampleDelta;
+    E_DjiCameraVideoFrameRate frameRate;
+} T_MediaCatalogBenchFrameRate;
+
+/* Private values -------------------------------------------------------------*/
+static const T_MediaCatalogBenchResolution s_benchResolution[] = {
+    {1920, 1080, DJI_CAMERA_VIDEO_RESOLUTION_1920x1080},
+    {3840, 2160, DJI_CAMERA_VIDEO_RESOLUTION_3840x2160},
+    {1280, 720,  DJI_CAMERA_VIDEO_RESOLUTION_1280x720},
+    {2720, 1530, DJI_CAMERA_VIDEO_RESOLUTION_UNKNOWN},
+};
+static const T_MediaCatalogBenchFrameRate s_benchFrameRate[] = {
+    {30000, 1001, DJI_CAMERA_VIDEO_FRAME_RATE_30_FPS},
+    {25,    1,    DJI_CAMERA_VIDEO_FRAME_RATE_25_FPS},
+    {24000, 1000, DJI_CAMERA_VIDEO_FRAME_RATE_24_FPS},
+};
+static T_DjiOsalHandler s_osalHandler = {0};
+
+/* Private functions declaration ---------------------------------------------*/
+static void *MediaCatalogBench_Malloc(uint32_t size);
+static void MediaCatalogBench_Free(void *ptr);
+static T_DjiReturnCode MediaCatalogBench_MutexCreate(T_DjiMutexHandle *mutex);
+static T_DjiReturnCode MediaCatalogBench_MutexDestroy(T_DjiMutexHandle mutex);
+static T_DjiReturnCode MediaCatalogBench_MutexLock(T_DjiMutexHandle mutex);
+static T_DjiReturnCode MediaCatalogBench_MutexUnlock(T_DjiMutexHandle mutex);
+static void MediaCatalogBench_GetFilePath(const char *dirPath, uint32_t index, char *path, uint32_t pathSize);
+static uint32_t MediaCatalogBench_MakePhoto(uint32_t index, uint8_t *data);
+static uint32_t MediaCatalogBench_MakeVideo(uint32_t index, uint8_t *data);
+static void MediaCatalogBench_PutU32(uint8_t *data, uint32_t value);
+static uint32_t MediaCatalogBench_BoxBegin(uint8_t *data, uint32_t *len, const char *type);
+static void MediaCatalogBench_BoxEnd(uint8_t *data, uint32_t len, uint32_t boxStart);
+static int MediaCatalogBench_WriteFile(const char *path, const uint8_t *data, uint32_t size, int64_t timeS);
+static int MediaCatalogBench_CheckFileInfo(uint32_t index, const T_TestPayloadCameraMediaCatalogFileInfo *fileInfo);
+static double MediaCatalogBench_GetMonotonicMs(void);
+
+/* Exported functions definition ---------------------------------------------*/
+T_DjiOsalHandler *DjiPlatform_GetOsalHandler(void)
+{
+    return &s_osalHandler;
+}
+
+void DjiLogger_UserLogOutput(E_DjiLoggerConsoleLogLevel level, const char *fmt, ...)
+{
+    va_list args;
+
+    if (level > DJI_LOGGER_CONSOLE_LOG_LEVEL_WARN) {
+        return;
+    }
+
+    va_start(args, fmt);
+    vfprintf(stderr, fmt, args);
+    fprintf(stderr, "\r\n");
+    va_end(args);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *dir = argc > 1 ? argv[1] : "/tmp";
+    static T_TestPayloadCameraMediaCatalogFileInfo page[MEDIA_CATALOG_BENCH_PAGE_SIZE];
+    static uint8_t data[MEDIA_CATALOG_BENCH_FILE_SIZE_MAX];
+    char dirPath[MEDIA_CATALOG_BENCH_DIR_PATH_SIZE];
+    char path[MEDIA_CATALOG_BENCH_PATH_SIZE];
+    char newPath[MEDIA_CATALOG_BENCH_PATH_SIZE];
+    T_TestPayloadCameraMediaCatalogFileInfo fileInfo;
+    uint32_t fileCount, totalFileCount, pageCount = 0;
+    int64_t lastTimeMs = INT64_MAX;
+    double startMs, pageMs, pageMaxMs = 0, pageTotalMs = 0;
+    double buildMs, listMs;
+    uint32_t size;
+    uint32_t offset;
+    int isFail = 0;
+    uint32_t i;
+
+    s_osalHandler.Malloc = MediaCatalogBench_Malloc;
+    s_osalHandler.Free = MediaCatalogBench_Free;
+    s_osalHandler.MutexCreate = MediaCatalogBench_MutexCreate;
+    s_osalHandler.MutexDestroy = MediaCatalogBench_MutexDestroy;
+    s_osalHandler.MutexLock = MediaCatalogBench_MutexLock;
+    s_osalHandler.MutexUnlock = MediaCatalogBench_MutexUnlock;
+
+    snprintf(dirPath, sizeof(dirPath), "%s/media_catalog_bench", dir);
+    mkdir(dirPath, 0755);
+
+    //files are written out of time order, caches of other modules are hidden files and are not media files
+    for (i = 0; i < MEDIA_CATALOG_BENCH_FILE_NUM; i++) {
+        MediaCatalogBench_GetFilePath(dirPath, i, path, sizeof(path));
+        size = i % MEDIA_CATALOG_BENCH_VIDEO_INTERVAL == 0 ? MediaCatalogBench_MakeVideo(i, data) :
+               MediaCatalogBench_MakePhoto(i, data);
+        if (MediaCatalogBench_WriteFile(path, data, size, MEDIA_CATALOG_BENCH_TIME_BASE_S +
+                                                          (i * 7919) % MEDIA_CATALOG_BENCH_FILE_NUM) != 0) {
+            printf("media catalog bench write %s error\r\n", path);
+            return 1;
+        }
+    }
+    snprintf(path, sizeof(path), "%s/.PSDK_00000.mp4.fidx", dirPath);
+    MediaCatalogBench_WriteFile(path, data, 16, MEDIA_CATALOG_BENCH_TIME_BASE_S);
+    snprintf(path, sizeof(path), "%s/.preview_cache", dirPath);
+    mkdir(path, 0755);
+
+    startMs = MediaCatalogBench_GetMonotonicMs();
+    if (DjiTest_MediaCatalogInit(dirPath) != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        printf("media catalog bench init error\r\n");
+        return 1;
+    }
+    buildMs = MediaCatalogBench_GetMonotonicMs() - startMs;
+
+    //file list request, file information of every file
+    startMs = MediaCatalogBench_GetMonotonicMs();
+    for (i = 0; i < MEDIA_CATALOG_BENCH_FILE_NUM; i++) {
+        MediaCatalogBench_GetFilePath(dirPath, i, path, sizeof(path));
+        if (DjiTest_MediaCatalogGetFileInfo(path, &fileInfo) != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+            printf("CHECK FAIL: %s is not in catalog\r\n", path);
+            isFail = 1;
+            break;
+        }
+        isFail |= MediaCatalogBench_CheckFileInfo(i, &fileInfo);
+    }
+    listMs = MediaCatalogBench_GetMonotonicMs() - startMs;
+
+    //whole list in pages from the newest file
+    for (offset = 0;; offset += fileCount) {
+        startMs = MediaCatalogBench_GetMonotonicMs();
+        DjiTest_MediaCatalogQuery(offset, MEDIA_CATALOG_BENCH_PAGE_SIZE, true, page, &fileCount, &totalFileCount);
+        pageMs = MediaCatalogBench_GetMonotonicMs() - startMs;
+        if (fileCount == 0) {
+            break;
+        }
+        pageTotalMs += pageMs;
+        pageMaxMs = pageMs > pageMaxMs ? pageMs : pageMaxMs;
+        pageCount++;
+        for (i = 0; i < fileCount; i++) {
+            if (page[i].createTimeMs > lastTimeMs) {
+                printf("CHECK FAIL: %s is out of time order\r\n", page[i].fileName);
+                isFail = 1;
+            }
+            lastTimeMs = page[i].createTimeMs;
+        }
+    }
+    if (offset != MEDIA_CATALOG_BENCH_FILE_NUM || totalFileCount != MEDIA_CATALOG_BENCH_FILE_NUM) {
+        printf("CHECK FAIL: %u files in pages, %u files in catalog\r\n", offset, totalFileCount);
+        isFail = 1;
+    }
+
+    printf("media catalog bench: %u files, %u videos\r\n", MEDIA_CATALOG_BENCH_FILE_NUM,
+           MEDIA_CATALOG_BENCH_FILE_NUM / MEDIA_CATALOG_BENCH_VIDEO_INTERVAL);
+    printf("build catalog from directory     %10.3f ms\r\n", buildMs);
+    printf("file list request, every file    %10.3f ms\r\n", listMs);
+    printf("file list page of %u, average    %10.3f ms\r\n", MEDIA_CATALOG_BENCH_PAGE_SIZE,
+           pageTotalMs / pageCount);
+    printf("file list page of %u, max        %10.3f ms\r\n", MEDIA_CATALOG_BENCH_PAGE_SIZE, pageMaxMs);
+
+    //a new file, the newest one, is added by inotify on Linux, by the hook otherwise
+    MediaCatalogBench_GetFilePath(dirPath, MEDIA_CATALOG_BENCH_NEW_FILE_INDEX, path, sizeof(path));
+    size = MediaCatalogBench_MakePhoto(MEDIA_CATALOG_BENCH_NEW_FILE_INDEX, data);
+    MediaCatalogBench_WriteFile(path, data, size, MEDIA_CATALOG_BENCH_TIME_BASE_S + MEDIA_CATALOG_BENCH_NEW_FILE_INDEX);
+#ifndef SYSTEM_ARCH_LINUX
+    DjiTest_MediaCatalogAddFile(path);
+#endif
+    DjiTest_MediaCatalogQuery(0, 1, true, page, &fileCount, &totalFileCount);
+    if (fileCount != 1 || strcmp(page[0].fileName, strrchr(path, '/') + 1) != 0 ||
+        totalFileCount != MEDIA_CATALOG_BENCH_FILE_NUM + 1) {
+        printf("CHECK FAIL: new file is not the newest in catalog\r\n");
+        isFail = 1;
+    }
+
+    //renamed file
+    snprintf(newPath, sizeof(newPath), "%s/PSDK_RENAMED.jpg", dirPath);
+    rename(path, newPath);
+#ifndef SYSTEM_ARCH_LINUX
+    DjiTest_MediaCatalogRemoveFile(path);
+    DjiTest_MediaCatalogAddFile(newPath);
+#endif
+    if (DjiTest_MediaCatalogGetFileInfo(path, &fileInfo) == DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS ||
+        DjiTest_MediaCatalogGetFileInfo(newPath, &fileInfo) != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS ||
+        MediaCatalogBench_CheckFileInfo(MEDIA_CATALOG_BENCH_NEW_FILE_INDEX, &fileInfo) != 0) {
+        printf("CHECK FAIL: renamed file\r\n");
+        isFail = 1;
+    }
+
+    //deleted file
+    remove(newPath);
+#ifndef SYSTEM_ARCH_LINUX
+    DjiTest_MediaCatalogRemoveFile(newPath);
+#endif
+    DjiTest_MediaCatalogQuery(0, 1, true, page, &fileCount, &totalFileCount);
+    if (DjiTest_MediaCatalogGetFileInfo(newPath, &fileInfo) == DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS ||
+        totalFileCount != MEDIA_CATALOG_BENCH_FILE_NUM) {
+        printf("CHECK FAIL: deleted file\r\n");
+        isFail = 1;
+    }
+
+    //explicit hooks, as called on RTOS, agree with the directory
+    MediaCatalogBench_GetFilePath(dirPath, 0, path, sizeof(path));
+    if (DjiTest_MediaCatalogRemoveFile(path) != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS ||
+        DjiTest_MediaCatalogGetFileInfo(path, &fileInfo) == DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS ||
+        DjiTest_MediaCatalogAddFile(path) != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS ||
+        DjiTest_MediaCatalogGetFileInfo(path, &fileInfo) != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS ||
+        MediaCatalogBench_CheckFileInfo(0, &fileInfo) != 0) {
+        printf("CHECK FAIL: explicit hooks\r\n");
+        isFail = 1;
+    }
+    DjiTest_MediaCatalogQuery(MEDIA_CATALOG_BENCH_FILE_NUM, 1, false, page, &fileCount, &totalFileCount);
+    if (fileCount != 0 || totalFileCount != MEDIA_CATALOG_BENCH_FILE_NUM) {
+        printf("CHECK FAIL: page after the last file\r\n");
+        isFail = 1;
+    }
+
+    DjiTest_MediaCatalogDeInit();
+
+    for (i = 0; i < MEDIA_CATALOG_BENCH_FILE_NUM; i++) {
+        MediaCatalogBench_GetFilePath(dirPath, i, path, sizeof(path));
+        remove(path);
+    }
+    snprintf(path, sizeof(path), "%s/.PSDK_00000.mp4.fidx", dirPath);
+    remove(path);
+    snprintf(path, sizeof(path), "%s/.preview_cache", dirPath);
+    rmdir(path);
+    rmdir(dirPath);
+
+    printf("%s\r\n", isFail ? "CHECK FAIL" : "CHECK PASS");
+
+    return isFail;
+}
+
+/* Private functions definition-----------------------------------------------*/
+static void *MediaCatalogBench_Malloc(uint32_t size)
+{
+    return malloc(size);
+}
+
+static void MediaCatalogBench_Free(void *ptr)
+{
+    free(ptr);
+}
+
+static T_DjiReturnCode MediaCatalogBench_MutexCreate(T_DjiMutexHandle *mutex)
+{
+    pthread_mutex_t *pthreadMutex = malloc(sizeof(pthread_mutex_t));
+
+    if (pthreadMutex == NULL) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_MEMORY_ALLOC_FAILED;
+    }
+    pthread_mutex_init(pthreadMutex, NULL);
+    *mutex = pthreadMutex;
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+static T_DjiReturnCode MediaCatalogBench_MutexDestroy(T_DjiMutexHandle mutex)
+{
+    pthread_mutex_destroy(mutex);
+    free(mutex);
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+static T_DjiReturnCode MediaCatalogBench_MutexLock(T_DjiMutexHandle mutex)
+{
+    pthread_mutex_lock(mutex);
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+static T_DjiReturnCode MediaCatalogBench_MutexUnlock(T_DjiMutexHandle mutex)
+{
+    pthread_mutex_unlock(mutex);
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+static void MediaCatalogBench_GetFilePath(const char *dirPath, uint32_t index, char *path, uint32_t pathSize)
+{
+    snprintf(path, pathSize, "%s/PSDK_%05u.%s", dirPath, index,
+             index % MEDIA_CATALOG_BENCH_VIDEO_INTERVAL == 0 ? "mp4" : "jpg");
+}
+
+// SOI, Exif APP1 of filler, SOF0 and EOI, the catalog reads no further than SOF
+static uint32_t MediaCatalogBench_MakePhoto(uint32_t index, uint8_t *data)
+{
+    uint16_t width = index % 2 == 0 ? 4000 : 5280;
+    uint16_t height = index % 2 == 0 ? 3000 : 3956;
+    uint32_t len = 0;
+
+    data[len++] = 0xFF;
+    data[len++] = 0xD8;
+    data[len++] = 0xFF;
+    data[len++] = 0xE1;
+    data[len++] = (uint8_t) ((MEDIA_CATALOG_BENCH_EXIF_SIZE + 2) >> 8);
+    data[len++] = (uint8_t) (MEDIA_CATALOG_BENCH_EXIF_SIZE + 2);
+    memset(&data[len], 0, MEDIA_CATALOG_BENCH_EXIF_SIZE);
+    memcpy(&data[len], "Exif\0\0", 6);
+    len += MEDIA_CATALOG_BENCH_EXIF_SIZE;
+
+    data[len++] = 0xFF;
+    data[len++] = 0xC0;
+    data[len++] = 0x00;
+    data[len++] = 17;
+    data[len++] = 8;
+    data[len++] = (uint8_t) (height >> 8);
+    data[len++] = (uint8_t) height;
+    data[len++] = (uint8_t) (width >> 8);
+    data[len++] = (uint8_t) width;
+    data[len++] = 3;
+    memset(&data[len], 0x11, 9);
+    len += 9;
+
+    data[len++] = 0xFF;
+    data[len++] = 0xD9;
+
+    return len;
+}
+
+// ftyp, mdat, then moov of mvhd and one video trak, as a camera writes it
+static uint32_t MediaCatalogBench_MakeVideo(uint32_t index, uint8_t *data)
+{
+    const T_MediaCatalogBenchResolution *resolution = &s_benchResolution[(index / MEDIA_CATALOG_BENCH_VIDEO_INTERVAL) %
+                                                                         (sizeof(s_benchResolution) /
+                                                                          sizeof(s_benchResolution[0]))];
+    const T_MediaCatalogBenchFrameRate *frameRate = &s_benchFrameRate[(index / MEDIA_CATALOG_BENCH_VIDEO_INTERVAL) %
+                                                                      (sizeof(s_benchFrameRate) /
+                                                                       sizeof(s_benchFrameRate[0]))];
+    uint32_t durationS = 10 + index % 590;
+    uint32_t sampleNum = (uint32_t) ((uint64_t) durationS * frameRate->timescale / frameRate->sampleDelta);
+    uint32_t moov, trak, mdia, minf, stbl, box;
+    uint32_t len = 0;
+
+    box = MediaCatalogBench_BoxBegin(data, &len, "ftyp");
+    memcpy(&data[len], "isom\0\0\0\0isom", 12);
+    len += 12;
+    MediaCatalogBench_BoxEnd(data, len, box);
+
+    box = MediaCatalogBench_BoxBegin(data, &len, "mdat");
+    memset(&data[len], 0, MEDIA_CATALOG_BENCH_MDAT_SIZE);
+    len += MEDIA_CATALOG_BENCH_MDAT_SIZE;
+    MediaCatalogBench_BoxEnd(data, len, box);
+
+    moov = MediaCatalogBench_BoxBegin(data, &len, "moov");
+    box = MediaCatalogBench_BoxBegin(data, &len, "mvhd");
+    memset(&data[len], 0, 100);
+    MediaCatalogBench_PutU32(&data[len + 12], 1000);
+    MediaCatalogBench_PutU32(&data[len + 16], durationS * 1000);
+    len += 100;
+    MediaCatalogBench_BoxEnd(data, len, box);
+
+    trak = MediaCatalogBench_BoxBegin(data, &len, "trak");
+    box = MediaCatalogBench_BoxBegin(data, &len, "tkhd");
+    memset(&data[len], 0, 84);
+    MediaCatalogBench_PutU32(&data[len + 76], (uint32_t) resolution->width << 16);
+    MediaCatalogBench_PutU32(&data[len + 80], (uint32_t) resolution->height << 16);
+    len += 84;
+    MediaCatalogBench_BoxEnd(data, len, box);
+
+    mdia = MediaCatalogBench_BoxBegin(data, &len, "mdia");
+    box = MediaCatalogBench_BoxBegin(data, &len, "mdhd");
+    memset(&data[len], 0, 24);
+    MediaCatalogBench_PutU32(&data[len + 12], frameRate->timescale);
+    MediaCatalogBench_PutU32(&data[len + 16], sampleNum * frameRate->sampleDelta);
+    len += 24;
+    MediaCatalogBench_BoxEnd(data, len, box);
+    box = MediaCatalogBench_BoxBegin(data, &len, "hdlr");
+    memset(&data[len], 0, 25);
+    memcpy(&data[len + 8], "vide", 4);
+    len += 25;
+    MediaCatalogBench_BoxEnd(data, len, box);
+
+    minf = MediaCatalogBench_BoxBegin(data, &len, "minf");
+    stbl = MediaCatalogBench_BoxBegin(data, &len, "stbl");
+    box = MediaCatalogBench_BoxBegin(data, &len, "stts");
+    MediaCatalogBench_PutU32(&data[len], 0);
+    MediaCatalogBench_PutU32(&data[len + 4], 1);
+    MediaCatalogBench_PutU32(&data[len + 8], sampleNum);
+    MediaCatalogBench_PutU32(&data[len + 12], frameRate->sampleDelta);
+    len += 16;
+    MediaCatalogBench_BoxEnd(data, len, box);
+    MediaCatalogBench_BoxEnd(data, len, stbl);
+    MediaCatalogBench_BoxEnd(data, len, minf);
+    MediaCatalogBench_BoxEnd(data, len, mdia);
+    MediaCatalogBench_BoxEnd(data, len, trak);
+    MediaCatalogBench_BoxEnd(data, len, moov);
+
+    return len;
+}
+
+static void MediaCatalogBench_PutU32(uint8_t *data, uint32_t value)
+{
+    data[0] = (uint8_t) (value >> 24);
+    data[1] = (uint8_t) (value >> 16);
+    data[2] = (uint8_t) (value >> 8);
+    data[3] = (uint8_t) value;
+}
+
+static uint32_t MediaCatalogBench_BoxBegin(uint8_t *data, uint32_t *len, const char *type)
+{
+    uint32_t boxStart = *len;
+
+    memcpy(&data[boxStart + 4], type, 4);
+    *len += 8;
+
+    return boxStart;
+}
+
+static void MediaCatalogBench_BoxEnd(uint8_t *data, uint32_t len, uint32_t boxStart)
+{
+    MediaCatalogBench_PutU32(&data[boxStart], len - boxStart);
+}
+
+static int MediaCatalogBench_WriteFile(const char *path, const uint8_t *data, uint32_t size, int64_t timeS)
+{
+    struct timespec modifyTime[2];
+    FILE *file = fopen(path, "wb");
+
+    if (file == NULL) {
+        return -1;
+    }
+    if (fwrite(data, 1, size, file) != size) {
+        fclose(file);
+        return -1;
+    }
+    if (fclose(file) != 0) {
+        return -1;
+    }
+
+    modifyTime[0].tv_sec = 0;
+    modifyTime[0].tv_nsec = UTIME_OMIT;
+    modifyTime[1].tv_sec = timeS;
+    modifyTime[1].tv_nsec = 0;
+
+    return utimensat(AT_FDCWD, path, modifyTime, 0);
+}
+
+static int MediaCatalogBench_CheckFileInfo(uint32_t index, const T_TestPayloadCameraMediaCatalogFileInfo *fileInfo)
+{
+    const T_MediaCatalogBenchResolution *resolution = &s_benchResolution[(index / MEDIA_CATALOG_BENCH_VIDEO_INTERVAL) %
+                                                                         (sizeof(s_benchResolution) /
+                                                                          sizeof(s_benchResolution[0]))];
+    const T_MediaCatalogBenchFrameRate *frameRate = &s_benchFrameRate[(index / MEDIA_CATALOG_BENCH_VIDEO_INTERVAL) %
+                                                                      (sizeof(s_benchFrameRate) /
+                                                                       sizeof(s_benchFrameRate[0]))];
+    uint32_t durationS = 10 + index % 590;
+    bool isVideo = index % MEDIA_CATALOG_BENCH_VIDEO_INTERVAL == 0;
+
+    if (isVideo && (fileInfo->type != DJI_CAMERA_FILE_TYPE_MP4 ||
+                    fileInfo->mediaFileAttr.attrVideoDuration != durationS ||
+                    fileInfo->durationMs != durationS * 1000 ||
+                    fileInfo->width != resolution->width || fileInfo->height != resolution->height ||
+                    fileInfo->mediaFileAttr.attrVideoResolution != resolution->resolution ||
+                    fileInfo->mediaFileAttr.attrVideoFrameRate != frameRate->frameRate)) {
+        printf("CHECK FAIL: video %s, %ux%u %u ms, resolution %u frame rate %u\r\n", fileInfo->fileName,
+               fileInfo->width, fileInfo->height, fileInfo->durationMs, fileInfo->mediaFileAttr.attrVideoResolution,
+               fileInfo->mediaFileAttr.attrVideoFrameRate);
+        return 1;
+    }
+    if (!isVideo && (fileInfo->type != DJI_CAMERA_FILE_TYPE_JPEG ||
+                     fileInfo->width != (index % 2 == 0 ? 4000 : 5280) ||
+                     fileInfo->height != (index % 2 == 0 ? 3000 : 3956) || fileInfo->durationMs != 0)) {
+        printf("CHECK FAIL: photo %s, %ux%u\r\n", fileInfo->fileName, fileInfo->width, fileInfo->height);
+        return 1;
+    }
+
+    return 0;
+}
+
+static double MediaCatalogBench_GetMonotonicMs(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return now.tv_sec * 1000.0 + now.tv_nsec / 1000000.0;
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
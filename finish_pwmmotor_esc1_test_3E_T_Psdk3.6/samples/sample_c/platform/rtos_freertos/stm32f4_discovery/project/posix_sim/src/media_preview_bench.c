@@ -0,0 +1,540 @@
+/**
+ ********************************************************************
+ * @file    media_preview_bench.c
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   Host benchmark of thumbnails and screennails of camera_emu on a generated media directory, like a pilot
+ *          browsing the album: cold start makes every preview, then browsing again is served by the memory cache,
+ *          and after a restart by the disk cache. Also checks size of previews, and that previews of a modified
+ *          or removed file are not used.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <time.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include "dji_logger.h"
+#include "dji_platform.h"
+#include "camera_emu/dji_media_file_manage/dji_media_file_jpg_codec.h"
+#include "camera_emu/dji_media_file_manage/dji_media_file_preview.h"
+
+/* Private constants ---------------------------------------------------------*/
+//photos with an Exif thumbnail, as taken by a camera
+#define MEDIA_PREVIEW_BENCH_EXIF_FILE_NUM           1000
+#define MEDIA_PREVIEW_BENCH_EXIF_WIDTH              1920
+#define MEDIA_PREVIEW_BENCH_EXIF_HEIGHT             1080
+#define MEDIA_PREVIEW_BENCH_EXIF_THUMBNAIL_WIDTH    160
+#define MEDIA_PREVIEW_BENCH_EXIF_THUMBNAIL_HEIGHT   90
+//only the head of these files is read, a smooth main picture keeps the directory small
+#define MEDIA_PREVIEW_BENCH_EXIF_NOISE              2
+//photos without Exif thumbnail, the main picture is decoded
+#define MEDIA_PREVIEW_BENCH_MAIN_FILE_NUM           10
+#define MEDIA_PREVIEW_BENCH_MAIN_WIDTH              4000
+#define MEDIA_PREVIEW_BENCH_MAIN_HEIGHT             3000
+#define MEDIA_PREVIEW_BENCH_MAIN_NOISE              24
+#define MEDIA_PREVIEW_BENCH_QUALITY                 90
+//same as test_payload_cam_emu_media.c
+#define MEDIA_PREVIEW_BENCH_MEMORY_CACHE_SIZE_MAX   (8 * 1024 * 1024)
+//payload camera downloads a file in pieces of this size
+#define MEDIA_PREVIEW_BENCH_READ_LEN                1024
+#define MEDIA_PREVIEW_BENCH_PATH_SIZE               512
+//room for a file name after the directory
+#define MEDIA_PREVIEW_BENCH_DIR_PATH_SIZE           448
+
+/* Private types -------------------------------------------------------------*/
+typedef struct {
+    double totalMs;
+    double maxMs;
+    uint32_t count;
+    uint32_t totalSize;
+} T_MediaPreviewBenchResult;
+
+/* Private values -------------------------------------------------------------*/
+static T_DjiOsalHandler s_osalHandler = {0};
+static uint32_t s_seed = 1;
+
+/* Private functions declaration ---------------------------------------------*/
+static void *MediaPreviewBench_Malloc(uint32_t size);
+static void MediaPreviewBench_Free(void *ptr);
+static T_DjiReturnCode MediaPreviewBench_MutexCreate(T_DjiMutexHandle *mutex);
+static T_DjiReturnCode MediaPreviewBench_MutexDestroy(T_DjiMutexHandle mutex);
+static T_DjiReturnCode MediaPreviewBench_MutexLock(T_DjiMutexHandle mutex);
+static T_DjiReturnCode MediaPreviewBench_MutexUnlock(T_DjiMutexHandle mutex);
+static uint32_t MediaPreviewBench_Random(void);
+static int MediaPreviewBench_MakePicture(uint16_t width, uint16_t height, uint32_t noise, uint8_t **data,
+                                         uint32_t *size);
+static int MediaPreviewBench_MakePhoto(uint16_t width, uint16_t height, uint32_t noise, bool isWithThumbnail,
+                                       uint8_t **data, uint32_t *size);
+static int MediaPreviewBench_WriteFile(const char *path, const uint8_t *data, uint32_t size);
+static int MediaPreviewBench_Browse(char (*path)[MEDIA_PREVIEW_BENCH_PATH_SIZE], uint32_t fileNum,
+                                    E_DjiMediaFilePreviewType type, T_MediaPreviewBenchResult *result);
+static void MediaPreviewBench_Print(const char *name, const T_MediaPreviewBenchResult *result);
+static double MediaPreviewBench_GetMonotonicMs(void);
+
+/* Exported functions definition ---------------------------------------------*/
+T_DjiOsalHandler *DjiPlatform_GetOsalHandler(void)
+{
+    return &s_osalHandler;
+}
+
+void DjiLogger_UserLogOutput(E_DjiLoggerConsoleLogLevel level, const char *fmt, ...)
+{
+    va_list args;
+
+    if (level > DJI_LOGGER_CONSOLE_LOG_LEVEL_WARN) {
+        return;
+    }
+
+    va_start(args, fmt);
+    vfprintf(stderr, fmt, args);
+    fprintf(stderr, "\r\n");
+    va_end(args);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *dir = argc > 1 ? argv[1] : "/tmp";
+    static char exifPath[MEDIA_PREVIEW_BENCH_EXIF_FILE_NUM][MEDIA_PREVIEW_BENCH_PATH_SIZE];
+    static char mainPath[MEDIA_PREVIEW_BENCH_MAIN_FILE_NUM][MEDIA_PREVIEW_BENCH_PATH_SIZE];
+    char mediaDirPath[MEDIA_PREVIEW_BENCH_DIR_PATH_SIZE];
+    char cacheDirPath[MEDIA_PREVIEW_BENCH_PATH_SIZE];
+    T_DjiMediaFilePreviewConfig config;
+    T_DjiMediaFilePreviewStatistics statistics;
+    T_DjiMediaFilePreview *preview;
+    T_MediaPreviewBenchResult result;
+    uint16_t width, height;
+    uint8_t *exifPhoto = NULL;
+    uint8_t *mainPhoto = NULL;
+    uint32_t exifPhotoSize, mainPhotoSize;
+    uint32_t generateCount;
+    struct timespec modifyTime[2];
+    int isFail = 0;
+    uint32_t i;
+
+    s_osalHandler.Malloc = MediaPreviewBench_Malloc;
+    s_osalHandler.Free = MediaPreviewBench_Free;
+    s_osalHandler.MutexCreate = MediaPreviewBench_MutexCreate;
+    s_osalHandler.MutexDestroy = MediaPreviewBench_MutexDestroy;
+    s_osalHandler.MutexLock = MediaPreviewBench_MutexLock;
+    s_osalHandler.MutexUnlock = MediaPreviewBench_MutexUnlock;
+
+    snprintf(mediaDirPath, sizeof(mediaDirPath), "%s/media_preview_bench", dir);
+    snprintf(cacheDirPath, sizeof(cacheDirPath), "%s/.preview_cache", mediaDirPath);
+    mkdir(mediaDirPath, 0755);
+
+    if (MediaPreviewBench_MakePhoto(MEDIA_PREVIEW_BENCH_EXIF_WIDTH, MEDIA_PREVIEW_BENCH_EXIF_HEIGHT,
+                                    MEDIA_PREVIEW_BENCH_EXIF_NOISE, true, &exifPhoto, &exifPhotoSize) != 0 ||
+        MediaPreviewBench_MakePhoto(MEDIA_PREVIEW_BENCH_MAIN_WIDTH, MEDIA_PREVIEW_BENCH_MAIN_HEIGHT,
+                                    MEDIA_PREVIEW_BENCH_MAIN_NOISE, false, &mainPhoto, &mainPhotoSize) != 0) {
+        printf("media preview bench make photo error\r\n");
+        return 1;
+    }
+
+    for (i = 0; i < MEDIA_PREVIEW_BENCH_EXIF_FILE_NUM; i++) {
+        snprintf(exifPath[i], sizeof(exifPath[i]), "%s/PSDK_%04u.jpg", mediaDirPath, i);
+        if (MediaPreviewBench_WriteFile(exifPath[i], exifPhoto, exifPhotoSize) != 0) {
+            printf("media preview bench write %s error\r\n", exifPath[i]);
+            return 1;
+        }
+    }
+    for (i = 0; i < MEDIA_PREVIEW_BENCH_MAIN_FILE_NUM; i++) {
+        snprintf(mainPath[i], sizeof(mainPath[i]), "%s/PSDK_MAIN_%02u.jpg", mediaDirPath, i);
+        if (MediaPreviewBench_WriteFile(mainPath[i], mainPhoto, mainPhotoSize) != 0) {
+            printf("media preview bench write %s error\r\n", mainPath[i]);
+            return 1;
+        }
+    }
+
+    //previous runs must not be hit
+    config.memoryCacheSizeMax = MEDIA_PREVIEW_BENCH_MEMORY_CACHE_SIZE_MAX;
+    config.diskCacheDirPath = cacheDirPath;
+    DjiMediaFile_PreviewInit(&config);
+    for (i = 0; i < MEDIA_PREVIEW_BENCH_EXIF_FILE_NUM; i++) {
+        DjiMediaFile_PreviewRemove(exifPath[i]);
+    }
+    for (i = 0; i < MEDIA_PREVIEW_BENCH_MAIN_FILE_NUM; i++) {
+        DjiMediaFile_PreviewRemove(mainPath[i]);
+    }
+    DjiMediaFile_PreviewDeInit();
+
+    printf("media preview bench: %u photos of %ux%u with %ux%u Exif thumbnail, %u KB each\r\n",
+           MEDIA_PREVIEW_BENCH_EXIF_FILE_NUM, MEDIA_PREVIEW_BENCH_EXIF_WIDTH, MEDIA_PREVIEW_BENCH_EXIF_HEIGHT,
+           MEDIA_PREVIEW_BENCH_EXIF_THUMBNAIL_WIDTH, MEDIA_PREVIEW_BENCH_EXIF_THUMBNAIL_HEIGHT, exifPhotoSize / 1024);
+    printf("                     %u photos of %ux%u without Exif thumbnail, %u KB each\r\n",
+           MEDIA_PREVIEW_BENCH_MAIN_FILE_NUM, MEDIA_PREVIEW_BENCH_MAIN_WIDTH, MEDIA_PREVIEW_BENCH_MAIN_HEIGHT,
+           mainPhotoSize / 1024);
+    printf("%-36s %10s %10s %10s\r\n", "case", "avg ms", "max ms", "avg bytes");
+
+    //cache disabled, every preview is made
+    MediaPreviewBench_Browse(mainPath, MEDIA_PREVIEW_BENCH_MAIN_FILE_NUM, DJI_MEDIA_FILE_PREVIEW_TYPE_THUMBNAIL,
+                             &result);
+    MediaPreviewBench_Print("thumbnail, main picture, no cache", &result);
+    MediaPreviewBench_Browse(mainPath, MEDIA_PREVIEW_BENCH_MAIN_FILE_NUM, DJI_MEDIA_FILE_PREVIEW_TYPE_SCREENNAIL,
+                             &result);
+    MediaPreviewBench_Print("screennail, main picture, no cache", &result);
+
+    if (DjiMediaFile_PreviewInit(&config) != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        printf("media preview bench init error\r\n");
+        return 1;
+    }
+
+    isFail |= MediaPreviewBench_Browse(exifPath, MEDIA_PREVIEW_BENCH_EXIF_FILE_NUM,
+                                       DJI_MEDIA_FILE_PREVIEW_TYPE_THUMBNAIL, &result);
+    MediaPreviewBench_Print("thumbnail, Exif, cold", &result);
+    isFail |= MediaPreviewBench_Browse(exifPath, MEDIA_PREVIEW_BENCH_EXIF_FILE_NUM,
+                                       DJI_MEDIA_FILE_PREVIEW_TYPE_THUMBNAIL, &result);
+    MediaPreviewBench_Print("thumbnail, Exif, memory cache", &result);
+    isFail |= MediaPreviewBench_Browse(mainPath, MEDIA_PREVIEW_BENCH_MAIN_FILE_NUM,
+                                       DJI_MEDIA_FILE_PREVIEW_TYPE_SCREENNAIL, &result);
+    MediaPreviewBench_Print("screennail, main picture, cold", &result);
+    isFail |= MediaPreviewBench_Browse(mainPath, MEDIA_PREVIEW_BENCH_MAIN_FILE_NUM,
+                                       DJI_MEDIA_FILE_PREVIEW_TYPE_SCREENNAIL, &result);
+    MediaPreviewBench_Print("screennail, main picture, memory", &result);
+
+    DjiMediaFile_PreviewGetStatistics(&statistics);
+    if (statistics.memoryCacheSize > MEDIA_PREVIEW_BENCH_MEMORY_CACHE_SIZE_MAX ||
+        statistics.generateCount != MEDIA_PREVIEW_BENCH_EXIF_FILE_NUM + MEDIA_PREVIEW_BENCH_MAIN_FILE_NUM) {
+        printf("CHECK FAIL: %u previews made, memory cache %u bytes\r\n", statistics.generateCount,
+               statistics.memoryCacheSize);
+        isFail = 1;
+    }
+    printf("memory cache: %u previews, %u KB\r\n", statistics.memoryCacheItemCount,
+           statistics.memoryCacheSize / 1024);
+
+    //restart, memory cache is empty and previews are loaded from disk
+    DjiMediaFile_PreviewDeInit();
+    DjiMediaFile_PreviewInit(&config);
+    isFail |= MediaPreviewBench_Browse(exifPath, MEDIA_PREVIEW_BENCH_EXIF_FILE_NUM,
+                                       DJI_MEDIA_FILE_PREVIEW_TYPE_THUMBNAIL, &result);
+    MediaPreviewBench_Print("thumbnail, Exif, disk cache", &result);
+    isFail |= MediaPreviewBench_Browse(mainPath, MEDIA_PREVIEW_BENCH_MAIN_FILE_NUM,
+                                       DJI_MEDIA_FILE_PREVIEW_TYPE_SCREENNAIL, &result);
+    MediaPreviewBench_Print("screennail, main picture, disk cache", &result);
+
+    DjiMediaFile_PreviewGetStatistics(&statistics);
+    if (statistics.generateCount != 0) {
+        printf("CHECK FAIL: %u previews made after restart\r\n", statistics.generateCount);
+        isFail = 1;
+    }
+
+    //thumbnail of a modified photo is made again from both caches
+    generateCount = statistics.generateCount;
+    modifyTime[0].tv_sec = 0;
+    modifyTime[0].tv_nsec = UTIME_OMIT;
+    modifyTime[1].tv_sec = time(NULL) + 10;
+    modifyTime[1].tv_nsec = 0;
+    utimensat(AT_FDCWD, exifPath[0], modifyTime, 0);
+    if (DjiMediaFile_PreviewCreate(exifPath[0], DJI_MEDIA_FILE_PREVIEW_SOURCE_JPG,
+                                   DJI_MEDIA_FILE_PREVIEW_TYPE_THUMBNAIL, &preview) !=
+        DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        printf("CHECK FAIL: thumbnail of modified photo\r\n");
+        isFail = 1;
+    } else {
+        DjiMediaFile_PreviewDestroy(preview);
+    }
+    DjiMediaFile_PreviewGetStatistics(&statistics);
+    if (statistics.generateCount != generateCount + 1) {
+        printf("CHECK FAIL: thumbnail of modified photo is from cache\r\n");
+        isFail = 1;
+    }
+
+    //previews of a removed photo are dropped
+    generateCount = statistics.generateCount;
+    DjiMediaFile_PreviewRemove(exifPath[1]);
+    DjiMediaFile_PreviewDeInit();
+    DjiMediaFile_PreviewInit(&config);
+    DjiMediaFile_PreviewCreate(exifPath[1], DJI_MEDIA_FILE_PREVIEW_SOURCE_JPG,
+                               DJI_MEDIA_FILE_PREVIEW_TYPE_THUMBNAIL, &preview);
+    if (preview != NULL) {
+        if (DjiMediaFile_JpgGetImageSize(preview->data, preview->size, &width, &height) !=
+            DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS || width != DJI_MEDIA_FILE_PREVIEW_THUMBNAIL_WIDTH) {
+            printf("CHECK FAIL: thumbnail of removed photo\r\n");
+            isFail = 1;
+        }
+        DjiMediaFile_PreviewDestroy(preview);
+    }
+    DjiMediaFile_PreviewGetStatistics(&statistics);
+    if (statistics.generateCount != 1) {
+        printf("CHECK FAIL: thumbnail of removed photo is from cache\r\n");
+        isFail = 1;
+    }
+    DjiMediaFile_PreviewDeInit();
+
+    for (i = 0; i < MEDIA_PREVIEW_BENCH_EXIF_FILE_NUM; i++) {
+        remove(exifPath[i]);
+    }
+    for (i = 0; i < MEDIA_PREVIEW_BENCH_MAIN_FILE_NUM; i++) {
+        remove(mainPath[i]);
+    }
+    free(exifPhoto);
+    free(mainPhoto);
+
+    printf("%s\r\n", isFail ? "CHECK FAIL" : "CHECK PASS");
+
+    return isFail;
+}
+
+/* Private functions definition-----------------------------------------------*/
+static void *MediaPreviewBench_Malloc(uint32_t size)
+{
+    return malloc(size);
+}
+
+static void MediaPreviewBench_Free(void *ptr)
+{
+    free(ptr);
+}
+
+static T_DjiReturnCode MediaPreviewBench_MutexCreate(T_DjiMutexHandle *mutex)
+{
+    pthread_mutex_t *pthreadMutex = malloc(sizeof(pthread_mutex_t));
+
+    if (pthreadMutex == NULL) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_MEMORY_ALLOC_FAILED;
+    }
+    pthread_mutex_init(pthreadMutex, NULL);
+    *mutex = pthreadMutex;
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+static T_DjiReturnCode MediaPreviewBench_MutexDestroy(T_DjiMutexHandle mutex)
+{
+    pthread_mutex_destroy(mutex);
+    free(mutex);
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+static T_DjiReturnCode MediaPreviewBench_MutexLock(T_DjiMutexHandle mutex)
+{
+    pthread_mutex_lock(mutex);
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+static T_DjiReturnCode MediaPreviewBench_MutexUnlock(T_DjiMutexHandle mutex)
+{
+    pthread_mutex_unlock(mutex);
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+static uint32_t MediaPreviewBench_Random(void)
+{
+    s_seed = s_seed * 1103515245 + 12345;
+
+    return s_seed >> 8;
+}
+
+// smooth color gradients with some noise, so the picture costs like a photo in Huffman decoding
+static int MediaPreviewBench_MakePicture(uint16_t width, uint16_t height, uint32_t noise, uint8_t **data,
+                                         uint32_t *size)
+{
+    T_DjiMediaFileImage image;
+    uint8_t *pixel;
+    uint32_t x, y;
+    int ret;
+
+    image.width = width;
+    image.height = height;
+    image.componentNum = DJI_MEDIA_FILE_IMAGE_COMPONENT_NUM_RGB;
+    image.pixels = malloc((size_t) width * height * DJI_MEDIA_FILE_IMAGE_COMPONENT_NUM_RGB);
+    if (image.pixels == NULL) {
+        return -1;
+    }
+
+    pixel = image.pixels;
+    for (y = 0; y < height; y++) {
+        for (x = 0; x < width; x++) {
+            pixel[0] = (uint8_t) (x * 255 / width + MediaPreviewBench_Random() % noise);
+            pixel[1] = (uint8_t) (y * 255 / height + MediaPreviewBench_Random() % noise);
+            pixel[2] = (uint8_t) (((x + y) / 8) % 256);
+            pixel += DJI_MEDIA_FILE_IMAGE_COMPONENT_NUM_RGB;
+        }
+    }
+
+    ret = DjiMediaFile_JpgEncode(&image, MEDIA_PREVIEW_BENCH_QUALITY, data, size) ==
+          DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS ? 0 : -1;
+    free(image.pixels);
+
+    return ret;
+}
+
+// JPEG file of the main picture, with an Exif APP1 segment of big endian TIFF holding an empty IFD0 and an IFD1 of
+// the thumbnail, like the ones of DJI cameras
+static int MediaPreviewBench_MakePhoto(uint16_t width, uint16_t height, uint32_t noise, bool isWithThumbnail,
+                                       uint8_t **data, uint32_t *size)
+{
+    static const uint8_t tiffHead[] = {
+        'M', 'M', 0x00, 0x2A, 0x00, 0x00, 0x00, 0x08,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x0E,
+        0x00, 0x02,
+        0x02, 0x01, 0x00, 0x04, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x2C,
+        0x02, 0x02, 0x00, 0x04, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+    };
+    uint8_t *mainData = NULL;
+    uint8_t *thumbnailData = NULL;
+    uint32_t mainSize, thumbnailSize = 0;
+    uint32_t segmentLen;
+    uint8_t *photo;
+
+    if (MediaPreviewBench_MakePicture(width, height, noise, &mainData, &mainSize) != 0) {
+        return -1;
+    }
+    if (!isWithThumbnail) {
+        *data = mainData;
+        *size = mainSize;
+        return 0;
+    }
+
+    if (MediaPreviewBench_MakePicture(MEDIA_PREVIEW_BENCH_EXIF_THUMBNAIL_WIDTH,
+                                      MEDIA_PREVIEW_BENCH_EXIF_THUMBNAIL_HEIGHT, MEDIA_PREVIEW_BENCH_MAIN_NOISE,
+                                      &thumbnailData, &thumbnailSize) != 0) {
+        free(mainData);
+        return -1;
+    }
+
+    segmentLen = 2 + 6 + sizeof(tiffHead) + thumbnailSize;
+    *size = mainSize + 2 + segmentLen;
+    photo = malloc(*size);
+    if (photo == NULL) {
+        free(mainData);
+        free(thumbnailData);
+        return -1;
+    }
+
+    //SOI, APP1, then the main picture without its SOI
+    photo[0] = 0xFF;
+    photo[1] = 0xD8;
+    photo[2] = 0xFF;
+    photo[3] = 0xE1;
+    photo[4] = (uint8_t) (segmentLen >> 8);
+    photo[5] = (uint8_t) segmentLen;
+    memcpy(&photo[6], "Exif\0\0", 6);
+    memcpy(&photo[12], tiffHead, sizeof(tiffHead));
+    photo[12 + 36] = (uint8_t) (thumbnailSize >> 24);
+    photo[12 + 37] = (uint8_t) (thumbnailSize >> 16);
+    photo[12 + 38] = (uint8_t) (thumbnailSize >> 8);
+    photo[12 + 39] = (uint8_t) thumbnailSize;
+    memcpy(&photo[12 + sizeof(tiffHead)], thumbnailData, thumbnailSize);
+    memcpy(&photo[12 + sizeof(tiffHead) + thumbnailSize], &mainData[2], mainSize - 2);
+
+    free(mainData);
+    free(thumbnailData);
+    *data = photo;
+
+    return 0;
+}
+
+static int MediaPreviewBench_WriteFile(const char *path, const uint8_t *data, uint32_t size)
+{
+    FILE *file = fopen(path, "wb");
+
+    if (file == NULL) {
+        return -1;
+    }
+    if (fwrite(data, 1, size, file) != size) {
+        fclose(file);
+        return -1;
+    }
+
+    return fclose(file) == 0 ? 0 : -1;
+}
+
+// create, read in pieces and destroy the preview of every file, like the payload camera serving the album
+static int MediaPreviewBench_Browse(char (*path)[MEDIA_PREVIEW_BENCH_PATH_SIZE], uint32_t fileNum,
+                                    E_DjiMediaFilePreviewType type, T_MediaPreviewBenchResult *result)
+{
+    static uint8_t buffer[MEDIA_PREVIEW_BENCH_READ_LEN];
+    uint16_t expectedWidth = type == DJI_MEDIA_FILE_PREVIEW_TYPE_THUMBNAIL ? DJI_MEDIA_FILE_PREVIEW_THUMBNAIL_WIDTH :
+                             DJI_MEDIA_FILE_PREVIEW_SCREENNAIL_WIDTH;
+    T_DjiMediaFilePreview *preview;
+    uint16_t width, height;
+    uint16_t realLen;
+    uint32_t offset;
+    double startMs;
+    double fileMs;
+    int isFail = 0;
+    uint32_t i;
+
+    memset(result, 0, sizeof(T_MediaPreviewBenchResult));
+
+    for (i = 0; i < fileNum; i++) {
+        startMs = MediaPreviewBench_GetMonotonicMs();
+        if (DjiMediaFile_PreviewCreate(path[i], DJI_MEDIA_FILE_PREVIEW_SOURCE_JPG, type, &preview) !=
+            DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+            printf("CHECK FAIL: preview of %s\r\n", path[i]);
+            isFail = 1;
+            continue;
+        }
+        for (offset = 0; offset < preview->size; offset += realLen) {
+            if (DjiMediaFile_PreviewGetData(preview, offset, sizeof(buffer), buffer, &realLen) !=
+                DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+                isFail = 1;
+                break;
+            }
+        }
+        fileMs = MediaPreviewBench_GetMonotonicMs() - startMs;
+
+        if (DjiMediaFile_JpgGetImageSize(preview->data, preview->size, &width, &height) !=
+            DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS || width != expectedWidth) {
+            printf("CHECK FAIL: preview of %s is not %u pixels wide\r\n", path[i], expectedWidth);
+            isFail = 1;
+        }
+
+        result->totalMs += fileMs;
+        result->maxMs = fileMs > result->maxMs ? fileMs : result->maxMs;
+        result->totalSize += preview->size;
+        result->count++;
+        DjiMediaFile_PreviewDestroy(preview);
+    }
+
+    return isFail;
+}
+
+static void MediaPreviewBench_Print(const char *name, const T_MediaPreviewBenchResult *result)
+{
+    if (result->count == 0) {
+        printf("%-36s %10s\r\n", name, "fail");
+        return;
+    }
+
+    printf("%-36s %10.3f %10.3f %10u\r\n", name, result->totalMs / result->count, result->maxMs,
+           result->totalSize / result->count);
+}
+
+static double MediaPreviewBench_GetMonotonicMs(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return now.tv_sec * 1000.0 + now.tv_nsec / 1000000.0;
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
@@ -0,0 +1,552 @@
+/**
+ ********************************************************************
+ * @file    mem_pool_bench.c
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   Host benchmark of osal_mem_pool.c, replays an allocation trace against heap_4.c of target with and
+ *          without memory pool and reports peak heap use and fragmentation of both.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "FreeRTOS.h"
+#include "osal_mem_pool.h"
+
+/* Private constants ---------------------------------------------------------*/
+//built in trace, one iteration is 10 ms of flight, 100000 iterations are about 17 minutes
+#define MEM_POOL_BENCH_ITERATION_NUM            100000
+#define MEM_POOL_BENCH_OP_NUM_MAX               (4 * 1024 * 1024)
+#define MEM_POOL_BENCH_ID_NUM_MAX               (2 * 1024 * 1024)
+#define MEM_POOL_BENCH_LIVE_NUM_MAX             1024
+//heap state is sampled every this many operations, walking free list of heap_4 is O(free blocks)
+#define MEM_POOL_BENCH_SAMPLE_INTERVAL          16
+//size of TaskStatus_t on target, monitor task of application.c allocates one per task every period
+#define MEM_POOL_BENCH_TASK_STATUS_SIZE         36
+#define MEM_POOL_BENCH_TASK_NUM                 15
+#define MEM_POOL_BENCH_MONITOR_PERIOD           100
+//size of TCB on target, stacks of tasks are given in bytes
+#define MEM_POOL_BENCH_TCB_SIZE                 84
+#define MEM_POOL_BENCH_LINE_LEN_MAX             64
+
+/* Private types -------------------------------------------------------------*/
+typedef enum {
+    MEM_POOL_BENCH_OP_MALLOC = 'm', /*!< Osal_Malloc, served by pool when it is enabled. */
+    MEM_POOL_BENCH_OP_HEAP_MALLOC = 'h', /*!< pvPortMalloc of kernel objects, tasks, queues and timers. */
+    MEM_POOL_BENCH_OP_FREE = 'f',
+} E_MemPoolBenchOpType;
+
+typedef struct {
+    uint8_t type;
+    uint32_t id;
+    uint32_t size;
+} T_MemPoolBenchOp;
+
+typedef struct {
+    T_MemPoolBenchOp *ops;
+    uint32_t opNum;
+    uint32_t idNum;
+} T_MemPoolBenchTrace;
+
+typedef struct {
+    uint32_t id;
+    uint32_t freeIteration;
+} T_MemPoolBenchLive;
+
+typedef struct {
+    T_MemPoolBenchLive live[MEM_POOL_BENCH_LIVE_NUM_MAX];
+    uint32_t liveNum;
+    uint32_t seed;
+} T_MemPoolBenchGenerator;
+
+typedef struct {
+    int isReplayed;
+    uint32_t failedAllocNum;
+    uint32_t corruptedNum;
+    uint32_t peakLiveBytes;
+    uint32_t peakUsedBytes;
+    uint32_t worstFragmentation; /*!< 1 - largest free block / free bytes, unit: 0.1 %. */
+    uint32_t minLargestFreeBlock;
+    uint32_t endFreeBytes;
+    uint32_t endLargestFreeBlock;
+    uint32_t endFreeBlockNum;
+    uint32_t endFragmentation;
+    uint32_t countOfHeapAlloc;
+    T_OsalMemPoolClassState classState[OSAL_MEM_POOL_CLASS_NUM];
+} T_MemPoolBenchResult;
+
+/* Private values -------------------------------------------------------------*/
+
+/* Private functions declaration ---------------------------------------------*/
+static int MemPoolBench_GenerateTrace(T_MemPoolBenchTrace *trace);
+static int MemPoolBench_LoadTrace(const char *path, T_MemPoolBenchTrace *trace);
+static uint32_t MemPoolBench_Alloc(T_MemPoolBenchTrace *trace, T_MemPoolBenchGenerator *generator, uint8_t type,
+                                   uint32_t size, uint32_t freeIteration);
+static void MemPoolBench_AddOp(T_MemPoolBenchTrace *trace, uint8_t type, uint32_t id, uint32_t size);
+static uint32_t MemPoolBench_Random(T_MemPoolBenchGenerator *generator, uint32_t min, uint32_t max);
+static int MemPoolBench_Run(const T_MemPoolBenchTrace *trace, int isPoolEnabled, T_MemPoolBenchResult *result);
+static void MemPoolBench_Replay(const T_MemPoolBenchTrace *trace, int isPoolEnabled, T_MemPoolBenchResult *result);
+static void MemPoolBench_SampleHeap(T_MemPoolBenchResult *result, HeapStats_t *heapStats, uint32_t *fragmentation);
+
+/* Exported functions definition ---------------------------------------------*/
+/**
+ * @brief Replay built in trace, or a recorded one given as argument.
+ * @note A recorded trace has one operation per line, "m <id> <size>" for Osal_Malloc, "h <id> <size>" for
+ * pvPortMalloc of kernel and "f <id>" for free, ids are below 2097152 and may be used again after free.
+ */
+int main(int argc, char *argv[])
+{
+    T_MemPoolBenchTrace trace = {0};
+    T_MemPoolBenchResult result[2];
+    uint32_t mallocNum = 0;
+    int isFail = 0;
+    uint32_t i;
+
+    trace.ops = malloc(MEM_POOL_BENCH_OP_NUM_MAX * sizeof(T_MemPoolBenchOp));
+    if (trace.ops == NULL) {
+        printf("mem pool bench: out of memory\r\n");
+        return 1;
+    }
+
+    if (argc > 1) {
+        if (MemPoolBench_LoadTrace(argv[1], &trace) != 0) {
+            free(trace.ops);
+            return 1;
+        }
+    } else if (MemPoolBench_GenerateTrace(&trace) != 0) {
+        printf("mem pool bench: built in trace is larger than trace buffer\r\n");
+        free(trace.ops);
+        return 1;
+    }
+
+    for (i = 0; i < trace.opNum; i++) {
+        if (trace.ops[i].type != MEM_POOL_BENCH_OP_FREE) {
+            mallocNum++;
+        }
+    }
+    printf("trace %s, %u allocations, heap %u bytes:\r\n", argc > 1 ? argv[1] : "built in", mallocNum,
+           (unsigned int) configTOTAL_HEAP_SIZE);
+
+    //heap_4 and pool have no deinit, every replay starts from fresh state in its own process
+    if (MemPoolBench_Run(&trace, 0, &result[0]) != 0 || MemPoolBench_Run(&trace, 1, &result[1]) != 0) {
+        free(trace.ops);
+        return 1;
+    }
+
+    printf("  %-34s %12s %12s\r\n", "", "heap only", "pool + heap");
+    printf("  %-34s %12u %12u\r\n", "peak live bytes requested", result[0].peakLiveBytes, result[1].peakLiveBytes);
+    printf("  %-34s %12u %12u\r\n", "peak heap used, bytes", result[0].peakUsedBytes, result[1].peakUsedBytes);
+    printf("  %-34s %10u.%u%% %10u.%u%%\r\n", "worst fragmentation",
+           result[0].worstFragmentation / 10, result[0].worstFragmentation % 10,
+           result[1].worstFragmentation / 10, result[1].worstFragmentation % 10);
+    printf("  %-34s %12u %12u\r\n", "min largest free block, bytes", result[0].minLargestFreeBlock,
+           result[1].minLargestFreeBlock);
+    printf("  %-34s %12u %12u\r\n", "end free bytes", result[0].endFreeBytes, result[1].endFreeBytes);
+    printf("  %-34s %12u %12u\r\n", "end largest free block, bytes", result[0].endLargestFreeBlock,
+           result[1].endLargestFreeBlock);
+    printf("  %-34s %12u %12u\r\n", "end free blocks", result[0].endFreeBlockNum, result[1].endFreeBlockNum);
+    printf("  %-34s %10u.%u%% %10u.%u%%\r\n", "end fragmentation",
+           result[0].endFragmentation / 10, result[0].endFragmentation % 10,
+           result[1].endFragmentation / 10, result[1].endFragmentation % 10);
+    printf("  %-34s %12u %12u\r\n", "heap allocations of Osal_Malloc", result[0].countOfHeapAlloc,
+           result[1].countOfHeapAlloc);
+    printf("  %-34s %12u %12u\r\n", "failed allocations", result[0].failedAllocNum, result[1].failedAllocNum);
+
+    printf("pool classes:\r\n");
+    for (i = 0; i < OSAL_MEM_POOL_CLASS_NUM; i++) {
+        printf("  %4u bytes x %2u  max used %2u  allocations %8u  exhausted %6u\r\n",
+               result[1].classState[i].blockSize, result[1].classState[i].blockNum,
+               result[1].classState[i].maxUsedBlockNum, result[1].classState[i].countOfAlloc,
+               result[1].classState[i].countOfExhausted);
+    }
+
+    //every block must keep its content until it is freed, in both modes
+    for (i = 0; i < 2; i++) {
+        if (!result[i].isReplayed || result[i].corruptedNum != 0) {
+            printf("%s: %u corrupted blocks%s\r\n", i == 0 ? "heap only" : "pool + heap", result[i].corruptedNum,
+                   result[i].isReplayed ? "" : ", replay failed");
+            isFail = 1;
+        }
+    }
+
+    printf("%s\r\n", isFail ? "CHECK FAIL" : "CHECK PASS");
+
+    free(trace.ops);
+
+    return isFail;
+}
+
+/* Private functions definition-----------------------------------------------*/
+/**
+ * @brief Build trace of the allocations of payload sdk sample in flight.
+ * @note Long lived allocations are made first: kernel objects of tasks and queues, sdk handles. Then every
+ * iteration data transmission receive callbacks copy messages of 1 to 255 bytes and free them right after
+ * printing, sdk keeps command contexts for up to 300 ms, monitor task replaces its task status array every
+ * second, file transfer buffers live for seconds and a task is created and deleted every 30 seconds.
+ * @param trace: pointer to trace.
+ * @return 0 on success, -1 if trace buffer is too small.
+ */
+static int MemPoolBench_GenerateTrace(T_MemPoolBenchTrace *trace)
+{
+    static const uint32_t taskStackSize[] = {4096, 2048, 2048, 2048, 1024, 1024, 1024, 512};
+    static const uint32_t queueSize[] = {320, 160, 160, 96, 96, 64};
+    T_MemPoolBenchGenerator *generator;
+    uint32_t monitorId = UINT32_MAX;
+    uint32_t iteration;
+    uint32_t i;
+    uint32_t n;
+
+    generator = calloc(1, sizeof(T_MemPoolBenchGenerator));
+    if (generator == NULL) {
+        return -1;
+    }
+    generator->seed = 1;
+    trace->opNum = 0;
+    trace->idNum = 0;
+
+    for (i = 0; i < sizeof(taskStackSize) / sizeof(taskStackSize[0]); i++) {
+        MemPoolBench_Alloc(trace, generator, MEM_POOL_BENCH_OP_HEAP_MALLOC, MEM_POOL_BENCH_TCB_SIZE, UINT32_MAX);
+        MemPoolBench_Alloc(trace, generator, MEM_POOL_BENCH_OP_HEAP_MALLOC, taskStackSize[i], UINT32_MAX);
+    }
+    for (i = 0; i < sizeof(queueSize) / sizeof(queueSize[0]); i++) {
+        MemPoolBench_Alloc(trace, generator, MEM_POOL_BENCH_OP_HEAP_MALLOC, queueSize[i], UINT32_MAX);
+    }
+    for (i = 0; i < 40; i++) {
+        MemPoolBench_Alloc(trace, generator, MEM_POOL_BENCH_OP_MALLOC, MemPoolBench_Random(generator, 8, 160),
+                           UINT32_MAX);
+    }
+
+    for (iteration = 0; iteration < MEM_POOL_BENCH_ITERATION_NUM; iteration++) {
+        //data transmission receive callbacks, malloc len + 1 and strncpy
+        n = MemPoolBench_Random(generator, 0, 9) < 3 ? MemPoolBench_Random(generator, 1, 2) : 0;
+        for (i = 0; i < n; i++) {
+            MemPoolBench_Alloc(trace, generator, MEM_POOL_BENCH_OP_MALLOC, MemPoolBench_Random(generator, 1, 255) + 1,
+                               iteration);
+        }
+
+        //contexts of sdk commands and pushes, mostly small
+        n = MemPoolBench_Random(generator, 0, 3);
+        for (i = 0; i < n; i++) {
+            uint32_t size = MemPoolBench_Random(generator, 0, 9) < 8 ? MemPoolBench_Random(generator, 8, 128) :
+                            MemPoolBench_Random(generator, 129, 700);
+
+            MemPoolBench_Alloc(trace, generator, MEM_POOL_BENCH_OP_MALLOC, size,
+                               iteration + MemPoolBench_Random(generator, 1, 30));
+        }
+
+        //monitor task, new task status array is allocated before last one is freed
+        if (iteration % MEM_POOL_BENCH_MONITOR_PERIOD == 0) {
+            uint32_t lastMonitorId = monitorId;
+
+            monitorId = MemPoolBench_Alloc(trace, generator, MEM_POOL_BENCH_OP_MALLOC,
+                                           MEM_POOL_BENCH_TASK_NUM * MEM_POOL_BENCH_TASK_STATUS_SIZE, UINT32_MAX);
+            if (lastMonitorId != UINT32_MAX) {
+                MemPoolBench_AddOp(trace, MEM_POOL_BENCH_OP_FREE, lastMonitorId, 0);
+            }
+        }
+
+        //send and receive buffers of mop channel and file transfer
+        if (iteration % 1000 == 500) {
+            MemPoolBench_Alloc(trace, generator, MEM_POOL_BENCH_OP_MALLOC, MemPoolBench_Random(generator, 1024, 4096),
+                               iteration + MemPoolBench_Random(generator, 100, 600));
+        }
+
+        //short lived task, TCB and stack
+        if (iteration % 3000 == 1500) {
+            uint32_t freeIteration = iteration + MemPoolBench_Random(generator, 200, 800);
+
+            MemPoolBench_Alloc(trace, generator, MEM_POOL_BENCH_OP_HEAP_MALLOC, MEM_POOL_BENCH_TCB_SIZE,
+                               freeIteration);
+            MemPoolBench_Alloc(trace, generator, MEM_POOL_BENCH_OP_HEAP_MALLOC, 2048, freeIteration);
+        }
+
+        for (i = 0; i < generator->liveNum;) {
+            if (generator->live[i].freeIteration <= iteration) {
+                MemPoolBench_AddOp(trace, MEM_POOL_BENCH_OP_FREE, generator->live[i].id, 0);
+                generator->live[i] = generator->live[--generator->liveNum];
+            } else {
+                i++;
+            }
+        }
+
+        if (trace->opNum > MEM_POOL_BENCH_OP_NUM_MAX - 64 || trace->idNum > MEM_POOL_BENCH_ID_NUM_MAX - 64 ||
+            generator->liveNum > MEM_POOL_BENCH_LIVE_NUM_MAX - 64) {
+            free(generator);
+            return -1;
+        }
+    }
+
+    free(generator);
+
+    return 0;
+}
+
+static int MemPoolBench_LoadTrace(const char *path, T_MemPoolBenchTrace *trace)
+{
+    char line[MEM_POOL_BENCH_LINE_LEN_MAX];
+    unsigned int lineNum = 0;
+    unsigned int id;
+    unsigned int size;
+    char type;
+    FILE *file;
+    int isFail = 0;
+
+    file = fopen(path, "r");
+    if (file == NULL) {
+        printf("mem pool bench: open %s error\r\n", path);
+        return -1;
+    }
+
+    trace->opNum = 0;
+    trace->idNum = 0;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        lineNum++;
+        size = 0;
+        if (line[0] == '\n' || line[0] == '#') {
+            continue;
+        }
+        if (sscanf(line, " %c %u %u", &type, &id, &size) < 2 || id >= MEM_POOL_BENCH_ID_NUM_MAX ||
+            (type != MEM_POOL_BENCH_OP_MALLOC && type != MEM_POOL_BENCH_OP_HEAP_MALLOC &&
+             type != MEM_POOL_BENCH_OP_FREE)) {
+            printf("mem pool bench: %s:%u: bad operation\r\n", path, lineNum);
+            isFail = 1;
+            break;
+        }
+        if (trace->opNum >= MEM_POOL_BENCH_OP_NUM_MAX) {
+            printf("mem pool bench: %s has more than %d operations\r\n", path, MEM_POOL_BENCH_OP_NUM_MAX);
+            isFail = 1;
+            break;
+        }
+        MemPoolBench_AddOp(trace, (uint8_t) type, id, size);
+        if (id >= trace->idNum) {
+            trace->idNum = id + 1;
+        }
+    }
+
+    fclose(file);
+
+    return isFail ? -1 : 0;
+}
+
+static uint32_t MemPoolBench_Alloc(T_MemPoolBenchTrace *trace, T_MemPoolBenchGenerator *generator, uint8_t type,
+                                   uint32_t size, uint32_t freeIteration)
+{
+    uint32_t id = trace->idNum++;
+
+    MemPoolBench_AddOp(trace, type, id, size);
+    //UINT32_MAX is freed by caller or never
+    if (freeIteration != UINT32_MAX) {
+        generator->live[generator->liveNum].id = id;
+        generator->live[generator->liveNum].freeIteration = freeIteration;
+        generator->liveNum++;
+    }
+
+    return id;
+}
+
+static void MemPoolBench_AddOp(T_MemPoolBenchTrace *trace, uint8_t type, uint32_t id, uint32_t size)
+{
+    trace->ops[trace->opNum].type = type;
+    trace->ops[trace->opNum].id = id;
+    trace->ops[trace->opNum].size = size;
+    trace->opNum++;
+}
+
+static uint32_t MemPoolBench_Random(T_MemPoolBenchGenerator *generator, uint32_t min, uint32_t max)
+{
+    generator->seed = generator->seed * 1664525U + 1013904223U;
+
+    return min + (generator->seed >> 8) % (max - min + 1);
+}
+
+/**
+ * @brief Replay trace in a child process and collect its result.
+ * @param trace: pointer to trace.
+ * @param isPoolEnabled: 1 to serve Osal_Malloc by pool as OSAL_MEM_POOL_ENABLE does, 0 to use heap directly.
+ * @param result: pointer to result.
+ * @return 0 on success, -1 if child process could not be run.
+ */
+static int MemPoolBench_Run(const T_MemPoolBenchTrace *trace, int isPoolEnabled, T_MemPoolBenchResult *result)
+{
+    int pipeFd[2];
+    ssize_t readLen;
+    pid_t pid;
+
+    memset(result, 0, sizeof(T_MemPoolBenchResult));
+    if (pipe(pipeFd) != 0) {
+        printf("mem pool bench: create pipe error\r\n");
+        return -1;
+    }
+
+    fflush(stdout);
+    pid = fork();
+    if (pid < 0) {
+        printf("mem pool bench: fork error\r\n");
+        close(pipeFd[0]);
+        close(pipeFd[1]);
+        return -1;
+    } else if (pid == 0) {
+        close(pipeFd[0]);
+        MemPoolBench_Replay(trace, isPoolEnabled, result);
+        if (write(pipeFd[1], result, sizeof(T_MemPoolBenchResult)) != sizeof(T_MemPoolBenchResult)) {
+            _exit(1);
+        }
+        _exit(0);
+    }
+
+    close(pipeFd[1]);
+    readLen = read(pipeFd[0], result, sizeof(T_MemPoolBenchResult));
+    close(pipeFd[0]);
+    waitpid(pid, NULL, 0);
+    if (readLen != sizeof(T_MemPoolBenchResult)) {
+        //a replay that crashed leaves result not replayed, which fails the check
+        memset(result, 0, sizeof(T_MemPoolBenchResult));
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Replay trace on heap_4 of target, every block is filled with its id and checked before it is freed.
+ * @note Heap block header is 16 bytes on 64 bit host and 8 bytes on target, so heap only mode pays more overhead per
+ * small block here than on target, and pool + heap mode is favoured a little.
+ */
+static void MemPoolBench_Replay(const T_MemPoolBenchTrace *trace, int isPoolEnabled, T_MemPoolBenchResult *result)
+{
+    HeapStats_t heapStats;
+    uint8_t **blocks;
+    uint32_t *blockSizes;
+    uint8_t *blockTypes;
+    uint32_t liveBytes = 0;
+    uint32_t fragmentation;
+    uint32_t i;
+    uint32_t j;
+
+    blocks = calloc(trace->idNum, sizeof(uint8_t *));
+    blockSizes = calloc(trace->idNum, sizeof(uint32_t));
+    blockTypes = calloc(trace->idNum, sizeof(uint8_t));
+    if (blocks == NULL || blockSizes == NULL || blockTypes == NULL) {
+        return;
+    }
+
+    if (isPoolEnabled && OsalMemPool_Init() != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        return;
+    }
+    result->minLargestFreeBlock = UINT32_MAX;
+
+    for (i = 0; i < trace->opNum; i++) {
+        const T_MemPoolBenchOp *op = &trace->ops[i];
+
+        if (op->type == MEM_POOL_BENCH_OP_FREE) {
+            uint8_t *block = blocks[op->id];
+
+            if (block == NULL) {
+                continue;
+            }
+            for (j = 0; j < blockSizes[op->id]; j++) {
+                if (block[j] != (uint8_t) op->id) {
+                    result->corruptedNum++;
+                    break;
+                }
+            }
+            if (isPoolEnabled && blockTypes[op->id] == MEM_POOL_BENCH_OP_MALLOC) {
+                OsalMemPool_Free(block);
+            } else {
+                vPortFree(block);
+            }
+            liveBytes -= blockSizes[op->id];
+            blocks[op->id] = NULL;
+        } else {
+            uint8_t *block;
+
+            if (blocks[op->id] != NULL) {
+                //id used again before free, a recorded trace that missed a free leaks like target would
+                liveBytes -= blockSizes[op->id];
+            }
+            if (isPoolEnabled && op->type == MEM_POOL_BENCH_OP_MALLOC) {
+                block = OsalMemPool_Malloc(op->size);
+            } else {
+                block = pvPortMalloc(op->size);
+                if (op->type == MEM_POOL_BENCH_OP_MALLOC) {
+                    result->countOfHeapAlloc++;
+                }
+            }
+            blocks[op->id] = block;
+            blockSizes[op->id] = op->size;
+            blockTypes[op->id] = op->type;
+            if (block == NULL) {
+                result->failedAllocNum++;
+            } else {
+                memset(block, (uint8_t) op->id, op->size);
+                liveBytes += op->size;
+                if (liveBytes > result->peakLiveBytes) {
+                    result->peakLiveBytes = liveBytes;
+                }
+            }
+        }
+
+        if (i % MEM_POOL_BENCH_SAMPLE_INTERVAL == 0 || i == trace->opNum - 1) {
+            MemPoolBench_SampleHeap(result, &heapStats, &fragmentation);
+        }
+    }
+
+    MemPoolBench_SampleHeap(result, &heapStats, &fragmentation);
+    result->endFreeBytes = heapStats.xAvailableHeapSpaceInBytes;
+    result->endLargestFreeBlock = heapStats.xSizeOfLargestFreeBlockInBytes;
+    result->endFreeBlockNum = heapStats.xNumberOfFreeBlocks;
+    result->endFragmentation = fragmentation;
+    result->peakUsedBytes = configTOTAL_HEAP_SIZE - xPortGetMinimumEverFreeHeapSize();
+    if (isPoolEnabled) {
+        result->countOfHeapAlloc = OsalMemPool_GetCountOfHeapAlloc();
+        for (i = 0; i < OSAL_MEM_POOL_CLASS_NUM; i++) {
+            OsalMemPool_GetClassState(i, &result->classState[i]);
+        }
+    }
+    result->isReplayed = 1;
+
+    free(blocks);
+    free(blockSizes);
+    free(blockTypes);
+}
+
+static void MemPoolBench_SampleHeap(T_MemPoolBenchResult *result, HeapStats_t *heapStats, uint32_t *fragmentation)
+{
+    vPortGetHeapStats(heapStats);
+    if (heapStats->xAvailableHeapSpaceInBytes == 0) {
+        *fragmentation = 0;
+    } else {
+        *fragmentation = (uint32_t) (1000 - (uint64_t) heapStats->xSizeOfLargestFreeBlockInBytes * 1000 /
+                                            heapStats->xAvailableHeapSpaceInBytes);
+    }
+
+    if (*fragmentation > result->worstFragmentation) {
+        result->worstFragmentation = *fragmentation;
+    }
+    if (heapStats->xSizeOfLargestFreeBlockInBytes < result->minLargestFreeBlock) {
+        result->minLargestFreeBlock = (uint32_t) heapStats->xSizeOfLargestFreeBlockInBytes;
+    }
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
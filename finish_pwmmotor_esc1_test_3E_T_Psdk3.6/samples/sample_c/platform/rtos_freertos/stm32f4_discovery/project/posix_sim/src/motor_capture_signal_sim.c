@@ -0,0 +1,125 @@
+/**
+ ********************************************************************
+ * @file    motor_capture_signal_sim.c
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   Synthetic captures of pulse and tachometer edges for host builds, written into circular buffers
+ * the way DMA of motor_capture.c does. Used by motor capture of simulator and by host check of motor
+ * telemetry.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "motor_capture_signal_sim.h"
+#include "motor_telemetry.h"
+
+/* Private constants ---------------------------------------------------------*/
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private values -------------------------------------------------------------*/
+
+/* Private functions declaration ---------------------------------------------*/
+static void MotorCaptureSignalSim_WriteCapture(uint16_t *buffer, uint16_t bufferLen, uint16_t *writeIndex,
+                                               uint32_t timeUs);
+
+/* Exported functions definition ---------------------------------------------*/
+/**
+ * @brief Start signal at time 0 with no edges, write indexes start from 0, same as DMA.
+ * @param signal: pointer to signal.
+ * @param pulseBuffer: buffer of pulse captures, in records of MOTOR_TELEMETRY_PULSE_RECORD_LEN.
+ * @param pulseBufferLen: length of pulse buffer, unit: half word.
+ * @param tachBuffer: buffer of tachometer captures.
+ * @param tachBufferLen: length of tachometer buffer, unit: half word.
+ * @return None.
+ */
+void MotorCaptureSignalSim_Init(T_MotorCaptureSignalSim *signal, uint16_t *pulseBuffer, uint16_t pulseBufferLen,
+                                uint16_t *tachBuffer, uint16_t tachBufferLen)
+{
+    T_MotorCaptureSignalSim zero = {0};
+
+    *signal = zero;
+    signal->pulseBuffer = pulseBuffer;
+    signal->pulseBufferLen = pulseBufferLen;
+    signal->tachBuffer = tachBuffer;
+    signal->tachBufferLen = tachBufferLen;
+}
+
+/**
+ * @brief Advance time and write captures of edges that happen meanwhile.
+ * @note A pulse record is written at every rising edge, capture of the rising edge followed by the latest falling
+ * edge, which belongs to previous pulse. A pulse as wide as its period leaves line high and has no falling edge.
+ * @param signal: pointer to signal.
+ * @param durationUs: time to advance.
+ * @param pulseWidthUs: width of pulses starting meanwhile.
+ * @param pulsePeriodUs: period of pulses, 0 stops pulses and line stays low.
+ * @param tachPeriodUs: interval of tachometer edges, 0 means motor stands still.
+ * @return None.
+ */
+void MotorCaptureSignalSim_Advance(T_MotorCaptureSignalSim *signal, uint32_t durationUs, uint32_t pulseWidthUs,
+                                   uint32_t pulsePeriodUs, uint32_t tachPeriodUs)
+{
+    signal->timeUs += durationUs;
+
+    if (pulsePeriodUs == 0) {
+        signal->isPulseRunning = false;
+    } else {
+        if (!signal->isPulseRunning) {
+            signal->nextRiseUs = signal->timeUs - durationUs;
+            signal->isPulseRunning = true;
+        }
+        while ((int32_t) (signal->timeUs - signal->nextRiseUs) > 0) {
+            MotorCaptureSignalSim_WriteCapture(signal->pulseBuffer, signal->pulseBufferLen,
+                                               &signal->pulseWriteIndex, signal->nextRiseUs);
+            MotorCaptureSignalSim_WriteCapture(signal->pulseBuffer, signal->pulseBufferLen,
+                                               &signal->pulseWriteIndex, signal->lastFallUs);
+            if (pulseWidthUs < pulsePeriodUs) {
+                signal->lastFallUs = signal->nextRiseUs + pulseWidthUs;
+            }
+            signal->nextRiseUs += pulsePeriodUs;
+        }
+    }
+
+    if (tachPeriodUs == 0) {
+        signal->isTachRunning = false;
+    } else {
+        //edges restart at start of this advance after a stop, or when next edge is further than a new interval
+        if (!signal->isTachRunning || (int32_t) (signal->nextTachUs - signal->timeUs) > (int32_t) tachPeriodUs) {
+            signal->nextTachUs = signal->timeUs - durationUs;
+            signal->isTachRunning = true;
+        }
+        while ((int32_t) (signal->timeUs - signal->nextTachUs) > 0) {
+            MotorCaptureSignalSim_WriteCapture(signal->tachBuffer, signal->tachBufferLen, &signal->tachWriteIndex,
+                                               signal->nextTachUs);
+            signal->nextTachUs += tachPeriodUs;
+        }
+    }
+}
+
+/* Private functions definition-----------------------------------------------*/
+static void MotorCaptureSignalSim_WriteCapture(uint16_t *buffer, uint16_t bufferLen, uint16_t *writeIndex,
+                                               uint32_t timeUs)
+{
+    //capture timer counts at MOTOR_TELEMETRY_CAPTURE_FREQ_HZ, i.e. 1 us, and wraps at 16 bits
+    buffer[*writeIndex] = (uint16_t) timeUs;
+    *writeIndex = (*writeIndex + 1) % bufferLen;
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
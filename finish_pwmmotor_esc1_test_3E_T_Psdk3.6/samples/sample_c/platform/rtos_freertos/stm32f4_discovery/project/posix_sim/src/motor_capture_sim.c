@@ -0,0 +1,135 @@
+/**
+ ********************************************************************
+ * @file    motor_capture_sim.c
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   Motor capture of host simulator build, replaces motor_capture.c. Capture buffers are filled with
+ * synthetic edges of the simulated motor PWM output and a motor whose speed follows pulse width, see
+ * motor_capture_signal_sim.c, then filtered by the same code as target.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "motor_capture.h"
+#include "motor_capture_signal_sim.h"
+#include "motor_pwm.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Private constants ---------------------------------------------------------*/
+#define MOTOR_CAPTURE_SIM_TASK_STACK_SIZE   configMINIMAL_STACK_SIZE
+#define MOTOR_CAPTURE_SIM_TASK_PRIORITY     (configMAX_PRIORITIES - 1)
+
+#define MOTOR_CAPTURE_SIM_PULSE_BUFFER_LEN  (MOTOR_CAPTURE_PULSE_RECORD_NUM * MOTOR_TELEMETRY_PULSE_RECORD_LEN)
+#define MOTOR_CAPTURE_SIM_UPDATE_PERIOD_US  (MOTOR_TELEMETRY_CAPTURE_FREQ_HZ / MOTOR_TELEMETRY_UPDATE_FREQ_HZ)
+//one count of motor PWM timer, and pulse range of motor task from idle to full throttle
+#define MOTOR_CAPTURE_SIM_PWM_COUNT_US      10
+#define MOTOR_CAPTURE_SIM_PULSE_IDLE_US     600
+#define MOTOR_CAPTURE_SIM_PULSE_FULL_US     1600
+#define MOTOR_CAPTURE_SIM_RPM_MAX           12000
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private values -------------------------------------------------------------*/
+static bool s_isMotorCaptureInit = false;
+static TaskHandle_t s_motorCaptureSimTask;
+static uint16_t s_motorCapturePulseBuffer[MOTOR_CAPTURE_SIM_PULSE_BUFFER_LEN];
+static uint16_t s_motorCaptureTachBuffer[MOTOR_CAPTURE_TACH_EDGE_NUM];
+static T_MotorCaptureSignalSim s_motorCaptureSignal;
+static T_MotorTelemetry s_motorTelemetry;
+
+/* Private functions declaration ---------------------------------------------*/
+static void MotorCapture_SimTask(void *arg);
+
+/* Exported functions definition ---------------------------------------------*/
+T_DjiReturnCode MotorCapture_Init(const T_MotorTelemetryConfig *config)
+{
+    if (s_isMotorCaptureInit) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_NONSUPPORT_IN_CURRENT_STATE;
+    }
+
+    MotorTelemetry_Init(&s_motorTelemetry, config);
+    MotorCaptureSignalSim_Init(&s_motorCaptureSignal, s_motorCapturePulseBuffer, MOTOR_CAPTURE_SIM_PULSE_BUFFER_LEN,
+                               s_motorCaptureTachBuffer, MOTOR_CAPTURE_TACH_EDGE_NUM);
+    xTaskCreate(MotorCapture_SimTask, "motorCapture_sim", MOTOR_CAPTURE_SIM_TASK_STACK_SIZE,
+                NULL, MOTOR_CAPTURE_SIM_TASK_PRIORITY, &s_motorCaptureSimTask);
+    s_isMotorCaptureInit = true;
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+void MotorCapture_GetTelemetry(T_MotorTelemetryValue *value)
+{
+    taskENTER_CRITICAL();
+    *value = s_motorTelemetry.value;
+    taskEXIT_CRITICAL();
+}
+
+/* Private functions definition-----------------------------------------------*/
+#ifndef __CC_ARM
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-noreturn"
+#pragma GCC diagnostic ignored "-Wreturn-type"
+#endif
+
+static void MotorCapture_SimTask(void *arg)
+{
+    uint32_t pulseUs;
+    uint32_t tachPeriodUs;
+    uint32_t rpm;
+    T_MotorTelemetryCapture pulseCapture = {s_motorCapturePulseBuffer, MOTOR_CAPTURE_SIM_PULSE_BUFFER_LEN, 0};
+    T_MotorTelemetryCapture tachCapture = {s_motorCaptureTachBuffer, MOTOR_CAPTURE_TACH_EDGE_NUM, 0};
+
+    (void) arg;
+
+    while (1) {
+        vTaskDelay(pdMS_TO_TICKS(1000 / MOTOR_TELEMETRY_UPDATE_FREQ_HZ));
+
+        //output is active low, line is high for the part of period after compare value
+        pulseUs = (MOTOR_PWM_PERIOD_COUNT - MotorPwm_GetCompare(MOTOR_PWM_CHANNEL_THROTTLE)) *
+                  MOTOR_CAPTURE_SIM_PWM_COUNT_US;
+
+        //motor stands still at idle pulse and when line stays high, speed is linear to pulse width in between
+        tachPeriodUs = 0;
+        if (pulseUs > MOTOR_CAPTURE_SIM_PULSE_IDLE_US &&
+            pulseUs < MOTOR_PWM_PERIOD_COUNT * MOTOR_CAPTURE_SIM_PWM_COUNT_US) {
+            rpm = ((pulseUs < MOTOR_CAPTURE_SIM_PULSE_FULL_US ? pulseUs : MOTOR_CAPTURE_SIM_PULSE_FULL_US) -
+                   MOTOR_CAPTURE_SIM_PULSE_IDLE_US) * MOTOR_CAPTURE_SIM_RPM_MAX /
+                  (MOTOR_CAPTURE_SIM_PULSE_FULL_US - MOTOR_CAPTURE_SIM_PULSE_IDLE_US);
+            tachPeriodUs = 60000000 / (rpm * s_motorTelemetry.config.tachEdgePerRev);
+        }
+
+        //time of simulated capture timer is advanced by one update period per turn instead of following host clock
+        MotorCaptureSignalSim_Advance(&s_motorCaptureSignal, MOTOR_CAPTURE_SIM_UPDATE_PERIOD_US, pulseUs,
+                                      MOTOR_PWM_PERIOD_COUNT * MOTOR_CAPTURE_SIM_PWM_COUNT_US, tachPeriodUs);
+
+        pulseCapture.writeIndex = s_motorCaptureSignal.pulseWriteIndex;
+        tachCapture.writeIndex = s_motorCaptureSignal.tachWriteIndex;
+        taskENTER_CRITICAL();
+        MotorTelemetry_Update(&s_motorTelemetry, &pulseCapture, &tachCapture);
+        taskEXIT_CRITICAL();
+    }
+}
+
+#ifndef __CC_ARM
+#pragma GCC diagnostic pop
+#endif
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
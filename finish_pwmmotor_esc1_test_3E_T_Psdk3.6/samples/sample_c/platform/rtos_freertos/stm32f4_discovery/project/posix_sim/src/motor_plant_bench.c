@@ -0,0 +1,182 @@
+/**
+ ********************************************************************
+ * @file    motor_plant_bench.c
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   Host benchmark of command to output latency and settling time of the motor PWM channel, throttle
+ *          ramp is run in the update interrupt of the ESC timer as motor_pwm.c does and drives the plant model.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "stm32f4xx_hal.h"
+#include "motor_pwm.h"
+#include "motor_plant_model_sim.h"
+
+/* Private constants ---------------------------------------------------------*/
+#define MOTOR_PLANT_BENCH_TIM_CLOCK_HZ          84000000
+#define MOTOR_PLANT_BENCH_PERIOD_US             ((uint64_t) MOTOR_PWM_PERIOD_COUNT * MOTOR_PWM_PRESCALER * 1000000 / \
+                                                 MOTOR_PLANT_BENCH_TIM_CLOCK_HZ)
+#define MOTOR_PLANT_BENCH_SAMPLE_PERIOD_US      1000
+//same mapping as application.c, throttle widget 0 to 100 is 600 to 1600 us pulse
+#define MOTOR_PLANT_BENCH_IDLE_COMPARE          (MOTOR_PWM_PERIOD_COUNT - 60)
+#define MOTOR_PLANT_BENCH_START_DELAY_US        500000
+#define MOTOR_PLANT_BENCH_STEP_HOLD_US          1000000
+#define MOTOR_PLANT_BENCH_ROUND_NUM             32
+#define MOTOR_PLANT_BENCH_STEP_NUM              (sizeof(s_benchStep) / sizeof(s_benchStep[0]))
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private values -------------------------------------------------------------*/
+//same ramp as motor PWM of application.c
+static const T_ThrottleRampConfig s_benchRampConfig = {
+    .profile = THROTTLE_RAMP_PROFILE_S_CURVE,
+    .maxStepPerUpdate = 20,
+    .rampUpdateNum = 10,
+    .exponentialShift = 2,
+};
+
+//ESC on TIM14 is calibrated to the pulse range throttle widget maps to
+static const T_MotorPlantModelChannelConfig s_benchChannelConfig = {
+    "motor", TIM14, MOTOR_PLANT_MODEL_ESC_INPUT_PULSE, 600, 1600
+};
+
+static const int32_t s_benchStep[] = {20, 50, 80, 30, 100, 60, 0, 40};
+
+static TIM_HandleTypeDef s_benchTimHandle = {.Instance = TIM14};
+static T_MotorPlantModelChannel s_benchChannel;
+static T_MotorPlantModelResult s_benchResult;
+static uint64_t s_nowUs = 0;
+static uint32_t s_seed = 1;
+
+/* Private functions declaration ---------------------------------------------*/
+static void MotorPlantBench_OnCompareWrite(TIM_TypeDef *instance, uint32_t channel, uint32_t compare);
+static uint32_t MotorPlantBench_Random(void);
+
+/* Exported functions definition ---------------------------------------------*/
+int main(int argc, char *argv[])
+{
+    T_ThrottleRamp ramp;
+    FILE *file = NULL;
+    uint64_t nextUpdateUs;
+    uint64_t nextSampleUs;
+    uint64_t nextCommandUs;
+    uint64_t endUs;
+    uint32_t stepIndex = 0;
+    int32_t command = 0;
+
+    if (argc > 1) {
+        file = fopen(argv[1], "w");
+        if (file == NULL) {
+            printf("open %s error\r\n", argv[1]);
+            return 1;
+        }
+        fprintf(file, "time_us,command,compare,pulse_us,throttle,rpm\n");
+    }
+
+    //timer and ramp start as MotorPwm_Init leaves them, ESC sees idle pulse
+    TIM14->ARR = MOTOR_PWM_PERIOD_COUNT - 1;
+    TIM14->PSC = MOTOR_PWM_PRESCALER - 1;
+    MotorPlantModel_Init(&s_benchChannel, &s_benchChannelConfig, s_nowUs);
+    TimSim_RegCompareWriteCallback(MotorPlantBench_OnCompareWrite);
+    ThrottleRamp_Init(&ramp, &s_benchRampConfig, MOTOR_PLANT_BENCH_IDLE_COMPARE);
+    __HAL_TIM_SET_COMPARE(&s_benchTimHandle, TIM_CHANNEL_1, MOTOR_PLANT_BENCH_IDLE_COMPARE);
+
+    //commands come at random phase of PWM period, as widget changes do
+    nextUpdateUs = MOTOR_PLANT_BENCH_PERIOD_US;
+    nextSampleUs = MOTOR_PLANT_BENCH_SAMPLE_PERIOD_US;
+    nextCommandUs = MOTOR_PLANT_BENCH_START_DELAY_US + MotorPlantBench_Random() % MOTOR_PLANT_BENCH_PERIOD_US;
+    endUs = MOTOR_PLANT_BENCH_START_DELAY_US +
+            (uint64_t) MOTOR_PLANT_BENCH_ROUND_NUM * MOTOR_PLANT_BENCH_STEP_NUM * MOTOR_PLANT_BENCH_STEP_HOLD_US +
+            MOTOR_PLANT_BENCH_PERIOD_US;
+
+    while (s_nowUs < endUs) {
+        s_nowUs = nextUpdateUs < nextSampleUs ? nextUpdateUs : nextSampleUs;
+        s_nowUs = nextCommandUs < s_nowUs ? nextCommandUs : s_nowUs;
+        MotorPlantModel_Advance(&s_benchChannel, s_nowUs);
+
+        //update event has just taken preloaded compare value, interrupt preloads the next one
+        if (s_nowUs == nextUpdateUs) {
+            __HAL_TIM_SET_COMPARE(&s_benchTimHandle, TIM_CHANNEL_1, ThrottleRamp_Update(&ramp));
+            nextUpdateUs += MOTOR_PLANT_BENCH_PERIOD_US;
+        }
+
+        if (s_nowUs == nextCommandUs) {
+            if (stepIndex != 0) {
+                MotorPlantModel_EndStep(&s_benchChannel, &s_benchResult);
+            }
+            command = s_benchStep[stepIndex % MOTOR_PLANT_BENCH_STEP_NUM];
+            MotorPlantModel_StartStep(&s_benchChannel, s_nowUs);
+            ThrottleRamp_SetTarget(&ramp, (uint16_t) (MOTOR_PLANT_BENCH_IDLE_COMPARE - command));
+            stepIndex++;
+            nextCommandUs = stepIndex < MOTOR_PLANT_BENCH_ROUND_NUM * MOTOR_PLANT_BENCH_STEP_NUM ?
+                            MOTOR_PLANT_BENCH_START_DELAY_US + (uint64_t) stepIndex * MOTOR_PLANT_BENCH_STEP_HOLD_US +
+                            MotorPlantBench_Random() % MOTOR_PLANT_BENCH_PERIOD_US : UINT64_MAX;
+        }
+
+        if (s_nowUs == nextSampleUs) {
+            MotorPlantModel_Sample(&s_benchChannel);
+            if (file != NULL) {
+                fprintf(file, "%llu,%d,%u,%u,%.4f,%.1f\n", (unsigned long long) s_nowUs, (int) command,
+                        (unsigned int) s_benchChannel.compare, (unsigned int) s_benchChannel.pulseUs,
+                        s_benchChannel.throttle, MotorPlantModel_GetRpm(&s_benchChannel));
+            }
+            nextSampleUs += MOTOR_PLANT_BENCH_SAMPLE_PERIOD_US;
+        }
+    }
+    MotorPlantModel_EndStep(&s_benchChannel, &s_benchResult);
+
+    if (file != NULL) {
+        fclose(file);
+    }
+
+    printf("motor plant bench, %u steps held %u ms, pwm period %u us, ramp updated every period\r\n",
+           (unsigned int) stepIndex, MOTOR_PLANT_BENCH_STEP_HOLD_US / 1000, (unsigned int) MOTOR_PLANT_BENCH_PERIOD_US);
+    MotorPlantModel_PrintResult(s_benchChannelConfig.name, &s_benchResult);
+
+    //every step changes throttle, a step without output change is a broken path
+    return s_benchResult.countOfNoResponse != 0;
+}
+
+/* Private functions definition-----------------------------------------------*/
+/**
+ * @brief Record compare write at bench time, preloaded value is taken by ESC from next period.
+ */
+static void MotorPlantBench_OnCompareWrite(TIM_TypeDef *instance, uint32_t channel, uint32_t compare)
+{
+    (void) channel;
+
+    if (instance == s_benchChannelConfig.instance) {
+        MotorPlantModel_WriteCompare(&s_benchChannel, compare, s_nowUs);
+    }
+}
+
+static uint32_t MotorPlantBench_Random(void)
+{
+    s_seed = s_seed * 1103515245 + 12345;
+
+    return s_seed >> 8;
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
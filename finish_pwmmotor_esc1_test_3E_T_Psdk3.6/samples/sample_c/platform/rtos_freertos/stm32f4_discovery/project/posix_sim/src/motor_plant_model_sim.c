@@ -0,0 +1,312 @@
+/**
+ ********************************************************************
+ * @file    motor_plant_model_sim.c
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   ESC and motor model of host simulator build and benches. ESC takes compare value at start of
+ *          PWM period and turns pulse into throttle, motor with prop load follows it, step measurement
+ *          reports command to output latency and settling time.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "motor_plant_model_sim.h"
+
+/* Private constants ---------------------------------------------------------*/
+#define MOTOR_PLANT_MODEL_TIM_CLOCK_HZ          84000000
+//motor is integrated in sub steps, much shorter than its mechanical time constant
+#define MOTOR_PLANT_MODEL_SUB_STEP_US           100
+#define MOTOR_PLANT_MODEL_RAD_S_TO_RPM          (60.0 / (2.0 * M_PI))
+
+//output is settled when speed stays within 2% of final speed, but not tighter than a few rpm at standstill
+#define MOTOR_PLANT_MODEL_SETTLE_BAND_PERCENT   2
+#define MOTOR_PLANT_MODEL_SETTLE_BAND_MIN_RPM   20.0
+
+/* Private types -------------------------------------------------------------*/
+typedef struct {
+    double kv; /*!< Speed constant, unit: rpm/V. */
+    double batteryVoltage; /*!< Unit: V. */
+    double windingResistance; /*!< Unit: ohm. */
+    double rotorInertia; /*!< Inertia of rotor and prop, unit: kg*m^2. */
+    double propTorqueCoeff; /*!< Load torque of prop is coeff * speed^2, unit: N*m/(rad/s)^2. */
+} T_MotorPlantModelMotorConfig;
+
+/* Private values -------------------------------------------------------------*/
+//2212 class motor with 10 inch prop on 3S battery, about 8600 rpm and 20 ms time constant at full throttle
+static const T_MotorPlantModelMotorConfig s_motorPlantModelMotorConfig = {
+    .kv = 920.0,
+    .batteryVoltage = 11.1,
+    .windingResistance = 0.1,
+    .rotorInertia = 3.0e-5,
+    .propTorqueCoeff = 2.1e-7,
+};
+
+/* Private functions declaration ---------------------------------------------*/
+static void MotorPlantModel_StartPeriod(T_MotorPlantModelChannel *channel);
+static void MotorPlantModel_Integrate(T_MotorPlantModelChannel *channel, uint64_t timeUs);
+static void MotorPlantModel_PrintPercentile(const char *name, uint32_t *value, uint32_t valueNum);
+static int MotorPlantModel_CompareValue(const void *a, const void *b);
+
+/* Exported functions definition ---------------------------------------------*/
+/**
+ * @brief Start channel at given time with motor standing still and no compare value taken.
+ * @param channel: pointer to channel.
+ * @param config: pointer to channel configuration, kept by channel.
+ * @param timeUs: start time.
+ * @return None.
+ */
+void MotorPlantModel_Init(T_MotorPlantModelChannel *channel, const T_MotorPlantModelChannelConfig *config,
+                          uint64_t timeUs)
+{
+    static const T_MotorPlantModelChannel zero = {0};
+
+    *channel = zero;
+    channel->config = config;
+    channel->periodStartUs = timeUs;
+    channel->timeUs = timeUs;
+}
+
+/**
+ * @brief Record compare write of channel timer, ESC takes it at first period start after the write.
+ * @param channel: pointer to channel.
+ * @param compare: compare value written.
+ * @param timeUs: time of write.
+ * @return None.
+ */
+void MotorPlantModel_WriteCompare(T_MotorPlantModelChannel *channel, uint32_t compare, uint64_t timeUs)
+{
+    channel->pendingCompare = compare;
+    channel->pendingWriteTimeUs = timeUs;
+    channel->isComparePending = true;
+}
+
+/**
+ * @brief Run ESC and motor of a channel up to given time, ESC takes new pulse at start of each PWM period.
+ * @param channel: pointer to channel.
+ * @param timeUs: time to advance to, not before time of last call.
+ * @return None.
+ */
+void MotorPlantModel_Advance(T_MotorPlantModelChannel *channel, uint64_t timeUs)
+{
+    TIM_TypeDef *instance = channel->config->instance;
+    uint64_t periodUs = (uint64_t) (instance->ARR + 1) * (instance->PSC + 1) * 1000000 /
+                        MOTOR_PLANT_MODEL_TIM_CLOCK_HZ;
+
+    //timer is not started by application yet
+    if (instance->ARR == 0) {
+        channel->periodStartUs = timeUs;
+        channel->timeUs = timeUs;
+        return;
+    }
+
+    while (channel->periodStartUs + periodUs <= timeUs) {
+        channel->periodStartUs += periodUs;
+        MotorPlantModel_Integrate(channel, channel->periodStartUs);
+        MotorPlantModel_StartPeriod(channel);
+    }
+    MotorPlantModel_Integrate(channel, timeUs);
+}
+
+/**
+ * @brief Get motor speed.
+ * @param channel: pointer to channel.
+ * @return Speed, unit: rpm.
+ */
+double MotorPlantModel_GetRpm(const T_MotorPlantModelChannel *channel)
+{
+    return channel->speed * MOTOR_PLANT_MODEL_RAD_S_TO_RPM;
+}
+
+/**
+ * @brief Start measuring a step of throttle command, output change and speed are counted from command time.
+ * @param channel: pointer to channel.
+ * @param commandTimeUs: time command is given.
+ * @return None.
+ */
+void MotorPlantModel_StartStep(T_MotorPlantModelChannel *channel, uint64_t commandTimeUs)
+{
+    channel->stepStartThrottle = channel->throttle;
+    channel->isOutputChanged = false;
+    channel->sampleNum = 0;
+    channel->stepCommandTimeUs = commandTimeUs;
+    channel->isStepActive = true;
+}
+
+/**
+ * @brief Take a speed sample of current step at time channel is advanced to, call once per millisecond.
+ * @param channel: pointer to channel.
+ * @return None.
+ */
+void MotorPlantModel_Sample(T_MotorPlantModelChannel *channel)
+{
+    if (!channel->isStepActive || channel->sampleNum >= MOTOR_PLANT_MODEL_STEP_SAMPLE_MAX_NUM ||
+        channel->timeUs < channel->stepCommandTimeUs) {
+        return;
+    }
+
+    channel->sample[channel->sampleNum].timeUs = (uint32_t) (channel->timeUs - channel->stepCommandTimeUs);
+    channel->sample[channel->sampleNum].rpm = (float) MotorPlantModel_GetRpm(channel);
+    channel->sampleNum++;
+}
+
+/**
+ * @brief Stop measuring current step and account its latency and settling time, final speed is the last sample.
+ * @param channel: pointer to channel.
+ * @param result: pointer to result the step is added to.
+ * @return None.
+ */
+void MotorPlantModel_EndStep(T_MotorPlantModelChannel *channel, T_MotorPlantModelResult *result)
+{
+    double finalRpm;
+    double band;
+    uint32_t settlingUs = 0;
+    uint32_t i;
+
+    channel->isStepActive = false;
+
+    if (!channel->isOutputChanged || channel->sampleNum == 0) {
+        result->countOfNoResponse++;
+        return;
+    }
+    if (result->resultNum >= MOTOR_PLANT_MODEL_RESULT_MAX_NUM) {
+        return;
+    }
+
+    finalRpm = channel->sample[channel->sampleNum - 1].rpm;
+    band = finalRpm * MOTOR_PLANT_MODEL_SETTLE_BAND_PERCENT / 100;
+    if (band < MOTOR_PLANT_MODEL_SETTLE_BAND_MIN_RPM) {
+        band = MOTOR_PLANT_MODEL_SETTLE_BAND_MIN_RPM;
+    }
+
+    //settled at first sample after the last one out of band
+    for (i = 0; i < channel->sampleNum; i++) {
+        if (fabs(channel->sample[i].rpm - finalRpm) > band && i + 1 < channel->sampleNum) {
+            settlingUs = channel->sample[i + 1].timeUs;
+        }
+    }
+
+    result->latencyUs[result->resultNum] = channel->latencyUs;
+    result->settlingUs[result->resultNum] = settlingUs;
+    result->resultNum++;
+}
+
+/**
+ * @brief Print percentiles of latency and settling time of a result, values of result are sorted in place.
+ * @param name: name of channel.
+ * @param result: pointer to result.
+ * @return None.
+ */
+void MotorPlantModel_PrintResult(const char *name, T_MotorPlantModelResult *result)
+{
+    printf("[%s] responded %u, no response %u\r\n", name, (unsigned int) result->resultNum,
+           (unsigned int) result->countOfNoResponse);
+    MotorPlantModel_PrintPercentile("command to output latency", result->latencyUs, result->resultNum);
+    MotorPlantModel_PrintPercentile("settling time", result->settlingUs, result->resultNum);
+}
+
+/* Private functions definition-----------------------------------------------*/
+/**
+ * @brief Take pending compare value and turn it into throttle the way ESC reads its input.
+ */
+static void MotorPlantModel_StartPeriod(T_MotorPlantModelChannel *channel)
+{
+    const T_MotorPlantModelChannelConfig *config = channel->config;
+    TIM_TypeDef *instance = config->instance;
+    uint32_t countUs = (instance->PSC + 1) * 1000000 / MOTOR_PLANT_MODEL_TIM_CLOCK_HZ;
+    uint32_t periodCount = instance->ARR + 1;
+    double throttle;
+
+    if (channel->isComparePending && channel->pendingWriteTimeUs < channel->periodStartUs) {
+        channel->compare = channel->pendingCompare;
+        channel->isComparePending = false;
+    }
+
+    //output is active low, line is high for the part of period after compare value
+    channel->pulseUs = channel->compare < periodCount ? (periodCount - channel->compare) * countUs : 0;
+
+    if (config->escInput == MOTOR_PLANT_MODEL_ESC_INPUT_DUTY) {
+        throttle = (double) channel->pulseUs / (periodCount * countUs);
+    } else if (channel->pulseUs <= config->pulseMinUs) {
+        throttle = 0;
+    } else if (channel->pulseUs >= config->pulseMaxUs) {
+        throttle = 1;
+    } else {
+        throttle = (double) (channel->pulseUs - config->pulseMinUs) / (config->pulseMaxUs - config->pulseMinUs);
+    }
+
+    if (channel->isStepActive && !channel->isOutputChanged && channel->periodStartUs >= channel->stepCommandTimeUs &&
+        throttle != channel->stepStartThrottle) {
+        channel->isOutputChanged = true;
+        channel->latencyUs = (uint32_t) (channel->periodStartUs - channel->stepCommandTimeUs);
+    }
+    channel->throttle = throttle;
+}
+
+/**
+ * @brief Integrate motor speed up to given time. Drive torque of motor falls with back emf, prop load rises with
+ * square of speed.
+ */
+static void MotorPlantModel_Integrate(T_MotorPlantModelChannel *channel, uint64_t timeUs)
+{
+    const T_MotorPlantModelMotorConfig *motor = &s_motorPlantModelMotorConfig;
+    double torqueConstant = MOTOR_PLANT_MODEL_RAD_S_TO_RPM / motor->kv;
+    double stepS;
+    double torque;
+
+    while (channel->timeUs < timeUs) {
+        stepS = (double) (timeUs - channel->timeUs < MOTOR_PLANT_MODEL_SUB_STEP_US ?
+                          timeUs - channel->timeUs : MOTOR_PLANT_MODEL_SUB_STEP_US) / 1000000;
+        torque = torqueConstant * (motor->batteryVoltage * channel->throttle - torqueConstant * channel->speed) /
+                 motor->windingResistance - motor->propTorqueCoeff * channel->speed * channel->speed;
+        channel->speed += torque / motor->rotorInertia * stepS;
+        //ESC does not brake, motor only coasts down
+        if (channel->speed < 0) {
+            channel->speed = 0;
+        }
+        channel->timeUs += (uint64_t) (stepS * 1000000 + 0.5);
+    }
+}
+
+static void MotorPlantModel_PrintPercentile(const char *name, uint32_t *value, uint32_t valueNum)
+{
+    if (valueNum == 0) {
+        printf("    %s: no sample\r\n", name);
+        return;
+    }
+
+    //nearest rank percentile
+    qsort(value, valueNum, sizeof(uint32_t), MotorPlantModel_CompareValue);
+    printf("    %s: p50 %u us, p90 %u us, p99 %u us, max %u us\r\n", name,
+           (unsigned int) value[(valueNum * 50 + 99) / 100 - 1], (unsigned int) value[(valueNum * 90 + 99) / 100 - 1],
+           (unsigned int) value[(valueNum * 99 + 99) / 100 - 1], (unsigned int) value[valueNum - 1]);
+}
+
+static int MotorPlantModel_CompareValue(const void *a, const void *b)
+{
+    uint32_t valueA = *(const uint32_t *) a;
+    uint32_t valueB = *(const uint32_t *) b;
+
+    return valueA < valueB ? -1 : (valueA > valueB ? 1 : 0);
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
@@ -0,0 +1,272 @@
+/**
+ ********************************************************************
+ * @file    motor_plant_sim.c
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   Plant of host simulator build. ESCs and motors of motor_plant_model_sim.c are driven by
+ *          compare values written to TIM14 by motor task and to TIM13 by led pwm task, and a bench steps
+ *          throttle widgets to report command to output latency and settling time of whole application.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "motor_plant_sim.h"
+#include "motor_plant_model_sim.h"
+#include "ledpwm.h"
+#include "time_base.h"
+#include "widget/test_widget.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Private constants ---------------------------------------------------------*/
+#define MOTOR_PLANT_SIM_TASK_STACK_SIZE         configMINIMAL_STACK_SIZE
+#define MOTOR_PLANT_SIM_TASK_PRIORITY           (configMAX_PRIORITIES - 1)
+#define MOTOR_PLANT_SIM_BENCH_TASK_STACK_SIZE   configMINIMAL_STACK_SIZE
+#define MOTOR_PLANT_SIM_BENCH_TASK_PRIORITY     0
+
+#define MOTOR_PLANT_SIM_STEP_PERIOD_MS          1
+
+//widgets stepped by bench and arming switch, same as application.c
+#define MOTOR_PLANT_SIM_THROTTLE_WIDGET_INDEX   5
+#define MOTOR_PLANT_SIM_LED_WIDGET_INDEX        3
+#define MOTOR_PLANT_SIM_ARMING_WIDGET_INDEX     7
+
+//wait for application tasks to start, then for min throttle hold of ESC arming
+#define MOTOR_PLANT_SIM_BENCH_START_DELAY_MS    2000
+#define MOTOR_PLANT_SIM_BENCH_ARM_DELAY_MS      3500
+#define MOTOR_PLANT_SIM_BENCH_STEP_HOLD_MS      1000
+#define MOTOR_PLANT_SIM_BENCH_ROUND_NUM         8
+#define MOTOR_PLANT_SIM_BENCH_STEP_NUM          (sizeof(s_motorPlantSimBenchStep) / sizeof(s_motorPlantSimBenchStep[0]))
+
+/* Private types -------------------------------------------------------------*/
+typedef enum {
+    MOTOR_PLANT_SIM_CHANNEL_MOTOR = 0,
+    MOTOR_PLANT_SIM_CHANNEL_LED,
+    MOTOR_PLANT_SIM_CHANNEL_NUM,
+} E_MotorPlantSimChannel;
+
+typedef struct {
+    T_MotorPlantModelChannelConfig model;
+    uint32_t widgetIndex;
+} T_MotorPlantSimChannelConfig;
+
+/* Private values -------------------------------------------------------------*/
+//pulse range is what motor task maps throttle widget to, ESC is calibrated to the same endpoints
+static const T_MotorPlantSimChannelConfig s_motorPlantSimChannelConfig[MOTOR_PLANT_SIM_CHANNEL_NUM] = {
+    {{"motor", GTIM_TIMX_PWM, MOTOR_PLANT_MODEL_ESC_INPUT_PULSE, 600, 1600}, MOTOR_PLANT_SIM_THROTTLE_WIDGET_INDEX},
+    {{"led", GTIM_TIMX_MOTORPWM, MOTOR_PLANT_MODEL_ESC_INPUT_DUTY, 0, 0}, MOTOR_PLANT_SIM_LED_WIDGET_INDEX},
+};
+
+static const int32_t s_motorPlantSimBenchStep[] = {20, 50, 80, 30, 100, 60, 0, 40};
+
+static T_MotorPlantModelChannel s_motorPlantSimChannel[MOTOR_PLANT_SIM_CHANNEL_NUM];
+static T_MotorPlantModelResult s_motorPlantSimBenchResult[MOTOR_PLANT_SIM_CHANNEL_NUM];
+static TaskHandle_t s_motorPlantSimTask;
+static TaskHandle_t s_motorPlantSimBenchTask;
+static FILE *volatile s_motorPlantSimCsvFile = NULL;
+static int32_t s_benchCommand = 0;
+
+/* Private functions declaration ---------------------------------------------*/
+static void MotorPlantSim_Task(void *arg);
+static void MotorPlantSim_BenchTask(void *arg);
+static void MotorPlantSim_OnCompareWrite(TIM_TypeDef *instance, uint32_t channel, uint32_t compare);
+static void MotorPlantSim_PrintReport(void);
+
+/* Exported functions definition ---------------------------------------------*/
+/**
+ * @brief Start plant model and bench if csv path is set by environment, otherwise simulator runs without plant.
+ * @note Call before scheduler starts.
+ * @return None.
+ */
+void MotorPlantSim_Init(void)
+{
+    const char *path = getenv(MOTOR_PLANT_SIM_CSV_ENV_NAME);
+    uint32_t i;
+
+    if (path == NULL) {
+        return;
+    }
+
+    s_motorPlantSimCsvFile = fopen(path, "w");
+    if (s_motorPlantSimCsvFile == NULL) {
+        printf("motor plant sim open %s error\r\n", path);
+        return;
+    }
+    fprintf(s_motorPlantSimCsvFile, "time_us,command");
+    for (i = 0; i < MOTOR_PLANT_SIM_CHANNEL_NUM; i++) {
+        fprintf(s_motorPlantSimCsvFile, ",%s_compare,%s_pulse_us,%s_throttle,%s_rpm",
+                s_motorPlantSimChannelConfig[i].model.name, s_motorPlantSimChannelConfig[i].model.name,
+                s_motorPlantSimChannelConfig[i].model.name, s_motorPlantSimChannelConfig[i].model.name);
+    }
+    fprintf(s_motorPlantSimCsvFile, "\n");
+
+    for (i = 0; i < MOTOR_PLANT_SIM_CHANNEL_NUM; i++) {
+        MotorPlantModel_Init(&s_motorPlantSimChannel[i], &s_motorPlantSimChannelConfig[i].model, 0);
+    }
+    TimSim_RegCompareWriteCallback(MotorPlantSim_OnCompareWrite);
+
+    xTaskCreate(MotorPlantSim_Task, "motorPlant_sim", MOTOR_PLANT_SIM_TASK_STACK_SIZE,
+                NULL, MOTOR_PLANT_SIM_TASK_PRIORITY, &s_motorPlantSimTask);
+    xTaskCreate(MotorPlantSim_BenchTask, "motorPlant_bench", MOTOR_PLANT_SIM_BENCH_TASK_STACK_SIZE,
+                NULL, MOTOR_PLANT_SIM_BENCH_TASK_PRIORITY, &s_motorPlantSimBenchTask);
+
+    printf("motor plant sim bench started, csv is written to %s\r\n", path);
+}
+
+/* Private functions definition-----------------------------------------------*/
+#ifndef __CC_ARM
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-noreturn"
+#pragma GCC diagnostic ignored "-Wreturn-type"
+#endif
+
+static void MotorPlantSim_Task(void *arg)
+{
+    T_MotorPlantModelChannel *channel;
+    uint64_t timeUs;
+    uint32_t i;
+    FILE *file;
+
+    (void) arg;
+
+    timeUs = TimeBase_GetUs();
+    taskENTER_CRITICAL();
+    for (i = 0; i < MOTOR_PLANT_SIM_CHANNEL_NUM; i++) {
+        s_motorPlantSimChannel[i].periodStartUs = timeUs;
+        s_motorPlantSimChannel[i].timeUs = timeUs;
+    }
+    taskEXIT_CRITICAL();
+
+    while (1) {
+        vTaskDelay(pdMS_TO_TICKS(MOTOR_PLANT_SIM_STEP_PERIOD_MS));
+        timeUs = TimeBase_GetUs();
+
+        taskENTER_CRITICAL();
+        for (i = 0; i < MOTOR_PLANT_SIM_CHANNEL_NUM; i++) {
+            MotorPlantModel_Advance(&s_motorPlantSimChannel[i], timeUs);
+            MotorPlantModel_Sample(&s_motorPlantSimChannel[i]);
+        }
+        taskEXIT_CRITICAL();
+
+        //bench closes file when done, rows of this turn are dropped then
+        file = s_motorPlantSimCsvFile;
+        if (file == NULL) {
+            continue;
+        }
+        fprintf(file, "%llu,%d", (unsigned long long) timeUs, (int) s_benchCommand);
+        for (i = 0; i < MOTOR_PLANT_SIM_CHANNEL_NUM; i++) {
+            channel = &s_motorPlantSimChannel[i];
+            fprintf(file, ",%u,%u,%.4f,%.1f", (unsigned int) channel->compare, (unsigned int) channel->pulseUs,
+                    channel->throttle, MotorPlantModel_GetRpm(channel));
+        }
+        fprintf(file, "\n");
+    }
+}
+
+static void MotorPlantSim_BenchTask(void *arg)
+{
+    uint64_t commandTimeUs;
+    uint32_t round;
+    uint32_t step;
+    uint32_t i;
+    FILE *file;
+
+    (void) arg;
+
+    vTaskDelay(pdMS_TO_TICKS(MOTOR_PLANT_SIM_BENCH_START_DELAY_MS));
+    //motor channel only follows throttle once ESC is armed, which also needs a live link on the payload sdk uart
+    DjiTest_WidgetInjectValue(DJI_WIDGET_TYPE_SWITCH, MOTOR_PLANT_SIM_ARMING_WIDGET_INDEX, 1);
+    vTaskDelay(pdMS_TO_TICKS(MOTOR_PLANT_SIM_BENCH_ARM_DELAY_MS));
+
+    for (round = 0; round < MOTOR_PLANT_SIM_BENCH_ROUND_NUM; round++) {
+        for (step = 0; step < MOTOR_PLANT_SIM_BENCH_STEP_NUM; step++) {
+            taskENTER_CRITICAL();
+            //time of samples is counted from command, take it from the same clock as plant
+            commandTimeUs = TimeBase_GetUs();
+            for (i = 0; i < MOTOR_PLANT_SIM_CHANNEL_NUM; i++) {
+                MotorPlantModel_StartStep(&s_motorPlantSimChannel[i], commandTimeUs);
+            }
+            s_benchCommand = s_motorPlantSimBenchStep[step];
+            taskEXIT_CRITICAL();
+
+            for (i = 0; i < MOTOR_PLANT_SIM_CHANNEL_NUM; i++) {
+                DjiTest_WidgetInjectValue(DJI_WIDGET_TYPE_SCALE, s_motorPlantSimChannelConfig[i].widgetIndex,
+                                          s_motorPlantSimBenchStep[step]);
+            }
+            vTaskDelay(pdMS_TO_TICKS(MOTOR_PLANT_SIM_BENCH_STEP_HOLD_MS));
+
+            taskENTER_CRITICAL();
+            for (i = 0; i < MOTOR_PLANT_SIM_CHANNEL_NUM; i++) {
+                MotorPlantModel_EndStep(&s_motorPlantSimChannel[i], &s_motorPlantSimBenchResult[i]);
+            }
+            taskEXIT_CRITICAL();
+        }
+    }
+
+    file = s_motorPlantSimCsvFile;
+    s_motorPlantSimCsvFile = NULL;
+    fclose(file);
+
+    MotorPlantSim_PrintReport();
+    //bench is meant to be run from scripts, leave with the report as last output
+    exit(0);
+}
+
+#ifndef __CC_ARM
+#pragma GCC diagnostic pop
+#endif
+
+/**
+ * @brief Record compare write of a plant channel, called in the task that writes compare value.
+ */
+static void MotorPlantSim_OnCompareWrite(TIM_TypeDef *instance, uint32_t channel, uint32_t compare)
+{
+    uint64_t timeUs = TimeBase_GetUs();
+    uint32_t i;
+
+    (void) channel;
+
+    for (i = 0; i < MOTOR_PLANT_SIM_CHANNEL_NUM; i++) {
+        if (s_motorPlantSimChannelConfig[i].model.instance != instance) {
+            continue;
+        }
+
+        taskENTER_CRITICAL();
+        MotorPlantModel_WriteCompare(&s_motorPlantSimChannel[i], compare, timeUs);
+        taskEXIT_CRITICAL();
+    }
+}
+
+static void MotorPlantSim_PrintReport(void)
+{
+    uint32_t i;
+
+    printf("motor plant sim bench report, %d steps of %d ms per channel\r\n",
+           (int) (MOTOR_PLANT_SIM_BENCH_ROUND_NUM * MOTOR_PLANT_SIM_BENCH_STEP_NUM),
+           MOTOR_PLANT_SIM_BENCH_STEP_HOLD_MS);
+
+    for (i = 0; i < MOTOR_PLANT_SIM_CHANNEL_NUM; i++) {
+        MotorPlantModel_PrintResult(s_motorPlantSimChannelConfig[i].model.name, &s_motorPlantSimBenchResult[i]);
+    }
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
@@ -0,0 +1,195 @@
+/**
+ ********************************************************************
+ * @file    motor_pwm_sim.c
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   ESC PWM output of host simulator build, replaces motor_pwm.c. Ramp update runs in
+ *          a task woken once per PWM period instead of timer update interrupt.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <time.h>
+#include "motor_pwm.h"
+#include "ledpwm.h"
+#include "time_base.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Private constants ---------------------------------------------------------*/
+#define MOTOR_PWM_SIM_TASK_STACK_SIZE       configMINIMAL_STACK_SIZE
+#define MOTOR_PWM_SIM_TASK_PRIORITY         (configMAX_PRIORITIES - 1)
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private values -------------------------------------------------------------*/
+extern TIM_HandleTypeDef g_timx_pwm_chy_handle;
+
+static T_ThrottleRamp s_motorPwmRamp[MOTOR_PWM_CHANNEL_NUM];
+static TaskHandle_t s_motorPwmSimTask;
+static uint32_t s_countOfUpdate = 0;
+static uint64_t s_sumOfUpdateCostNs = 0;
+static uint32_t s_maxUpdateCostNs = 0;
+static uint64_t s_changeTimeUs[MOTOR_PWM_CHANNEL_NUM];
+static uint32_t s_countOfLatency = 0;
+static uint64_t s_sumOfLatencyUs = 0;
+static uint32_t s_maxLatencyUs = 0;
+
+/* Private functions declaration ---------------------------------------------*/
+static void MotorPwm_SimTask(void *arg);
+static uint64_t MotorPwm_GetMonotonicNs(void);
+
+/* Exported functions definition ---------------------------------------------*/
+void MotorPwm_Init(const T_ThrottleRampConfig *rampConfig, uint16_t initCompare)
+{
+    uint32_t i;
+
+    gtim_timx_pwm_chy_init(MOTOR_PWM_PERIOD_COUNT - 1, MOTOR_PWM_PRESCALER - 1);
+
+    for (i = 0; i < MOTOR_PWM_CHANNEL_NUM; i++) {
+        ThrottleRamp_Init(&s_motorPwmRamp[i], rampConfig, initCompare);
+    }
+    __HAL_TIM_SET_COMPARE(&g_timx_pwm_chy_handle, GTIM_TIMX_PWM_CHY, initCompare);
+
+    xTaskCreate(MotorPwm_SimTask, "motorPwm_sim", MOTOR_PWM_SIM_TASK_STACK_SIZE,
+                NULL, MOTOR_PWM_SIM_TASK_PRIORITY, &s_motorPwmSimTask);
+}
+
+void MotorPwm_SetTarget(E_MotorPwmChannel channel, uint16_t compare)
+{
+    if (channel >= MOTOR_PWM_CHANNEL_NUM) {
+        return;
+    }
+
+    ThrottleRamp_SetTarget(&s_motorPwmRamp[channel], compare);
+}
+
+void MotorPwm_JumpTarget(E_MotorPwmChannel channel, uint16_t compare)
+{
+    if (channel >= MOTOR_PWM_CHANNEL_NUM) {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    ThrottleRamp_Jump(&s_motorPwmRamp[channel], compare);
+    __HAL_TIM_SET_COMPARE(&g_timx_pwm_chy_handle, GTIM_TIMX_PWM_CHY, compare);
+    taskEXIT_CRITICAL();
+}
+
+void MotorPwm_StampTarget(E_MotorPwmChannel channel, uint64_t changeTimeUs)
+{
+    if (channel >= MOTOR_PWM_CHANNEL_NUM || changeTimeUs == 0) {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    if (s_changeTimeUs[channel] == 0) {
+        s_changeTimeUs[channel] = changeTimeUs;
+    }
+    taskEXIT_CRITICAL();
+}
+
+uint16_t MotorPwm_GetCompare(E_MotorPwmChannel channel)
+{
+    if (channel >= MOTOR_PWM_CHANNEL_NUM) {
+        return 0;
+    }
+
+    return s_motorPwmRamp[channel].current;
+}
+
+void MotorPwm_GetUpdateCost(T_MotorPwmUpdateCost *cost)
+{
+    taskENTER_CRITICAL();
+    cost->countOfUpdate = s_countOfUpdate;
+    cost->averageCostNs = s_countOfUpdate != 0 ? (uint32_t) (s_sumOfUpdateCostNs / s_countOfUpdate) : 0;
+    cost->maxCostNs = s_maxUpdateCostNs;
+    taskEXIT_CRITICAL();
+}
+
+void MotorPwm_GetOutputLatency(T_MotorPwmOutputLatency *latency)
+{
+    taskENTER_CRITICAL();
+    latency->countOfLatency = s_countOfLatency;
+    latency->averageLatencyUs = s_countOfLatency != 0 ? (uint32_t) (s_sumOfLatencyUs / s_countOfLatency) : 0;
+    latency->maxLatencyUs = s_maxLatencyUs;
+    taskEXIT_CRITICAL();
+}
+
+/* Private functions definition-----------------------------------------------*/
+#ifndef __CC_ARM
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-noreturn"
+#pragma GCC diagnostic ignored "-Wreturn-type"
+#endif
+
+static void MotorPwm_SimTask(void *arg)
+{
+    uint64_t startNs;
+    uint32_t costNs;
+    uint16_t compare;
+    uint32_t latencyUs;
+
+    (void) arg;
+
+    while (1) {
+        //vTaskDelayUntil is not built in simulator, a late period is not made up
+        vTaskDelay(pdMS_TO_TICKS(1000 / MOTOR_PWM_UPDATE_FREQ_HZ));
+
+        startNs = MotorPwm_GetMonotonicNs();
+        compare = ThrottleRamp_Update(&s_motorPwmRamp[MOTOR_PWM_CHANNEL_THROTTLE]);
+        __HAL_TIM_SET_COMPARE(&g_timx_pwm_chy_handle, GTIM_TIMX_PWM_CHY, compare);
+        costNs = (uint32_t) (MotorPwm_GetMonotonicNs() - startNs);
+
+        taskENTER_CRITICAL();
+        s_countOfUpdate++;
+        s_sumOfUpdateCostNs += costNs;
+        if (costNs > s_maxUpdateCostNs) {
+            s_maxUpdateCostNs = costNs;
+        }
+        //simulated timer has no preload, target is output as soon as it is written
+        if (s_changeTimeUs[MOTOR_PWM_CHANNEL_THROTTLE] != 0 &&
+            compare == s_motorPwmRamp[MOTOR_PWM_CHANNEL_THROTTLE].target) {
+            latencyUs = (uint32_t) (TimeBase_GetUs() - s_changeTimeUs[MOTOR_PWM_CHANNEL_THROTTLE]);
+            s_countOfLatency++;
+            s_sumOfLatencyUs += latencyUs;
+            if (latencyUs > s_maxLatencyUs) {
+                s_maxLatencyUs = latencyUs;
+            }
+            s_changeTimeUs[MOTOR_PWM_CHANNEL_THROTTLE] = 0;
+        }
+        taskEXIT_CRITICAL();
+    }
+}
+
+#ifndef __CC_ARM
+#pragma GCC diagnostic pop
+#endif
+
+static uint64_t MotorPwm_GetMonotonicNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
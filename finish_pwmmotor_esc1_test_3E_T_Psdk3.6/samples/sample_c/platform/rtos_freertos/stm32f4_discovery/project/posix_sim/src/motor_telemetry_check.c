@@ -0,0 +1,297 @@
+/**
+ ********************************************************************
+ * @file    motor_telemetry_check.c
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   Host check of motor telemetry filtering, synthetic captures of known pulse widths and tachometer
+ *          periods go in and filtered pulse width and speed are checked, including counter and buffer
+ *          wrap-around, signal dropout and recovery.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdint.h>
+#include "motor_capture.h"
+#include "motor_capture_signal_sim.h"
+
+/* Private constants ---------------------------------------------------------*/
+#define MOTOR_TELEMETRY_CHECK_PULSE_BUFFER_LEN  (MOTOR_CAPTURE_PULSE_RECORD_NUM * MOTOR_TELEMETRY_PULSE_RECORD_LEN)
+#define MOTOR_TELEMETRY_CHECK_UPDATE_PERIOD_US  (MOTOR_TELEMETRY_CAPTURE_FREQ_HZ / MOTOR_TELEMETRY_UPDATE_FREQ_HZ)
+#define MOTOR_TELEMETRY_CHECK_US_PER_MINUTE     60000000U
+//same configuration as motor capture of application.c
+#define MOTOR_TELEMETRY_CHECK_FILTER_SHIFT      3
+#define MOTOR_TELEMETRY_CHECK_TACH_EDGE_PER_REV 7
+#define MOTOR_TELEMETRY_CHECK_TIMEOUT_MS        50
+
+/* Private types -------------------------------------------------------------*/
+typedef struct {
+    uint16_t pulseBuffer[MOTOR_TELEMETRY_CHECK_PULSE_BUFFER_LEN];
+    uint16_t tachBuffer[MOTOR_CAPTURE_TACH_EDGE_NUM];
+    T_MotorCaptureSignalSim signal;
+    T_MotorTelemetry telemetry;
+} T_MotorTelemetryCheckRig;
+
+typedef struct {
+    uint16_t minPulseWidthUs;
+    uint16_t maxPulseWidthUs;
+    uint16_t minPulsePeriodUs;
+    uint16_t maxPulsePeriodUs;
+    uint32_t minRpm;
+    uint32_t maxRpm;
+    bool isPulseWidthDecreased; /*!< Filtered width went down at least once during run. */
+} T_MotorTelemetryCheckStat;
+
+/* Private values -------------------------------------------------------------*/
+static T_MotorTelemetryCheckRig s_rig;
+static int s_isFail = 0;
+
+/* Private functions declaration ---------------------------------------------*/
+static void MotorTelemetryCheck_Steady(uint16_t pulseWidthUs, uint16_t pulsePeriodUs, uint32_t tachPeriodUs);
+static void MotorTelemetryCheck_WrapAround(void);
+static void MotorTelemetryCheck_FilterStep(void);
+static void MotorTelemetryCheck_Dropout(void);
+static void MotorTelemetryCheck_InitRig(void);
+static void MotorTelemetryCheck_Run(uint32_t durationMs, uint32_t pulseWidthUs, uint32_t pulsePeriodUs,
+                                    uint32_t tachPeriodUs, T_MotorTelemetryCheckStat *stat);
+static uint32_t MotorTelemetryCheck_GetRpm(uint32_t tachPeriodUs);
+static void MotorTelemetryCheck_Expect(const char *name, bool isPass, uint32_t value, uint32_t expect);
+
+/* Exported functions definition ---------------------------------------------*/
+int main(void)
+{
+    //ESC PWM at 50 Hz and 400 Hz, tachometer from 60 ms down to 250 us between edges
+    MotorTelemetryCheck_Steady(1500, 20000, 1000);
+    MotorTelemetryCheck_Steady(1000, 2500, 250);
+    MotorTelemetryCheck_Steady(1999, 2000, 5000);
+    MotorTelemetryCheck_Steady(600, 20000, 40000);
+    MotorTelemetryCheck_WrapAround();
+    MotorTelemetryCheck_FilterStep();
+    MotorTelemetryCheck_Dropout();
+
+    printf("%s\r\n", s_isFail ? "CHECK FAIL" : "CHECK PASS");
+
+    return s_isFail;
+}
+
+/* Private functions definition-----------------------------------------------*/
+/**
+ * @brief Check constant pulse and speed, filter of a constant input must give the exact value.
+ * @param pulseWidthUs: width of pulse.
+ * @param pulsePeriodUs: period of pulse.
+ * @param tachPeriodUs: interval of tachometer edges.
+ * @return None.
+ */
+static void MotorTelemetryCheck_Steady(uint16_t pulseWidthUs, uint16_t pulsePeriodUs, uint32_t tachPeriodUs)
+{
+    T_MotorTelemetryCheckStat stat;
+    uint32_t durationMs = 500;
+    uint32_t expectRpm = MotorTelemetryCheck_GetRpm(tachPeriodUs);
+    uint32_t expectPulseNum;
+
+    printf("steady pulse %u/%u us, tachometer %u us, %u rpm:\r\n", pulseWidthUs, pulsePeriodUs, tachPeriodUs,
+           expectRpm);
+    MotorTelemetryCheck_InitRig();
+    MotorTelemetryCheck_Run(durationMs, pulseWidthUs, pulsePeriodUs, tachPeriodUs, &stat);
+
+    MotorTelemetryCheck_Expect("  pulse width", s_rig.telemetry.value.pulseWidthUs == pulseWidthUs,
+                               s_rig.telemetry.value.pulseWidthUs, pulseWidthUs);
+    MotorTelemetryCheck_Expect("  pulse period", s_rig.telemetry.value.pulsePeriodUs == pulsePeriodUs,
+                               s_rig.telemetry.value.pulsePeriodUs, pulsePeriodUs);
+    MotorTelemetryCheck_Expect("  rpm", s_rig.telemetry.value.rpm == expectRpm, s_rig.telemetry.value.rpm,
+                               expectRpm);
+
+    //first rising edge only starts measuring, every later one completes a pulse
+    expectPulseNum = (durationMs * 1000 - 1) / pulsePeriodUs;
+    MotorTelemetryCheck_Expect("  pulse count", s_rig.telemetry.value.countOfPulse == expectPulseNum,
+                               s_rig.telemetry.value.countOfPulse, expectPulseNum);
+}
+
+/**
+ * @brief Check values stay exact while 16 bit capture counter and capture buffers wrap many times.
+ * @return None.
+ */
+static void MotorTelemetryCheck_WrapAround(void)
+{
+    T_MotorTelemetryCheckStat stat;
+    uint32_t expectRpm = MotorTelemetryCheck_GetRpm(777);
+
+    //period is not a divisor of 65536, so edges fall on every phase of counter wrap
+    printf("wrap-around, 10 s of pulse 1234/2500 us and tachometer 777 us:\r\n");
+    MotorTelemetryCheck_InitRig();
+    MotorTelemetryCheck_Run(100, 1234, 2500, 777, &stat);
+    MotorTelemetryCheck_Run(10000, 1234, 2500, 777, &stat);
+
+    MotorTelemetryCheck_Expect("  min pulse width", stat.minPulseWidthUs == 1234, stat.minPulseWidthUs, 1234);
+    MotorTelemetryCheck_Expect("  max pulse width", stat.maxPulseWidthUs == 1234, stat.maxPulseWidthUs, 1234);
+    MotorTelemetryCheck_Expect("  min pulse period", stat.minPulsePeriodUs == 2500, stat.minPulsePeriodUs, 2500);
+    MotorTelemetryCheck_Expect("  max pulse period", stat.maxPulsePeriodUs == 2500, stat.maxPulsePeriodUs, 2500);
+    //one update covers a non-integer count of edges, average of span keeps rpm within a count of exact value
+    MotorTelemetryCheck_Expect("  min rpm", stat.minRpm + 1 >= expectRpm, stat.minRpm, expectRpm);
+    MotorTelemetryCheck_Expect("  max rpm", stat.maxRpm <= expectRpm + 1, stat.maxRpm, expectRpm);
+}
+
+/**
+ * @brief Check step of pulse width, filter takes 1/2^shift of difference per pulse and never overshoots.
+ * @return None.
+ */
+static void MotorTelemetryCheck_FilterStep(void)
+{
+    T_MotorTelemetryCheckStat stat;
+    uint16_t expectFirst = 1000 + (1000 >> MOTOR_TELEMETRY_CHECK_FILTER_SHIFT);
+
+    printf("filter step, pulse 1000 us to 2000 us at 400 Hz:\r\n");
+    MotorTelemetryCheck_InitRig();
+    MotorTelemetryCheck_Run(100, 1000, 2500, 0, &stat);
+
+    //one more pulse of new width is completed within 3 ms
+    MotorTelemetryCheck_Run(3, 2000, 2500, 0, &stat);
+    MotorTelemetryCheck_Expect("  first sample", s_rig.telemetry.value.pulseWidthUs == expectFirst,
+                               s_rig.telemetry.value.pulseWidthUs, expectFirst);
+
+    MotorTelemetryCheck_Run(200, 2000, 2500, 0, &stat);
+    MotorTelemetryCheck_Expect("  monotonic", !stat.isPulseWidthDecreased, stat.isPulseWidthDecreased, 0);
+    MotorTelemetryCheck_Expect("  no overshoot", stat.maxPulseWidthUs <= 2000, stat.maxPulseWidthUs, 2000);
+    //integer filter stops up to 2^shift - 1 scaled counts below input, i.e. less than one us
+    MotorTelemetryCheck_Expect("  settled", s_rig.telemetry.value.pulseWidthUs >= 1999,
+                               s_rig.telemetry.value.pulseWidthUs, 2000);
+    MotorTelemetryCheck_Expect("  rpm without tachometer", s_rig.telemetry.value.rpm == 0,
+                               s_rig.telemetry.value.rpm, 0);
+}
+
+/**
+ * @brief Check that values are cleared after signal timeout and measured again when signal comes back, with no
+ * sample spanning the dropout.
+ * @return None.
+ */
+static void MotorTelemetryCheck_Dropout(void)
+{
+    T_MotorTelemetryCheckStat stat;
+    uint32_t expectRpm = MotorTelemetryCheck_GetRpm(1000);
+
+    printf("dropout of %u ms timeout, pulse 1500/20000 us, tachometer 1000 us:\r\n",
+           MOTOR_TELEMETRY_CHECK_TIMEOUT_MS);
+    MotorTelemetryCheck_InitRig();
+    MotorTelemetryCheck_Run(200, 1500, 20000, 1000, &stat);
+
+    //values are kept while signal is gone for less than timeout
+    MotorTelemetryCheck_Run(MOTOR_TELEMETRY_CHECK_TIMEOUT_MS / 2, 0, 0, 0, &stat);
+    MotorTelemetryCheck_Expect("  pulse width before timeout", s_rig.telemetry.value.pulseWidthUs == 1500,
+                               s_rig.telemetry.value.pulseWidthUs, 1500);
+    MotorTelemetryCheck_Expect("  rpm before timeout", s_rig.telemetry.value.rpm == expectRpm,
+                               s_rig.telemetry.value.rpm, expectRpm);
+
+    MotorTelemetryCheck_Run(MOTOR_TELEMETRY_CHECK_TIMEOUT_MS * 2, 0, 0, 0, &stat);
+    MotorTelemetryCheck_Expect("  pulse width after timeout", s_rig.telemetry.value.pulseWidthUs == 0,
+                               s_rig.telemetry.value.pulseWidthUs, 0);
+    MotorTelemetryCheck_Expect("  pulse period after timeout", s_rig.telemetry.value.pulsePeriodUs == 0,
+                               s_rig.telemetry.value.pulsePeriodUs, 0);
+    MotorTelemetryCheck_Expect("  rpm after timeout", s_rig.telemetry.value.rpm == 0, s_rig.telemetry.value.rpm, 0);
+
+    //first edges after dropout only restart measuring, a value must be either not measured yet or exact
+    MotorTelemetryCheck_Run(200, 1500, 20000, 1000, &stat);
+    MotorTelemetryCheck_Expect("  pulse width after recovery", stat.maxPulseWidthUs == 1500, stat.maxPulseWidthUs,
+                               1500);
+    MotorTelemetryCheck_Expect("  pulse period after recovery", stat.maxPulsePeriodUs == 20000,
+                               stat.maxPulsePeriodUs, 20000);
+    MotorTelemetryCheck_Expect("  rpm after recovery", stat.maxRpm == expectRpm && stat.minRpm == 0 &&
+                               s_rig.telemetry.value.rpm == expectRpm, stat.maxRpm, expectRpm);
+    MotorTelemetryCheck_Expect("  pulse width recovered", s_rig.telemetry.value.pulseWidthUs == 1500,
+                               s_rig.telemetry.value.pulseWidthUs, 1500);
+}
+
+static void MotorTelemetryCheck_InitRig(void)
+{
+    T_MotorTelemetryConfig config = {
+        .filterShift = MOTOR_TELEMETRY_CHECK_FILTER_SHIFT,
+        .tachEdgePerRev = MOTOR_TELEMETRY_CHECK_TACH_EDGE_PER_REV,
+        .signalTimeoutMs = MOTOR_TELEMETRY_CHECK_TIMEOUT_MS,
+    };
+
+    MotorTelemetry_Init(&s_rig.telemetry, &config);
+    MotorCaptureSignalSim_Init(&s_rig.signal, s_rig.pulseBuffer, MOTOR_TELEMETRY_CHECK_PULSE_BUFFER_LEN,
+                               s_rig.tachBuffer, MOTOR_CAPTURE_TACH_EDGE_NUM);
+}
+
+/**
+ * @brief Advance signal and update telemetry once per update period, the way capture of target does.
+ * @param durationMs: time to run.
+ * @param pulseWidthUs: width of pulse.
+ * @param pulsePeriodUs: period of pulse, 0 for no pulse.
+ * @param tachPeriodUs: interval of tachometer edges, 0 for none.
+ * @param stat: range of values during run.
+ * @return None.
+ */
+static void MotorTelemetryCheck_Run(uint32_t durationMs, uint32_t pulseWidthUs, uint32_t pulsePeriodUs,
+                                    uint32_t tachPeriodUs, T_MotorTelemetryCheckStat *stat)
+{
+    T_MotorTelemetryCapture pulseCapture = {s_rig.pulseBuffer, MOTOR_TELEMETRY_CHECK_PULSE_BUFFER_LEN, 0};
+    T_MotorTelemetryCapture tachCapture = {s_rig.tachBuffer, MOTOR_CAPTURE_TACH_EDGE_NUM, 0};
+    const T_MotorTelemetryValue *value = &s_rig.telemetry.value;
+    uint16_t lastPulseWidthUs = value->pulseWidthUs;
+    uint32_t i;
+
+    stat->minPulseWidthUs = UINT16_MAX;
+    stat->maxPulseWidthUs = 0;
+    stat->minPulsePeriodUs = UINT16_MAX;
+    stat->maxPulsePeriodUs = 0;
+    stat->minRpm = UINT32_MAX;
+    stat->maxRpm = 0;
+    stat->isPulseWidthDecreased = false;
+
+    for (i = 0; i < durationMs * MOTOR_TELEMETRY_UPDATE_FREQ_HZ / 1000; i++) {
+        MotorCaptureSignalSim_Advance(&s_rig.signal, MOTOR_TELEMETRY_CHECK_UPDATE_PERIOD_US, pulseWidthUs,
+                                      pulsePeriodUs, tachPeriodUs);
+        pulseCapture.writeIndex = s_rig.signal.pulseWriteIndex;
+        tachCapture.writeIndex = s_rig.signal.tachWriteIndex;
+        MotorTelemetry_Update(&s_rig.telemetry, &pulseCapture, &tachCapture);
+
+        stat->minPulseWidthUs = value->pulseWidthUs < stat->minPulseWidthUs ? value->pulseWidthUs :
+                                stat->minPulseWidthUs;
+        stat->maxPulseWidthUs = value->pulseWidthUs > stat->maxPulseWidthUs ? value->pulseWidthUs :
+                                stat->maxPulseWidthUs;
+        stat->minPulsePeriodUs = value->pulsePeriodUs < stat->minPulsePeriodUs ? value->pulsePeriodUs :
+                                 stat->minPulsePeriodUs;
+        stat->maxPulsePeriodUs = value->pulsePeriodUs > stat->maxPulsePeriodUs ? value->pulsePeriodUs :
+                                 stat->maxPulsePeriodUs;
+        stat->minRpm = value->rpm < stat->minRpm ? value->rpm : stat->minRpm;
+        stat->maxRpm = value->rpm > stat->maxRpm ? value->rpm : stat->maxRpm;
+        if (value->pulseWidthUs < lastPulseWidthUs) {
+            stat->isPulseWidthDecreased = true;
+        }
+        lastPulseWidthUs = value->pulseWidthUs;
+    }
+}
+
+static uint32_t MotorTelemetryCheck_GetRpm(uint32_t tachPeriodUs)
+{
+    return MOTOR_TELEMETRY_CHECK_US_PER_MINUTE / (tachPeriodUs * MOTOR_TELEMETRY_CHECK_TACH_EDGE_PER_REV);
+}
+
+static void MotorTelemetryCheck_Expect(const char *name, bool isPass, uint32_t value, uint32_t expect)
+{
+    printf("%-32s %8u, expect %8u%s\r\n", name, value, expect, isPass ? "" : "  FAIL");
+    if (!isPass) {
+        s_isFail = 1;
+    }
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
@@ -0,0 +1,407 @@
+/**
+ ********************************************************************
+ * @file    mp_ringbuffer_bench.c
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   Host stress test and benchmark of the multi-producer ring buffer used by UART_Write, several threads
+ *          put tagged bytes concurrently against one consumer, compared with the mutex and T_RingBuffer it replaced.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include "dji_mp_ringbuffer.h"
+#include "dji_ringbuffer.h"
+
+/* Private constants ---------------------------------------------------------*/
+//same size as write buffer of UART2 and UART3
+#define MP_RINGBUFFER_BENCH_BUFFER_SIZE         2048
+#define MP_RINGBUFFER_BENCH_PRODUCER_NUM_MAX    8
+#define MP_RINGBUFFER_BENCH_STRESS_BYTES        (1024 * 1024)
+#define MP_RINGBUFFER_BENCH_STRESS_CHUNK_MAX    64
+#define MP_RINGBUFFER_BENCH_BYTES               (8 * 1024 * 1024)
+//typical length of a log line written to UART
+#define MP_RINGBUFFER_BENCH_CHUNK_SIZE          32
+#define MP_RINGBUFFER_BENCH_READ_SIZE           512
+//every byte carries its producer in high nibble and a running counter in low nibble, consumer marks bytes it has
+//handled in place with a producer that never exists, so data exposed before it was written can't pass the check
+#define MP_RINGBUFFER_BENCH_POISON              0xFF
+
+/* Private types -------------------------------------------------------------*/
+typedef enum {
+    MP_RINGBUFFER_BENCH_LOCK_FREE = 0,
+    MP_RINGBUFFER_BENCH_MUTEX,
+} E_MpRingBufferBenchMode;
+
+typedef struct {
+    E_MpRingBufferBenchMode mode;
+    T_MpRingBuffer mpRingBuffer;
+    T_RingBuffer ringBuffer;
+    pthread_mutex_t mutex;
+    uint32_t producerNum;
+    uint32_t bytesPerProducer;
+    uint32_t chunkMax;
+    int isRandomChunk;
+} T_MpRingBufferBenchShared;
+
+typedef struct {
+    T_MpRingBufferBenchShared *shared;
+    uint32_t producerId;
+    uint32_t partialPutCount;
+    uint32_t putCount;
+} T_MpRingBufferBenchProducer;
+
+typedef struct {
+    T_MpRingBufferBenchShared *shared;
+    uint32_t receivedLen[MP_RINGBUFFER_BENCH_PRODUCER_NUM_MAX];
+    uint32_t errorCount;
+    uint32_t emptyPollCount;
+} T_MpRingBufferBenchConsumer;
+
+/* Private values -------------------------------------------------------------*/
+static uint8_t s_benchBuffer[MP_RINGBUFFER_BENCH_BUFFER_SIZE];
+
+/* Private functions declaration ---------------------------------------------*/
+static int MpRingBufferBench_CheckStalledProducer(void);
+static int MpRingBufferBench_Run(T_MpRingBufferBenchShared *shared, double *seconds, uint32_t *partialPutCount);
+static void *MpRingBufferBench_ProducerTask(void *arg);
+static void *MpRingBufferBench_ConsumerTask(void *arg);
+static uint32_t MpRingBufferBench_Put(T_MpRingBufferBenchShared *shared, const uint8_t *data, uint32_t len);
+static void MpRingBufferBench_CheckBytes(T_MpRingBufferBenchConsumer *consumer, const uint8_t *data, uint32_t len);
+static uint64_t MpRingBufferBench_GetMonotonicNs(void);
+
+/* Exported functions definition ---------------------------------------------*/
+int main(void)
+{
+    static const uint32_t producerNum[] = {1, 2, 4, 8};
+    T_MpRingBufferBenchShared *shared;
+    double seconds[2];
+    uint32_t partialPutCount;
+    int isFail = 0;
+    uint32_t i;
+
+    shared = calloc(1, sizeof(T_MpRingBufferBenchShared));
+    if (shared == NULL) {
+        printf("mp ringbuffer bench: out of memory\r\n");
+        return 1;
+    }
+    pthread_mutex_init(&shared->mutex, NULL);
+
+    if (MpRingBufferBench_CheckStalledProducer() != 0) {
+        isFail = 1;
+    }
+
+    printf("stress, %d bytes per producer in chunks of 1 to %d bytes, ring of %d bytes:\r\n",
+           MP_RINGBUFFER_BENCH_STRESS_BYTES, MP_RINGBUFFER_BENCH_STRESS_CHUNK_MAX, MP_RINGBUFFER_BENCH_BUFFER_SIZE);
+    for (i = 0; i < sizeof(producerNum) / sizeof(producerNum[0]); i++) {
+        shared->mode = MP_RINGBUFFER_BENCH_LOCK_FREE;
+        shared->producerNum = producerNum[i];
+        shared->bytesPerProducer = MP_RINGBUFFER_BENCH_STRESS_BYTES;
+        shared->chunkMax = MP_RINGBUFFER_BENCH_STRESS_CHUNK_MAX;
+        shared->isRandomChunk = 1;
+        if (MpRingBufferBench_Run(shared, &seconds[0], &partialPutCount) != 0) {
+            isFail = 1;
+        }
+        printf("  %u producers %8.1f ms, %u puts cut short by full ring\r\n", producerNum[i], seconds[0] * 1000,
+               partialPutCount);
+    }
+
+    printf("throughput, %d bytes per producer in chunks of %d bytes, ring of %d bytes:\r\n",
+           MP_RINGBUFFER_BENCH_BYTES, MP_RINGBUFFER_BENCH_CHUNK_SIZE, MP_RINGBUFFER_BENCH_BUFFER_SIZE);
+    printf("  (the mutex consumer takes the mutex too, on target the TX ISR reads without it)\r\n");
+    for (i = 0; i < sizeof(producerNum) / sizeof(producerNum[0]); i++) {
+        shared->producerNum = producerNum[i];
+        shared->bytesPerProducer = MP_RINGBUFFER_BENCH_BYTES;
+        shared->chunkMax = MP_RINGBUFFER_BENCH_CHUNK_SIZE;
+        shared->isRandomChunk = 0;
+
+        shared->mode = MP_RINGBUFFER_BENCH_MUTEX;
+        if (MpRingBufferBench_Run(shared, &seconds[0], &partialPutCount) != 0) {
+            isFail = 1;
+        }
+        shared->mode = MP_RINGBUFFER_BENCH_LOCK_FREE;
+        if (MpRingBufferBench_Run(shared, &seconds[1], &partialPutCount) != 0) {
+            isFail = 1;
+        }
+
+        printf("  %u producers  mutex %7.1f MB/s  lock free %7.1f MB/s  speedup %.2fx\r\n", producerNum[i],
+               (double) producerNum[i] * MP_RINGBUFFER_BENCH_BYTES / seconds[0] / 1e6,
+               (double) producerNum[i] * MP_RINGBUFFER_BENCH_BYTES / seconds[1] / 1e6, seconds[0] / seconds[1]);
+    }
+
+    pthread_mutex_destroy(&shared->mutex);
+    free(shared);
+
+    printf("%s\r\n", isFail ? "CHECK FAIL" : "CHECK PASS");
+
+    return isFail;
+}
+
+/* Private functions definition-----------------------------------------------*/
+/**
+ * @brief Check that a producer preempted between reserving and committing only holds back its own slot.
+ * @note Reservation of the preempted producer is made by hand, the ring buffer has no API to split it from commit.
+ * @return 0 if check passes, otherwise 1.
+ */
+static int MpRingBufferBench_CheckStalledProducer(void)
+{
+    T_MpRingBuffer ring;
+    uint8_t data[512];
+    uint8_t readData[512];
+    uint32_t stallIndex;
+    uint32_t readLen;
+    uint32_t expectLen;
+    int isFail = 0;
+    uint32_t i;
+
+    for (i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t) i;
+    }
+
+    //1024 bytes ring has 32 slots of 32 bytes
+    MpRingBuf_Init(&ring, s_benchBuffer, 1024);
+    MpRingBuf_Put(&ring, data, 100);
+    stallIndex = ring.reserveIndex;
+    ring.reserveIndex += 10;
+    MpRingBuf_Put(&ring, data + 110, 200);
+
+    //data before the slot of the stalled write is readable, nothing after it is exposed
+    expectLen = stallIndex & ~(ring.slotSize - 1);
+    readLen = MpRingBuf_Get(&ring, readData, sizeof(readData));
+    if (readLen != expectLen || memcmp(readData, data, readLen) != 0) {
+        printf("stalled producer: read %u bytes before commit, expect %u\r\n", readLen, expectLen);
+        isFail = 1;
+    }
+
+    memcpy(s_benchBuffer + stallIndex, data + 100, 10);
+    ring.slotCommitCount[stallIndex / ring.slotSize] += 10;
+    readLen = MpRingBuf_Get(&ring, readData, sizeof(readData));
+    if (readLen != 310 - expectLen || memcmp(readData, data + expectLen, readLen) != 0) {
+        printf("stalled producer: read %u bytes after commit, expect %u\r\n", readLen, 310 - expectLen);
+        isFail = 1;
+    }
+
+    //space of the slot consumer is in is not reusable, the rest is
+    if (MpRingBuf_GetUnusedSize(&ring) != 1024 - (310 - (310 & ~(ring.slotSize - 1)))) {
+        printf("stalled producer: unused size %u\r\n", MpRingBuf_GetUnusedSize(&ring));
+        isFail = 1;
+    }
+
+    printf("stalled producer: %s\r\n", isFail ? "FAIL" : "ok");
+
+    return isFail;
+}
+
+/**
+ * @brief Run producers and one consumer until every byte is received and checked.
+ * @param shared Shared state of the run.
+ * @param seconds Wall time of the run.
+ * @param partialPutCount Number of puts that stored less than wanted.
+ * @return 0 if every byte arrived in order, otherwise 1.
+ */
+static int MpRingBufferBench_Run(T_MpRingBufferBenchShared *shared, double *seconds, uint32_t *partialPutCount)
+{
+    T_MpRingBufferBenchProducer producer[MP_RINGBUFFER_BENCH_PRODUCER_NUM_MAX];
+    T_MpRingBufferBenchConsumer consumer;
+    pthread_t producerThread[MP_RINGBUFFER_BENCH_PRODUCER_NUM_MAX];
+    pthread_t consumerThread;
+    uint64_t startNs;
+    int isFail = 0;
+    uint32_t i;
+
+    MpRingBuf_Init(&shared->mpRingBuffer, s_benchBuffer, sizeof(s_benchBuffer));
+    RingBuf_Init(&shared->ringBuffer, s_benchBuffer, sizeof(s_benchBuffer));
+    memset(s_benchBuffer, MP_RINGBUFFER_BENCH_POISON, sizeof(s_benchBuffer));
+    memset(&consumer, 0, sizeof(consumer));
+    consumer.shared = shared;
+
+    startNs = MpRingBufferBench_GetMonotonicNs();
+    pthread_create(&consumerThread, NULL, MpRingBufferBench_ConsumerTask, &consumer);
+    for (i = 0; i < shared->producerNum; i++) {
+        producer[i] = (T_MpRingBufferBenchProducer) {.shared = shared, .producerId = i};
+        pthread_create(&producerThread[i], NULL, MpRingBufferBench_ProducerTask, &producer[i]);
+    }
+
+    *partialPutCount = 0;
+    for (i = 0; i < shared->producerNum; i++) {
+        pthread_join(producerThread[i], NULL);
+        *partialPutCount += producer[i].partialPutCount;
+    }
+    pthread_join(consumerThread, NULL);
+    *seconds = (double) (MpRingBufferBench_GetMonotonicNs() - startNs) / 1e9;
+
+    if (consumer.errorCount != 0) {
+        printf("  %u bytes out of order or exposed before written\r\n", consumer.errorCount);
+        isFail = 1;
+    }
+    for (i = 0; i < shared->producerNum; i++) {
+        if (consumer.receivedLen[i] != shared->bytesPerProducer) {
+            printf("  producer %u: received %u of %u bytes\r\n", i, consumer.receivedLen[i],
+                   shared->bytesPerProducer);
+            isFail = 1;
+        }
+    }
+
+    return isFail;
+}
+
+/**
+ * @brief Producer thread, puts its tagged bytes in chunks and puts the rest again when the ring is full.
+ * @param arg Pointer to producer state.
+ * @return NULL.
+ */
+static void *MpRingBufferBench_ProducerTask(void *arg)
+{
+    T_MpRingBufferBenchProducer *producer = arg;
+    T_MpRingBufferBenchShared *shared = producer->shared;
+    uint8_t chunk[MP_RINGBUFFER_BENCH_STRESS_CHUNK_MAX];
+    unsigned int seed = producer->producerId + 1;
+    uint32_t sentLen = 0;
+    uint32_t chunkLen;
+    uint32_t putLen;
+    uint32_t i;
+
+    while (sentLen < shared->bytesPerProducer) {
+        chunkLen = shared->isRandomChunk ? (uint32_t) rand_r(&seed) % shared->chunkMax + 1 : shared->chunkMax;
+        if (chunkLen > shared->bytesPerProducer - sentLen) {
+            chunkLen = shared->bytesPerProducer - sentLen;
+        }
+        for (i = 0; i < chunkLen; i++) {
+            chunk[i] = (uint8_t) ((producer->producerId << 4) | ((sentLen + i) & 0x0F));
+        }
+
+        putLen = MpRingBufferBench_Put(shared, chunk, chunkLen);
+        producer->putCount++;
+        sentLen += putLen;
+        if (putLen < chunkLen) {
+            producer->partialPutCount++;
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Consumer thread, lock free mode reads by copying and in place in turn, so both paths are checked.
+ * @param arg Pointer to consumer state.
+ * @return NULL.
+ */
+static void *MpRingBufferBench_ConsumerTask(void *arg)
+{
+    T_MpRingBufferBenchConsumer *consumer = arg;
+    T_MpRingBufferBenchShared *shared = consumer->shared;
+    uint8_t readData[MP_RINGBUFFER_BENCH_READ_SIZE];
+    T_MpRingBufSpan spans[2];
+    uint64_t totalLen = (uint64_t) shared->producerNum * shared->bytesPerProducer;
+    uint64_t receivedLen = 0;
+    uint32_t readLen;
+    uint32_t round = 0;
+
+    while (receivedLen < totalLen) {
+        if (shared->mode == MP_RINGBUFFER_BENCH_MUTEX) {
+            pthread_mutex_lock(&shared->mutex);
+            readLen = RingBuf_Get(&shared->ringBuffer, readData, sizeof(readData));
+            pthread_mutex_unlock(&shared->mutex);
+            MpRingBufferBench_CheckBytes(consumer, readData, readLen);
+        } else if ((round++ & 1) == 0) {
+            readLen = MpRingBuf_Get(&shared->mpRingBuffer, readData, sizeof(readData));
+            MpRingBufferBench_CheckBytes(consumer, readData, readLen);
+        } else {
+            readLen = MpRingBuf_PeekSpans(&shared->mpRingBuffer, spans);
+            MpRingBufferBench_CheckBytes(consumer, spans[0].dataPtr, spans[0].dataLen);
+            MpRingBufferBench_CheckBytes(consumer, spans[1].dataPtr, spans[1].dataLen);
+            memset(spans[0].dataPtr, MP_RINGBUFFER_BENCH_POISON, spans[0].dataLen);
+            memset(spans[1].dataPtr, MP_RINGBUFFER_BENCH_POISON, spans[1].dataLen);
+            MpRingBuf_Consume(&shared->mpRingBuffer, readLen);
+        }
+
+        receivedLen += readLen;
+        if (readLen == 0) {
+            consumer->emptyPollCount++;
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Put data the way UART_Write did before and does now.
+ * @param shared Shared state of the run.
+ * @param data Pointer to data.
+ * @param len Length of data.
+ * @return Length of data stored.
+ */
+static uint32_t MpRingBufferBench_Put(T_MpRingBufferBenchShared *shared, const uint8_t *data, uint32_t len)
+{
+    uint32_t putLen;
+
+    if (shared->mode == MP_RINGBUFFER_BENCH_LOCK_FREE) {
+        return MpRingBuf_Put(&shared->mpRingBuffer, data, len);
+    }
+
+    pthread_mutex_lock(&shared->mutex);
+    putLen = RingBuf_Put(&shared->ringBuffer, data, (uint16_t) len);
+    pthread_mutex_unlock(&shared->mutex);
+
+    return putLen;
+}
+
+/**
+ * @brief Check that bytes of every producer arrive in the order they were put.
+ * @param consumer Pointer to consumer state.
+ * @param data Pointer to data read.
+ * @param len Length of data read.
+ * @return None.
+ */
+static void MpRingBufferBench_CheckBytes(T_MpRingBufferBenchConsumer *consumer, const uint8_t *data, uint32_t len)
+{
+    uint32_t producerId;
+    uint32_t i;
+
+    for (i = 0; i < len; i++) {
+        producerId = data[i] >> 4;
+        if (producerId >= consumer->shared->producerNum ||
+            (data[i] & 0x0F) != (consumer->receivedLen[producerId] & 0x0F)) {
+            consumer->errorCount++;
+            continue;
+        }
+        consumer->receivedLen[producerId]++;
+    }
+}
+
+static uint64_t MpRingBufferBench_GetMonotonicNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
@@ -0,0 +1,641 @@
+/**
+ ********************************************************************
+ * @file    ringbuffer_span_bench.c
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   Host wrap-around check and benchmark of the span API of T_RingBuffer and T_UtilBuffer, frames are
+ *          parsed in place from peeked spans against copying them out through RingBuf_Put/RingBuf_Get.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include "dji_ringbuffer.h"
+#include "utils/util_buffer.h"
+
+/* Private constants ---------------------------------------------------------*/
+#define RINGBUFFER_SPAN_BENCH_CHECK_SIZE        64
+#define RINGBUFFER_SPAN_BENCH_RANDOM_OP_NUM     200000
+//same size as read buffer of UART3, the aircraft link
+#define RINGBUFFER_SPAN_BENCH_BUFFER_SIZE       8192
+#define RINGBUFFER_SPAN_BENCH_BYTES             (64 * 1024 * 1024)
+//bytes stored per receive interrupt or DMA event, and bytes read by parser task per wake up
+#define RINGBUFFER_SPAN_BENCH_RX_CHUNK_SIZE     64
+#define RINGBUFFER_SPAN_BENCH_READ_SIZE         1024
+#define RINGBUFFER_SPAN_BENCH_FRAME_HEAD        0xAA
+#define RINGBUFFER_SPAN_BENCH_PAYLOAD_LEN_MAX   200
+
+/* Private types -------------------------------------------------------------*/
+//same layout as T_RingBufSpan and T_UtilBufferSpan, so one check covers both buffers
+typedef struct {
+    uint8_t *dataPtr;
+    uint16_t dataLen;
+} T_RingBufferSpanBenchSpan;
+
+typedef struct {
+    const char *name;
+    void (*init)(void *buffer, uint8_t *memory, uint16_t size);
+    uint16_t (*put)(void *buffer, const uint8_t *data, uint16_t dataLen);
+    uint16_t (*get)(void *buffer, uint8_t *data, uint16_t dataLen);
+    uint16_t (*peekSpans)(void *buffer, T_RingBufferSpanBenchSpan spans[2]);
+    uint16_t (*consume)(void *buffer, uint16_t dataLen);
+    uint16_t (*reserveSpans)(void *buffer, T_RingBufferSpanBenchSpan spans[2]);
+    uint16_t (*commit)(void *buffer, uint16_t dataLen);
+    void (*setIndex)(void *buffer, uint16_t index);
+} T_RingBufferSpanBenchOps;
+
+//reference model of buffer content, a plain queue of bytes
+typedef struct {
+    uint8_t data[RINGBUFFER_SPAN_BENCH_CHECK_SIZE];
+    uint16_t len;
+} T_RingBufferSpanBenchModel;
+
+typedef struct {
+    uint32_t seed;
+    uint16_t frameOffset;
+    uint16_t frameLen;
+    uint8_t payloadLen;
+    uint8_t checksum;
+} T_RingBufferSpanBenchGenerator;
+
+typedef struct {
+    uint16_t frameOffset;
+    uint8_t payloadLen;
+    uint8_t checksum;
+    uint32_t frameNum;
+    uint32_t errorNum;
+} T_RingBufferSpanBenchParser;
+
+typedef struct {
+    uint32_t frameNum;
+    uint32_t errorNum;
+    uint64_t copiedLen; /*!< Bytes copied by memcpy of ring buffer or into staging buffer. */
+    double seconds;
+} T_RingBufferSpanBenchResult;
+
+/* Private values -------------------------------------------------------------*/
+static uint32_t s_seed = 1;
+
+/* Private functions declaration ---------------------------------------------*/
+static int RingBufferSpanBench_CheckWrapAround(const T_RingBufferSpanBenchOps *ops, void *buffer);
+static int RingBufferSpanBench_CheckRandom(const T_RingBufferSpanBenchOps *ops, void *buffer);
+static int RingBufferSpanBench_CheckSpans(uint8_t *memory, const T_RingBufferSpanBenchSpan spans[2],
+                                          uint16_t expectLen, uint16_t expectOffset);
+static void RingBufferSpanBench_RunCopy(T_RingBufferSpanBenchResult *result);
+static void RingBufferSpanBench_RunSpan(T_RingBufferSpanBenchResult *result);
+static void RingBufferSpanBench_Generate(T_RingBufferSpanBenchGenerator *generator, uint8_t *data, uint16_t dataLen);
+static void RingBufferSpanBench_Parse(T_RingBufferSpanBenchParser *parser, const uint8_t *data, uint16_t dataLen);
+static uint32_t RingBufferSpanBench_Random(uint32_t max);
+static uint64_t RingBufferSpanBench_GetMonotonicNs(void);
+
+static void RingBufferSpanBench_RingInit(void *buffer, uint8_t *memory, uint16_t size);
+static uint16_t RingBufferSpanBench_RingPut(void *buffer, const uint8_t *data, uint16_t dataLen);
+static uint16_t RingBufferSpanBench_RingGet(void *buffer, uint8_t *data, uint16_t dataLen);
+static uint16_t RingBufferSpanBench_RingPeekSpans(void *buffer, T_RingBufferSpanBenchSpan spans[2]);
+static uint16_t RingBufferSpanBench_RingConsume(void *buffer, uint16_t dataLen);
+static uint16_t RingBufferSpanBench_RingReserveSpans(void *buffer, T_RingBufferSpanBenchSpan spans[2]);
+static uint16_t RingBufferSpanBench_RingCommit(void *buffer, uint16_t dataLen);
+static void RingBufferSpanBench_RingSetIndex(void *buffer, uint16_t index);
+static void RingBufferSpanBench_UtilInit(void *buffer, uint8_t *memory, uint16_t size);
+static uint16_t RingBufferSpanBench_UtilPut(void *buffer, const uint8_t *data, uint16_t dataLen);
+static uint16_t RingBufferSpanBench_UtilGet(void *buffer, uint8_t *data, uint16_t dataLen);
+static uint16_t RingBufferSpanBench_UtilPeekSpans(void *buffer, T_RingBufferSpanBenchSpan spans[2]);
+static uint16_t RingBufferSpanBench_UtilConsume(void *buffer, uint16_t dataLen);
+static uint16_t RingBufferSpanBench_UtilReserveSpans(void *buffer, T_RingBufferSpanBenchSpan spans[2]);
+static uint16_t RingBufferSpanBench_UtilCommit(void *buffer, uint16_t dataLen);
+static void RingBufferSpanBench_UtilSetIndex(void *buffer, uint16_t index);
+
+static const T_RingBufferSpanBenchOps s_ringBufferOps = {
+    "T_RingBuffer",
+    RingBufferSpanBench_RingInit,
+    RingBufferSpanBench_RingPut,
+    RingBufferSpanBench_RingGet,
+    RingBufferSpanBench_RingPeekSpans,
+    RingBufferSpanBench_RingConsume,
+    RingBufferSpanBench_RingReserveSpans,
+    RingBufferSpanBench_RingCommit,
+    RingBufferSpanBench_RingSetIndex,
+};
+
+static const T_RingBufferSpanBenchOps s_utilBufferOps = {
+    "T_UtilBuffer",
+    RingBufferSpanBench_UtilInit,
+    RingBufferSpanBench_UtilPut,
+    RingBufferSpanBench_UtilGet,
+    RingBufferSpanBench_UtilPeekSpans,
+    RingBufferSpanBench_UtilConsume,
+    RingBufferSpanBench_UtilReserveSpans,
+    RingBufferSpanBench_UtilCommit,
+    RingBufferSpanBench_UtilSetIndex,
+};
+
+/* Exported functions definition ---------------------------------------------*/
+int main(void)
+{
+    T_RingBuffer ringBuffer;
+    T_UtilBuffer utilBuffer;
+    T_RingBufferSpanBenchResult copyResult;
+    T_RingBufferSpanBenchResult spanResult;
+    uint32_t expectFrameNum;
+    int isFail = 0;
+
+    printf("wrap-around, every read offset and fill level of a %d byte buffer, also across index overflow:\r\n",
+           RINGBUFFER_SPAN_BENCH_CHECK_SIZE);
+    isFail |= RingBufferSpanBench_CheckWrapAround(&s_ringBufferOps, &ringBuffer);
+    isFail |= RingBufferSpanBench_CheckWrapAround(&s_utilBufferOps, &utilBuffer);
+
+    printf("random mix of put, get, reserve/commit and peek/consume against a reference queue, %d ops:\r\n",
+           RINGBUFFER_SPAN_BENCH_RANDOM_OP_NUM);
+    isFail |= RingBufferSpanBench_CheckRandom(&s_ringBufferOps, &ringBuffer);
+    isFail |= RingBufferSpanBench_CheckRandom(&s_utilBufferOps, &utilBuffer);
+
+    printf("frame parsing, %d MB through a ring of %d bytes, %d bytes per receive event, %d bytes per read:\r\n",
+           RINGBUFFER_SPAN_BENCH_BYTES / (1024 * 1024), RINGBUFFER_SPAN_BENCH_BUFFER_SIZE,
+           RINGBUFFER_SPAN_BENCH_RX_CHUNK_SIZE, RINGBUFFER_SPAN_BENCH_READ_SIZE);
+    RingBufferSpanBench_RunCopy(&copyResult);
+    RingBufferSpanBench_RunSpan(&spanResult);
+    printf("  put/get      %7.1f MB/s  %.2f bytes copied per byte  %u frames\r\n",
+           RINGBUFFER_SPAN_BENCH_BYTES / copyResult.seconds / (1024 * 1024),
+           (double) copyResult.copiedLen / RINGBUFFER_SPAN_BENCH_BYTES, copyResult.frameNum);
+    printf("  spans        %7.1f MB/s  %.2f bytes copied per byte  %u frames  speedup %.2fx\r\n",
+           RINGBUFFER_SPAN_BENCH_BYTES / spanResult.seconds / (1024 * 1024),
+           (double) spanResult.copiedLen / RINGBUFFER_SPAN_BENCH_BYTES, spanResult.frameNum,
+           copyResult.seconds / spanResult.seconds);
+
+    //both paths see the same generated stream, so they must parse the same frames without checksum error
+    expectFrameNum = copyResult.frameNum;
+    if (copyResult.errorNum != 0 || spanResult.errorNum != 0 || spanResult.frameNum != expectFrameNum ||
+        expectFrameNum == 0) {
+        printf("  frames parsed %u/%u, checksum errors %u/%u\r\n", copyResult.frameNum, spanResult.frameNum,
+               copyResult.errorNum, spanResult.errorNum);
+        isFail = 1;
+    }
+
+    printf("%s\r\n", isFail ? "CHECK FAIL" : "CHECK PASS");
+
+    return isFail;
+}
+
+/* Private functions definition-----------------------------------------------*/
+/**
+ * @brief Reserve, commit, peek and consume at every read offset and fill level, starting with indexes near 0 and
+ *        near 65535, so that spans are checked against the end of memory and against overflow of the indexes.
+ * @param ops: buffer under check.
+ * @param buffer: buffer structure.
+ * @return 1 if check failed, 0 otherwise.
+ */
+static int RingBufferSpanBench_CheckWrapAround(const T_RingBufferSpanBenchOps *ops, void *buffer)
+{
+    static const uint16_t startIndex[] = {0, (uint16_t) (0x10000 - RINGBUFFER_SPAN_BENCH_CHECK_SIZE / 2)};
+    uint8_t memory[RINGBUFFER_SPAN_BENCH_CHECK_SIZE];
+    T_RingBufferSpanBenchSpan spans[2];
+    uint32_t errorNum = 0;
+    uint32_t caseNum = 0;
+    uint16_t offset;
+    uint16_t fillLen;
+    uint16_t realLen;
+    uint16_t index;
+    uint16_t i;
+    uint32_t j;
+
+    for (j = 0; j < sizeof(startIndex) / sizeof(startIndex[0]); j++) {
+        for (offset = 0; offset < RINGBUFFER_SPAN_BENCH_CHECK_SIZE; offset++) {
+            for (fillLen = 0; fillLen <= RINGBUFFER_SPAN_BENCH_CHECK_SIZE; fillLen++) {
+                caseNum++;
+                index = (uint16_t) (startIndex[j] + offset);
+                memset(memory, 0, sizeof(memory));
+                ops->init(buffer, memory, sizeof(memory));
+                ops->setIndex(buffer, index);
+
+                //free space starts at write offset and wraps to start of memory
+                realLen = ops->reserveSpans(buffer, spans);
+                errorNum += realLen != RINGBUFFER_SPAN_BENCH_CHECK_SIZE;
+                errorNum += RingBufferSpanBench_CheckSpans(memory, spans, RINGBUFFER_SPAN_BENCH_CHECK_SIZE,
+                                                           index % RINGBUFFER_SPAN_BENCH_CHECK_SIZE);
+                for (i = 0; i < fillLen; i++) {
+                    if (i < spans[0].dataLen) {
+                        spans[0].dataPtr[i] = (uint8_t) (i + 1);
+                    } else {
+                        spans[1].dataPtr[i - spans[0].dataLen] = (uint8_t) (i + 1);
+                    }
+                }
+                errorNum += ops->commit(buffer, fillLen) != fillLen;
+                if (fillLen == RINGBUFFER_SPAN_BENCH_CHECK_SIZE) {
+                    errorNum += ops->commit(buffer, 1) != 0;
+                    errorNum += ops->reserveSpans(buffer, spans) != 0;
+                }
+
+                //data is exposed in order from read offset
+                realLen = ops->peekSpans(buffer, spans);
+                errorNum += realLen != fillLen;
+                errorNum += RingBufferSpanBench_CheckSpans(memory, spans, fillLen,
+                                                           index % RINGBUFFER_SPAN_BENCH_CHECK_SIZE);
+                for (i = 0; i < fillLen; i++) {
+                    errorNum += (i < spans[0].dataLen ? spans[0].dataPtr[i] :
+                                 spans[1].dataPtr[i - spans[0].dataLen]) != (uint8_t) (i + 1);
+                }
+
+                //partial consume moves read offset, consuming more than stored is cut to what is stored
+                errorNum += ops->consume(buffer, fillLen / 2) != fillLen / 2;
+                realLen = ops->peekSpans(buffer, spans);
+                errorNum += realLen != fillLen - fillLen / 2;
+                errorNum += realLen != 0 && spans[0].dataPtr[0] != (uint8_t) (fillLen / 2 + 1);
+                errorNum += ops->consume(buffer, RINGBUFFER_SPAN_BENCH_CHECK_SIZE) != realLen;
+                errorNum += ops->peekSpans(buffer, spans) != 0;
+                errorNum += spans[0].dataLen != 0 || spans[1].dataLen != 0;
+            }
+        }
+    }
+
+    printf("  %-14s %6u cases, %u errors\r\n", ops->name, caseNum, errorNum);
+
+    return errorNum != 0;
+}
+
+/**
+ * @brief Run a random mix of copying and in place operations against a reference queue, starting with indexes
+ *        just before overflow.
+ * @param ops: buffer under check.
+ * @param buffer: buffer structure.
+ * @return 1 if check failed, 0 otherwise.
+ */
+static int RingBufferSpanBench_CheckRandom(const T_RingBufferSpanBenchOps *ops, void *buffer)
+{
+    uint8_t memory[RINGBUFFER_SPAN_BENCH_CHECK_SIZE];
+    uint8_t data[RINGBUFFER_SPAN_BENCH_CHECK_SIZE * 2];
+    T_RingBufferSpanBenchModel model;
+    T_RingBufferSpanBenchSpan spans[2];
+    uint32_t errorNum = 0;
+    uint16_t dataLen;
+    uint16_t expectLen;
+    uint16_t realLen;
+    uint16_t i;
+    uint32_t op;
+
+    memset(&model, 0, sizeof(model));
+    ops->init(buffer, memory, sizeof(memory));
+    ops->setIndex(buffer, (uint16_t) (0x10000 - 10));
+
+    for (op = 0; op < RINGBUFFER_SPAN_BENCH_RANDOM_OP_NUM; op++) {
+        dataLen = (uint16_t) RingBufferSpanBench_Random(RINGBUFFER_SPAN_BENCH_CHECK_SIZE + 8);
+
+        switch (RingBufferSpanBench_Random(3)) {
+            case 0:
+                for (i = 0; i < dataLen; i++) {
+                    data[i] = (uint8_t) RingBufferSpanBench_Random(0xFF);
+                }
+                expectLen = dataLen < RINGBUFFER_SPAN_BENCH_CHECK_SIZE - model.len ? dataLen :
+                            RINGBUFFER_SPAN_BENCH_CHECK_SIZE - model.len;
+                realLen = ops->put(buffer, data, dataLen);
+                errorNum += realLen != expectLen;
+                memcpy(&model.data[model.len], data, expectLen);
+                model.len += expectLen;
+                break;
+            case 1:
+                expectLen = dataLen < model.len ? dataLen : model.len;
+                realLen = ops->get(buffer, data, dataLen);
+                errorNum += realLen != expectLen || memcmp(data, model.data, expectLen) != 0;
+                memmove(model.data, &model.data[expectLen], model.len - expectLen);
+                model.len -= expectLen;
+                break;
+            case 2:
+                realLen = ops->reserveSpans(buffer, spans);
+                errorNum += realLen != RINGBUFFER_SPAN_BENCH_CHECK_SIZE - model.len;
+                expectLen = dataLen < realLen ? dataLen : realLen;
+                for (i = 0; i < expectLen; i++) {
+                    data[i] = (uint8_t) RingBufferSpanBench_Random(0xFF);
+                    if (i < spans[0].dataLen) {
+                        spans[0].dataPtr[i] = data[i];
+                    } else {
+                        spans[1].dataPtr[i - spans[0].dataLen] = data[i];
+                    }
+                }
+                errorNum += ops->commit(buffer, dataLen) != expectLen;
+                memcpy(&model.data[model.len], data, expectLen);
+                model.len += expectLen;
+                break;
+            default:
+                realLen = ops->peekSpans(buffer, spans);
+                errorNum += realLen != model.len || spans[0].dataLen + spans[1].dataLen != model.len;
+                if (realLen == model.len) {
+                    errorNum += memcmp(spans[0].dataPtr, model.data, spans[0].dataLen) != 0;
+                    errorNum += memcmp(spans[1].dataPtr, &model.data[spans[0].dataLen], spans[1].dataLen) != 0;
+                }
+                expectLen = dataLen < model.len ? dataLen : model.len;
+                errorNum += ops->consume(buffer, dataLen) != expectLen;
+                memmove(model.data, &model.data[expectLen], model.len - expectLen);
+                model.len -= expectLen;
+                break;
+        }
+    }
+
+    printf("  %-14s %u errors\r\n", ops->name, errorNum);
+
+    return errorNum != 0;
+}
+
+/**
+ * @brief Check that spans describe a region starting at an offset of buffer memory and wrapping to its start.
+ * @return Count of errors.
+ */
+static int RingBufferSpanBench_CheckSpans(uint8_t *memory, const T_RingBufferSpanBenchSpan spans[2],
+                                          uint16_t expectLen, uint16_t expectOffset)
+{
+    uint16_t expectFirstLen = expectLen < RINGBUFFER_SPAN_BENCH_CHECK_SIZE - expectOffset ? expectLen :
+                              RINGBUFFER_SPAN_BENCH_CHECK_SIZE - expectOffset;
+    int errorNum = 0;
+
+    errorNum += spans[0].dataPtr != memory + expectOffset;
+    errorNum += spans[0].dataLen != expectFirstLen;
+    errorNum += spans[1].dataPtr != memory;
+    errorNum += spans[1].dataLen != expectLen - expectFirstLen;
+
+    return errorNum;
+}
+
+/**
+ * @brief Receive path as before span API, receive interrupt puts a chunk and parser task gets it into a buffer.
+ * @param result: pointer to result.
+ * @return None.
+ */
+static void RingBufferSpanBench_RunCopy(T_RingBufferSpanBenchResult *result)
+{
+    static uint8_t memory[RINGBUFFER_SPAN_BENCH_BUFFER_SIZE];
+    uint8_t staging[RINGBUFFER_SPAN_BENCH_RX_CHUNK_SIZE];
+    uint8_t readBuf[RINGBUFFER_SPAN_BENCH_READ_SIZE];
+    T_RingBufferSpanBenchGenerator generator = {0};
+    T_RingBufferSpanBenchParser parser = {0};
+    T_RingBuffer ringBuffer;
+    uint32_t producedLen = 0;
+    uint16_t dataLen;
+    uint64_t startNs;
+
+    memset(result, 0, sizeof(T_RingBufferSpanBenchResult));
+    generator.seed = 1;
+    RingBuf_Init(&ringBuffer, memory, sizeof(memory));
+
+    startNs = RingBufferSpanBench_GetMonotonicNs();
+    while (producedLen < RINGBUFFER_SPAN_BENCH_BYTES) {
+        while (producedLen < RINGBUFFER_SPAN_BENCH_BYTES &&
+               RingBuf_GetUnusedSize(&ringBuffer) >= RINGBUFFER_SPAN_BENCH_RX_CHUNK_SIZE) {
+            RingBufferSpanBench_Generate(&generator, staging, RINGBUFFER_SPAN_BENCH_RX_CHUNK_SIZE);
+            result->copiedLen += RingBuf_Put(&ringBuffer, staging, RINGBUFFER_SPAN_BENCH_RX_CHUNK_SIZE);
+            producedLen += RINGBUFFER_SPAN_BENCH_RX_CHUNK_SIZE;
+        }
+
+        while ((dataLen = RingBuf_Get(&ringBuffer, readBuf, sizeof(readBuf))) != 0) {
+            result->copiedLen += dataLen;
+            RingBufferSpanBench_Parse(&parser, readBuf, dataLen);
+        }
+    }
+    result->seconds = (double) (RingBufferSpanBench_GetMonotonicNs() - startNs) / 1e9;
+    result->frameNum = parser.frameNum;
+    result->errorNum = parser.errorNum;
+}
+
+/**
+ * @brief Receive path with span API, data is stored in reserved space like DMA does and parsed from peeked spans.
+ * @param result: pointer to result.
+ * @return None.
+ */
+static void RingBufferSpanBench_RunSpan(T_RingBufferSpanBenchResult *result)
+{
+    static uint8_t memory[RINGBUFFER_SPAN_BENCH_BUFFER_SIZE];
+    T_RingBufferSpanBenchGenerator generator = {0};
+    T_RingBufferSpanBenchParser parser = {0};
+    T_RingBufSpan spans[2];
+    T_RingBuffer ringBuffer;
+    uint32_t producedLen = 0;
+    uint16_t dataLen;
+    uint16_t firstLen;
+    uint64_t startNs;
+
+    memset(result, 0, sizeof(T_RingBufferSpanBenchResult));
+    generator.seed = 1;
+    RingBuf_Init(&ringBuffer, memory, sizeof(memory));
+
+    startNs = RingBufferSpanBench_GetMonotonicNs();
+    while (producedLen < RINGBUFFER_SPAN_BENCH_BYTES) {
+        while (producedLen < RINGBUFFER_SPAN_BENCH_BYTES &&
+               RingBuf_ReserveSpans(&ringBuffer, spans) >= RINGBUFFER_SPAN_BENCH_RX_CHUNK_SIZE) {
+            firstLen = spans[0].dataLen < RINGBUFFER_SPAN_BENCH_RX_CHUNK_SIZE ? spans[0].dataLen :
+                       RINGBUFFER_SPAN_BENCH_RX_CHUNK_SIZE;
+            RingBufferSpanBench_Generate(&generator, spans[0].dataPtr, firstLen);
+            RingBufferSpanBench_Generate(&generator, spans[1].dataPtr, RINGBUFFER_SPAN_BENCH_RX_CHUNK_SIZE - firstLen);
+            RingBuf_Commit(&ringBuffer, RINGBUFFER_SPAN_BENCH_RX_CHUNK_SIZE);
+            producedLen += RINGBUFFER_SPAN_BENCH_RX_CHUNK_SIZE;
+        }
+
+        while (RingBuf_PeekSpans(&ringBuffer, spans) != 0) {
+            firstLen = spans[0].dataLen < RINGBUFFER_SPAN_BENCH_READ_SIZE ? spans[0].dataLen :
+                       RINGBUFFER_SPAN_BENCH_READ_SIZE;
+            dataLen = spans[1].dataLen < RINGBUFFER_SPAN_BENCH_READ_SIZE - firstLen ? spans[1].dataLen :
+                      RINGBUFFER_SPAN_BENCH_READ_SIZE - firstLen;
+            RingBufferSpanBench_Parse(&parser, spans[0].dataPtr, firstLen);
+            RingBufferSpanBench_Parse(&parser, spans[1].dataPtr, dataLen);
+            RingBuf_Consume(&ringBuffer, firstLen + dataLen);
+        }
+    }
+    result->seconds = (double) (RingBufferSpanBench_GetMonotonicNs() - startNs) / 1e9;
+    result->frameNum = parser.frameNum;
+    result->errorNum = parser.errorNum;
+}
+
+/**
+ * @brief Generate a stream of frames, head, payload length, payload and 8 bits sum of length and payload.
+ * @param generator: pointer to generator, frames continue across calls.
+ * @param data: pointer to memory to be filled.
+ * @param dataLen: length of memory to be filled.
+ * @return None.
+ */
+static void RingBufferSpanBench_Generate(T_RingBufferSpanBenchGenerator *generator, uint8_t *data, uint16_t dataLen)
+{
+    //state is kept in locals, byte stores through data may alias the generator structure
+    T_RingBufferSpanBenchGenerator state = *generator;
+    uint16_t i;
+    uint8_t byte;
+
+    for (i = 0; i < dataLen; i++) {
+        if (state.frameOffset == 0) {
+            state.seed = state.seed * 1664525U + 1013904223U;
+            state.payloadLen = (uint8_t) ((state.seed >> 16) % (RINGBUFFER_SPAN_BENCH_PAYLOAD_LEN_MAX + 1));
+            state.frameLen = state.payloadLen + 3;
+            byte = RINGBUFFER_SPAN_BENCH_FRAME_HEAD;
+        } else if (state.frameOffset == 1) {
+            byte = state.payloadLen;
+            state.checksum = byte;
+        } else if (state.frameOffset < state.frameLen - 1) {
+            byte = (uint8_t) (state.seed >> 24) + (uint8_t) state.frameOffset;
+            state.checksum += byte;
+        } else {
+            byte = state.checksum;
+        }
+
+        data[i] = byte;
+        state.frameOffset++;
+        if (state.frameOffset == state.frameLen) {
+            state.frameOffset = 0;
+        }
+    }
+
+    *generator = state;
+}
+
+/**
+ * @brief Parse frames byte by byte, frames may be split at any byte between calls.
+ * @param parser: pointer to parser.
+ * @param data: pointer to data.
+ * @param dataLen: length of data.
+ * @return None.
+ */
+static void RingBufferSpanBench_Parse(T_RingBufferSpanBenchParser *parser, const uint8_t *data, uint16_t dataLen)
+{
+    T_RingBufferSpanBenchParser state = *parser;
+    uint16_t i;
+
+    for (i = 0; i < dataLen; i++) {
+        if (state.frameOffset == 0) {
+            if (data[i] != RINGBUFFER_SPAN_BENCH_FRAME_HEAD) {
+                state.errorNum++;
+                continue;
+            }
+        } else if (state.frameOffset == 1) {
+            state.payloadLen = data[i];
+            state.checksum = data[i];
+        } else if (state.frameOffset < state.payloadLen + 2) {
+            state.checksum += data[i];
+        } else {
+            if (data[i] == state.checksum) {
+                state.frameNum++;
+            } else {
+                state.errorNum++;
+            }
+            state.frameOffset = 0;
+            continue;
+        }
+        state.frameOffset++;
+    }
+
+    *parser = state;
+}
+
+static uint32_t RingBufferSpanBench_Random(uint32_t max)
+{
+    s_seed = s_seed * 1664525U + 1013904223U;
+
+    return (s_seed >> 8) % (max + 1);
+}
+
+static uint64_t RingBufferSpanBench_GetMonotonicNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void RingBufferSpanBench_RingInit(void *buffer, uint8_t *memory, uint16_t size)
+{
+    RingBuf_Init((T_RingBuffer *) buffer, memory, size);
+}
+
+static uint16_t RingBufferSpanBench_RingPut(void *buffer, const uint8_t *data, uint16_t dataLen)
+{
+    return RingBuf_Put((T_RingBuffer *) buffer, data, dataLen);
+}
+
+static uint16_t RingBufferSpanBench_RingGet(void *buffer, uint8_t *data, uint16_t dataLen)
+{
+    return RingBuf_Get((T_RingBuffer *) buffer, data, dataLen);
+}
+
+static uint16_t RingBufferSpanBench_RingPeekSpans(void *buffer, T_RingBufferSpanBenchSpan spans[2])
+{
+    return RingBuf_PeekSpans((T_RingBuffer *) buffer, (T_RingBufSpan *) spans);
+}
+
+static uint16_t RingBufferSpanBench_RingConsume(void *buffer, uint16_t dataLen)
+{
+    return RingBuf_Consume((T_RingBuffer *) buffer, dataLen);
+}
+
+static uint16_t RingBufferSpanBench_RingReserveSpans(void *buffer, T_RingBufferSpanBenchSpan spans[2])
+{
+    return RingBuf_ReserveSpans((T_RingBuffer *) buffer, (T_RingBufSpan *) spans);
+}
+
+static uint16_t RingBufferSpanBench_RingCommit(void *buffer, uint16_t dataLen)
+{
+    return RingBuf_Commit((T_RingBuffer *) buffer, dataLen);
+}
+
+static void RingBufferSpanBench_RingSetIndex(void *buffer, uint16_t index)
+{
+    ((T_RingBuffer *) buffer)->readIndex = index;
+    ((T_RingBuffer *) buffer)->writeIndex = index;
+}
+
+static void RingBufferSpanBench_UtilInit(void *buffer, uint8_t *memory, uint16_t size)
+{
+    UtilBuffer_Init((T_UtilBuffer *) buffer, memory, size);
+}
+
+static uint16_t RingBufferSpanBench_UtilPut(void *buffer, const uint8_t *data, uint16_t dataLen)
+{
+    return UtilBuffer_Put((T_UtilBuffer *) buffer, data, dataLen);
+}
+
+static uint16_t RingBufferSpanBench_UtilGet(void *buffer, uint8_t *data, uint16_t dataLen)
+{
+    return UtilBuffer_Get((T_UtilBuffer *) buffer, data, dataLen);
+}
+
+static uint16_t RingBufferSpanBench_UtilPeekSpans(void *buffer, T_RingBufferSpanBenchSpan spans[2])
+{
+    return UtilBuffer_PeekSpans((T_UtilBuffer *) buffer, (T_UtilBufferSpan *) spans);
+}
+
+static uint16_t RingBufferSpanBench_UtilConsume(void *buffer, uint16_t dataLen)
+{
+    return UtilBuffer_Consume((T_UtilBuffer *) buffer, dataLen);
+}
+
+static uint16_t RingBufferSpanBench_UtilReserveSpans(void *buffer, T_RingBufferSpanBenchSpan spans[2])
+{
+    return UtilBuffer_ReserveSpans((T_UtilBuffer *) buffer, (T_UtilBufferSpan *) spans);
+}
+
+static uint16_t RingBufferSpanBench_UtilCommit(void *buffer, uint16_t dataLen)
+{
+    return UtilBuffer_Commit((T_UtilBuffer *) buffer, dataLen);
+}
+
+static void RingBufferSpanBench_UtilSetIndex(void *buffer, uint16_t index)
+{
+    ((T_UtilBuffer *) buffer)->readIndex = index;
+    ((T_UtilBuffer *) buffer)->writeIndex = index;
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
@@ -0,0 +1,398 @@
+/**
+ ********************************************************************
+ * @file    task_latency_bench.c
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   Host benchmark of UART to callback latency of the protocol task under CPU bound background tasks,
+ *          in round-robin with them at priority 0 against the task policy of application.c, on one core.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+
+
+/* Includes ------------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include "dji_ringbuffer.h"
+
+/* Private constants ---------------------------------------------------------*/
+//priorities of tasks in application.c, tasks created through osal without policy run at 0
+#define TASK_LATENCY_BENCH_PRIORITY_IDLE        0
+#define TASK_LATENCY_BENCH_PRIORITY_NORMAL      1
+#define TASK_LATENCY_BENCH_PRIORITY_HIGH        3
+//FreeRTOS priority p runs as SCHED_FIFO priority BASE + p, receive interrupt and bench control above all tasks
+#define TASK_LATENCY_BENCH_RT_PRIORITY_BASE     10
+#define TASK_LATENCY_BENCH_RT_PRIORITY_IRQ      80
+#define TASK_LATENCY_BENCH_RT_PRIORITY_MAIN     90
+//tick of FreeRTOSConfig.h, tasks of equal priority take turns every tick
+#define TASK_LATENCY_BENCH_TICK_US              1000
+//same load as DJI_USE_CPU_LOAD_TEST of application.c, sample tasks encoding and sending data, and monitor task
+//formatting its log, all created through osal without policy
+#define TASK_LATENCY_BENCH_LOAD_BUSY_US         80000
+#define TASK_LATENCY_BENCH_LOAD_PERIOD_US       100000
+#define TASK_LATENCY_BENCH_SAMPLE_BUSY_US       30000
+#define TASK_LATENCY_BENCH_SAMPLE_PERIOD_US     40000
+#define TASK_LATENCY_BENCH_MONITOR_BUSY_US      5000
+#define TASK_LATENCY_BENCH_MONITOR_PERIOD_US    100000
+#define TASK_LATENCY_BENCH_LOAD_TASK_NUM        3
+//protocol frames arrive every 200 to 2000 us
+#define TASK_LATENCY_BENCH_FRAME_GAP_MIN_US     200
+#define TASK_LATENCY_BENCH_FRAME_GAP_MAX_US     2000
+#define TASK_LATENCY_BENCH_FRAME_LEN            16
+#define TASK_LATENCY_BENCH_FRAME_FILL           0x5A
+#define TASK_LATENCY_BENCH_BUFFER_SIZE          8192
+#define TASK_LATENCY_BENCH_RUN_US               3000000
+#define TASK_LATENCY_BENCH_SAMPLE_NUM_MAX       (TASK_LATENCY_BENCH_RUN_US / TASK_LATENCY_BENCH_FRAME_GAP_MIN_US)
+
+/* Private types -------------------------------------------------------------*/
+typedef struct {
+    const char *name;
+    uint8_t rootTaskPriority;
+    //background tasks share one priority, as tasks created without policy do
+    uint8_t loadTaskPriority;
+} T_TaskLatencyBenchCase;
+
+typedef struct {
+    const char *name;
+    uint32_t busyUs;
+    uint32_t periodUs;
+} T_TaskLatencyBenchLoad;
+
+typedef struct {
+    uint32_t sampleNum;
+    uint32_t averageUs;
+    uint32_t p50Us;
+    uint32_t p90Us;
+    uint32_t p99Us;
+    uint32_t maxUs;
+    uint32_t sentFrameNum;
+    uint32_t badFrameNum;
+} T_TaskLatencyBenchResult;
+
+/* Private values -------------------------------------------------------------*/
+static const T_TaskLatencyBenchCase s_benchCases[] = {
+    {"all tasks at priority 0", TASK_LATENCY_BENCH_PRIORITY_IDLE, TASK_LATENCY_BENCH_PRIORITY_IDLE},
+    {"task policy of application.c", TASK_LATENCY_BENCH_PRIORITY_HIGH, TASK_LATENCY_BENCH_PRIORITY_NORMAL},
+};
+static const T_TaskLatencyBenchLoad s_loadTasks[TASK_LATENCY_BENCH_LOAD_TASK_NUM] = {
+    {"cpu load", TASK_LATENCY_BENCH_LOAD_BUSY_US, TASK_LATENCY_BENCH_LOAD_PERIOD_US},
+    {"sample", TASK_LATENCY_BENCH_SAMPLE_BUSY_US, TASK_LATENCY_BENCH_SAMPLE_PERIOD_US},
+    {"monitor", TASK_LATENCY_BENCH_MONITOR_BUSY_US, TASK_LATENCY_BENCH_MONITOR_PERIOD_US},
+};
+static uint8_t s_memory[TASK_LATENCY_BENCH_BUFFER_SIZE];
+static T_RingBuffer s_ringBuffer;
+static pthread_mutex_t s_ringBufferMutex = PTHREAD_MUTEX_INITIALIZER;
+static volatile int s_isIrqStop;
+static volatile int s_isStop;
+static uint32_t s_latencyUs[TASK_LATENCY_BENCH_SAMPLE_NUM_MAX];
+static uint32_t s_sampleNum;
+static uint32_t s_sentFrameNum;
+static uint32_t s_badFrameNum;
+
+/* Private functions declaration ---------------------------------------------*/
+static int TaskLatencyBench_Run(const T_TaskLatencyBenchCase *benchCase, T_TaskLatencyBenchResult *result);
+static int TaskLatencyBench_StartThread(pthread_t *thread, int rtPriority, void *(*func)(void *), void *arg);
+static void *TaskLatencyBench_UartIrq(void *arg);
+static void *TaskLatencyBench_RootTask(void *arg);
+static void *TaskLatencyBench_LoadTask(void *arg);
+static int TaskLatencyBench_CompareUint32(const void *a, const void *b);
+static uint64_t TaskLatencyBench_GetMonotonicUs(void);
+static void TaskLatencyBench_SleepUntilUs(uint64_t timeUs);
+
+/* Exported functions definition ---------------------------------------------*/
+int main(void)
+{
+    T_TaskLatencyBenchResult result;
+    struct sched_param param = {.sched_priority = TASK_LATENCY_BENCH_RT_PRIORITY_MAIN};
+    cpu_set_t cpuSet;
+    int isFail = 0;
+    uint32_t i;
+    int ret;
+
+    //a single core as on STM32F4, threads created later inherit affinity
+    CPU_ZERO(&cpuSet);
+    CPU_SET(0, &cpuSet);
+    if (sched_setaffinity(0, sizeof(cpuSet), &cpuSet) != 0) {
+        printf("task latency bench: set affinity error %d\r\n", errno);
+        return 1;
+    }
+    ret = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (ret == EPERM) {
+        printf("task latency bench: real time scheduling not permitted, run as root or with CAP_SYS_NICE\r\n");
+        printf("BENCH SKIPPED\r\n");
+        return 0;
+    } else if (ret != 0) {
+        printf("task latency bench: set scheduling policy error %d\r\n", ret);
+        return 1;
+    }
+
+    printf("uart to callback latency, frames every %d to %d us, background tasks:\r\n",
+           TASK_LATENCY_BENCH_FRAME_GAP_MIN_US, TASK_LATENCY_BENCH_FRAME_GAP_MAX_US);
+    for (i = 0; i < TASK_LATENCY_BENCH_LOAD_TASK_NUM; i++) {
+        printf("  %-8s busy %2u of %3u ms\r\n", s_loadTasks[i].name, s_loadTasks[i].busyUs / 1000,
+               s_loadTasks[i].periodUs / 1000);
+    }
+    printf("root task polls uart every %d us tick, %d s per case:\r\n", TASK_LATENCY_BENCH_TICK_US,
+           TASK_LATENCY_BENCH_RUN_US / 1000000);
+    for (i = 0; i < sizeof(s_benchCases) / sizeof(s_benchCases[0]); i++) {
+        if (TaskLatencyBench_Run(&s_benchCases[i], &result) != 0) {
+            return 1;
+        }
+        printf("  %-30s avg %5u us  p50 %5u us  p90 %5u us  p99 %5u us  max %6u us\r\n", s_benchCases[i].name,
+               result.averageUs, result.p50Us, result.p90Us, result.p99Us, result.maxUs);
+
+        //every frame sent must reach the callback intact, whatever the latency
+        if (result.sampleNum == 0 || result.sampleNum != result.sentFrameNum || result.badFrameNum != 0) {
+            printf("  %u of %u frames received, %u bad\r\n", result.sampleNum, result.sentFrameNum,
+                   result.badFrameNum);
+            isFail = 1;
+        }
+    }
+
+    printf("%s\r\n", isFail ? "CHECK FAIL" : "CHECK PASS");
+
+    return isFail;
+}
+
+/* Private functions definition-----------------------------------------------*/
+/**
+ * @brief Run receive interrupt, root task and background tasks with priorities of a case.
+ * @param benchCase: pointer to case.
+ * @param result: pointer to latency result.
+ * @return 0 on success, -1 if threads could not be started.
+ */
+static int TaskLatencyBench_Run(const T_TaskLatencyBenchCase *benchCase, T_TaskLatencyBenchResult *result)
+{
+    pthread_t taskThreads[TASK_LATENCY_BENCH_LOAD_TASK_NUM + 1];
+    pthread_t irqThread;
+    uint64_t sumUs = 0;
+    int taskThreadNum = 0;
+    int isIrqStarted = 0;
+    uint32_t i;
+
+    memset(result, 0, sizeof(T_TaskLatencyBenchResult));
+    RingBuf_Init(&s_ringBuffer, s_memory, sizeof(s_memory));
+    s_isIrqStop = 0;
+    s_isStop = 0;
+    s_sampleNum = 0;
+    s_sentFrameNum = 0;
+    s_badFrameNum = 0;
+
+    for (i = 0; i < TASK_LATENCY_BENCH_LOAD_TASK_NUM; i++) {
+        if (TaskLatencyBench_StartThread(&taskThreads[taskThreadNum], TASK_LATENCY_BENCH_RT_PRIORITY_BASE +
+                                         benchCase->loadTaskPriority, TaskLatencyBench_LoadTask,
+                                         (void *) &s_loadTasks[i]) == 0) {
+            taskThreadNum++;
+        }
+    }
+    if (TaskLatencyBench_StartThread(&taskThreads[taskThreadNum], TASK_LATENCY_BENCH_RT_PRIORITY_BASE +
+                                     benchCase->rootTaskPriority, TaskLatencyBench_RootTask, NULL) == 0) {
+        taskThreadNum++;
+    }
+    if (TaskLatencyBench_StartThread(&irqThread, TASK_LATENCY_BENCH_RT_PRIORITY_IRQ, TaskLatencyBench_UartIrq,
+                                     NULL) == 0) {
+        isIrqStarted = 1;
+    }
+    if (isIrqStarted && taskThreadNum == TASK_LATENCY_BENCH_LOAD_TASK_NUM + 1) {
+        TaskLatencyBench_SleepUntilUs(TaskLatencyBench_GetMonotonicUs() + TASK_LATENCY_BENCH_RUN_US);
+    }
+
+    //frames stop first, so that root task takes the last of them before tasks stop
+    s_isIrqStop = 1;
+    if (isIrqStarted) {
+        pthread_join(irqThread, NULL);
+    }
+    TaskLatencyBench_SleepUntilUs(TaskLatencyBench_GetMonotonicUs() + TASK_LATENCY_BENCH_LOAD_PERIOD_US);
+    s_isStop = 1;
+    for (i = 0; i < (uint32_t) taskThreadNum; i++) {
+        pthread_join(taskThreads[i], NULL);
+    }
+    if (!isIrqStarted || taskThreadNum != TASK_LATENCY_BENCH_LOAD_TASK_NUM + 1) {
+        printf("task latency bench: start thread error\r\n");
+        return -1;
+    }
+
+    qsort(s_latencyUs, s_sampleNum, sizeof(s_latencyUs[0]), TaskLatencyBench_CompareUint32);
+    for (i = 0; i < s_sampleNum; i++) {
+        sumUs += s_latencyUs[i];
+    }
+    result->sampleNum = s_sampleNum;
+    result->sentFrameNum = s_sentFrameNum;
+    result->badFrameNum = s_badFrameNum;
+    if (s_sampleNum != 0) {
+        result->averageUs = (uint32_t) (sumUs / s_sampleNum);
+        result->p50Us = s_latencyUs[s_sampleNum / 2];
+        result->p90Us = s_latencyUs[(uint64_t) s_sampleNum * 90 / 100];
+        result->p99Us = s_latencyUs[(uint64_t) s_sampleNum * 99 / 100];
+        result->maxUs = s_latencyUs[s_sampleNum - 1];
+    }
+
+    return 0;
+}
+
+static int TaskLatencyBench_StartThread(pthread_t *thread, int rtPriority, void *(*func)(void *), void *arg)
+{
+    struct sched_param param = {.sched_priority = rtPriority};
+    pthread_attr_t attr;
+    int ret;
+
+    pthread_attr_init(&attr);
+    pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+    pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+    pthread_attr_setschedparam(&attr, &param);
+    ret = pthread_create(thread, &attr, func, arg);
+    pthread_attr_destroy(&attr);
+
+    return ret;
+}
+
+/**
+ * @brief Receive interrupt, puts a time stamped frame into read ring buffer at random intervals.
+ */
+static void *TaskLatencyBench_UartIrq(void *arg)
+{
+    uint8_t frame[TASK_LATENCY_BENCH_FRAME_LEN];
+    uint32_t seed = 1;
+    uint64_t timeUs;
+
+    (void) arg;
+    memset(frame, TASK_LATENCY_BENCH_FRAME_FILL, sizeof(frame));
+    timeUs = TaskLatencyBench_GetMonotonicUs();
+    while (!s_isIrqStop) {
+        seed = seed * 1664525U + 1013904223U;
+        timeUs += TASK_LATENCY_BENCH_FRAME_GAP_MIN_US +
+                  (seed >> 8) % (TASK_LATENCY_BENCH_FRAME_GAP_MAX_US - TASK_LATENCY_BENCH_FRAME_GAP_MIN_US + 1);
+        TaskLatencyBench_SleepUntilUs(timeUs);
+
+        timeUs = TaskLatencyBench_GetMonotonicUs();
+        memcpy(frame, &timeUs, sizeof(timeUs));
+        pthread_mutex_lock(&s_ringBufferMutex);
+        if (RingBuf_Put(&s_ringBuffer, frame, sizeof(frame)) == sizeof(frame)) {
+            s_sentFrameNum++;
+        }
+        pthread_mutex_unlock(&s_ringBufferMutex);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Root task of payload sdk, reads communication uart every tick and hands frames to callbacks.
+ */
+static void *TaskLatencyBench_RootTask(void *arg)
+{
+    uint8_t buf[TASK_LATENCY_BENCH_FRAME_LEN * 64];
+    uint64_t frameTimeUs;
+    uint64_t timeUs;
+    uint16_t readLen;
+    uint16_t i;
+
+    (void) arg;
+    while (!s_isStop) {
+        //vTaskDelay(1) wakes on next tick
+        timeUs = TaskLatencyBench_GetMonotonicUs();
+        TaskLatencyBench_SleepUntilUs((timeUs / TASK_LATENCY_BENCH_TICK_US + 1) * TASK_LATENCY_BENCH_TICK_US);
+
+        do {
+            pthread_mutex_lock(&s_ringBufferMutex);
+            readLen = RingBuf_Get(&s_ringBuffer, buf, sizeof(buf));
+            pthread_mutex_unlock(&s_ringBufferMutex);
+
+            timeUs = TaskLatencyBench_GetMonotonicUs();
+            for (i = 0; i + TASK_LATENCY_BENCH_FRAME_LEN <= readLen; i += TASK_LATENCY_BENCH_FRAME_LEN) {
+                memcpy(&frameTimeUs, &buf[i], sizeof(frameTimeUs));
+                if (frameTimeUs > timeUs ||
+                    buf[i + TASK_LATENCY_BENCH_FRAME_LEN - 1] != TASK_LATENCY_BENCH_FRAME_FILL) {
+                    s_badFrameNum++;
+                } else if (s_sampleNum < TASK_LATENCY_BENCH_SAMPLE_NUM_MAX) {
+                    s_latencyUs[s_sampleNum++] = (uint32_t) (timeUs - frameTimeUs);
+                }
+            }
+        } while (readLen == sizeof(buf));
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief CPU bound task, busy for part of every period, gives way to tasks of equal priority at every tick like
+ *        time slicing of FreeRTOS, where tick interrupt also wakes tasks that delay until that tick.
+ */
+static void *TaskLatencyBench_LoadTask(void *arg)
+{
+    const T_TaskLatencyBenchLoad *load = (const T_TaskLatencyBenchLoad *) arg;
+    uint64_t periodStartUs = TaskLatencyBench_GetMonotonicUs();
+    uint64_t tick;
+    uint64_t timeUs;
+
+    while (!s_isStop) {
+        tick = periodStartUs / TASK_LATENCY_BENCH_TICK_US;
+        do {
+            timeUs = TaskLatencyBench_GetMonotonicUs();
+            if (timeUs / TASK_LATENCY_BENCH_TICK_US != tick) {
+                sched_yield();
+                //slice starts when task gets cpu back, which is after other tasks of its priority had theirs
+                timeUs = TaskLatencyBench_GetMonotonicUs();
+                tick = timeUs / TASK_LATENCY_BENCH_TICK_US;
+            }
+        } while (timeUs - periodStartUs < load->busyUs && !s_isStop);
+
+        periodStartUs += load->periodUs;
+        TaskLatencyBench_SleepUntilUs(periodStartUs);
+    }
+
+    return NULL;
+}
+
+static int TaskLatencyBench_CompareUint32(const void *a, const void *b)
+{
+    uint32_t valueA = *(const uint32_t *) a;
+    uint32_t valueB = *(const uint32_t *) b;
+
+    return valueA < valueB ? -1 : valueA > valueB;
+}
+
+static uint64_t TaskLatencyBench_GetMonotonicUs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void TaskLatencyBench_SleepUntilUs(uint64_t timeUs)
+{
+    struct timespec ts;
+
+    ts.tv_sec = (time_t) (timeUs / 1000000);
+    ts.tv_nsec = (long) (timeUs % 1000000) * 1000;
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+    }
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
@@ -0,0 +1,334 @@
+/**
+ ********************************************************************
+ * @file    textcodec_bench.c
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   Host benchmark of UTF8ToGBK against the sorted pair table with binary search it replaced.
+ *          Run without argument for a generated corpus of common Chinese text, or with path of a UTF-8
+ *          corpus file.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "textcodec.h"
+#include "textcodec_table.h"
+
+/* Private constants ---------------------------------------------------------*/
+#define TEXTCODEC_BENCH_CORPUS_CHAR_NUM     1000000
+#define TEXTCODEC_BENCH_MIN_DURATION_NS     500000000ULL
+//GB2312 level 1 characters, the 3755 most common ones, have GBK lead byte B0 to D7
+#define TEXTCODEC_BENCH_COMMON_LEAD_MIN     0xB0
+#define TEXTCODEC_BENCH_COMMON_LEAD_MAX     0xD7
+
+/* Private types -------------------------------------------------------------*/
+typedef void (*TextCodecBenchFunc)(const uint8_t *from, uint32_t fromSize, uint8_t *to, uint32_t *toSize);
+
+typedef struct {
+    double charsPerSecond;
+    double megaBytesPerSecond;
+    uint32_t outputSize;
+} T_TextCodecBenchResult;
+
+/* Private values -------------------------------------------------------------*/
+static uint16_t *s_pairTable = NULL;
+static uint32_t s_pairTableSize = 0;
+
+/* Private functions declaration ---------------------------------------------*/
+static void TextCodecBench_BuildPairTable(void);
+static uint16_t TextCodecBench_PairConvert(uint16_t src);
+static void TextCodecBench_PairUtf8ToGbk(const uint8_t *from, uint32_t fromSize, uint8_t *to, uint32_t *toSize);
+static uint8_t *TextCodecBench_MakeCorpus(uint32_t *size, uint32_t *charNum);
+static uint8_t *TextCodecBench_LoadCorpus(const char *path, uint32_t *size, uint32_t *charNum);
+static void TextCodecBench_Measure(TextCodecBenchFunc func, const uint8_t *corpus, uint32_t size, uint32_t charNum,
+                                   uint8_t *output, T_TextCodecBenchResult *result);
+static uint64_t TextCodecBench_GetMonotonicNs(void);
+
+/* Exported functions definition ---------------------------------------------*/
+int main(int argc, char *argv[])
+{
+    T_TextCodecBenchResult pairResult;
+    T_TextCodecBenchResult pageResult;
+    uint8_t *corpus;
+    uint8_t *pairOutput;
+    uint8_t *pageOutput;
+    uint32_t size;
+    uint32_t charNum;
+    uint32_t pageTableSize = sizeof(g_textCodecUnicodeToGbkIndex) + sizeof(g_textCodecUnicodeToGbkPage);
+
+    corpus = argc > 1 ? TextCodecBench_LoadCorpus(argv[1], &size, &charNum) :
+             TextCodecBench_MakeCorpus(&size, &charNum);
+    if (corpus == NULL) {
+        return 1;
+    }
+
+    TextCodecBench_BuildPairTable();
+    //old conversion may write 2 bytes for every byte of a malformed input
+    pairOutput = malloc((size_t) size * 2 + 4);
+    pageOutput = malloc(size);
+    if (s_pairTable == NULL || pairOutput == NULL || pageOutput == NULL) {
+        printf("textcodec bench out of memory\r\n");
+        return 1;
+    }
+
+    TextCodecBench_Measure(TextCodecBench_PairUtf8ToGbk, corpus, size, charNum, pairOutput, &pairResult);
+    TextCodecBench_Measure(UTF8ToGBK, corpus, size, charNum, pageOutput, &pageResult);
+
+    printf("corpus: %u bytes, %u characters\r\n", size, charNum);
+    printf("pair table + binary search: %10.0f char/s, %7.1f MB/s, table %u bytes\r\n",
+           pairResult.charsPerSecond, pairResult.megaBytesPerSecond, s_pairTableSize);
+    printf("page table direct index:    %10.0f char/s, %7.1f MB/s, table %u bytes\r\n",
+           pageResult.charsPerSecond, pageResult.megaBytesPerSecond, pageTableSize);
+    printf("speedup %.2fx, flash %+d bytes, output %s\r\n",
+           pageResult.charsPerSecond / pairResult.charsPerSecond, (int32_t) (pageTableSize - s_pairTableSize),
+           pairResult.outputSize == pageResult.outputSize &&
+           memcmp(pairOutput, pageOutput, pageResult.outputSize) == 0 ? "identical" :
+           "differs, expected for input beyond 1 and 3 byte characters");
+
+    free(pageOutput);
+    free(pairOutput);
+    free(s_pairTable);
+    free(corpus);
+
+    return 0;
+}
+
+/* Private functions definition-----------------------------------------------*/
+//rebuild uni2oem table of the old textcodec.c, same sorted Unicode - GBK pairs closed by a 0, 0 pair
+static void TextCodecBench_BuildPairTable(void)
+{
+    uint32_t code;
+    uint16_t gbk;
+    uint32_t count = 0;
+
+    s_pairTable = malloc((TEXTCODEC_TABLE_UNICODE_TO_GBK_CODE_NUM + 1) * 2 * sizeof(uint16_t));
+    if (s_pairTable == NULL) {
+        return;
+    }
+
+    for (code = 0x80; code <= 0xFFFF; code++) {
+        gbk = g_textCodecUnicodeToGbkPage[g_textCodecUnicodeToGbkIndex[code >> 8]][code & 0xFF];
+        if (gbk != 0) {
+            s_pairTable[count * 2] = (uint16_t) code;
+            s_pairTable[count * 2 + 1] = gbk;
+            count++;
+        }
+    }
+    s_pairTable[count * 2] = 0;
+    s_pairTable[count * 2 + 1] = 0;
+    s_pairTableSize = (count + 1) * 2 * sizeof(uint16_t);
+}
+
+//ff_convert of the old textcodec.c in unicode to gbk direction
+static uint16_t TextCodecBench_PairConvert(uint16_t src)
+{
+    const uint16_t *p = s_pairTable;
+    int i = 0;
+    int n;
+    int li = 0;
+    int hi = (int) (s_pairTableSize >> 2) - 1;
+
+    if (src < 0x80) {
+        return src;
+    }
+
+    for (n = 16; n; n--) {
+        i = li + (hi - li) / 2;
+        if (src == p[i << 1]) {
+            break;
+        }
+        if (src > p[i << 1]) {
+            li = i;
+        } else {
+            hi = i;
+        }
+    }
+
+    return n ? p[(i << 1) + 1] : 0;
+}
+
+//UTF8ToGBK of the old textcodec.c, which takes every non ASCII character as 3 bytes, only guarded against
+//reading past the end of input
+static void TextCodecBench_PairUtf8ToGbk(const uint8_t *from, uint32_t fromSize, uint8_t *to, uint32_t *toSize)
+{
+    uint32_t unicode;
+    uint32_t utfcode;
+    uint32_t size = 0;
+
+    while (fromSize != 0) {
+        if (*from < 0x80) {
+            utfcode = *from;
+            from++;
+            fromSize--;
+        } else {
+            if (fromSize < 3) {
+                break;
+            }
+            utfcode = (from[0] << 16) | (from[1] << 8) | from[2];
+            from += 3;
+            fromSize -= 3;
+        }
+
+        if (utfcode < 0x80U) {
+            unicode = utfcode;
+        } else if (utfcode >= 0x0000C080U && utfcode <= 0x0000DFBFU) {
+            unicode = (((utfcode >> 8) & 0x1FU) << 6) | (utfcode & 0x3FU);
+        } else if (utfcode >= 0x00E08080U && utfcode <= 0x00EFBFBFU) {
+            unicode = (((utfcode >> 16) & 0xFU) << 12) | (((utfcode >> 8) & 0x3FU) << 6) | (utfcode & 0x3FU);
+        } else {
+            break;
+        }
+
+        if (unicode < 0x80) {
+            *to++ = unicode;
+            size++;
+        } else {
+            unicode = TextCodecBench_PairConvert(unicode);
+            to[0] = (unicode >> 8) & 0xFF;
+            to[1] = unicode & 0xFF;
+            to += 2;
+            size += 2;
+        }
+    }
+    *toSize = size;
+}
+
+//common characters with about one in ten being ASCII space, digit or Chinese punctuation, like plain Chinese text
+static uint8_t *TextCodecBench_MakeCorpus(uint32_t *size, uint32_t *charNum)
+{
+    static const uint32_t punctuation[] = {0xFF0C, 0x3002, 0x3001, 0xFF1A, 0x201C, 0x201D};
+    uint32_t *common;
+    uint32_t commonNum = 0;
+    uint32_t seed = 1;
+    uint32_t code;
+    uint32_t random;
+    uint32_t i;
+    uint16_t gbk;
+    uint8_t *corpus;
+    uint8_t *p;
+
+    common = malloc(0x10000 * sizeof(uint32_t));
+    corpus = malloc(TEXTCODEC_BENCH_CORPUS_CHAR_NUM * 3);
+    if (common == NULL || corpus == NULL) {
+        free(common);
+        free(corpus);
+        printf("textcodec bench out of memory\r\n");
+        return NULL;
+    }
+
+    for (code = 0x4E00; code <= 0x9FFF; code++) {
+        gbk = g_textCodecUnicodeToGbkPage[g_textCodecUnicodeToGbkIndex[code >> 8]][code & 0xFF];
+        if ((gbk >> 8) >= TEXTCODEC_BENCH_COMMON_LEAD_MIN && (gbk >> 8) <= TEXTCODEC_BENCH_COMMON_LEAD_MAX) {
+            common[commonNum++] = code;
+        }
+    }
+
+    p = corpus;
+    for (i = 0; i < TEXTCODEC_BENCH_CORPUS_CHAR_NUM; i++) {
+        seed = seed * 1103515245 + 12345;
+        random = seed >> 8;
+        if (random % 20 == 0) {
+            *p++ = (uint8_t) (random % 3 == 0 ? ' ' : '0' + random % 10);
+            continue;
+        }
+        code = random % 20 == 1 ? punctuation[random % (sizeof(punctuation) / sizeof(punctuation[0]))] :
+               common[random % commonNum];
+        *p++ = (uint8_t) (0xE0 | (code >> 12));
+        *p++ = (uint8_t) (0x80 | ((code >> 6) & 0x3F));
+        *p++ = (uint8_t) (0x80 | (code & 0x3F));
+    }
+
+    free(common);
+    *size = (uint32_t) (p - corpus);
+    *charNum = TEXTCODEC_BENCH_CORPUS_CHAR_NUM;
+
+    return corpus;
+}
+
+static uint8_t *TextCodecBench_LoadCorpus(const char *path, uint32_t *size, uint32_t *charNum)
+{
+    FILE *file;
+    uint8_t *corpus;
+    long fileSize;
+    uint32_t i;
+
+    file = fopen(path, "rb");
+    if (file == NULL) {
+        printf("textcodec bench open %s error\r\n", path);
+        return NULL;
+    }
+
+    fseek(file, 0, SEEK_END);
+    fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    corpus = fileSize > 0 ? malloc((size_t) fileSize) : NULL;
+    if (corpus == NULL || fread(corpus, 1, (size_t) fileSize, file) != (size_t) fileSize) {
+        printf("textcodec bench read %s error\r\n", path);
+        free(corpus);
+        fclose(file);
+        return NULL;
+    }
+    fclose(file);
+
+    *size = (uint32_t) fileSize;
+    *charNum = 0;
+    for (i = 0; i < *size; i++) {
+        if ((corpus[i] & 0xC0) != 0x80) {
+            (*charNum)++;
+        }
+    }
+
+    return corpus;
+}
+
+static void TextCodecBench_Measure(TextCodecBenchFunc func, const uint8_t *corpus, uint32_t size, uint32_t charNum,
+                                   uint8_t *output, T_TextCodecBenchResult *result)
+{
+    uint64_t startNs;
+    uint64_t durationNs;
+    uint32_t round = 0;
+
+    //warm up caches and table pages before timing
+    func(corpus, size, output, &result->outputSize);
+
+    startNs = TextCodecBench_GetMonotonicNs();
+    do {
+        func(corpus, size, output, &result->outputSize);
+        round++;
+        durationNs = TextCodecBench_GetMonotonicNs() - startNs;
+    } while (durationNs < TEXTCODEC_BENCH_MIN_DURATION_NS);
+
+    result->charsPerSecond = (double) charNum * round * 1e9 / (double) durationNs;
+    result->megaBytesPerSecond = (double) size * round * 1e3 / (double) durationNs;
+}
+
+static uint64_t TextCodecBench_GetMonotonicNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
@@ -0,0 +1,840 @@
+/**
+ ********************************************************************
+ * @file    textcodec_suite.c
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   Host conformance and benchmark suite of the text conversion paths: textcodec.c tables, utftogbk.c
+ *          iconv and the file name conversion of the widget speaker. Checks round trip over all GBK code points
+ *          and malformed input, then measures throughput and per call latency for several string lengths.
+ *          Run with --json for one JSON object per line, --check-only to skip the benchmark. Exit code is
+ *          not zero when a check fails.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <time.h>
+#include "dji_widget.h"
+#include "textcodec.h"
+#include "textcodec_table.h"
+#include "utftogbk.h"
+
+/* Private constants ---------------------------------------------------------*/
+#define TEXTCODEC_SUITE_FUZZ_ROUND              200000
+#define TEXTCODEC_SUITE_FUZZ_LEN_MAX            64
+//bytes behind every output buffer that a conversion must leave untouched
+#define TEXTCODEC_SUITE_GUARD_SIZE              16
+#define TEXTCODEC_SUITE_GUARD_BYTE              0xA5
+#define TEXTCODEC_SUITE_STREAM_CHUNK_MAX        7
+#define TEXTCODEC_SUITE_STREAM_BENCH_CHUNK      4096
+#define TEXTCODEC_SUITE_MIN_DURATION_NS         200000000ULL
+#define TEXTCODEC_SUITE_LATENCY_SAMPLE_NUM      20000
+#define TEXTCODEC_SUITE_CORPUS_CHAR_NUM         32768
+#define TEXTCODEC_SUITE_FAILURE_PRINT_MAX       5
+//GB2312 level 1 characters, which every path can convert, have lead byte B0 to D7, D7FA to D7FE are not assigned
+#define TEXTCODEC_SUITE_LEVEL1_LEAD_MIN         0xB0
+#define TEXTCODEC_SUITE_LEVEL1_LEAD_MAX         0xD7
+//both bytes of a GB2312 code are A1 to FE
+#define TEXTCODEC_SUITE_GB2312_BYTE_MIN         0xA1
+#define TEXTCODEC_SUITE_GB2312_BYTE_MAX         0xFE
+
+/* Private types -------------------------------------------------------------*/
+//every path takes input and output capacity, returns output size or -1 when it rejects the input
+typedef int (*TextCodecSuiteFunc)(const uint8_t *from, uint32_t fromSize, uint8_t *to, uint32_t toCapacity);
+
+typedef enum {
+    TEXTCODEC_SUITE_INPUT_UTF8 = 0,
+    TEXTCODEC_SUITE_INPUT_GBK,
+} E_TextCodecSuiteInput;
+
+typedef struct {
+    const char *name;
+    TextCodecSuiteFunc func;
+    E_TextCodecSuiteInput input;
+    //worst case output bytes for every input byte
+    uint32_t expansion;
+} T_TextCodecSuitePath;
+
+typedef struct {
+    const char *name;
+    const char *input;
+    uint32_t inputLen;
+    const char *expect;
+    uint32_t expectLen;
+} T_TextCodecSuiteCase;
+
+/* Private values -------------------------------------------------------------*/
+static int s_isJson = 0;
+static uint32_t s_failedCheckNum = 0;
+static uint32_t s_seed = 1;
+//0 for random chunks of 1 to TEXTCODEC_SUITE_STREAM_CHUNK_MAX bytes
+static uint32_t s_streamChunkSize = 0;
+
+/* Private functions declaration ---------------------------------------------*/
+static int TextCodecSuite_TextCodecUtf8ToGbk(const uint8_t *from, uint32_t fromSize, uint8_t *to,
+                                             uint32_t toCapacity);
+static int TextCodecSuite_TextCodecGbkToUtf8(const uint8_t *from, uint32_t fromSize, uint8_t *to,
+                                             uint32_t toCapacity);
+static int TextCodecSuite_IconvUtf8ToGb2312(const uint8_t *from, uint32_t fromSize, uint8_t *to,
+                                            uint32_t toCapacity);
+static int TextCodecSuite_IconvGb2312ToUtf8(const uint8_t *from, uint32_t fromSize, uint8_t *to,
+                                            uint32_t toCapacity);
+static int TextCodecSuite_IconvStreamUtf8ToGb2312(const uint8_t *from, uint32_t fromSize, uint8_t *to,
+                                                  uint32_t toCapacity);
+static int TextCodecSuite_SpeakerFileName(const uint8_t *from, uint32_t fromSize, uint8_t *to,
+                                          uint32_t toCapacity);
+static void TextCodecSuite_Report(const char *check, uint32_t total, uint32_t failed, const char *detail);
+static void TextCodecSuite_PrintFailure(uint32_t *printed, const char *format, ...);
+static int TextCodecSuite_IsValidUtf8(const uint8_t *data, uint32_t size);
+static int TextCodecSuite_IsValidGbk(const uint8_t *data, uint32_t size);
+static int TextCodecSuite_Run(TextCodecSuiteFunc func, const uint8_t *from, uint32_t fromSize, uint8_t *to,
+                              uint32_t toCapacity, int *isGuardBroken);
+static void TextCodecSuite_CheckGbkRoundTrip(void);
+static void TextCodecSuite_CheckGb2312RoundTrip(void);
+static void TextCodecSuite_CheckUnmappedUnicode(void);
+static void TextCodecSuite_CheckCases(void);
+static void TextCodecSuite_CheckFuzz(const T_TextCodecSuitePath *path, uint32_t pathNum);
+static void TextCodecSuite_CheckSpeakerFileName(void);
+static uint32_t TextCodecSuite_Random(void);
+static uint8_t *TextCodecSuite_MakeGbkCorpus(uint32_t charNum, uint32_t *size);
+static void TextCodecSuite_Bench(const T_TextCodecSuitePath *path, uint32_t pathNum);
+static uint64_t TextCodecSuite_GetMonotonicNs(void);
+static int TextCodecSuite_CompareU64(const void *a, const void *b);
+
+/* Exported functions definition ---------------------------------------------*/
+int main(int argc, char *argv[])
+{
+    static const T_TextCodecSuitePath path[] = {
+        {"textcodec_utf8_to_gbk",       TextCodecSuite_TextCodecUtf8ToGbk,      TEXTCODEC_SUITE_INPUT_UTF8, 1},
+        {"textcodec_gbk_to_utf8",       TextCodecSuite_TextCodecGbkToUtf8,      TEXTCODEC_SUITE_INPUT_GBK,  3},
+        {"iconv_utf8_to_gb2312",        TextCodecSuite_IconvUtf8ToGb2312,       TEXTCODEC_SUITE_INPUT_UTF8, 1},
+        {"iconv_gb2312_to_utf8",        TextCodecSuite_IconvGb2312ToUtf8,       TEXTCODEC_SUITE_INPUT_GBK,  3},
+        {"iconv_stream_utf8_to_gb2312", TextCodecSuite_IconvStreamUtf8ToGb2312, TEXTCODEC_SUITE_INPUT_UTF8, 1},
+    };
+    uint32_t pathNum = sizeof(path) / sizeof(path[0]);
+    int isCheckOnly = 0;
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) {
+            s_isJson = 1;
+        } else if (strcmp(argv[i], "--check-only") == 0) {
+            isCheckOnly = 1;
+        } else {
+            printf("usage: %s [--json] [--check-only]\r\n", argv[0]);
+            return 2;
+        }
+    }
+
+    TextCodecSuite_CheckGbkRoundTrip();
+    TextCodecSuite_CheckGb2312RoundTrip();
+    TextCodecSuite_CheckUnmappedUnicode();
+    TextCodecSuite_CheckCases();
+    TextCodecSuite_CheckFuzz(path, pathNum);
+    TextCodecSuite_CheckSpeakerFileName();
+
+    if (!isCheckOnly) {
+        TextCodecSuite_Bench(path, pathNum);
+    }
+
+    if (s_isJson) {
+        printf("{\"type\":\"summary\",\"failed_checks\":%u}\n", s_failedCheckNum);
+    } else {
+        printf("%s, %u check(s) failed\r\n", s_failedCheckNum == 0 ? "PASS" : "FAIL", s_failedCheckNum);
+    }
+
+    return s_failedCheckNum == 0 ? 0 : 1;
+}
+
+/* Private functions definition-----------------------------------------------*/
+static int TextCodecSuite_TextCodecUtf8ToGbk(const uint8_t *from, uint32_t fromSize, uint8_t *to,
+                                             uint32_t toCapacity)
+{
+    uint32_t toSize;
+
+    //GBK output is never longer than UTF-8 input
+    if (toCapacity < fromSize) {
+        return -1;
+    }
+    UTF8ToGBK(from, fromSize, to, &toSize);
+
+    return (int) toSize;
+}
+
+static int TextCodecSuite_TextCodecGbkToUtf8(const uint8_t *from, uint32_t fromSize, uint8_t *to,
+                                             uint32_t toCapacity)
+{
+    uint32_t toSize;
+
+    //an invalid byte takes 3 bytes of U+FFFD, a 2 byte character at most 3 bytes
+    if (toCapacity < fromSize * 3) {
+        return -1;
+    }
+    GBKToUTF8(from, fromSize, to, &toSize);
+
+    return (int) toSize;
+}
+
+static int TextCodecSuite_IconvUtf8ToGb2312(const uint8_t *from, uint32_t fromSize, uint8_t *to,
+                                            uint32_t toCapacity)
+{
+    return Utf8ToGb2312((char *) to, (int) toCapacity, (const char *) from, (int) fromSize);
+}
+
+static int TextCodecSuite_IconvGb2312ToUtf8(const uint8_t *from, uint32_t fromSize, uint8_t *to,
+                                            uint32_t toCapacity)
+{
+    return Gb2312ToUtf8((char *) to, (int) toCapacity, (const char *) from, (int) fromSize);
+}
+
+//stream with small random chunks in checks, so that most characters are split between two writes, and with
+//fixed chunks of TEXTCODEC_SUITE_STREAM_BENCH_CHUNK bytes in benchmark
+static int TextCodecSuite_IconvStreamUtf8ToGb2312(const uint8_t *from, uint32_t fromSize, uint8_t *to,
+                                                  uint32_t toCapacity)
+{
+    T_UtfToGbkStream stream;
+    uint32_t offset = 0;
+    uint32_t chunk;
+    uint32_t outLen = 0;
+    int len;
+
+    if (UtfToGbkStream_Begin(&stream, UTFTOGBK_UTF8_TO_GB2312) != 0) {
+        return -1;
+    }
+
+    while (offset < fromSize) {
+        chunk = s_streamChunkSize != 0 ? s_streamChunkSize :
+                1 + TextCodecSuite_Random() % TEXTCODEC_SUITE_STREAM_CHUNK_MAX;
+        chunk = fromSize - offset < chunk ? fromSize - offset : chunk;
+        len = UtfToGbkStream_Write(&stream, (char *) to + outLen, (int) (toCapacity - outLen),
+                                   (const char *) from + offset, (int) chunk);
+        if (len < 0) {
+            UtfToGbkStream_End(&stream);
+            return -1;
+        }
+        outLen += len;
+        offset += chunk;
+    }
+
+    return UtfToGbkStream_End(&stream) == 0 ? (int) outLen : -1;
+}
+
+//same conversion ReceiveAudioData of test_widget_speaker.c does on the file name of a transmit start event
+static int TextCodecSuite_SpeakerFileName(const uint8_t *from, uint32_t fromSize, uint8_t *to,
+                                          uint32_t toCapacity)
+{
+    T_DjiWidgetTransDataContent transDataContent = {0};
+    uint32_t gbkSize = 0;
+
+    memcpy(transDataContent.transDataStartContent.fileName, from,
+           fromSize < sizeof(transDataContent.transDataStartContent.fileName) ?
+           fromSize : sizeof(transDataContent.transDataStartContent.fileName));
+    if (toCapacity < sizeof(transDataContent.transDataStartContent.fileName)) {
+        return -1;
+    }
+
+    UTF8ToGBK((const uint8_t *) transDataContent.transDataStartContent.fileName,
+              strnlen((const char *) transDataContent.transDataStartContent.fileName,
+                      sizeof(transDataContent.transDataStartContent.fileName)), to, &gbkSize);
+
+    return (int) gbkSize;
+}
+
+static void TextCodecSuite_Report(const char *check, uint32_t total, uint32_t failed, const char *detail)
+{
+    if (failed != 0) {
+        s_failedCheckNum++;
+    }
+
+    if (s_isJson) {
+        printf("{\"type\":\"check\",\"name\":\"%s\",\"total\":%u,\"failed\":%u,\"detail\":\"%s\"}\n",
+               check, total, failed, detail);
+    } else {
+        printf("%-4s %-40s %8u case(s), %u failed%s%s\r\n", failed == 0 ? "ok" : "FAIL", check, total, failed,
+               detail[0] != '\0' ? ", " : "", detail);
+    }
+}
+
+//failures go to stderr, so they never break JSON lines on stdout
+static void TextCodecSuite_PrintFailure(uint32_t *printed, const char *format, ...)
+{
+    va_list args;
+
+    if (*printed >= TEXTCODEC_SUITE_FAILURE_PRINT_MAX) {
+        return;
+    }
+    (*printed)++;
+
+    va_start(args, format);
+    fprintf(stderr, "  ");
+    vfprintf(stderr, format, args);
+    fprintf(stderr, "\r\n");
+    va_end(args);
+}
+
+//strict UTF-8: no overlong form, surrogate or code point beyond U+10FFFF, written apart from textcodec.c
+static int TextCodecSuite_IsValidUtf8(const uint8_t *data, uint32_t size)
+{
+    uint32_t i = 0;
+    uint32_t len;
+    uint32_t code;
+    uint32_t k;
+
+    while (i < size) {
+        if (data[i] < 0x80) {
+            i++;
+            continue;
+        }
+        if (data[i] >= 0xC2 && data[i] <= 0xDF) {
+            len = 2;
+        } else if (data[i] >= 0xE0 && data[i] <= 0xEF) {
+            len = 3;
+        } else if (data[i] >= 0xF0 && data[i] <= 0xF4) {
+            len = 4;
+        } else {
+            return 0;
+        }
+        if (size - i < len) {
+            return 0;
+        }
+        code = data[i] & (0x7F >> len);
+        for (k = 1; k < len; k++) {
+            if ((data[i + k] & 0xC0) != 0x80) {
+                return 0;
+            }
+            code = (code << 6) | (data[i + k] & 0x3F);
+        }
+        if ((len == 3 && (code < 0x800 || (code >= 0xD800 && code <= 0xDFFF))) ||
+            (len == 4 && (code < 0x10000 || code > 0x10FFFF))) {
+            return 0;
+        }
+        i += len;
+    }
+
+    return 1;
+}
+
+//every non ASCII byte pair must be a GBK code in the table
+static int TextCodecSuite_IsValidGbk(const uint8_t *data, uint32_t size)
+{
+    uint32_t i = 0;
+
+    while (i < size) {
+        if (data[i] < 0x80) {
+            i++;
+            continue;
+        }
+        if (size - i < 2 || data[i] < TEXTCODEC_TABLE_GBK_LEAD_MIN || data[i] > TEXTCODEC_TABLE_GBK_LEAD_MAX ||
+            data[i + 1] < TEXTCODEC_TABLE_GBK_TRAIL_MIN || data[i + 1] > TEXTCODEC_TABLE_GBK_TRAIL_MAX ||
+            g_textCodecGbkToUnicode[data[i] - TEXTCODEC_TABLE_GBK_LEAD_MIN]
+            [data[i + 1] - TEXTCODEC_TABLE_GBK_TRAIL_MIN] == 0) {
+            return 0;
+        }
+        i += 2;
+    }
+
+    return 1;
+}
+
+//run a path on a copy of input in an exactly sized heap buffer, so that an address sanitizer build catches any
+//read past the end, and on an output buffer followed by guard bytes
+static int TextCodecSuite_Run(TextCodecSuiteFunc func, const uint8_t *from, uint32_t fromSize, uint8_t *to,
+                              uint32_t toCapacity, int *isGuardBroken)
+{
+    uint8_t *input = malloc(fromSize != 0 ? fromSize : 1);
+    uint32_t i;
+    int ret;
+
+    if (input == NULL) {
+        return -1;
+    }
+    memcpy(input, from, fromSize);
+    memset(to + toCapacity, TEXTCODEC_SUITE_GUARD_BYTE, TEXTCODEC_SUITE_GUARD_SIZE);
+
+    ret = func(input, fromSize, to, toCapacity);
+
+    *isGuardBroken = 0;
+    for (i = 0; i < TEXTCODEC_SUITE_GUARD_SIZE; i++) {
+        if (to[toCapacity + i] != TEXTCODEC_SUITE_GUARD_BYTE) {
+            *isGuardBroken = 1;
+        }
+    }
+    free(input);
+
+    return ret;
+}
+
+//every GBK code must decode to a code point that encodes back to the same code, and every unmapped code must
+//decode to U+FFFD, for textcodec.c both ways
+static void TextCodecSuite_CheckGbkRoundTrip(void)
+{
+    uint8_t gbk[2];
+    uint8_t utf8[8];
+    uint8_t back[8];
+    uint32_t utf8Size;
+    uint32_t backSize;
+    uint32_t lead;
+    uint32_t trail;
+    uint32_t total = 0;
+    uint32_t failed = 0;
+    uint32_t mapped = 0;
+    uint32_t printed = 0;
+    int isMapped;
+    char detail[64];
+
+    for (lead = TEXTCODEC_TABLE_GBK_LEAD_MIN; lead <= TEXTCODEC_TABLE_GBK_LEAD_MAX; lead++) {
+        for (trail = TEXTCODEC_TABLE_GBK_TRAIL_MIN; trail <= TEXTCODEC_TABLE_GBK_TRAIL_MAX; trail++) {
+            gbk[0] = (uint8_t) lead;
+            gbk[1] = (uint8_t) trail;
+            isMapped = g_textCodecGbkToUnicode[lead - TEXTCODEC_TABLE_GBK_LEAD_MIN]
+                       [trail - TEXTCODEC_TABLE_GBK_TRAIL_MIN] != 0;
+            total++;
+            mapped += isMapped;
+
+            GBKToUTF8(gbk, sizeof(gbk), utf8, &utf8Size);
+            if (!isMapped) {
+                //U+FFFD, trail byte of ASCII range is decoded again on its own
+                if (utf8Size < 3 || memcmp(utf8, "\xEF\xBF\xBD", 3) != 0 ||
+                    (trail < 0x80 && (utf8Size != 4 || utf8[3] != trail))) {
+                    failed++;
+                    TextCodecSuite_PrintFailure(&printed, "unmapped GBK %02X%02X not replaced", lead, trail);
+                }
+                continue;
+            }
+
+            UTF8ToGBK(utf8, utf8Size, back, &backSize);
+            if (!TextCodecSuite_IsValidUtf8(utf8, utf8Size) || backSize != 2 || memcmp(back, gbk, 2) != 0) {
+                failed++;
+                TextCodecSuite_PrintFailure(&printed, "GBK %02X%02X round trip gives %u byte(s) %02X%02X", lead,
+                                            trail, backSize, back[0], back[1]);
+            }
+        }
+    }
+
+    if (mapped != TEXTCODEC_TABLE_UNICODE_TO_GBK_CODE_NUM) {
+        failed++;
+        TextCodecSuite_PrintFailure(&printed, "GBK to Unicode table has %u codes, Unicode to GBK table %u", mapped,
+                                    TEXTCODEC_TABLE_UNICODE_TO_GBK_CODE_NUM);
+    }
+
+    snprintf(detail, sizeof(detail), "%u mapped", mapped);
+    TextCodecSuite_Report("textcodec_gbk_round_trip", total, failed, detail);
+}
+
+//iconv path round trip over GB2312 codes, and codes where iconv and textcodec.c disagree, which come from
+//different GBK tables, not counted as failure
+static void TextCodecSuite_CheckGb2312RoundTrip(void)
+{
+    uint8_t gb2312[2];
+    uint8_t utf8[8];
+    uint8_t tableUtf8[8];
+    uint8_t back[8];
+    uint32_t tableUtf8Size;
+    uint32_t lead;
+    uint32_t trail;
+    uint32_t total = 0;
+    uint32_t failed = 0;
+    uint32_t differ = 0;
+    uint32_t printed = 0;
+    int utf8Len;
+    int backLen;
+    char detail[64];
+
+    for (lead = TEXTCODEC_SUITE_GB2312_BYTE_MIN; lead <= TEXTCODEC_SUITE_GB2312_BYTE_MAX; lead++) {
+        for (trail = TEXTCODEC_SUITE_GB2312_BYTE_MIN; trail <= TEXTCODEC_SUITE_GB2312_BYTE_MAX; trail++) {
+            gb2312[0] = (uint8_t) lead;
+            gb2312[1] = (uint8_t) trail;
+            utf8Len = Gb2312ToUtf8((char *) utf8, sizeof(utf8), (const char *) gb2312, sizeof(gb2312));
+            if (utf8Len < 0) {
+                continue;
+            }
+            total++;
+
+            backLen = Utf8ToGb2312((char *) back, sizeof(back), (const char *) utf8, utf8Len);
+            if (backLen != 2 || memcmp(back, gb2312, 2) != 0) {
+                failed++;
+                TextCodecSuite_PrintFailure(&printed, "GB2312 %02X%02X iconv round trip failed", lead, trail);
+            }
+
+            GBKToUTF8(gb2312, sizeof(gb2312), tableUtf8, &tableUtf8Size);
+            if (tableUtf8Size != (uint32_t) utf8Len || memcmp(tableUtf8, utf8, utf8Len) != 0) {
+                differ++;
+            }
+        }
+    }
+
+    if (total == 0) {
+        failed++;
+        TextCodecSuite_PrintFailure(&printed, "iconv has no gb2312 converter");
+    }
+
+    snprintf(detail, sizeof(detail), "%u differ from textcodec table", differ);
+    TextCodecSuite_Report("iconv_gb2312_round_trip", total, failed, detail);
+}
+
+//BMP code points without GBK code must become '?', never a GBK code of some other character
+static void TextCodecSuite_CheckUnmappedUnicode(void)
+{
+    uint8_t unicode[2];
+    uint8_t gbk[4];
+    uint32_t gbkSize = 0;
+    uint32_t code;
+    uint32_t total = 0;
+    uint32_t failed = 0;
+    uint32_t printed = 0;
+
+    for (code = 0x80; code <= 0xFFFF; code++) {
+        if (g_textCodecUnicodeToGbkPage[g_textCodecUnicodeToGbkIndex[code >> 8]][code & 0xFF] != 0) {
+            continue;
+        }
+        total++;
+        unicode[0] = code & 0xFF;
+        unicode[1] = code >> 8;
+        UnicodeToGBK(unicode, sizeof(unicode), gbk, &gbkSize);
+        if (gbkSize != 1 || gbk[0] != '?') {
+            failed++;
+            TextCodecSuite_PrintFailure(&printed, "unmapped U+%04X gives %u byte(s)", code, gbkSize);
+        }
+    }
+
+    TextCodecSuite_Report("textcodec_unmapped_unicode", total, failed, "");
+}
+
+//hand written malformed input with known replacement, for textcodec.c
+static void TextCodecSuite_CheckCases(void)
+{
+    static const T_TextCodecSuiteCase utf8Case[] = {
+        {"truncated 3 byte",     "A\xE4\xB8",         3, "A??",     3},
+        {"overlong 2 byte",      "\xC0\x80" "B",      3, "??B",     3},
+        {"overlong 3 byte",      "\xE0\x80\x80",      3, "???",     3},
+        {"surrogate",            "\xED\xA0\x80",      3, "???",     3},
+        {"beyond U+10FFFF",      "\xF4\x90\x80\x80",  4, "????",    4},
+        {"lone continuation",    "\x80\xBF" "C",      3, "??C",     3},
+        {"4 byte emoji",         "\xF0\x9F\x98\x80",  4, "?",       1},
+        {"valid after invalid",  "\xFF\xE4\xB8\xAD",  4, "?\xD6\xD0", 3},
+    };
+    static const T_TextCodecSuiteCase gbkCase[] = {
+        {"truncated lead",       "A\x81",             2, "A\xEF\xBF\xBD",             4},
+        {"lead before digit",    "\x81" "0",          2, "\xEF\xBF\xBD" "0",          4},
+        {"single 0x80",          "\x80",              1, "\xEF\xBF\xBD",              3},
+        {"single 0xFF",          "\xFF",              1, "\xEF\xBF\xBD",              3},
+        {"trail 0x7F",           "\xB0\x7F",          2, "\xEF\xBF\xBD\x7F",          4},
+        {"valid after invalid",  "\xFF\xD6\xD0",      3, "\xEF\xBF\xBD\xE4\xB8\xAD",  6},
+    };
+    uint8_t out[64];
+    uint32_t outSize;
+    uint32_t total = 0;
+    uint32_t failed = 0;
+    uint32_t printed = 0;
+    uint32_t i;
+
+    for (i = 0; i < sizeof(utf8Case) / sizeof(utf8Case[0]); i++, total++) {
+        UTF8ToGBK((const uint8_t *) utf8Case[i].input, utf8Case[i].inputLen, out, &outSize);
+        if (outSize != utf8Case[i].expectLen || memcmp(out, utf8Case[i].expect, outSize) != 0) {
+            failed++;
+            TextCodecSuite_PrintFailure(&printed, "UTF8ToGBK %s gives %u byte(s)", utf8Case[i].name, outSize);
+        }
+    }
+    for (i = 0; i < sizeof(gbkCase) / sizeof(gbkCase[0]); i++, total++) {
+        GBKToUTF8((const uint8_t *) gbkCase[i].input, gbkCase[i].inputLen, out, &outSize);
+        if (outSize != gbkCase[i].expectLen || memcmp(out, gbkCase[i].expect, outSize) != 0) {
+            failed++;
+            TextCodecSuite_PrintFailure(&printed, "GBKToUTF8 %s gives %u byte(s)", gbkCase[i].name, outSize);
+        }
+    }
+
+    TextCodecSuite_Report("textcodec_malformed_cases", total, failed, "");
+}
+
+//random bytes, biased to lead and continuation bytes, through every path: output stays in its buffer and is
+//valid in the target encoding, stream agrees with one call conversion
+static void TextCodecSuite_CheckFuzz(const T_TextCodecSuitePath *path, uint32_t pathNum)
+{
+    static const uint8_t byteClass[] = {'A', 0x80, 0xBF, 0xC2, 0xE4, 0xED, 0xF0, 0xF4, 0x81, 0xD6, 0xFE, 0xFF};
+    uint8_t input[TEXTCODEC_SUITE_FUZZ_LEN_MAX];
+    uint8_t *output;
+    uint8_t *oneShot;
+    uint32_t outputCapacity = TEXTCODEC_SUITE_FUZZ_LEN_MAX * 3;
+    uint32_t failed[8] = {0};
+    uint32_t printed = 0;
+    uint32_t round;
+    uint32_t len;
+    uint32_t i;
+    uint32_t random;
+    int ret;
+    int oneShotRet;
+    int isGuardBroken;
+    int isValid;
+    char check[64];
+
+    output = malloc(outputCapacity + TEXTCODEC_SUITE_GUARD_SIZE);
+    oneShot = malloc(outputCapacity + TEXTCODEC_SUITE_GUARD_SIZE);
+    if (output == NULL || oneShot == NULL || pathNum > sizeof(failed) / sizeof(failed[0])) {
+        free(output);
+        free(oneShot);
+        TextCodecSuite_Report("fuzz", 0, 1, "out of memory");
+        return;
+    }
+
+    for (round = 0; round < TEXTCODEC_SUITE_FUZZ_ROUND; round++) {
+        len = TextCodecSuite_Random() % (TEXTCODEC_SUITE_FUZZ_LEN_MAX + 1);
+        for (i = 0; i < len; i++) {
+            random = TextCodecSuite_Random();
+            input[i] = random % 2 ? (uint8_t) (random >> 8) :
+                       byteClass[(random >> 8) % sizeof(byteClass)];
+        }
+
+        oneShotRet = -1;
+        for (i = 0; i < pathNum; i++) {
+            ret = TextCodecSuite_Run(path[i].func, input, len, output, len * path[i].expansion, &isGuardBroken);
+            if (ret < 0) {
+                if (path[i].func == TextCodecSuite_IconvStreamUtf8ToGb2312 && oneShotRet >= 0) {
+                    failed[i]++;
+                    TextCodecSuite_PrintFailure(&printed, "%s rejects input that one call accepts", path[i].name);
+                }
+                continue;
+            }
+
+            isValid = path[i].input == TEXTCODEC_SUITE_INPUT_UTF8 ? TextCodecSuite_IsValidGbk(output, ret) :
+                      TextCodecSuite_IsValidUtf8(output, ret);
+            if (isGuardBroken || (uint32_t) ret > len * path[i].expansion || !isValid) {
+                failed[i]++;
+                TextCodecSuite_PrintFailure(&printed, "%s round %u: %s", path[i].name, round,
+                                            isGuardBroken ? "wrote past output" : "invalid output");
+            }
+
+            if (path[i].func == TextCodecSuite_IconvUtf8ToGb2312) {
+                oneShotRet = ret;
+                memcpy(oneShot, output, ret);
+            } else if (path[i].func == TextCodecSuite_IconvStreamUtf8ToGb2312 &&
+                       (ret != oneShotRet || memcmp(output, oneShot, ret) != 0)) {
+                failed[i]++;
+                TextCodecSuite_PrintFailure(&printed, "%s round %u differs from one call", path[i].name, round);
+            }
+        }
+    }
+
+    for (i = 0; i < pathNum; i++) {
+        snprintf(check, sizeof(check), "fuzz_%s", path[i].name);
+        TextCodecSuite_Report(check, TEXTCODEC_SUITE_FUZZ_ROUND, failed[i], "");
+    }
+
+    free(oneShot);
+    free(output);
+}
+
+//file name field is 32 bytes without terminator when full, a long name may be cut in a character
+static void TextCodecSuite_CheckSpeakerFileName(void)
+{
+    //12 Chinese characters are 36 bytes, field keeps 10 and 2 bytes of the 11th, which become 2 '?'
+    static const char longName[] = "中文语音播报测试文件名称";
+    static const char shortName[] = "告警.opus";
+    uint8_t output[64 + TEXTCODEC_SUITE_GUARD_SIZE];
+    uint32_t failed = 0;
+    uint32_t printed = 0;
+    int isGuardBroken;
+    int ret;
+
+    ret = TextCodecSuite_Run(TextCodecSuite_SpeakerFileName, (const uint8_t *) longName, strlen(longName), output,
+                             64, &isGuardBroken);
+    if (isGuardBroken || ret != 22 || output[20] != '?' || output[21] != '?' || !TextCodecSuite_IsValidGbk(output, ret)) {
+        failed++;
+        TextCodecSuite_PrintFailure(&printed, "cut file name gives %d byte(s)", ret);
+    }
+
+    ret = TextCodecSuite_Run(TextCodecSuite_SpeakerFileName, (const uint8_t *) shortName, strlen(shortName), output,
+                             64, &isGuardBroken);
+    if (isGuardBroken || ret != 9 || memcmp(output, "\xB8\xE6\xBE\xAF.opus", 9) != 0) {
+        failed++;
+        TextCodecSuite_PrintFailure(&printed, "short file name gives %d byte(s)", ret);
+    }
+
+    TextCodecSuite_Report("speaker_file_name", 2, failed, "");
+}
+
+static uint32_t TextCodecSuite_Random(void)
+{
+    s_seed = s_seed * 1103515245 + 12345;
+
+    return s_seed >> 8;
+}
+
+//level 1 characters with about one in ten being ASCII space or digit, like plain Chinese text
+static uint8_t *TextCodecSuite_MakeGbkCorpus(uint32_t charNum, uint32_t *size)
+{
+    uint32_t trailNum = TEXTCODEC_SUITE_GB2312_BYTE_MAX - TEXTCODEC_SUITE_GB2312_BYTE_MIN + 1;
+    uint32_t leadNum = TEXTCODEC_SUITE_LEVEL1_LEAD_MAX - TEXTCODEC_SUITE_LEVEL1_LEAD_MIN + 1;
+    uint32_t random;
+    uint32_t i;
+    uint8_t lead;
+    uint8_t trail;
+    uint8_t *corpus;
+    uint8_t *p;
+
+    corpus = malloc(charNum * 2);
+    if (corpus == NULL) {
+        return NULL;
+    }
+
+    p = corpus;
+    for (i = 0; i < charNum; i++) {
+        random = TextCodecSuite_Random();
+        if (random % 10 == 0) {
+            *p++ = (uint8_t) (random % 3 == 0 ? ' ' : '0' + random % 10);
+            continue;
+        }
+        lead = (uint8_t) (TEXTCODEC_SUITE_LEVEL1_LEAD_MIN + random / trailNum % leadNum);
+        trail = (uint8_t) (TEXTCODEC_SUITE_GB2312_BYTE_MIN + random % trailNum);
+        if (lead == TEXTCODEC_SUITE_LEVEL1_LEAD_MAX && trail > 0xF9) {
+            trail = 0xF9;
+        }
+        *p++ = lead;
+        *p++ = trail;
+    }
+    *size = (uint32_t) (p - corpus);
+
+    return corpus;
+}
+
+//throughput over repeated calls, latency percentiles from single timed calls, which include clock read overhead
+static void TextCodecSuite_Bench(const T_TextCodecSuitePath *path, uint32_t pathNum)
+{
+    static const uint32_t bucketCharNum[] = {4, 16, 128, 2048, TEXTCODEC_SUITE_CORPUS_CHAR_NUM};
+    uint64_t *sample;
+    uint8_t *gbk;
+    uint8_t *utf8;
+    uint8_t *output;
+    const uint8_t *input;
+    uint32_t gbkSize = 0;
+    uint32_t inputSize;
+    uint32_t outputCapacity;
+    uint32_t gbkOffset;
+    uint32_t charCount;
+    uint32_t bucket;
+    uint32_t round;
+    uint32_t i;
+    uint64_t startNs;
+    uint64_t durationNs;
+    uint64_t latencyStartNs;
+    double megaBytesPerSecond;
+    double meanNs;
+
+    gbk = TextCodecSuite_MakeGbkCorpus(TEXTCODEC_SUITE_CORPUS_CHAR_NUM, &gbkSize);
+    if (gbk == NULL) {
+        TextCodecSuite_Report("bench", 0, 1, "out of memory");
+        return;
+    }
+    utf8 = malloc(gbkSize * 3);
+    output = malloc(gbkSize * 3);
+    sample = malloc(TEXTCODEC_SUITE_LATENCY_SAMPLE_NUM * sizeof(uint64_t));
+    if (gbk == NULL || utf8 == NULL || output == NULL || sample == NULL) {
+        free(gbk);
+        free(utf8);
+        free(output);
+        free(sample);
+        TextCodecSuite_Report("bench", 0, 1, "out of memory");
+        return;
+    }
+    s_streamChunkSize = TEXTCODEC_SUITE_STREAM_BENCH_CHUNK;
+
+    if (!s_isJson) {
+        printf("%-28s %6s %8s %9s %10s %8s %8s\r\n", "path", "chars", "bytes", "MB/s", "mean ns", "p50 ns",
+               "p99 ns");
+    }
+
+    for (i = 0; i < pathNum; i++) {
+        for (bucket = 0; bucket < sizeof(bucketCharNum) / sizeof(bucketCharNum[0]); bucket++) {
+            //a GBK prefix of the corpus with this many characters, and the same text in UTF-8
+            gbkOffset = 0;
+            for (charCount = 0; charCount < bucketCharNum[bucket] && gbkOffset < gbkSize; charCount++) {
+                gbkOffset += gbk[gbkOffset] < 0x80 ? 1 : 2;
+            }
+            if (path[i].input == TEXTCODEC_SUITE_INPUT_GBK) {
+                input = gbk;
+                inputSize = gbkOffset;
+            } else {
+                GBKToUTF8(gbk, gbkOffset, utf8, &inputSize);
+                input = utf8;
+            }
+            outputCapacity = inputSize * path[i].expansion;
+
+            startNs = TextCodecSuite_GetMonotonicNs();
+            round = 0;
+            do {
+                path[i].func(input, inputSize, output, outputCapacity);
+                round++;
+                durationNs = TextCodecSuite_GetMonotonicNs() - startNs;
+            } while (durationNs < TEXTCODEC_SUITE_MIN_DURATION_NS);
+            megaBytesPerSecond = (double) inputSize * round * 1e3 / (double) durationNs;
+            meanNs = (double) durationNs / round;
+
+            //sample count is bounded by time too, long strings take milliseconds per call
+            latencyStartNs = TextCodecSuite_GetMonotonicNs();
+            for (round = 0; round < TEXTCODEC_SUITE_LATENCY_SAMPLE_NUM; round++) {
+                startNs = TextCodecSuite_GetMonotonicNs();
+                path[i].func(input, inputSize, output, outputCapacity);
+                sample[round] = TextCodecSuite_GetMonotonicNs() - startNs;
+                if (round >= 100 && startNs - latencyStartNs > TEXTCODEC_SUITE_MIN_DURATION_NS) {
+                    round++;
+                    break;
+                }
+            }
+            qsort(sample, round, sizeof(uint64_t), TextCodecSuite_CompareU64);
+
+            if (s_isJson) {
+                printf("{\"type\":\"bench\",\"path\":\"%s\",\"chars\":%u,\"bytes\":%u,\"mb_per_s\":%.2f,"
+                       "\"mean_ns\":%.1f,\"p50_ns\":%llu,\"p99_ns\":%llu}\n", path[i].name, charCount, inputSize,
+                       megaBytesPerSecond, meanNs, (unsigned long long) sample[round / 2],
+                       (unsigned long long) sample[round * 99 / 100]);
+            } else {
+                printf("%-28s %6u %8u %9.1f %10.1f %8llu %8llu\r\n", path[i].name, charCount, inputSize,
+                       megaBytesPerSecond, meanNs, (unsigned long long) sample[round / 2],
+                       (unsigned long long) sample[round * 99 / 100]);
+            }
+        }
+    }
+
+    free(sample);
+    free(output);
+    free(utf8);
+    free(gbk);
+}
+
+static uint64_t TextCodecSuite_GetMonotonicNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static int TextCodecSuite_CompareU64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *) a;
+    uint64_t y = *(const uint64_t *) b;
+
+    return x < y ? -1 : x > y;
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
@@ -0,0 +1,320 @@
+/**
+ ********************************************************************
+ * @file    throttle_ramp_check.c
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   Host check of the throttle ramp profiles, every profile is run over rising, falling and retargeted
+ *          segments, end value, monotonicity and step size of every update are checked.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "throttle_ramp.h"
+
+/* Private constants ---------------------------------------------------------*/
+//no ramp of the checked configurations takes this many updates, a ramp that does is reported as not settled
+#define THROTTLE_RAMP_CHECK_UPDATE_NUM_MAX      100000
+#define THROTTLE_RAMP_CHECK_HOLD_UPDATE_NUM     5
+
+/* Private types -------------------------------------------------------------*/
+typedef struct {
+    const char *name;
+    T_ThrottleRampConfig config;
+} T_ThrottleRampCheckConfig;
+
+typedef struct {
+    uint16_t start;
+    uint16_t target;
+    uint16_t retargetUpdateIndex; /*!< Update after which target is changed again, 0 for none. */
+    uint16_t retarget;
+} T_ThrottleRampCheckSegment;
+
+/* Private values -------------------------------------------------------------*/
+static const T_ThrottleRampCheckConfig s_checkConfig[] = {
+    //configurations of motor PWM and ESC output of application.c
+    {"motor pwm s-curve", {THROTTLE_RAMP_PROFILE_S_CURVE, 20, 10, 2}},
+    {"esc output s-curve", {THROTTLE_RAMP_PROFILE_S_CURVE, 10, 100, 4}},
+    {"none", {THROTTLE_RAMP_PROFILE_NONE, 0, 1, 0}},
+    {"none slew limited", {THROTTLE_RAMP_PROFILE_NONE, 20, 1, 0}},
+    {"linear", {THROTTLE_RAMP_PROFILE_LINEAR, 0, 50, 0}},
+    {"linear slew limited", {THROTTLE_RAMP_PROFILE_LINEAR, 20, 10, 0}},
+    {"s-curve", {THROTTLE_RAMP_PROFILE_S_CURVE, 0, 50, 0}},
+    {"exponential", {THROTTLE_RAMP_PROFILE_EXPONENTIAL, 0, 1, 3}},
+    {"exponential slew limited", {THROTTLE_RAMP_PROFILE_EXPONENTIAL, 20, 1, 2}},
+};
+
+static const T_ThrottleRampCheckSegment s_checkSegment[] = {
+    {0, 2000, 0, 0},
+    {2000, 0, 0, 0},
+    {150, 100, 0, 0},
+    {1000, 1001, 0, 0},
+    {1001, 1000, 0, 0},
+    {500, 500, 0, 0},
+    {0, UINT16_MAX, 0, 0},
+    {UINT16_MAX, 0, 0, 0},
+    //retarget in the middle of a ramp, further in the same direction and back
+    {0, 2000, 5, 3000},
+    {0, 2000, 5, 500},
+    {2000, 0, 10, 1500},
+    {2000, 0, 3, 2000},
+};
+
+/* Private functions declaration ---------------------------------------------*/
+static int ThrottleRampCheck_RunSegment(const T_ThrottleRampCheckConfig *checkConfig,
+                                        const T_ThrottleRampCheckSegment *segment, uint32_t *updateNum,
+                                        uint32_t *maxStep);
+static int ThrottleRampCheck_RunJump(const T_ThrottleRampCheckConfig *checkConfig);
+static uint32_t ThrottleRampCheck_GetStepNum(const T_ThrottleRampConfig *config, uint32_t distance);
+static uint32_t ThrottleRampCheck_GetDistance(uint16_t from, uint16_t to);
+
+/* Exported functions definition ---------------------------------------------*/
+int main(void)
+{
+    const T_ThrottleRampCheckConfig *checkConfig;
+    uint32_t updateNum;
+    uint32_t fullRangeUpdateNum;
+    uint32_t maxStep;
+    uint32_t fullRangeMaxStep;
+    int isConfigFail;
+    int isFail = 0;
+    uint32_t i;
+    uint32_t j;
+
+    for (i = 0; i < sizeof(s_checkConfig) / sizeof(s_checkConfig[0]); i++) {
+        checkConfig = &s_checkConfig[i];
+        isConfigFail = 0;
+        fullRangeMaxStep = 0;
+        fullRangeUpdateNum = 0;
+
+        for (j = 0; j < sizeof(s_checkSegment) / sizeof(s_checkSegment[0]); j++) {
+            if (ThrottleRampCheck_RunSegment(checkConfig, &s_checkSegment[j], &updateNum, &maxStep) != 0) {
+                printf("  segment %u -> %u: FAIL\r\n", s_checkSegment[j].start, s_checkSegment[j].target);
+                isConfigFail = 1;
+            }
+            //first segment is the full range rise, which is what update count and step are reported for
+            if (j == 0) {
+                fullRangeUpdateNum = updateNum;
+                fullRangeMaxStep = maxStep;
+            }
+        }
+        if (ThrottleRampCheck_RunJump(checkConfig) != 0) {
+            printf("  jump: FAIL\r\n");
+            isConfigFail = 1;
+        }
+
+        printf("%-26s %s, 0 -> 2000 in %5u updates, max step %5u\r\n", checkConfig->name,
+               isConfigFail ? "FAIL" : "ok  ", fullRangeUpdateNum, fullRangeMaxStep);
+        isFail |= isConfigFail;
+    }
+
+    printf("%s\r\n", isFail ? "CHECK FAIL" : "CHECK PASS");
+
+    return isFail;
+}
+
+/* Private functions definition-----------------------------------------------*/
+/**
+ * @brief Run a ramp over a segment and check every update.
+ * @param checkConfig: configuration of ramp.
+ * @param segment: start, target and optional change of target.
+ * @param updateNum: count of updates until output stays at final target.
+ * @param maxStep: largest change of output in one update.
+ * @return 0 if every check passes, otherwise 1.
+ */
+static int ThrottleRampCheck_RunSegment(const T_ThrottleRampCheckConfig *checkConfig,
+                                        const T_ThrottleRampCheckSegment *segment, uint32_t *updateNum,
+                                        uint32_t *maxStep)
+{
+    const T_ThrottleRampConfig *config = &checkConfig->config;
+    T_ThrottleRamp ramp;
+    uint16_t target = segment->target;
+    uint16_t segmentStart = segment->start;
+    uint32_t segmentUpdateNum = 0;
+    uint32_t segmentDistance;
+    uint32_t expectStep;
+    uint32_t remain;
+    uint32_t step;
+    uint16_t previous;
+    uint16_t current;
+    int direction;
+    int isFail = 0;
+    uint32_t i;
+
+    ThrottleRamp_Init(&ramp, config, segment->start);
+    ThrottleRamp_SetTarget(&ramp, target);
+    *maxStep = 0;
+    current = segment->start;
+
+    for (i = 1; i <= THROTTLE_RAMP_CHECK_UPDATE_NUM_MAX; i++) {
+        if (segment->retargetUpdateIndex != 0 && i == segment->retargetUpdateIndex + 1u) {
+            target = segment->retarget;
+            segmentStart = current;
+            segmentUpdateNum = 0;
+            ThrottleRamp_SetTarget(&ramp, target);
+        }
+
+        previous = current;
+        current = ThrottleRamp_Update(&ramp);
+        segmentUpdateNum++;
+        step = ThrottleRampCheck_GetDistance(previous, current);
+        remain = ThrottleRampCheck_GetDistance(previous, target);
+        direction = target > segmentStart ? 1 : -1;
+        if (step > *maxStep) {
+            *maxStep = step;
+        }
+
+        //never move away from target and never pass it
+        if ((direction > 0 && (current < previous || current > target)) ||
+            (direction < 0 && (current > previous || current < target))) {
+            printf("  %s: update %u moves from %u to %u, target %u\r\n", checkConfig->name, i, previous, current,
+                   target);
+            isFail = 1;
+        }
+
+        if (config->maxStepPerUpdate != 0 && step > config->maxStepPerUpdate) {
+            printf("  %s: update %u steps %u, limit %u\r\n", checkConfig->name, i, step, config->maxStepPerUpdate);
+            isFail = 1;
+        }
+
+        //exponential profile covers 1/2^shift of remaining distance, at least one count
+        if (config->profile == THROTTLE_RAMP_PROFILE_EXPONENTIAL && remain != 0) {
+            expectStep = (remain >> config->exponentialShift) > 0 ? remain >> config->exponentialShift : 1;
+            if (config->maxStepPerUpdate != 0 && expectStep > config->maxStepPerUpdate) {
+                expectStep = config->maxStepPerUpdate;
+            }
+            if (step != expectStep) {
+                printf("  %s: update %u steps %u of remaining %u, expect %u\r\n", checkConfig->name, i, step,
+                       remain, expectStep);
+                isFail = 1;
+            }
+        }
+
+        //S-curve starts slower than linear ramp of the same length
+        segmentDistance = ThrottleRampCheck_GetDistance(segmentStart, target);
+        if (config->profile == THROTTLE_RAMP_PROFILE_S_CURVE && segmentUpdateNum == 1 &&
+            step * ThrottleRampCheck_GetStepNum(config, segmentDistance) > segmentDistance) {
+            printf("  %s: first step %u is not below linear step of %u counts\r\n", checkConfig->name, step,
+                   segmentDistance);
+            isFail = 1;
+        }
+
+        if (current == target && (segment->retargetUpdateIndex == 0 || i > segment->retargetUpdateIndex)) {
+            break;
+        }
+    }
+
+    *updateNum = i;
+    if (current != target) {
+        printf("  %s: output %u after %u updates, target %u\r\n", checkConfig->name, current, i, target);
+        return 1;
+    }
+
+    //linear and S-curve ramps take the planned count of updates, stretched by slew limit
+    segmentDistance = ThrottleRampCheck_GetDistance(segmentStart, target);
+    if ((config->profile == THROTTLE_RAMP_PROFILE_LINEAR || config->profile == THROTTLE_RAMP_PROFILE_S_CURVE) &&
+        segmentDistance != 0 && segmentUpdateNum != ThrottleRampCheck_GetStepNum(config, segmentDistance)) {
+        printf("  %s: ramp of %u counts takes %u updates, expect %u\r\n", checkConfig->name, segmentDistance,
+               segmentUpdateNum, ThrottleRampCheck_GetStepNum(config, segmentDistance));
+        isFail = 1;
+    }
+
+    //output stays at target once reached
+    for (i = 0; i < THROTTLE_RAMP_CHECK_HOLD_UPDATE_NUM; i++) {
+        if (ThrottleRamp_Update(&ramp) != target || !ThrottleRamp_IsSettled(&ramp)) {
+            printf("  %s: output leaves target %u\r\n", checkConfig->name, target);
+            isFail = 1;
+            break;
+        }
+    }
+
+    return isFail;
+}
+
+/**
+ * @brief Jump in the middle of a ramp, as failsafe does, then ramp again from where output jumped to.
+ * @param checkConfig: configuration of ramp.
+ * @return 0 if every check passes, otherwise 1.
+ */
+static int ThrottleRampCheck_RunJump(const T_ThrottleRampCheckConfig *checkConfig)
+{
+    const T_ThrottleRampConfig *config = &checkConfig->config;
+    T_ThrottleRamp ramp;
+    uint16_t current;
+    uint32_t i;
+
+    ThrottleRamp_Init(&ramp, config, 0);
+    ThrottleRamp_SetTarget(&ramp, 2000);
+    for (i = 0; i < 3; i++) {
+        ThrottleRamp_Update(&ramp);
+    }
+
+    //output is at jump value on next update whatever the slew limit, and stays there
+    ThrottleRamp_Jump(&ramp, 100);
+    for (i = 0; i < THROTTLE_RAMP_CHECK_HOLD_UPDATE_NUM; i++) {
+        current = ThrottleRamp_Update(&ramp);
+        if (current != 100 || !ThrottleRamp_IsSettled(&ramp)) {
+            printf("  %s: output %u after jump to 100\r\n", checkConfig->name, current);
+            return 1;
+        }
+    }
+
+    //next ramp starts from jump value and keeps slew limit
+    ThrottleRamp_SetTarget(&ramp, 1100);
+    current = ThrottleRamp_Update(&ramp);
+    if (current < 100 || current > 1100 ||
+        (config->maxStepPerUpdate != 0 && current - 100u > config->maxStepPerUpdate)) {
+        printf("  %s: first update after jump outputs %u, ramp from 100 to 1100\r\n", checkConfig->name, current);
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Get count of updates a linear or S-curve ramp is planned to take.
+ * @param config: configuration of ramp.
+ * @param distance: distance of ramp.
+ * @return Count of updates.
+ */
+static uint32_t ThrottleRampCheck_GetStepNum(const T_ThrottleRampConfig *config, uint32_t distance)
+{
+    uint32_t stepNum = 0;
+    uint32_t rampUpdateNum = config->rampUpdateNum != 0 ? config->rampUpdateNum : 1;
+
+    //steepest step of smoothstep is 1.5 times of linear step
+    if (config->maxStepPerUpdate != 0) {
+        stepNum = config->profile == THROTTLE_RAMP_PROFILE_S_CURVE ?
+                  (3 * distance + 2 * config->maxStepPerUpdate - 1) / (2 * config->maxStepPerUpdate) :
+                  (distance + config->maxStepPerUpdate - 1) / config->maxStepPerUpdate;
+    }
+
+    return stepNum > rampUpdateNum ? stepNum : rampUpdateNum;
+}
+
+static uint32_t ThrottleRampCheck_GetDistance(uint16_t from, uint16_t to)
+{
+    return from > to ? (uint32_t) (from - to) : (uint32_t) (to - from);
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
@@ -0,0 +1,83 @@
+/**
+ ********************************************************************
+ * @file    tim_compare_sim.c
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   Timer registers and compare writes of host simulator build. Needs no FreeRTOS, so host
+ *          benches share it with the simulator to drive plant model through the same compare hook.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+
+/* Private constants ---------------------------------------------------------*/
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private values -------------------------------------------------------------*/
+TIM_TypeDef g_simTim13;
+TIM_TypeDef g_simTim14;
+
+static volatile TimSimCompareWriteCallback s_compareWriteCallback = NULL;
+
+/* Private functions declaration ---------------------------------------------*/
+
+/* Exported functions definition ---------------------------------------------*/
+/**
+ * @brief Write compare register of a channel, then report the write to the registered callback.
+ * @param instance: timer registers.
+ * @param channel: TIM_CHANNEL_1 to TIM_CHANNEL_4.
+ * @param compare: compare value.
+ * @return None.
+ */
+void TimSim_SetCompare(TIM_TypeDef *instance, uint32_t channel, uint32_t compare)
+{
+    TimSimCompareWriteCallback callback = s_compareWriteCallback;
+
+    if (channel == TIM_CHANNEL_1) {
+        instance->CCR1 = compare;
+    } else if (channel == TIM_CHANNEL_2) {
+        instance->CCR2 = compare;
+    } else if (channel == TIM_CHANNEL_3) {
+        instance->CCR3 = compare;
+    } else {
+        instance->CCR4 = compare;
+    }
+
+    if (callback != NULL) {
+        callback(instance, channel, compare);
+    }
+}
+
+/**
+ * @brief Register callback invoked after each compare write, e.g. by plant model of simulator.
+ * @note Callback runs in the task that writes compare value, it must not block.
+ * @param callback: callback function, NULL to unregister.
+ * @return None.
+ */
+void TimSim_RegCompareWriteCallback(TimSimCompareWriteCallback callback)
+{
+    s_compareWriteCallback = callback;
+}
+
+/* Private functions definition-----------------------------------------------*/
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
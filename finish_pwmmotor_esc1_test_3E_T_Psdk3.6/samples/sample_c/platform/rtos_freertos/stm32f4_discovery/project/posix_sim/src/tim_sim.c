@@ -0,0 +1,73 @@
+/**
+ ********************************************************************
+ * @file    tim_sim.c
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   Timer PWM driver of host simulator build, replaces ledpwm.c. Timer registers are plain
+ *          memory, so compare values written by application can be inspected by debugger or other tasks,
+ *          compare writes are in tim_compare_sim.c.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "ledpwm.h"
+#include <stdio.h>
+
+/* Private constants ---------------------------------------------------------*/
+#define TIM_SIM_CLOCK_HZ        84000000
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private values -------------------------------------------------------------*/
+TIM_HandleTypeDef g_timx_pwm_chy_handle;
+TIM_HandleTypeDef g_timx_motor_chy_handle;
+
+/* Private functions declaration ---------------------------------------------*/
+static void TimSim_PwmInit(TIM_HandleTypeDef *htim, TIM_TypeDef *instance, uint16_t arr, uint16_t psc);
+
+/* Exported functions definition ---------------------------------------------*/
+void gtim_timx_pwm_chy_init(uint16_t arr, uint16_t psc)
+{
+    TimSim_PwmInit(&g_timx_pwm_chy_handle, GTIM_TIMX_PWM, arr, psc);
+}
+
+void gtim_timx_motor_chy_init(uint16_t arr, uint16_t psc)
+{
+    TimSim_PwmInit(&g_timx_motor_chy_handle, GTIM_TIMX_MOTORPWM, arr, psc);
+}
+
+/* Private functions definition-----------------------------------------------*/
+static void TimSim_PwmInit(TIM_HandleTypeDef *htim, TIM_TypeDef *instance, uint16_t arr, uint16_t psc)
+{
+    htim->Instance = instance;
+    htim->Init.Prescaler = psc;
+    htim->Init.Period = arr;
+
+    instance->PSC = psc;
+    instance->ARR = arr;
+    instance->CNT = 0;
+    instance->CCR1 = 0;
+
+    //may run before logger of psdk is registered, so use printf directly
+    printf("sim timer pwm init, period %d us.\r\n",
+           (int) ((uint64_t) (arr + 1) * (psc + 1) * 1000000 / TIM_SIM_CLOCK_HZ));
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
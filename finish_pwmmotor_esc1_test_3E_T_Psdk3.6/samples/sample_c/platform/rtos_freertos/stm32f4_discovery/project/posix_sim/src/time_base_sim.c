@@ -0,0 +1,62 @@
+/**
+ ********************************************************************
+ * @file    time_base_sim.c
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   Time base of host simulator build, replaces time_base.c with monotonic clock of host.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <time.h>
+#include "time_base.h"
+
+/* Private constants ---------------------------------------------------------*/
+
+/* Private types -------------------------------------------------------------*/
+
+/* Private values -------------------------------------------------------------*/
+static uint64_t s_timeBaseOriginUs = 0;
+
+/* Private functions declaration ---------------------------------------------*/
+static uint64_t TimeBase_GetMonotonicUs(void);
+
+/* Exported functions definition ---------------------------------------------*/
+void TimeBase_Init(void)
+{
+    s_timeBaseOriginUs = TimeBase_GetMonotonicUs();
+}
+
+uint64_t TimeBase_GetUs(void)
+{
+    return TimeBase_GetMonotonicUs() - s_timeBaseOriginUs;
+}
+
+/* Private functions definition-----------------------------------------------*/
+static uint64_t TimeBase_GetMonotonicUs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
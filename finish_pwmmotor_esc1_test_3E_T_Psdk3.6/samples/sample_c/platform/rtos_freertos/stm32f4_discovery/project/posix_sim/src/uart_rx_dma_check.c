@@ -0,0 +1,350 @@
+/**
+ ********************************************************************
+ * @file    uart_rx_dma_check.c
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   Host loopback check of UART circular DMA reception, a model of the DMA stream and its half/full
+ *          transfer and IDLE-line interrupts feeds the read ring buffer, the reader checks every byte received.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "uart_rx_dma.h"
+
+/* Private constants ---------------------------------------------------------*/
+//same size as read buffer of UART3, the aircraft link
+#define UART_RX_DMA_CHECK_BUF_SIZE          8192
+#define UART_RX_DMA_CHECK_READ_LEN          256
+//bytes per interrupt of receive interrupt mode
+#define UART_RX_DMA_CHECK_IT_PER_KILO_BYTE  1024
+
+/* Private types -------------------------------------------------------------*/
+typedef enum {
+    UART_RX_DMA_CHECK_IRQ_IDLE = 0,
+    UART_RX_DMA_CHECK_IRQ_HALF_TRANSFER,
+    UART_RX_DMA_CHECK_IRQ_TRANSFER_COMPLETE,
+    UART_RX_DMA_CHECK_IRQ_NUM,
+} E_UartRxDmaCheckIrq;
+
+typedef struct {
+    const char *name;
+    uint32_t dataLen; /*!< Bytes sent over the link. */
+    uint16_t burstLenMax; /*!< Bytes of a burst sent back to back, 0 for one continuous stream. */
+    uint16_t idleLenMax; /*!< Idle time between bursts, unit: byte time. */
+    uint16_t irqLatencyMax; /*!< Time from event to its interrupt handler, unit: byte time. */
+    uint16_t readPeriodMax; /*!< Time between reads of reader task, unit: byte time. */
+    uint32_t stallLen; /*!< Reader does not read until this many bytes were sent, then reads at idle line only. */
+    uint32_t maxInterruptsPerKiloByte;
+} T_UartRxDmaCheckCase;
+
+typedef struct {
+    uint8_t buffer[UART_RX_DMA_CHECK_BUF_SIZE];
+    T_RingBuffer ringBuffer;
+    T_UartBufferState state;
+    uint16_t lastPosition;
+    uint16_t dmaRemainCount; /*!< NDTR of DMA stream, reloaded in circular mode. */
+    uint64_t timeNow; /*!< Unit: byte time. */
+    uint64_t irqTime[UART_RX_DMA_CHECK_IRQ_NUM]; /*!< Time pending interrupt is handled, 0 if not pending. */
+    uint32_t sentLen;
+    uint32_t readLen;
+    uint32_t badByteNum;
+    uint32_t badOffsetNum;
+    uint32_t seed;
+} T_UartRxDmaCheckLink;
+
+/* Private values -------------------------------------------------------------*/
+static const T_UartRxDmaCheckCase s_checkCases[] = {
+    {"frames with idle gaps",       4000000, 1024, 64, 32,   2048, 0,      16},
+    {"short frames",                1000000, 16,   8,  32,   2048, 0,      256},
+    {"continuous stream",           4000000, 0,    0,  32,   2048, 0,      1},
+    {"late interrupts",             4000000, 1024, 64, 3000, 2048, 0,      16},
+    {"reader stalled for 20 laps",  163940,  1024, 64, 32,   2048, 163940, 16},
+    {"reader stalled for 3 laps",   1000000, 1024, 64, 32,   2048, 24676,  16},
+};
+static T_UartRxDmaCheckLink s_link;
+static int s_isFail = 0;
+
+/* Private functions declaration ---------------------------------------------*/
+static void UartRxDmaCheck_Run(const T_UartRxDmaCheckCase *checkCase);
+static void UartRxDmaCheck_FullBuffer(void);
+static void UartRxDmaCheck_InitLink(uint32_t seed);
+static void UartRxDmaCheck_Advance(uint32_t duration, bool isLineBusy, uint16_t irqLatencyMax);
+static void UartRxDmaCheck_RaiseIrq(E_UartRxDmaCheckIrq irq, uint16_t irqLatencyMax);
+static bool UartRxDmaCheck_IsIrqPending(void);
+static void UartRxDmaCheck_Read(void);
+static uint8_t UartRxDmaCheck_GetData(uint32_t offset);
+static uint32_t UartRxDmaCheck_Random(uint32_t max);
+static void UartRxDmaCheck_Expect(const char *name, bool isPass, uint32_t value, uint32_t expect);
+
+/* Exported functions definition ---------------------------------------------*/
+int main(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < sizeof(s_checkCases) / sizeof(s_checkCases[0]); i++) {
+        UartRxDmaCheck_Run(&s_checkCases[i]);
+    }
+    UartRxDmaCheck_FullBuffer();
+
+    printf("%s\r\n", s_isFail ? "CHECK FAIL" : "CHECK PASS");
+
+    return s_isFail;
+}
+
+/* Private functions definition-----------------------------------------------*/
+/**
+ * @brief Send data over the modelled link in bursts while reader task polls the read ring buffer.
+ * @param checkCase: pointer to case.
+ * @return None.
+ */
+static void UartRxDmaCheck_Run(const T_UartRxDmaCheckCase *checkCase)
+{
+    uint32_t burstLen;
+    uint32_t readTime;
+    uint32_t expectLostLen;
+    uint32_t interruptsPerKiloByte;
+
+    printf("%s:\r\n", checkCase->name);
+    UartRxDmaCheck_InitLink(checkCase->dataLen);
+    readTime = UartRxDmaCheck_Random(checkCase->readPeriodMax);
+
+    while (s_link.sentLen < checkCase->dataLen) {
+        burstLen = checkCase->burstLenMax == 0 ? 1 : 1 + UartRxDmaCheck_Random(checkCase->burstLenMax - 1);
+        if (burstLen > checkCase->dataLen - s_link.sentLen) {
+            burstLen = checkCase->dataLen - s_link.sentLen;
+        }
+
+        //reader task wakes up in the middle of bursts too, unless it is stalled
+        while (burstLen != 0) {
+            if (s_link.sentLen < checkCase->stallLen || readTime > burstLen) {
+                if (readTime > burstLen) {
+                    readTime -= burstLen;
+                }
+                UartRxDmaCheck_Advance(burstLen, true, checkCase->irqLatencyMax);
+                burstLen = 0;
+            } else {
+                UartRxDmaCheck_Advance(readTime, true, checkCase->irqLatencyMax);
+                burstLen -= readTime;
+                if (checkCase->stallLen == 0) {
+                    UartRxDmaCheck_Read();
+                }
+                readTime = 1 + UartRxDmaCheck_Random(checkCase->readPeriodMax - 1);
+            }
+        }
+
+        if (checkCase->burstLenMax != 0) {
+            UartRxDmaCheck_RaiseIrq(UART_RX_DMA_CHECK_IRQ_IDLE, checkCase->irqLatencyMax);
+            UartRxDmaCheck_Advance(1 + UartRxDmaCheck_Random(checkCase->idleLenMax - 1), false,
+                                   checkCase->irqLatencyMax);
+            //a reader back from a stall reads while line is idle, otherwise DMA may overwrite what it copies
+            if (checkCase->stallLen != 0 && s_link.sentLen >= checkCase->stallLen && !UartRxDmaCheck_IsIrqPending()) {
+                UartRxDmaCheck_Read();
+            }
+        }
+    }
+
+    //line goes idle at the end, reader takes the rest
+    UartRxDmaCheck_RaiseIrq(UART_RX_DMA_CHECK_IRQ_IDLE, checkCase->irqLatencyMax);
+    UartRxDmaCheck_Advance(checkCase->irqLatencyMax + 2, false, checkCase->irqLatencyMax);
+    UartRxDmaCheck_Read();
+
+    expectLostLen = checkCase->stallLen >= checkCase->dataLen ? checkCase->dataLen - UART_RX_DMA_CHECK_BUF_SIZE : 0;
+    interruptsPerKiloByte = (uint32_t) ((uint64_t) s_link.state.countOfInterrupt * 1024 /
+                                        s_link.state.countOfTransferredData);
+
+    UartRxDmaCheck_Expect("  bytes received", s_link.state.countOfTransferredData == checkCase->dataLen,
+                          s_link.state.countOfTransferredData, checkCase->dataLen);
+    if (checkCase->stallLen == 0 || checkCase->stallLen >= checkCase->dataLen) {
+        UartRxDmaCheck_Expect("  bytes lost", s_link.state.countOfLostData == expectLostLen,
+                              s_link.state.countOfLostData, expectLostLen);
+    } else {
+        //reader catches up after the stall, so at least the data of the stall minus one buffer is lost
+        UartRxDmaCheck_Expect("  bytes lost", s_link.state.countOfLostData >= checkCase->stallLen -
+                              UART_RX_DMA_CHECK_BUF_SIZE, s_link.state.countOfLostData,
+                              checkCase->stallLen - UART_RX_DMA_CHECK_BUF_SIZE);
+    }
+    UartRxDmaCheck_Expect("  bytes read or lost", s_link.readLen + s_link.state.countOfLostData == checkCase->dataLen,
+                          s_link.readLen + s_link.state.countOfLostData, checkCase->dataLen);
+    UartRxDmaCheck_Expect("  bytes read wrong", s_link.badByteNum == 0, s_link.badByteNum, 0);
+    UartRxDmaCheck_Expect("  reads at wrong offset", s_link.badOffsetNum == 0, s_link.badOffsetNum, 0);
+    UartRxDmaCheck_Expect("  max used capacity", s_link.state.maxUsedCapacityOfBuffer <= UART_RX_DMA_CHECK_BUF_SIZE,
+                          s_link.state.maxUsedCapacityOfBuffer, UART_RX_DMA_CHECK_BUF_SIZE);
+    UartRxDmaCheck_Expect("  interrupts per KB", interruptsPerKiloByte <= checkCase->maxInterruptsPerKiloByte,
+                          interruptsPerKiloByte, checkCase->maxInterruptsPerKiloByte);
+    printf("  %-34s %8u\r\n", "interrupts per KB of interrupt mode", UART_RX_DMA_CHECK_IT_PER_KILO_BYTE);
+}
+
+/**
+ * @brief Check the edges of a full buffer, exactly one buffer of unread data loses nothing, one byte more does.
+ * @return None.
+ */
+static void UartRxDmaCheck_FullBuffer(void)
+{
+    printf("full buffer:\r\n");
+    UartRxDmaCheck_InitLink(1);
+
+    //half transfer and transfer complete interrupts report the lap, DMA position is back at buffer start
+    UartRxDmaCheck_Advance(UART_RX_DMA_CHECK_BUF_SIZE, true, 0);
+    UartRxDmaCheck_Advance(2, false, 0);
+    UartRxDmaCheck_Expect("  bytes lost with full buffer", s_link.state.countOfLostData == 0,
+                          s_link.state.countOfLostData, 0);
+    UartRxDmaCheck_Expect("  used capacity", s_link.state.maxUsedCapacityOfBuffer == UART_RX_DMA_CHECK_BUF_SIZE,
+                          s_link.state.maxUsedCapacityOfBuffer, UART_RX_DMA_CHECK_BUF_SIZE);
+
+    UartRxDmaCheck_Advance(1, true, 0);
+    UartRxDmaCheck_RaiseIrq(UART_RX_DMA_CHECK_IRQ_IDLE, 0);
+    UartRxDmaCheck_Advance(2, false, 0);
+    UartRxDmaCheck_Expect("  bytes lost with one byte more", s_link.state.countOfLostData == 1,
+                          s_link.state.countOfLostData, 1);
+
+    UartRxDmaCheck_Read();
+    UartRxDmaCheck_Expect("  bytes read", s_link.readLen == UART_RX_DMA_CHECK_BUF_SIZE, s_link.readLen,
+                          UART_RX_DMA_CHECK_BUF_SIZE);
+    UartRxDmaCheck_Expect("  bytes read wrong", s_link.badByteNum == 0 && s_link.badOffsetNum == 0,
+                          s_link.badByteNum + s_link.badOffsetNum, 0);
+}
+
+static void UartRxDmaCheck_InitLink(uint32_t seed)
+{
+    memset(&s_link, 0, sizeof(s_link));
+    RingBuf_Init(&s_link.ringBuffer, s_link.buffer, sizeof(s_link.buffer));
+    s_link.dmaRemainCount = UART_RX_DMA_CHECK_BUF_SIZE;
+    s_link.seed = seed;
+}
+
+/**
+ * @brief Advance modelled time, DMA stores one byte per byte time while line is busy, due interrupts are handled.
+ * @param duration: unit: byte time.
+ * @param isLineBusy: bytes arrive during whole duration.
+ * @param irqLatencyMax: max latency of interrupts raised during duration.
+ * @return None.
+ */
+static void UartRxDmaCheck_Advance(uint32_t duration, bool isLineBusy, uint16_t irqLatencyMax)
+{
+    uint32_t i;
+    int irq;
+
+    for (i = 0; i < duration; i++) {
+        s_link.timeNow++;
+        if (isLineBusy) {
+            s_link.buffer[UART_RX_DMA_CHECK_BUF_SIZE - s_link.dmaRemainCount] = UartRxDmaCheck_GetData(s_link.sentLen);
+            s_link.sentLen++;
+            s_link.dmaRemainCount--;
+            if (s_link.dmaRemainCount == UART_RX_DMA_CHECK_BUF_SIZE / 2) {
+                UartRxDmaCheck_RaiseIrq(UART_RX_DMA_CHECK_IRQ_HALF_TRANSFER, irqLatencyMax);
+            } else if (s_link.dmaRemainCount == 0) {
+                s_link.dmaRemainCount = UART_RX_DMA_CHECK_BUF_SIZE;
+                UartRxDmaCheck_RaiseIrq(UART_RX_DMA_CHECK_IRQ_TRANSFER_COMPLETE, irqLatencyMax);
+            }
+        }
+
+        for (irq = 0; irq < UART_RX_DMA_CHECK_IRQ_NUM; irq++) {
+            if (s_link.irqTime[irq] != 0 && s_link.irqTime[irq] <= s_link.timeNow) {
+                s_link.irqTime[irq] = 0;
+                UartRxDma_Update(&s_link.lastPosition, &s_link.ringBuffer, s_link.dmaRemainCount, &s_link.state);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Set interrupt flag, a flag already pending is not raised again, like the flags of DMA and USART.
+ * @param irq: interrupt.
+ * @param irqLatencyMax: max time until interrupt is handled, unit: byte time.
+ * @return None.
+ */
+static void UartRxDmaCheck_RaiseIrq(E_UartRxDmaCheckIrq irq, uint16_t irqLatencyMax)
+{
+    if (s_link.irqTime[irq] == 0) {
+        s_link.irqTime[irq] = s_link.timeNow + 1 + UartRxDmaCheck_Random(irqLatencyMax);
+    }
+}
+
+static bool UartRxDmaCheck_IsIrqPending(void)
+{
+    int irq;
+
+    for (irq = 0; irq < UART_RX_DMA_CHECK_IRQ_NUM; irq++) {
+        if (s_link.irqTime[irq] != 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Read like UART_Read() until buffer is empty, every byte is checked against the stream sent.
+ * @return None.
+ */
+static void UartRxDmaCheck_Read(void)
+{
+    uint8_t buf[UART_RX_DMA_CHECK_READ_LEN];
+    uint32_t offset;
+    uint16_t realLen;
+    uint16_t i;
+
+    UartRxDma_Resync(&s_link.ringBuffer);
+
+    //oldest unread byte, everything before it has been read or reported lost
+    offset = s_link.state.countOfTransferredData -
+             (uint16_t) (s_link.ringBuffer.writeIndex - s_link.ringBuffer.readIndex);
+    if (offset != s_link.readLen + s_link.state.countOfLostData) {
+        s_link.badOffsetNum++;
+    }
+
+    do {
+        realLen = RingBuf_Get(&s_link.ringBuffer, buf, sizeof(buf));
+        for (i = 0; i < realLen; i++) {
+            if (buf[i] != UartRxDmaCheck_GetData(offset + i)) {
+                s_link.badByteNum++;
+            }
+        }
+        offset += realLen;
+        s_link.readLen += realLen;
+    } while (realLen == sizeof(buf));
+}
+
+static uint8_t UartRxDmaCheck_GetData(uint32_t offset)
+{
+    return (uint8_t) ((offset * 2654435761U) >> 24);
+}
+
+static uint32_t UartRxDmaCheck_Random(uint32_t max)
+{
+    s_link.seed = s_link.seed * 1664525U + 1013904223U;
+
+    return max == 0 ? 0 : (s_link.seed >> 8) % (max + 1);
+}
+
+static void UartRxDmaCheck_Expect(const char *name, bool isPass, uint32_t value, uint32_t expect)
+{
+    printf("%-36s %8u, expect %8u%s\r\n", name, value, expect, isPass ? "" : "  FAIL");
+    if (!isPass) {
+        s_isFail = 1;
+    }
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
@@ -0,0 +1,225 @@
+/**
+ ********************************************************************
+ * @file    uart_sim.c
+ * @version V2.0.0
+ * @date    2026/10/16
+ * @brief   UART driver of host simulator build. Each port is backed by a pseudo terminal, or
+ *          by the tty/pipe given in environment variable PSDK_SIM_UARTn, console port goes to stdout.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include "uart.h"
+#include "osal.h"
+//termios.h defines CR1/CR2 etc. which clash with register names, keep it after device header
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+
+/* Private constants ---------------------------------------------------------*/
+#define UART_SIM_ENV_NAME_MAX_LEN       32
+
+/* Private types -------------------------------------------------------------*/
+typedef struct {
+    int fd;
+    T_DjiMutexHandle mutex;
+    T_UartBufferState readBufferState;
+    T_UartBufferState writeBufferState;
+} T_UartSimPort;
+
+/* Private values -------------------------------------------------------------*/
+static T_UartSimPort s_uartSimPort[UART_NUM_3 + 1] = {
+    [0 ... UART_NUM_3] = {.fd = -1},
+};
+
+/* Private functions declaration ---------------------------------------------*/
+static int UART_SimOpenPort(E_UartNum uartNum);
+static T_UartSimPort *UART_SimGetPort(E_UartNum uartNum);
+
+/* Exported functions definition ---------------------------------------------*/
+/**
+ * @brief UART initialization of simulator, open the file that stands in for the port.
+ * @param uartNum UART number.
+ * @param baudRate Baud rate, only used for log, host tty keeps its own setting.
+ * @return None.
+ */
+void UART_Init(E_UartNum uartNum, uint32_t baudRate)
+{
+    T_UartSimPort *port = UART_SimGetPort(uartNum);
+
+    if (port == NULL || port->fd >= 0) {
+        return;
+    }
+
+    if (Osal_MutexCreate(&port->mutex) != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        printf("uart%d sim mutex create error\r\n", uartNum);
+        return;
+    }
+
+    if (uartNum == DJI_CONSOLE_UART_NUM) {
+        port->fd = STDOUT_FILENO;
+        return;
+    }
+
+    port->fd = UART_SimOpenPort(uartNum);
+    (void) baudRate;
+}
+
+/**
+ * @brief Read data from UART, never blocks, return 0 if no data.
+ * @param uartNum UART number.
+ * @param buf Pointer to buffer used to store data.
+ * @param readSize Size of data to be read.
+ * @return Size of data read actually.
+ */
+int UART_Read(E_UartNum uartNum, uint8_t *buf, uint16_t readSize)
+{
+    T_UartSimPort *port = UART_SimGetPort(uartNum);
+    ssize_t readRealLen;
+
+    if (port == NULL || port->fd < 0 || port->fd == STDOUT_FILENO) {
+        return UART_ERROR;
+    }
+
+    Osal_MutexLock(port->mutex);
+    do {
+        readRealLen = read(port->fd, buf, readSize);
+    } while (readRealLen < 0 && errno == EINTR);
+
+    //EAGAIN when empty and EIO when no one opened the other side of pty
+    if (readRealLen < 0) {
+        readRealLen = 0;
+    }
+    port->readBufferState.countOfTransferredData += readRealLen;
+    Osal_MutexUnlock(port->mutex);
+
+    return (int) readRealLen;
+}
+
+/**
+ * @brief Write data to UART, data not accepted by host file immediately is counted as lost.
+ * @param uartNum UART number.
+ * @param buf Pointer to data to be sent.
+ * @param writeSize Size of data to be sent.
+ * @return Size of data sent actually.
+ */
+int UART_Write(E_UartNum uartNum, const uint8_t *buf, uint16_t writeSize)
+{
+    T_UartSimPort *port = UART_SimGetPort(uartNum);
+    ssize_t ret;
+    int writeRealLen = 0;
+
+    if (port == NULL || port->fd < 0) {
+        return UART_ERROR;
+    }
+
+    Osal_MutexLock(port->mutex);
+    while (writeRealLen < writeSize) {
+        ret = write(port->fd, buf + writeRealLen, writeSize - writeRealLen);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            break;
+        }
+        writeRealLen += ret;
+    }
+    port->writeBufferState.countOfLostData += writeSize - writeRealLen;
+    port->writeBufferState.countOfTransferredData += writeRealLen;
+    Osal_MutexUnlock(port->mutex);
+
+    return writeRealLen;
+}
+
+/**
+ * @brief Get UART buffer state. There is no interrupt on host, interrupt and latency related items stay 0.
+ * @param uartNum UART number.
+ * @param readBufferState Pointer to read buffer state.
+ * @param writeBufferState Pointer to write buffer state.
+ * @return None.
+ */
+void UART_GetBufferState(E_UartNum uartNum, T_UartBufferState *readBufferState, T_UartBufferState *writeBufferState)
+{
+    T_UartSimPort *port = UART_SimGetPort(uartNum);
+
+    if (port == NULL || port->fd < 0) {
+        return;
+    }
+
+    Osal_MutexLock(port->mutex);
+    memcpy(readBufferState, &port->readBufferState, sizeof(T_UartBufferState));
+    memcpy(writeBufferState, &port->writeBufferState, sizeof(T_UartBufferState));
+    Osal_MutexUnlock(port->mutex);
+}
+
+/* Private functions definition-----------------------------------------------*/
+static T_UartSimPort *UART_SimGetPort(E_UartNum uartNum)
+{
+    if (uartNum < UART_NUM_1 || uartNum > UART_NUM_3) {
+        return NULL;
+    }
+
+    return &s_uartSimPort[uartNum];
+}
+
+static int UART_SimOpenPort(E_UartNum uartNum)
+{
+    char envName[UART_SIM_ENV_NAME_MAX_LEN];
+    const char *path;
+    struct termios tio;
+    int fd;
+
+    snprintf(envName, sizeof(envName), "PSDK_SIM_UART%d", uartNum);
+    path = getenv(envName);
+
+    if (path != NULL) {
+        fd = open(path, O_RDWR | O_NOCTTY | O_NONBLOCK);
+        if (fd < 0) {
+            printf("uart%d sim open %s error: %s\r\n", uartNum, path, strerror(errno));
+            return -1;
+        }
+    } else {
+        fd = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+        if (fd < 0 || grantpt(fd) != 0 || unlockpt(fd) != 0) {
+            printf("uart%d sim open pty error: %s\r\n", uartNum, strerror(errno));
+            if (fd >= 0) {
+                close(fd);
+            }
+            return -1;
+        }
+        path = ptsname(fd);
+    }
+
+    if (isatty(fd) && tcgetattr(fd, &tio) == 0) {
+        cfmakeraw(&tio);
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+
+    printf("uart%d is simulated on %s\r\n", uartNum, path);
+
+    return fd;
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
@@ -0,0 +1,346 @@
+/**
+ ********************************************************************
+ * @file    utftogbk_bench.c
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   Host microbenchmark of the cached iconv descriptors of utftogbk.c against opening and closing
+ *          a descriptor for every call, for short strings like file names and for bulk text.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+#include <iconv.h>
+#include "utftogbk.h"
+
+/* Private constants ---------------------------------------------------------*/
+#define UTFTOGBK_BENCH_MIN_DURATION_NS      500000000ULL
+#define UTFTOGBK_BENCH_THREAD_NUM           4
+#define UTFTOGBK_BENCH_BULK_CHAR_NUM        1000000
+//odd chunk size, so that chunk boundaries split characters and the stream has to carry them over
+#define UTFTOGBK_BENCH_CHUNK_SIZE           4093
+#define UTFTOGBK_BENCH_SHORT_BUFFER_SIZE    256
+//GB2312 level 1 characters have lead byte B0 to D7 and trail byte A1 to FE, D7FA to D7FE are not assigned
+#define UTFTOGBK_BENCH_LEVEL1_LEAD_MIN      0xB0
+#define UTFTOGBK_BENCH_LEVEL1_LEAD_MAX      0xD7
+#define UTFTOGBK_BENCH_TRAIL_MIN            0xA1
+#define UTFTOGBK_BENCH_TRAIL_MAX            0xFE
+
+/* Private types -------------------------------------------------------------*/
+typedef int (*UtfToGbkBenchFunc)(char *sOut, int iMaxOutLen, const char *sIn, int iInLen);
+
+typedef struct {
+    UtfToGbkBenchFunc func;
+    const char *input;
+    int inputLen;
+    const char *expect;
+    int expectLen;
+    double callsPerSecond;
+    int isMismatch;
+} T_UtfToGbkBenchShort;
+
+/* Private values -------------------------------------------------------------*/
+//typical payload file name, about 10 characters of Chinese with ASCII
+static const char s_shortUtf8[] = "航拍视频_20261017_东门入口.mp4";
+
+/* Private functions declaration ---------------------------------------------*/
+static int UtfToGbkBench_UncachedUtf8ToGb2312(char *sOut, int iMaxOutLen, const char *sIn, int iInLen);
+static int UtfToGbkBench_UncachedGb2312ToUtf8(char *sOut, int iMaxOutLen, const char *sIn, int iInLen);
+static int UtfToGbkBench_UncachedConvert(const char *toCode, const char *fromCode, char *sOut, int iMaxOutLen,
+                                         const char *sIn, int iInLen);
+static void *UtfToGbkBench_ShortTask(void *arg);
+static double UtfToGbkBench_MeasureThreads(UtfToGbkBenchFunc func, const char *input, int inputLen,
+                                           const char *expect, int expectLen, int *isMismatch);
+static int UtfToGbkBench_StreamUtf8ToGb2312(char *sOut, int iMaxOutLen, const char *sIn, int iInLen);
+static char *UtfToGbkBench_MakeBulkGb2312(int *size);
+static double UtfToGbkBench_MeasureBulk(UtfToGbkBenchFunc func, const char *input, int inputLen, char *output,
+                                        int outputSize, int *outputLen);
+static uint64_t UtfToGbkBench_GetMonotonicNs(void);
+
+/* Exported functions definition ---------------------------------------------*/
+int main(void)
+{
+    char shortGb2312[UTFTOGBK_BENCH_SHORT_BUFFER_SIZE];
+    T_UtfToGbkBenchShort shortCase[4] = {
+        {.func = UtfToGbkBench_UncachedUtf8ToGb2312},
+        {.func = Utf8ToGb2312},
+        {.func = UtfToGbkBench_UncachedGb2312ToUtf8},
+        {.func = Gb2312ToUtf8},
+    };
+    static const char *const shortName[4] = {
+        "utf-8 -> gb2312 open per call", "utf-8 -> gb2312 cached",
+        "gb2312 -> utf-8 open per call", "gb2312 -> utf-8 cached",
+    };
+    int shortUtf8Len = (int) strlen(s_shortUtf8);
+    int shortGb2312Len;
+    double threadCallsPerSecond[2];
+    int isThreadMismatch = 0;
+    char *bulkGb2312;
+    char *bulkUtf8;
+    char *oneShotOutput;
+    char *streamOutput;
+    int bulkGb2312Len;
+    int bulkUtf8Len;
+    int oneShotLen;
+    int streamLen;
+    double oneShotBytesPerSecond;
+    double streamBytesPerSecond;
+    T_UtfToGbkBenchShort *item;
+    int i;
+
+    shortGb2312Len = Utf8ToGb2312(shortGb2312, sizeof(shortGb2312), s_shortUtf8, shortUtf8Len);
+    if (shortGb2312Len < 0) {
+        printf("utftogbk bench: iconv has no gb2312 converter\r\n");
+        return 1;
+    }
+
+    for (i = 0; i < 4; i++) {
+        item = &shortCase[i];
+        item->input = i < 2 ? s_shortUtf8 : shortGb2312;
+        item->inputLen = i < 2 ? shortUtf8Len : shortGb2312Len;
+        item->expect = i < 2 ? shortGb2312 : s_shortUtf8;
+        item->expectLen = i < 2 ? shortGb2312Len : shortUtf8Len;
+        UtfToGbkBench_ShortTask(item);
+    }
+
+    printf("short string, %d bytes utf-8, %d bytes gb2312:\r\n", shortUtf8Len, shortGb2312Len);
+    for (i = 0; i < 4; i++) {
+        printf("  %-30s %10.0f call/s%s\r\n", shortName[i], shortCase[i].callsPerSecond,
+               shortCase[i].isMismatch ? ", output MISMATCH" : "");
+    }
+    printf("  speedup utf-8 -> gb2312 %.1fx, gb2312 -> utf-8 %.1fx\r\n",
+           shortCase[1].callsPerSecond / shortCase[0].callsPerSecond,
+           shortCase[3].callsPerSecond / shortCase[2].callsPerSecond);
+
+    threadCallsPerSecond[0] = UtfToGbkBench_MeasureThreads(UtfToGbkBench_UncachedUtf8ToGb2312, s_shortUtf8,
+                                                           shortUtf8Len, shortGb2312, shortGb2312Len,
+                                                           &isThreadMismatch);
+    threadCallsPerSecond[1] = UtfToGbkBench_MeasureThreads(Utf8ToGb2312, s_shortUtf8, shortUtf8Len, shortGb2312,
+                                                           shortGb2312Len, &isThreadMismatch);
+    printf("short string, %d threads utf-8 -> gb2312:\r\n", UTFTOGBK_BENCH_THREAD_NUM);
+    printf("  %-30s %10.0f call/s\r\n", "open per call", threadCallsPerSecond[0]);
+    printf("  %-30s %10.0f call/s%s\r\n", "cached per thread", threadCallsPerSecond[1],
+           isThreadMismatch ? ", output MISMATCH" : "");
+
+    bulkGb2312 = UtfToGbkBench_MakeBulkGb2312(&bulkGb2312Len);
+    bulkUtf8 = bulkGb2312 != NULL ? malloc((size_t) bulkGb2312Len * 2) : NULL;
+    oneShotOutput = malloc((size_t) bulkGb2312Len);
+    streamOutput = malloc((size_t) bulkGb2312Len);
+    if (bulkUtf8 == NULL || oneShotOutput == NULL || streamOutput == NULL) {
+        printf("utftogbk bench out of memory\r\n");
+        return 1;
+    }
+
+    bulkUtf8Len = Gb2312ToUtf8(bulkUtf8, bulkGb2312Len * 2, bulkGb2312, bulkGb2312Len);
+    oneShotBytesPerSecond = UtfToGbkBench_MeasureBulk(Utf8ToGb2312, bulkUtf8, bulkUtf8Len, oneShotOutput,
+                                                      bulkGb2312Len, &oneShotLen);
+    streamBytesPerSecond = UtfToGbkBench_MeasureBulk(UtfToGbkBench_StreamUtf8ToGb2312, bulkUtf8, bulkUtf8Len,
+                                                     streamOutput, bulkGb2312Len, &streamLen);
+
+    printf("bulk, %d bytes utf-8, %d characters:\r\n", bulkUtf8Len, UTFTOGBK_BENCH_BULK_CHAR_NUM);
+    printf("  %-30s %7.1f MB/s\r\n", "one call", oneShotBytesPerSecond / 1e6);
+    printf("  %-30s %7.1f MB/s\r\n", "stream, 4093 byte chunks", streamBytesPerSecond / 1e6);
+    printf("  output %s\r\n", oneShotLen == bulkGb2312Len && streamLen == bulkGb2312Len &&
+                              memcmp(oneShotOutput, bulkGb2312, bulkGb2312Len) == 0 &&
+                              memcmp(streamOutput, bulkGb2312, bulkGb2312Len) == 0 ? "round trips" : "MISMATCH");
+
+    free(streamOutput);
+    free(oneShotOutput);
+    free(bulkUtf8);
+    free(bulkGb2312);
+
+    return shortCase[1].isMismatch || shortCase[3].isMismatch || isThreadMismatch ? 1 : 0;
+}
+
+/* Private functions definition-----------------------------------------------*/
+//the conversion utftogbk.c did before descriptors were cached
+static int UtfToGbkBench_UncachedUtf8ToGb2312(char *sOut, int iMaxOutLen, const char *sIn, int iInLen)
+{
+    return UtfToGbkBench_UncachedConvert("gb2312", "utf-8", sOut, iMaxOutLen, sIn, iInLen);
+}
+
+static int UtfToGbkBench_UncachedGb2312ToUtf8(char *sOut, int iMaxOutLen, const char *sIn, int iInLen)
+{
+    return UtfToGbkBench_UncachedConvert("utf-8", "gb2312", sOut, iMaxOutLen, sIn, iInLen);
+}
+
+static int UtfToGbkBench_UncachedConvert(const char *toCode, const char *fromCode, char *sOut, int iMaxOutLen,
+                                         const char *sIn, int iInLen)
+{
+    char *pIn = (char *) sIn;
+    char *pOut = sOut;
+    size_t iLeftLen = iMaxOutLen;
+    size_t iSrcLen = iInLen;
+    size_t ret;
+    iconv_t cd;
+
+    cd = iconv_open(toCode, fromCode);
+    if (cd == (iconv_t) -1) {
+        return -1;
+    }
+    ret = iconv(cd, &pIn, &iSrcLen, &pOut, &iLeftLen);
+    iconv_close(cd);
+
+    return ret == (size_t) -1 ? -1 : (int) (iMaxOutLen - iLeftLen);
+}
+
+static void *UtfToGbkBench_ShortTask(void *arg)
+{
+    T_UtfToGbkBenchShort *item = arg;
+    char output[UTFTOGBK_BENCH_SHORT_BUFFER_SIZE];
+    uint64_t startNs;
+    uint64_t durationNs;
+    uint32_t call = 0;
+    int len;
+
+    startNs = UtfToGbkBench_GetMonotonicNs();
+    do {
+        len = item->func(output, sizeof(output), item->input, item->inputLen);
+        if (len != item->expectLen || memcmp(output, item->expect, len) != 0) {
+            item->isMismatch = 1;
+        }
+        call++;
+        durationNs = UtfToGbkBench_GetMonotonicNs() - startNs;
+    } while (durationNs < UTFTOGBK_BENCH_MIN_DURATION_NS);
+
+    item->callsPerSecond = (double) call * 1e9 / (double) durationNs;
+
+    return NULL;
+}
+
+static double UtfToGbkBench_MeasureThreads(UtfToGbkBenchFunc func, const char *input, int inputLen,
+                                           const char *expect, int expectLen, int *isMismatch)
+{
+    pthread_t thread[UTFTOGBK_BENCH_THREAD_NUM];
+    T_UtfToGbkBenchShort item[UTFTOGBK_BENCH_THREAD_NUM];
+    double callsPerSecond = 0;
+    int i;
+
+    for (i = 0; i < UTFTOGBK_BENCH_THREAD_NUM; i++) {
+        item[i] = (T_UtfToGbkBenchShort) {func, input, inputLen, expect, expectLen, 0, 0};
+        pthread_create(&thread[i], NULL, UtfToGbkBench_ShortTask, &item[i]);
+    }
+    for (i = 0; i < UTFTOGBK_BENCH_THREAD_NUM; i++) {
+        pthread_join(thread[i], NULL);
+        callsPerSecond += item[i].callsPerSecond;
+        *isMismatch |= item[i].isMismatch;
+    }
+
+    return callsPerSecond;
+}
+
+static int UtfToGbkBench_StreamUtf8ToGb2312(char *sOut, int iMaxOutLen, const char *sIn, int iInLen)
+{
+    T_UtfToGbkStream stream;
+    int offset;
+    int chunk;
+    int len;
+    int outLen = 0;
+
+    if (UtfToGbkStream_Begin(&stream, UTFTOGBK_UTF8_TO_GB2312) != 0) {
+        return -1;
+    }
+
+    for (offset = 0; offset < iInLen; offset += chunk) {
+        chunk = iInLen - offset < UTFTOGBK_BENCH_CHUNK_SIZE ? iInLen - offset : UTFTOGBK_BENCH_CHUNK_SIZE;
+        len = UtfToGbkStream_Write(&stream, sOut + outLen, iMaxOutLen - outLen, sIn + offset, chunk);
+        if (len < 0) {
+            UtfToGbkStream_End(&stream);
+            return -1;
+        }
+        outLen += len;
+    }
+
+    return UtfToGbkStream_End(&stream) == 0 ? outLen : -1;
+}
+
+//level 1 characters with about one in ten being ASCII space or digit, like plain Chinese text
+static char *UtfToGbkBench_MakeBulkGb2312(int *size)
+{
+    uint32_t seed = 1;
+    uint32_t random;
+    uint32_t trailNum = UTFTOGBK_BENCH_TRAIL_MAX - UTFTOGBK_BENCH_TRAIL_MIN + 1;
+    uint32_t leadNum = UTFTOGBK_BENCH_LEVEL1_LEAD_MAX - UTFTOGBK_BENCH_LEVEL1_LEAD_MIN + 1;
+    uint8_t lead;
+    uint8_t trail;
+    char *bulk;
+    char *p;
+    int i;
+
+    bulk = malloc(UTFTOGBK_BENCH_BULK_CHAR_NUM * 2);
+    if (bulk == NULL) {
+        return NULL;
+    }
+
+    p = bulk;
+    for (i = 0; i < UTFTOGBK_BENCH_BULK_CHAR_NUM; i++) {
+        seed = seed * 1103515245 + 12345;
+        random = seed >> 8;
+        if (random % 10 == 0) {
+            *p++ = (char) (random % 3 == 0 ? ' ' : '0' + random % 10);
+            continue;
+        }
+        lead = (uint8_t) (UTFTOGBK_BENCH_LEVEL1_LEAD_MIN + random / trailNum % leadNum);
+        trail = (uint8_t) (UTFTOGBK_BENCH_TRAIL_MIN + random % trailNum);
+        if (lead == UTFTOGBK_BENCH_LEVEL1_LEAD_MAX && trail > 0xF9) {
+            trail = 0xF9;
+        }
+        *p++ = (char) lead;
+        *p++ = (char) trail;
+    }
+    *size = (int) (p - bulk);
+
+    return bulk;
+}
+
+static double UtfToGbkBench_MeasureBulk(UtfToGbkBenchFunc func, const char *input, int inputLen, char *output,
+                                        int outputSize, int *outputLen)
+{
+    uint64_t startNs;
+    uint64_t durationNs;
+    uint32_t round = 0;
+
+    *outputLen = func(output, outputSize, input, inputLen);
+
+    startNs = UtfToGbkBench_GetMonotonicNs();
+    do {
+        func(output, outputSize, input, inputLen);
+        round++;
+        durationNs = UtfToGbkBench_GetMonotonicNs() - startNs;
+    } while (durationNs < UTFTOGBK_BENCH_MIN_DURATION_NS);
+
+    return (double) inputLen * round * 1e9 / (double) durationNs;
+}
+
+static uint64_t UtfToGbkBench_GetMonotonicNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
@@ -0,0 +1,459 @@
+/**
+ ********************************************************************
+ * @file    video_send_bench.c
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   Host benchmark of the camera_emu video send path: the mapped video source against the calloc, fseek
+ *          and fread per frame path it replaced. Frames go to a stand-in of DjiPayloadCamera_SendVideoStream,
+ *          which copies every send like the payload sdk does, both paths must deliver the same byte stream.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <time.h>
+#include <math.h>
+#include "dji_logger.h"
+#include "dji_platform.h"
+#include "utils/util_misc.h"
+#include "camera_emu/test_payload_cam_emu_frame_index.h"
+#include "camera_emu/test_payload_cam_emu_video_source.h"
+
+/* Private constants ---------------------------------------------------------*/
+#define VIDEO_SEND_BENCH_FRAME_RATE             30
+#define VIDEO_SEND_BENCH_DURATION_S             60
+#define VIDEO_SEND_BENCH_GOP_SIZE               30
+//IDR frames are larger than one send, so they are cut like 4K streams are
+#define VIDEO_SEND_BENCH_IDR_SIZE               90000
+#define VIDEO_SEND_BENCH_P_SIZE                 12000
+//a frame is less than 1.5 IDR size and starts in the first IDR size bytes of the payload
+#define VIDEO_SEND_BENCH_PAYLOAD_SIZE           (VIDEO_SEND_BENCH_IDR_SIZE * 3)
+#define VIDEO_SEND_BENCH_LOOP_NUM               10
+#define VIDEO_SEND_BENCH_PACED_FRAME_NUM        600
+//same values as test_payload_cam_emu_media.c
+#define VIDEO_SEND_BENCH_FRAME_MAX_COUNT        18000
+#define VIDEO_SEND_BENCH_SEND_LEN_MAX           60000
+#define VIDEO_SEND_BENCH_TASK_FREQ              120
+#define VIDEO_SEND_BENCH_SINK_SIZE              65000
+#define VIDEO_SEND_BENCH_PATH_SIZE              512
+
+/* Private types -------------------------------------------------------------*/
+typedef int (*VideoSendBenchSendFrameFunc)(uint32_t frameNumber);
+
+typedef struct {
+    const char *name;
+    VideoSendBenchSendFrameFunc sendFrame;
+} T_VideoSendBenchPath;
+
+/* Private values -------------------------------------------------------------*/
+static T_DjiOsalHandler s_osalHandler = {0};
+static uint32_t s_seed = 1;
+static uint32_t s_mallocCount = 0;
+static uint8_t s_sink[VIDEO_SEND_BENCH_SINK_SIZE];
+static bool s_isSinkHashed = false;
+static uint64_t s_sinkHash = 0;
+static uint64_t s_sinkBytes = 0;
+static uint32_t s_sinkCallCount = 0;
+static T_TestPayloadCameraVideoFrameInfo *s_frameInfo = NULL;
+static uint32_t s_frameCount = 0;
+static FILE *s_fpFile = NULL;
+static T_TestPayloadCameraVideoSource s_videoSource = {.fd = -1};
+static const uint8_t s_frameAudInfo[VIDEO_SOURCE_AUD_LEN] = {0x00, 0x00, 0x00, 0x01, 0x09, 0x10};
+
+/* Private functions declaration ---------------------------------------------*/
+static void *VideoSendBench_Malloc(uint32_t size);
+static void VideoSendBench_Free(void *ptr);
+static uint32_t VideoSendBench_Random(void);
+static int VideoSendBench_MakeStream(const char *path, uint32_t frameNum);
+static T_DjiReturnCode VideoSendBench_SendVideoStream(const uint8_t *data, uint16_t len);
+static int VideoSendBench_SendFrameByRead(uint32_t frameNumber);
+static int VideoSendBench_SendFrameBySource(uint32_t frameNumber);
+static int VideoSendBench_Run(const T_VideoSendBenchPath *path, uint64_t *hash, uint32_t *sendCount);
+static int VideoSendBench_RunPaced(const T_VideoSendBenchPath *path);
+static int VideoSendBench_CompareDouble(const void *a, const void *b);
+static void VideoSendBench_PrintLatency(const char *name, double *sampleUs, uint32_t sampleNum);
+static uint64_t VideoSendBench_GetMonotonicNs(void);
+
+/* Exported functions definition ---------------------------------------------*/
+T_DjiOsalHandler *DjiPlatform_GetOsalHandler(void)
+{
+    return &s_osalHandler;
+}
+
+void DjiLogger_UserLogOutput(E_DjiLoggerConsoleLogLevel level, const char *fmt, ...)
+{
+    va_list args;
+
+    if (level > DJI_LOGGER_CONSOLE_LOG_LEVEL_WARN) {
+        return;
+    }
+
+    va_start(args, fmt);
+    vfprintf(stderr, fmt, args);
+    fprintf(stderr, "\r\n");
+    va_end(args);
+}
+
+int main(int argc, char *argv[])
+{
+    static const T_VideoSendBenchPath path[] = {
+        {"calloc + fseek + fread", VideoSendBench_SendFrameByRead},
+        {"mapped video source", VideoSendBench_SendFrameBySource},
+    };
+    const char *dir = argc > 1 ? argv[1] : "/tmp";
+    char filePath[VIDEO_SEND_BENCH_PATH_SIZE];
+    uint32_t frameNum = VIDEO_SEND_BENCH_DURATION_S * VIDEO_SEND_BENCH_FRAME_RATE;
+    uint64_t hash[sizeof(path) / sizeof(path[0])];
+    uint32_t sendCount[sizeof(path) / sizeof(path[0])];
+    int isMismatch = 0;
+    uint32_t i;
+    T_DjiReturnCode returnCode;
+
+    s_osalHandler.Malloc = VideoSendBench_Malloc;
+    s_osalHandler.Free = VideoSendBench_Free;
+
+    s_frameInfo = malloc(VIDEO_SEND_BENCH_FRAME_MAX_COUNT * sizeof(T_TestPayloadCameraVideoFrameInfo));
+    if (s_frameInfo == NULL) {
+        printf("video send bench out of memory\r\n");
+        return 1;
+    }
+
+    snprintf(filePath, sizeof(filePath), "%s/video_send_bench.h264", dir);
+    if (VideoSendBench_MakeStream(filePath, frameNum) != 0) {
+        printf("video send bench write %s error\r\n", filePath);
+        return 1;
+    }
+
+    returnCode = DjiTest_FrameIndexScanH264File(filePath, VIDEO_SEND_BENCH_FRAME_RATE, s_frameInfo,
+                                                VIDEO_SEND_BENCH_FRAME_MAX_COUNT, &s_frameCount);
+    if (returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS || s_frameCount != frameNum) {
+        printf("video send bench index %s error\r\n", filePath);
+        return 1;
+    }
+
+    s_fpFile = fopen(filePath, "rb+");
+    returnCode = DjiTest_VideoSourceOpen(&s_videoSource, filePath, s_frameInfo, s_frameCount);
+    if (s_fpFile == NULL || returnCode != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        printf("video send bench open %s error\r\n", filePath);
+        return 1;
+    }
+
+    printf("%u frames, %.1f MB, %u loops, send length max %u B\r\n", s_frameCount,
+           (double) (s_frameInfo[s_frameCount - 1].positionInFile + s_frameInfo[s_frameCount - 1].size) / 1e6,
+           VIDEO_SEND_BENCH_LOOP_NUM, VIDEO_SEND_BENCH_SEND_LEN_MAX);
+    for (i = 0; i < sizeof(path) / sizeof(path[0]); i++) {
+        if (VideoSendBench_Run(&path[i], &hash[i], &sendCount[i]) != 0) {
+            isMismatch = 1;
+        }
+    }
+    //same bytes in as many sends, delimiter shares the last send of a frame on every path
+    for (i = 1; i < sizeof(path) / sizeof(path[0]); i++) {
+        if (hash[i] != hash[0] || sendCount[i] != sendCount[0]) {
+            isMismatch = 1;
+        }
+    }
+
+    printf("paced at %u Hz task tick, %u frames:\r\n", VIDEO_SEND_BENCH_TASK_FREQ, VIDEO_SEND_BENCH_PACED_FRAME_NUM);
+    for (i = 0; i < sizeof(path) / sizeof(path[0]); i++) {
+        if (VideoSendBench_RunPaced(&path[i]) != 0) {
+            isMismatch = 1;
+        }
+    }
+
+    DjiTest_VideoSourceClose(&s_videoSource);
+    fclose(s_fpFile);
+    remove(filePath);
+    free(s_frameInfo);
+
+    printf("video stream %s\r\n", isMismatch ? "MISMATCH" : "same on both paths");
+
+    return isMismatch;
+}
+
+/* Private functions definition-----------------------------------------------*/
+static void *VideoSendBench_Malloc(uint32_t size)
+{
+    s_mallocCount++;
+
+    return malloc(size);
+}
+
+static void VideoSendBench_Free(void *ptr)
+{
+    free(ptr);
+}
+
+static uint32_t VideoSendBench_Random(void)
+{
+    s_seed = s_seed * 1103515245 + 12345;
+
+    return s_seed >> 8;
+}
+
+//SPS and PPS before every IDR, one slice a frame, payload has no zero byte
+static int VideoSendBench_MakeStream(const char *path, uint32_t frameNum)
+{
+    static const uint8_t sps[] = {0x00, 0x00, 0x00, 0x01, 0x67, 0x64, 0x00, 0x28, 0xAC};
+    static const uint8_t pps[] = {0x00, 0x00, 0x00, 0x01, 0x68, 0xEB, 0xE3, 0xCB};
+    static const uint8_t sliceHeader[] = {0x00, 0x00, 0x00, 0x01, 0x00, 0x88};
+    uint8_t *payload;
+    FILE *file;
+    uint32_t i;
+    uint32_t size;
+    uint8_t header[sizeof(sliceHeader)];
+
+    payload = malloc(VIDEO_SEND_BENCH_PAYLOAD_SIZE);
+    file = fopen(path, "wb");
+    if (payload == NULL || file == NULL) {
+        free(payload);
+        return -1;
+    }
+    for (i = 0; i < VIDEO_SEND_BENCH_PAYLOAD_SIZE; i++) {
+        payload[i] = (uint8_t) (VideoSendBench_Random() % 255 + 1);
+    }
+
+    memcpy(header, sliceHeader, sizeof(header));
+    for (i = 0; i < frameNum; i++) {
+        size = i % VIDEO_SEND_BENCH_GOP_SIZE == 0 ? VIDEO_SEND_BENCH_IDR_SIZE : VIDEO_SEND_BENCH_P_SIZE;
+        size = size / 2 + VideoSendBench_Random() % size;
+        header[4] = i % VIDEO_SEND_BENCH_GOP_SIZE == 0 ? 0x65 : 0x41;
+
+        if (i % VIDEO_SEND_BENCH_GOP_SIZE == 0) {
+            fwrite(sps, 1, sizeof(sps), file);
+            fwrite(pps, 1, sizeof(pps), file);
+        }
+        fwrite(header, 1, sizeof(header), file);
+        fwrite(payload + VideoSendBench_Random() % VIDEO_SEND_BENCH_IDR_SIZE, 1, size, file);
+    }
+
+    free(payload);
+
+    return fclose(file);
+}
+
+//stand-in of DjiPayloadCamera_SendVideoStream, which copies data into its send buffer before it returns
+static T_DjiReturnCode VideoSendBench_SendVideoStream(const uint8_t *data, uint16_t len)
+{
+    uint64_t hash = s_sinkHash;
+    uint32_t i;
+
+    if (len > VIDEO_SEND_BENCH_SINK_SIZE) {
+        return DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER;
+    }
+
+    memcpy(s_sink, data, len);
+    if (s_isSinkHashed) {
+        for (i = 0; i < len; i++) {
+            hash = (hash ^ s_sink[i]) * 0x100000001B3ULL;
+        }
+        s_sinkHash = hash;
+    }
+    s_sinkBytes += len;
+    s_sinkCallCount++;
+
+    return DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS;
+}
+
+//frame send of UserCameraMedia_SendVideoTask before the video source, DJI H264 format
+static int VideoSendBench_SendFrameByRead(uint32_t frameNumber)
+{
+    unsigned long dataLength;
+    uint16_t lengthOfDataToBeSent;
+    int lengthOfDataHaveBeenSent;
+    uint32_t frameBufSize;
+    char *dataBuffer;
+    int ret = -1;
+
+    frameBufSize = s_frameInfo[frameNumber].size + VIDEO_SOURCE_AUD_LEN;
+    dataBuffer = calloc(frameBufSize, 1);
+    s_mallocCount++;
+    if (dataBuffer == NULL) {
+        goto free;
+    }
+
+    if (fseek(s_fpFile, s_frameInfo[frameNumber].positionInFile, SEEK_SET) != 0) {
+        goto free;
+    }
+
+    dataLength = fread(dataBuffer, 1, s_frameInfo[frameNumber].size, s_fpFile);
+    if (dataLength != s_frameInfo[frameNumber].size) {
+        goto free;
+    }
+
+    memcpy(&dataBuffer[s_frameInfo[frameNumber].size], s_frameAudInfo, VIDEO_SOURCE_AUD_LEN);
+    dataLength = dataLength + VIDEO_SOURCE_AUD_LEN;
+
+    lengthOfDataHaveBeenSent = 0;
+    while (dataLength - lengthOfDataHaveBeenSent) {
+        lengthOfDataToBeSent = USER_UTIL_MIN(VIDEO_SEND_BENCH_SEND_LEN_MAX, dataLength - lengthOfDataHaveBeenSent);
+        VideoSendBench_SendVideoStream((const uint8_t *) dataBuffer + lengthOfDataHaveBeenSent, lengthOfDataToBeSent);
+        lengthOfDataHaveBeenSent += lengthOfDataToBeSent;
+    }
+    ret = 0;
+
+free:
+    free(dataBuffer);
+
+    return ret;
+}
+
+static int VideoSendBench_SendFrameBySource(uint32_t frameNumber)
+{
+    T_DjiReturnCode returnCode;
+
+    returnCode = DjiTest_VideoSourceSendFrame(&s_videoSource, &s_frameInfo[frameNumber], true,
+                                              VIDEO_SEND_BENCH_SEND_LEN_MAX, VideoSendBench_SendVideoStream);
+
+    return returnCode == DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS ? 0 : -1;
+}
+
+//hash the stream and count the sends of one loop for comparing paths, then send every frame as fast as possible
+static int VideoSendBench_Run(const T_VideoSendBenchPath *path, uint64_t *hash, uint32_t *sendCount)
+{
+    uint32_t sampleNum = VIDEO_SEND_BENCH_LOOP_NUM * s_frameCount;
+    double *sampleUs;
+    uint64_t startNs;
+    uint64_t frameStartNs;
+    uint64_t totalNs;
+    uint32_t mallocCount;
+    uint32_t loop;
+    uint32_t i;
+    int ret = 0;
+
+    sampleUs = malloc(sampleNum * sizeof(double));
+    if (sampleUs == NULL) {
+        return -1;
+    }
+
+    s_sinkHash = 0xCBF29CE484222325ULL;
+    s_sinkCallCount = 0;
+    s_isSinkHashed = true;
+    for (i = 0; i < s_frameCount; i++) {
+        if (path->sendFrame(i) != 0) {
+            ret = -1;
+        }
+    }
+    s_isSinkHashed = false;
+    *hash = s_sinkHash;
+    *sendCount = s_sinkCallCount;
+
+    s_sinkBytes = 0;
+    s_sinkCallCount = 0;
+    mallocCount = s_mallocCount;
+    startNs = VideoSendBench_GetMonotonicNs();
+    for (loop = 0; loop < VIDEO_SEND_BENCH_LOOP_NUM; loop++) {
+        for (i = 0; i < s_frameCount; i++) {
+            frameStartNs = VideoSendBench_GetMonotonicNs();
+            if (path->sendFrame(i) != 0) {
+                ret = -1;
+            }
+            sampleUs[loop * s_frameCount + i] = (double) (VideoSendBench_GetMonotonicNs() - frameStartNs) / 1e3;
+        }
+    }
+    totalNs = VideoSendBench_GetMonotonicNs() - startNs;
+
+    printf("%s:\r\n", path->name);
+    printf("  %9.0f fps, %7.1f MB/s, %u sends, %.2f heap allocations a frame\r\n",
+           (double) sampleNum * 1e9 / (double) totalNs, (double) s_sinkBytes * 1e3 / (double) totalNs,
+           s_sinkCallCount, (double) (s_mallocCount - mallocCount) / sampleNum);
+    VideoSendBench_PrintLatency("frame send", sampleUs, sampleNum);
+    free(sampleUs);
+
+    return ret;
+}
+
+//send a frame on every fourth tick of a 120 Hz task like UserCameraMedia_SendVideoTask, measure lateness of sends
+static int VideoSendBench_RunPaced(const T_VideoSendBenchPath *path)
+{
+    uint64_t periodNs = 1000000000ULL / VIDEO_SEND_BENCH_TASK_FREQ;
+    uint32_t tickPerFrame = VIDEO_SEND_BENCH_TASK_FREQ / VIDEO_SEND_BENCH_FRAME_RATE;
+    double sampleUs[VIDEO_SEND_BENCH_PACED_FRAME_NUM];
+    uint64_t deadlineNs;
+    uint64_t lastDoneNs = 0;
+    uint64_t doneNs;
+    struct timespec ts;
+    uint32_t i;
+    int ret = 0;
+
+    deadlineNs = VideoSendBench_GetMonotonicNs();
+    for (i = 0; i < VIDEO_SEND_BENCH_PACED_FRAME_NUM; i++) {
+        deadlineNs += periodNs * tickPerFrame;
+        ts.tv_sec = (time_t) (deadlineNs / 1000000000ULL);
+        ts.tv_nsec = (long) (deadlineNs % 1000000000ULL);
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+
+        if (path->sendFrame(i % s_frameCount) != 0) {
+            ret = -1;
+        }
+        doneNs = VideoSendBench_GetMonotonicNs();
+        //deviation of frame interval from 1 / frame rate
+        sampleUs[i] = lastDoneNs == 0 ? 0 :
+                      ((double) (doneNs - lastDoneNs) - (double) (periodNs * tickPerFrame)) / 1e3;
+        if (sampleUs[i] < 0) {
+            sampleUs[i] = -sampleUs[i];
+        }
+        lastDoneNs = doneNs;
+    }
+
+    VideoSendBench_PrintLatency(path->name, sampleUs + 1, VIDEO_SEND_BENCH_PACED_FRAME_NUM - 1);
+
+    return ret;
+}
+
+static int VideoSendBench_CompareDouble(const void *a, const void *b)
+{
+    double x = *(const double *) a;
+    double y = *(const double *) b;
+
+    return x < y ? -1 : x > y;
+}
+
+static void VideoSendBench_PrintLatency(const char *name, double *sampleUs, uint32_t sampleNum)
+{
+    double sum = 0;
+    double squareSum = 0;
+    double mean;
+    uint32_t i;
+
+    for (i = 0; i < sampleNum; i++) {
+        sum += sampleUs[i];
+        squareSum += sampleUs[i] * sampleUs[i];
+    }
+    mean = sum / sampleNum;
+    qsort(sampleUs, sampleNum, sizeof(double), VideoSendBench_CompareDouble);
+
+    printf("  %-24s us: mean %8.2f, p50 %8.2f, p99 %8.2f, max %9.2f, stddev %8.2f\r\n", name, mean,
+           sampleUs[sampleNum / 2], sampleUs[(uint32_t) ((uint64_t) sampleNum * 99 / 100)], sampleUs[sampleNum - 1],
+           squareSum / sampleNum > mean * mean ? sqrt(squareSum / sampleNum - mean * mean) : 0);
+}
+
+static uint64_t VideoSendBench_GetMonotonicNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
@@ -0,0 +1,408 @@
+/**
+ ********************************************************************
+ * @file    widget_bus_check.c
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   Host check of the widget bus, subscription, coalescing of bursts, drop counts, event order, index
+ *          masks and snapshot sequence, widget_bus.c of target runs on shim FreeRTOS headers of inc/widget_bus_check.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "widget_bus.h"
+#include "time_base.h"
+
+/* Private constants ---------------------------------------------------------*/
+//subscribers of the check, subscription can't be undone, so they are made once and shared by every case
+#define WIDGET_BUS_CHECK_MOTOR_MASK     (WIDGET_BUS_INDEX_MASK(5) | WIDGET_BUS_INDEX_MASK(7))
+#define WIDGET_BUS_CHECK_LED_MASK       WIDGET_BUS_INDEX_MASK(3)
+#define WIDGET_BUS_CHECK_ALL_MASK       0xFFFFFFFFUL
+#define WIDGET_BUS_CHECK_LATE_MASK      WIDGET_BUS_INDEX_MASK(0)
+
+/* Private types -------------------------------------------------------------*/
+typedef enum {
+    WIDGET_BUS_CHECK_SUBSCRIBER_MOTOR = 0,
+    WIDGET_BUS_CHECK_SUBSCRIBER_LED,
+    WIDGET_BUS_CHECK_SUBSCRIBER_ALL,
+    WIDGET_BUS_CHECK_SUBSCRIBER_LATE,
+    WIDGET_BUS_CHECK_SUBSCRIBER_NUM,
+} E_WidgetBusCheckSubscriber;
+
+typedef struct {
+    const char *caseName;
+    int isFail;
+} T_WidgetBusCheckRun;
+
+typedef struct {
+    const char *name;
+    void (*func)(T_WidgetBusCheckRun *run);
+} T_WidgetBusCheckCase;
+
+/* Private values -------------------------------------------------------------*/
+static T_WidgetBusHandle s_checkHandle[WIDGET_BUS_CHECK_SUBSCRIBER_NUM];
+static uint64_t s_nowUs = 1000;
+
+/* Private functions declaration ---------------------------------------------*/
+static void WidgetBusCheck_Subscribe(T_WidgetBusCheckRun *run);
+static void WidgetBusCheck_Burst(T_WidgetBusCheckRun *run);
+static void WidgetBusCheck_Order(T_WidgetBusCheckRun *run);
+static void WidgetBusCheck_Requeue(T_WidgetBusCheckRun *run);
+static void WidgetBusCheck_AllIndex(T_WidgetBusCheckRun *run);
+static void WidgetBusCheck_Snapshot(T_WidgetBusCheckRun *run);
+static void WidgetBusCheck_Publish(E_DjiWidgetType widgetType, uint32_t index, int32_t value);
+static void WidgetBusCheck_ExpectEvent(T_WidgetBusCheckRun *run, E_WidgetBusCheckSubscriber subscriber,
+                                       uint32_t index, int32_t value, uint32_t countOfCoalesced, uint64_t timeUs,
+                                       const char *step);
+static void WidgetBusCheck_ExpectNoEvent(T_WidgetBusCheckRun *run, E_WidgetBusCheckSubscriber subscriber,
+                                         const char *step);
+static void WidgetBusCheck_GetState(E_WidgetBusCheckSubscriber subscriber, T_WidgetBusSubscriberState *state);
+static void WidgetBusCheck_ExpectCount(T_WidgetBusCheckRun *run, E_WidgetBusCheckSubscriber subscriber,
+                                       const T_WidgetBusSubscriberState *before, uint32_t eventNum,
+                                       uint32_t droppedNum, const char *step);
+static void WidgetBusCheck_ExpectTrue(T_WidgetBusCheckRun *run, bool isTrue, const char *step);
+
+/* Exported functions definition ---------------------------------------------*/
+int main(void)
+{
+    //cases run in order, subscribe case makes the subscribers the others use
+    static const T_WidgetBusCheckCase checkCase[] = {
+        {"subscribe", WidgetBusCheck_Subscribe},
+        {"burst coalesced", WidgetBusCheck_Burst},
+        {"event order", WidgetBusCheck_Order},
+        {"requeue after receive", WidgetBusCheck_Requeue},
+        {"every index", WidgetBusCheck_AllIndex},
+        {"snapshot sequence", WidgetBusCheck_Snapshot},
+    };
+    T_WidgetBusCheckRun run;
+    int isFail = 0;
+    uint32_t i;
+
+    for (i = 0; i < sizeof(checkCase) / sizeof(checkCase[0]); i++) {
+        run.caseName = checkCase[i].name;
+        run.isFail = 0;
+        checkCase[i].func(&run);
+        printf("%-26s %s\r\n", checkCase[i].name, run.isFail ? "FAIL" : "ok");
+        isFail |= run.isFail;
+    }
+
+    printf("%s\r\n", isFail ? "CHECK FAIL" : "CHECK PASS");
+
+    return isFail;
+}
+
+//time base of target is replaced by a clock the check advances
+void TimeBase_Init(void)
+{
+}
+
+uint64_t TimeBase_GetUs(void)
+{
+    return s_nowUs;
+}
+
+/* Private functions definition-----------------------------------------------*/
+/**
+ * @brief Invalid subscriptions are rejected, up to WIDGET_BUS_SUBSCRIBER_MAX_NUM are taken and names are truncated.
+ */
+static void WidgetBusCheck_Subscribe(T_WidgetBusCheckRun *run)
+{
+    static const struct {
+        const char *name;
+        uint32_t indexMask;
+    } subscription[WIDGET_BUS_CHECK_SUBSCRIBER_NUM] = {
+        {"motor", WIDGET_BUS_CHECK_MOTOR_MASK},
+        {"led", WIDGET_BUS_CHECK_LED_MASK},
+        {"all", WIDGET_BUS_CHECK_ALL_MASK},
+        {"late subscriber name", WIDGET_BUS_CHECK_LATE_MASK},
+    };
+    T_WidgetBusSubscriberState state;
+    T_WidgetBusHandle handle = NULL;
+    uint32_t i;
+
+    WidgetBusCheck_ExpectTrue(run, WidgetBus_Subscribe(NULL, 1, &handle) ==
+                                   DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER, "no name");
+    WidgetBusCheck_ExpectTrue(run, WidgetBus_Subscribe("none", 0, &handle) ==
+                                   DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER, "no index");
+    WidgetBusCheck_ExpectTrue(run, WidgetBus_Subscribe("none", 1, NULL) ==
+                                   DJI_ERROR_SYSTEM_MODULE_CODE_INVALID_PARAMETER, "no handle");
+    WidgetBusCheck_ExpectTrue(run, WidgetBus_GetSubscriberState(0, &state) ==
+                                   DJI_ERROR_SYSTEM_MODULE_CODE_OUT_OF_RANGE, "state before subscribe");
+
+    for (i = 0; i < WIDGET_BUS_CHECK_SUBSCRIBER_NUM; i++) {
+        WidgetBusCheck_ExpectTrue(run, WidgetBus_Subscribe(subscription[i].name, subscription[i].indexMask,
+                                                           &s_checkHandle[i]) ==
+                                       DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS, subscription[i].name);
+    }
+    WidgetBusCheck_ExpectTrue(run, WidgetBus_Subscribe("extra", 1, &handle) ==
+                                   DJI_ERROR_SYSTEM_MODULE_CODE_OUT_OF_RANGE, "beyond max subscribers");
+    WidgetBusCheck_ExpectTrue(run, WidgetBus_GetSubscriberState(WIDGET_BUS_CHECK_SUBSCRIBER_NUM, &state) ==
+                                   DJI_ERROR_SYSTEM_MODULE_CODE_OUT_OF_RANGE, "state beyond subscribers");
+
+    WidgetBusCheck_GetState(WIDGET_BUS_CHECK_SUBSCRIBER_MOTOR, &state);
+    WidgetBusCheck_ExpectTrue(run, strcmp(state.name, "motor") == 0 &&
+                                   state.indexMask == WIDGET_BUS_CHECK_MOTOR_MASK &&
+                                   state.countOfEvent == 0 && state.countOfDropped == 0, "state of motor");
+    WidgetBusCheck_GetState(WIDGET_BUS_CHECK_SUBSCRIBER_LATE, &state);
+    WidgetBusCheck_ExpectTrue(run, strcmp(state.name, "late subscriber") == 0, "name truncated");
+}
+
+/**
+ * @brief Burst of changes to one widget is received as one event with latest value and time of oldest change, the
+ * changes coalesced away are counted as dropped, subscribers of other widgets see nothing.
+ */
+static void WidgetBusCheck_Burst(T_WidgetBusCheckRun *run)
+{
+    T_WidgetBusSubscriberState motorBefore;
+    T_WidgetBusSubscriberState ledBefore;
+    T_WidgetBusSubscriberState motorAfter;
+    uint64_t burstStartUs = s_nowUs;
+    int32_t value;
+
+    WidgetBusCheck_GetState(WIDGET_BUS_CHECK_SUBSCRIBER_MOTOR, &motorBefore);
+    WidgetBusCheck_GetState(WIDGET_BUS_CHECK_SUBSCRIBER_LED, &ledBefore);
+
+    for (value = 10; value < 15; value++) {
+        WidgetBusCheck_Publish(DJI_WIDGET_TYPE_SCALE, 5, value);
+    }
+    s_nowUs += 1000;
+
+    WidgetBusCheck_ExpectEvent(run, WIDGET_BUS_CHECK_SUBSCRIBER_MOTOR, 5, 14, 4, burstStartUs, "burst");
+    WidgetBusCheck_ExpectNoEvent(run, WIDGET_BUS_CHECK_SUBSCRIBER_MOTOR, "after burst");
+    WidgetBusCheck_ExpectEvent(run, WIDGET_BUS_CHECK_SUBSCRIBER_ALL, 5, 14, 4, burstStartUs, "burst of all");
+    WidgetBusCheck_ExpectNoEvent(run, WIDGET_BUS_CHECK_SUBSCRIBER_LED, "burst of other widget");
+
+    WidgetBusCheck_ExpectCount(run, WIDGET_BUS_CHECK_SUBSCRIBER_MOTOR, &motorBefore, 1, 4, "count of burst");
+    WidgetBusCheck_ExpectCount(run, WIDGET_BUS_CHECK_SUBSCRIBER_LED, &ledBefore, 0, 0, "count of other widget");
+    //latency runs from oldest change of the burst
+    WidgetBusCheck_GetState(WIDGET_BUS_CHECK_SUBSCRIBER_MOTOR, &motorAfter);
+    WidgetBusCheck_ExpectTrue(run, motorAfter.maxLatencyUs >= s_nowUs - burstStartUs, "latency of burst");
+}
+
+/**
+ * @brief Events come in order of first change of each widget, each with latest value and type of its widget.
+ */
+static void WidgetBusCheck_Order(T_WidgetBusCheckRun *run)
+{
+    T_WidgetBusSubscriberState motorBefore;
+    T_WidgetBusSubscriberState allBefore;
+    uint64_t firstUs[WIDGET_BUS_INDEX_NUM] = {0};
+
+    WidgetBusCheck_GetState(WIDGET_BUS_CHECK_SUBSCRIBER_MOTOR, &motorBefore);
+    WidgetBusCheck_GetState(WIDGET_BUS_CHECK_SUBSCRIBER_ALL, &allBefore);
+
+    firstUs[5] = s_nowUs;
+    WidgetBusCheck_Publish(DJI_WIDGET_TYPE_SCALE, 5, 20);
+    firstUs[7] = s_nowUs;
+    WidgetBusCheck_Publish(DJI_WIDGET_TYPE_SWITCH, 7, 1);
+    WidgetBusCheck_Publish(DJI_WIDGET_TYPE_SCALE, 5, 21);
+    firstUs[3] = s_nowUs;
+    WidgetBusCheck_Publish(DJI_WIDGET_TYPE_SCALE, 3, 30);
+    WidgetBusCheck_Publish(DJI_WIDGET_TYPE_SWITCH, 7, 0);
+    WidgetBusCheck_Publish(DJI_WIDGET_TYPE_SCALE, 5, 22);
+
+    WidgetBusCheck_ExpectEvent(run, WIDGET_BUS_CHECK_SUBSCRIBER_MOTOR, 5, 22, 2, firstUs[5], "first of motor");
+    WidgetBusCheck_ExpectEvent(run, WIDGET_BUS_CHECK_SUBSCRIBER_MOTOR, 7, 0, 1, firstUs[7], "second of motor");
+    WidgetBusCheck_ExpectNoEvent(run, WIDGET_BUS_CHECK_SUBSCRIBER_MOTOR, "end of motor");
+
+    WidgetBusCheck_ExpectEvent(run, WIDGET_BUS_CHECK_SUBSCRIBER_ALL, 5, 22, 2, firstUs[5], "first of all");
+    WidgetBusCheck_ExpectEvent(run, WIDGET_BUS_CHECK_SUBSCRIBER_ALL, 7, 0, 1, firstUs[7], "second of all");
+    WidgetBusCheck_ExpectEvent(run, WIDGET_BUS_CHECK_SUBSCRIBER_ALL, 3, 30, 0, firstUs[3], "third of all");
+    WidgetBusCheck_ExpectNoEvent(run, WIDGET_BUS_CHECK_SUBSCRIBER_ALL, "end of all");
+
+    WidgetBusCheck_ExpectEvent(run, WIDGET_BUS_CHECK_SUBSCRIBER_LED, 3, 30, 0, firstUs[3], "led");
+    WidgetBusCheck_ExpectNoEvent(run, WIDGET_BUS_CHECK_SUBSCRIBER_LED, "end of led");
+
+    WidgetBusCheck_ExpectCount(run, WIDGET_BUS_CHECK_SUBSCRIBER_MOTOR, &motorBefore, 2, 3, "count of motor");
+    WidgetBusCheck_ExpectCount(run, WIDGET_BUS_CHECK_SUBSCRIBER_ALL, &allBefore, 3, 3, "count of all");
+}
+
+/**
+ * @brief Change after receive is a new event, not coalesced with the received one.
+ */
+static void WidgetBusCheck_Requeue(T_WidgetBusCheckRun *run)
+{
+    uint64_t secondUs;
+
+    WidgetBusCheck_Publish(DJI_WIDGET_TYPE_SCALE, 5, 40);
+    WidgetBusCheck_Publish(DJI_WIDGET_TYPE_SCALE, 5, 41);
+    WidgetBusCheck_ExpectEvent(run, WIDGET_BUS_CHECK_SUBSCRIBER_MOTOR, 5, 41, 1, s_nowUs - 200, "first");
+
+    secondUs = s_nowUs;
+    WidgetBusCheck_Publish(DJI_WIDGET_TYPE_SCALE, 5, 42);
+    WidgetBusCheck_ExpectEvent(run, WIDGET_BUS_CHECK_SUBSCRIBER_MOTOR, 5, 42, 0, secondUs, "after receive");
+    WidgetBusCheck_ExpectNoEvent(run, WIDGET_BUS_CHECK_SUBSCRIBER_MOTOR, "end");
+
+    //all subscriber did not receive in between, so it still has one event
+    WidgetBusCheck_ExpectEvent(run, WIDGET_BUS_CHECK_SUBSCRIBER_ALL, 5, 42, 2, secondUs - 200, "all");
+    WidgetBusCheck_ExpectNoEvent(run, WIDGET_BUS_CHECK_SUBSCRIBER_ALL, "end of all");
+}
+
+/**
+ * @brief Every index pending at once fits the queue of a subscriber, indexes out of range are ignored.
+ */
+static void WidgetBusCheck_AllIndex(T_WidgetBusCheckRun *run)
+{
+    T_WidgetBusSubscriberState allBefore;
+    T_WidgetBusSnapshot snapshot;
+    uint64_t firstUs = s_nowUs;
+    uint32_t sequence;
+    uint32_t round;
+    uint32_t i;
+
+    WidgetBusCheck_GetState(WIDGET_BUS_CHECK_SUBSCRIBER_ALL, &allBefore);
+
+    for (round = 0; round < 2; round++) {
+        for (i = 0; i < WIDGET_BUS_INDEX_NUM; i++) {
+            WidgetBusCheck_Publish(DJI_WIDGET_TYPE_INT_INPUT_BOX, i, (int32_t) (round * 100 + i));
+        }
+    }
+    WidgetBus_GetSnapshot(&snapshot);
+    sequence = snapshot.sequence;
+    WidgetBusCheck_Publish(DJI_WIDGET_TYPE_INT_INPUT_BOX, WIDGET_BUS_INDEX_NUM, 0);
+    WidgetBus_GetSnapshot(&snapshot);
+    WidgetBusCheck_ExpectTrue(run, snapshot.sequence == sequence, "index out of range");
+
+    for (i = 0; i < WIDGET_BUS_INDEX_NUM; i++) {
+        WidgetBusCheck_ExpectEvent(run, WIDGET_BUS_CHECK_SUBSCRIBER_ALL, i, (int32_t) (100 + i), 1,
+                                   firstUs + i * 100, "index");
+    }
+    WidgetBusCheck_ExpectNoEvent(run, WIDGET_BUS_CHECK_SUBSCRIBER_ALL, "end of all");
+    WidgetBusCheck_ExpectCount(run, WIDGET_BUS_CHECK_SUBSCRIBER_ALL, &allBefore, WIDGET_BUS_INDEX_NUM,
+                               WIDGET_BUS_INDEX_NUM, "count of all");
+
+    //other subscribers are drained for the cases after
+    WidgetBusCheck_ExpectEvent(run, WIDGET_BUS_CHECK_SUBSCRIBER_LATE, 0, 100, 1, firstUs, "late");
+    WidgetBusCheck_ExpectEvent(run, WIDGET_BUS_CHECK_SUBSCRIBER_LED, 3, 103, 1, firstUs + 300, "led");
+    WidgetBusCheck_ExpectEvent(run, WIDGET_BUS_CHECK_SUBSCRIBER_MOTOR, 5, 105, 1, firstUs + 500, "motor first");
+    WidgetBusCheck_ExpectEvent(run, WIDGET_BUS_CHECK_SUBSCRIBER_MOTOR, 7, 107, 1, firstUs + 700, "motor second");
+}
+
+/**
+ * @brief Snapshot sequence counts every change, coalesced or not, and snapshot holds latest value of every widget.
+ */
+static void WidgetBusCheck_Snapshot(T_WidgetBusCheckRun *run)
+{
+    T_WidgetBusSnapshot before;
+    T_WidgetBusSnapshot after;
+    T_WidgetBusSnapshot again;
+
+    WidgetBus_GetSnapshot(&before);
+    WidgetBusCheck_Publish(DJI_WIDGET_TYPE_SCALE, 9, 90);
+    WidgetBusCheck_Publish(DJI_WIDGET_TYPE_SCALE, 5, 50);
+    WidgetBusCheck_Publish(DJI_WIDGET_TYPE_SCALE, 5, 51);
+    WidgetBus_GetSnapshot(&after);
+
+    WidgetBusCheck_ExpectTrue(run, after.sequence == before.sequence + 3, "sequence counts every change");
+    WidgetBusCheck_ExpectTrue(run, after.value[9] == 90 && after.value[5] == 51, "latest values");
+    before.value[9] = 90;
+    before.value[5] = 51;
+    WidgetBusCheck_ExpectTrue(run, memcmp(before.value, after.value, sizeof(before.value)) == 0,
+                              "other values kept");
+
+    WidgetBus_GetSnapshot(&again);
+    WidgetBusCheck_ExpectTrue(run, memcmp(&again, &after, sizeof(again)) == 0, "same sequence same snapshot");
+
+    WidgetBusCheck_ExpectEvent(run, WIDGET_BUS_CHECK_SUBSCRIBER_MOTOR, 5, 51, 1, s_nowUs - 200, "motor");
+    WidgetBusCheck_ExpectEvent(run, WIDGET_BUS_CHECK_SUBSCRIBER_ALL, 9, 90, 0, s_nowUs - 300, "all first");
+    WidgetBusCheck_ExpectEvent(run, WIDGET_BUS_CHECK_SUBSCRIBER_ALL, 5, 51, 1, s_nowUs - 200, "all second");
+}
+
+/**
+ * @brief Publish a change, clock advances 100 us after each change so that events tell which change they start from.
+ */
+static void WidgetBusCheck_Publish(E_DjiWidgetType widgetType, uint32_t index, int32_t value)
+{
+    WidgetBus_Publish(widgetType, index, value);
+    s_nowUs += 100;
+}
+
+static void WidgetBusCheck_ExpectEvent(T_WidgetBusCheckRun *run, E_WidgetBusCheckSubscriber subscriber,
+                                       uint32_t index, int32_t value, uint32_t countOfCoalesced, uint64_t timeUs,
+                                       const char *step)
+{
+    T_WidgetBusEvent event;
+
+    if (WidgetBus_Receive(s_checkHandle[subscriber], &event, 0) != DJI_ERROR_SYSTEM_MODULE_CODE_SUCCESS) {
+        printf("  %s: %s: no event, expect index %u\r\n", run->caseName, step, (unsigned int) index);
+        run->isFail = 1;
+        return;
+    }
+
+    if (event.index != index || event.value != value || event.countOfCoalesced != countOfCoalesced ||
+        event.timeUs != timeUs) {
+        printf("  %s: %s: index %u, value %d, coalesced %u, time %llu, expect %u, %d, %u, %llu\r\n", run->caseName,
+               step, (unsigned int) event.index, (int) event.value, (unsigned int) event.countOfCoalesced,
+               (unsigned long long) event.timeUs, (unsigned int) index, (int) value,
+               (unsigned int) countOfCoalesced, (unsigned long long) timeUs);
+        run->isFail = 1;
+    }
+}
+
+static void WidgetBusCheck_ExpectNoEvent(T_WidgetBusCheckRun *run, E_WidgetBusCheckSubscriber subscriber,
+                                         const char *step)
+{
+    T_WidgetBusEvent event;
+
+    if (WidgetBus_Receive(s_checkHandle[subscriber], &event, 0) != DJI_ERROR_SYSTEM_MODULE_CODE_TIMEOUT) {
+        printf("  %s: %s: unexpected event of index %u\r\n", run->caseName, step, (unsigned int) event.index);
+        run->isFail = 1;
+    }
+}
+
+static void WidgetBusCheck_GetState(E_WidgetBusCheckSubscriber subscriber, T_WidgetBusSubscriberState *state)
+{
+    memset(state, 0, sizeof(T_WidgetBusSubscriberState));
+    WidgetBus_GetSubscriberState((uint16_t) subscriber, state);
+}
+
+/**
+ * @brief Check counts of events and dropped changes of a subscriber grew by given numbers since before.
+ */
+static void WidgetBusCheck_ExpectCount(T_WidgetBusCheckRun *run, E_WidgetBusCheckSubscriber subscriber,
+                                       const T_WidgetBusSubscriberState *before, uint32_t eventNum,
+                                       uint32_t droppedNum, const char *step)
+{
+    T_WidgetBusSubscriberState state;
+
+    WidgetBusCheck_GetState(subscriber, &state);
+    if (state.countOfEvent - before->countOfEvent != eventNum ||
+        state.countOfDropped - before->countOfDropped != droppedNum) {
+        printf("  %s: %s: events %u, dropped %u, expect %u, %u\r\n", run->caseName, step,
+               (unsigned int) (state.countOfEvent - before->countOfEvent),
+               (unsigned int) (state.countOfDropped - before->countOfDropped), (unsigned int) eventNum,
+               (unsigned int) droppedNum);
+        run->isFail = 1;
+    }
+}
+
+static void WidgetBusCheck_ExpectTrue(T_WidgetBusCheckRun *run, bool isTrue, const char *step)
+{
+    if (!isTrue) {
+        printf("  %s: %s: unexpected result\r\n", run->caseName, step);
+        run->isFail = 1;
+    }
+}
+
+/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/
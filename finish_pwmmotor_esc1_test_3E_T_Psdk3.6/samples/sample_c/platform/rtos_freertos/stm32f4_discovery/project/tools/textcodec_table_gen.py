@@ -0,0 +1,178 @@
+#!/usr/bin/env python3
+# Generate the Unicode to GBK and GBK to Unicode tables of drivers/BSP/textcodec.c from the GBK codec of Python.
+#
+# Unicode to GBK table is two level: the high byte of a BMP code point selects a page through a 256 byte index, the low byte
+# selects the GBK code in the page. Pages without any mapping share the empty page 0, so only about 100 pages of
+# 512 bytes are stored, and a lookup is two loads instead of the binary search over the sorted pair table.
+# GBK to Unicode table has a row for every lead byte 0x81 to 0xFE and a column for every trail byte 0x40 to 0xFE.
+#
+# Usage: textcodec_table_gen.py [output directory], default is drivers/BSP. Generated files are kept in the tree
+# because MDK build can not run a generator, host simulator build regenerates them in its build directory, where
+# target textcodec_table_check compares them with the kept ones.
+
+import os
+import sys
+
+PAGE_SIZE = 256
+PAGE_NUM_MAX = 255
+GBK_LEAD_MIN = 0x81
+GBK_LEAD_MAX = 0xFE
+GBK_TRAIL_MIN = 0x40
+GBK_TRAIL_MAX = 0xFE
+
+HEADER_TEMPLATE = """/**
+ ********************************************************************
+ * @file    {name}
+ * @version V2.0.0
+ * @date    2026/10/17
+ * @brief   Unicode to GBK page table, generated by project/tools/textcodec_table_gen.py, do not edit.
+ *
+ * @copyright (c) 2021 DJI. All rights reserved.
+ *
+ * All information contained herein is, and remains, the property of DJI.
+ * The intellectual and technical concepts contained herein are proprietary
+ * to DJI and may be covered by U.S. and foreign patents, patents in process,
+ * and protected by trade secret or copyright law.  Dissemination of this
+ * information, including but not limited to data and other proprietary
+ * material(s) incorporated within the information, in any form, is strictly
+ * prohibited without the express written consent of DJI.
+ *
+ * If you receive this source code without DJI’s authorization, you may not
+ * further disseminate the information, and you must immediately remove the
+ * source code and notify DJI of its removal. DJI reserves the right to pursue
+ * legal actions against you for any loss(es) or damage(s) caused by your
+ * failure to do so.
+ *
+ *********************************************************************
+ */
+"""
+
+
+def build_pages():
+    pages = [[0] * PAGE_SIZE]
+    index = [0] * PAGE_SIZE
+    count = 0
+
+    for high in range(PAGE_SIZE):
+        page = [0] * PAGE_SIZE
+        for low in range(PAGE_SIZE):
+            code = (high << 8) | low
+            if code < 0x80 or 0xD800 <= code < 0xE000:
+                continue
+            try:
+                gbk = chr(code).encode('gbk')
+            except UnicodeEncodeError:
+                continue
+            if len(gbk) == 2:
+                page[low] = (gbk[0] << 8) | gbk[1]
+                count += 1
+        if any(page):
+            index[high] = len(pages)
+            pages.append(page)
+
+    if len(pages) > PAGE_NUM_MAX:
+        raise SystemExit('too many pages for 8 bit index: %d' % len(pages))
+
+    return index, pages, count
+
+
+def build_gbk_rows():
+    rows = []
+
+    for lead in range(GBK_LEAD_MIN, GBK_LEAD_MAX + 1):
+        row = [0] * (GBK_TRAIL_MAX - GBK_TRAIL_MIN + 1)
+        for trail in range(GBK_TRAIL_MIN, GBK_TRAIL_MAX + 1):
+            try:
+                text = bytes([lead, trail]).decode('gbk')
+            except UnicodeDecodeError:
+                continue
+            row[trail - GBK_TRAIL_MIN] = ord(text)
+        rows.append(row)
+
+    return rows
+
+
+def write_header(path, page_num, count):
+    with open(path, 'w', encoding='utf-8', newline='\n') as f:
+        f.write(HEADER_TEMPLATE.format(name=os.path.basename(path)))
+        f.write("""
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef TEXTCODEC_TABLE_H
+#define TEXTCODEC_TABLE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Exported constants --------------------------------------------------------*/
+#define TEXTCODEC_TABLE_PAGE_SIZE                   %d
+#define TEXTCODEC_TABLE_UNICODE_TO_GBK_PAGE_NUM     %d
+#define TEXTCODEC_TABLE_UNICODE_TO_GBK_CODE_NUM     %d
+#define TEXTCODEC_TABLE_GBK_LEAD_MIN                0x%02X
+#define TEXTCODEC_TABLE_GBK_LEAD_MAX                0x%02X
+#define TEXTCODEC_TABLE_GBK_TRAIL_MIN               0x%02X
+#define TEXTCODEC_TABLE_GBK_TRAIL_MAX               0x%02X
+
+/* Exported types ------------------------------------------------------------*/
+
+/* Exported functions --------------------------------------------------------*/
+//page of code point c is page[index[c >> 8]], entry c & 0xFF of it is GBK code in big endian order, 0 if unmapped
+extern const uint8_t g_textCodecUnicodeToGbkIndex[TEXTCODEC_TABLE_PAGE_SIZE];
+extern const uint16_t g_textCodecUnicodeToGbkPage[TEXTCODEC_TABLE_UNICODE_TO_GBK_PAGE_NUM][TEXTCODEC_TABLE_PAGE_SIZE];
+//code point of GBK code lead, trail is entry [lead - LEAD_MIN][trail - TRAIL_MIN], 0 if unmapped
+extern const uint16_t g_textCodecGbkToUnicode[TEXTCODEC_TABLE_GBK_LEAD_MAX - TEXTCODEC_TABLE_GBK_LEAD_MIN + 1]
+                                             [TEXTCODEC_TABLE_GBK_TRAIL_MAX - TEXTCODEC_TABLE_GBK_TRAIL_MIN + 1];
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TEXTCODEC_TABLE_H
+/************************ (C) COPYRIGHT DJI Innovations *******END OF FILE******/
+""" % (PAGE_SIZE, page_num, count, GBK_LEAD_MIN, GBK_LEAD_MAX, GBK_TRAIL_MIN, GBK_TRAIL_MAX))
+
+
+def write_source(path, index, pages, rows):
+    with open(path, 'w', encoding='utf-8', newline='\n') as f:
+        f.write(HEADER_TEMPLATE.format(name=os.path.basename(path)))
+        f.write('\n/* Includes ------------------------------------------------------------------*/\n')
+        f.write('#include "textcodec_table.h"\n\n')
+        f.write('/* Exported values -----------------------------------------------------------*/\n')
+        f.write('const uint8_t g_textCodecUnicodeToGbkIndex[TEXTCODEC_TABLE_PAGE_SIZE] = {\n')
+        for i in range(0, PAGE_SIZE, 16):
+            f.write('    ' + ', '.join('%3d' % v for v in index[i:i + 16]) + ',\n')
+        f.write('};\n\n')
+        f.write('const uint16_t g_textCodecUnicodeToGbkPage[TEXTCODEC_TABLE_UNICODE_TO_GBK_PAGE_NUM]'
+                '[TEXTCODEC_TABLE_PAGE_SIZE] = {\n')
+        for n, page in enumerate(pages):
+            high = index.index(n) if n != 0 else None
+            f.write('    {\n' if high is None else '    /* U+%02X00 */ {\n' % high)
+            for i in range(0, PAGE_SIZE, 12):
+                f.write('        ' + ', '.join('0x%04X' % v for v in page[i:i + 12]) + ',\n')
+            f.write('    },\n')
+        f.write('};\n\n')
+        f.write('const uint16_t g_textCodecGbkToUnicode[TEXTCODEC_TABLE_GBK_LEAD_MAX - TEXTCODEC_TABLE_GBK_LEAD_MIN + 1]\n'
+                '                                     [TEXTCODEC_TABLE_GBK_TRAIL_MAX - TEXTCODEC_TABLE_GBK_TRAIL_MIN + 1] = {\n')
+        for n, row in enumerate(rows):
+            f.write('    /* 0x%02X */ {\n' % (GBK_LEAD_MIN + n))
+            for i in range(0, len(row), 12):
+                f.write('        ' + ', '.join('0x%04X' % v for v in row[i:i + 12]) + ',\n')
+            f.write('    },\n')
+        f.write('};\n\n')
+        f.write('/****************** (C) COPYRIGHT DJI Innovations *****END OF FILE****/\n')
+
+
+def main():
+    out_dir = sys.argv[1] if len(sys.argv) > 1 else \
+        os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..', 'drivers', 'BSP')
+    index, pages, count = build_pages()
+
+    write_header(os.path.join(out_dir, 'textcodec_table.h'), len(pages), count)
+    write_source(os.path.join(out_dir, 'textcodec_table.c'), index, pages, build_gbk_rows())
+
+
+if __name__ == '__main__':
+    main()